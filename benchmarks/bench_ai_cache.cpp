@@ -0,0 +1,84 @@
+#include "core/ai_cache.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr size_t kKeys = 2048;
+constexpr size_t kCapacity = 1024; // Half the key space: misses and evictions
+
+AICache &sharedCache() {
+  static AICache cache(kCapacity, std::chrono::seconds(300));
+  return cache;
+}
+
+const std::vector<std::string> &keys() {
+  static const std::vector<std::string> keys = [] {
+    std::vector<std::string> keys;
+    keys.reserve(kKeys);
+    for (size_t i = 0; i < kKeys; ++i) {
+      keys.push_back(AICache::generateKey("image_" + std::to_string(i),
+                                          "{\"model\":\"yolov8n\"}"));
+    }
+    return keys;
+  }();
+  return keys;
+}
+
+// A typical detection result body
+const std::string &resultBody() {
+  static const std::string body(512, 'x');
+  return body;
+}
+
+void BM_AICache_Get(benchmark::State &state) {
+  auto &cache = sharedCache();
+  const auto &all = keys();
+  // Warm the first kCapacity keys once, before any thread reads
+  static const bool warmed = [&] {
+    for (size_t i = 0; i < kCapacity; ++i) {
+      cache.put(all[i], resultBody());
+    }
+    return true;
+  }();
+  benchmark::DoNotOptimize(warmed);
+  size_t i = static_cast<size_t>(state.thread_index()) * 7919;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cache.get(all[i++ % kCapacity]));
+  }
+}
+BENCHMARK(BM_AICache_Get)->ThreadRange(1, 8)->UseRealTime();
+
+// Read-mostly mix under contention: 90% get, 10% put over a key space twice
+// the capacity
+void BM_AICache_MixedGetPut(benchmark::State &state) {
+  auto &cache = sharedCache();
+  const auto &all = keys();
+  std::mt19937 rng(static_cast<unsigned>(state.thread_index()));
+  std::uniform_int_distribution<size_t> pick(0, kKeys - 1);
+  std::uniform_int_distribution<int> op(0, 9);
+  for (auto _ : state) {
+    const std::string &key = all[pick(rng)];
+    if (op(rng) == 0) {
+      cache.put(key, resultBody());
+    } else {
+      benchmark::DoNotOptimize(cache.get(key));
+    }
+  }
+}
+BENCHMARK(BM_AICache_MixedGetPut)->ThreadRange(1, 8)->UseRealTime();
+
+void BM_AICache_GenerateKey(benchmark::State &state) {
+  const std::string image(static_cast<size_t>(state.range(0)), '\x5a');
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        AICache::generateKey(image, "{\"model\":\"yolov8n\"}"));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          state.range(0));
+}
+BENCHMARK(BM_AICache_GenerateKey)->Arg(64)->Arg(256 * 1024);
+
+} // namespace
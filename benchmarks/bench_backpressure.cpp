@@ -0,0 +1,49 @@
+#include "core/backpressure_controller.h"
+#include <benchmark/benchmark.h>
+#include <string>
+
+using namespace BackpressureController;
+
+namespace {
+
+// Per-frame check through the handle the frame hooks keep
+void BM_Backpressure_ShouldDropFrame_Handle(benchmark::State &state) {
+  static auto handle = BackpressureController::BackpressureController::getInstance().registerInstance(
+      "bench_handle", DropPolicy::DROP_NEWEST, 30.0, 10);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(handle->shouldDropFrame());
+  }
+}
+BENCHMARK(BM_Backpressure_ShouldDropFrame_Handle)->ThreadRange(1, 8);
+
+// Same check through the string API (shared lock + hash lookup), one
+// instance per thread as with several running pipelines
+void BM_Backpressure_ShouldDropFrame_ById(benchmark::State &state) {
+  auto &controller = BackpressureController::BackpressureController::getInstance();
+  const std::string instanceId =
+      "bench_instance_" + std::to_string(state.thread_index());
+  controller.registerInstance(instanceId, DropPolicy::DROP_NEWEST, 30.0, 10);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(controller.shouldDropFrame(instanceId));
+  }
+}
+BENCHMARK(BM_Backpressure_ShouldDropFrame_ById)->ThreadRange(1, 8);
+
+// Full per-frame sequence of an ADAPTIVE_FPS pipeline
+void BM_Backpressure_AdaptiveFrameCycle(benchmark::State &state) {
+  auto handle = BackpressureController::BackpressureController::getInstance().registerInstance(
+      "bench_adaptive_" + std::to_string(state.thread_index()),
+      DropPolicy::ADAPTIVE_FPS, 30.0, 10);
+  size_t depth = 0;
+  for (auto _ : state) {
+    handle->updateQueueSize(depth++ % 5); // Below the drop threshold
+    if (handle->shouldDropFrame()) {
+      handle->recordFrameDropped();
+    } else {
+      handle->recordFrameProcessed();
+    }
+  }
+}
+BENCHMARK(BM_Backpressure_AdaptiveFrameCycle)->ThreadRange(1, 8);
+
+} // namespace
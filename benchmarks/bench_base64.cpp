@@ -0,0 +1,180 @@
+#include "utils/base64_codec.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef EDGE_AI_BENCH_OPENCV
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+#endif
+
+namespace {
+
+/**
+ * @brief A 1920x1080 frame encoded as JPEG (quality 90), the payload size
+ * the preview/last-frame and recognition endpoints typically move
+ */
+const std::vector<unsigned char> &jpeg1080p() {
+  static const std::vector<unsigned char> jpeg = [] {
+    std::vector<unsigned char> buffer;
+#ifdef EDGE_AI_BENCH_OPENCV
+    cv::Mat frame(1080, 1920, CV_8UC3);
+    cv::randu(frame, cv::Scalar::all(0), cv::Scalar::all(255));
+    cv::GaussianBlur(frame, frame, cv::Size(9, 9), 0);
+    cv::imencode(".jpg", frame, buffer, {cv::IMWRITE_JPEG_QUALITY, 90});
+#else
+    // Compressed data is close to uniformly random; match a typical size
+    std::mt19937 rng(1080);
+    buffer.resize(384 * 1024);
+    for (auto &byte : buffer) {
+      byte = static_cast<unsigned char>(rng());
+    }
+#endif
+    return buffer;
+  }();
+  return jpeg;
+}
+
+// Loops the codec replaced, kept verbatim for comparison
+std::string legacyWorkerEncode(const std::vector<unsigned char> &data) {
+  static const std::string base64_chars =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string encoded;
+  int val = 0, valb = -6;
+  for (unsigned char c : data) {
+    val = (val << 8) + c;
+    valb += 8;
+    while (valb >= 0) {
+      encoded.push_back(base64_chars[(val >> valb) & 0x3F]);
+      valb -= 6;
+    }
+  }
+  if (valb > -6) {
+    encoded.push_back(base64_chars[((val << 8) >> (valb + 8)) & 0x3F]);
+  }
+  while (encoded.size() % 4) {
+    encoded.push_back('=');
+  }
+  return encoded;
+}
+
+std::string legacyRegistryEncode(const unsigned char *data, size_t length) {
+  static const char base64_chars[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string encoded;
+  encoded.reserve(((length + 2) / 3) * 4);
+  size_t i = 0;
+  while (i < length) {
+    unsigned char byte1 = data[i++];
+    unsigned char byte2 = (i < length) ? data[i++] : 0;
+    unsigned char byte3 = (i < length) ? data[i++] : 0;
+    unsigned int combined = (byte1 << 16) | (byte2 << 8) | byte3;
+    encoded += base64_chars[(combined >> 18) & 0x3F];
+    encoded += base64_chars[(combined >> 12) & 0x3F];
+    encoded += (i - 2 < length) ? base64_chars[(combined >> 6) & 0x3F] : '=';
+    encoded += (i - 1 < length) ? base64_chars[combined & 0x3F] : '=';
+  }
+  return encoded;
+}
+
+bool legacyRecognitionDecode(const std::string &base64Str,
+                             std::vector<unsigned char> &output) {
+  std::string cleanBase64;
+  for (char c : base64Str) {
+    if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+      cleanBase64 += c;
+    }
+  }
+  if (cleanBase64.empty()) {
+    return false;
+  }
+  const std::string base64_chars =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  int val = 0, valb = -8;
+  for (unsigned char c : cleanBase64) {
+    if (c == '=')
+      break;
+    size_t pos = base64_chars.find(c);
+    if (pos == std::string::npos) {
+      return false;
+    }
+    val = (val << 6) + pos;
+    valb += 6;
+    if (valb >= 0) {
+      output.push_back((val >> valb) & 0xFF);
+      valb -= 8;
+    }
+  }
+  return true;
+}
+
+void setBytes(benchmark::State &state, size_t bytes) {
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(bytes));
+  state.counters["payload_bytes"] = static_cast<double>(bytes);
+}
+
+void BM_Base64Encode_LegacyWorker(benchmark::State &state) {
+  const auto &jpeg = jpeg1080p();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(legacyWorkerEncode(jpeg));
+  }
+  setBytes(state, jpeg.size());
+}
+BENCHMARK(BM_Base64Encode_LegacyWorker);
+
+void BM_Base64Encode_LegacyRegistry(benchmark::State &state) {
+  const auto &jpeg = jpeg1080p();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(legacyRegistryEncode(jpeg.data(), jpeg.size()));
+  }
+  setBytes(state, jpeg.size());
+}
+BENCHMARK(BM_Base64Encode_LegacyRegistry);
+
+void BM_Base64Encode(benchmark::State &state) {
+  auto impl = static_cast<Base64::Impl>(state.range(0));
+  if (!Base64::isSupported(impl)) {
+    state.SkipWithError("implementation not supported on this CPU");
+    return;
+  }
+  state.SetLabel(Base64::implName(impl));
+  const auto &jpeg = jpeg1080p();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Base64::encode(jpeg.data(), jpeg.size(), impl));
+  }
+  setBytes(state, jpeg.size());
+}
+BENCHMARK(BM_Base64Encode)->DenseRange(0, 3);
+
+void BM_Base64Decode_LegacyRecognition(benchmark::State &state) {
+  const std::string text = Base64::encode(jpeg1080p());
+  for (auto _ : state) {
+    std::vector<unsigned char> output;
+    benchmark::DoNotOptimize(legacyRecognitionDecode(text, output));
+    benchmark::DoNotOptimize(output.data());
+  }
+  setBytes(state, text.size());
+}
+BENCHMARK(BM_Base64Decode_LegacyRecognition);
+
+void BM_Base64Decode(benchmark::State &state) {
+  auto impl = static_cast<Base64::Impl>(state.range(0));
+  if (!Base64::isSupported(impl)) {
+    state.SkipWithError("implementation not supported on this CPU");
+    return;
+  }
+  state.SetLabel(Base64::implName(impl));
+  const std::string text = Base64::encode(jpeg1080p());
+  std::vector<unsigned char> output;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        Base64::decode(text.data(), text.size(), output, impl));
+    benchmark::DoNotOptimize(output.data());
+  }
+  setBytes(state, text.size());
+}
+BENCHMARK(BM_Base64Decode)->DenseRange(0, 3);
+
+} // namespace
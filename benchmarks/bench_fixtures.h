@@ -0,0 +1,27 @@
+#pragma once
+
+#include "instances/instance_statistics.h"
+
+namespace bench {
+
+/**
+ * @brief Statistics of a running 1080p -> 720p pipeline, as reported by the
+ * statistics endpoint and the worker's GET_STATISTICS reply
+ */
+inline InstanceStatistics sampleStatistics() {
+  InstanceStatistics stats;
+  stats.frames_processed = 1234567;
+  stats.frames_incoming = 1240000;
+  stats.source_framerate = 30.0;
+  stats.current_framerate = 29.7;
+  stats.latency = 41.5;
+  stats.start_time = 1760000000;
+  stats.input_queue_size = 3;
+  stats.dropped_frames_count = 5433;
+  stats.resolution = "1280x720";
+  stats.format = "BGR";
+  stats.source_resolution = "1920x1080";
+  return stats;
+}
+
+} // namespace bench
@@ -0,0 +1,146 @@
+#include "core/pipeline_builder.h"
+#include "instances/instance_registry.h"
+#include "instances/instance_storage.h"
+#include "models/create_instance_request.h"
+#include "solutions/solution_registry.h"
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+constexpr int kInstances = 16;
+
+/**
+ * @brief Registry with kInstances created (not started) instances
+ *
+ * No pipelines run here, so reads measure the registry locks, lookups and
+ * copies, and the writer below supplies the contention that frame hooks and
+ * API writes cause in a live server.
+ */
+struct RegistryFixture {
+  std::filesystem::path storage_dir;
+  std::unique_ptr<PipelineBuilder> pipeline_builder;
+  std::unique_ptr<InstanceStorage> instance_storage;
+  std::unique_ptr<InstanceRegistry> registry;
+  std::vector<std::string> ids;
+
+  RegistryFixture() {
+    storage_dir = std::filesystem::temp_directory_path() /
+                  ("edge_ai_bench_instances_" + std::to_string(getpid()));
+    std::filesystem::create_directories(storage_dir);
+    pipeline_builder = std::make_unique<PipelineBuilder>();
+    instance_storage = std::make_unique<InstanceStorage>(storage_dir.string());
+    registry = std::make_unique<InstanceRegistry>(
+        SolutionRegistry::getInstance(), *pipeline_builder, *instance_storage);
+    for (int i = 0; i < kInstances; ++i) {
+      CreateInstanceRequest req;
+      req.name = "bench_" + std::to_string(i);
+      req.statisticsMode = true;
+      std::string id = registry->createInstance(req);
+      if (!id.empty()) {
+        ids.push_back(id);
+      }
+    }
+  }
+
+  ~RegistryFixture() {
+    registry.reset();
+    std::error_code ec;
+    std::filesystem::remove_all(storage_dir, ec);
+  }
+};
+
+RegistryFixture &fixture() {
+  static RegistryFixture fixture;
+  return fixture;
+}
+
+/**
+ * @brief Creates and deletes a scratch instance in a loop (exclusive registry
+ * lock) while a benchmark reads
+ */
+class RegistryWriter {
+public:
+  RegistryWriter(InstanceRegistry &registry, bool enabled) {
+    if (!enabled) {
+      return;
+    }
+    thread_ = std::thread([this, &registry] {
+      CreateInstanceRequest req;
+      req.name = "bench_writer";
+      while (!stop_.load(std::memory_order_relaxed)) {
+        std::string id = registry.createInstance(req);
+        if (!id.empty()) {
+          registry.deleteInstance(id);
+        }
+        writes_.fetch_add(1, std::memory_order_relaxed);
+      }
+    });
+  }
+
+  ~RegistryWriter() {
+    stop_.store(true);
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  uint64_t writes() const { return writes_.load(); }
+
+private:
+  std::thread thread_;
+  std::atomic<bool> stop_{false};
+  std::atomic<uint64_t> writes_{0};
+};
+
+// Arg: 0 = idle registry, 1 = concurrent writer
+void BM_InstanceRegistry_GetStatistics(benchmark::State &state) {
+  auto &f = fixture();
+  if (f.ids.empty()) {
+    state.SkipWithError("could not create instances");
+    return;
+  }
+  RegistryWriter writer(*f.registry, state.range(0) != 0);
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        f.registry->getInstanceStatistics(f.ids[i++ % f.ids.size()]));
+  }
+  state.counters["writes"] = static_cast<double>(writer.writes());
+}
+BENCHMARK(BM_InstanceRegistry_GetStatistics)->Arg(0)->Arg(1)->UseRealTime();
+
+// Status summary / list endpoints read every instance in one call
+void BM_InstanceRegistry_GetAllInstances(benchmark::State &state) {
+  auto &f = fixture();
+  RegistryWriter writer(*f.registry, state.range(0) != 0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(f.registry->getAllInstances());
+  }
+  state.counters["writes"] = static_cast<double>(writer.writes());
+}
+BENCHMARK(BM_InstanceRegistry_GetAllInstances)->Arg(0)->Arg(1)->UseRealTime();
+
+void BM_InstanceRegistry_GetLastFrame(benchmark::State &state) {
+  auto &f = fixture();
+  if (f.ids.empty()) {
+    state.SkipWithError("could not create instances");
+    return;
+  }
+  RegistryWriter writer(*f.registry, state.range(0) != 0);
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        f.registry->getLastFrame(f.ids[i++ % f.ids.size()]));
+  }
+  state.counters["writes"] = static_cast<double>(writer.writes());
+}
+BENCHMARK(BM_InstanceRegistry_GetLastFrame)->Arg(0)->Arg(1)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,76 @@
+#include "bench_fixtures.h"
+#include "utils/base64_codec.h"
+#include "worker/ipc_protocol.h"
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+using worker::IPCMessage;
+
+// Worker reply to GET_STATISTICS: the most frequent IPC round trip
+IPCMessage statisticsResponse() {
+  IPCMessage msg;
+  msg.type = worker::MessageType::GET_STATISTICS_RESPONSE;
+  msg.payload = worker::createResponse(worker::ResponseStatus::OK, "",
+                                       bench::sampleStatistics().toJson());
+  return msg;
+}
+
+// Worker reply to GET_LAST_FRAME: a base64 JPEG of a 1080p frame
+IPCMessage lastFrameResponse() {
+  std::vector<unsigned char> jpeg(300 * 1024, 0x5a);
+  Json::Value data;
+  data["frame"] = Base64::encode(jpeg);
+  data["has_frame"] = true;
+  IPCMessage msg;
+  msg.type = worker::MessageType::GET_LAST_FRAME_RESPONSE;
+  msg.payload = worker::createResponse(worker::ResponseStatus::OK, "", data);
+  return msg;
+}
+
+void BM_IPC_Serialize_Statistics(benchmark::State &state) {
+  IPCMessage msg = statisticsResponse();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(msg.serialize());
+  }
+}
+BENCHMARK(BM_IPC_Serialize_Statistics);
+
+void BM_IPC_Deserialize_Statistics(benchmark::State &state) {
+  std::string bytes = statisticsResponse().serialize();
+  for (auto _ : state) {
+    IPCMessage out;
+    benchmark::DoNotOptimize(IPCMessage::deserialize(bytes, out));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(bytes.size()));
+}
+BENCHMARK(BM_IPC_Deserialize_Statistics);
+
+void BM_IPC_Serialize_LastFrame(benchmark::State &state) {
+  IPCMessage msg = lastFrameResponse();
+  size_t size = 0;
+  for (auto _ : state) {
+    std::string bytes = msg.serialize();
+    size = bytes.size();
+    benchmark::DoNotOptimize(bytes);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(size));
+}
+BENCHMARK(BM_IPC_Serialize_LastFrame);
+
+void BM_IPC_Deserialize_LastFrame(benchmark::State &state) {
+  std::string bytes = lastFrameResponse().serialize();
+  for (auto _ : state) {
+    IPCMessage out;
+    benchmark::DoNotOptimize(IPCMessage::deserialize(bytes, out));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(bytes.size()));
+}
+BENCHMARK(BM_IPC_Deserialize_LastFrame);
+
+} // namespace
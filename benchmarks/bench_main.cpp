@@ -0,0 +1,27 @@
+#include "core/logging_flags.h"
+#include <atomic>
+#include <benchmark/benchmark.h>
+
+// Define logging flags for benchmarks (they're normally defined in main.cpp)
+std::atomic<bool> g_log_api{false};
+std::atomic<bool> g_log_instance{false};
+std::atomic<bool> g_log_sdk_output{false};
+
+int main(int argc, char **argv) {
+  // Recorded in the "context" block of JSON output so result files from
+  // different releases can be told apart when comparing them
+  benchmark::AddCustomContext("edge_ai_api_version", EDGE_AI_BENCH_VERSION);
+#ifdef EDGE_AI_BENCH_FULL_APP
+  benchmark::AddCustomContext("edge_ai_bench_mode", "full");
+#else
+  benchmark::AddCustomContext("edge_ai_bench_mode", "components");
+#endif
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,52 @@
+#include "bench_fixtures.h"
+#include "core/performance_monitor.h"
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace {
+
+void BM_InstanceStatistics_ToJson(benchmark::State &state) {
+  InstanceStatistics stats = bench::sampleStatistics();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(stats.toJson());
+  }
+}
+BENCHMARK(BM_InstanceStatistics_ToJson);
+
+void BM_InstanceStatistics_ToJsonString(benchmark::State &state) {
+  InstanceStatistics stats = bench::sampleStatistics();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(stats.toJsonString());
+  }
+}
+BENCHMARK(BM_InstanceStatistics_ToJsonString);
+
+// Called by the metrics interceptor on every API request
+void BM_PerformanceMonitor_RecordRequest(benchmark::State &state) {
+  static const std::vector<std::string> endpoints = {
+      "/v1/core/instance/status/summary", "/v1/core/instance/{id}/statistics",
+      "/v1/core/instance/{id}/frame", "/v1/recognition/recognize",
+      "/v1/core/health"};
+  auto &monitor = PerformanceMonitor::getInstance();
+  size_t i = static_cast<size_t>(state.thread_index());
+  for (auto _ : state) {
+    monitor.recordRequest(endpoints[i++ % endpoints.size()],
+                          std::chrono::milliseconds(12), true);
+  }
+}
+BENCHMARK(BM_PerformanceMonitor_RecordRequest)->ThreadRange(1, 8)->UseRealTime();
+
+void BM_PerformanceMonitor_RecordRequestWithStatus(benchmark::State &state) {
+  auto &monitor = PerformanceMonitor::getInstance();
+  for (auto _ : state) {
+    monitor.recordRequest("GET", "/v1/core/instance/{id}/statistics", 200,
+                          0.004);
+  }
+}
+BENCHMARK(BM_PerformanceMonitor_RecordRequestWithStatus)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+} // namespace
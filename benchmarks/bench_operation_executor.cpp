@@ -0,0 +1,79 @@
+#include "core/operation_executor.h"
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+void configureWorkers(size_t workers) {
+  OperationExecutor::Config config;
+  config.worker_threads = workers;
+  config.max_pending = 100000;
+  config.max_retained = 10000;
+  OperationExecutor::getInstance().configure(config);
+}
+
+// Bulk restart of range(1) instances with range(0) executor workers.
+// A simulated restart waits 5 ms for pipeline teardown/startup (parallel)
+// and holds a shared lock for 0.5 ms (registry / GStreamer state changes
+// serialize in the real server). Throughput levels off once the serialized
+// part dominates: pick system.operations.worker_threads around the knee.
+void BM_OperationExecutor_BulkRestart(benchmark::State &state) {
+  const size_t workers = static_cast<size_t>(state.range(0));
+  const int instances = static_cast<int>(state.range(1));
+  configureWorkers(workers);
+  auto &executor = OperationExecutor::getInstance();
+  static std::mutex pipelineLock;
+
+  for (auto _ : state) {
+    std::vector<OperationExecutor::BatchItem> items;
+    items.reserve(instances);
+    for (int i = 0; i < instances; ++i) {
+      items.push_back({"bench-instance-" + std::to_string(i),
+                       [](OperationExecutor::Progress &progress,
+                          std::string &) {
+                         progress.report(0.1, "stopping pipeline");
+                         std::this_thread::sleep_for(
+                             std::chrono::microseconds(2500));
+                         {
+                           std::lock_guard<std::mutex> lock(pipelineLock);
+                           std::this_thread::sleep_for(
+                               std::chrono::microseconds(500));
+                         }
+                         progress.report(0.5, "starting pipeline");
+                         std::this_thread::sleep_for(
+                             std::chrono::microseconds(2500));
+                         return true;
+                       }});
+    }
+    std::string id = executor.submitBatch("batch_restart", std::move(items));
+    executor.wait(id);
+  }
+  state.SetItemsProcessed(state.iterations() * instances);
+  state.counters["workers"] = static_cast<double>(workers);
+}
+BENCHMARK(BM_OperationExecutor_BulkRestart)
+    ->ArgsProduct({{1, 2, 4, 8, 16}, {64}})
+    ->ArgNames({"workers", "instances"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// Executor overhead: submit + wait for an empty operation
+void BM_OperationExecutor_SubmitWait(benchmark::State &state) {
+  configureWorkers(4);
+  auto &executor = OperationExecutor::getInstance();
+  int i = 0;
+  for (auto _ : state) {
+    std::string id = executor.submit(
+        "stop", "bench-" + std::to_string(i++ % 64),
+        [](OperationExecutor::Progress &, std::string &) { return true; });
+    executor.wait(id);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OperationExecutor_SubmitWait)->UseRealTime();
+
+} // namespace
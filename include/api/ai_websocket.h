@@ -4,6 +4,7 @@
 #include <drogon/HttpRequest.h>
 #include <drogon/WebSocketController.h>
 #include <memory>
+#include <optional>
 #include <string>
 
 using namespace drogon;
@@ -39,6 +40,13 @@ public:
    */
   static void setInstanceManager(IInstanceManager *manager);
 
+  /**
+   * @brief Build the serialized update message of an instance
+   * Shared by all subscribers of the instance (see InstanceSubscriptionHub).
+   */
+  static std::optional<std::string>
+  buildInstanceUpdate(const std::string &instanceId);
+
 private:
   void processStreamMessage(const WebSocketConnectionPtr &wsConnPtr,
                             const std::string &message);
@@ -50,8 +58,11 @@ private:
   void sendResult(const WebSocketConnectionPtr &wsConnPtr,
                   const std::string &result);
 
-  void sendInstanceUpdate(const WebSocketConnectionPtr &wsConnPtr,
-                          const std::string &instanceId);
+  /**
+   * @brief Subscribe a connection to the instance update fan-out
+   */
+  static void subscribeToInstance(const WebSocketConnectionPtr &wsConnPtr,
+                                  const std::string &instanceId);
 
   static std::atomic<size_t> active_connections_;
   static IInstanceManager *instance_manager_;
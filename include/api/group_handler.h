@@ -25,6 +25,14 @@ class GroupInfo;
  * - PUT /v1/core/groups/{groupId} - Update a group
  * - DELETE /v1/core/groups/{groupId} - Delete a group
  * - GET /v1/core/groups/{groupId}/instances - Get instances in a group
+ * - POST /v1/core/groups/{groupId}/start - Start all instances in a group
+ * - POST /v1/core/groups/{groupId}/stop - Stop all instances in a group
+ * - POST /v1/core/groups/{groupId}/restart - Restart all instances in a group
+ *
+ * Group actions run in parallel on the OperationExecutor. Body (optional):
+ * {"concurrency": N, "timeoutMs": M}. Default response waits for the whole
+ * group; ?async=true returns 202 with an operation ID, and ?stream=true (or
+ * Accept: text/event-stream) streams one SSE event per finished instance.
  */
 class GroupHandler : public drogon::HttpController<GroupHandler> {
 public:
@@ -36,11 +44,23 @@ public:
   ADD_METHOD_TO(GroupHandler::deleteGroup, "/v1/core/groups/{groupId}", Delete);
   ADD_METHOD_TO(GroupHandler::getGroupInstances,
                 "/v1/core/groups/{groupId}/instances", Get);
+  ADD_METHOD_TO(GroupHandler::startGroup, "/v1/core/groups/{groupId}/start",
+                Post);
+  ADD_METHOD_TO(GroupHandler::stopGroup, "/v1/core/groups/{groupId}/stop",
+                Post);
+  ADD_METHOD_TO(GroupHandler::restartGroup,
+                "/v1/core/groups/{groupId}/restart", Post);
   ADD_METHOD_TO(GroupHandler::handleOptions, "/v1/core/groups", Options);
   ADD_METHOD_TO(GroupHandler::handleOptions, "/v1/core/groups/{groupId}",
                 Options);
   ADD_METHOD_TO(GroupHandler::handleOptions,
                 "/v1/core/groups/{groupId}/instances", Options);
+  ADD_METHOD_TO(GroupHandler::handleOptions, "/v1/core/groups/{groupId}/start",
+                Options);
+  ADD_METHOD_TO(GroupHandler::handleOptions, "/v1/core/groups/{groupId}/stop",
+                Options);
+  ADD_METHOD_TO(GroupHandler::handleOptions,
+                "/v1/core/groups/{groupId}/restart", Options);
   METHOD_LIST_END
 
   /**
@@ -86,6 +106,27 @@ public:
   getGroupInstances(const HttpRequestPtr &req,
                     std::function<void(const HttpResponsePtr &)> &&callback);
 
+  /**
+   * @brief Handle POST /v1/core/groups/{groupId}/start
+   * Starts every instance in the group (running ones are left alone)
+   */
+  void startGroup(const HttpRequestPtr &req,
+                  std::function<void(const HttpResponsePtr &)> &&callback);
+
+  /**
+   * @brief Handle POST /v1/core/groups/{groupId}/stop
+   * Stops every running instance in the group
+   */
+  void stopGroup(const HttpRequestPtr &req,
+                 std::function<void(const HttpResponsePtr &)> &&callback);
+
+  /**
+   * @brief Handle POST /v1/core/groups/{groupId}/restart
+   * Restarts every instance in the group
+   */
+  void restartGroup(const HttpRequestPtr &req,
+                    std::function<void(const HttpResponsePtr &)> &&callback);
+
   /**
    * @brief Handle OPTIONS request for CORS preflight
    */
@@ -127,6 +168,14 @@ private:
   HttpResponsePtr createSuccessResponse(const Json::Value &data,
                                         int statusCode = 200) const;
 
+  /**
+   * @brief Shared body of the start/stop/restart group actions
+   * @param action "start", "stop" or "restart"
+   */
+  void runGroupAction(const HttpRequestPtr &req,
+                      std::function<void(const HttpResponsePtr &)> &&callback,
+                      const std::string &action);
+
   /**
    * @brief Validate group ID format
    */
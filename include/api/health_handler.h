@@ -16,11 +16,15 @@ using namespace drogon;
  *
  * Endpoint: GET /v1/core/health
  * Returns: JSON with status, timestamp, and uptime
+ *
+ * Endpoint: GET /v1/core/health/startup
+ * Returns: Startup timeline (phases, durations, time to API ready)
  */
 class HealthHandler : public drogon::HttpController<HealthHandler> {
 public:
   METHOD_LIST_BEGIN
   ADD_METHOD_TO(HealthHandler::getHealth, "/v1/core/health", Get);
+  ADD_METHOD_TO(HealthHandler::getStartup, "/v1/core/health/startup", Get);
   METHOD_LIST_END
 
   /**
@@ -32,6 +36,15 @@ public:
   void getHealth(const HttpRequestPtr &req,
                  std::function<void(const HttpResponsePtr &)> &&callback);
 
+  /**
+   * @brief Handle GET /v1/core/health/startup
+   *
+   * @param req HTTP request
+   * @param callback Response callback
+   */
+  void getStartup(const HttpRequestPtr &req,
+                  std::function<void(const HttpResponsePtr &)> &&callback);
+
 private:
   /**
    * @brief Get current timestamp in ISO 8601 format
@@ -44,6 +44,8 @@ class UpdateInstanceRequest;
  * configuration
  * - POST /v1/core/instance/{instanceId}/output/stream - Configure stream
  * output (RTMP/RTSP/HLS)
+ * - GET /v1/core/instance/{instanceId}/queue - Get per-node queue depth
+ * telemetry (time series)
  */
 class InstanceHandler : public drogon::HttpController<InstanceHandler> {
 public:
@@ -94,6 +96,10 @@ public:
                 "/v1/core/instance/{instanceId}/classes", Get);
   ADD_METHOD_TO(InstanceHandler::getInstancePreview,
                 "/v1/core/instance/{instanceId}/preview", Get);
+  ADD_METHOD_TO(InstanceHandler::getPreviewStream,
+                "/v1/core/instance/{instanceId}/preview/stream", Get);
+  ADD_METHOD_TO(InstanceHandler::getQueueTelemetry,
+                "/v1/core/instance/{instanceId}/queue", Get);
   ADD_METHOD_TO(InstanceHandler::handleOptions, "/v1/core/instance", Options);
   ADD_METHOD_TO(InstanceHandler::handleOptions,
                 "/v1/core/instance/{instanceId}", Options);
@@ -119,6 +125,10 @@ public:
                 "/v1/core/instance/{instanceId}/classes", Options);
   ADD_METHOD_TO(InstanceHandler::handleOptions,
                 "/v1/core/instance/{instanceId}/preview", Options);
+  ADD_METHOD_TO(InstanceHandler::handleOptions,
+                "/v1/core/instance/{instanceId}/preview/stream", Options);
+  ADD_METHOD_TO(InstanceHandler::handleOptions,
+                "/v1/core/instance/{instanceId}/queue", Options);
   ADD_METHOD_TO(InstanceHandler::handleOptions, "/v1/core/instance/batch/start",
                 Options);
   ADD_METHOD_TO(InstanceHandler::handleOptions, "/v1/core/instance/batch/stop",
@@ -259,7 +269,8 @@ public:
 
   /**
    * @brief Handle GET /v1/core/instance/{instanceId}/frame
-   * Gets the last frame from a running instance
+   * Gets the last frame from a running instance (base64 in JSON, or the JPEG
+   * itself with Accept: image/jpeg)
    */
   void getLastFrame(const HttpRequestPtr &req,
                     std::function<void(const HttpResponsePtr &)> &&callback);
@@ -289,12 +300,31 @@ public:
 
   /**
    * @brief Handle GET /v1/core/instance/{instanceId}/preview
-   * Gets preview frame (screenshot) from instance
+   * Gets preview frame (screenshot) from instance (data URL in JSON, or the
+   * JPEG itself with Accept: image/jpeg)
    */
   void
   getInstancePreview(const HttpRequestPtr &req,
                      std::function<void(const HttpResponsePtr &)> &&callback);
 
+  /**
+   * @brief Handle GET /v1/core/instance/{instanceId}/preview/stream
+   * Live MJPEG preview (multipart/x-mixed-replace) from PreviewStreamHub
+   * Query: fps (max frames per second, default 5), width (0 = source)
+   */
+  void
+  getPreviewStream(const HttpRequestPtr &req,
+                   std::function<void(const HttpResponsePtr &)> &&callback);
+
+  /**
+   * @brief Handle GET /v1/core/instance/{instanceId}/queue
+   * Gets per-node queue depth and drop count time series
+   * Query: samples (max samples per node, default 100, max 512)
+   */
+  void
+  getQueueTelemetry(const HttpRequestPtr &req,
+                    std::function<void(const HttpResponsePtr &)> &&callback);
+
   /**
    * @brief Handle OPTIONS request for CORS preflight
    */
@@ -340,6 +370,33 @@ private:
   HttpResponsePtr createSuccessResponse(const Json::Value &data,
                                         int statusCode = 200) const;
 
+  /**
+   * @brief True if the client asked for a frame as a JPEG body
+   * (Accept: image/jpeg) instead of base64 inside JSON
+   */
+  static bool wantsJpeg(const HttpRequestPtr &req);
+
+  /**
+   * @brief JPEG body with CORS headers (204 No Content if there is no frame)
+   */
+  HttpResponsePtr createJpegResponse(std::string jpeg, bool running) const;
+
+  /**
+   * @brief Run a per-instance batch action on the operation executor
+   *
+   * One operation per instance (serialized with other operations on that
+   * instance) under a batch operation. Waits and replies with per-instance
+   * results, or replies 202 with the batch operation ID when the request has
+   * ?async=true.
+   */
+  void runBatchOperation(const HttpRequestPtr &req,
+                         std::function<void(const HttpResponsePtr &)> &&callback,
+                         const std::string &type,
+                         const std::vector<std::string> &instanceIds,
+                         std::function<bool(const std::string &)> action,
+                         const std::string &doneStatus,
+                         const std::string &failureMessage);
+
   /**
    * @brief Get output file information for an instance
    * @param instanceId Instance ID
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <json/json.h>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Fan-out hub for WebSocket instance subscriptions
+ *
+ * One periodic tick on the hub's own thread builds and serializes the update
+ * of every subscribed instance exactly once and hands the same shared buffer
+ * to all of that instance's subscribers. Building an update may block (IPC
+ * to a worker in subprocess mode), so it never runs on a Drogon loop; the
+ * Subscriber posts the actual send to its connection's loop.
+ *
+ * Each connection has a bounded number of sends in flight. A connection that
+ * is still behind when the next update is due skips that update (the next one
+ * carries the full state anyway); after too many consecutive skips it is
+ * closed.
+ *
+ * The hub does not depend on Drogon: connections are represented by a
+ * Subscriber with send/connected/close callbacks.
+ */
+class InstanceSubscriptionHub {
+public:
+  using ConnectionId = const void *;
+  using Payload = std::shared_ptr<const std::string>;
+
+  /**
+   * @brief Builds the serialized update for an instance
+   * @return Serialized message, or empty optional to skip this tick
+   */
+  using UpdateBuilder =
+      std::function<std::optional<std::string>(const std::string &instanceId)>;
+
+  /**
+   * @brief Transport callbacks of one connection
+   * send() must call done() once the payload was handed to the socket (it
+   * may do so asynchronously, on the connection's own event loop).
+   */
+  struct Subscriber {
+    std::function<void(Payload payload, std::function<void()> done)> send;
+    std::function<bool()> connected;
+    std::function<void()> close;
+  };
+
+  struct Config {
+    std::chrono::milliseconds interval{1000};
+    size_t max_pending_per_connection = 4; // Sends in flight per connection
+    size_t max_consecutive_skips = 30; // Close a connection stuck this long
+  };
+
+  struct Stats {
+    size_t connections = 0;
+    size_t subscriptions = 0; // (connection, instance) pairs
+    size_t instances = 0;     // Distinct subscribed instances
+    uint64_t ticks = 0;
+    uint64_t messages_sent = 0;
+    uint64_t messages_skipped = 0; // Slow connection, update skipped
+    uint64_t connections_closed = 0; // Closed for being too slow
+    double last_fanout_seconds = 0.0;
+    double total_fanout_seconds = 0.0;
+  };
+
+  static InstanceSubscriptionHub &getInstance() {
+    static InstanceSubscriptionHub instance;
+    return instance;
+  }
+
+  void configure(const Config &config);
+  Config getConfig() const;
+
+  void setUpdateBuilder(UpdateBuilder builder);
+
+  /**
+   * @brief Subscribe a connection to an instance (idempotent)
+   * The Subscriber of the first subscription of a connection is kept.
+   */
+  void subscribe(ConnectionId connection, const std::string &instanceId,
+                 Subscriber subscriber);
+
+  /**
+   * @brief Remove one subscription of a connection
+   */
+  void unsubscribe(ConnectionId connection, const std::string &instanceId);
+
+  /**
+   * @brief Remove all subscriptions of a connection (connection closed)
+   */
+  void removeConnection(ConnectionId connection);
+
+  /**
+   * @brief Start the tick thread (idempotent)
+   */
+  void start();
+
+  /**
+   * @brief Stop the tick thread
+   */
+  void shutdown();
+
+  /**
+   * @brief Build and fan out one round of updates
+   * Called by the tick thread; public for tests.
+   * @return Number of messages handed to connections
+   */
+  size_t tick();
+
+  Stats getStats() const;
+  Json::Value getStatsJson() const;
+
+  /**
+   * @brief Prometheus exposition of subscription and fan-out metrics
+   */
+  std::string getPrometheusMetrics() const;
+
+private:
+  InstanceSubscriptionHub() = default;
+  ~InstanceSubscriptionHub() { shutdown(); }
+  InstanceSubscriptionHub(const InstanceSubscriptionHub &) = delete;
+  InstanceSubscriptionHub &operator=(const InstanceSubscriptionHub &) = delete;
+
+  struct Connection {
+    Subscriber subscriber;
+    std::set<std::string> instances;
+    std::atomic<size_t> pending{0}; // Sends not yet handed to the socket
+    size_t consecutive_skips = 0;   // Only touched by tick()
+    bool closing = false;           // Only touched by tick()
+  };
+
+  void dropConnectionLocked(ConnectionId connection);
+  void tickLoop();
+
+  mutable std::mutex mutex_;
+  Config config_;
+  UpdateBuilder builder_;
+  std::unordered_map<ConnectionId, std::shared_ptr<Connection>> connections_;
+  std::unordered_map<std::string, std::vector<std::shared_ptr<Connection>>>
+      subscribers_; // instanceId -> connections
+  size_t subscription_count_ = 0;
+
+  std::mutex tick_mutex_; // Serializes tick() (thread vs. manual calls)
+
+  std::thread thread_;
+  std::condition_variable cv_; // Wakes tickLoop on shutdown
+  bool running_ = false;
+
+  std::atomic<uint64_t> ticks_{0};
+  std::atomic<uint64_t> messages_sent_{0};
+  std::atomic<uint64_t> messages_skipped_{0};
+  std::atomic<uint64_t> connections_closed_{0};
+  std::atomic<uint64_t> last_fanout_ns_{0};
+  std::atomic<uint64_t> total_fanout_ns_{0};
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <drogon/HttpController.h>
+#include <drogon/HttpRequest.h>
+#include <drogon/HttpResponse.h>
+#include <json/json.h>
+
+using namespace drogon;
+
+/**
+ * @brief Long-running operation status endpoints
+ *
+ * Endpoints:
+ * - GET /v1/core/operations - Recent operations and executor stats
+ *   (?instanceId= to filter by instance, ?limit= default 50)
+ * - GET /v1/core/operations/{operationId} - State and progress of one
+ *   operation (batches include their per-instance children)
+ *
+ * Operation IDs are returned by stop/restart/delete and batch actions.
+ */
+class OperationsHandler : public drogon::HttpController<OperationsHandler> {
+public:
+  METHOD_LIST_BEGIN
+  ADD_METHOD_TO(OperationsHandler::listOperations, "/v1/core/operations",
+                Get);
+  ADD_METHOD_TO(OperationsHandler::getOperation,
+                "/v1/core/operations/{operationId}", Get);
+  ADD_METHOD_TO(OperationsHandler::handleOptions, "/v1/core/operations",
+                Options);
+  ADD_METHOD_TO(OperationsHandler::handleOptions,
+                "/v1/core/operations/{operationId}", Options);
+  METHOD_LIST_END
+
+  /**
+   * @brief Handle GET /v1/core/operations
+   */
+  void listOperations(const HttpRequestPtr &req,
+                      std::function<void(const HttpResponsePtr &)> &&callback);
+
+  /**
+   * @brief Handle GET /v1/core/operations/{operationId}
+   */
+  void getOperation(const HttpRequestPtr &req,
+                    std::function<void(const HttpResponsePtr &)> &&callback);
+
+  /**
+   * @brief Handle OPTIONS request for CORS preflight
+   */
+  void handleOptions(const HttpRequestPtr &req,
+                     std::function<void(const HttpResponsePtr &)> &&callback);
+
+private:
+  static HttpResponsePtr createJsonResponse(const Json::Value &body,
+                                            HttpStatusCode code);
+};
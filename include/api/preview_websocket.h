@@ -0,0 +1,53 @@
+#pragma once
+
+#include <drogon/HttpRequest.h>
+#include <drogon/WebSocketController.h>
+#include <string>
+
+using namespace drogon;
+
+// Forward declarations
+class IInstanceManager;
+
+/**
+ * @brief Binary WebSocket live preview
+ *
+ * Endpoint: /v1/core/instance/{instanceId}/preview/ws?fps=5&width=640
+ * Each frame is sent as one binary message containing a JPEG. Frames come
+ * from PreviewStreamHub and are shared with every other viewer of the same
+ * instance/fps/width (including MJPEG viewers of
+ * /v1/core/instance/{instanceId}/preview/stream).
+ */
+class PreviewWebSocketController
+    : public drogon::WebSocketController<PreviewWebSocketController> {
+public:
+  void handleNewMessage(const WebSocketConnectionPtr &wsConnPtr,
+                        std::string &&message,
+                        const WebSocketMessageType &type) override;
+
+  void handleNewConnection(const HttpRequestPtr &req,
+                           const WebSocketConnectionPtr &wsConnPtr) override;
+
+  void handleConnectionClosed(const WebSocketConnectionPtr &wsConnPtr) override;
+
+  WS_PATH_LIST_BEGIN
+  WS_PATH_ADD("/v1/core/instance/{instanceId}/preview/ws", drogon::Get);
+  WS_PATH_LIST_END
+
+  /**
+   * @brief Set instance manager and wire it as PreviewStreamHub frame source
+   * Also installs the JPEG scaler and starts the hub.
+   */
+  static void setInstanceManager(IInstanceManager *manager);
+
+  /**
+   * @brief Scale a JPEG to the given width (never upscales)
+   * @return Re-encoded JPEG, the input if already small enough, or empty
+   * string if it cannot be decoded
+   */
+  static std::string scaleJpeg(const std::string &jpeg, int width,
+                               int quality);
+
+private:
+  static IInstanceManager *instance_manager_;
+};
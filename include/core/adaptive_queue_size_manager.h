@@ -14,6 +14,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -88,6 +89,17 @@ public:
   void updateInstanceMetrics(const std::string &instanceId,
                              const InstanceMetrics &metrics);
 
+  /**
+   * @brief Recalculate queue size from queue depth telemetry
+   *
+   * Derives queue full frequency and queue depth from the QueueTelemetry ring
+   * buffers of the instance (last TELEMETRY_WINDOW_MS) instead of waiting for
+   * updateInstanceMetrics().
+   * @param instanceId Instance ID
+   * @return Current (possibly updated) queue size
+   */
+  size_t refreshFromTelemetry(const std::string &instanceId);
+
   /**
    * @brief Get current queue size for instance
    * @param instanceId Instance ID
@@ -153,6 +165,9 @@ private:
   static constexpr double REDUCE_FACTOR = 0.8;   // Reduce by 20%
   static constexpr double INCREASE_FACTOR = 1.2; // Increase by 20%
   static constexpr size_t MIN_ADJUSTMENT = 1;    // Minimum adjustment step
+
+  // Telemetry window used by refreshFromTelemetry()
+  static constexpr int64_t TELEMETRY_WINDOW_MS = 2000;
 };
 
 } // namespace AdaptiveQueueSize
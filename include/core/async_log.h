@@ -0,0 +1,208 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <json/json.h>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Asynchronous logging backend
+ *
+ * Log calls on frame and API threads only copy the message into a ring
+ * buffer owned by the calling thread (single producer, single consumer, no
+ * lock). A background writer drains all rings every EDGE_AI_LOG_FLUSH_MS,
+ * orders the records by time, formats them and hands each output one batch,
+ * i.e. one write() per output per flush instead of one locked write per line.
+ *
+ * Sinks are registered once (LogManager's plog appenders, raw stdout and
+ * stderr); several sinks can share one output (the console).
+ * redirectStdStreams() reroutes std::cout/std::cerr/std::clog through the
+ * backend line by line, so existing "[Component] ..." output no longer takes
+ * stream locks on hot paths.
+ *
+ * When a ring is full the record is dropped and counted
+ * (EDGE_AI_LOG_DROP_POLICY=drop, default) or the caller waits for the writer
+ * (block). Before start() and after shutdown() records are written
+ * synchronously. Disable with EDGE_AI_ASYNC_LOG=0.
+ */
+class AsyncLogBackend {
+public:
+  enum class DropPolicy { Drop, Block };
+
+  struct Config {
+    size_t ring_bytes = 64 * 1024; // Per thread (EDGE_AI_LOG_RING_KB)
+    std::chrono::milliseconds flush_interval{20}; // EDGE_AI_LOG_FLUSH_MS
+    DropPolicy drop_policy = DropPolicy::Drop;    // EDGE_AI_LOG_DROP_POLICY
+  };
+
+  /**
+   * @brief One log record as seen by a sink formatter
+   */
+  struct Record {
+    int64_t time_ns = 0; // CLOCK_REALTIME
+    int severity = 0;    // Sink-defined (plog::Severity for plog sinks)
+    uint32_t tid = 0;
+    uint32_t line = 0;
+    const char *func = "";
+    size_t func_len = 0;
+    const char *message = "";
+    size_t message_len = 0;
+  };
+
+  using Formatter = std::function<void(const Record &, std::string &out)>;
+  using Writer = std::function<void(const char *data, size_t size)>;
+
+  struct Stats {
+    uint64_t records = 0;        // Accepted into a ring
+    uint64_t dropped = 0;        // Rejected because a ring was full
+    uint64_t dropped_bytes = 0;
+    uint64_t truncated = 0;      // Longer than half a ring
+    uint64_t blocked = 0;        // Waited for the writer (block policy)
+    uint64_t batches = 0;        // Output writes issued by the writer
+    uint64_t bytes_written = 0;
+    size_t threads = 0;          // Live producer rings
+  };
+
+  static AsyncLogBackend &getInstance() {
+    static AsyncLogBackend instance;
+    return instance;
+  }
+
+  /**
+   * @brief Read configuration from the environment and start the writer
+   * @return false if disabled (EDGE_AI_ASYNC_LOG=0); logging stays
+   * synchronous
+   */
+  bool start();
+
+  /**
+   * @brief Start with an explicit configuration (tests)
+   */
+  void start(const Config &config);
+
+  /**
+   * @brief Drain everything, stop the writer and restore std streams
+   */
+  void shutdown();
+
+  /**
+   * @brief Write out everything logged so far (blocks up to timeout)
+   * Call before abort()/_exit() so the last lines are not lost.
+   */
+  void flush(std::chrono::milliseconds timeout = std::chrono::milliseconds(200));
+
+  bool isRunning() const { return running_.load(std::memory_order_acquire); }
+
+  // Output ids of fd 1 and 2; also the ids of their raw text sinks
+  static constexpr uint16_t STDOUT = 0;
+  static constexpr uint16_t STDERR = 1;
+  static constexpr size_t MAX_OUTPUTS = 16;
+  static constexpr size_t MAX_SINKS = 32;
+
+  /**
+   * @brief Register an output (file, fd); the writer calls it once per flush
+   * with all records of all its sinks, in time order
+   * @return Output id, or MAX_OUTPUTS if the table is full
+   */
+  uint16_t addOutput(const std::string &name, Writer writer);
+
+  /**
+   * @brief Register a sink: a record format for one output
+   * @param formatter Appends the formatted record to out; empty = raw text
+   * @return Sink id, or MAX_SINKS if the table is full
+   */
+  uint16_t addSink(Formatter formatter, uint16_t output);
+
+  /**
+   * @brief Log a record (lock-free unless the block policy has to wait)
+   * @return false if the record was dropped
+   */
+  bool log(uint16_t sink, const Record &record);
+
+  /**
+   * @brief Log raw text (time is taken now)
+   */
+  bool write(uint16_t sink, const char *data, size_t size);
+
+  /**
+   * @brief Route std::cout, std::cerr and std::clog through the backend
+   */
+  void redirectStdStreams();
+
+  Stats getStats() const;
+  Json::Value getStatsJson() const;
+  std::string getPrometheusMetrics() const;
+
+  static int64_t nowNs();
+
+private:
+  AsyncLogBackend();
+  ~AsyncLogBackend();
+  AsyncLogBackend(const AsyncLogBackend &) = delete;
+  AsyncLogBackend &operator=(const AsyncLogBackend &) = delete;
+
+  class Ring;
+  class LineBuf;
+  struct ThreadState;
+  struct Output {
+    std::string name;
+    Writer writer;
+    std::string batch; // Writer thread only (under drain_mutex_)
+  };
+  struct Sink {
+    Formatter formatter;
+    uint16_t output = STDOUT;
+  };
+
+  static ThreadState *threadState();
+  Ring *threadRing();
+  void writerLoop();
+  // Drain all rings into the sinks; caller holds drain_mutex_
+  void drainLocked();
+  void writeSync(uint16_t sink, const Record &record);
+  void flushOutputsLocked();
+
+  Config config_;
+  std::atomic<bool> running_{false};
+  std::atomic<bool> stopping_{false};
+  std::thread writer_;
+  std::mutex wake_mutex_;
+  std::condition_variable wake_cv_;
+  std::atomic<bool> wake_requested_{false};
+
+  std::timed_mutex drain_mutex_; // Single consumer: writer, flush(), sync path
+
+  // Append-only tables, readable without a lock up to the published count
+  std::mutex register_mutex_;
+  std::array<std::unique_ptr<Output>, MAX_OUTPUTS> outputs_;
+  std::array<std::unique_ptr<Sink>, MAX_SINKS> sinks_;
+  std::atomic<uint16_t> output_count_{0};
+  std::atomic<uint16_t> sink_count_{0};
+
+  mutable std::mutex rings_mutex_; // Ring registration (once per thread) and sweep
+  std::vector<std::shared_ptr<Ring>> rings_;
+
+  std::unique_ptr<LineBuf> stdout_buf_;
+  std::unique_ptr<LineBuf> stderr_buf_;
+  std::streambuf *orig_cout_ = nullptr;
+  std::streambuf *orig_cerr_ = nullptr;
+  std::streambuf *orig_clog_ = nullptr;
+
+  std::atomic<uint64_t> records_{0};
+  std::atomic<uint64_t> dropped_{0};
+  std::atomic<uint64_t> dropped_bytes_{0};
+  std::atomic<uint64_t> truncated_{0};
+  std::atomic<uint64_t> blocked_{0};
+  std::atomic<uint64_t> batches_{0};
+  std::atomic<uint64_t> bytes_written_{0};
+};
@@ -8,8 +8,10 @@
 
 #pragma once
 
+#include "core/queue_telemetry.h"
 #include <atomic>
 #include <chrono>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
@@ -27,25 +29,139 @@ enum class DropPolicy {
 };
 
 /**
- * @brief Backpressure statistics per instance
+ * @brief Per-instance backpressure state
+ *
+ * Returned by BackpressureController::registerInstance() as a stable handle.
+ * All per-frame methods are lock-free and do no hashing; fields written by
+ * different threads live on separate cache lines to avoid false sharing
+ * between the frame thread, the queue hooks and readers.
  */
-struct BackpressureStats {
-  std::atomic<uint64_t> frames_dropped{0};
-  std::atomic<uint64_t> frames_processed{0};
-  std::atomic<uint64_t> queue_full_count{0};
-  std::atomic<double> current_fps{0.0};
-  std::atomic<double> target_fps{30.0};
-  std::atomic<bool> backpressure_detected{false};
-  std::atomic<size_t> current_queue_size{
-      0}; // Current queue size for queue-based dropping
-  std::chrono::steady_clock::time_point last_drop_time;
-  std::chrono::steady_clock::time_point last_processed_time;
+class InstanceControl {
+public:
+  static constexpr size_t CACHE_LINE = 64;
+
+  InstanceControl(const std::string &instanceId,
+                  std::shared_ptr<QueueTelemetry::InstanceSeries> telemetry);
+
+  /**
+   * @brief Check if frame should be dropped (queue depth, then FPS pacing)
+   */
+  bool shouldDropFrame();
+
+  /**
+   * @brief Record frame processed (updates FPS, runs ADAPTIVE_FPS control)
+   */
+  void recordFrameProcessed();
+
+  /**
+   * @brief Record frame dropped
+   */
+  void recordFrameDropped();
+
+  /**
+   * @brief Record queue full event (runs ADAPTIVE_FPS control)
+   */
+  void recordQueueFull();
+
+  /**
+   * @brief Update current queue size (used when no telemetry is attached)
+   */
+  void updateQueueSize(size_t queue_size) {
+    current_queue_size_.store(queue_size, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Run one ADAPTIVE_FPS control step if the control interval elapsed
+   * Called from recordFrameProcessed()/recordQueueFull(); public for callers
+   * that want to drive the loop explicitly.
+   */
+  void updateAdaptiveFPS();
+
+  /**
+   * @brief Apply one step of the ADAPTIVE_FPS control law
+   * @param occupancy Queue occupancy sample (depth / max queue size)
+   * @param dt_seconds Time since previous step
+   * @return New target FPS
+   * Not thread-safe; updateAdaptiveFPS() serializes calls on the hot path.
+   */
+  double applyControlStep(double occupancy, double dt_seconds);
+
+  double getCurrentFPS() const {
+    return current_fps_.load(std::memory_order_relaxed);
+  }
+  double getTargetFPS() const {
+    return target_fps_.load(std::memory_order_relaxed);
+  }
+  double getMaxFPS() const { return max_fps_.load(std::memory_order_relaxed); }
+  size_t getMaxQueueSize() const {
+    return max_queue_size_.load(std::memory_order_relaxed);
+  }
+  DropPolicy getPolicy() const {
+    return policy_.load(std::memory_order_relaxed);
+  }
+  bool isBackpressureDetected() const {
+    return backpressure_detected_.load(std::memory_order_relaxed);
+  }
+  const std::string &instanceId() const { return instance_id_; }
+
+private:
+  friend class BackpressureController;
+
+  void configure(DropPolicy policy, double max_fps, size_t max_queue_size);
+  void setMaxQueueSize(size_t max_queue_size);
+  void setTargetFPS(double fps);
+  size_t currentQueueDepth() const;
+  void resetStats();
+  static int64_t nowNs();
+
+  // Read-mostly configuration (written by configure() only)
+  alignas(CACHE_LINE) std::atomic<DropPolicy> policy_{DropPolicy::DROP_NEWEST};
+  std::atomic<double> max_fps_{30.0}; // Configured ceiling
+  std::atomic<size_t> max_queue_size_{10};
+  std::atomic<int64_t> min_frame_interval_ns_{33333333};
+  std::atomic<double> target_fps_{30.0}; // May be reduced by ADAPTIVE_FPS
+  const std::string instance_id_;
+  const std::shared_ptr<QueueTelemetry::InstanceSeries> telemetry_;
+
+  // Frame pacing (frame thread)
+  alignas(CACHE_LINE) std::atomic<int64_t> last_frame_time_ns_{0};
+  std::atomic<uint64_t> drop_log_counter_{0};
+
+  // Frame counters (frame thread)
+  alignas(CACHE_LINE) std::atomic<uint64_t> frames_processed_{0};
+  std::atomic<uint64_t> frames_dropped_{0};
+  std::atomic<int64_t> last_processed_ns_{0};
+  std::atomic<int64_t> last_drop_ns_{0};
+  std::atomic<int64_t> fps_window_start_ns_{0};
+  std::atomic<uint64_t> fps_window_frames_{0};
+  std::atomic<double> current_fps_{0.0};
+
+  // Queue state (pipeline hook threads)
+  alignas(CACHE_LINE) std::atomic<uint64_t> queue_full_count_{0};
+  std::atomic<bool> backpressure_detected_{false};
+  std::atomic<size_t> current_queue_size_{0};
+
+  // ADAPTIVE_FPS controller state (guarded by control_busy_)
+  alignas(CACHE_LINE) std::atomic<bool> control_busy_{false};
+  std::atomic<int64_t> last_control_ns_{0};
+  double smoothed_occupancy_ = 0.0;
+  double previous_error_ = 0.0;
+  uint64_t last_queue_full_seen_ = 0;
 };
 
+/**
+ * @brief Stable per-instance handle (valid until the caller releases it)
+ */
+using InstanceHandle = std::shared_ptr<InstanceControl>;
+
 /**
  * @brief Backpressure Controller
  *
  * Quản lý backpressure và frame dropping để tránh queue overflow
+ *
+ * Hot paths should register once and keep the returned handle; the
+ * string-based methods remain for callers outside the frame path and take a
+ * shared lock plus one hash lookup per call.
  */
 class BackpressureController {
 public:
@@ -54,12 +170,37 @@ public:
     return instance;
   }
 
+  /**
+   * @brief Configure backpressure control for an instance and return its
+   * handle
+   *
+   * Re-registering an instance reconfigures and returns the existing handle,
+   * so handles captured by running hooks stay valid.
+   */
+  InstanceHandle registerInstance(const std::string &instanceId,
+                                  DropPolicy policy = DropPolicy::DROP_NEWEST,
+                                  double max_fps = 30.0,
+                                  size_t max_queue_size = 10);
+
+  /**
+   * @brief Get handle of a configured instance
+   * @return nullptr if instance is not configured
+   */
+  InstanceHandle getHandle(const std::string &instanceId) const;
+
+  /**
+   * @brief Remove an instance (existing handles keep working standalone)
+   */
+  void unregisterInstance(const std::string &instanceId);
+
   /**
    * @brief Configure backpressure control for an instance
    */
   void configure(const std::string &instanceId,
                  DropPolicy policy = DropPolicy::DROP_NEWEST,
-                 double max_fps = 30.0, size_t max_queue_size = 10);
+                 double max_fps = 30.0, size_t max_queue_size = 10) {
+    registerInstance(instanceId, policy, max_fps, max_queue_size);
+  }
 
   /**
    * @brief Check if frame should be dropped
@@ -121,6 +262,11 @@ public:
 
   BackpressureStatsSnapshot getStats(const std::string &instanceId) const;
 
+  /**
+   * @brief Get statistics snapshot from a handle
+   */
+  static BackpressureStatsSnapshot getStats(const InstanceControl &control);
+
   /**
    * @brief Reset statistics for instance
    */
@@ -146,45 +292,6 @@ public:
    */
   size_t getMaxQueueSize(const std::string &instanceId) const;
 
-private:
-  BackpressureController() = default;
-  ~BackpressureController() = default;
-  BackpressureController(const BackpressureController &) = delete;
-  BackpressureController &operator=(const BackpressureController &) = delete;
-
-  struct InstanceConfig {
-    DropPolicy policy;
-    // Use atomic for values accessed in hot path (shouldDropFrame)
-    std::atomic<double> max_fps{30.0};
-    std::atomic<int64_t> min_frame_interval_ms{33}; // 1000/30 FPS default
-    // Store time as nanoseconds since epoch for atomic access
-    std::atomic<int64_t> last_frame_time_ns{0};
-    size_t max_queue_size;
-
-    // Helper to get last_frame_time atomically
-    std::chrono::steady_clock::time_point getLastFrameTime() const {
-      int64_t ns = last_frame_time_ns.load(std::memory_order_relaxed);
-      if (ns == 0) {
-        return std::chrono::steady_clock::time_point{}; // Epoch
-      }
-      return std::chrono::steady_clock::time_point(
-          std::chrono::steady_clock::duration(std::chrono::nanoseconds(ns)));
-    }
-
-    // Helper to set last_frame_time atomically
-    void setLastFrameTime(const std::chrono::steady_clock::time_point &time) {
-      auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                    time.time_since_epoch())
-                    .count();
-      last_frame_time_ns.store(ns, std::memory_order_relaxed);
-    }
-  };
-
-  mutable std::shared_mutex stats_mutex_;  // For concurrent stats reads
-  mutable std::shared_mutex config_mutex_; // For concurrent config reads
-  std::unordered_map<std::string, InstanceConfig> configs_;
-  std::unordered_map<std::string, BackpressureStats> stats_;
-
   // Adaptive FPS parameters
   // Note: MIN_FPS should be > 0 to avoid division by zero when calculating
   // interval_ms Set to 12.0 to ensure minimum acceptable FPS (targeting 10-15
@@ -194,12 +301,25 @@ private:
   static constexpr double MAX_FPS =
       120.0; // Increased from 60.0 to support high FPS processing for multiple
              // instances
-  static constexpr double FPS_REDUCTION_FACTOR =
-      0.9; // Reduce by 10% when backpressure
-  static constexpr double FPS_INCREASE_FACTOR =
-      1.05; // Increase by 5% when stable
-  static constexpr std::chrono::milliseconds ADAPTIVE_UPDATE_INTERVAL{
-      1000}; // Update every 1 second
+
+  // ADAPTIVE_FPS control loop: incremental PI controller on queue occupancy
+  // (deepest node queue / max queue size). Output is the target FPS; each
+  // step is rate-limited so the target converges without oscillating.
+  static constexpr double OCCUPANCY_SETPOINT = 0.3;  // Keep queues ~30% full
+  static constexpr double OCCUPANCY_SMOOTHING = 0.3; // EWMA weight of sample
+  static constexpr double CONTROL_KP = 1.0;          // Per unit error change
+  static constexpr double CONTROL_KI = 0.4;          // Per unit error-second
+  static constexpr double MAX_STEP_FRACTION = 0.1; // Max change/step (of max)
+  static constexpr std::chrono::milliseconds ADAPTIVE_UPDATE_INTERVAL{250};
+
+private:
+  BackpressureController() = default;
+  ~BackpressureController() = default;
+  BackpressureController(const BackpressureController &) = delete;
+  BackpressureController &operator=(const BackpressureController &) = delete;
+
+  mutable std::shared_mutex mutex_; // Guards handles_ (not the handles)
+  std::unordered_map<std::string, InstanceHandle> handles_;
 };
 
 } // namespace BackpressureController
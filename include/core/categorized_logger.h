@@ -58,13 +58,11 @@ inline void init(const std::string &log_dir = "",
   // Initialize log manager
   LogManager::init(log_dir);
 
-  // Get console appender if enabled
-  static plog::ConsoleAppender<plog::TxtFormatter> consoleAppender;
-
-  // Initialize PLOG with console appender
+  // Initialize PLOG with console appender (queued on the async log
+  // backend like the file appenders)
   plog::Logger<0> *logger = nullptr;
   if (enable_console) {
-    logger = &plog::init<0>(log_level, &consoleAppender);
+    logger = &plog::init<0>(log_level, LogManager::getConsoleAppender());
   } else {
     logger = &plog::init<0>(log_level);
   }
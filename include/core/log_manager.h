@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/async_log.h"
 #include "core/env_config.h"
 #include "core/logging_flags.h"
 #include <atomic>
@@ -7,6 +8,7 @@
 #include <filesystem>
 #include <memory>
 #include <mutex>
+#include <plog/Appenders/IAppender.h>
 #include <plog/Appenders/RollingFileAppender.h>
 #include <plog/Formatters/TxtFormatter.h>
 #include <plog/Log.h>
@@ -16,6 +18,52 @@
 
 namespace fs = std::filesystem;
 
+/**
+ * @brief plog appender that queues records on AsyncLogBackend
+ *
+ * The calling thread only copies time, severity, thread id, function, line
+ * and message into its ring buffer. The log writer formats them like
+ * plog::TxtFormatter and hands each flush to the output in one write.
+ */
+class AsyncPlogAppender : public plog::IAppender {
+public:
+  /**
+   * @brief Append to a registered AsyncLogBackend output (e.g. STDOUT)
+   */
+  explicit AsyncPlogAppender(uint16_t output);
+
+  /**
+   * @brief Append to a plog appender that writes text as is (e.g. a
+   * RollingFileAppender<PreformattedFormatter>)
+   */
+  AsyncPlogAppender(const std::string &name,
+                    std::unique_ptr<plog::IAppender> target);
+
+  void write(const plog::Record &record) override;
+
+  /**
+   * @brief Format a record the way plog::TxtFormatter does
+   */
+  static void formatTxt(const AsyncLogBackend::Record &record,
+                        std::string &out);
+
+private:
+  std::unique_ptr<plog::IAppender> target_;
+  uint16_t sink_ = AsyncLogBackend::MAX_SINKS;
+};
+
+/**
+ * @brief plog formatter for text that was already formatted (batches from
+ * AsyncPlogAppender)
+ */
+class PreformattedFormatter {
+public:
+  static plog::util::nstring header() { return plog::util::nstring(); }
+  static plog::util::nstring format(const plog::Record &record) {
+    return record.getMessage();
+  }
+};
+
 /**
  * @brief Log Manager for categorized logging with disk space management
  *
@@ -24,6 +72,7 @@ namespace fs = std::filesystem;
  * - Daily log rotation: YYYY-MM-DD format
  * - Monthly cleanup: auto-delete logs older than 1 month
  * - Disk space monitoring: auto-cleanup when disk is nearly full
+ * - Asynchronous writes: appenders queue records on AsyncLogBackend
  */
 class LogManager {
 public:
@@ -53,10 +102,14 @@ public:
    * @brief Get appender for a specific category
    *
    * @param category Log category
-   * @return Pointer to RollingFileAppender
+   * @return Appender writing to the category's rolling file (asynchronously)
+   */
+  static plog::IAppender *getAppender(Category category);
+
+  /**
+   * @brief Get the console appender (stdout, asynchronous)
    */
-  static plog::RollingFileAppender<plog::TxtFormatter> *
-  getAppender(Category category);
+  static plog::IAppender *getConsoleAppender();
 
   /**
    * @brief Get log directory for a category
@@ -118,14 +171,17 @@ private:
   static int cleanup_interval_hours_;
 
   // Appenders for each category
-  static std::unique_ptr<plog::RollingFileAppender<plog::TxtFormatter>>
-      api_appender_;
-  static std::unique_ptr<plog::RollingFileAppender<plog::TxtFormatter>>
-      instance_appender_;
-  static std::unique_ptr<plog::RollingFileAppender<plog::TxtFormatter>>
-      sdk_output_appender_;
-  static std::unique_ptr<plog::RollingFileAppender<plog::TxtFormatter>>
-      general_appender_;
+  static std::unique_ptr<AsyncPlogAppender> api_appender_;
+  static std::unique_ptr<AsyncPlogAppender> instance_appender_;
+  static std::unique_ptr<AsyncPlogAppender> sdk_output_appender_;
+  static std::unique_ptr<AsyncPlogAppender> general_appender_;
+  static std::unique_ptr<AsyncPlogAppender> console_appender_;
+
+  /**
+   * @brief Create the asynchronous appender of a category log file
+   */
+  static std::unique_ptr<AsyncPlogAppender>
+  makeFileAppender(Category category, const std::string &path);
 
   // Cleanup thread
   static std::unique_ptr<std::thread> cleanup_thread_;
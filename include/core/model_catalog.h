@@ -0,0 +1,255 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <json/json.h>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <sys/types.h>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @brief In-memory catalog of model files
+ *
+ * Indexes model files under a set of root directories (CVEDIX_DATA_ROOT,
+ * CVEDIX_SDK_ROOT, /opt/edge_ai_api/models, system data dirs, ...) by path,
+ * directory, name, category and content checksum. The index is kept fresh
+ * with inotify (same approach as worker::ConfigFileWatcher), so model
+ * resolution and listing in PipelineBuilder no longer stat() the filesystem
+ * for every candidate path on every node creation.
+ *
+ * Lookups outside the indexed roots return Lookup::Unknown so callers can
+ * fall back to the filesystem.
+ */
+class ModelCatalog {
+public:
+  /**
+   * @brief Indexed model file
+   */
+  struct ModelEntry {
+    std::string path;      // Normalized absolute path (index key)
+    std::string canonicalPath;
+    std::string filename;  // e.g. "yunet_2023mar.onnx"
+    std::string name;      // Filename without extension
+    std::string category;  // Parent directory name (e.g. "face")
+    uint64_t size = 0;
+    int64_t modifiedTime = 0; // Seconds since epoch
+    std::string checksum;     // FNV-1a 64-bit hex, empty until computed
+
+    Json::Value toJson() const;
+  };
+
+  /**
+   * @brief Result of a catalog lookup
+   */
+  enum class Lookup {
+    Found,   // Path is indexed
+    Missing, // Path is inside an indexed root but does not exist
+    Unknown  // Path is not covered by the catalog - check the filesystem
+  };
+
+  static ModelCatalog &getInstance() {
+    static ModelCatalog instance;
+    return instance;
+  }
+
+  /**
+   * @brief Register the default model search roots (same order as
+   * PipelineBuilder::resolveModelPath)
+   */
+  void addDefaultRoots();
+
+  /**
+   * @brief Register a root directory to index (recursively)
+   * Roots that do not exist yet are re-checked periodically by the watcher.
+   */
+  void addRoot(const std::string &dir);
+
+  /**
+   * @brief Index all roots and start the inotify watcher thread
+   */
+  void start();
+
+  /**
+   * @brief Stop the watcher thread
+   */
+  void stop();
+
+  /**
+   * @brief Check if catalog is serving lookups
+   */
+  bool isRunning() const { return running_.load(std::memory_order_acquire); }
+
+  /**
+   * @brief Check whether a file exists according to the catalog
+   */
+  Lookup lookupFile(const std::string &path) const;
+
+  /**
+   * @brief Check whether a directory exists according to the catalog
+   */
+  Lookup lookupDirectory(const std::string &dir) const;
+
+  /**
+   * @brief List indexed files in a directory
+   * @param dir Directory path
+   * @param recursive Include files in subdirectories
+   * @param out Output entries (sorted by path)
+   * @return false if directory is not covered by the catalog
+   */
+  bool listDirectory(const std::string &dir, bool recursive,
+                     std::vector<ModelEntry> &out) const;
+
+  /**
+   * @brief Get a single entry
+   * @return false if path is not indexed
+   */
+  bool getEntry(const std::string &path, ModelEntry &out) const;
+
+  /**
+   * @brief Find entries by name (filename without extension, case-insensitive)
+   */
+  std::vector<ModelEntry> findByName(const std::string &name) const;
+
+  /**
+   * @brief Find entries by category (parent directory name)
+   */
+  std::vector<ModelEntry> findByCategory(const std::string &category) const;
+
+  /**
+   * @brief Find entries by content checksum
+   * Computes missing checksums on demand (reads model files).
+   */
+  std::vector<ModelEntry> findByChecksum(const std::string &checksum);
+
+  /**
+   * @brief Get content checksum of an indexed file, computing it if needed
+   * @return Checksum or empty string if file is not indexed / unreadable
+   */
+  std::string getChecksum(const std::string &path);
+
+  /**
+   * @brief Incrementally (re)index a file after it was written or renamed
+   * @param path File path
+   * @param checksum Checksum if already known by the caller (e.g. computed
+   * from an upload body), empty otherwise
+   */
+  void notifyFileChanged(const std::string &path,
+                         const std::string &checksum = "");
+
+  /**
+   * @brief Remove a file from the index after it was deleted or renamed
+   */
+  void notifyFileRemoved(const std::string &path);
+
+  /**
+   * @brief Look up a cached resolution result
+   * Cached results are dropped whenever the catalog changes.
+   */
+  bool getCachedResolution(const std::string &key, std::string &value) const;
+
+  /**
+   * @brief Store a resolution result
+   * @param generation Catalog generation read before resolving; the result is
+   * discarded if the catalog changed in the meantime
+   */
+  void cacheResolution(const std::string &key, const std::string &value,
+                       uint64_t generation);
+
+  /**
+   * @brief Catalog generation (incremented on every index change)
+   */
+  uint64_t getGeneration() const {
+    return generation_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Catalog statistics (entry count, roots, cache hits, ...)
+   */
+  Json::Value getStatistics() const;
+
+  /**
+   * @brief Compute FNV-1a 64-bit checksum of a memory buffer (hex string)
+   */
+  static std::string computeChecksum(const void *data, size_t size);
+
+  /**
+   * @brief Compute FNV-1a 64-bit checksum of a file (hex string)
+   * @return Checksum or empty string if file cannot be read
+   */
+  static std::string computeFileChecksum(const std::string &path);
+
+  /**
+   * @brief Check whether a filename looks like a model file
+   */
+  static bool isModelFilename(const std::string &filename);
+
+  /**
+   * @brief Normalize a path (absolute + lexically normal, no trailing slash)
+   * Does not touch the filesystem.
+   */
+  static std::string normalizePath(const std::string &path);
+
+private:
+  ModelCatalog() = default;
+  ~ModelCatalog();
+  ModelCatalog(const ModelCatalog &) = delete;
+  ModelCatalog &operator=(const ModelCatalog &) = delete;
+
+  // All helpers below expect mutex_ to be held exclusively
+  void scanRootLocked(const std::string &root);
+  void scanDirectoryLocked(const std::string &dir);
+  void indexFileLocked(const std::string &path, const std::string &checksum);
+  void removeFileLocked(const std::string &path);
+  void removeDirectoryLocked(const std::string &dir);
+  void addWatchLocked(const std::string &dir);
+  void rescanAllLocked();
+  void bumpGenerationLocked();
+
+  Lookup lookupLocked(const std::string &normalized, bool isDirectory) const;
+  const std::string *findRoot(const std::string &normalized) const;
+  std::vector<ModelEntry>
+  collectEntries(const std::set<std::string> &paths) const;
+
+  void watchLoop();
+  void processEvents(const char *buffer, ssize_t length);
+  void checkAbsentRoots();
+
+  mutable std::shared_mutex mutex_;
+  std::vector<std::string> roots_;       // Existing, indexed roots
+  std::vector<std::string> absent_roots_; // Registered but not existing yet
+
+  std::unordered_map<std::string, ModelEntry> entries_;
+  // directory -> filenames of indexed files
+  std::unordered_map<std::string, std::set<std::string>> directories_;
+  // Subdirectories skipped during scan (symlinks) - lookups fall back
+  std::unordered_set<std::string> opaque_dirs_;
+  std::unordered_map<std::string, std::set<std::string>> by_name_;
+  std::unordered_map<std::string, std::set<std::string>> by_category_;
+  std::unordered_map<std::string, std::set<std::string>> by_checksum_;
+
+  mutable std::mutex cache_mutex_;
+  std::unordered_map<std::string, std::string> resolution_cache_;
+  uint64_t cache_generation_ = 0;
+  mutable std::atomic<uint64_t> cache_hits_{0};
+  mutable std::atomic<uint64_t> cache_misses_{0};
+
+  std::atomic<uint64_t> generation_{0};
+  std::atomic<bool> running_{false};
+  std::atomic<bool> should_stop_{false};
+  std::thread watch_thread_;
+
+  // inotify
+  int inotify_fd_ = -1;
+  std::unordered_map<int, std::string> watch_to_dir_;
+  std::unordered_map<std::string, int> dir_to_watch_;
+
+  static constexpr int POLL_TIMEOUT_MS = 500;
+  static constexpr int ABSENT_ROOT_CHECK_MS = 5000;
+  static constexpr int POLLING_RESCAN_MS = 10000; // When inotify unavailable
+};
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Motion detection that decides which frames reach the detector
+ *
+ * Used by the motion_gate node (SmartDetection mode): frames are converted to
+ * small grayscale images (analysis_width wide) and compared against a running
+ * background. Only frames with motion are forwarded, plus a keep-alive frame
+ * every keepalive_ms so downstream state (tracks, OSD, outputs) stays fresh
+ * on static scenes, and hold_ms of frames after motion stops so tracks can
+ * leave the scene cleanly.
+ *
+ * The background is kept in 12.4 fixed point and the per-pixel loop is plain
+ * integer arithmetic without branches, so the compiler vectorizes it; no SDK
+ * or OpenCV dependency.
+ *
+ * Parameter values that are missing, empty or an unresolved "${VARIABLE}"
+ * placeholder fall back to the defaults; malformed values throw
+ * std::invalid_argument.
+ */
+class MotionGate {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Options {
+    int pixel_threshold = 30;  // Grey levels a pixel must change by
+    double min_area = 0.01;    // Changed pixel fraction counted as motion
+    double scene_change_area = 0.6; // Lights on/off, camera moved
+    int analysis_width = 160;
+    int keepalive_ms = 1000;
+    int hold_ms = 1000;
+    int learn_shift = 4; // Background follows at 1/2^learn_shift per frame
+  };
+
+  enum class Decision {
+    Initial,     // First frame (background initialised), forwarded
+    Motion,      // Forwarded
+    Hold,        // No motion, but within hold_ms of the last motion
+    KeepAlive,   // Static; periodic frame forwarded
+    SceneChange, // Most of the frame changed; background reset, forwarded
+    Skip         // Static; not forwarded
+  };
+
+  /**
+   * @brief Defaults for a movementSensitivity preset ("Low", "Medium",
+   * "High"; anything else = Low)
+   */
+  static Options optionsForSensitivity(const std::string &sensitivity);
+
+  /**
+   * @brief Options from node parameters: sensitivity, pixel_threshold,
+   * min_area, analysis_width, keepalive_ms, hold_ms
+   */
+  static Options parseOptions(const std::map<std::string, std::string> &params);
+
+  static bool forwards(Decision decision) { return decision != Decision::Skip; }
+  static const char *decisionName(Decision decision);
+
+  MotionGate() = default;
+  explicit MotionGate(const Options &options) : options_(options) {}
+
+  const Options &options() const { return options_; }
+
+  /**
+   * @brief Analysis image height for a frame, keeping the aspect ratio
+   */
+  int analysisHeight(int frameWidth, int frameHeight) const;
+
+  /**
+   * @brief Feed one downscaled 8-bit grayscale frame
+   * @param stride Bytes per row (>= width)
+   */
+  Decision update(const uint8_t *gray, int width, int height, size_t stride,
+                  Clock::time_point now = Clock::now());
+
+  uint64_t frames() const { return frames_; }
+  uint64_t forwarded() const { return forwarded_; }
+  /** @brief Changed pixel fraction of the last frame */
+  double lastChangedFraction() const { return last_fraction_; }
+
+private:
+  void resetBackground(const uint8_t *gray, int width, int height,
+                       size_t stride);
+
+  Options options_;
+  int width_ = 0;
+  int height_ = 0;
+  std::vector<int16_t> background_; // Grey level << 4
+  Clock::time_point last_motion_{};
+  Clock::time_point last_forward_{};
+  bool has_motion_ = false;
+  uint64_t frames_ = 0;
+  uint64_t forwarded_ = 0;
+  double last_fraction_ = 0.0;
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "core/motion_gate.h"
+#include <atomic>
+#include <cvedix/nodes/common/cvedix_node.h>
+#include <cvedix/objects/cvedix_frame_meta.h>
+#include <cvedix/objects/cvedix_frame_target.h>
+#include <cvedix/objects/cvedix_meta.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <opencv2/core.hpp>
+#include <set>
+#include <string>
+#include <vector>
+
+class MotionGateJoinNode;
+
+/**
+ * @brief Node between source and detector that keeps static frames away
+ * from the detector
+ *
+ * Each channel gets its own MotionGate. Frames with motion plus the
+ * keep-alive and hold frames go to the detector. With a join node set (see
+ * MotionGateJoinNode), skipped frames are handed straight to it and leave
+ * the join with the channel's last detections attached, so the tracker, BA
+ * and output nodes still run at the source rate and tracks are carried
+ * across static periods. Without a join, skipped frames are dropped.
+ */
+class MotionGateNode : public cvedix_nodes::cvedix_node {
+public:
+  MotionGateNode(const std::string &node_name,
+                 const MotionGate::Options &options);
+  ~MotionGateNode();
+
+  // Node placed after the detector that re-joins skipped frames
+  void setJoin(const std::shared_ptr<MotionGateJoinNode> &join);
+
+  const MotionGate::Options &options() const { return options_; }
+  uint64_t frames() const { return frames_.load(); }
+  uint64_t forwarded() const { return forwarded_.load(); }
+  uint64_t carried() const { return carried_.load(); }
+
+protected:
+  std::shared_ptr<cvedix_objects::cvedix_meta> handle_frame_meta(
+      std::shared_ptr<cvedix_objects::cvedix_frame_meta> meta) override;
+
+private:
+  struct Channel {
+    explicit Channel(const MotionGate::Options &options) : gate(options) {}
+    MotionGate gate;
+    cv::Mat small;
+    cv::Mat gray;
+  };
+
+  Channel &channel(int index);
+
+  MotionGate::Options options_;
+  std::mutex channels_mutex_;
+  std::map<int, std::unique_ptr<Channel>> channels_;
+  std::weak_ptr<MotionGateJoinNode> join_;
+  std::atomic<uint64_t> frames_{0};
+  std::atomic<uint64_t> forwarded_{0};
+  std::atomic<uint64_t> carried_{0};
+};
+
+/**
+ * @brief Node right after the detector that merges frames the gate skipped
+ *
+ * Frames from the detector pass through and their targets are remembered
+ * per channel. Skipped frames arrive from the gate via carry() and get
+ * copies of those targets. A skipped frame is only carried once every frame
+ * the gate sent to the detector has come out of it, so frames of a channel
+ * leave in order; otherwise carry() refuses and the gate drops the frame.
+ */
+class MotionGateJoinNode : public cvedix_nodes::cvedix_node {
+public:
+  explicit MotionGateJoinNode(const std::string &node_name);
+  ~MotionGateJoinNode();
+
+  // Called by the gate for each frame it sends to the detector
+  void expect(const cvedix_objects::cvedix_frame_meta &meta);
+
+  // Called by the gate for a skipped frame; false if it has to be dropped
+  bool carry(const std::shared_ptr<cvedix_objects::cvedix_frame_meta> &meta);
+
+protected:
+  std::shared_ptr<cvedix_objects::cvedix_meta> handle_frame_meta(
+      std::shared_ptr<cvedix_objects::cvedix_frame_meta> meta) override;
+
+private:
+  struct Channel {
+    int last_sent = -1;
+    int last_detected = -1;
+    std::vector<std::shared_ptr<cvedix_objects::cvedix_frame_target>> targets;
+  };
+
+  std::mutex mutex_;
+  std::map<int, Channel> channels_;
+  std::set<const cvedix_objects::cvedix_frame_meta *> carried_;
+};
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <json/json.h>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Bounded executor for long-running instance operations
+ *
+ * Stop, restart, delete, line/jam/stop-triggered restarts and batch actions
+ * run here instead of on detached threads. Every operation gets an ID that
+ * clients poll through GET /v1/core/operations/{id} for state and progress.
+ *
+ * - A fixed pool of worker threads bounds how many pipelines are torn down
+ *   or rebuilt at once (they all serialize on GStreamer locks anyway).
+ * - Operations with the same key (the instance ID) run one at a time in
+ *   submission order, so a delete can never overlap a restart of the same
+ *   instance. Different keys run in parallel up to the pool size.
+ * - A batch is a parent operation whose children are ordinary keyed
+ *   operations; its progress and state are derived from the children.
+ *   Batches may cap their own parallelism, time out slow children and
+ *   report each finished child to an observer (group actions stream these).
+ * - Finished operations are kept for inspection up to max_retained /
+ *   retention, oldest first.
+ */
+class OperationExecutor {
+public:
+  enum class State { Queued, Running, Succeeded, Failed, Cancelled };
+
+  /**
+   * @brief Handed to a running task to publish progress
+   */
+  class Progress {
+  public:
+    /**
+     * @param fraction 0.0-1.0 (clamped, never moves backwards)
+     * @param step Short description of the current step
+     */
+    void report(double fraction, const std::string &step);
+
+  private:
+    friend class OperationExecutor;
+    Progress(OperationExecutor &executor, std::string id)
+        : executor_(executor), id_(std::move(id)) {}
+    OperationExecutor &executor_;
+    std::string id_;
+  };
+
+  /**
+   * @brief Operation body
+   * @param error Set to a message when returning false
+   * @return true on success (exceptions count as failure)
+   */
+  using Task = std::function<bool(Progress &progress, std::string &error)>;
+
+  struct BatchItem {
+    std::string key; // Instance ID
+    Task task;
+  };
+
+  /**
+   * @brief Batch progress callback
+   * @param event "instance" when a child finished (data = child operation),
+   * "done" when the whole batch finished (data = batch with children)
+   *
+   * Called outside the executor lock, in order, never concurrently for the
+   * same executor. Must not block.
+   */
+  using BatchObserver =
+      std::function<void(const std::string &event, const Json::Value &data)>;
+
+  struct BatchOptions {
+    size_t max_parallel = 0; // Children queued at once, 0 = pool size only
+    // A child still running after this is reported Failed; its task keeps
+    // the worker (and its instance key) until it really returns. 0 = none.
+    std::chrono::milliseconds item_timeout{0};
+    BatchObserver observer;
+  };
+
+  struct Config {
+    size_t worker_threads = 4;
+    size_t max_pending = 1024;  // Submissions beyond this are rejected
+    size_t max_retained = 1000; // Finished operations kept for GET
+    std::chrono::seconds retention{3600};
+  };
+
+  struct Stats {
+    size_t workers = 0;
+    size_t queued = 0;  // Including batch children waiting for a slot
+    size_t running = 0;
+    size_t retained = 0;
+    uint64_t submitted = 0;
+    uint64_t succeeded = 0;
+    uint64_t failed = 0;
+    uint64_t cancelled = 0;
+    uint64_t rejected = 0;        // max_pending reached
+    uint64_t timed_out = 0;       // Batch children past their timeout
+    double avg_queue_ms = 0.0;    // Submit -> start
+    double avg_run_ms = 0.0;      // Start -> finish
+    double completed_per_minute = 0.0; // Over the last 60 s
+  };
+
+  static OperationExecutor &getInstance() {
+    static OperationExecutor instance;
+    return instance;
+  }
+
+  /**
+   * @brief Read config from the optional "system.operations" section
+   * EDGE_AI_OPERATION_WORKERS overrides worker_threads.
+   */
+  static Config loadConfig();
+
+  /**
+   * @brief Apply configuration and (re)start worker threads
+   * Queued operations are kept; running ones finish before the old threads
+   * exit. Call from startup code only (not concurrently with submit()).
+   */
+  void configure(const Config &config);
+
+  /**
+   * @brief Stop worker threads; queued operations become Cancelled
+   */
+  void shutdown();
+
+  /**
+   * @brief Queue an operation
+   * @param type Operation type shown to clients ("restart", "delete", ...)
+   * @param key Serialization key (instance ID); empty = no serialization
+   * @return Operation ID, or empty string when the queue is full
+   */
+  std::string submit(const std::string &type, const std::string &key,
+                     Task task);
+
+  /**
+   * @brief Queue one child operation per item under a parent operation
+   * @return Parent operation ID, or empty string when the queue is full
+   * (nothing is queued then)
+   */
+  std::string submitBatch(const std::string &type,
+                          std::vector<BatchItem> items);
+  std::string submitBatch(const std::string &type, std::vector<BatchItem> items,
+                          BatchOptions options);
+
+  /**
+   * @brief Wait until the operation is finished
+   * @return Final state, or std::nullopt on timeout / unknown ID
+   */
+  std::optional<State>
+  wait(const std::string &id,
+       std::chrono::milliseconds timeout = std::chrono::milliseconds::max());
+
+  std::optional<State> getState(const std::string &id) const;
+
+  /**
+   * @brief Operation as returned by GET /v1/core/operations/{id}
+   * Batches include their children.
+   */
+  std::optional<Json::Value> getOperationJson(const std::string &id) const;
+
+  /**
+   * @brief Most recent operations first (top-level only unless key is set)
+   * @param key Only operations for this instance (empty = all)
+   */
+  Json::Value listOperationsJson(const std::string &key, size_t limit) const;
+
+  Stats getStats() const;
+  Json::Value getStatsJson() const;
+
+  static const char *stateName(State state);
+  static bool isFinished(State state) {
+    return state == State::Succeeded || state == State::Failed ||
+           state == State::Cancelled;
+  }
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Operation {
+    std::string id;
+    std::string type;
+    std::string key;
+    std::string parent_id;
+    bool batch = false;
+    std::vector<std::string> children;
+    // Batch: children not queued yet (max_parallel) and the observer
+    std::deque<std::shared_ptr<Operation>> deferred;
+    std::shared_ptr<BatchObserver> observer;
+    std::chrono::milliseconds timeout{0};
+    Task task;
+    State state = State::Queued;
+    double progress = 0.0;
+    std::string step;
+    std::string error;
+    Clock::time_point created;
+    Clock::time_point started;
+    Clock::time_point finished;
+    std::chrono::system_clock::time_point created_wall;
+  };
+
+  OperationExecutor() = default;
+  ~OperationExecutor() { shutdown(); }
+  OperationExecutor(const OperationExecutor &) = delete;
+  OperationExecutor &operator=(const OperationExecutor &) = delete;
+
+  struct PendingEvent {
+    std::shared_ptr<BatchObserver> observer;
+    std::string event;
+    Json::Value data;
+  };
+
+  void workerLoop();
+  void timerLoop();
+  void startWorkersLocked();
+  void joinThreads();
+  void dispatchEvents();
+  std::shared_ptr<Operation> newOperation(const std::string &type,
+                                          const std::string &key);
+  void enqueueLocked(const std::shared_ptr<Operation> &op);
+  void finishLocked(Operation &op, State state, const std::string &error);
+  void updateParentLocked(const std::string &parentId);
+  void pruneLocked();
+  void setProgress(const std::string &id, double fraction,
+                   const std::string &step);
+  Json::Value toJsonLocked(const Operation &op, bool withChildren) const;
+
+  Config config_;
+  std::vector<std::thread> workers_;
+  std::thread timer_; // Enforces batch item timeouts
+  std::atomic<bool> running_{false};
+  bool accepting_ = true;
+
+  mutable std::mutex mutex_;
+  std::condition_variable work_cv_;
+  std::condition_variable done_cv_;
+  std::condition_variable timer_cv_;
+  std::unordered_map<std::string, std::shared_ptr<Operation>> operations_;
+  std::deque<std::string> order_; // Creation order, for listing and pruning
+  // Per-key FIFO of operations not yet started
+  std::unordered_map<std::string, std::deque<std::shared_ptr<Operation>>>
+      pending_;
+  std::unordered_set<std::string> busy_keys_; // Key has a running operation
+  std::deque<std::string> ready_keys_;        // Runnable keys, FIFO
+  size_t pending_count_ = 0;
+  size_t deferred_count_ = 0; // Batch children held back by max_parallel
+  size_t running_count_ = 0;
+  std::vector<std::shared_ptr<Operation>> timed_; // Running, with timeout
+  std::vector<PendingEvent> events_;              // For dispatchEvents()
+  std::mutex dispatch_mutex_; // Keeps observer calls ordered
+  std::deque<Clock::time_point> recent_finishes_;
+
+  uint64_t submitted_ = 0;
+  uint64_t succeeded_ = 0;
+  uint64_t failed_ = 0;
+  uint64_t cancelled_ = 0;
+  uint64_t rejected_ = 0;
+  uint64_t timed_out_ = 0;
+  double total_queue_ms_ = 0.0;
+  double total_run_ms_ = 0.0;
+  uint64_t started_ = 0;
+  uint64_t finished_ = 0;
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/model_catalog.h"
 #include "instances/instance_info.h"
 #include "models/create_instance_request.h"
 #include "models/solution_config.h"
@@ -602,6 +603,66 @@ private:
       const CreateInstanceRequest &req);
 #endif
 
+  // ========== Synthetic Nodes (load testing, no models) ==========
+
+  /**
+   * @brief Create synthetic source node (generated frames, width/height/fps)
+   */
+  std::shared_ptr<cvedix_nodes::cvedix_node>
+  createSyntheticSourceNode(const std::string &nodeName,
+                            const std::map<std::string, std::string> &params);
+
+  /**
+   * @brief Create synthetic detector node (latency_ms, boxes, ...)
+   */
+  std::shared_ptr<cvedix_nodes::cvedix_node>
+  createSyntheticDetectorNode(const std::string &nodeName,
+                              const std::map<std::string, std::string> &params);
+
+  /**
+   * @brief Create pass-through synthetic BA node
+   */
+  std::shared_ptr<cvedix_nodes::cvedix_node>
+  createSyntheticBANode(const std::string &nodeName);
+
+  /**
+   * @brief Create synthetic broker node (serializes and drops messages)
+   */
+  std::shared_ptr<cvedix_nodes::cvedix_node>
+  createSyntheticBrokerNode(const std::string &nodeName,
+                            const std::map<std::string, std::string> &params);
+
+  // ========== Offline Video Job Nodes ==========
+
+  /**
+   * @brief Create unpaced file source for one segment of an offline job
+   * (file_path, start_sec, end_sec, fps, resize_ratio)
+   */
+  std::shared_ptr<cvedix_nodes::cvedix_node>
+  createOfflineSegmentSourceNode(
+      const std::string &nodeName,
+      const std::map<std::string, std::string> &params);
+
+  // ========== Motion Gate ==========
+
+  /**
+   * @brief Create motion gate node (sensitivity, pixel_threshold, min_area,
+   * analysis_width, keepalive_ms, hold_ms); sensitivity defaults to
+   * req.movementSensitivity
+   */
+  std::shared_ptr<cvedix_nodes::cvedix_node>
+  createMotionGateNode(const std::string &nodeName,
+                       const std::map<std::string, std::string> &params,
+                       const CreateInstanceRequest &req);
+
+  /**
+   * @brief Whether buildPipeline() inserts a motion gate before the first
+   * detector: detectorMode "SmartDetection" and additionalParams MOTION_GATE
+   * set to true. A gate, inserted or from the solution, gets a join node
+   * after the detector it feeds (see MotionGateJoinNode)
+   */
+  static bool motionGateRequested(const CreateInstanceRequest &req);
+
   /**
    * @brief Map detection sensitivity to threshold value
    * @param sensitivity "Low", "Medium", or "High"
@@ -652,4 +713,27 @@ private:
    */
   std::vector<std::string>
   listAvailableModels(const std::string &category = "") const;
+
+  /**
+   * @brief Uncached implementations of resolveModelPath / resolveModelByName
+   * (results are memoized in ModelCatalog until the catalog changes)
+   */
+  std::string resolveModelPathUncached(const std::string &relativePath) const;
+  std::string resolveModelByNameUncached(const std::string &modelName,
+                                         const std::string &category) const;
+
+  /**
+   * @brief Check if a model file / directory exists
+   * Answered from ModelCatalog when it covers the path, otherwise from the
+   * filesystem
+   */
+  bool modelFileExists(const std::string &path) const;
+  bool modelDirectoryExists(const std::string &dir) const;
+
+  /**
+   * @brief List regular files in a model directory (non-recursive)
+   * Entries from the filesystem fallback have an empty canonicalPath.
+   */
+  std::vector<ModelCatalog::ModelEntry>
+  listModelDirectory(const std::string &dir) const;
 };
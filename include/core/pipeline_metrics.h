@@ -0,0 +1,120 @@
+#pragma once
+
+#include "core/backpressure_controller.h"
+#include "core/queue_telemetry.h"
+#include <atomic>
+#include <cstdint>
+#include <json/json.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Per-instance pipeline metrics for Prometheus
+ *
+ * Every instance registers once (pipeline start in-process, first pushed
+ * statistics in subprocess mode) and gets a set of atomic counters. The
+ * registry keeps an immutable, sorted list of entries behind an atomically
+ * swapped shared_ptr: register/remove copy the list, a scrape loads it once
+ * and reads only atomics (the counters, the BackpressureController handle
+ * and the QueueTelemetry node series). A scrape therefore never takes a lock
+ * that the frame path also takes and never talks to a worker; its cost is
+ * O(instances + nodes).
+ */
+class PipelineMetricsRegistry {
+public:
+  /**
+   * @brief Counters owned by the registry
+   *
+   * In-process instances only use frames_incoming and the reconnect counters;
+   * processed/dropped/FPS/queue come from the BackpressureController handle.
+   * Subprocess instances have no handle in this process, so the last pushed
+   * worker statistics are stored in the remaining fields. Workers that do
+   * not report incoming frames or RTSP reconnects clear the has_* flags and
+   * those series are left out instead of exported as 0.
+   */
+  struct Counters {
+    std::atomic<uint64_t> frames_incoming{0};
+    std::atomic<uint64_t> frames_processed{0};
+    std::atomic<uint64_t> frames_dropped{0};
+    std::atomic<uint64_t> queue_size{0};
+    std::atomic<double> fps{0.0};
+    std::atomic<double> latency_ms{0.0};
+    std::atomic<uint64_t> reconnect_attempts{0};
+    std::atomic<uint64_t> reconnect_failures{0};
+    std::atomic<bool> has_incoming{true};
+    std::atomic<bool> has_reconnects{true};
+  };
+
+  static PipelineMetricsRegistry &getInstance() {
+    static PipelineMetricsRegistry instance;
+    return instance;
+  }
+
+  /**
+   * @brief Register an in-process pipeline (idempotent, keeps counters)
+   * @param backpressure Handle read for processed/dropped/FPS/queue, or null
+   * @param telemetry Node queue series exported per node, or null
+   * @return Counters of the instance (never null)
+   */
+  std::shared_ptr<Counters>
+  attach(const std::string &instanceId,
+         BackpressureController::InstanceHandle backpressure = nullptr,
+         std::shared_ptr<QueueTelemetry::InstanceSeries> telemetry = nullptr);
+
+  /**
+   * @brief Get the counters of an instance, registering it if needed
+   */
+  std::shared_ptr<Counters> counters(const std::string &instanceId);
+
+  /**
+   * @brief Store statistics pushed by a worker (subprocess mode)
+   * @param statistics GET_STATISTICS style object (frames_processed, ...;
+   * optional frames_incoming, rtsp_reconnect_attempts and
+   * rtsp_reconnect_failures)
+   */
+  void updateFromStatistics(const std::string &instanceId,
+                            const Json::Value &statistics);
+
+  /**
+   * @brief Count an RTSP reconnect attempt and whether it failed
+   */
+  void recordReconnect(const std::string &instanceId, bool success);
+
+  /**
+   * @brief Stop exporting an instance (instance deleted)
+   */
+  void remove(const std::string &instanceId);
+
+  size_t size() const;
+
+  /**
+   * @brief Labelled per-instance and per-node metrics in Prometheus format
+   */
+  std::string getPrometheusMetrics() const;
+
+private:
+  PipelineMetricsRegistry();
+  PipelineMetricsRegistry(const PipelineMetricsRegistry &) = delete;
+  PipelineMetricsRegistry &operator=(const PipelineMetricsRegistry &) = delete;
+
+  struct Entry {
+    std::string instance_id;
+    std::string label; // instance_id escaped for a label value
+    std::shared_ptr<Counters> counters;
+    BackpressureController::InstanceHandle backpressure;
+    std::shared_ptr<QueueTelemetry::InstanceSeries> telemetry;
+  };
+  using Snapshot = std::vector<Entry>;
+
+  std::shared_ptr<const Snapshot> load() const {
+    return std::atomic_load(&snapshot_);
+  }
+  static const Entry *find(const Snapshot &snapshot,
+                           const std::string &instanceId);
+  static Entry &findOrInsert(Snapshot &snapshot, const std::string &instanceId);
+
+  std::mutex write_mutex_; // Serializes copy-on-write updates only
+  std::shared_ptr<const Snapshot> snapshot_;
+};
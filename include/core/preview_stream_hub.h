@@ -0,0 +1,225 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <json/json.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Shared live preview streams (MJPEG / binary WebSocket)
+ *
+ * Viewers subscribe to an instance with a variant (max FPS, output width).
+ * One background thread pulls the latest frame of every watched instance
+ * once per due tick, scales/encodes it once per variant and pushes the same
+ * buffer to every viewer of that variant. Instances nobody watches are never
+ * fetched or encoded, and the thread sleeps while there are no viewers.
+ *
+ * Viewers are removed when their connection closes (removeViewer from a
+ * close handler, or an AliveFn polled every tick), when a push fails, and
+ * when their instance is deleted.
+ *
+ * Each viewer gets a frame it has not seen yet, so a new viewer receives the
+ * current picture on the next tick. A slow viewer with max_frames_in_flight
+ * payloads not yet handed to its connection skips frames instead of
+ * queueing them.
+ *
+ * Frame access and JPEG scaling are injected (setFrameSource /
+ * setTranscoder), so the hub itself has no OpenCV or Drogon dependency.
+ */
+class PreviewStreamHub {
+public:
+  using ViewerId = uint64_t;
+  using Payload = std::shared_ptr<const std::string>;
+
+  /**
+   * @brief Called by a PushFn once the payload reached the connection (may
+   * be called from any thread, exactly once per accepted push)
+   */
+  using Sent = std::function<void()>;
+
+  /**
+   * @brief Delivers a payload to one viewer
+   * @return false if the viewer is gone (it is removed; sent is not called)
+   */
+  using PushFn = std::function<bool(const Payload &payload, Sent sent)>;
+
+  /**
+   * @brief Whether a viewer's connection is still open
+   *
+   * Checked on every due tick, also when nothing is pushed (static scene,
+   * stopped instance), so a closed client frees its slot without a failed
+   * push.
+   */
+  using AliveFn = std::function<bool()>;
+
+  /**
+   * @brief Returns the latest JPEG of an instance (empty if none)
+   */
+  using FrameSource = std::function<std::string(const std::string &instanceId)>;
+
+  /**
+   * @brief Scales a JPEG to the given width (keeps aspect ratio)
+   * @return Re-encoded JPEG, or empty string on failure
+   */
+  using Transcoder = std::function<std::string(const std::string &jpeg,
+                                               int width, int quality)>;
+
+  /**
+   * @brief How a viewer wants frames framed
+   */
+  enum class Framing {
+    Jpeg,         // Raw JPEG bytes (binary WebSocket message)
+    MultipartPart // multipart/x-mixed-replace part incl. boundary
+  };
+
+  struct Variant {
+    int max_fps = 5;
+    int width = 0; // 0 = source resolution
+
+    bool operator==(const Variant &other) const {
+      return max_fps == other.max_fps && width == other.width;
+    }
+  };
+
+  struct Config {
+    int max_fps = 30;
+    int min_width = 64;
+    int max_width = 3840;
+    int jpeg_quality = 80;
+    size_t max_viewers = 64; // Over all instances
+    int max_frames_in_flight = 2; // Per viewer, before frames are skipped
+  };
+
+  struct Stats {
+    size_t viewers = 0;
+    size_t instances = 0; // Watched instances
+    size_t variants = 0;  // Distinct encodings in use
+    uint64_t frames_fetched = 0;
+    uint64_t frames_encoded = 0;  // Scaled variants produced
+    uint64_t frames_unchanged = 0; // Same frame as last push, not resent
+    uint64_t frames_skipped = 0;   // Per viewer, earlier frames still in flight
+    uint64_t frames_pushed = 0;    // Per viewer
+    uint64_t bytes_pushed = 0;
+  };
+
+  static constexpr const char *MULTIPART_BOUNDARY = "frame";
+
+  static PreviewStreamHub &getInstance() {
+    static PreviewStreamHub instance;
+    return instance;
+  }
+
+  void configure(const Config &config);
+  Config getConfig() const;
+
+  void setFrameSource(FrameSource source);
+  void setTranscoder(Transcoder transcoder);
+
+  /**
+   * @brief Clamp a requested variant to the configured limits
+   * Widths are rounded to a multiple of 16 so similar requests share one
+   * encoding.
+   */
+  Variant normalize(const Variant &requested) const;
+
+  /**
+   * @brief Add a viewer
+   * @param alive Optional connection check for transports without a close
+   * notification
+   * @return Viewer ID, or 0 if the viewer limit is reached
+   */
+  ViewerId addViewer(const std::string &instanceId, const Variant &variant,
+                     Framing framing, PushFn push, AliveFn alive = nullptr);
+
+  void removeViewer(ViewerId id);
+
+  /**
+   * @brief Drop every viewer of an instance (instance deleted)
+   * @return Number of viewers removed
+   */
+  size_t removeInstance(const std::string &instanceId);
+
+  /**
+   * @brief Start the background pump thread (idempotent)
+   */
+  void start();
+
+  /**
+   * @brief Stop the pump thread and drop all viewers
+   */
+  void shutdown();
+
+  /**
+   * @brief Fetch, encode and push every variant that is due
+   * Called by the pump thread; public for tests.
+   * @return Number of payloads pushed to viewers
+   */
+  size_t pump(std::chrono::steady_clock::time_point now);
+
+  /**
+   * @brief Build a multipart/x-mixed-replace part for a JPEG
+   */
+  static std::string makeMultipartPart(const std::string &jpeg);
+
+  Stats getStats() const;
+  Json::Value getStatsJson() const;
+
+private:
+  PreviewStreamHub() = default;
+  ~PreviewStreamHub() { shutdown(); }
+  PreviewStreamHub(const PreviewStreamHub &) = delete;
+  PreviewStreamHub &operator=(const PreviewStreamHub &) = delete;
+
+  struct Viewer {
+    ViewerId id = 0;
+    Framing framing = Framing::Jpeg;
+    PushFn push;
+    AliveFn alive;
+    size_t last_frame_hash = 0; // Last frame pushed to this viewer
+    std::shared_ptr<std::atomic<int>> in_flight =
+        std::make_shared<std::atomic<int>>(0);
+  };
+
+  struct VariantState {
+    Variant variant;
+    std::vector<Viewer> viewers;
+    std::chrono::steady_clock::time_point next_due{};
+  };
+
+  struct ViewerLocation {
+    std::string instance_id;
+    Variant variant;
+  };
+
+  void pumpLoop();
+  std::chrono::steady_clock::time_point nextDueLocked() const;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  Config config_;
+  FrameSource source_;
+  Transcoder transcoder_;
+  std::unordered_map<std::string, std::vector<VariantState>> instances_;
+  std::unordered_map<ViewerId, ViewerLocation> viewer_index_;
+  ViewerId next_viewer_id_ = 1;
+
+  std::thread thread_;
+  bool running_ = false;
+
+  std::mutex pump_mutex_; // Serializes pump() (thread vs. manual calls)
+
+  std::atomic<uint64_t> frames_fetched_{0};
+  std::atomic<uint64_t> frames_encoded_{0};
+  std::atomic<uint64_t> frames_unchanged_{0};
+  std::atomic<uint64_t> frames_skipped_{0};
+  std::atomic<uint64_t> frames_pushed_{0};
+  std::atomic<uint64_t> bytes_pushed_{0};
+};
@@ -70,6 +70,7 @@ public:
    */
   struct Stats {
     size_t total;
+    size_t critical_priority;
     size_t high_priority;
     size_t medium_priority;
     size_t low_priority;
@@ -85,6 +86,7 @@ public:
 
 private:
   std::priority_queue<Request> queue_;
+  size_t priority_counts_[4] = {0, 0, 0, 0}; // Indexed by Priority
   mutable std::mutex mutex_;
   std::condition_variable condition_;
   size_t max_size_;
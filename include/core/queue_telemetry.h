@@ -0,0 +1,245 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <json/json.h>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Per-instance, per-node queue depth telemetry
+ *
+ * The pipeline meta_arriving_hooker (setupQueueSizeTrackingHook) already sees
+ * the input queue size of every node on every frame. It records those values
+ * here into fixed-size lock-free ring buffers, so QueueMonitor,
+ * AdaptiveQueueSizeManager and BackpressureController can react to queue
+ * pressure within one frame instead of re-parsing "queue full" log lines.
+ *
+ * Writers (node hooks) never block: a sample is a seqlock-protected slot in a
+ * ring buffer. Readers copy samples and skip slots that were overwritten
+ * while being read.
+ */
+class QueueTelemetry {
+public:
+  /**
+   * @brief Single queue depth sample
+   */
+  struct Sample {
+    int64_t timestamp_ms = 0; // steady_clock milliseconds
+    uint32_t depth = 0;       // Input queue size when meta arrived
+    uint64_t drops = 0;       // Cumulative drops at sample time
+  };
+
+  /**
+   * @brief Aggregated view over a time window
+   */
+  struct Summary {
+    uint32_t current_depth = 0;  // Max current depth over all nodes
+    uint32_t max_depth = 0;      // Max depth seen in window
+    double avg_depth = 0.0;      // Average depth of the deepest node
+    uint64_t drops = 0;          // Drops in window (all nodes)
+    double drops_per_second = 0.0;
+    double full_per_second = 0.0; // Samples at/above high watermark per second
+    double full_ratio = 0.0; // Max over nodes of share of samples at watermark
+    size_t samples = 0;
+  };
+
+  /**
+   * @brief Ring buffer of samples for one pipeline node
+   */
+  class NodeSeries {
+  public:
+    static constexpr size_t CAPACITY = 512; // ~17s at 30 FPS
+
+    explicit NodeSeries(const std::string &nodeName) : name_(nodeName) {}
+
+    /**
+     * @brief Replace the setup-time label with the SDK node name (first call
+     * wins; safe to call from the hook thread)
+     */
+    void setName(const std::string &nodeName);
+
+    /**
+     * @brief Record a queue depth sample (lock-free, called per frame)
+     * @param depth Current input queue size
+     * @param highWatermark Depth at which the queue is considered full
+     * @return true if this sample crossed into the full state
+     */
+    bool record(uint32_t depth, uint32_t highWatermark);
+
+    /**
+     * @brief Count frames dropped at this node (lock-free)
+     */
+    void recordDrops(uint64_t count = 1) {
+      drops_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    std::string name() const;
+    const std::string &label() const { return name_; } // Setup-time label
+    uint32_t currentDepth() const {
+      return current_depth_.load(std::memory_order_relaxed);
+    }
+    uint64_t totalDrops() const {
+      return drops_.load(std::memory_order_relaxed);
+    }
+    uint64_t totalSamples() const {
+      return head_.load(std::memory_order_acquire);
+    }
+    bool isFull() const { return full_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Copy the most recent samples (oldest first)
+     * @param out Output samples
+     * @param maxSamples Maximum number of samples to copy
+     * @param sinceMs Only samples with timestamp >= sinceMs (0 = all)
+     */
+    void snapshot(std::vector<Sample> &out, size_t maxSamples,
+                  int64_t sinceMs = 0) const;
+
+  private:
+    struct Slot {
+      std::atomic<uint64_t> seq{0}; // 2*index+1 while writing, 2*index+2 done
+      std::atomic<int64_t> timestamp_ms{0};
+      std::atomic<uint32_t> depth{0};
+      std::atomic<uint64_t> drops{0};
+    };
+
+    std::string name_;
+    std::string sdk_name_;
+    std::once_flag name_once_;
+    std::atomic<bool> has_sdk_name_{false};
+    std::array<Slot, CAPACITY> slots_;
+    std::atomic<uint64_t> head_{0};
+    std::atomic<uint32_t> current_depth_{0};
+    std::atomic<uint64_t> drops_{0};
+    std::atomic<bool> full_{false};
+  };
+
+  /**
+   * @brief All node series of one instance
+   *
+   * Nodes are registered once when the pipeline hooks are installed and are
+   * never removed, so readers can walk them without taking a lock.
+   */
+  class InstanceSeries {
+  public:
+    static constexpr size_t MAX_NODES = 64;
+
+    explicit InstanceSeries(const std::string &instanceId)
+        : instance_id_(instanceId) {}
+
+    /**
+     * @brief Register a node (setup time)
+     * Re-registering an existing label returns the existing series.
+     * @return Node series or nullptr if MAX_NODES reached
+     */
+    NodeSeries *addNode(const std::string &nodeName);
+
+    /**
+     * @brief Set configured queue capacity (high watermark = 80%)
+     */
+    void setQueueCapacity(size_t capacity);
+
+    uint32_t highWatermark() const {
+      return high_watermark_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Deepest current queue over all nodes (lock-free)
+     */
+    uint32_t currentMaxDepth() const;
+
+    /**
+     * @brief Total drops over all nodes (lock-free)
+     */
+    uint64_t totalDrops() const;
+
+    /**
+     * @brief Check if any node queue is at/above high watermark (lock-free)
+     */
+    bool isOverloaded() const;
+
+    /**
+     * @brief Summarize the last windowMs milliseconds
+     */
+    Summary summarize(int64_t windowMs) const;
+
+    /**
+     * @brief Serialize current state and up to maxSamples samples per node
+     */
+    Json::Value toJson(size_t maxSamples) const;
+
+    const std::string &instanceId() const { return instance_id_; }
+    size_t nodeCount() const {
+      return node_count_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Node series by registration index (lock-free)
+     * @return nullptr if index >= nodeCount()
+     */
+    const NodeSeries *node(size_t index) const {
+      return index < nodeCount() ? nodes_[index].get() : nullptr;
+    }
+
+  private:
+    std::string instance_id_;
+    std::mutex add_mutex_; // Serializes addNode() only; readers are lock-free
+    std::array<std::unique_ptr<NodeSeries>, MAX_NODES> nodes_;
+    std::atomic<size_t> node_count_{0};
+    std::atomic<uint32_t> capacity_{20};
+    std::atomic<uint32_t> high_watermark_{16};
+  };
+
+  static QueueTelemetry &getInstance() {
+    static QueueTelemetry instance;
+    return instance;
+  }
+
+  /**
+   * @brief Get or create the series of an instance
+   * Existing node series are kept, so restarting hooks keeps history.
+   */
+  std::shared_ptr<InstanceSeries> getOrCreate(const std::string &instanceId);
+
+  /**
+   * @brief Get the series of an instance
+   * @return nullptr if no telemetry was recorded for the instance
+   */
+  std::shared_ptr<InstanceSeries> find(const std::string &instanceId) const;
+
+  /**
+   * @brief Drop all telemetry of an instance (called on instance delete)
+   */
+  void remove(const std::string &instanceId);
+
+  /**
+   * @brief List instances with telemetry
+   */
+  std::vector<std::string> listInstances() const;
+
+  /**
+   * @brief Serialize the series of an instance
+   * @return null Json::Value if instance has no telemetry
+   */
+  Json::Value toJson(const std::string &instanceId, size_t maxSamples) const;
+
+  /**
+   * @brief Current steady_clock time in milliseconds (sample timebase)
+   */
+  static int64_t nowMs();
+
+private:
+  QueueTelemetry() = default;
+  ~QueueTelemetry() = default;
+  QueueTelemetry(const QueueTelemetry &) = delete;
+  QueueTelemetry &operator=(const QueueTelemetry &) = delete;
+
+  mutable std::shared_mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<InstanceSeries>> instances_;
+};
@@ -61,7 +61,7 @@ public:
 
 private:
   struct TokenBucket {
-    size_t tokens;
+    size_t tokens = 0; // Remaining requests; filled on first use
     std::chrono::steady_clock::time_point last_refill;
     std::atomic<size_t> requests_count{0};
   };
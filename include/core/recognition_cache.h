@@ -0,0 +1,197 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Content-addressed result cache for recognition endpoints
+ *
+ * Caches serialized /v1/recognition/recognize and /v1/recognition/search
+ * responses keyed by a 64-bit hash of the raw image bytes plus a hash of the
+ * request parameters, so clients resubmitting the same frame skip decoding
+ * and inference entirely. Optionally, a perceptual (difference) hash lets
+ * near-duplicate frames reuse a result.
+ *
+ * Entries are spread over independently locked shards, bounded by a byte
+ * budget with per-shard LRU eviction, and tagged with the face gallery
+ * version: any change to registered faces bumps the version and invalidates
+ * every cached result.
+ */
+class RecognitionCache {
+public:
+  struct Config {
+    bool enabled = true;
+    size_t max_bytes = 32 * 1024 * 1024; // Budget over all shards
+    std::chrono::seconds ttl{60};
+    bool perceptual_hash = false;      // Match near-duplicate frames
+    uint32_t perceptual_max_distance = 4; // Max differing dHash bits
+  };
+
+  /**
+   * @brief Cache key (content hash + request parameter hash)
+   */
+  struct Key {
+    uint64_t content = 0;
+    uint64_t params = 0;
+
+    bool operator==(const Key &other) const {
+      return content == other.content && params == other.params;
+    }
+    bool operator!=(const Key &other) const { return !(*this == other); }
+  };
+
+  struct Stats {
+    size_t entries = 0;
+    size_t bytes = 0;
+    size_t max_bytes = 0;
+    uint64_t hits = 0;            // Exact content hits
+    uint64_t perceptual_hits = 0; // Near-duplicate hits after an exact miss
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t gallery_version = 0;
+    double hit_rate = 0.0;
+  };
+
+  static constexpr size_t SHARD_COUNT = 16;
+  static constexpr size_t PERCEPTUAL_INDEX_SIZE = 256; // Recent dHashes kept
+
+  static RecognitionCache &getInstance() {
+    static RecognitionCache instance;
+    return instance;
+  }
+
+  /**
+   * @brief Apply configuration (drops all cached entries and statistics)
+   */
+  void configure(const Config &config);
+
+  Config getConfig() const;
+
+  bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Build a key from raw image bytes and request parameters
+   * @param image Raw (encoded) image bytes as received
+   * @param params Canonical parameter string, including the endpoint
+   */
+  static Key makeKey(const std::vector<unsigned char> &image,
+                     const std::string &params);
+
+  /**
+   * @brief Look up a result by exact content
+   * @return Cached response body, or empty optional on miss
+   */
+  std::optional<std::string> get(const Key &key);
+
+  /**
+   * @brief Look up a result of a near-duplicate frame
+   * Counted as a perceptual hit only; call after get() missed.
+   * @param params Parameter hash of the request (Key::params)
+   * @param perceptualHash dHash of the request image
+   * @return Cached response body, or empty optional on miss
+   */
+  std::optional<std::string> getSimilar(uint64_t params,
+                                        uint64_t perceptualHash);
+
+  /**
+   * @brief Store a result
+   * @param galleryVersion Gallery version read before inference started; the
+   * result is discarded if the gallery changed in the meantime
+   * @param perceptualHash dHash of the image (0 = not indexed)
+   */
+  void put(const Key &key, std::string value, uint64_t galleryVersion,
+           uint64_t perceptualHash = 0);
+
+  /**
+   * @brief Current face gallery version
+   */
+  uint64_t galleryVersion() const {
+    return gallery_version_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Mark the face gallery as changed (invalidates all entries)
+   */
+  void bumpGalleryVersion();
+
+  void clear();
+
+  Stats getStats() const;
+
+  /**
+   * @brief 64-bit non-cryptographic hash (XXH64) of a byte range
+   */
+  static uint64_t hashBytes(const void *data, size_t length, uint64_t seed = 0);
+
+  /**
+   * @brief Difference hash of a 9x8 grayscale thumbnail (row-major)
+   */
+  static uint64_t differenceHash(const uint8_t *gray9x8);
+
+  static int hammingDistance(uint64_t a, uint64_t b);
+
+private:
+  RecognitionCache() = default;
+  ~RecognitionCache() = default;
+  RecognitionCache(const RecognitionCache &) = delete;
+  RecognitionCache &operator=(const RecognitionCache &) = delete;
+
+  struct KeyHash {
+    size_t operator()(const Key &key) const {
+      return static_cast<size_t>(key.content ^ (key.params * 0x9E3779B97F4A7C15ULL));
+    }
+  };
+
+  struct Entry {
+    Key key;
+    std::string value;
+    uint64_t gallery_version = 0;
+    std::chrono::steady_clock::time_point expiry;
+  };
+
+  struct Shard {
+    mutable std::mutex mutex;
+    std::list<Entry> lru; // Most recently used first
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+    size_t bytes = 0;
+  };
+
+  struct PerceptualEntry {
+    uint64_t hash = 0;
+    Key key;
+  };
+
+  Shard &shardFor(const Key &key) {
+    return shards_[KeyHash()(key) % SHARD_COUNT];
+  }
+  static size_t entryBytes(const Entry &entry);
+  std::optional<std::string> lookup(const Key &key); // No hit/miss stats
+  void erase(Shard &shard, std::list<Entry>::iterator it);
+
+  std::array<Shard, SHARD_COUNT> shards_;
+
+  mutable std::mutex perceptual_mutex_;
+  std::array<PerceptualEntry, PERCEPTUAL_INDEX_SIZE> perceptual_index_{};
+  size_t perceptual_next_ = 0;
+
+  mutable std::mutex config_mutex_;
+  Config config_;
+  std::atomic<bool> enabled_{true};
+  std::atomic<size_t> shard_budget_{Config().max_bytes / SHARD_COUNT};
+  std::atomic<int64_t> ttl_seconds_{60};
+  std::atomic<uint64_t> gallery_version_{1};
+
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> perceptual_hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  std::atomic<uint64_t> evictions_{0};
+};
@@ -1,9 +1,18 @@
 #pragma once
 
+#include "core/priority_queue.h"
+#include "core/rate_limiter.h"
+#include <atomic>
 #include <chrono>
+#include <drogon/HttpAppFramework.h>
 #include <drogon/HttpFilter.h>
 #include <drogon/HttpRequest.h>
 #include <drogon/HttpResponse.h>
+#include <json/json.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 /**
  * @brief Middleware to track request metrics for endpoint monitoring
@@ -21,3 +30,113 @@ public:
   void doFilter(const drogon::HttpRequestPtr &req, drogon::FilterCallback &&fcb,
                 drogon::FilterChainCallback &&fccb) override;
 };
+
+/**
+ * @brief Priority-aware admission control for heavy endpoints
+ *
+ * Registered as a Drogon pre-handling advice. Cheap requests (health,
+ * version, metrics, statistics and everything not classified as heavy) keep
+ * running inline on the I/O threads. Heavy requests (recognition, uploads,
+ * batch instance operations, AI processing) are:
+ * - rate limited per client with a token bucket (429),
+ * - queued by priority on a bounded executor, so they never occupy I/O
+ *   threads,
+ * - shed when the queue is deep: low priority gets 429 above the shed depth,
+ *   everything gets 503 when the queue is full or a request waited longer
+ *   than the queue timeout.
+ */
+class RequestAdmissionControl {
+public:
+  enum class RequestClass {
+    Critical, // Health/metrics - never queued or limited
+    Normal,   // Inline on I/O thread
+    Heavy     // Executor + per-client rate limit
+  };
+
+  struct Classification {
+    RequestClass request_class = RequestClass::Normal;
+    PriorityQueue::Priority priority = PriorityQueue::Priority::Medium;
+  };
+
+  struct Config {
+    bool enabled = true;
+    size_t worker_threads = 4;
+    size_t max_queue_size = 256; // 503 when full
+    size_t shed_queue_depth = 128; // 429 for low priority above this depth
+    std::chrono::milliseconds queue_timeout{10000}; // 503 if waited longer
+    size_t client_requests_per_window = 600; // Heavy requests per client
+    std::chrono::seconds client_window{60};
+  };
+
+  struct Stats {
+    uint64_t admitted = 0;
+    uint64_t inline_requests = 0;
+    uint64_t rate_limited = 0; // 429 from token bucket
+    uint64_t shed = 0;         // 429 from queue depth
+    uint64_t rejected = 0;     // 503 queue full / queue timeout
+    size_t queue_depth = 0;
+    size_t active_workers = 0;
+  };
+
+  static RequestAdmissionControl &getInstance() {
+    static RequestAdmissionControl instance;
+    return instance;
+  }
+
+  /**
+   * @brief Read config from the optional "system.admission_control" section
+   */
+  static Config loadConfig();
+
+  /**
+   * @brief Apply configuration and (re)start executor threads
+   */
+  void configure(const Config &config);
+
+  /**
+   * @brief Classify a route
+   */
+  static Classification classify(drogon::HttpMethod method,
+                                 const std::string &path);
+
+  /**
+   * @brief Pre-handling advice entry point
+   * Either continues the chain inline, queues it on the executor or responds
+   * with 429/503.
+   */
+  void admit(const drogon::HttpRequestPtr &req, drogon::AdviceCallback &&acb,
+             drogon::AdviceChainCallback &&accb);
+
+  /**
+   * @brief Stop executor threads (pending requests get 503)
+   */
+  void shutdown();
+
+  Stats getStats() const;
+  Json::Value getStatsJson() const;
+
+private:
+  RequestAdmissionControl() = default;
+  ~RequestAdmissionControl() { shutdown(); }
+  RequestAdmissionControl(const RequestAdmissionControl &) = delete;
+  RequestAdmissionControl &operator=(const RequestAdmissionControl &) = delete;
+
+  void workerLoop();
+  static drogon::HttpResponsePtr
+  createRejectResponse(drogon::HttpStatusCode code, const std::string &message,
+                       int retryAfterSeconds);
+
+  Config config_;
+  std::unique_ptr<PriorityQueue> queue_;
+  std::unique_ptr<RateLimiter> rate_limiter_;
+  std::vector<std::thread> workers_;
+  std::atomic<bool> running_{false};
+  std::atomic<bool> enabled_{false};
+
+  std::atomic<uint64_t> admitted_{0};
+  std::atomic<uint64_t> inline_requests_{0};
+  std::atomic<uint64_t> rate_limited_{0};
+  std::atomic<uint64_t> shed_{0};
+  std::atomic<uint64_t> rejected_{0};
+  std::atomic<size_t> active_workers_{0};
+};
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <string>
+
+/**
+ * @brief Closed-loop choice of source resize_ratio and skip_interval
+ *
+ * One tuner per instance. The open-loop starting point comes from the stream:
+ * skip_interval brings the offered frame rate down to target_fps, and
+ * resize_ratio keeps the decoded width under max_decoded_width (4K cameras)
+ * but never below the ratio at which an object of min_object_px source pixels
+ * shrinks under detector_min_px.
+ *
+ * Each update() takes one measurement (processed fps, latency, queue depth,
+ * CPU headroom). After stable_samples consecutive overloaded samples the
+ * tuner steps down: lower resolution first (down to the detection floor),
+ * then extra frame skip. After the same number of samples with clear spare
+ * capacity it steps back up in reverse order. Changes are at least cooldown
+ * apart, since applying one rebuilds the pipeline. The open-loop setting only
+ * counts as a change when it differs from what the pipeline already runs.
+ *
+ * Values the user set explicitly (RESIZE_RATIO, SKIP_INTERVAL) are pinned and
+ * never changed.
+ */
+class SourceAutoTuner {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Options {
+    double target_fps = 10.0;  // 0 = process every source frame
+    int min_object_px = 0;     // Smallest object height (source px), 0 = none
+    int detector_min_px = 20;  // Smallest object the detector finds reliably
+    double min_resize_ratio = 0.2;
+    int max_decoded_width = 1920;
+    int max_skip_interval = 10;
+    size_t queue_high = 5;        // Input queue depth that counts as backlog
+    double min_cpu_headroom = 0.1;
+    double spare_cpu_headroom = 0.35;
+    int stable_samples = 3;
+    std::chrono::seconds cooldown{60};
+  };
+
+  struct Setting {
+    double resize_ratio = 0.0; // 0 = not chosen yet
+    int skip_interval = -1;    // -1 = not chosen yet
+
+    bool operator==(const Setting &other) const {
+      return resize_ratio == other.resize_ratio &&
+             skip_interval == other.skip_interval;
+    }
+    bool operator!=(const Setting &other) const { return !(*this == other); }
+  };
+
+  struct Sample {
+    int source_width = 0;
+    int source_height = 0;
+    double source_fps = 0.0;
+    double processed_fps = 0.0;
+    double latency_ms = 0.0;
+    size_t queue_size = 0;
+    double cpu_headroom = -1.0; // Idle CPU fraction 0-1, < 0 = unknown
+  };
+
+  enum class Load { Unknown, Overloaded, Balanced, Spare };
+
+  struct Decision {
+    Setting setting;
+    bool changed = false;
+    Load load = Load::Unknown;
+    std::string reason;
+  };
+
+  /**
+   * @brief Options from instance additionalParams (AUTO_TUNE_TARGET_FPS,
+   * AUTO_TUNE_MIN_OBJECT_PX, AUTO_TUNE_DETECTOR_MIN_PX,
+   * AUTO_TUNE_MAX_WIDTH) on top of the given defaults
+   * @throws std::invalid_argument on malformed values
+   */
+  static Options parseOptions(const std::map<std::string, std::string> &params,
+                              const Options &defaults);
+
+  static const char *loadName(Load load);
+
+  /**
+   * @param current Setting the running pipeline uses (from AUTO_* params)
+   * @param pinned User-set values (RESIZE_RATIO / SKIP_INTERVAL), or unset
+   * @param running What the pipeline uses where current is unset (solution
+   * or builder defaults); unset fields are unknown and always applied
+   */
+  SourceAutoTuner(const Options &options, const Setting &current,
+                  const Setting &pinned, const Setting &running);
+  SourceAutoTuner(const Options &options, const Setting &current,
+                  const Setting &pinned);
+
+  const Options &options() const { return options_; }
+  const Setting &current() const { return current_; }
+
+  /**
+   * @brief Lowest and highest resize_ratio allowed for a source width
+   */
+  double minResizeRatio() const;
+  double maxResizeRatio(int sourceWidth) const;
+
+  /**
+   * @brief Frame skip that brings source_fps down to about target_fps
+   */
+  int baseSkipInterval(double sourceFps) const;
+
+  /**
+   * @brief Open-loop setting for a stream, before any measurement
+   */
+  Setting initialSetting(int sourceWidth, double sourceFps) const;
+
+  /**
+   * @brief Classify one measurement against the expected frame rate
+   */
+  Load classify(const Sample &sample) const;
+
+  /**
+   * @brief Feed one measurement; the returned setting becomes current()
+   */
+  Decision update(const Sample &sample, Clock::time_point now = Clock::now());
+
+private:
+  Setting applyPins(Setting setting) const;
+
+  Options options_;
+  Setting current_;
+  Setting pinned_;
+  Setting running_;
+  Load streak_load_ = Load::Unknown;
+  int streak_ = 0;
+  bool changed_once_ = false;
+  Clock::time_point last_change_{};
+};
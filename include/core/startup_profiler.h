@@ -0,0 +1,183 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <json/json.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Startup timeline recorder
+ *
+ * Records every boot phase of main() (config, logger, registries, storage
+ * loads, handler registration, ...) with its start offset, duration, thread
+ * and outcome, and the moment the HTTP listener is about to accept requests
+ * ("API ready"). The timeline is served at GET /v1/core/health/startup and
+ * printed as a summary once the server is ready.
+ *
+ * Offsets are relative to the profiler's creation (first thing in main()).
+ * The time the kernel spent exec'ing and loading the binary before main()
+ * and the time since boot (CLOCK_BOOTTIME, i.e. since power-on) are reported
+ * separately so the "API ready after power loss" target can be checked.
+ */
+class StartupProfiler {
+public:
+  enum class Status { Ok, Failed, Skipped };
+
+  struct Phase {
+    std::string name;
+    std::string thread;
+    std::vector<std::string> depends_on;
+    int64_t start_us = 0; // Since profiler origin
+    int64_t duration_us = 0;
+    Status status = Status::Ok;
+    std::string error;
+    bool background = false; // Not waited for before API ready
+  };
+
+  /**
+   * @brief Times one phase from construction to destruction
+   */
+  class Scope {
+  public:
+    explicit Scope(std::string name, bool background = false);
+    ~Scope();
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+    /**
+     * @brief Mark the phase as failed (still recorded on destruction)
+     */
+    void fail(const std::string &error);
+
+  private:
+    std::string name_;
+    bool background_;
+    std::chrono::steady_clock::time_point start_;
+    int exceptions_; // std::uncaught_exceptions() at construction
+    Status status_ = Status::Ok;
+    std::string error_;
+  };
+
+  static StartupProfiler &getInstance() {
+    static StartupProfiler instance;
+    return instance;
+  }
+
+  /**
+   * @brief Record a finished phase
+   */
+  void record(Phase phase);
+
+  /**
+   * @brief Record a phase that ran from start until now
+   */
+  void record(const std::string &name,
+              std::chrono::steady_clock::time_point start,
+              Status status = Status::Ok, const std::string &error = "",
+              const std::vector<std::string> &depends_on = {},
+              bool background = false);
+
+  /**
+   * @brief Mark the API as ready (first call wins)
+   */
+  void markReady();
+  bool isReady() const;
+
+  /**
+   * @brief Microseconds since the profiler origin
+   */
+  int64_t elapsedUs(std::chrono::steady_clock::time_point at =
+                        std::chrono::steady_clock::now()) const;
+
+  /**
+   * @brief Label of the calling thread in the timeline ("main" by default)
+   */
+  static void setThreadLabel(const std::string &label);
+  static const std::string &threadLabel();
+
+  std::vector<Phase> getPhases() const;
+  Json::Value getTimelineJson() const;
+
+  /**
+   * @brief Human-readable timeline, one line per phase (ordered by start)
+   */
+  std::string formatSummary() const;
+
+  /**
+   * @brief Print formatSummary() and warn if the ready target was missed
+   */
+  void logSummary() const;
+
+  /**
+   * @brief Forget recorded phases and restart the clock (tests)
+   */
+  void reset();
+
+  static const char *statusName(Status status);
+
+private:
+  StartupProfiler();
+  StartupProfiler(const StartupProfiler &) = delete;
+  StartupProfiler &operator=(const StartupProfiler &) = delete;
+
+  mutable std::mutex mutex_;
+  std::chrono::steady_clock::time_point origin_;
+  int64_t pre_main_us_ = -1;   // exec() to origin, -1 if unknown
+  int64_t ready_us_ = -1;      // Since origin
+  int64_t ready_boot_us_ = -1; // CLOCK_BOOTTIME at ready
+  int target_ms_ = 1000;       // EDGE_AI_STARTUP_TARGET_MS
+  std::vector<Phase> phases_;
+};
+
+/**
+ * @brief Dependency-aware parallel initialization
+ *
+ * Boot phases are added with the names of the phases they need; run()
+ * executes every phase once all of its dependencies succeeded, on the
+ * calling thread plus (threads - 1) helpers, and records each one in the
+ * StartupProfiler. If a phase throws, phases depending on it are skipped,
+ * independent ones still run, and run() rethrows the first exception once
+ * everything settled, so main() fails exactly like the serial code did.
+ */
+class StartupTaskGraph {
+public:
+  /**
+   * @param threads Worker count including the caller; 0 = defaultThreads()
+   */
+  explicit StartupTaskGraph(size_t threads = 0);
+
+  /**
+   * @brief Add a phase; dependencies must be added before run()
+   */
+  void add(const std::string &name, std::vector<std::string> depends_on,
+           std::function<void()> fn);
+
+  /**
+   * @brief Run all phases
+   * @throws std::invalid_argument on unknown dependencies or cycles (before
+   * anything runs); otherwise the first exception thrown by a phase
+   */
+  void run();
+
+  size_t threads() const { return threads_; }
+
+  /**
+   * @brief EDGE_AI_STARTUP_THREADS, default min(CPUs, 4); 1 = serial
+   */
+  static size_t defaultThreads();
+
+private:
+  struct Task {
+    std::string name;
+    std::vector<std::string> depends_on;
+    std::function<void()> fn;
+    std::vector<size_t> dependents;
+    size_t pending = 0;
+  };
+
+  size_t threads_;
+  std::vector<Task> tasks_;
+};
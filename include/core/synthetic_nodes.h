@@ -0,0 +1,105 @@
+#pragma once
+
+#include "core/synthetic_workload.h"
+#include <atomic>
+#include <cvedix/nodes/common/cvedix_node.h>
+#include <cvedix/nodes/common/cvedix_src_node.h>
+#include <cvedix/objects/cvedix_frame_meta.h>
+#include <cvedix/objects/cvedix_meta.h>
+#include <memory>
+#include <opencv2/core.hpp>
+#include <string>
+
+/**
+ * @brief CPU-only stand-ins for source, detector, BA and broker nodes
+ *
+ * Used by the synthetic_load_test solution to drive the API, registry and
+ * worker supervisor at realistic instance counts without cameras or models.
+ * See core/synthetic_workload.h for the parameters.
+ */
+namespace SyntheticNodes {
+
+/**
+ * @brief Source that generates frames at a fixed resolution and fps
+ *
+ * Frames are copies of a pre-rendered pattern with a moving bar, so each
+ * frame costs one allocation and one memcpy like a decoded camera frame.
+ * start()/stop() behave as for the other source nodes.
+ */
+class SyntheticSourceNode : public cvedix_nodes::cvedix_src_node {
+public:
+  SyntheticSourceNode(const std::string &node_name,
+                      const SyntheticWorkload::SourceOptions &options);
+  ~SyntheticSourceNode();
+
+  const SyntheticWorkload::SourceOptions &options() const { return options_; }
+
+protected:
+  void handle_run() override;
+
+private:
+  SyntheticWorkload::SourceOptions options_;
+  cv::Mat pattern_;
+};
+
+/**
+ * @brief Detector that waits the configured latency and adds moving boxes
+ */
+class SyntheticDetectorNode : public cvedix_nodes::cvedix_node {
+public:
+  SyntheticDetectorNode(const std::string &node_name,
+                        const SyntheticWorkload::DetectorOptions &options);
+  ~SyntheticDetectorNode();
+
+protected:
+  std::shared_ptr<cvedix_objects::cvedix_meta> handle_frame_meta(
+      std::shared_ptr<cvedix_objects::cvedix_frame_meta> meta) override;
+
+private:
+  SyntheticWorkload::DetectorOptions options_;
+};
+
+/**
+ * @brief Pass-through behaviour analysis node
+ *
+ * Only counts the targets it sees so the hop (queue, thread hand-off) is
+ * present in the pipeline without any analysis cost.
+ */
+class SyntheticBANode : public cvedix_nodes::cvedix_node {
+public:
+  explicit SyntheticBANode(const std::string &node_name);
+  ~SyntheticBANode();
+
+  uint64_t targetsSeen() const { return targets_seen_.load(); }
+
+protected:
+  std::shared_ptr<cvedix_objects::cvedix_meta> handle_frame_meta(
+      std::shared_ptr<cvedix_objects::cvedix_frame_meta> meta) override;
+
+private:
+  std::atomic<uint64_t> targets_seen_{0};
+};
+
+/**
+ * @brief Broker that builds the per-frame JSON message and drops it
+ */
+class SyntheticBrokerNode : public cvedix_nodes::cvedix_node {
+public:
+  SyntheticBrokerNode(const std::string &node_name,
+                      const SyntheticWorkload::BrokerOptions &options);
+  ~SyntheticBrokerNode();
+
+  uint64_t messages() const { return messages_.load(); }
+  uint64_t bytes() const { return bytes_.load(); }
+
+protected:
+  std::shared_ptr<cvedix_objects::cvedix_meta> handle_frame_meta(
+      std::shared_ptr<cvedix_objects::cvedix_frame_meta> meta) override;
+
+private:
+  SyntheticWorkload::BrokerOptions options_;
+  std::atomic<uint64_t> messages_{0};
+  std::atomic<uint64_t> bytes_{0};
+};
+
+} // namespace SyntheticNodes
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Parameters and deterministic workload for the synthetic node family
+ *
+ * The synthetic nodes (synthetic_src, synthetic_detector, synthetic_ba,
+ * synthetic_broker) stand in for cameras and models when scale testing the
+ * control plane: they need no model files, no GPU and no network input. This
+ * part holds everything that does not depend on the SDK so it can be unit
+ * tested on its own.
+ *
+ * Parameter values that are missing, empty or still an unresolved
+ * "${VARIABLE}" placeholder fall back to the defaults below; values that are
+ * present but malformed throw std::invalid_argument.
+ */
+namespace SyntheticWorkload {
+
+struct SourceOptions {
+  int channel = 0;
+  int width = 1280;
+  int height = 720;
+  double fps = 25.0;
+};
+
+struct DetectorOptions {
+  int latency_ms = 10;       // Simulated inference time per frame
+  int latency_jitter_ms = 0; // +/- uniform jitter around latency_ms
+  bool busy_wait = false;    // Spin (CPU-bound model) instead of sleeping
+  int boxes = 5;             // Targets emitted per frame
+  int min_box = 32;          // Box side range in pixels
+  int max_box = 160;
+  uint32_t seed = 0;
+};
+
+struct BrokerOptions {
+  bool serialize = true; // Build the JSON message like a real broker would
+};
+
+SourceOptions
+parseSourceOptions(const std::map<std::string, std::string> &params);
+DetectorOptions
+parseDetectorOptions(const std::map<std::string, std::string> &params);
+BrokerOptions
+parseBrokerOptions(const std::map<std::string, std::string> &params);
+
+/**
+ * @brief Frame interval for the configured fps
+ */
+std::chrono::nanoseconds frameInterval(const SourceOptions &options);
+
+/**
+ * @brief Simulated inference time for a frame (deterministic per frame index)
+ */
+std::chrono::microseconds latencyFor(const DetectorOptions &options,
+                                     int frameIndex);
+
+struct Box {
+  int x = 0;
+  int y = 0;
+  int width = 0;
+  int height = 0;
+  int class_id = 0;
+  float score = 0.0f;
+};
+
+/**
+ * @brief Boxes for a frame
+ *
+ * Box i keeps its size, class and direction for the lifetime of the stream
+ * and moves a few pixels per frame (bouncing off the edges), so trackers and
+ * BA nodes downstream see plausible continuous objects. The result depends
+ * only on (options, frameIndex, width, height); every box lies inside the
+ * frame.
+ */
+std::vector<Box> generateBoxes(const DetectorOptions &options, int frameIndex,
+                               int width, int height);
+
+} // namespace SyntheticWorkload
@@ -59,6 +59,17 @@ inline int getWorkerStateMutexTimeoutMs() {
   return EnvConfig::getInt("WORKER_STATE_MUTEX_TIMEOUT_MS", 100, 50, 1000);
 }
 
+// Interval at which workers push statistics to the supervisor (0 = disabled,
+// statistics are then fetched with GET_STATISTICS on every read)
+inline int getWorkerStatsPushIntervalMs() {
+  return EnvConfig::getInt("WORKER_STATS_PUSH_INTERVAL_MS", 250, 0, 10000);
+}
+
+// Maximum age of pushed statistics served without an IPC round trip
+inline int getWorkerStatsMaxAgeMs() {
+  return EnvConfig::getInt("WORKER_STATS_MAX_AGE_MS", 2000, 100, 60000);
+}
+
 // Shutdown timeout - total time before force exit
 inline int getShutdownTimeoutMs() {
   return EnvConfig::getInt("SHUTDOWN_TIMEOUT_MS", 500, 100, 5000);
@@ -48,6 +48,9 @@ public:
   std::optional<InstanceStatistics>
   getInstanceStatistics(const std::string &instanceId) override;
   std::string getLastFrame(const std::string &instanceId) const override;
+  std::string getLastFrameJpeg(const std::string &instanceId) const override;
+  Json::Value getQueueTelemetry(const std::string &instanceId,
+                                size_t maxSamples) const override;
   Json::Value getInstanceConfig(const std::string &instanceId) const override;
   bool updateInstanceFromConfig(const std::string &instanceId,
                                 const Json::Value &configJson) override;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "models/resource_limits.h"
 #include <chrono>
 #include <map>
 #include <memory>
@@ -71,6 +72,9 @@ struct InstanceInfo {
   std::string performanceMode =
       "Balanced"; // "Balanced", "Performance", "Saved"
 
+  // Worker cgroup limits (subprocess mode)
+  ResourceLimits resourceLimits;
+
   // SolutionManager settings
   int recommendedFrameRate = 0; // Recommended frame rate
 
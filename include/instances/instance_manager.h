@@ -3,6 +3,7 @@
 #include "instances/instance_info.h"
 #include "instances/instance_statistics.h"
 #include "models/create_instance_request.h"
+#include "utils/base64_codec.h"
 #include <json/json.h>
 #include <memory>
 #include <optional>
@@ -112,6 +113,33 @@ public:
    */
   virtual std::string getLastFrame(const std::string &instanceId) const = 0;
 
+  /**
+   * @brief Get last frame from instance as raw JPEG bytes
+   *
+   * Used by the frame endpoints' binary mode (Accept: image/jpeg). The
+   * default decodes getLastFrame(); backends that hold the frame locally
+   * override it to skip base64 entirely.
+   * @param instanceId Instance ID
+   * @return JPEG data or empty string
+   */
+  virtual std::string getLastFrameJpeg(const std::string &instanceId) const {
+    std::string frame = getLastFrame(instanceId);
+    std::vector<unsigned char> jpeg;
+    if (frame.empty() || !Base64::decode(frame, jpeg)) {
+      return "";
+    }
+    return std::string(jpeg.begin(), jpeg.end());
+  }
+
+  /**
+   * @brief Get queue depth telemetry (per-node depth/drop time series)
+   * @param instanceId Instance ID
+   * @param maxSamples Maximum samples per node
+   * @return Telemetry JSON, null if no telemetry recorded for the instance
+   */
+  virtual Json::Value getQueueTelemetry(const std::string &instanceId,
+                                        size_t maxSamples) const = 0;
+
   /**
    * @brief Get instance config as JSON
    * @param instanceId Instance ID
@@ -188,6 +188,13 @@ public:
    */
   std::string getLastFrame(const std::string &instanceId) const;
 
+  /**
+   * @brief Get last frame from instance as raw JPEG bytes (no base64)
+   * @param instanceId Instance ID
+   * @return JPEG data, empty string if no frame available
+   */
+  std::string getLastFrameJpeg(const std::string &instanceId) const;
+
 private:
   SolutionRegistry &solution_registry_;
   PipelineBuilder &pipeline_builder_;
@@ -313,6 +320,12 @@ private:
    */
   void updateFrameCache(const std::string &instanceId, const cv::Mat &frame);
 
+  /**
+   * @brief Shared reference to the cached frame (null if none or if the cache
+   * lock could not be taken in time)
+   */
+  FramePtr getCachedFrame(const std::string &instanceId) const;
+
   /**
    * @brief Setup frame capture hook for pipeline
    * @param instanceId Instance ID
@@ -341,6 +354,13 @@ private:
   std::string encodeFrameToBase64(const cv::Mat &frame,
                                   int jpegQuality = 85) const;
 
+  /**
+   * @brief Encode cv::Mat frame to JPEG bytes
+   * @return JPEG data, empty string on failure
+   */
+  std::string encodeFrameToJpeg(const cv::Mat &frame,
+                                int jpegQuality = 85) const;
+
   /**
    * @brief Create InstanceInfo from request
    */
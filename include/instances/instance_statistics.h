@@ -22,6 +22,8 @@ struct InstanceStatistics {
   std::string resolution;            // e.g., "1280x720"
   std::string format;                // e.g., "BGR"
   std::string source_resolution;     // e.g., "1920x1080"
+  Json::Value resource_usage; // Worker cgroup usage (subprocess mode), or null
+  Json::Value placement;      // Worker CPUs / NUMA node (subprocess mode), or null
 
   /**
    * @brief Convert statistics to JSON value
@@ -41,6 +43,12 @@ struct InstanceStatistics {
     json["resolution"] = resolution;
     json["format"] = format;
     json["source_resolution"] = source_resolution;
+    if (!resource_usage.isNull()) {
+      json["resource_usage"] = resource_usage;
+    }
+    if (!placement.isNull()) {
+      json["placement"] = placement;
+    }
     return json;
   }
 
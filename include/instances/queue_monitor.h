@@ -5,7 +5,6 @@
 #include <map>
 #include <memory>
 #include <mutex>
-#include <regex>
 #include <string>
 #include <thread>
 
@@ -16,6 +15,10 @@
  * - Tracks queue full warning frequency
  * - Automatically clears/restarts nodes when queue is consistently full
  * - Prevents deadlock by proactive queue management
+ *
+ * Queue pressure is read directly from QueueTelemetry (fed by the pipeline
+ * queue size hooks); warnings are recorded by the hook the moment a node
+ * queue crosses its high watermark.
  */
 class QueueMonitor {
 public:
@@ -82,25 +85,17 @@ public:
    */
   void setMonitoringWindow(int window);
 
-  /**
-   * @brief Parse log line to detect queue full warnings
-   * @param logLine Log line to parse
-   * @return Instance ID if found, empty string otherwise
-   */
-  std::string parseLogLine(const std::string &logLine);
-
-  /**
-   * @brief Enable log file parsing
-   * @param logFilePath Path to log file to parse
-   */
-  void enableLogParsing(const std::string &logFilePath);
-
 private:
   QueueMonitor();
   ~QueueMonitor();
 
   void monitoringThread();
 
+  /**
+   * @brief Push telemetry-derived queue sizes to BackpressureController
+   */
+  void applyAdaptiveQueueSizes();
+
   std::map<std::string, QueueStats> instance_stats_;
   std::mutex stats_mutex_;
   std::atomic<bool> running_{false};
@@ -111,15 +106,8 @@ private:
   int monitoring_window_{5};           // Seconds
   int max_warnings_before_clear_{100}; // Max warnings before clearing
 
-  // Log parsing
-  std::string log_file_path_;
-  std::atomic<bool> log_parsing_enabled_{false};
-  std::mutex log_file_mutex_;
-
-  // Map node names to instance IDs (for log parsing)
-  std::map<std::string, std::string> node_to_instance_map_;
-  std::mutex node_map_mutex_;
-
-  void parseLogFile();
-  void updateNodeToInstanceMap();
+  // Fraction of samples at/above high watermark over the monitoring window
+  // that counts as sustained saturation
+  static constexpr double SATURATION_RATIO = 0.9;
+  static constexpr int TELEMETRY_POLL_MS = 1000;
 };
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "core/source_auto_tuner.h"
+#include "instances/instance_info.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class IInstanceManager;
+
+/**
+ * @brief Periodically re-tunes source resize_ratio / skip_interval
+ *
+ * Instances opt in with additionalParams AUTO_TUNE=true (optional
+ * AUTO_TUNE_TARGET_FPS, AUTO_TUNE_MIN_OBJECT_PX, AUTO_TUNE_DETECTOR_MIN_PX,
+ * AUTO_TUNE_MAX_WIDTH). Every interval the monitor feeds each running
+ * opted-in instance's statistics (source resolution and fps, processed fps,
+ * latency, input queue) and the host's idle CPU fraction into that
+ * instance's SourceAutoTuner.
+ *
+ * A new setting is stored as AUTO_RESIZE_RATIO / AUTO_SKIP_INTERVAL in the
+ * instance's additionalParams (persisted with the instance) through
+ * IInstanceManager::updateInstance() on the OperationExecutor, so it is
+ * serialized with other operations on the instance. The update rebuilds the
+ * pipeline (hot swap in subprocess mode) and the RTSP source node picks the
+ * values up. User-set RESIZE_RATIO / SKIP_INTERVAL always win and are never
+ * changed.
+ *
+ * Every applied step restarts the pipeline. In in-process mode that is a
+ * stop, a 3 s wait for the source to release and a start, so the stream is
+ * down for several seconds per step; the cooldown bounds how often that
+ * happens, and no update is queued when the chosen setting is the one the
+ * pipeline already runs.
+ */
+class SourceAutoTuneMonitor {
+public:
+  struct Config {
+    bool enabled = true;
+    std::chrono::seconds interval{10};
+    int stable_samples = 3;
+    std::chrono::seconds cooldown{120};
+    double min_cpu_headroom = 0.1;
+    double spare_cpu_headroom = 0.35;
+    size_t queue_high = 5;
+    double default_target_fps = 10.0;
+  };
+
+  static SourceAutoTuneMonitor &getInstance() {
+    static SourceAutoTuneMonitor instance;
+    return instance;
+  }
+
+  /**
+   * @brief Read config from the optional "system.auto_tune" section
+   */
+  static Config loadConfig();
+
+  /**
+   * @brief Whether an instance opted in (additionalParams AUTO_TUNE)
+   */
+  static bool isEnabledFor(const InstanceInfo &info);
+
+  /**
+   * @brief Tuner options for an instance from config and additionalParams
+   * @throws std::invalid_argument on malformed AUTO_TUNE_* values
+   */
+  static SourceAutoTuner::Options
+  optionsFor(const Config &config,
+             const std::map<std::string, std::string> &params);
+
+  /**
+   * @brief User-set values (RESIZE_RATIO, SKIP_INTERVAL) the tuner must keep
+   */
+  static SourceAutoTuner::Setting
+  pinnedSetting(const std::map<std::string, std::string> &params);
+
+  /**
+   * @brief Previously tuned values (AUTO_RESIZE_RATIO, AUTO_SKIP_INTERVAL)
+   */
+  static SourceAutoTuner::Setting
+  tunedSetting(const std::map<std::string, std::string> &params);
+
+  /**
+   * @brief Values the pipeline builder uses when no AUTO_* value is set: the
+   * rtsp_src node's resize_ratio / scale / skip_interval from the solution,
+   * else the builder defaults (0.6, 0). Templated values are left unset.
+   */
+  static SourceAutoTuner::Setting runningSetting(const InstanceInfo &info);
+
+  /**
+   * @brief Start the monitoring thread (no-op when disabled)
+   */
+  void start(IInstanceManager *manager, const Config &config);
+
+  void stop();
+
+private:
+  SourceAutoTuneMonitor() = default;
+  ~SourceAutoTuneMonitor();
+  SourceAutoTuneMonitor(const SourceAutoTuneMonitor &) = delete;
+  SourceAutoTuneMonitor &operator=(const SourceAutoTuneMonitor &) = delete;
+
+  struct Tracked {
+    std::unique_ptr<SourceAutoTuner> tuner;
+    std::string params_key; // AUTO_TUNE_* and pinned values the tuner uses
+    std::string operation_id; // Pending update, empty when none
+  };
+
+  void run();
+  void tick();
+  // Queue the update that stores and applies a new setting
+  std::string apply(const InstanceInfo &info,
+                    const SourceAutoTuner::Setting &setting);
+
+  /**
+   * @brief Idle fraction of all CPUs since the previous call, from /proc/stat
+   * @return -1 when unknown
+   */
+  double sampleCpuHeadroom();
+
+  IInstanceManager *manager_ = nullptr;
+  Config config_;
+
+  std::map<std::string, Tracked> tracked_; // Monitoring thread only
+
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  std::atomic<bool> running_{false};
+  std::thread thread_;
+
+  uint64_t last_cpu_total_ = 0;
+  uint64_t last_cpu_idle_ = 0;
+};
@@ -56,6 +56,8 @@ public:
   std::optional<InstanceStatistics>
   getInstanceStatistics(const std::string &instanceId) override;
   std::string getLastFrame(const std::string &instanceId) const override;
+  Json::Value getQueueTelemetry(const std::string &instanceId,
+                                size_t maxSamples) const override;
   Json::Value getInstanceConfig(const std::string &instanceId) const override;
   bool updateInstanceFromConfig(const std::string &instanceId,
                                 const Json::Value &configJson) override;
@@ -120,4 +122,17 @@ private:
    * @brief Handle worker errors
    */
   void onWorkerError(const std::string &instanceId, const std::string &error);
+
+  /**
+   * @brief Handle a crashed worker that the supervisor restarted, or gave
+   * up on (restarted = false)
+   */
+  void onWorkerRestarted(const std::string &instanceId, bool restarted,
+                         bool pipelineResumed);
+
+  /**
+   * @brief Statistics reported by the worker (pushed snapshot or IPC query)
+   */
+  std::optional<InstanceStatistics>
+  fetchWorkerStatistics(const std::string &instanceId);
 };
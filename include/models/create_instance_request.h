@@ -1,5 +1,6 @@
 #pragma once
 
+#include "models/resource_limits.h"
 #include <map>
 #include <string>
 
@@ -44,6 +45,9 @@ struct CreateInstanceRequest {
   std::string performanceMode =
       "Balanced"; // "Balanced", "Performance", "Saved"
 
+  // Worker cgroup limits (subprocess mode)
+  ResourceLimits resourceLimits;
+
   // SolutionManager settings
   int recommendedFrameRate = 0; // Recommended frame rate
 
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <json/json.h>
+#include <string>
+
+/**
+ * @brief Per-instance resource limits for subprocess workers
+ *
+ * Applied to the worker's cgroup v2 leaf (cpu.weight, cpu.max, memory.high).
+ * A value of 0 leaves the kernel default in place. Ignored in in-process
+ * mode.
+ */
+struct ResourceLimits {
+  int cpuWeight = 0;        // cpu.weight, 1-10000 (kernel default 100)
+  double cpuMax = 0.0;      // cpu.max in CPU cores, e.g. 1.5
+  int64_t memoryHighMB = 0; // memory.high, throttled and reclaimed above this
+
+  bool empty() const {
+    return cpuWeight == 0 && cpuMax <= 0.0 && memoryHighMB == 0;
+  }
+
+  /**
+   * @brief Range check
+   * @return Error message, or empty string if valid
+   */
+  std::string validate() const {
+    if (cpuWeight != 0 && (cpuWeight < 1 || cpuWeight > 10000)) {
+      return "resourceLimits.cpuWeight must be between 1 and 10000";
+    }
+    if (cpuMax < 0.0 || (cpuMax > 0.0 && cpuMax < 0.01)) {
+      return "resourceLimits.cpuMax must be at least 0.01 CPU cores";
+    }
+    if (memoryHighMB < 0) {
+      return "resourceLimits.memoryHighMB must not be negative";
+    }
+    return "";
+  }
+
+  Json::Value toJson() const {
+    Json::Value json(Json::objectValue);
+    if (cpuWeight > 0) {
+      json["cpuWeight"] = cpuWeight;
+    }
+    if (cpuMax > 0.0) {
+      json["cpuMax"] = cpuMax;
+    }
+    if (memoryHighMB > 0) {
+      json["memoryHighMB"] = static_cast<Json::Int64>(memoryHighMB);
+    }
+    return json;
+  }
+
+  static ResourceLimits fromJson(const Json::Value &json) {
+    ResourceLimits limits;
+    if (!json.isObject()) {
+      return limits;
+    }
+    if (json["cpuWeight"].isNumeric()) {
+      limits.cpuWeight = json["cpuWeight"].asInt();
+    }
+    if (json["cpuMax"].isNumeric()) {
+      limits.cpuMax = json["cpuMax"].asDouble();
+    }
+    if (json["memoryHighMB"].isNumeric()) {
+      limits.memoryHighMB = json["memoryHighMB"].asInt64();
+    }
+    return limits;
+  }
+};
@@ -213,6 +213,12 @@ private:
    */
   void registerBAStopMQTTDefaultSolution();
 
+  /**
+   * @brief Register synthetic_load_test solution (generated frames, fake
+   * detector; no models or cameras needed)
+   */
+  void registerSyntheticLoadTestSolution();
+
 #ifdef CVEDIX_WITH_RKNN
   /**
    * @brief Register RKNN YOLOv11 detection solution
@@ -0,0 +1,241 @@
+#pragma once
+
+#include "videos/video_segmenter.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <json/json.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Offline (faster than real time) analytics jobs over video files
+ *
+ * A job probes the video, cuts it into keyframe-aligned segments
+ * (VideoSegmenter) and analyses the segments in parallel without stream
+ * pacing. Each segment writes its BA events / detections to its own file in
+ * time order; when all segments are done they are merged into one timeline
+ * (events.jsonl in the job directory).
+ *
+ * Probing and segment processing are pluggable: the server installs the
+ * SDK pipeline processor (OfflineSegmentPipeline) at startup; tests use
+ * fakes.
+ *
+ * - Jobs run one after another (max_concurrent_jobs at once); a job uses up
+ *   to `parallelism` segment workers (default max_workers = CPU cores).
+ * - Progress and throughput (frames/s, x real time) are updated as segments
+ *   report frames.
+ */
+class OfflineJobManager {
+public:
+  enum class State {
+    Queued,
+    Probing,
+    Running,
+    Merging,
+    Succeeded,
+    Failed,
+    Cancelled
+  };
+
+  struct JobRequest {
+    std::string video_path;  // Resolved file path
+    std::string video_name;  // As given by the client (for display)
+    std::string solution_id; // Solution whose pipeline analyses the video
+    std::map<std::string, std::string> additional_params;
+    size_t segments = 0;    // 0 = segments_per_worker x parallelism
+    size_t parallelism = 0; // 0 = max_workers
+    bool include_detections = true;
+  };
+
+  struct VideoInfo {
+    double duration_sec = 0.0;
+    double fps = 0.0;
+    uint64_t frames = 0; // 0 = unknown, estimated from duration x fps
+    std::vector<double> keyframes;
+  };
+
+  /**
+   * @brief Handed to a segment processor
+   */
+  class SegmentProgress {
+  public:
+    /** @brief Total frames analysed so far in this segment */
+    void setFrames(uint64_t frames);
+    bool cancelled() const;
+
+  private:
+    friend class OfflineJobManager;
+    SegmentProgress(OfflineJobManager &manager, std::string job_id,
+                    size_t segment)
+        : manager_(manager), job_id_(std::move(job_id)), segment_(segment) {}
+    OfflineJobManager &manager_;
+    std::string job_id_;
+    size_t segment_;
+  };
+
+  struct SegmentTask {
+    std::string job_id;
+    std::string video_path;
+    std::string solution_id;
+    std::map<std::string, std::string> additional_params;
+    bool include_detections = true;
+    VideoSegmenter::Segment segment;
+    bool to_end = false; // Last segment: read until EOF
+    double fps = 0.0;
+    std::string output_path; // "<time>\t<json>" lines, in time order
+  };
+
+  using Prober = std::function<bool(const std::string &path, VideoInfo &info,
+                                    std::string &error)>;
+  using SegmentProcessor = std::function<bool(
+      const SegmentTask &task, SegmentProgress &progress, std::string &error)>;
+
+  struct Config {
+    size_t max_workers = 0; // 0 = hardware concurrency
+    size_t max_concurrent_jobs = 1;
+    size_t segments_per_worker = 2; // More, shorter segments balance better
+    double min_segment_seconds = 10.0;
+    size_t max_retained_jobs = 50; // Finished jobs kept (with their files)
+    std::string jobs_dir = "video_jobs";
+  };
+
+  static OfflineJobManager &getInstance() {
+    static OfflineJobManager instance;
+    return instance;
+  }
+
+  /**
+   * @brief Read config from the optional "system.offline_jobs" section
+   */
+  static Config loadConfig();
+
+  /**
+   * @brief Apply configuration (call before submitting jobs)
+   */
+  void configure(const Config &config);
+
+  void setProber(Prober prober);
+  void setSegmentProcessor(SegmentProcessor processor);
+
+  /**
+   * @brief Default prober: ffprobe for duration, fps and keyframe packets
+   */
+  static bool probeWithFfprobe(const std::string &path, VideoInfo &info,
+                               std::string &error);
+
+  /**
+   * @brief Queue a job
+   * @return Job ID, or empty string (error set) when it cannot be queued
+   */
+  std::string submit(const JobRequest &request, std::string &error);
+
+  /**
+   * @brief Cancel a queued/running job, or delete a finished one with its
+   * files
+   * @return false if the job is unknown
+   */
+  bool cancelOrDelete(const std::string &id);
+
+  /**
+   * @brief Wait until the job is finished
+   */
+  std::optional<State>
+  wait(const std::string &id,
+       std::chrono::milliseconds timeout = std::chrono::milliseconds::max());
+
+  std::optional<Json::Value> getJobJson(const std::string &id) const;
+  Json::Value listJobsJson() const;
+
+  /**
+   * @brief Merged events of a finished job
+   * @param offset Events to skip
+   * @param limit Maximum events returned
+   * @return events[] (+ offset, count, total), or nullopt for unknown jobs
+   */
+  std::optional<Json::Value> getEventsJson(const std::string &id,
+                                           uint64_t offset,
+                                           uint64_t limit) const;
+
+  /**
+   * @brief Stop runners; queued jobs are cancelled, running ones finish
+   * their cancellation
+   */
+  void shutdown();
+
+  static const char *stateName(State state);
+  static bool isFinished(State state) {
+    return state == State::Succeeded || state == State::Failed ||
+           state == State::Cancelled;
+  }
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct SegmentState {
+    VideoSegmenter::Segment segment;
+    uint64_t frames = 0;
+    uint64_t expected_frames = 0;
+    std::string state = "queued"; // queued, running, done, failed
+    std::string error;
+    double seconds = 0.0;
+  };
+
+  struct Job {
+    std::string id;
+    JobRequest request;
+    State state = State::Queued;
+    std::string error;
+    std::string dir;
+    VideoInfo info;
+    std::vector<SegmentState> segments;
+    size_t parallelism = 1;
+    uint64_t events = 0;
+    std::atomic<bool> cancel{false};
+    Clock::time_point created;
+    Clock::time_point started;  // Segment processing started
+    Clock::time_point finished;
+    std::chrono::system_clock::time_point created_wall;
+  };
+
+  OfflineJobManager() = default;
+  ~OfflineJobManager() { shutdown(); }
+  OfflineJobManager(const OfflineJobManager &) = delete;
+  OfflineJobManager &operator=(const OfflineJobManager &) = delete;
+
+  void startRunnersLocked();
+  void runnerLoop();
+  void runJob(const std::shared_ptr<Job> &job);
+  bool processSegments(const std::shared_ptr<Job> &job, std::string &error);
+  bool mergeSegments(const std::shared_ptr<Job> &job, std::string &error);
+  void finishJob(const std::shared_ptr<Job> &job, State state,
+                 const std::string &error);
+  void setSegmentFrames(const std::string &id, size_t segment,
+                        uint64_t frames);
+  bool isCancelled(const std::string &id) const;
+  void pruneLocked();
+  Json::Value toJsonLocked(const Job &job, bool withSegments) const;
+
+  Config config_;
+  Prober prober_ = &OfflineJobManager::probeWithFfprobe;
+  SegmentProcessor processor_;
+  std::vector<std::thread> runners_;
+  bool running_ = false;
+  bool accepting_ = true;
+
+  mutable std::mutex mutex_;
+  std::condition_variable work_cv_;
+  std::condition_variable done_cv_;
+  std::unordered_map<std::string, std::shared_ptr<Job>> jobs_;
+  std::deque<std::string> order_; // Creation order, for listing and pruning
+  std::deque<std::shared_ptr<Job>> queue_;
+};
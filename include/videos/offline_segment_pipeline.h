@@ -0,0 +1,99 @@
+#pragma once
+
+#include "videos/offline_job_manager.h"
+#include <atomic>
+#include <cvedix/nodes/common/cvedix_node.h>
+#include <cvedix/nodes/common/cvedix_src_node.h>
+#include <cvedix/objects/cvedix_frame_meta.h>
+#include <cvedix/objects/cvedix_meta.h>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/**
+ * @brief SDK side of offline video jobs: one pipeline per segment
+ *
+ * The solution's pipeline is rebuilt for each segment with its source
+ * replaced by OfflineSegmentSourceNode and its outputs (OSD, destinations,
+ * brokers) dropped; an OfflineCollectorNode at the end writes the segment's
+ * events for OfflineJobManager to merge.
+ */
+namespace OfflineSegmentPipeline {
+
+/**
+ * @brief File source that starts at a keyframe and reads as fast as the
+ * pipeline consumes
+ *
+ * Unlike file_src it seeks to start_sec, stops at end_sec and does not pace
+ * at the video frame rate. Backpressure comes from the output queue: reading
+ * pauses while more than max_queue frames are waiting. frame_index is the
+ * absolute frame number in the video, so timestamps derived from it are the
+ * same whichever segment a frame was analysed in.
+ *
+ * Params: file_path, start_sec, end_sec (0 = until EOF), fps (the probed
+ * rate, so frame numbers match the job's), resize_ratio, channel, max_queue.
+ */
+class OfflineSegmentSourceNode : public cvedix_nodes::cvedix_src_node {
+public:
+  OfflineSegmentSourceNode(const std::string &node_name,
+                           const std::map<std::string, std::string> &params);
+  ~OfflineSegmentSourceNode();
+
+  /** @brief Segment end (or EOF) reached, or the file could not be read */
+  bool finished() const { return finished_.load(); }
+  uint64_t framesEmitted() const { return frames_emitted_.load(); }
+  std::string error() const;
+
+protected:
+  void handle_run() override;
+
+private:
+  std::string file_path_;
+  double start_sec_ = 0.0;
+  double end_sec_ = 0.0;
+  double fps_ = 0.0; // 0 = as reported by the decoder
+  double resize_ratio_ = 1.0;
+  size_t max_queue_ = 32;
+
+  std::atomic<bool> finished_{false};
+  std::atomic<uint64_t> frames_emitted_{0};
+  mutable std::mutex error_mutex_;
+  std::string error_;
+};
+
+/**
+ * @brief Last node of a segment pipeline: writes BA events (and optionally
+ * per-frame detections) as "<time>\t<json>" lines
+ */
+class OfflineCollectorNode : public cvedix_nodes::cvedix_node {
+public:
+  OfflineCollectorNode(const std::string &node_name,
+                       const std::string &output_path, double fps,
+                       bool include_detections);
+  ~OfflineCollectorNode();
+
+  bool ok() const { return static_cast<bool>(output_); }
+  uint64_t framesSeen() const { return frames_seen_.load(); }
+
+protected:
+  std::shared_ptr<cvedix_objects::cvedix_meta> handle_frame_meta(
+      std::shared_ptr<cvedix_objects::cvedix_frame_meta> meta) override;
+
+private:
+  std::ofstream output_;
+  double fps_;
+  bool include_detections_;
+  std::atomic<uint64_t> frames_seen_{0};
+};
+
+/**
+ * @brief OfflineJobManager::SegmentProcessor running a segment through the
+ * job's solution
+ */
+bool processSegment(const OfflineJobManager::SegmentTask &task,
+                    OfflineJobManager::SegmentProgress &progress,
+                    std::string &error);
+
+} // namespace OfflineSegmentPipeline
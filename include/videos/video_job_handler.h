@@ -0,0 +1,106 @@
+#pragma once
+
+#include <drogon/HttpController.h>
+#include <drogon/HttpRequest.h>
+#include <drogon/HttpResponse.h>
+#include <json/json.h>
+#include <string>
+
+using namespace drogon;
+
+/**
+ * @brief Offline Video Job Handler
+ *
+ * Analyses an uploaded video faster than real time (OfflineJobManager):
+ * the file is split into keyframe-aligned segments that run in parallel
+ * through the solution's pipeline, and the events are merged into one
+ * timeline.
+ *
+ * Endpoints:
+ * - POST /v1/core/video/jobs - Create a job
+ * - GET /v1/core/video/jobs - List jobs
+ * - GET /v1/core/video/jobs/{jobId} - Job status, progress and throughput
+ * - GET /v1/core/video/jobs/{jobId}/events - Merged events (paged)
+ * - DELETE /v1/core/video/jobs/{jobId} - Cancel, or delete a finished job
+ */
+class VideoJobHandler : public drogon::HttpController<VideoJobHandler> {
+public:
+  METHOD_LIST_BEGIN
+  ADD_METHOD_TO(VideoJobHandler::createJob, "/v1/core/video/jobs", Post);
+  ADD_METHOD_TO(VideoJobHandler::listJobs, "/v1/core/video/jobs", Get);
+  ADD_METHOD_TO(VideoJobHandler::getJob, "/v1/core/video/jobs/{jobId}", Get);
+  ADD_METHOD_TO(VideoJobHandler::getJobEvents,
+                "/v1/core/video/jobs/{jobId}/events", Get);
+  ADD_METHOD_TO(VideoJobHandler::deleteJob, "/v1/core/video/jobs/{jobId}",
+                Delete);
+  ADD_METHOD_TO(VideoJobHandler::handleOptions, "/v1/core/video/jobs",
+                Options);
+  ADD_METHOD_TO(VideoJobHandler::handleOptions, "/v1/core/video/jobs/{jobId}",
+                Options);
+  ADD_METHOD_TO(VideoJobHandler::handleOptions,
+                "/v1/core/video/jobs/{jobId}/events", Options);
+  METHOD_LIST_END
+
+  /**
+   * @brief Handle POST /v1/core/video/jobs
+   * Body: video (file in the videos directory), solutionId, additionalParams,
+   * segments, parallelism, includeDetections
+   */
+  void createJob(const HttpRequestPtr &req,
+                 std::function<void(const HttpResponsePtr &)> &&callback);
+
+  /**
+   * @brief Handle GET /v1/core/video/jobs
+   */
+  void listJobs(const HttpRequestPtr &req,
+                std::function<void(const HttpResponsePtr &)> &&callback);
+
+  /**
+   * @brief Handle GET /v1/core/video/jobs/{jobId}
+   */
+  void getJob(const HttpRequestPtr &req,
+              std::function<void(const HttpResponsePtr &)> &&callback);
+
+  /**
+   * @brief Handle GET /v1/core/video/jobs/{jobId}/events?offset=&limit=
+   */
+  void getJobEvents(const HttpRequestPtr &req,
+                    std::function<void(const HttpResponsePtr &)> &&callback);
+
+  /**
+   * @brief Handle DELETE /v1/core/video/jobs/{jobId}
+   */
+  void deleteJob(const HttpRequestPtr &req,
+                 std::function<void(const HttpResponsePtr &)> &&callback);
+
+  /**
+   * @brief Handle OPTIONS request for CORS preflight
+   */
+  void handleOptions(const HttpRequestPtr &req,
+                     std::function<void(const HttpResponsePtr &)> &&callback);
+
+  /**
+   * @brief Set videos directory (same as VideoUploadHandler)
+   */
+  static void setVideosDirectory(const std::string &dir);
+
+private:
+  static std::string videos_dir_;
+
+  /**
+   * @brief Extract job ID from request path
+   */
+  std::string extractJobId(const HttpRequestPtr &req) const;
+
+  /**
+   * @brief Resolve a video name inside the videos directory
+   * @return Path, or empty when the name is invalid (absolute, "..")
+   */
+  std::string resolveVideoPath(const std::string &video) const;
+
+  /**
+   * @brief Create error response
+   */
+  HttpResponsePtr createErrorResponse(int statusCode, const std::string &error,
+                                      const std::string &message) const;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Keyframe-aligned splitting and ordered merging for offline video jobs
+ *
+ * An offline job cuts a recording into segments that each start on a
+ * keyframe, so every segment decodes independently (a seek lands exactly on
+ * the segment start, nothing before it is decoded twice). Segments are
+ * analysed in parallel; each writes its events in time order and the
+ * streams are merged back into one timeline.
+ *
+ * Segment event streams use one line per event: "<time_sec>\t<json>". The
+ * merged output keeps only the JSON (JSON Lines).
+ *
+ * No SDK dependency, so it can be unit tested on its own.
+ */
+namespace VideoSegmenter {
+
+struct Segment {
+  size_t index = 0;
+  double start_sec = 0.0; // Keyframe the segment starts on
+  double end_sec = 0.0;   // Start of the next segment (exclusive)
+};
+
+/**
+ * @brief Parse keyframe times from ffprobe output
+ *
+ * Accepts "pts_time" lines and "pts_time,flags" packet lines (only packets
+ * whose flags contain 'K' are keyframes). Unparseable lines (N/A, blank) are
+ * skipped. Result is sorted and de-duplicated.
+ */
+std::vector<double> parseKeyframeTimes(const std::string &output);
+
+/**
+ * @brief Split [0, duration) into at most target_count keyframe-aligned
+ * segments of roughly equal length
+ *
+ * Each boundary is the keyframe closest to an even split point. Boundaries
+ * that would leave a segment shorter than min_segment_sec are dropped, so
+ * sparse keyframes or short videos give fewer (never empty) segments. Without
+ * keyframes or a known duration the whole video is one segment.
+ */
+std::vector<Segment> planSegments(const std::vector<double> &keyframes,
+                                  double duration_sec, size_t target_count,
+                                  double min_segment_sec = 10.0);
+
+/**
+ * @brief Format one segment event line
+ */
+std::string formatEventLine(double time_sec, const std::string &json);
+
+/**
+ * @brief Merge per-segment event streams into one timeline
+ *
+ * Streams must each be in time order. Ties keep stream order (earlier
+ * segment first), then line order. Writes the JSON part of every line
+ * followed by '\n'; malformed lines are skipped.
+ *
+ * @return Number of events written
+ */
+uint64_t mergeEventStreams(const std::vector<std::istream *> &inputs,
+                           std::ostream &output);
+
+} // namespace VideoSegmenter
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstdint>
+#include <json/json.h>
+#include <mutex>
+#include <optional>
+#include <sched.h>
+#include <string>
+#include <sys/types.h>
+#include <unordered_map>
+#include <vector>
+
+namespace worker {
+
+/**
+ * @brief CPU affinity and NUMA placement of worker processes
+ *
+ * Each worker gets a small set of CPUs (EDGE_AI_CPUS_PER_WORKER) inside one
+ * NUMA node and prefers memory from that node, so its decode, inference and
+ * encode threads share caches instead of floating over every core. CPUs are
+ * scored by load divided by cpu_capacity, which keeps pipelines on big
+ * cores of big.LITTLE SoCs as long as that is cheaper than sharing.
+ *
+ * Policies (EDGE_AI_WORKER_PLACEMENT):
+ * - none:   no pinning (default); reserved CPUs are still excluded
+ * - pack:   fill the lowest NUMA node first, up to
+ *           EDGE_AI_WORKERS_PER_CPU workers per CPU, then the next one
+ * - spread: put each worker on the least loaded CPUs of the least loaded
+ *           node
+ *
+ * EDGE_AI_RESERVED_CPUS (cpulist, e.g. "0-1") pins the API process to those
+ * CPUs and keeps workers off them. When a worker is released the remaining
+ * workers are re-placed greedily within their NUMA node (memory already
+ * allocated stays local); moves are applied to every thread of the running
+ * worker.
+ */
+class CpuPlacement {
+public:
+  enum class Policy { None, Pack, Spread };
+
+  struct Config {
+    Policy policy = Policy::None;
+    std::vector<int> reserved_cpus;
+    int cpus_per_worker = 2;
+    int workers_per_cpu = 1; // Pack: load per CPU before the next node
+  };
+
+  struct Cpu {
+    int id = 0;
+    int node = 0;
+    int capacity = 1024; // cpu_capacity (1024 = biggest core)
+  };
+
+  struct Assignment {
+    std::vector<int> cpus; // Empty: no pinning beyond excluding reserved
+    int node = -1;         // Preferred memory node, -1 for none
+  };
+
+  /**
+   * @brief A placement change for a running worker
+   */
+  struct Move {
+    std::string instance_id;
+    Assignment assignment;
+  };
+
+  static CpuPlacement &getInstance() {
+    static CpuPlacement instance;
+    return instance;
+  }
+
+  /**
+   * @brief Read configuration from the environment and topology from sysfs,
+   * and pin the calling process to the reserved CPUs (idempotent)
+   */
+  void initialize();
+
+  /**
+   * @brief Replace configuration and topology (tests)
+   */
+  void configure(const Config &config, const std::vector<Cpu> &cpus);
+
+  /**
+   * @brief Placement for a worker; an instance keeps its CPUs across
+   * restarts until release()
+   */
+  Assignment assign(const std::string &instance_id);
+
+  /**
+   * @brief Free an instance's CPUs and re-place the remaining workers
+   * @return Workers whose placement changed
+   */
+  std::vector<Move> release(const std::string &instance_id);
+
+  std::optional<Assignment> getAssignment(const std::string &instance_id) const;
+
+  /**
+   * @brief Apply an assignment to the calling process
+   * Only uses raw syscalls, for use in a child between fork() and exec().
+   */
+  static void applyInChild(const cpu_set_t &mask, int node);
+
+  /**
+   * @brief Apply CPUs to every thread of a running process
+   */
+  static bool applyToProcess(pid_t pid, const std::vector<int> &cpus);
+
+  static cpu_set_t toMask(const std::vector<int> &cpus);
+  static std::vector<int> parseCpuList(const std::string &list);
+  static std::string formatCpuList(const std::vector<int> &cpus);
+
+  // Busy and total jiffies of each CPU at a caller's previous sample
+  using CpuTimes = std::unordered_map<int, std::pair<uint64_t, uint64_t>>;
+
+  /**
+   * @brief Per-CPU utilization (0-1) since the sample in previous, from
+   * /proc/stat; previous is updated. Each reader keeps its own baseline so
+   * one does not shorten the other's interval.
+   */
+  static std::unordered_map<int, double> sampleUtilization(CpuTimes &previous);
+
+  // Utilization since the previous call of the same method
+  Json::Value getStatsJson();
+  std::string getPrometheusMetrics();
+
+private:
+  CpuPlacement() = default;
+  CpuPlacement(const CpuPlacement &) = delete;
+  CpuPlacement &operator=(const CpuPlacement &) = delete;
+
+  struct Placed {
+    uint64_t seq = 0;
+    Assignment assignment;
+  };
+
+  static std::vector<Cpu> readTopology();
+
+  void configureLocked(const Config &config, const std::vector<Cpu> &cpus);
+  // Cheapest CPUs for one more worker, optionally within one node
+  Assignment chooseLocked(int only_node = -1) const;
+  double costLocked(const std::vector<int> &cpus) const;
+  void addLoadLocked(const Assignment &assignment, int delta);
+
+  mutable std::mutex mutex_;
+  bool initialized_ = false;
+  Config config_;
+  std::vector<Cpu> cpus_; // Online, not reserved
+  std::unordered_map<int, int> load_; // CPU -> workers
+  std::unordered_map<std::string, Placed> placed_;
+  uint64_t next_seq_ = 0;
+
+  std::mutex sample_mutex_;
+  CpuTimes stats_sample_;   // getStatsJson()
+  CpuTimes metrics_sample_; // getPrometheusMetrics()
+};
+
+} // namespace worker
@@ -35,12 +35,15 @@ enum class MessageType : uint8_t {
   GET_STATISTICS_RESPONSE = 23,
   GET_LAST_FRAME = 24,
   GET_LAST_FRAME_RESPONSE = 25,
+  GET_QUEUE_TELEMETRY = 26,
+  GET_QUEUE_TELEMETRY_RESPONSE = 27,
 
   // Events (worker -> supervisor)
   INSTANCE_STATE_CHANGED = 30,
   INSTANCE_ERROR = 31,
   WORKER_READY = 32,
   WORKER_MEMORY_WARNING = 33,
+  STATISTICS_UPDATE = 34, // Periodic statistics delta, no response expected
 
   // Error
   ERROR_RESPONSE = 255
@@ -111,4 +114,26 @@ Json::Value createResponse(ResponseStatus status,
 Json::Value createErrorResponse(const std::string &error,
                                 ResponseStatus status = ResponseStatus::ERROR);
 
+/**
+ * @brief Check if a message is pushed by the worker on its own (not a reply)
+ *
+ * Push events can arrive on the IPC socket at any time, including while the
+ * supervisor waits for the response to a request. WORKER_READY is excluded:
+ * it is the handshake read explicitly after connecting.
+ */
+bool isPushEvent(MessageType type);
+
+/**
+ * @brief Compute a statistics delta (members of current that differ from
+ * previous)
+ * @return Object with the changed members only (empty if nothing changed)
+ */
+Json::Value diffStatistics(const Json::Value &previous,
+                           const Json::Value &current);
+
+/**
+ * @brief Apply a delta produced by diffStatistics() onto a snapshot
+ */
+void applyStatisticsDelta(Json::Value &snapshot, const Json::Value &delta);
+
 } // namespace worker
@@ -50,6 +50,15 @@ public:
    */
   const std::string &getSocketPath() const { return socket_path_; }
 
+  /**
+   * @brief Push an event message to the connected client
+   *
+   * Thread-safe with respect to responses sent by the accept thread. The
+   * event is dropped (returns false) if no client is connected or the socket
+   * send buffer is full, so a stalled supervisor never blocks the caller.
+   */
+  bool sendEvent(const IPCMessage &msg);
+
 private:
   std::string socket_path_;
   int server_fd_ = -1;
@@ -58,6 +67,13 @@ private:
   MessageHandler handler_;
   ClientConnectedCallback on_client_connected_;
 
+  // Connected client (-1 if none); writes to it are serialized by send_mutex_
+  std::atomic<int> client_fd_{-1};
+  std::mutex send_mutex_;
+
+  bool sendAll(int fd, const std::string &data);
+  void releaseClient(int client_fd);
+
   void acceptLoop();
   void handleClient(int client_fd);
 };
@@ -69,6 +85,8 @@ private:
  */
 class UnixSocketClient {
 public:
+  using EventHandler = std::function<void(const IPCMessage &event)>;
+
   explicit UnixSocketClient(const std::string &socket_path);
   ~UnixSocketClient();
 
@@ -93,6 +111,11 @@ public:
    */
   bool isConnected() const { return connected_.load(); }
 
+  /**
+   * @brief Socket file descriptor (-1 if not connected), for hang-up watching
+   */
+  int getFd() const { return socket_fd_; }
+
   /**
    * @brief Send message and wait for response
    * @param msg Message to send
@@ -115,15 +138,44 @@ public:
    */
   IPCMessage receive(int timeout_ms = 30000);
 
+  /**
+   * @brief Set handler for push events (see isPushEvent())
+   * Events read while waiting for a response are passed to the handler
+   * instead of being mistaken for the response. The handler runs on the
+   * reading thread and must be cheap.
+   */
+  void setEventHandler(EventHandler handler);
+
+  /**
+   * @brief Dispatch push events that are already buffered on the socket
+   * Never waits for data to arrive. Returns immediately if another thread is
+   * receiving (that thread dispatches events itself).
+   * @return Number of events dispatched
+   */
+  size_t pollEvents();
+
 private:
   std::string socket_path_;
   int socket_fd_ = -1;
   std::atomic<bool> connected_{false};
   std::mutex send_mutex_;
   std::mutex recv_mutex_;
+  EventHandler event_handler_; // Guarded by recv_mutex_
 
   bool sendRaw(const std::string &data);
   std::string receiveRaw(size_t expected_size, int timeout_ms);
+
+  /**
+   * @brief Read one complete message (recv_mutex_ must be held)
+   * @return false on timeout/error, with error set
+   */
+  bool readMessage(IPCMessage &out, int timeout_ms, std::string &error);
+
+  /**
+   * @brief Read the next message that is not a push event, dispatching any
+   * events received before it (recv_mutex_ must be held)
+   */
+  bool readReply(IPCMessage &out, int timeout_ms, std::string &error);
 };
 
 /**
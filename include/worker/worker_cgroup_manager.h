@@ -0,0 +1,118 @@
+#pragma once
+
+#include "models/resource_limits.h"
+#include <cstdint>
+#include <json/json.h>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace worker {
+
+/**
+ * @brief Resource usage of one worker, read from its cgroup
+ */
+struct WorkerResourceUsage {
+  uint64_t cpu_usage_usec = 0;     // cpu.stat usage_usec
+  uint64_t cpu_throttled_usec = 0; // cpu.stat throttled_usec (cpu.max)
+  uint64_t memory_current = 0;     // memory.current (bytes)
+  uint64_t memory_anon = 0;        // memory.stat anon, ~RSS (bytes)
+  uint64_t memory_high_events = 0; // memory.events high
+  uint64_t oom_events = 0;         // memory.events oom
+  uint64_t oom_kill_events = 0;    // memory.events oom_kill
+  double cpu_pressure_avg10 = 0.0; // cpu.pressure some avg10 (%)
+  double memory_pressure_avg10 = 0.0; // memory.pressure some avg10 (%)
+  uint64_t cpu_pressure_total_usec = 0;    // cpu.pressure some total
+  uint64_t memory_pressure_total_usec = 0; // memory.pressure some total
+
+  Json::Value toJson() const;
+};
+
+/**
+ * @brief Places each worker process in its own cgroup v2 leaf
+ *
+ * Leaves are created under a delegated subtree (EDGE_AI_WORKER_CGROUP_ROOT,
+ * or the server's own cgroup when systemd delegates it with Delegate=yes).
+ * If the server itself lives in that cgroup it is moved to a "supervisor"
+ * leaf first, since cgroup v2 only allows processes in leaves once
+ * controllers are enabled for children.
+ *
+ * Disabled unless EDGE_AI_WORKER_CGROUPS=1. Every failure (no cgroup2, no
+ * write access, controller unavailable) is logged and leaves the worker
+ * unconfined rather than failing the spawn.
+ */
+class WorkerCgroupManager {
+public:
+  static WorkerCgroupManager &getInstance() {
+    static WorkerCgroupManager instance;
+    return instance;
+  }
+
+  /**
+   * @brief Resolve and prepare the delegated subtree (idempotent)
+   * @return true if worker cgroups are available
+   */
+  bool initialize();
+
+  bool isEnabled() const;
+
+  /**
+   * @brief Create (or reuse) the leaf of an instance and apply its limits
+   * Called in the parent before fork(). A leaf is kept across restarts of
+   * the same instance so OOM counters survive a crash.
+   * @return Path of the leaf's cgroup.procs file, or empty if unavailable
+   */
+  std::string prepare(const std::string &instance_id,
+                      const ResourceLimits &limits);
+
+  /**
+   * @brief Move the calling process into a cgroup
+   * Only uses async-signal-safe calls, for use in a child between fork()
+   * and exec().
+   */
+  static void joinFromChild(const char *procs_path);
+
+  /**
+   * @brief Remove an instance's leaf (its processes must have exited)
+   */
+  void remove(const std::string &instance_id);
+
+  std::optional<WorkerResourceUsage>
+  readUsage(const std::string &instance_id) const;
+
+  /**
+   * @brief Per-worker resource metrics in Prometheus format
+   */
+  std::string getPrometheusMetrics() const;
+
+  /**
+   * @brief Format ResourceLimits::cpuMax as a cpu.max value
+   * e.g. 1.5 cores -> "150000 100000"; 0 -> "max 100000"
+   */
+  static std::string formatCpuMax(double cores);
+
+  /**
+   * @brief Parse "some avg10=... total=..." lines of a PSI file
+   */
+  static void parsePressure(const std::string &content, double &some_avg10,
+                            uint64_t &some_total_usec);
+
+private:
+  WorkerCgroupManager() = default;
+  WorkerCgroupManager(const WorkerCgroupManager &) = delete;
+  WorkerCgroupManager &operator=(const WorkerCgroupManager &) = delete;
+
+  bool initializeLocked();
+  std::string leafPathLocked(const std::string &instance_id) const;
+
+  mutable std::mutex mutex_;
+  bool initialized_ = false;
+  bool enabled_ = false;
+  bool cpu_controller_ = false;
+  bool memory_controller_ = false;
+  std::string root_;
+  std::unordered_map<std::string, std::string> leaves_; // instance -> path
+};
+
+} // namespace worker
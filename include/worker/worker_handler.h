@@ -13,6 +13,7 @@
 #include <opencv2/core.hpp>
 #include <shared_mutex>
 #include <string>
+#include <thread>
 
 // Forward declarations for CVEDIX types
 namespace cvedix_nodes {
@@ -122,8 +123,15 @@ private:
   std::chrono::steady_clock::time_point last_fps_update_;
   std::atomic<double> current_fps_{0.0};
   std::atomic<size_t> queue_size_{0};
-  std::string resolution_;
-  std::string source_resolution_;
+  std::atomic<int> frame_width_{0}; // Last processed frame (resolution)
+  std::atomic<int> frame_height_{0};
+  std::atomic<double> source_fps_{0.0}; // Last known source framerate
+  std::string source_resolution_;       // Guarded by state_mutex_
+
+  // Statistics push to supervisor (STATISTICS_UPDATE events)
+  std::thread stats_push_thread_;
+  std::mutex stats_push_mutex_;
+  std::condition_variable stats_push_cv_;
 
   // Frame cache - use shared_ptr to avoid expensive clone() operations
   // This optimization eliminates ~6MB memory copy per frame update
@@ -158,6 +166,35 @@ private:
   IPCMessage handleGetStatus(const IPCMessage &msg);
   IPCMessage handleGetStatistics(const IPCMessage &msg);
   IPCMessage handleGetLastFrame(const IPCMessage &msg);
+  IPCMessage handleGetQueueTelemetry(const IPCMessage &msg);
+
+  /**
+   * @brief Query source node for framerate/resolution (100ms timeout)
+   * Updates source_fps_ and source_resolution_.
+   */
+  void refreshSourceInfo();
+
+  /**
+   * @brief Build statistics JSON from counters and cached source info
+   * Cheap: does not touch pipeline nodes.
+   */
+  Json::Value buildStatisticsData() const;
+
+  /**
+   * @brief Start pushing statistics deltas to the supervisor
+   * Interval from WORKER_STATS_PUSH_INTERVAL_MS (0 disables the push).
+   */
+  void startStatsPush();
+
+  /**
+   * @brief Stop the statistics push thread
+   */
+  void stopStatsPush();
+
+  /**
+   * @brief Statistics push loop (runs in stats_push_thread_)
+   */
+  void statsPushLoop(std::chrono::milliseconds interval);
 
   /**
    * @brief Build pipeline from config
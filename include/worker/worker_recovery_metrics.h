@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <json/json.h>
+#include <string>
+
+namespace worker {
+
+/**
+ * @brief Crash and restart metrics of worker processes
+ *
+ * Recorded by WorkerSupervisor. Recovery time is measured from the moment a
+ * worker exit is detected until the restarted worker reports its first
+ * processed frame (via pushed statistics).
+ */
+class WorkerRecoveryMetrics {
+public:
+  struct Stats {
+    uint64_t crashes = 0;
+    uint64_t restarts = 0;
+    uint64_t restart_failures = 0;
+    uint64_t recoveries = 0; // Restarted and processing frames again
+    double recovery_seconds_sum = 0.0;
+    double last_recovery_seconds = 0.0;
+  };
+
+  static WorkerRecoveryMetrics &getInstance() {
+    static WorkerRecoveryMetrics instance;
+    return instance;
+  }
+
+  void recordCrash();
+  void recordRestart();
+  void recordRestartFailure();
+  void recordRecovery(std::chrono::steady_clock::duration crash_to_first_frame);
+
+  Stats getStats() const;
+  Json::Value getStatsJson() const;
+
+  /**
+   * @brief Prometheus exposition of crash/restart/recovery metrics
+   */
+  std::string getPrometheusMetrics() const;
+
+private:
+  WorkerRecoveryMetrics() = default;
+  WorkerRecoveryMetrics(const WorkerRecoveryMetrics &) = delete;
+  WorkerRecoveryMetrics &operator=(const WorkerRecoveryMetrics &) = delete;
+
+  std::atomic<uint64_t> crashes_{0};
+  std::atomic<uint64_t> restarts_{0};
+  std::atomic<uint64_t> restart_failures_{0};
+  std::atomic<uint64_t> recoveries_{0};
+  std::atomic<uint64_t> recovery_us_sum_{0};
+  std::atomic<uint64_t> last_recovery_us_{0};
+};
+
+} // namespace worker
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+
+namespace worker {
+
+/**
+ * @brief When a crashed worker is restarted, and when to give up
+ *
+ * The first restart is immediate; a crash loop (or a restart that fails to
+ * spawn) backs off exponentially from base_delay_ms up to max_delay_ms. A
+ * worker that ran longer than stable_after before crashing starts over with
+ * its full restart budget.
+ */
+struct WorkerRestartPolicy {
+  int max_restarts = 3;
+  int base_delay_ms = 1000;
+  int max_delay_ms = 30000;
+  std::chrono::steady_clock::duration stable_after = std::chrono::minutes(5);
+
+  /**
+   * @brief Delay before restart attempt n (1-based)
+   */
+  int delayMs(int attempt) const {
+    if (attempt <= 1) {
+      return 0;
+    }
+    long long delay = static_cast<long long>(base_delay_ms)
+                      << std::min(attempt - 2, 5);
+    return static_cast<int>(
+        std::min<long long>(delay, static_cast<long long>(max_delay_ms)));
+  }
+
+  /**
+   * @brief Whether a worker that already used restart_count attempts gets
+   * no further restart
+   */
+  bool exhausted(int restart_count) const {
+    return restart_count >= max_restarts;
+  }
+
+  /**
+   * @brief Whether a crash after this uptime resets the restart budget
+   */
+  bool ranStably(std::chrono::steady_clock::duration uptime) const {
+    return uptime > stable_after;
+  }
+};
+
+} // namespace worker
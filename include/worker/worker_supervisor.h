@@ -4,11 +4,15 @@
 #include "models/create_instance_request.h"
 #include "worker/ipc_protocol.h"
 #include "worker/unix_socket.h"
+#include "worker/worker_restart_policy.h"
 #include <atomic>
+#include <condition_variable>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <string>
 #include <sys/types.h>
 #include <thread>
@@ -41,6 +45,11 @@ struct WorkerInfo {
   std::chrono::steady_clock::time_point last_heartbeat;
   int restart_count = 0;
   std::string last_error;
+  Json::Value config;           // Spawn config, reused on restart
+  bool pipeline_started = false; // START_INSTANCE succeeded, not stopped since
+  int pidfd = -1;               // Exit notification fd (-1 if unsupported)
+  bool restarting = false;      // Crashed, restart scheduled or in progress
+  uint64_t restart_ticket = 0;  // Identifies the scheduled restart
 };
 
 /**
@@ -51,6 +60,16 @@ struct WorkerInfo {
  * - Monitor worker health (heartbeat)
  * - Handle worker crashes and restart
  * - Route commands to workers via Unix sockets
+ *
+ * Worker exits are detected without polling: each worker's pidfd and the
+ * hang-up of its IPC socket are watched in one epoll set, so a crashed
+ * worker is restarted (and its pipeline resumed) right away. On kernels
+ * without pidfd_open the heartbeat loop's waitpid() remains the fallback.
+ *
+ * Restarts run on their own thread, after the backoff of
+ * WorkerRestartPolicy. The crashed entry stays in place (marked restarting)
+ * until the new process is ready and swapped in, so terminateWorker() during
+ * a restart removes the instance and the new process is killed.
  */
 class WorkerSupervisor {
 public:
@@ -59,6 +78,9 @@ public:
                          WorkerState new_state)>;
   using ErrorCallback = std::function<void(const std::string &instance_id,
                                            const std::string &error)>;
+  using RestartCallback =
+      std::function<void(const std::string &instance_id, bool restarted,
+                         bool pipeline_resumed)>;
 
   /**
    * @brief Constructor
@@ -136,16 +158,35 @@ public:
    */
   void setErrorCallback(ErrorCallback callback);
 
+  /**
+   * @brief Set callback invoked after a crashed worker was restarted, or
+   * with restarted = false once its restarts are exhausted
+   */
+  void setRestartCallback(RestartCallback callback);
+
   /**
    * @brief Get worker info (for debugging)
    */
   std::optional<WorkerInfo> getWorkerInfo(const std::string &instance_id) const;
 
+  /**
+   * @brief Latest statistics pushed by a worker (STATISTICS_UPDATE)
+   *
+   * Served from memory, without an IPC round trip.
+   * @param instance_id Instance ID
+   * @param max_age Snapshots not refreshed within this time are ignored
+   * @return Same fields as the GET_STATISTICS response data, or nullopt if
+   * no fresh snapshot exists (pipeline stopped, push disabled, ...)
+   */
+  std::optional<Json::Value>
+  getLatestStatistics(const std::string &instance_id,
+                      std::chrono::milliseconds max_age) const;
+
   // Configuration
   void setHeartbeatInterval(int ms) { heartbeat_interval_ms_ = ms; }
   void setHeartbeatTimeout(int ms) { heartbeat_timeout_ms_ = ms; }
-  void setMaxRestarts(int count) { max_restarts_ = count; }
-  void setRestartDelay(int ms) { restart_delay_ms_ = ms; }
+  void setMaxRestarts(int count) { restart_policy_.max_restarts = count; }
+  void setRestartDelay(int ms) { restart_policy_.base_delay_ms = ms; }
 
 private:
   std::string worker_executable_;
@@ -155,15 +196,55 @@ private:
 
   std::atomic<bool> running_{false};
   std::thread monitor_thread_;
+  std::thread event_thread_;
+
+  // Exit watching: token -> watched fd (pidfd or IPC socket)
+  struct ExitWatch {
+    std::string instance_id;
+    pid_t pid = -1;
+    int fd = -1;
+    bool is_pidfd = false;
+  };
+  int epoll_fd_ = -1;
+  int wake_fd_ = -1; // eventfd, wakes exitWatchLoop on stop
+  std::thread exit_watch_thread_;
+  std::mutex watch_mutex_;
+  std::unordered_map<uint64_t, ExitWatch> exit_watches_;
+  uint64_t next_watch_token_ = 1;
+
+  // Latest pushed statistics per instance (delta-merged)
+  struct StatisticsSnapshot {
+    Json::Value data;
+    uint64_t seq = 0;
+    std::chrono::steady_clock::time_point updated;
+  };
+  mutable std::shared_mutex statistics_mutex_;
+  std::unordered_map<std::string, StatisticsSnapshot> latest_statistics_;
+  // Restarted instances waiting for their first frame -> crash time
+  std::unordered_map<std::string, std::chrono::steady_clock::time_point>
+      recovering_;
+
+  // Crashed workers waiting for their next restart attempt, by due time
+  struct PendingRestart {
+    std::string instance_id;
+    uint64_t ticket = 0;
+    std::chrono::steady_clock::time_point crashed_at;
+  };
+  std::thread restart_thread_;
+  std::mutex restart_mutex_;
+  std::condition_variable restart_cv_;
+  std::multimap<std::chrono::steady_clock::time_point, PendingRestart>
+      pending_restarts_;
+  uint64_t next_restart_ticket_ = 1; // Guarded by workers_mutex_
 
   StateChangeCallback state_change_callback_;
   ErrorCallback error_callback_;
+  RestartCallback restart_callback_;
 
   // Configuration
   int heartbeat_interval_ms_ = 5000;
   int heartbeat_timeout_ms_ = 15000;
-  int max_restarts_ = 3;
-  int restart_delay_ms_ = 1000;
+  WorkerRestartPolicy restart_policy_;
   int worker_startup_timeout_ms_ = 30000;
 
   /**
@@ -171,20 +252,96 @@ private:
    */
   void monitorLoop();
 
+  /**
+   * @brief Event thread - drains events pushed by workers
+   */
+  void eventLoop();
+
+  /**
+   * @brief Handle an event pushed by a worker
+   * Runs on whichever thread read it; must not take workers_mutex_.
+   */
+  void handleWorkerEvent(const std::string &instance_id,
+                         const IPCMessage &event);
+
   /**
    * @brief Check single worker health
    */
   void checkWorkerHealth(WorkerInfo &worker);
 
   /**
-   * @brief Handle worker crash
+   * @brief Exit watch thread - waits for worker exit / socket hang-up
+   */
+  void exitWatchLoop();
+
+  /**
+   * @brief Register pidfd and IPC socket of a worker (workers_mutex_ held)
+   */
+  void watchWorker(WorkerInfo &worker);
+
+  /**
+   * @brief Remove all exit watches of a worker (workers_mutex_ held)
+   */
+  void unwatchWorker(WorkerInfo &worker);
+
+  /**
+   * @brief Worker process exited (pidfd readable)
+   */
+  void onWorkerExited(const std::string &instance_id, pid_t pid);
+
+  /**
+   * @brief Worker closed its IPC connection
+   */
+  void onWorkerHangup(const std::string &instance_id, pid_t pid);
+
+  /**
+   * @brief Handle worker crash: schedule a restart or give up
+   * Only does bookkeeping, so the exit watch returns to epoll right away.
    */
   void handleWorkerCrash(const std::string &instance_id);
 
   /**
-   * @brief Restart a crashed worker
+   * @brief Count the next restart attempt of a crashed worker and schedule
+   * it after its backoff, or remove the worker when restarts are exhausted
+   * (workers_mutex_ held)
+   * @return Restart ticket, or 0 when the worker was given up
+   */
+  uint64_t nextRestartLocked(WorkerInfo &worker, int &delay_ms);
+
+  /**
+   * @brief Report a worker whose restarts are exhausted (no lock held)
+   */
+  void giveUpRestart(const std::string &instance_id);
+
+  /**
+   * @brief Queue a restart attempt for the restart thread
    */
-  bool restartWorker(const std::string &instance_id);
+  void scheduleRestart(const std::string &instance_id, uint64_t ticket,
+                       std::chrono::steady_clock::time_point crashed_at,
+                       int delay_ms);
+
+  /**
+   * @brief Restart thread - runs restart attempts when they are due
+   */
+  void restartLoop();
+
+  /**
+   * @brief Restart a crashed worker with its spawn config and resume its
+   * pipeline if it was running
+   * @param ticket Restart ticket; stale when the worker was terminated or
+   * respawned meanwhile
+   * @param crashed_at When the crash was detected (for recovery metrics)
+   */
+  bool restartWorker(const std::string &instance_id, uint64_t ticket,
+                     std::chrono::steady_clock::time_point crashed_at);
+
+  /**
+   * @brief Fork a worker process and wait until it is ready
+   * Does not touch workers_; resources are left assigned on failure.
+   * @return Ready worker, or nullptr
+   */
+  std::unique_ptr<WorkerInfo> launchWorker(const std::string &instance_id,
+                                           const Json::Value &config);
 
   /**
    * @brief Wait for worker to become ready
@@ -201,6 +358,13 @@ private:
    */
   void cleanupWorker(WorkerInfo &worker);
 
+  /**
+   * @brief Release an instance's cgroup leaf and CPUs once its worker is gone
+   * Re-pins the remaining workers if the placement changed.
+   * Must be called with workers_mutex_ held.
+   */
+  void releaseInstanceResourcesLocked(const std::string &instance_id);
+
   /**
    * @brief Find worker executable in PATH or relative to current binary
    */
@@ -0,0 +1,267 @@
+#!/usr/bin/env python3
+"""
+Edge AI API - Synthetic load driver
+
+Tạo N instance dùng solution "synthetic_load_test" (nguồn frame sinh sẵn,
+detector giả lập, không cần camera/model/GPU), giữ tải trong một khoảng thời
+gian rồi xoá. Trong lúc chạy, script liên tục gọi API đọc trạng thái để đo độ
+trễ của control plane (lock contention trong registry, IPC tới worker) và lấy
+mẫu RSS của tiến trình edge_ai_api / edge_ai_worker để tính bộ nhớ/instance.
+
+Chỉ dùng thư viện chuẩn của Python 3.
+
+Usage:
+  ./scripts/synthetic_load.py --instances 100 --duration 60
+  ./scripts/synthetic_load.py --instances 200 --fps 10 --latency-ms 30 \\
+      --boxes 20 --output load_200.json
+"""
+
+import argparse
+import json
+import os
+import statistics
+import sys
+import threading
+import time
+import urllib.error
+import urllib.request
+from concurrent.futures import ThreadPoolExecutor
+
+SOLUTION_ID = "synthetic_load_test"
+PROCESS_NAMES = ("edge_ai_api", "edge_ai_worker")
+
+
+class Recorder:
+    """Latency samples and error counts per endpoint (thread-safe)."""
+
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.samples = {}
+        self.errors = {}
+
+    def add(self, name, seconds, ok):
+        with self.lock:
+            self.samples.setdefault(name, []).append(seconds * 1000.0)
+            if not ok:
+                self.errors[name] = self.errors.get(name, 0) + 1
+
+    def summary(self):
+        result = {}
+        with self.lock:
+            for name, values in sorted(self.samples.items()):
+                ordered = sorted(values)
+
+                def pct(p):
+                    index = min(len(ordered) - 1, int(p / 100.0 * len(ordered)))
+                    return round(ordered[index], 2)
+
+                result[name] = {
+                    "count": len(ordered),
+                    "errors": self.errors.get(name, 0),
+                    "mean_ms": round(statistics.fmean(ordered), 2),
+                    "p50_ms": pct(50),
+                    "p95_ms": pct(95),
+                    "p99_ms": pct(99),
+                    "max_ms": round(ordered[-1], 2),
+                }
+        return result
+
+
+class Client:
+    def __init__(self, base_url, recorder, timeout):
+        self.base_url = base_url.rstrip("/")
+        self.recorder = recorder
+        self.timeout = timeout
+
+    def request(self, name, method, path, body=None):
+        data = json.dumps(body).encode() if body is not None else None
+        req = urllib.request.Request(
+            self.base_url + path,
+            data=data,
+            method=method,
+            headers={"Content-Type": "application/json"},
+        )
+        start = time.perf_counter()
+        status, payload = 0, None
+        try:
+            with urllib.request.urlopen(req, timeout=self.timeout) as resp:
+                status = resp.status
+                payload = resp.read()
+        except urllib.error.HTTPError as e:
+            status = e.code
+            payload = e.read()
+        except (urllib.error.URLError, OSError):
+            pass
+        elapsed = time.perf_counter() - start
+        ok = 200 <= status < 300
+        self.recorder.add(name, elapsed, ok)
+        try:
+            return status, json.loads(payload) if payload else None
+        except ValueError:
+            return status, None
+
+
+def read_rss_kb():
+    """Total RSS (kB) of the server and worker processes, from /proc."""
+    total, processes = 0, 0
+    for pid in os.listdir("/proc"):
+        if not pid.isdigit():
+            continue
+        try:
+            with open(f"/proc/{pid}/comm") as f:
+                comm = f.read().strip()
+            if not comm.startswith(PROCESS_NAMES):
+                continue
+            with open(f"/proc/{pid}/status") as f:
+                for line in f:
+                    if line.startswith("VmRSS:"):
+                        total += int(line.split()[1])
+                        processes += 1
+                        break
+        except (OSError, ValueError):
+            continue
+    return total, processes
+
+
+def create_instances(client, args):
+    params = {
+        "SYNTHETIC_WIDTH": str(args.width),
+        "SYNTHETIC_HEIGHT": str(args.height),
+        "SYNTHETIC_FPS": str(args.fps),
+        "SYNTHETIC_LATENCY_MS": str(args.latency_ms),
+        "SYNTHETIC_LATENCY_JITTER_MS": str(args.latency_jitter_ms),
+        "SYNTHETIC_LATENCY_MODE": args.latency_mode,
+        "SYNTHETIC_BOXES": str(args.boxes),
+    }
+
+    def create(index):
+        body = {
+            "name": f"synthetic-{index:04d}",
+            "group": "synthetic-load",
+            "solution": SOLUTION_ID,
+            "autoStart": True,
+            "additionalParams": dict(params, SYNTHETIC_SEED=str(index)),
+        }
+        status, payload = client.request("create", "POST", "/v1/core/instance",
+                                         body)
+        if 200 <= status < 300 and payload:
+            return payload.get("instanceId")
+        print(f"  create #{index} failed: HTTP {status} {payload}",
+              file=sys.stderr)
+        return None
+
+    with ThreadPoolExecutor(max_workers=args.concurrency) as pool:
+        ids = list(pool.map(create, range(args.instances)))
+    return [i for i in ids if i]
+
+
+def poll(client, ids, args, stop):
+    """Read-side load: what dashboards and the supervisor do continuously."""
+    fps = []
+
+    def one(instance_id):
+        status, payload = client.request(
+            "statistics", "GET", f"/v1/core/instance/{instance_id}/statistics")
+        if status == 200 and payload:
+            fps.append(float(payload.get("current_framerate", 0.0)))
+        if args.frames:
+            client.request("frame", "GET",
+                           f"/v1/core/instance/{instance_id}/frame")
+
+    with ThreadPoolExecutor(max_workers=args.concurrency) as pool:
+        while not stop.is_set():
+            started = time.monotonic()
+            fps.clear()
+            list(pool.map(one, ids))
+            client.request("list", "GET", "/v1/core/instance")
+            stop.wait(max(0.0, args.poll_interval -
+                          (time.monotonic() - started)))
+    return fps
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Scale-test the control plane with synthetic instances")
+    parser.add_argument("--url", default="http://localhost:8080")
+    parser.add_argument("--instances", type=int, default=100)
+    parser.add_argument("--concurrency", type=int, default=16,
+                        help="parallel HTTP requests")
+    parser.add_argument("--duration", type=float, default=60.0,
+                        help="seconds to hold the load")
+    parser.add_argument("--poll-interval", type=float, default=1.0)
+    parser.add_argument("--frames", action="store_true",
+                        help="also fetch the last frame of every instance")
+    parser.add_argument("--width", type=int, default=1280)
+    parser.add_argument("--height", type=int, default=720)
+    parser.add_argument("--fps", type=float, default=25.0)
+    parser.add_argument("--latency-ms", type=int, default=10)
+    parser.add_argument("--latency-jitter-ms", type=int, default=0)
+    parser.add_argument("--latency-mode", choices=("sleep", "busy"),
+                        default="sleep")
+    parser.add_argument("--boxes", type=int, default=5)
+    parser.add_argument("--timeout", type=float, default=30.0)
+    parser.add_argument("--keep", action="store_true",
+                        help="do not delete the instances at the end")
+    parser.add_argument("--output", help="write the JSON report here")
+    args = parser.parse_args()
+
+    recorder = Recorder()
+    client = Client(args.url, recorder, args.timeout)
+
+    rss_before, _ = read_rss_kb()
+    print(f"Creating {args.instances} instances ({args.width}x{args.height} "
+          f"@ {args.fps} fps, {args.latency_ms} ms, {args.boxes} boxes)...")
+    t0 = time.monotonic()
+    ids = create_instances(client, args)
+    create_seconds = time.monotonic() - t0
+    print(f"  {len(ids)} created in {create_seconds:.1f}s")
+
+    print(f"Holding load for {args.duration:.0f}s...")
+    stop = threading.Event()
+    result = {}
+    poller = threading.Thread(
+        target=lambda: result.setdefault("fps", poll(client, ids, args, stop)))
+    poller.start()
+    rss_samples = []
+    deadline = time.monotonic() + args.duration
+    while time.monotonic() < deadline:
+        rss_samples.append(read_rss_kb())
+        time.sleep(min(1.0, max(0.0, deadline - time.monotonic())))
+    stop.set()
+    poller.join()
+    status, system = client.request("system_status", "GET",
+                                    "/v1/core/system/status")
+
+    if not args.keep and ids:
+        print("Deleting instances...")
+        with ThreadPoolExecutor(max_workers=args.concurrency) as pool:
+            list(pool.map(lambda i: client.request(
+                "delete", "DELETE", f"/v1/core/instance/{i}"), ids))
+
+    rss_peak, processes = max(rss_samples) if rss_samples else (0, 0)
+    fps = result.get("fps", [])
+    report = {
+        "config": vars(args),
+        "instances_created": len(ids),
+        "create_seconds": round(create_seconds, 2),
+        "processes": processes,
+        "rss_before_kb": rss_before,
+        "rss_peak_kb": rss_peak,
+        "rss_per_instance_kb": (round((rss_peak - rss_before) / len(ids))
+                                if ids else 0),
+        "fps_mean": round(statistics.fmean(fps), 2) if fps else 0.0,
+        "fps_min": round(min(fps), 2) if fps else 0.0,
+        "system_status": system if status == 200 else None,
+        "endpoints": recorder.summary(),
+    }
+
+    text = json.dumps(report, indent=2)
+    print(text)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text + "\n")
+    return 0 if len(ids) == args.instances else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
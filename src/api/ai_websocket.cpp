@@ -1,19 +1,30 @@
 #include "api/ai_websocket.h"
+#include "api/instance_subscription_hub.h"
 #include "core/logging_flags.h"
 #include "instances/instance_manager.h"
 #include <chrono>
 #include <iostream>
 #include <json/json.h>
-#include <map>
 #include <mutex>
-#include <thread>
+#include <trantor/net/EventLoop.h>
 
 std::atomic<size_t> AIWebSocketController::active_connections_{0};
 IInstanceManager *AIWebSocketController::instance_manager_ = nullptr;
 
-// Map to store instanceId for each WebSocket connection
-static std::map<void *, std::string> connection_instance_map;
-static std::mutex connection_map_mutex;
+namespace {
+// Starts the fan-out thread on first subscription. Updates are built there
+// (in subprocess mode that is IPC to the workers), never on the main loop.
+void ensureSubscriptionHubStarted() {
+  static std::once_flag started;
+  std::call_once(started, []() {
+    auto &hub = InstanceSubscriptionHub::getInstance();
+    hub.setUpdateBuilder([](const std::string &instanceId) {
+      return AIWebSocketController::buildInstanceUpdate(instanceId);
+    });
+    hub.start();
+  });
+}
+} // namespace
 
 void AIWebSocketController::setInstanceManager(IInstanceManager *manager) {
   instance_manager_ = manager;
@@ -35,9 +46,8 @@ void AIWebSocketController::handleNewConnection(
     }
     instanceId = path.substr(start, end - start);
 
-    // Store instanceId for this connection
-    std::lock_guard<std::mutex> lock(connection_map_mutex);
-    connection_instance_map[wsConnPtr.get()] = instanceId;
+    // Store instanceId on the connection itself
+    wsConnPtr->setContext(std::make_shared<std::string>(instanceId));
   }
 
   std::cout << "[WebSocket] New connection. Total: "
@@ -59,11 +69,7 @@ void AIWebSocketController::handleConnectionClosed(
     const WebSocketConnectionPtr &wsConnPtr) {
   active_connections_--;
 
-  // Remove instanceId mapping
-  {
-    std::lock_guard<std::mutex> lock(connection_map_mutex);
-    connection_instance_map.erase(wsConnPtr.get());
-  }
+  InstanceSubscriptionHub::getInstance().removeConnection(wsConnPtr.get());
 
   std::cout << "[WebSocket] Connection closed. Total: "
             << active_connections_.load() << std::endl;
@@ -75,12 +81,8 @@ void AIWebSocketController::handleNewMessage(
   if (type == WebSocketMessageType::Text) {
     // Check if this is an instance stream connection
     std::string instanceId;
-    {
-      std::lock_guard<std::mutex> lock(connection_map_mutex);
-      auto it = connection_instance_map.find(wsConnPtr.get());
-      if (it != connection_instance_map.end()) {
-        instanceId = it->second;
-      }
+    if (wsConnPtr->hasContext()) {
+      instanceId = *wsConnPtr->getContext<std::string>();
     }
 
     if (!instanceId.empty()) {
@@ -175,14 +177,20 @@ void AIWebSocketController::processInstanceStreamMessage(
       sendResult(wsConnPtr,
                  Json::writeString(Json::StreamWriterBuilder(), response));
 
-      // Start periodic updates (in production, use a proper thread pool)
-      std::thread([this, wsConnPtr, instanceId]() {
-        while (wsConnPtr->connected()) {
-          sendInstanceUpdate(wsConnPtr, instanceId);
-          std::this_thread::sleep_for(
-              std::chrono::milliseconds(1000)); // 1 second
-        }
-      }).detach();
+      // Current state right away, then periodic updates from the hub
+      auto update = buildInstanceUpdate(instanceId);
+      if (update) {
+        sendResult(wsConnPtr, *update);
+      }
+      subscribeToInstance(wsConnPtr, instanceId);
+    } else if (msg_type == "unsubscribe") {
+      InstanceSubscriptionHub::getInstance().unsubscribe(wsConnPtr.get(),
+                                                         instanceId);
+      Json::Value response;
+      response["type"] = "unsubscribed";
+      response["instanceId"] = instanceId;
+      sendResult(wsConnPtr,
+                 Json::writeString(Json::StreamWriterBuilder(), response));
     } else if (msg_type == "ping") {
       Json::Value pong;
       pong["type"] = "pong";
@@ -199,10 +207,49 @@ void AIWebSocketController::processInstanceStreamMessage(
   }
 }
 
-void AIWebSocketController::sendInstanceUpdate(
+void AIWebSocketController::subscribeToInstance(
     const WebSocketConnectionPtr &wsConnPtr, const std::string &instanceId) {
+  ensureSubscriptionHubStarted();
+
+  // Sends are performed on the connection's own I/O loop; the hub only
+  // hands over a shared, already serialized buffer
+  trantor::EventLoop *loop = trantor::EventLoop::getEventLoopOfCurrentThread();
+  std::weak_ptr<WebSocketConnection> weak = wsConnPtr;
+
+  InstanceSubscriptionHub::Subscriber subscriber;
+  subscriber.send = [weak, loop](InstanceSubscriptionHub::Payload payload,
+                                 std::function<void()> done) {
+    auto sendNow = [weak, payload, done]() {
+      auto conn = weak.lock();
+      if (conn && conn->connected()) {
+        conn->send(*payload);
+      }
+      done();
+    };
+    if (loop) {
+      loop->queueInLoop(std::move(sendNow));
+    } else {
+      sendNow();
+    }
+  };
+  subscriber.connected = [weak]() {
+    auto conn = weak.lock();
+    return conn && conn->connected();
+  };
+  subscriber.close = [weak]() {
+    if (auto conn = weak.lock()) {
+      conn->forceClose();
+    }
+  };
+
+  InstanceSubscriptionHub::getInstance().subscribe(wsConnPtr.get(), instanceId,
+                                                   std::move(subscriber));
+}
+
+std::optional<std::string>
+AIWebSocketController::buildInstanceUpdate(const std::string &instanceId) {
   if (!instance_manager_) {
-    return;
+    return std::nullopt;
   }
 
   try {
@@ -213,9 +260,7 @@ void AIWebSocketController::sendInstanceUpdate(
       error["type"] = "error";
       error["message"] = "Instance not found";
       error["instanceId"] = instanceId;
-      sendResult(wsConnPtr,
-                 Json::writeString(Json::StreamWriterBuilder(), error));
-      return;
+      return Json::writeString(Json::StreamWriterBuilder(), error);
     }
 
     const auto &info = optInfo.value();
@@ -252,10 +297,10 @@ void AIWebSocketController::sendInstanceUpdate(
       update["statistics"] = statsJson;
     }
 
-    sendResult(wsConnPtr,
-               Json::writeString(Json::StreamWriterBuilder(), update));
-  } catch (const std::exception &e) {
+    return Json::writeString(Json::StreamWriterBuilder(), update);
+  } catch (const std::exception &) {
     // Silently ignore errors to avoid spamming
+    return std::nullopt;
   }
 }
 
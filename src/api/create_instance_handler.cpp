@@ -396,6 +396,11 @@ bool CreateInstanceHandler::parseRequest(const Json::Value &json,
     req.performanceMode = json["performanceMode"].asString();
   }
 
+  // Worker resource limits (subprocess mode)
+  if (json.isMember("resourceLimits") && json["resourceLimits"].isObject()) {
+    req.resourceLimits = ResourceLimits::fromJson(json["resourceLimits"]);
+  }
+
   // SolutionManager settings
   if (json.isMember("recommendedFrameRate") &&
       json["recommendedFrameRate"].isNumeric()) {
@@ -2,18 +2,146 @@
 #include "core/logger.h"
 #include "core/logging_flags.h"
 #include "core/metrics_interceptor.h"
+#include "core/operation_executor.h"
 #include "groups/group_registry.h"
 #include "groups/group_storage.h"
 #include "instances/instance_manager.h"
 #include "models/group_info.h"
 #include <chrono>
+#include <deque>
 #include <drogon/HttpResponse.h>
+#include <mutex>
 #include <regex>
+#include <thread>
 
 GroupRegistry *GroupHandler::group_registry_ = nullptr;
 GroupStorage *GroupHandler::group_storage_ = nullptr;
 IInstanceManager *GroupHandler::instance_manager_ = nullptr;
 
+namespace {
+
+constexpr int kDefaultGroupItemTimeoutMs = 60000;
+constexpr int kMaxGroupItemTimeoutMs = 3600000;
+
+std::string formatSseEvent(const std::string &event, const Json::Value &data) {
+  Json::StreamWriterBuilder builder;
+  builder["indentation"] = "";
+  return "event: " + event + "\ndata: " + Json::writeString(builder, data) +
+         "\n\n";
+}
+
+/**
+ * @brief SSE sink for one group action
+ *
+ * The executor may report finished instances before drogon hands over the
+ * response stream, and before the "accepted" event is written. Chunks are
+ * buffered until both happened, then written in order.
+ */
+class GroupActionStream {
+public:
+  void attach(ResponseStreamPtr stream) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stream_ = std::move(stream);
+    flushLocked();
+  }
+
+  // First event; nothing is written before it
+  void open(std::string chunk) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    backlog_.push_front(std::move(chunk));
+    open_ = true;
+    flushLocked();
+  }
+
+  void send(std::string chunk, bool last = false) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    backlog_.push_back(std::move(chunk));
+    finished_ = finished_ || last;
+    flushLocked();
+  }
+
+  size_t nextCompleted() { return ++completed_; } // Observer thread only
+
+private:
+  void flushLocked() {
+    if (!stream_ || !open_) {
+      return;
+    }
+    while (!backlog_.empty()) {
+      // A failed send means the client went away; keep draining silently
+      if (!disconnected_ && !stream_->send(backlog_.front())) {
+        disconnected_ = true;
+      }
+      backlog_.pop_front();
+    }
+    if (finished_) {
+      stream_->close();
+      stream_.reset();
+    }
+  }
+
+  std::mutex mutex_;
+  ResponseStreamPtr stream_;
+  std::deque<std::string> backlog_;
+  bool open_ = false;
+  bool finished_ = false;
+  bool disconnected_ = false;
+  size_t completed_ = 0;
+};
+
+/**
+ * @brief Response body for a finished group action (also the SSE "done"
+ * event)
+ */
+Json::Value groupActionResult(const std::string &groupId,
+                              const std::string &action,
+                              const Json::Value &batch) {
+  Json::Value response;
+  Json::Value results(Json::arrayValue);
+  int successCount = 0;
+  int failureCount = 0;
+  for (const auto &child : batch["children"]) {
+    Json::Value result;
+    result["instanceId"] = child["instanceId"];
+    bool success = child["state"].asString() == "succeeded";
+    result["success"] = success;
+    result["state"] = child["state"];
+    if (child.isMember("step")) {
+      result["step"] = child["step"];
+    }
+    if (child.isMember("error")) {
+      result["error"] = child["error"];
+    }
+    if (child.isMember("durationMs")) {
+      result["durationMs"] = child["durationMs"];
+    }
+    if (success) {
+      successCount++;
+    } else {
+      failureCount++;
+    }
+    results.append(result);
+  }
+
+  response["groupId"] = groupId;
+  response["action"] = action;
+  response["operationId"] = batch["operationId"];
+  response["state"] = batch["state"];
+  response["total"] = static_cast<int>(batch["children"].size());
+  response["success"] = successCount;
+  response["failed"] = failureCount;
+  if (batch.isMember("durationMs")) {
+    response["durationMs"] = batch["durationMs"];
+  }
+  response["results"] = results;
+  response["message"] = "Group " + action + " completed: " +
+                        std::to_string(successCount) + " succeeded, " +
+                        std::to_string(failureCount) + " failed";
+  return response;
+}
+
+} // namespace
+
 void GroupHandler::setGroupRegistry(GroupRegistry *registry) {
   group_registry_ = registry;
 }
@@ -732,6 +860,248 @@ void GroupHandler::getGroupInstances(
   }
 }
 
+void GroupHandler::startGroup(
+    const HttpRequestPtr &req,
+    std::function<void(const HttpResponsePtr &)> &&callback) {
+  runGroupAction(req, std::move(callback), "start");
+}
+
+void GroupHandler::stopGroup(
+    const HttpRequestPtr &req,
+    std::function<void(const HttpResponsePtr &)> &&callback) {
+  runGroupAction(req, std::move(callback), "stop");
+}
+
+void GroupHandler::restartGroup(
+    const HttpRequestPtr &req,
+    std::function<void(const HttpResponsePtr &)> &&callback) {
+  runGroupAction(req, std::move(callback), "restart");
+}
+
+void GroupHandler::runGroupAction(
+    const HttpRequestPtr &req,
+    std::function<void(const HttpResponsePtr &)> &&callback,
+    const std::string &action) {
+
+  auto start_time = std::chrono::steady_clock::now();
+
+  std::string groupId = extractGroupId(req);
+
+  if (isApiLoggingEnabled()) {
+    PLOG_INFO << "[API] POST /v1/core/groups/" << groupId << "/" << action
+              << " - Group " << action;
+  }
+
+  try {
+    if (!group_registry_ || !instance_manager_) {
+      callback(createErrorResponse(500, "Internal server error",
+                                   "Registry not initialized"));
+      return;
+    }
+
+    if (groupId.empty()) {
+      callback(
+          createErrorResponse(400, "Invalid request", "Group ID is required"));
+      return;
+    }
+
+    if (!group_registry_->groupExists(groupId)) {
+      if (isApiLoggingEnabled()) {
+        PLOG_WARNING << "[API] POST /v1/core/groups/" << groupId << "/"
+                     << action << " - Group not found";
+      }
+      callback(
+          createErrorResponse(404, "Not found", "Group not found: " + groupId));
+      return;
+    }
+
+    // Optional body: {"concurrency": N, "timeoutMs": M}
+    OperationExecutor::BatchOptions options;
+    int timeoutMs = kDefaultGroupItemTimeoutMs;
+    auto json = req->getJsonObject();
+    if (json && json->isMember("concurrency")) {
+      const Json::Value &value = (*json)["concurrency"];
+      if (!value.isIntegral() || value.asInt64() < 1) {
+        callback(createErrorResponse(400, "Invalid request",
+                                     "concurrency must be a positive integer"));
+        return;
+      }
+      options.max_parallel = static_cast<size_t>(value.asInt64());
+    }
+    if (json && json->isMember("timeoutMs")) {
+      const Json::Value &value = (*json)["timeoutMs"];
+      if (!value.isIntegral() || value.asInt64() < 0 ||
+          value.asInt64() > kMaxGroupItemTimeoutMs) {
+        callback(createErrorResponse(
+            400, "Invalid request",
+            "timeoutMs must be an integer between 0 (no timeout) and " +
+                std::to_string(kMaxGroupItemTimeoutMs)));
+        return;
+      }
+      timeoutMs = value.asInt();
+    }
+    options.item_timeout = std::chrono::milliseconds(timeoutMs);
+
+    auto instanceIds = group_registry_->getInstanceIds(groupId);
+
+    IInstanceManager *manager = instance_manager_;
+    std::vector<OperationExecutor::BatchItem> items;
+    items.reserve(instanceIds.size());
+    for (const auto &instanceId : instanceIds) {
+      items.push_back(
+          {instanceId, [manager, action, instanceId](
+                           OperationExecutor::Progress &progress,
+                           std::string &error) {
+             auto info = manager->getInstance(instanceId);
+             if (!info.has_value()) {
+               error = "Instance not found";
+               return false;
+             }
+             const bool running = info.value().running;
+             if (action == "start" && running) {
+               progress.report(1.0, "already running");
+               return true;
+             }
+             if (action == "stop" && !running) {
+               progress.report(1.0, "already stopped");
+               return true;
+             }
+
+             if (action != "start" && running) {
+               progress.report(0.1, "stopping");
+               if (!manager->stopInstance(instanceId)) {
+                 error = "Could not stop instance";
+                 return false;
+               }
+               if (action == "stop") {
+                 return true;
+               }
+               // Wait a moment for cleanup
+               std::this_thread::sleep_for(std::chrono::milliseconds(500));
+             }
+
+             progress.report(0.5, "starting");
+             if (!manager->startInstance(instanceId, true)) {
+               error = "Could not start instance. Check if instance has a "
+                       "pipeline.";
+               return false;
+             }
+             return true;
+           }});
+    }
+
+    const std::string type = "group_" + action;
+    const bool stream =
+        req->getParameter("stream") == "true" ||
+        req->getHeader("Accept").find("text/event-stream") != std::string::npos;
+    const bool async = req->getParameter("async") == "true";
+    auto &executor = OperationExecutor::getInstance();
+
+    std::shared_ptr<GroupActionStream> sink;
+    if (!stream && !async) {
+      // Synchronous: answer when the batch is done instead of blocking the
+      // IO thread until then
+      const size_t total = items.size();
+      options.observer = [this, callback, total, groupId, action,
+                          start_time](const std::string &event,
+                                      const Json::Value &data) {
+        if (event != "done") {
+          return;
+        }
+        Json::Value response = groupActionResult(groupId, action, data);
+        auto end_time = std::chrono::steady_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+            end_time - start_time);
+        if (isApiLoggingEnabled()) {
+          PLOG_INFO << "[API] POST /v1/core/groups/" << groupId << "/"
+                    << action << " - " << response["success"].asInt() << "/"
+                    << total << " succeeded - " << duration.count() << "ms";
+        }
+        callback(createSuccessResponse(response));
+      };
+    } else if (stream) {
+      sink = std::make_shared<GroupActionStream>();
+      const size_t total = items.size();
+      options.observer = [sink, total, groupId,
+                          action](const std::string &event,
+                                  const Json::Value &data) {
+        if (event == "done") {
+          sink->send(formatSseEvent(
+                         "done", groupActionResult(groupId, action, data)),
+                     true);
+          return;
+        }
+        Json::Value payload = data;
+        payload["completed"] = static_cast<Json::UInt64>(sink->nextCompleted());
+        payload["total"] = static_cast<Json::UInt64>(total);
+        sink->send(formatSseEvent("instance", payload));
+      };
+    }
+
+    const size_t total = items.size();
+    std::string operationId =
+        executor.submitBatch(type, std::move(items), std::move(options));
+    if (operationId.empty()) {
+      callback(createErrorResponse(
+          503, "Service Unavailable",
+          "Too many pending instance operations. Please try again later."));
+      return;
+    }
+
+    if (isApiLoggingEnabled()) {
+      PLOG_INFO << "[API] POST /v1/core/groups/" << groupId << "/" << action
+                << " - Queued " << total << " instances as operation "
+                << operationId;
+    }
+
+    Json::Value accepted;
+    accepted["groupId"] = groupId;
+    accepted["action"] = action;
+    accepted["operationId"] = operationId;
+    accepted["total"] = static_cast<int>(total);
+    accepted["timeoutMs"] = timeoutMs;
+
+    if (stream) {
+      auto resp = HttpResponse::newAsyncStreamResponse(
+          [sink](ResponseStreamPtr responseStream) {
+            sink->attach(std::move(responseStream));
+          },
+          true);
+      resp->setContentTypeString("text/event-stream");
+      resp->addHeader("Cache-Control", "no-cache");
+      resp->addHeader("X-Accel-Buffering", "no");
+      resp->addHeader("Access-Control-Allow-Origin", "*");
+      sink->open(formatSseEvent("accepted", accepted));
+      callback(resp);
+      return;
+    }
+
+    if (async) {
+      accepted["status"] = "queued";
+      accepted["message"] = "Group " + action +
+                            " accepted. Check progress using GET "
+                            "/v1/core/operations/" +
+                            operationId;
+      callback(createSuccessResponse(accepted, 202));
+    }
+    // Otherwise the observer responds when the batch is done
+
+  } catch (const std::exception &e) {
+    if (isApiLoggingEnabled()) {
+      PLOG_ERROR << "[API] POST /v1/core/groups/" << groupId << "/" << action
+                 << " - Exception: " << e.what();
+    }
+    callback(createErrorResponse(500, "Internal server error", e.what()));
+  } catch (...) {
+    if (isApiLoggingEnabled()) {
+      PLOG_ERROR << "[API] POST /v1/core/groups/" << groupId << "/" << action
+                 << " - Unknown exception";
+    }
+    callback(createErrorResponse(500, "Internal server error",
+                                 "Unknown error occurred"));
+  }
+}
+
 void GroupHandler::handleOptions(
     const HttpRequestPtr &req,
     std::function<void(const HttpResponsePtr &)> &&callback) {
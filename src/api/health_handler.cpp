@@ -1,5 +1,7 @@
 #include "api/health_handler.h"
 #include "core/metrics_interceptor.h"
+#include "core/request_middleware.h"
+#include "core/startup_profiler.h"
 #include <chrono>
 #include <ctime>
 #include <drogon/HttpResponse.h>
@@ -47,6 +49,8 @@ void HealthHandler::getHealth(
     response["service"] = "edge_ai_api";
     response["version"] = "2026.0.1.1";
     response["checks"] = checks;
+    response["admission"] =
+        RequestAdmissionControl::getInstance().getStatsJson();
 
     auto resp = HttpResponse::newHttpJsonResponse(response);
 
@@ -80,6 +84,24 @@ void HealthHandler::getHealth(
   }
 }
 
+void HealthHandler::getStartup(
+    const HttpRequestPtr &req,
+    std::function<void(const HttpResponsePtr &)> &&callback) {
+  // Set handler start time for accurate metrics
+  MetricsInterceptor::setHandlerStartTime(req);
+
+  auto resp = HttpResponse::newHttpJsonResponse(
+      StartupProfiler::getInstance().getTimelineJson());
+  resp->setStatusCode(k200OK);
+
+  // Add CORS headers
+  resp->addHeader("Access-Control-Allow-Origin", "*");
+  resp->addHeader("Access-Control-Allow-Methods", "GET, OPTIONS");
+  resp->addHeader("Access-Control-Allow-Headers", "Content-Type");
+
+  MetricsInterceptor::callWithMetrics(req, resp, std::move(callback));
+}
+
 std::string HealthHandler::getCurrentTimestamp() const {
   auto now = std::chrono::system_clock::now();
   auto time_t = std::chrono::system_clock::to_time_t(now);
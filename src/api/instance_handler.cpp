@@ -3,11 +3,14 @@
 #include "core/logger.h"
 #include "core/logging_flags.h"
 #include "core/metrics_interceptor.h"
+#include "core/operation_executor.h"
+#include "core/preview_stream_hub.h"
 #include "core/timeout_constants.h"
 #include "instances/instance_info.h"
 #include "instances/instance_manager.h"
 #include "models/update_instance_request.h"
 #include <algorithm>
+#include <cctype>
 #include <atomic>
 #include <chrono>
 #include <ctime>
@@ -21,6 +24,8 @@
 #include <optional>
 #include <sstream>
 #include <thread>
+#include <trantor/net/EventLoop.h>
+#include <trantor/net/TcpConnection.h>
 #include <typeinfo>
 #include <unordered_map>
 #include <vector>
@@ -78,6 +83,34 @@ HttpResponsePtr InstanceHandler::createSuccessResponse(const Json::Value &data,
   return resp;
 }
 
+bool InstanceHandler::wantsJpeg(const HttpRequestPtr &req) {
+  std::string accept = req->getHeader("Accept");
+  std::transform(accept.begin(), accept.end(), accept.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return accept.find("image/jpeg") != std::string::npos;
+}
+
+HttpResponsePtr InstanceHandler::createJpegResponse(std::string jpeg,
+                                                    bool running) const {
+  auto resp = HttpResponse::newHttpResponse();
+  if (jpeg.empty()) {
+    resp->setStatusCode(k204NoContent);
+  } else {
+    resp->setStatusCode(k200OK);
+    resp->setContentTypeString("image/jpeg");
+    resp->setBody(std::move(jpeg));
+  }
+  resp->addHeader("X-Instance-Running", running ? "true" : "false");
+  resp->addHeader("Cache-Control", "no-cache, no-store");
+  resp->addHeader("Access-Control-Allow-Origin", "*");
+  resp->addHeader("Access-Control-Allow-Methods",
+                  "GET, POST, PUT, DELETE, OPTIONS");
+  resp->addHeader("Access-Control-Allow-Headers",
+                  "Content-Type, Authorization");
+  resp->addHeader("Access-Control-Expose-Headers", "X-Instance-Running");
+  return resp;
+}
+
 void InstanceHandler::getStatusSummary(
     const HttpRequestPtr &req,
     std::function<void(const HttpResponsePtr &)> &&callback) {
@@ -829,40 +862,44 @@ void InstanceHandler::stopInstance(
       return;
     }
 
-    // OPTIMIZED: Run stopInstance() in detached thread to avoid blocking API
-    // thread and other instances This allows multiple instances to stop
-    // concurrently without blocking each other The instance will stop in
-    // background, and status can be checked via GET /v1/core/instance/{id}
-    std::thread stopThread([this, instanceId]() {
-      try {
-        instance_manager_->stopInstance(instanceId);
-      } catch (const std::exception &e) {
-        std::cerr << "[InstanceHandler] Exception stopping instance "
-                  << instanceId << ": " << e.what() << std::endl;
-      } catch (...) {
-        std::cerr << "[InstanceHandler] Unknown exception stopping instance "
-                  << instanceId << std::endl;
-      }
-    });
-    stopThread.detach(); // Detach thread - instance stops in background
-
-    // Return immediately - instance is stopping in background
-    // Client can check status using GET /v1/core/instance/{id}
     auto optInfo = instance_manager_->getInstance(instanceId);
     if (optInfo.has_value()) {
+      // Stop on the bounded operation executor (serialized per instance) so
+      // the API thread never waits on pipeline teardown. Progress is
+      // available via GET /v1/core/operations/{operationId}
+      std::string operationId = OperationExecutor::getInstance().submit(
+          "stop", instanceId,
+          [this, instanceId](OperationExecutor::Progress &progress,
+                             std::string &error) {
+            progress.report(0.1, "stopping pipeline");
+            if (!instance_manager_->stopInstance(instanceId)) {
+              error = "Could not stop instance";
+              return false;
+            }
+            return true;
+          });
+      if (operationId.empty()) {
+        callback(createErrorResponse(
+            503, "Service Unavailable",
+            "Too many pending instance operations. Please try again later."));
+        return;
+      }
+
       auto end_time = std::chrono::steady_clock::now();
       auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
           end_time - start_time);
       if (isApiLoggingEnabled()) {
         PLOG_INFO << "[API] POST /v1/core/instance/" << instanceId
-                  << "/stop - Accepted (async) - " << duration.count() << "ms";
+                  << "/stop - Accepted (operation " << operationId << ") - "
+                  << duration.count() << "ms";
       }
       Json::Value response = instanceInfoToJson(optInfo.value());
       response["message"] =
           "Instance stop request accepted. Instance is stopping in background. "
-          "Check status using GET /v1/core/instance/" +
-          instanceId;
+          "Check progress using GET /v1/core/operations/" +
+          operationId;
       response["status"] = "stopping"; // Indicate that instance is stopping
+      response["operationId"] = operationId;
       callback(createSuccessResponse(
           response, 202)); // 202 Accepted - request accepted but not completed
     } else {
@@ -916,43 +953,48 @@ void InstanceHandler::restartInstance(
       return;
     }
 
-    // OPTIMIZED: Run restartInstance() in detached thread to avoid blocking API
-    // thread and other instances This allows multiple instances to restart
-    // concurrently without blocking each other The instance will restart in
-    // background, and status can be checked via GET /v1/core/instance/{id}
-    std::thread restartThread([this, instanceId]() {
-      try {
-        // First, stop the instance if it's running
-        auto optInfo = instance_manager_->getInstance(instanceId);
-        if (optInfo.has_value() && optInfo.value().running) {
-          instance_manager_->stopInstance(instanceId);
-          // Give it a moment to fully stop and cleanup
-          std::this_thread::sleep_for(std::chrono::milliseconds(500));
-        }
+    auto optInfo = instance_manager_->getInstance(instanceId);
+    if (optInfo.has_value()) {
+      std::string operationId = OperationExecutor::getInstance().submit(
+          "restart", instanceId,
+          [this, instanceId](OperationExecutor::Progress &progress,
+                             std::string &error) {
+            // First, stop the instance if it's running
+            auto current = instance_manager_->getInstance(instanceId);
+            if (!current.has_value()) {
+              error = "Instance not found";
+              return false;
+            }
+            if (current.value().running) {
+              progress.report(0.1, "stopping pipeline");
+              instance_manager_->stopInstance(instanceId);
+              // Give it a moment to fully stop and cleanup
+              std::this_thread::sleep_for(std::chrono::milliseconds(500));
+            }
 
-        // Now start the instance (skip auto-stop since we already stopped it)
-        instance_manager_->startInstance(instanceId,
-                                         true); // true = skipAutoStop
-      } catch (const std::exception &e) {
-        std::cerr << "[InstanceHandler] Exception restarting instance "
-                  << instanceId << ": " << e.what() << std::endl;
-      } catch (...) {
-        std::cerr << "[InstanceHandler] Unknown exception restarting instance "
-                  << instanceId << std::endl;
+            // Now start the instance (skip auto-stop since we already stopped
+            // it)
+            progress.report(0.5, "starting pipeline");
+            if (!instance_manager_->startInstance(instanceId, true)) {
+              error = "Could not start instance";
+              return false;
+            }
+            return true;
+          });
+      if (operationId.empty()) {
+        callback(createErrorResponse(
+            503, "Service Unavailable",
+            "Too many pending instance operations. Please try again later."));
+        return;
       }
-    });
-    restartThread.detach(); // Detach thread - instance restarts in background
 
-    // Return immediately - instance is restarting in background
-    // Client can check status using GET /v1/core/instance/{id}
-    auto optInfo = instance_manager_->getInstance(instanceId);
-    if (optInfo.has_value()) {
       Json::Value response = instanceInfoToJson(optInfo.value());
       response["message"] = "Instance restart request accepted. Instance is "
                             "restarting in background. "
-                            "Check status using GET /v1/core/instance/" +
-                            instanceId;
+                            "Check progress using GET /v1/core/operations/" +
+                            operationId;
       response["status"] = "restarting"; // Indicate that instance is restarting
+      response["operationId"] = operationId;
       callback(createSuccessResponse(
           response, 202)); // 202 Accepted - request accepted but not completed
     } else {
@@ -1167,12 +1209,9 @@ void InstanceHandler::deleteInstance(
       return;
     }
 
-    // OPTIMIZED: Run deleteInstance() in detached thread to avoid blocking API
-    // thread and other instances deleteInstance() calls stopPipeline() which
-    // can take time (cleanup, DNN state clearing) This allows multiple
-    // instances to be deleted concurrently without blocking each other The
-    // instance will be deleted in background, and status can be checked via GET
-    // /v1/core/instance/{id}
+    // deleteInstance() calls stopPipeline() which can take time (cleanup, DNN
+    // state clearing), so it runs on the operation executor. Operations on
+    // the same instance are serialized, so a delete never overlaps a restart.
 
     // Check if instance exists first (before async deletion)
     auto optInfo = instance_manager_->getInstance(instanceId);
@@ -1182,29 +1221,34 @@ void InstanceHandler::deleteInstance(
       return;
     }
 
-    std::thread deleteThread([this, instanceId]() {
-      try {
-        instance_manager_->deleteInstance(instanceId);
-      } catch (const std::exception &e) {
-        std::cerr << "[InstanceHandler] Exception deleting instance "
-                  << instanceId << ": " << e.what() << std::endl;
-      } catch (...) {
-        std::cerr << "[InstanceHandler] Unknown exception deleting instance "
-                  << instanceId << std::endl;
-      }
-    });
-    deleteThread
-        .detach(); // Detach thread - instance deletion happens in background
+    std::string operationId = OperationExecutor::getInstance().submit(
+        "delete", instanceId,
+        [this, instanceId](OperationExecutor::Progress &progress,
+                           std::string &error) {
+          progress.report(0.1, "deleting instance");
+          if (!instance_manager_->deleteInstance(instanceId)) {
+            error = "Could not delete instance";
+            return false;
+          }
+          return true;
+        });
+    if (operationId.empty()) {
+      callback(createErrorResponse(
+          503, "Service Unavailable",
+          "Too many pending instance operations. Please try again later."));
+      return;
+    }
 
     // Return immediately - instance is being deleted in background
     Json::Value response;
     response["success"] = true;
     response["message"] = "Instance deletion request accepted. Instance is "
                           "being deleted in background. "
-                          "Check status using GET /v1/core/instance/" +
-                          instanceId;
+                          "Check progress using GET /v1/core/operations/" +
+                          operationId;
     response["instanceId"] = instanceId;
     response["status"] = "deleting"; // Indicate that instance is being deleted
+    response["operationId"] = operationId;
     callback(createSuccessResponse(
         response, 202)); // 202 Accepted - request accepted but not completed
     return;
@@ -1341,65 +1385,92 @@ void InstanceHandler::deleteAllInstances(
       instanceIds.push_back(info.instanceId);
     }
 
-    // Execute delete operations concurrently using async
-    std::vector<std::future<std::pair<std::string, bool>>> futures;
-    for (const auto &instanceId : instanceIds) {
-      futures.push_back(std::async(
-          std::launch::async,
-          [this, instanceId]() -> std::pair<std::string, bool> {
-            try {
-              bool success = instance_manager_->deleteInstance(instanceId);
-              return {instanceId, success};
-            } catch (...) {
-              return {instanceId, false};
-            }
-          }));
-    }
+    // Deletes run on the operation executor keyed by instance, so they use
+    // its bounded pool and never overlap a queued restart or auto_tune of
+    // the same instance. Outcome per instance: 0 = not run, 1 = deleted,
+    // -1 = failed; the executor lock orders the reads in the observer.
+    auto outcomes = std::make_shared<std::vector<int>>(instanceIds.size(), 0);
+    std::vector<OperationExecutor::BatchItem> items;
+    items.reserve(instanceIds.size());
+    for (size_t i = 0; i < instanceIds.size(); ++i) {
+      const std::string instanceId = instanceIds[i];
+      items.push_back(
+          {instanceId, [this, instanceId, outcomes, i](
+                           OperationExecutor::Progress &progress,
+                           std::string &error) {
+             progress.report(0.1, "deleting instance");
+             bool success = instance_manager_->deleteInstance(instanceId);
+             (*outcomes)[i] = success ? 1 : -1;
+             if (!success) {
+               error = "Could not delete instance";
+             }
+             return success;
+           }});
+    }
+
+    OperationExecutor::BatchOptions options;
+    options.observer = [this, callback, instanceIds, outcomes,
+                        start_time](const std::string &event,
+                                    const Json::Value &data) {
+      if (event != "done") {
+        return;
+      }
+      Json::Value response;
+      Json::Value results(Json::arrayValue);
+      int successCount = 0;
+      int failureCount = 0;
+
+      for (size_t i = 0; i < instanceIds.size(); ++i) {
+        Json::Value result;
+        result["instanceId"] = instanceIds[i];
+        result["success"] = (*outcomes)[i] == 1;
+
+        if ((*outcomes)[i] == 1) {
+          result["status"] = "deleted";
+          successCount++;
+        } else {
+          result["status"] = "failed";
+          result["error"] =
+              (*outcomes)[i] == 0
+                  ? "Operation cancelled"
+                  : "Could not delete instance. Instance may not exist.";
+          failureCount++;
+        }
 
-    // Collect results
-    Json::Value response;
-    Json::Value results(Json::arrayValue);
-    int successCount = 0;
-    int failureCount = 0;
+        results.append(result);
+      }
 
-    for (auto &future : futures) {
-      auto [instanceId, success] = future.get();
+      response["results"] = results;
+      response["total"] = static_cast<int>(instanceIds.size());
+      response["deleted"] = successCount;
+      response["failed"] = failureCount;
+      response["operationId"] = data["operationId"];
+      response["message"] = "Delete all instances operation completed";
+      response["success"] = (failureCount == 0);
 
-      Json::Value result;
-      result["instanceId"] = instanceId;
-      result["success"] = success;
+      auto end_time = std::chrono::steady_clock::now();
+      auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+          end_time - start_time);
 
-      if (success) {
-        result["status"] = "deleted";
-        successCount++;
-      } else {
-        result["status"] = "failed";
-        result["error"] = "Could not delete instance. Instance may not exist.";
-        failureCount++;
+      if (isApiLoggingEnabled()) {
+        PLOG_INFO << "[API] DELETE /v1/core/instance - Success: "
+                  << successCount << " deleted, " << failureCount
+                  << " failed out of " << instanceIds.size() << " total - "
+                  << duration.count() << "ms";
       }
 
-      results.append(result);
-    }
-
-    response["results"] = results;
-    response["total"] = static_cast<int>(instanceIds.size());
-    response["deleted"] = successCount;
-    response["failed"] = failureCount;
-    response["message"] = "Delete all instances operation completed";
-    response["success"] = (failureCount == 0);
-
-    auto end_time = std::chrono::steady_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-        end_time - start_time);
+      callback(createSuccessResponse(response));
+    };
 
-    if (isApiLoggingEnabled()) {
-      PLOG_INFO << "[API] DELETE /v1/core/instance - Success: " << successCount
-                << " deleted, " << failureCount << " failed out of "
-                << instanceIds.size() << " total - " << duration.count()
-                << "ms";
+    std::string operationId = OperationExecutor::getInstance().submitBatch(
+        "delete_all", std::move(items), std::move(options));
+    if (operationId.empty()) {
+      callback(createErrorResponse(
+          503, "Service Unavailable",
+          "Too many pending instance operations. Please try again later."));
+      return;
     }
-
-    callback(createSuccessResponse(response));
+    // The observer responds when every delete finished
 
   } catch (const std::exception &e) {
     auto end_time = std::chrono::steady_clock::now();
@@ -1876,11 +1947,13 @@ void InstanceHandler::getLastFrame(
     // CRITICAL: getLastFrame() can block for up to 5 seconds (IPC timeout)
     // We need async + timeout to prevent API from hanging in production
     // when there are concurrent requests
-    std::string frameBase64;
+    // Accept: image/jpeg returns the JPEG itself instead of base64 in JSON
+    const bool binary = wantsJpeg(req);
+    std::string frame;
     try {
       auto future = std::async(
           std::launch::async,
-          [this, instanceId]() -> std::string {
+          [this, instanceId, binary]() -> std::string {
             try {
               if (!instance_manager_) {
                 std::cerr << "[InstanceHandler] [ASYNC THREAD] ERROR: "
@@ -1888,7 +1961,8 @@ void InstanceHandler::getLastFrame(
                           << std::endl;
                 return "";
               }
-              return instance_manager_->getLastFrame(instanceId);
+              return binary ? instance_manager_->getLastFrameJpeg(instanceId)
+                            : instance_manager_->getLastFrame(instanceId);
             } catch (const std::exception &e) {
               std::cerr << "[InstanceHandler] [ASYNC THREAD] EXCEPTION in "
                            "getLastFrame: "
@@ -1919,7 +1993,7 @@ void InstanceHandler::getLastFrame(
         return;
       } else if (status == std::future_status::ready) {
         try {
-          frameBase64 = future.get();
+          frame = future.get();
         } catch (const std::exception &e) {
           std::cerr << "[InstanceHandler] Exception getting future result: "
                     << e.what() << std::endl;
@@ -1942,22 +2016,21 @@ void InstanceHandler::getLastFrame(
 
     // DEBUG: Log frame retrieval result
     if (isApiLoggingEnabled()) {
-      if (frameBase64.empty()) {
+      if (frame.empty()) {
         PLOG_DEBUG << "[API] GET /v1/core/instance/" << instanceId
                    << "/frame - No frame cached (empty result)";
+      } else if (binary) {
+        PLOG_DEBUG << "[API] GET /v1/core/instance/" << instanceId
+                   << "/frame - Frame retrieved: size=" << frame.length()
+                   << " bytes (JPEG)";
       } else {
         PLOG_DEBUG << "[API] GET /v1/core/instance/" << instanceId
-                   << "/frame - Frame retrieved: size=" << frameBase64.length()
+                   << "/frame - Frame retrieved: size=" << frame.length()
                    << " chars (base64), estimated image size="
-                   << (frameBase64.length() * 3 / 4) << " bytes";
+                   << (frame.length() * 3 / 4) << " bytes";
       }
     }
 
-    // Build JSON response
-    Json::Value response;
-    response["frame"] = frameBase64;
-    response["running"] = info.running;
-
     auto end_time = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
         end_time - start_time);
@@ -1965,9 +2038,19 @@ void InstanceHandler::getLastFrame(
     if (isApiLoggingEnabled()) {
       PLOG_INFO << "[API] GET /v1/core/instance/" << instanceId
                 << "/frame - Success - " << duration.count()
-                << "ms (frame size: " << frameBase64.length() << " chars)";
+                << "ms (frame size: " << frame.length()
+                << (binary ? " bytes)" : " chars)");
+    }
+
+    if (binary) {
+      callback(createJpegResponse(std::move(frame), info.running));
+      return;
     }
 
+    // Build JSON response
+    Json::Value response;
+    response["frame"] = frame;
+    response["running"] = info.running;
     callback(createSuccessResponse(response));
 
   } catch (const std::exception &e) {
@@ -3083,6 +3166,16 @@ void InstanceHandler::getInstancePreview(
 
     const InstanceInfo &info = optInfo.value();
 
+    if (wantsJpeg(req)) {
+      std::string jpeg = instance_manager_->getLastFrameJpeg(instanceId);
+      if (isApiLoggingEnabled()) {
+        PLOG_INFO << "[API] GET /v1/core/instance/" << instanceId
+                  << "/preview - Success (JPEG, " << jpeg.size() << " bytes)";
+      }
+      callback(createJpegResponse(std::move(jpeg), info.running));
+      return;
+    }
+
     // Get last frame (empty string if no frame cached)
     std::string frameBase64 = instance_manager_->getLastFrame(instanceId);
 
@@ -3140,6 +3233,202 @@ void InstanceHandler::getInstancePreview(
   }
 }
 
+void InstanceHandler::getPreviewStream(
+    const HttpRequestPtr &req,
+    std::function<void(const HttpResponsePtr &)> &&callback) {
+
+  std::string instanceId = extractInstanceId(req);
+
+  if (isApiLoggingEnabled()) {
+    PLOG_INFO << "[API] GET /v1/core/instance/" << instanceId
+              << "/preview/stream - Open MJPEG preview";
+  }
+
+  try {
+    if (!instance_manager_) {
+      callback(createErrorResponse(500, "Internal server error",
+                                   "Instance manager not initialized"));
+      return;
+    }
+
+    if (instanceId.empty()) {
+      callback(
+          createErrorResponse(400, "Bad request", "Instance ID is required"));
+      return;
+    }
+
+    PreviewStreamHub::Variant requested;
+    try {
+      std::string fpsParam = req->getParameter("fps");
+      std::string widthParam = req->getParameter("width");
+      if (!fpsParam.empty()) {
+        requested.max_fps = std::stoi(fpsParam);
+      }
+      if (!widthParam.empty()) {
+        requested.width = std::stoi(widthParam);
+      }
+    } catch (...) {
+      callback(createErrorResponse(400, "Bad request",
+                                   "fps and width must be integers"));
+      return;
+    }
+
+    if (!instance_manager_->hasInstance(instanceId)) {
+      callback(createErrorResponse(404, "Not found",
+                                   "Instance not found: " + instanceId));
+      return;
+    }
+
+    auto &hub = PreviewStreamHub::getInstance();
+    if (hub.getStats().viewers >= hub.getConfig().max_viewers) {
+      callback(createErrorResponse(503, "Service unavailable",
+                                   "Too many preview viewers"));
+      return;
+    }
+    PreviewStreamHub::Variant variant = hub.normalize(requested);
+
+    // The viewer lives as long as the client's connection: the hub checks it
+    // every tick, so a disconnect is noticed even when no frame is sent
+    // (static scene, stopped instance). Parts are sent on the stream's loop
+    // and count as in flight until then, so a slow client skips frames
+    // instead of piling them up.
+    std::weak_ptr<trantor::TcpConnection> connection = req->getConnectionPtr();
+    auto resp = HttpResponse::newAsyncStreamResponse(
+        [instanceId, variant, connection](ResponseStreamPtr stream) {
+          auto holder = std::make_shared<ResponseStreamPtr>(std::move(stream));
+          auto closed = std::make_shared<std::atomic<bool>>(false);
+          trantor::EventLoop *loop =
+              trantor::EventLoop::getEventLoopOfCurrentThread();
+          auto viewerId = PreviewStreamHub::getInstance().addViewer(
+              instanceId, variant, PreviewStreamHub::Framing::MultipartPart,
+              [holder, closed, loop](const PreviewStreamHub::Payload &payload,
+                                     PreviewStreamHub::Sent sent) {
+                if (closed->load()) {
+                  return false;
+                }
+                auto send = [holder, closed, payload,
+                             sent = std::move(sent)]() {
+                  if (!(*holder)->send(*payload)) {
+                    closed->store(true);
+                  }
+                  sent();
+                };
+                if (loop) {
+                  loop->queueInLoop(std::move(send));
+                } else {
+                  send();
+                }
+                return !closed->load();
+              },
+              [connection, closed]() {
+                auto conn = connection.lock();
+                return conn && conn->connected() && !closed->load();
+              });
+          if (viewerId == 0) {
+            (*holder)->close();
+          }
+        },
+        true);
+    resp->setContentTypeString(
+        std::string("multipart/x-mixed-replace; boundary=") +
+        PreviewStreamHub::MULTIPART_BOUNDARY);
+    resp->addHeader("Cache-Control", "no-cache, no-store");
+    resp->addHeader("Access-Control-Allow-Origin", "*");
+    callback(resp);
+
+  } catch (const std::exception &e) {
+    if (isApiLoggingEnabled()) {
+      PLOG_ERROR << "[API] GET /v1/core/instance/" << instanceId
+                 << "/preview/stream - Exception: " << e.what();
+    }
+    callback(createErrorResponse(500, "Internal server error", e.what()));
+  }
+}
+
+void InstanceHandler::getQueueTelemetry(
+    const HttpRequestPtr &req,
+    std::function<void(const HttpResponsePtr &)> &&callback) {
+
+  auto start_time = std::chrono::steady_clock::now();
+
+  std::string instanceId = extractInstanceId(req);
+
+  if (isApiLoggingEnabled()) {
+    PLOG_INFO << "[API] GET /v1/core/instance/" << instanceId
+              << "/queue - Get queue telemetry";
+  }
+
+  try {
+    if (!instance_manager_) {
+      callback(createErrorResponse(500, "Internal server error",
+                                   "Instance manager not initialized"));
+      return;
+    }
+
+    if (instanceId.empty()) {
+      callback(
+          createErrorResponse(400, "Bad request", "Instance ID is required"));
+      return;
+    }
+
+    size_t maxSamples = 100;
+    std::string samplesParam = req->getParameter("samples");
+    if (!samplesParam.empty()) {
+      try {
+        long value = std::stol(samplesParam);
+        if (value < 0) {
+          throw std::invalid_argument("negative");
+        }
+        maxSamples = std::min<size_t>(static_cast<size_t>(value), 512);
+      } catch (...) {
+        callback(createErrorResponse(400, "Bad request",
+                                     "samples must be a non-negative integer"));
+        return;
+      }
+    }
+
+    if (!instance_manager_->hasInstance(instanceId)) {
+      callback(createErrorResponse(404, "Not found",
+                                   "Instance not found: " + instanceId));
+      return;
+    }
+
+    Json::Value response =
+        instance_manager_->getQueueTelemetry(instanceId, maxSamples);
+    if (response.isNull()) {
+      // Instance exists but pipeline hooks have not recorded anything yet
+      response["instanceId"] = instanceId;
+      response["nodes"] = Json::Value(Json::arrayValue);
+      response["available"] = false;
+    } else {
+      response["available"] = true;
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start_time);
+    if (isApiLoggingEnabled()) {
+      PLOG_INFO << "[API] GET /v1/core/instance/" << instanceId
+                << "/queue - Success - " << duration.count() << "ms";
+    }
+
+    callback(createSuccessResponse(response));
+
+  } catch (const std::exception &e) {
+    if (isApiLoggingEnabled()) {
+      PLOG_ERROR << "[API] GET /v1/core/instance/" << instanceId
+                 << "/queue - Exception: " << e.what();
+    }
+    callback(createErrorResponse(500, "Internal server error", e.what()));
+  } catch (...) {
+    if (isApiLoggingEnabled()) {
+      PLOG_ERROR << "[API] GET /v1/core/instance/" << instanceId
+                 << "/queue - Unknown exception";
+    }
+    callback(createErrorResponse(500, "Internal server error",
+                                 "Unknown error occurred"));
+  }
+}
+
 std::vector<std::string>
 InstanceHandler::readClassesFromFile(const std::string &labelsPath) const {
   std::vector<std::string> classes;
@@ -3848,6 +4137,107 @@ InstanceHandler::createErrorResponse(int statusCode, const std::string &error,
   return resp;
 }
 
+void InstanceHandler::runBatchOperation(
+    const HttpRequestPtr &req,
+    std::function<void(const HttpResponsePtr &)> &&callback,
+    const std::string &type, const std::vector<std::string> &instanceIds,
+    std::function<bool(const std::string &)> action,
+    const std::string &doneStatus, const std::string &failureMessage) {
+  // Per-instance outcome: 0 = not run (cancelled), 1 = success, -1 = failed.
+  // Each task writes only its own slot; the executor lock orders the reads
+  // in the "done" observer.
+  auto outcomes = std::make_shared<std::vector<int>>(instanceIds.size(), 0);
+  std::vector<OperationExecutor::BatchItem> items;
+  items.reserve(instanceIds.size());
+  for (size_t i = 0; i < instanceIds.size(); ++i) {
+    const std::string instanceId = instanceIds[i];
+    items.push_back(
+        {instanceId, [action, instanceId, outcomes, i, failureMessage](
+                         OperationExecutor::Progress &, std::string &error) {
+           bool success = action(instanceId);
+           (*outcomes)[i] = success ? 1 : -1;
+           if (!success) {
+             error = failureMessage;
+           }
+           return success;
+         }});
+  }
+
+  const bool async = req->getParameter("async") == "true";
+  OperationExecutor::BatchOptions options;
+  if (!async) {
+    // Answer when the batch is done instead of blocking the IO thread
+    options.observer = [this, callback, type, instanceIds, outcomes,
+                        doneStatus, failureMessage](const std::string &event,
+                                                    const Json::Value &data) {
+      if (event != "done") {
+        return;
+      }
+      Json::Value response;
+      Json::Value results(Json::arrayValue);
+      int successCount = 0;
+      int failureCount = 0;
+
+      for (size_t i = 0; i < instanceIds.size(); ++i) {
+        const std::string &instanceId = instanceIds[i];
+        bool success = (*outcomes)[i] == 1;
+
+        Json::Value result;
+        result["instanceId"] = instanceId;
+        result["success"] = success;
+
+        if (success) {
+          auto optInfo = instance_manager_->getInstance(instanceId);
+          if (optInfo.has_value()) {
+            result["status"] = doneStatus;
+            result["running"] = optInfo.value().running;
+          }
+          successCount++;
+        } else {
+          result["status"] = "failed";
+          result["error"] = (*outcomes)[i] == 0 ? "Operation cancelled"
+                                                : failureMessage;
+          failureCount++;
+        }
+
+        results.append(result);
+      }
+
+      response["results"] = results;
+      response["total"] = static_cast<int>(instanceIds.size());
+      response["success"] = successCount;
+      response["failed"] = failureCount;
+      response["operationId"] = data["operationId"];
+      response["message"] = "Batch " + type.substr(type.find('_') + 1) +
+                            " operation completed";
+
+      callback(createSuccessResponse(response));
+    };
+  }
+
+  auto &executor = OperationExecutor::getInstance();
+  std::string operationId =
+      executor.submitBatch(type, std::move(items), std::move(options));
+  if (operationId.empty()) {
+    callback(createErrorResponse(
+        503, "Service Unavailable",
+        "Too many pending instance operations. Please try again later."));
+    return;
+  }
+
+  if (async) {
+    Json::Value response;
+    response["operationId"] = operationId;
+    response["total"] = static_cast<int>(instanceIds.size());
+    response["status"] = "queued";
+    response["message"] = "Batch operation accepted. Check progress using GET "
+                          "/v1/core/operations/" +
+                          operationId;
+    callback(createSuccessResponse(response, 202));
+  }
+  // Otherwise the observer responds when the batch is done
+}
+
 void InstanceHandler::batchStartInstances(
     const HttpRequestPtr &req,
     std::function<void(const HttpResponsePtr &)> &&callback) {
@@ -3890,58 +4280,14 @@ void InstanceHandler::batchStartInstances(
       return;
     }
 
-    // Execute start operations concurrently using async
-    std::vector<std::future<std::pair<std::string, bool>>> futures;
-    for (const auto &instanceId : instanceIds) {
-      futures.push_back(std::async(
-          std::launch::async,
-          [this, instanceId]() -> std::pair<std::string, bool> {
-            try {
-              bool success = instance_manager_->startInstance(instanceId);
-              return {instanceId, success};
-            } catch (...) {
-              return {instanceId, false};
-            }
-          }));
-    }
-
-    // Collect results
-    Json::Value response;
-    Json::Value results(Json::arrayValue);
-    int successCount = 0;
-    int failureCount = 0;
-
-    for (auto &future : futures) {
-      auto [instanceId, success] = future.get();
-
-      Json::Value result;
-      result["instanceId"] = instanceId;
-      result["success"] = success;
-
-      if (success) {
-        auto optInfo = instance_manager_->getInstance(instanceId);
-        if (optInfo.has_value()) {
-          result["status"] = "started";
-          result["running"] = optInfo.value().running;
-        }
-        successCount++;
-      } else {
-        result["status"] = "failed";
-        result["error"] = "Could not start instance. Check if instance exists "
-                          "and has a pipeline.";
-        failureCount++;
-      }
-
-      results.append(result);
-    }
-
-    response["results"] = results;
-    response["total"] = static_cast<int>(instanceIds.size());
-    response["success"] = successCount;
-    response["failed"] = failureCount;
-    response["message"] = "Batch start operation completed";
-
-    callback(createSuccessResponse(response));
+    runBatchOperation(
+        req, std::move(callback), "batch_start", instanceIds,
+        [this](const std::string &instanceId) {
+          return instance_manager_->startInstance(instanceId);
+        },
+        "started",
+        "Could not start instance. Check if instance exists and has a "
+        "pipeline.");
 
   } catch (const std::exception &e) {
     std::cerr << "[InstanceHandler] Exception in batchStartInstances: "
@@ -3997,57 +4343,12 @@ void InstanceHandler::batchStopInstances(
       return;
     }
 
-    // Execute stop operations concurrently using async
-    std::vector<std::future<std::pair<std::string, bool>>> futures;
-    for (const auto &instanceId : instanceIds) {
-      futures.push_back(std::async(
-          std::launch::async,
-          [this, instanceId]() -> std::pair<std::string, bool> {
-            try {
-              bool success = instance_manager_->stopInstance(instanceId);
-              return {instanceId, success};
-            } catch (...) {
-              return {instanceId, false};
-            }
-          }));
-    }
-
-    // Collect results
-    Json::Value response;
-    Json::Value results(Json::arrayValue);
-    int successCount = 0;
-    int failureCount = 0;
-
-    for (auto &future : futures) {
-      auto [instanceId, success] = future.get();
-
-      Json::Value result;
-      result["instanceId"] = instanceId;
-      result["success"] = success;
-
-      if (success) {
-        auto optInfo = instance_manager_->getInstance(instanceId);
-        if (optInfo.has_value()) {
-          result["status"] = "stopped";
-          result["running"] = optInfo.value().running;
-        }
-        successCount++;
-      } else {
-        result["status"] = "failed";
-        result["error"] = "Could not stop instance. Check if instance exists.";
-        failureCount++;
-      }
-
-      results.append(result);
-    }
-
-    response["results"] = results;
-    response["total"] = static_cast<int>(instanceIds.size());
-    response["success"] = successCount;
-    response["failed"] = failureCount;
-    response["message"] = "Batch stop operation completed";
-
-    callback(createSuccessResponse(response));
+    runBatchOperation(
+        req, std::move(callback), "batch_stop", instanceIds,
+        [this](const std::string &instanceId) {
+          return instance_manager_->stopInstance(instanceId);
+        },
+        "stopped", "Could not stop instance. Check if instance exists.");
 
   } catch (const std::exception &e) {
     std::cerr << "[InstanceHandler] Exception in batchStopInstances: "
@@ -4103,70 +4404,25 @@ void InstanceHandler::batchRestartInstances(
       return;
     }
 
-    // Execute restart operations concurrently using async
     // Restart = stop then start
-    std::vector<std::future<std::pair<std::string, bool>>> futures;
-    for (const auto &instanceId : instanceIds) {
-      futures.push_back(std::async(
-          std::launch::async,
-          [this, instanceId]() -> std::pair<std::string, bool> {
-            try {
-              // First stop the instance
-              bool stopSuccess = instance_manager_->stopInstance(instanceId);
-              if (!stopSuccess) {
-                return {instanceId, false};
-              }
-
-              // Wait a moment for cleanup
-              std::this_thread::sleep_for(std::chrono::milliseconds(500));
-
-              // Then start the instance
-              bool startSuccess = instance_manager_->startInstance(
-                  instanceId, true); // skipAutoStop=true
-              return {instanceId, startSuccess};
-            } catch (...) {
-              return {instanceId, false};
-            }
-          }));
-    }
-
-    // Collect results
-    Json::Value response;
-    Json::Value results(Json::arrayValue);
-    int successCount = 0;
-    int failureCount = 0;
-
-    for (auto &future : futures) {
-      auto [instanceId, success] = future.get();
-
-      Json::Value result;
-      result["instanceId"] = instanceId;
-      result["success"] = success;
-
-      if (success) {
-        auto optInfo = instance_manager_->getInstance(instanceId);
-        if (optInfo.has_value()) {
-          result["status"] = "restarted";
-          result["running"] = optInfo.value().running;
-        }
-        successCount++;
-      } else {
-        result["status"] = "failed";
-        result["error"] = "Could not restart instance. Check if instance "
-                          "exists and has a pipeline.";
-        failureCount++;
-      }
-
-      results.append(result);
-    }
+    runBatchOperation(
+        req, std::move(callback), "batch_restart", instanceIds,
+        [this](const std::string &instanceId) {
+          // First stop the instance
+          if (!instance_manager_->stopInstance(instanceId)) {
+            return false;
+          }
 
-    response["results"] = results;
-    response["total"] = static_cast<int>(instanceIds.size());
-    response["success"] = successCount;
-    response["failed"] = failureCount;
-    response["message"] = "Batch restart operation completed";
+          // Wait a moment for cleanup
+          std::this_thread::sleep_for(std::chrono::milliseconds(500));
 
-    callback(createSuccessResponse(response));
+          // Then start the instance
+          return instance_manager_->startInstance(instanceId,
+                                                  true); // skipAutoStop=true
+        },
+        "restarted",
+        "Could not restart instance. Check if instance exists and has a "
+        "pipeline.");
 
   } catch (const std::exception &e) {
     std::cerr << "[InstanceHandler] Exception in batchRestartInstances: "
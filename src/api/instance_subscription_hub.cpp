@@ -0,0 +1,282 @@
+#include "api/instance_subscription_hub.h"
+#include <iostream>
+#include <sstream>
+
+void InstanceSubscriptionHub::configure(const Config &config) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  config_ = config;
+  if (config_.max_pending_per_connection == 0) {
+    config_.max_pending_per_connection = 1;
+  }
+}
+
+InstanceSubscriptionHub::Config InstanceSubscriptionHub::getConfig() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return config_;
+}
+
+void InstanceSubscriptionHub::setUpdateBuilder(UpdateBuilder builder) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  builder_ = std::move(builder);
+}
+
+void InstanceSubscriptionHub::subscribe(ConnectionId connection,
+                                        const std::string &instanceId,
+                                        Subscriber subscriber) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &conn = connections_[connection];
+  if (!conn) {
+    conn = std::make_shared<Connection>();
+    conn->subscriber = std::move(subscriber);
+  }
+  if (!conn->instances.insert(instanceId).second) {
+    return; // Already subscribed
+  }
+  subscribers_[instanceId].push_back(conn);
+  subscription_count_++;
+}
+
+void InstanceSubscriptionHub::unsubscribe(ConnectionId connection,
+                                          const std::string &instanceId) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto connIt = connections_.find(connection);
+  if (connIt == connections_.end() ||
+      connIt->second->instances.erase(instanceId) == 0) {
+    return;
+  }
+
+  auto subIt = subscribers_.find(instanceId);
+  if (subIt != subscribers_.end()) {
+    auto &list = subIt->second;
+    for (auto it = list.begin(); it != list.end(); ++it) {
+      if (*it == connIt->second) {
+        list.erase(it);
+        break;
+      }
+    }
+    if (list.empty()) {
+      subscribers_.erase(subIt);
+    }
+  }
+  subscription_count_--;
+
+  if (connIt->second->instances.empty()) {
+    connections_.erase(connIt);
+  }
+}
+
+void InstanceSubscriptionHub::removeConnection(ConnectionId connection) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  dropConnectionLocked(connection);
+}
+
+void InstanceSubscriptionHub::dropConnectionLocked(ConnectionId connection) {
+  auto connIt = connections_.find(connection);
+  if (connIt == connections_.end()) {
+    return;
+  }
+  auto conn = connIt->second;
+  for (const auto &instanceId : conn->instances) {
+    auto subIt = subscribers_.find(instanceId);
+    if (subIt == subscribers_.end()) {
+      continue;
+    }
+    auto &list = subIt->second;
+    for (auto it = list.begin(); it != list.end(); ++it) {
+      if (*it == conn) {
+        list.erase(it);
+        break;
+      }
+    }
+    if (list.empty()) {
+      subscribers_.erase(subIt);
+    }
+    subscription_count_--;
+  }
+  connections_.erase(connIt);
+}
+
+void InstanceSubscriptionHub::start() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (running_) {
+    return;
+  }
+  running_ = true;
+  thread_ = std::thread(&InstanceSubscriptionHub::tickLoop, this);
+}
+
+void InstanceSubscriptionHub::shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = false;
+  }
+  cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void InstanceSubscriptionHub::tickLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (running_) {
+    cv_.wait_for(lock, config_.interval, [this] { return !running_; });
+    if (!running_) {
+      break;
+    }
+    lock.unlock();
+    tick();
+    lock.lock();
+  }
+}
+
+size_t InstanceSubscriptionHub::tick() {
+  std::lock_guard<std::mutex> tickLock(tick_mutex_);
+  auto start = std::chrono::steady_clock::now();
+
+  // Snapshot subscriptions so building updates and sending happen unlocked
+  UpdateBuilder builder;
+  Config config;
+  std::vector<std::pair<std::string, std::vector<std::shared_ptr<Connection>>>>
+      snapshot;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    builder = builder_;
+    config = config_;
+    snapshot.reserve(subscribers_.size());
+    for (const auto &[instanceId, list] : subscribers_) {
+      snapshot.emplace_back(instanceId, list);
+    }
+  }
+
+  size_t sent = 0;
+  if (builder) {
+    for (auto &[instanceId, list] : snapshot) {
+      std::optional<std::string> message;
+      try {
+        // Built and serialized once per instance, whatever the subscriber
+        // count
+        message = builder(instanceId);
+      } catch (const std::exception &e) {
+        std::cerr << "[InstanceSubscriptionHub] Failed to build update for "
+                  << instanceId << ": " << e.what() << std::endl;
+      }
+      if (!message) {
+        continue;
+      }
+      Payload payload = std::make_shared<const std::string>(std::move(*message));
+
+      for (auto &conn : list) {
+        if (conn->closing || !conn->subscriber.connected()) {
+          continue;
+        }
+        if (conn->pending.load(std::memory_order_acquire) >=
+            config.max_pending_per_connection) {
+          messages_skipped_.fetch_add(1, std::memory_order_relaxed);
+          if (++conn->consecutive_skips >= config.max_consecutive_skips) {
+            conn->closing = true;
+            connections_closed_.fetch_add(1, std::memory_order_relaxed);
+            std::cerr << "[InstanceSubscriptionHub] Closing slow connection ("
+                      << conn->consecutive_skips << " updates skipped)"
+                      << std::endl;
+            if (conn->subscriber.close) {
+              conn->subscriber.close();
+            }
+          }
+          continue;
+        }
+
+        conn->consecutive_skips = 0;
+        conn->pending.fetch_add(1, std::memory_order_acq_rel);
+        conn->subscriber.send(payload, [conn]() {
+          conn->pending.fetch_sub(1, std::memory_order_acq_rel);
+        });
+        sent++;
+      }
+    }
+  }
+
+  auto elapsed = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count());
+  last_fanout_ns_.store(elapsed, std::memory_order_relaxed);
+  total_fanout_ns_.fetch_add(elapsed, std::memory_order_relaxed);
+  ticks_.fetch_add(1, std::memory_order_relaxed);
+  messages_sent_.fetch_add(sent, std::memory_order_relaxed);
+  return sent;
+}
+
+InstanceSubscriptionHub::Stats InstanceSubscriptionHub::getStats() const {
+  Stats stats;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.connections = connections_.size();
+    stats.subscriptions = subscription_count_;
+    stats.instances = subscribers_.size();
+  }
+  stats.ticks = ticks_.load(std::memory_order_relaxed);
+  stats.messages_sent = messages_sent_.load(std::memory_order_relaxed);
+  stats.messages_skipped = messages_skipped_.load(std::memory_order_relaxed);
+  stats.connections_closed =
+      connections_closed_.load(std::memory_order_relaxed);
+  stats.last_fanout_seconds =
+      last_fanout_ns_.load(std::memory_order_relaxed) / 1e9;
+  stats.total_fanout_seconds =
+      total_fanout_ns_.load(std::memory_order_relaxed) / 1e9;
+  return stats;
+}
+
+Json::Value InstanceSubscriptionHub::getStatsJson() const {
+  Stats stats = getStats();
+  Json::Value json;
+  json["connections"] = static_cast<Json::UInt64>(stats.connections);
+  json["subscriptions"] = static_cast<Json::UInt64>(stats.subscriptions);
+  json["instances"] = static_cast<Json::UInt64>(stats.instances);
+  json["ticks"] = static_cast<Json::UInt64>(stats.ticks);
+  json["messagesSent"] = static_cast<Json::UInt64>(stats.messages_sent);
+  json["messagesSkipped"] = static_cast<Json::UInt64>(stats.messages_skipped);
+  json["slowConnectionsClosed"] =
+      static_cast<Json::UInt64>(stats.connections_closed);
+  json["lastFanoutMs"] = stats.last_fanout_seconds * 1000.0;
+  return json;
+}
+
+std::string InstanceSubscriptionHub::getPrometheusMetrics() const {
+  Stats stats = getStats();
+  std::ostringstream oss;
+
+  oss << "# HELP websocket_connections Connections with instance "
+         "subscriptions\n";
+  oss << "# TYPE websocket_connections gauge\n";
+  oss << "websocket_connections " << stats.connections << "\n";
+  oss << "# HELP websocket_subscriptions Active instance subscriptions\n";
+  oss << "# TYPE websocket_subscriptions gauge\n";
+  oss << "websocket_subscriptions " << stats.subscriptions << "\n";
+  oss << "# HELP websocket_subscribed_instances Instances with at least one "
+         "subscriber\n";
+  oss << "# TYPE websocket_subscribed_instances gauge\n";
+  oss << "websocket_subscribed_instances " << stats.instances << "\n";
+
+  oss << "# HELP websocket_messages_sent_total Instance updates sent\n";
+  oss << "# TYPE websocket_messages_sent_total counter\n";
+  oss << "websocket_messages_sent_total " << stats.messages_sent << "\n";
+  oss << "# HELP websocket_messages_skipped_total Updates skipped for slow "
+         "connections\n";
+  oss << "# TYPE websocket_messages_skipped_total counter\n";
+  oss << "websocket_messages_skipped_total " << stats.messages_skipped << "\n";
+  oss << "# HELP websocket_slow_connections_closed_total Connections closed "
+         "for falling behind\n";
+  oss << "# TYPE websocket_slow_connections_closed_total counter\n";
+  oss << "websocket_slow_connections_closed_total " << stats.connections_closed
+      << "\n";
+
+  oss << "# HELP websocket_fanout_duration_seconds Time to build and fan out "
+         "one round of updates\n";
+  oss << "# TYPE websocket_fanout_duration_seconds summary\n";
+  oss << "websocket_fanout_duration_seconds_sum " << stats.total_fanout_seconds
+      << "\n";
+  oss << "websocket_fanout_duration_seconds_count " << stats.ticks << "\n";
+  oss << "\n";
+
+  return oss.str();
+}
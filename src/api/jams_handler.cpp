@@ -2,6 +2,7 @@
 #include "core/logger.h"
 #include "core/logging_flags.h"
 #include "core/metrics_interceptor.h"
+#include "core/operation_executor.h"
 #include "core/uuid_generator.h"
 #include "instances/instance_manager.h"
 #include "instances/inprocess_instance_manager.h"
@@ -1155,64 +1156,82 @@ bool JamsHandler::restartInstanceForJamUpdate(const std::string &instanceId) con
     return true;
   }
 
-  // Restart instance in background thread to apply jam changes
-  std::thread restartThread([this, instanceId]() {
-    try {
-      if (isApiLoggingEnabled()) {
-        PLOG_INFO << "[API] ========================================";
-        PLOG_INFO << "[API] Restarting instance " << instanceId
-                  << " to apply jam changes";
-        PLOG_INFO << "[API] This will rebuild pipeline with new zones from additionalParams[\"JamZones\"]";
-        PLOG_INFO << "[API] ========================================";
-      }
-
-      // Stop instance (this will stop the pipeline)
-      if (isApiLoggingEnabled()) {
-        PLOG_INFO << "[API] Step 1/3: Stopping instance " << instanceId;
-      }
-      instance_manager_->stopInstance(instanceId);
+  // Restart on the operation executor: bounded parallelism, serialized with
+  // other operations on this instance, progress visible via GET
+  // /v1/core/operations/{id}
+  std::string operationId = OperationExecutor::getInstance().submit(
+      "restart", instanceId,
+      [this, instanceId](OperationExecutor::Progress &progress,
+                         std::string &error) {
+        try {
+          if (isApiLoggingEnabled()) {
+            PLOG_INFO << "[API] ========================================";
+            PLOG_INFO << "[API] Restarting instance " << instanceId
+                      << " to apply jam changes";
+            PLOG_INFO << "[API] This will rebuild pipeline with new zones from additionalParams[\"JamZones\"]";
+            PLOG_INFO << "[API] ========================================";
+          }
 
-      // Wait for cleanup to ensure pipeline is fully stopped
-      if (isApiLoggingEnabled()) {
-        PLOG_INFO << "[API] Step 2/3: Waiting for pipeline cleanup (500ms)";
-      }
-      std::this_thread::sleep_for(std::chrono::milliseconds(500));
+          // Stop instance (this will stop the pipeline)
+          if (isApiLoggingEnabled()) {
+            PLOG_INFO << "[API] Step 1/3: Stopping instance " << instanceId;
+          }
+          progress.report(0.1, "stopping pipeline");
+          instance_manager_->stopInstance(instanceId);
 
-      // Start instance again (this will rebuild pipeline with new zones)
-      if (isApiLoggingEnabled()) {
-        PLOG_INFO << "[API] Step 3/3: Starting instance " << instanceId
-                  << " (will rebuild pipeline with new JamZones)";
-      }
-      bool startSuccess = instance_manager_->startInstance(instanceId, true);
+          // Wait for cleanup to ensure pipeline is fully stopped
+          if (isApiLoggingEnabled()) {
+            PLOG_INFO << "[API] Step 2/3: Waiting for pipeline cleanup (500ms)";
+          }
+          std::this_thread::sleep_for(std::chrono::milliseconds(500));
 
-      if (startSuccess) {
-        if (isApiLoggingEnabled()) {
-          PLOG_INFO << "[API] ========================================";
-          PLOG_INFO << "[API] ✓ Instance " << instanceId
-                    << " restarted successfully for jam update";
-          PLOG_INFO << "[API] Pipeline rebuilt with new JamZones - zones should now be active";
-          PLOG_INFO << "[API] ========================================";
-        }
-      } else {
-        if (isApiLoggingEnabled()) {
-          PLOG_ERROR << "[API] ✗ Failed to start instance " << instanceId
-                     << " after restart";
+          // Start instance again (this will rebuild pipeline with new zones)
+          if (isApiLoggingEnabled()) {
+            PLOG_INFO << "[API] Step 3/3: Starting instance " << instanceId
+                      << " (will rebuild pipeline with new JamZones)";
+          }
+          progress.report(0.5, "starting pipeline");
+          bool startSuccess = instance_manager_->startInstance(instanceId, true);
+
+          if (startSuccess) {
+            if (isApiLoggingEnabled()) {
+              PLOG_INFO << "[API] ========================================";
+              PLOG_INFO << "[API] ✓ Instance " << instanceId
+                        << " restarted successfully for jam update";
+              PLOG_INFO << "[API] Pipeline rebuilt with new JamZones - zones should now be active";
+              PLOG_INFO << "[API] ========================================";
+            }
+          } else {
+            if (isApiLoggingEnabled()) {
+              PLOG_ERROR << "[API] ✗ Failed to start instance " << instanceId
+                         << " after restart";
+            }
+            error = "Failed to start instance after restart";
+          }
+          return startSuccess;
+        } catch (const std::exception &e) {
+          if (isApiLoggingEnabled()) {
+            PLOG_ERROR << "[API] ✗ Exception restarting instance " << instanceId
+                       << " for jam update: " << e.what();
+          }
+          error = e.what();
+          return false;
+        } catch (...) {
+          if (isApiLoggingEnabled()) {
+            PLOG_ERROR << "[API] ✗ Unknown error restarting instance " << instanceId
+                       << " for jam update";
+          }
+          error = "Unknown error";
+          return false;
         }
-      }
-    } catch (const std::exception &e) {
-      if (isApiLoggingEnabled()) {
-        PLOG_ERROR << "[API] ✗ Exception restarting instance " << instanceId
-                   << " for jam update: " << e.what();
-      }
-    } catch (...) {
-      if (isApiLoggingEnabled()) {
-        PLOG_ERROR << "[API] ✗ Unknown error restarting instance " << instanceId
-                   << " for jam update";
-      }
+      });
+  if (operationId.empty()) {
+    if (isApiLoggingEnabled()) {
+      PLOG_WARNING << "[API] Operation queue full, could not restart instance "
+                   << instanceId << " for jam update";
     }
-  });
-
-  restartThread.detach();
+    return false;
+  }
   return true;
 }
 
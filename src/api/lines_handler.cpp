@@ -2,6 +2,7 @@
 #include "core/logger.h"
 #include "core/logging_flags.h"
 #include "core/metrics_interceptor.h"
+#include "core/operation_executor.h"
 #include "core/uuid_generator.h"
 #include "instances/instance_manager.h"
 #include <algorithm>
@@ -1676,67 +1677,86 @@ bool LinesHandler::restartInstanceForLineUpdate(
     return true;
   }
 
-  // Restart instance in background thread to apply line changes
-  std::thread restartThread([this, instanceId]() {
-    try {
-      if (isApiLoggingEnabled()) {
-        PLOG_INFO << "[API] ========================================";
-        PLOG_INFO << "[API] Restarting instance " << instanceId
-                  << " to apply line changes";
-        PLOG_INFO << "[API] This will rebuild pipeline with new lines from "
-                     "additionalParams[\"CrossingLines\"]";
-        PLOG_INFO << "[API] ========================================";
-      }
-
-      // Stop instance (this will stop the pipeline)
-      if (isApiLoggingEnabled()) {
-        PLOG_INFO << "[API] Step 1/3: Stopping instance " << instanceId;
-      }
-      instance_manager_->stopInstance(instanceId);
+  // Restart on the operation executor: bounded parallelism, serialized with
+  // other operations on this instance, progress visible via GET
+  // /v1/core/operations/{id}
+  std::string operationId = OperationExecutor::getInstance().submit(
+      "restart", instanceId,
+      [this, instanceId](OperationExecutor::Progress &progress,
+                         std::string &error) {
+        try {
+          if (isApiLoggingEnabled()) {
+            PLOG_INFO << "[API] ========================================";
+            PLOG_INFO << "[API] Restarting instance " << instanceId
+                      << " to apply line changes";
+            PLOG_INFO << "[API] This will rebuild pipeline with new lines from "
+                         "additionalParams[\"CrossingLines\"]";
+            PLOG_INFO << "[API] ========================================";
+          }
 
-      // Wait for cleanup to ensure pipeline is fully stopped
-      if (isApiLoggingEnabled()) {
-        PLOG_INFO << "[API] Step 2/3: Waiting for pipeline cleanup (500ms)";
-      }
-      std::this_thread::sleep_for(std::chrono::milliseconds(500));
+          // Stop instance (this will stop the pipeline)
+          if (isApiLoggingEnabled()) {
+            PLOG_INFO << "[API] Step 1/3: Stopping instance " << instanceId;
+          }
+          progress.report(0.1, "stopping pipeline");
+          instance_manager_->stopInstance(instanceId);
 
-      // Start instance again (this will rebuild pipeline with new lines)
-      // startInstance() calls rebuildPipelineFromInstanceInfo() which rebuilds
-      // pipeline with lines from additionalParams["CrossingLines"]
-      if (isApiLoggingEnabled()) {
-        PLOG_INFO << "[API] Step 3/3: Starting instance " << instanceId
-                  << " (will rebuild pipeline with new lines)";
-      }
-      bool startSuccess = instance_manager_->startInstance(instanceId, true);
+          // Wait for cleanup to ensure pipeline is fully stopped
+          if (isApiLoggingEnabled()) {
+            PLOG_INFO << "[API] Step 2/3: Waiting for pipeline cleanup (500ms)";
+          }
+          std::this_thread::sleep_for(std::chrono::milliseconds(500));
 
-      if (startSuccess) {
-        if (isApiLoggingEnabled()) {
-          PLOG_INFO << "[API] ========================================";
-          PLOG_INFO << "[API] ✓ Instance " << instanceId
-                    << " restarted successfully for line update";
-          PLOG_INFO << "[API] Pipeline rebuilt with new lines - lines should "
-                       "now be visible on stream";
-          PLOG_INFO << "[API] ========================================";
-        }
-      } else {
-        if (isApiLoggingEnabled()) {
-          PLOG_ERROR << "[API] ✗ Failed to start instance " << instanceId
-                     << " after restart";
+          // Start instance again (this will rebuild pipeline with new lines)
+          // startInstance() calls rebuildPipelineFromInstanceInfo() which rebuilds
+          // pipeline with lines from additionalParams["CrossingLines"]
+          if (isApiLoggingEnabled()) {
+            PLOG_INFO << "[API] Step 3/3: Starting instance " << instanceId
+                      << " (will rebuild pipeline with new lines)";
+          }
+          progress.report(0.5, "starting pipeline");
+          bool startSuccess = instance_manager_->startInstance(instanceId, true);
+
+          if (startSuccess) {
+            if (isApiLoggingEnabled()) {
+              PLOG_INFO << "[API] ========================================";
+              PLOG_INFO << "[API] ✓ Instance " << instanceId
+                        << " restarted successfully for line update";
+              PLOG_INFO << "[API] Pipeline rebuilt with new lines - lines should "
+                           "now be visible on stream";
+              PLOG_INFO << "[API] ========================================";
+            }
+          } else {
+            if (isApiLoggingEnabled()) {
+              PLOG_ERROR << "[API] ✗ Failed to start instance " << instanceId
+                         << " after restart";
+            }
+            error = "Failed to start instance after restart";
+          }
+          return startSuccess;
+        } catch (const std::exception &e) {
+          if (isApiLoggingEnabled()) {
+            PLOG_ERROR << "[API] ✗ Exception restarting instance " << instanceId
+                       << " for line update: " << e.what();
+          }
+          error = e.what();
+          return false;
+        } catch (...) {
+          if (isApiLoggingEnabled()) {
+            PLOG_ERROR << "[API] ✗ Unknown error restarting instance " << instanceId
+                       << " for line update";
+          }
+          error = "Unknown error";
+          return false;
         }
-      }
-    } catch (const std::exception &e) {
-      if (isApiLoggingEnabled()) {
-        PLOG_ERROR << "[API] ✗ Exception restarting instance " << instanceId
-                   << " for line update: " << e.what();
-      }
-    } catch (...) {
-      if (isApiLoggingEnabled()) {
-        PLOG_ERROR << "[API] ✗ Unknown error restarting instance " << instanceId
-                   << " for line update";
-      }
+      });
+  if (operationId.empty()) {
+    if (isApiLoggingEnabled()) {
+      PLOG_WARNING << "[API] Operation queue full, could not restart instance "
+                   << instanceId << " for line update";
     }
-  });
-  restartThread.detach();
+    return false;
+  }
 
   return true;
 }
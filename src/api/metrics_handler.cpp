@@ -1,6 +1,14 @@
 #include "api/metrics_handler.h"
+#include "api/instance_subscription_hub.h"
+#include "core/async_log.h"
 #include "core/metrics_interceptor.h"
+#include "core/pipeline_metrics.h"
+#include "core/preview_stream_hub.h"
 #include "core/performance_monitor.h"
+#include "utils/mp4_finalize_queue.h"
+#include "worker/cpu_placement.h"
+#include "worker/worker_cgroup_manager.h"
+#include "worker/worker_recovery_metrics.h"
 #include <drogon/HttpResponse.h>
 #include <json/json.h>
 #include <string>
@@ -27,11 +35,31 @@ void MetricsHandler::getMetrics(
   if (wantJson) {
     // Return JSON format (easier to read)
     auto metricsJson = PerformanceMonitor::getInstance().getMetricsJSON();
+    metricsJson["websocket"] =
+        InstanceSubscriptionHub::getInstance().getStatsJson();
+    metricsJson["preview"] = PreviewStreamHub::getInstance().getStatsJson();
+    metricsJson["workers"] =
+        worker::WorkerRecoveryMetrics::getInstance().getStatsJson();
+    metricsJson["placement"] =
+        worker::CpuPlacement::getInstance().getStatsJson();
+    metricsJson["logging"] = AsyncLogBackend::getInstance().getStatsJson();
+    metricsJson["recording_finalize"] =
+        MP4Finalizer::MP4FinalizeQueue::getInstance().getStatsJson();
     resp = HttpResponse::newHttpJsonResponse(metricsJson);
     resp->setStatusCode(k200OK);
   } else {
     // Return Prometheus format (for monitoring tools)
     auto metrics = PerformanceMonitor::getInstance().getPrometheusMetrics();
+    metrics += PipelineMetricsRegistry::getInstance().getPrometheusMetrics();
+    metrics += InstanceSubscriptionHub::getInstance().getPrometheusMetrics();
+    metrics +=
+        worker::WorkerRecoveryMetrics::getInstance().getPrometheusMetrics();
+    metrics +=
+        worker::WorkerCgroupManager::getInstance().getPrometheusMetrics();
+    metrics += worker::CpuPlacement::getInstance().getPrometheusMetrics();
+    metrics += AsyncLogBackend::getInstance().getPrometheusMetrics();
+    metrics +=
+        MP4Finalizer::MP4FinalizeQueue::getInstance().getPrometheusMetrics();
     resp = HttpResponse::newHttpResponse();
     resp->setStatusCode(k200OK);
     resp->setContentTypeCode(CT_TEXT_PLAIN);
@@ -0,0 +1,92 @@
+#include "api/operations_handler.h"
+#include "core/metrics_interceptor.h"
+#include "core/operation_executor.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace {
+constexpr size_t kDefaultListLimit = 50;
+constexpr size_t kMaxListLimit = 1000;
+} // namespace
+
+HttpResponsePtr OperationsHandler::createJsonResponse(const Json::Value &body,
+                                                      HttpStatusCode code) {
+  auto resp = HttpResponse::newHttpJsonResponse(body);
+  resp->setStatusCode(code);
+  resp->addHeader("Access-Control-Allow-Origin", "*");
+  resp->addHeader("Access-Control-Allow-Methods", "GET, OPTIONS");
+  resp->addHeader("Access-Control-Allow-Headers", "Content-Type");
+  return resp;
+}
+
+void OperationsHandler::listOperations(
+    const HttpRequestPtr &req,
+    std::function<void(const HttpResponsePtr &)> &&callback) {
+  MetricsInterceptor::setHandlerStartTime(req);
+
+  size_t limit = kDefaultListLimit;
+  std::string limitParam = req->getParameter("limit");
+  if (!limitParam.empty()) {
+    try {
+      long long value = std::stoll(limitParam);
+      if (value <= 0) {
+        throw std::invalid_argument("limit");
+      }
+      limit = std::min<size_t>(static_cast<size_t>(value), kMaxListLimit);
+    } catch (const std::exception &) {
+      Json::Value error;
+      error["error"] = "Invalid request";
+      error["message"] = "limit must be a positive integer";
+      MetricsInterceptor::callWithMetrics(
+          req, createJsonResponse(error, k400BadRequest), std::move(callback));
+      return;
+    }
+  }
+
+  auto &executor = OperationExecutor::getInstance();
+  Json::Value response;
+  response["operations"] =
+      executor.listOperationsJson(req->getParameter("instanceId"), limit);
+  response["stats"] = executor.getStatsJson();
+  MetricsInterceptor::callWithMetrics(req, createJsonResponse(response, k200OK),
+                                      std::move(callback));
+}
+
+void OperationsHandler::getOperation(
+    const HttpRequestPtr &req,
+    std::function<void(const HttpResponsePtr &)> &&callback) {
+  MetricsInterceptor::setHandlerStartTime(req);
+
+  std::string operationId = req->getParameter("operationId");
+  if (operationId.empty()) {
+    // Fallback: last path segment
+    std::string path = req->getPath();
+    operationId = path.substr(path.find_last_of('/') + 1);
+  }
+
+  auto operation = OperationExecutor::getInstance().getOperationJson(operationId);
+  if (!operation) {
+    Json::Value error;
+    error["error"] = "Not found";
+    error["message"] = "Operation not found (unknown or expired): " +
+                       operationId;
+    MetricsInterceptor::callWithMetrics(
+        req, createJsonResponse(error, k404NotFound), std::move(callback));
+    return;
+  }
+  MetricsInterceptor::callWithMetrics(
+      req, createJsonResponse(*operation, k200OK), std::move(callback));
+}
+
+void OperationsHandler::handleOptions(
+    const HttpRequestPtr & /*req*/,
+    std::function<void(const HttpResponsePtr &)> &&callback) {
+  auto resp = HttpResponse::newHttpResponse();
+  resp->setStatusCode(k200OK);
+  resp->addHeader("Access-Control-Allow-Origin", "*");
+  resp->addHeader("Access-Control-Allow-Methods", "GET, OPTIONS");
+  resp->addHeader("Access-Control-Allow-Headers", "Content-Type");
+  resp->addHeader("Access-Control-Max-Age", "3600");
+  callback(resp);
+}
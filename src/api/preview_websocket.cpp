@@ -0,0 +1,171 @@
+#include "api/preview_websocket.h"
+#include "core/preview_stream_hub.h"
+#include "instances/instance_manager.h"
+#include <json/json.h>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+#include <trantor/net/EventLoop.h>
+#include <vector>
+
+IInstanceManager *PreviewWebSocketController::instance_manager_ = nullptr;
+
+namespace {
+// Viewer ID stored as connection context
+struct PreviewViewerContext {
+  PreviewStreamHub::ViewerId viewer_id = 0;
+};
+
+std::string extractInstanceId(const std::string &path) {
+  const std::string marker = "/instance/";
+  size_t start = path.find(marker);
+  if (start == std::string::npos) {
+    return "";
+  }
+  start += marker.size();
+  size_t end = path.find('/', start);
+  return path.substr(start, end == std::string::npos ? std::string::npos
+                                                     : end - start);
+}
+} // namespace
+
+void PreviewWebSocketController::setInstanceManager(IInstanceManager *manager) {
+  instance_manager_ = manager;
+
+  auto &hub = PreviewStreamHub::getInstance();
+  hub.setFrameSource([](const std::string &instanceId) -> std::string {
+    if (!instance_manager_) {
+      return "";
+    }
+    return instance_manager_->getLastFrameJpeg(instanceId);
+  });
+  hub.setTranscoder(&PreviewWebSocketController::scaleJpeg);
+  hub.start();
+}
+
+std::string PreviewWebSocketController::scaleJpeg(const std::string &jpeg,
+                                                  int width, int quality) {
+  cv::Mat encoded(1, static_cast<int>(jpeg.size()), CV_8UC1,
+                  const_cast<char *>(jpeg.data()));
+  cv::Mat image = cv::imdecode(encoded, cv::IMREAD_COLOR);
+  if (image.empty()) {
+    return "";
+  }
+  if (width <= 0 || image.cols <= width) {
+    return jpeg; // Never upscale
+  }
+
+  int height = std::max(2, (image.rows * width / image.cols) & ~1);
+  cv::Mat scaled;
+  cv::resize(image, scaled, cv::Size(width, height), 0, 0, cv::INTER_AREA);
+
+  std::vector<uchar> buffer;
+  std::vector<int> params = {cv::IMWRITE_JPEG_QUALITY, quality};
+  if (!cv::imencode(".jpg", scaled, buffer, params)) {
+    return "";
+  }
+  return std::string(buffer.begin(), buffer.end());
+}
+
+void PreviewWebSocketController::handleNewConnection(
+    const HttpRequestPtr &req, const WebSocketConnectionPtr &wsConnPtr) {
+  std::string instanceId = extractInstanceId(req->getPath());
+
+  auto sendError = [&wsConnPtr](const std::string &message) {
+    Json::Value error;
+    error["type"] = "error";
+    error["message"] = message;
+    wsConnPtr->send(Json::writeString(Json::StreamWriterBuilder(), error));
+    wsConnPtr->shutdown(CloseCode::kViolation, message);
+  };
+
+  if (!instance_manager_ || instanceId.empty() ||
+      !instance_manager_->getInstance(instanceId).has_value()) {
+    sendError("Instance not found: " + instanceId);
+    return;
+  }
+
+  auto &hub = PreviewStreamHub::getInstance();
+  PreviewStreamHub::Variant requested;
+  try {
+    std::string fps = req->getParameter("fps");
+    std::string width = req->getParameter("width");
+    if (!fps.empty()) {
+      requested.max_fps = std::stoi(fps);
+    }
+    if (!width.empty()) {
+      requested.width = std::stoi(width);
+    }
+  } catch (const std::exception &) {
+    sendError("fps and width must be integers");
+    return;
+  }
+  auto variant = hub.normalize(requested);
+
+  // Frames are sent on the connection's own loop; until then they count as
+  // in flight, so a slow client skips frames instead of piling them up
+  std::weak_ptr<WebSocketConnection> weak = wsConnPtr;
+  trantor::EventLoop *loop = trantor::EventLoop::getEventLoopOfCurrentThread();
+  auto viewerId = hub.addViewer(
+      instanceId, variant, PreviewStreamHub::Framing::Jpeg,
+      [weak, loop](const PreviewStreamHub::Payload &payload,
+                   PreviewStreamHub::Sent sent) {
+        auto conn = weak.lock();
+        if (!conn || !conn->connected()) {
+          return false;
+        }
+        auto send = [weak, payload, sent = std::move(sent)]() {
+          if (auto conn = weak.lock()) {
+            conn->send(payload->data(), payload->size(),
+                       WebSocketMessageType::Binary);
+          }
+          sent();
+        };
+        if (loop) {
+          loop->queueInLoop(std::move(send));
+        } else {
+          send();
+        }
+        return true;
+      });
+  if (viewerId == 0) {
+    sendError("Too many preview viewers");
+    return;
+  }
+
+  auto context = std::make_shared<PreviewViewerContext>();
+  context->viewer_id = viewerId;
+  wsConnPtr->setContext(context);
+
+  Json::Value welcome;
+  welcome["type"] = "connected";
+  welcome["instanceId"] = instanceId;
+  welcome["fps"] = variant.max_fps;
+  welcome["width"] = variant.width;
+  wsConnPtr->send(Json::writeString(Json::StreamWriterBuilder(), welcome));
+}
+
+void PreviewWebSocketController::handleConnectionClosed(
+    const WebSocketConnectionPtr &wsConnPtr) {
+  if (!wsConnPtr->hasContext()) {
+    return;
+  }
+  auto context = wsConnPtr->getContext<PreviewViewerContext>();
+  if (context) {
+    PreviewStreamHub::getInstance().removeViewer(context->viewer_id);
+  }
+}
+
+void PreviewWebSocketController::handleNewMessage(
+    const WebSocketConnectionPtr &wsConnPtr, std::string &&message,
+    const WebSocketMessageType &type) {
+  if (type != WebSocketMessageType::Text) {
+    return;
+  }
+  Json::Value json;
+  Json::Reader reader;
+  if (reader.parse(message, json) && json.get("type", "").asString() == "ping") {
+    Json::Value pong;
+    pong["type"] = "pong";
+    wsConnPtr->send(Json::writeString(Json::StreamWriterBuilder(), pong));
+  }
+}
@@ -3,6 +3,9 @@
 #include "core/logger.h"
 #include "core/logging_flags.h"
 #include "core/metrics_interceptor.h"
+#include "core/recognition_cache.h"
+#include "utils/base64_codec.h"
+#include "utils/image_header.h"
 #include <algorithm>
 #include <cctype>
 #include <chrono>
@@ -230,6 +233,135 @@ static cv::Mat align_face_using_landmarks(const cv::Mat &image,
   return aligned;
 }
 
+// Helper function: Minimum long side of the image face detection runs on,
+// from the optional "recognition_decode" config section (0 = full resolution)
+static int getDetectionMinLongSide() {
+  static std::once_flag configured;
+  static int minLongSide = 960;
+  std::call_once(configured, []() {
+    try {
+      Json::Value section =
+          SystemConfig::getInstance().getConfigSection("recognition_decode");
+      if (section.isObject()) {
+        minLongSide =
+            section.get("detect_min_long_side", minLongSide).asInt();
+      }
+    } catch (const std::exception &e) {
+      PLOG_WARNING << "[RecognitionHandler] Invalid recognition_decode "
+                      "config, using defaults: "
+                   << e.what();
+    }
+  });
+  return minLongSide;
+}
+
+// Helper function: Aligned 112x112 face from a YuNet detection row
+// (landmark alignment when available, otherwise a clamped box crop)
+static cv::Mat crop_face(const cv::Mat &image, const cv::Mat &faces,
+                         int face_idx) {
+  if (faces.cols >= 15) {
+    return align_face_using_landmarks(image, faces, face_idx);
+  }
+  float x = faces.at<float>(face_idx, 0), y = faces.at<float>(face_idx, 1);
+  float w = faces.at<float>(face_idx, 2), h = faces.at<float>(face_idx, 3);
+  x = std::max(0.0f, std::min(x, (float)(image.cols - 1)));
+  y = std::max(0.0f, std::min(y, (float)(image.rows - 1)));
+  w = std::max(1.0f, std::min(w, (float)(image.cols - x)));
+  h = std::max(1.0f, std::min(h, (float)(image.rows - y)));
+  cv::Mat aligned_face;
+  cv::resize(image(cv::Rect((int)x, (int)y, (int)w, (int)h)), aligned_face,
+             cv::Size(112, 112));
+  return aligned_face;
+}
+
+// Helper class: Image decoded at a reduced scale for face detection
+//
+// Large JPEGs are decoded with DCT scaling (IMREAD_REDUCED_COLOR_2/4/8), so
+// a 12 MP phone upload costs about as much as a 1 MP one; other formats are
+// decoded once and downsized. Detections stay in detection-image coordinates;
+// toFullResolution() maps them back for reporting. Face crops come from the
+// reduced image when the face still covers the 112x112 recognizer input
+// there, otherwise from a full-resolution decode made on first need.
+class ScaledFaceImage {
+public:
+  explicit ScaledFaceImage(const std::vector<unsigned char> &data)
+      : data_(data) {
+    ImageHeader::Info info = ImageHeader::probe(data);
+    int scale = info.valid()
+                    ? ImageHeader::reducedScale(info.width, info.height,
+                                                getDetectionMinLongSide())
+                    : 1;
+    if (scale > 1 && info.format == ImageHeader::Format::Jpeg) {
+      int flag = scale == 8   ? cv::IMREAD_REDUCED_COLOR_8
+                 : scale == 4 ? cv::IMREAD_REDUCED_COLOR_4
+                              : cv::IMREAD_REDUCED_COLOR_2;
+      detection_ = cv::imdecode(data, flag);
+      if (!detection_.empty()) {
+        scale_ = scale;
+        return;
+      }
+    }
+    full_ = cv::imdecode(data, cv::IMREAD_COLOR);
+    if (full_.empty()) {
+      return;
+    }
+    if (scale > 1) {
+      cv::resize(full_, detection_, cv::Size(), 1.0 / scale, 1.0 / scale,
+                 cv::INTER_AREA);
+      scale_ = scale;
+    } else {
+      detection_ = full_;
+    }
+  }
+
+  bool empty() const { return detection_.empty(); }
+  const cv::Mat &detectionImage() const { return detection_; }
+  int scale() const { return scale_; }
+
+  // Full-resolution size, known without a full decode
+  cv::Size size() const {
+    return full_.empty()
+               ? cv::Size(detection_.cols * scale_, detection_.rows * scale_)
+               : full_.size();
+  }
+
+  // Box and landmark columns (0-13) of YuNet rows in full-resolution pixels
+  cv::Mat toFullResolution(const cv::Mat &faces) const {
+    cv::Mat mapped = faces.clone();
+    if (scale_ > 1) {
+      int cols = std::min(mapped.cols, 14);
+      for (int r = 0; r < mapped.rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+          mapped.at<float>(r, c) *= static_cast<float>(scale_);
+        }
+      }
+    }
+    return mapped;
+  }
+
+  // Aligned face for detection row face_idx (detection coordinates)
+  cv::Mat alignedFace(const cv::Mat &faces, int face_idx) {
+    float side = std::min(faces.at<float>(face_idx, 2),
+                          faces.at<float>(face_idx, 3));
+    if (scale_ == 1 || side >= 112.0f) {
+      return crop_face(detection_, faces, face_idx);
+    }
+    if (full_.empty()) {
+      full_ = cv::imdecode(data_, cv::IMREAD_COLOR);
+      if (full_.empty()) {
+        return crop_face(detection_, faces, face_idx);
+      }
+    }
+    return crop_face(full_, toFullResolution(faces.row(face_idx)), 0);
+  }
+
+private:
+  const std::vector<unsigned char> &data_;
+  cv::Mat detection_;
+  cv::Mat full_;
+  int scale_ = 1;
+};
+
 // Helper function: extract embedding from aligned face image
 static std::vector<float>
 extract_embedding_from_image(const cv::Mat &aligned_face,
@@ -429,6 +561,82 @@ static Json::Value getDatabaseConnectionConfig() {
   }
 }
 
+// Helper function: Result cache for recognize/search, configured once from
+// the optional "recognition_cache" config section
+static RecognitionCache &getRecognitionCache() {
+  static std::once_flag configured;
+  std::call_once(configured, []() {
+    RecognitionCache::Config config;
+    try {
+      Json::Value section =
+          SystemConfig::getInstance().getConfigSection("recognition_cache");
+      if (section.isObject()) {
+        config.enabled = section.get("enabled", config.enabled).asBool();
+        config.max_bytes =
+            static_cast<size_t>(section.get("max_size_mb", 32).asUInt()) *
+            1024 * 1024;
+        config.ttl = std::chrono::seconds(
+            section.get("ttl_seconds", static_cast<Json::Int64>(
+                                           config.ttl.count()))
+                .asInt64());
+        config.perceptual_hash =
+            section.get("perceptual_hash", config.perceptual_hash).asBool();
+        config.perceptual_max_distance =
+            section
+                .get("perceptual_max_distance", config.perceptual_max_distance)
+                .asUInt();
+      }
+    } catch (const std::exception &e) {
+      PLOG_WARNING << "[RecognitionHandler] Invalid recognition_cache config, "
+                      "using defaults: "
+                   << e.what();
+    }
+    RecognitionCache::getInstance().configure(config);
+  });
+  return RecognitionCache::getInstance();
+}
+
+// Helper function: Difference hash of the image for near-duplicate lookups
+// Decodes at 1/8 scale in grayscale - much cheaper than the full decode
+static uint64_t computePerceptualHash(const std::vector<unsigned char> &data) {
+  try {
+    cv::Mat gray = cv::imdecode(data, cv::IMREAD_REDUCED_GRAYSCALE_8);
+    if (gray.empty()) {
+      return 0;
+    }
+    cv::Mat thumb;
+    cv::resize(gray, thumb, cv::Size(9, 8), 0, 0, cv::INTER_AREA);
+    if (!thumb.isContinuous()) {
+      thumb = thumb.clone();
+    }
+    return RecognitionCache::differenceHash(thumb.ptr<uint8_t>());
+  } catch (const cv::Exception &) {
+    return 0;
+  }
+}
+
+// Helper function: Serialize a JSON body once so it can also be cached
+static std::string serializeJsonBody(const Json::Value &json) {
+  Json::StreamWriterBuilder builder;
+  builder["indentation"] = "";
+  return Json::writeString(builder, json);
+}
+
+// Helper function: Build a JSON response from a serialized body
+static HttpResponsePtr createJsonBodyResponse(const std::string &body,
+                                              const std::string &allowHeaders,
+                                              bool cacheHit) {
+  auto resp = HttpResponse::newHttpResponse();
+  resp->setStatusCode(k200OK);
+  resp->setContentTypeCode(CT_APPLICATION_JSON);
+  resp->setBody(body);
+  resp->addHeader("Access-Control-Allow-Origin", "*");
+  resp->addHeader("Access-Control-Allow-Methods", "POST, OPTIONS");
+  resp->addHeader("Access-Control-Allow-Headers", allowHeaders);
+  resp->addHeader("X-Cache", cacheHit ? "HIT" : "MISS");
+  return resp;
+}
+
 // Helper function: Resolve database file path with 3-tier fallback
 // Following DIRECTORY_CREATION_GUIDE.md pattern
 static std::string resolveDatabasePath() {
@@ -694,6 +902,9 @@ private:
   }
 
   void save_database() {
+    // Every gallery mutation ends here - cached recognition results are stale
+    RecognitionCache::getInstance().bumpGalleryVersion();
+
     // Ensure parent directory exists
     try {
       std::filesystem::path filePath(db_file_path_);
@@ -840,7 +1051,8 @@ public:
       return false;
     }
 
-    cv::Mat image = cv::imdecode(imageData, cv::IMREAD_COLOR);
+    ScaledFaceImage scaled(imageData);
+    const cv::Mat &image = scaled.detectionImage();
     if (image.empty()) {
       error_msg = "Failed to decode image data. Image may be corrupted or in "
                   "unsupported format.";
@@ -854,7 +1066,8 @@ public:
 
     if (isApiLoggingEnabled()) {
       PLOG_DEBUG << "[FaceDatabase] Decoded image: " << image.cols << "x"
-                 << image.rows << " pixels";
+                 << image.rows << " pixels (1/" << scaled.scale()
+                 << " scale)";
     }
 
     if (detector_model_path_.empty()) {
@@ -915,8 +1128,8 @@ public:
     if (faces.rows == 0 || faces.empty()) {
       error_msg = "No face detected in image. Please ensure the image contains "
                   "a clear face. Image size: " +
-                  std::to_string(image.cols) + "x" +
-                  std::to_string(image.rows) +
+                  std::to_string(scaled.size().width) + "x" +
+                  std::to_string(scaled.size().height) +
                   ", detection threshold: " + std::to_string(detProbThreshold);
       return false;
     }
@@ -926,22 +1139,7 @@ public:
                  << " face(s) in image";
     }
 
-    float x = faces.at<float>(0, 0), y = faces.at<float>(0, 1);
-    float w = faces.at<float>(0, 2), h = faces.at<float>(0, 3);
-
-    x = std::max(0.0f, std::min(x, (float)(image.cols - 1)));
-    y = std::max(0.0f, std::min(y, (float)(image.rows - 1)));
-    w = std::max(1.0f, std::min(w, (float)(image.cols - x)));
-    h = std::max(1.0f, std::min(h, (float)(image.rows - y)));
-
-    cv::Mat aligned_face;
-    if (faces.cols >= 15) {
-      aligned_face = align_face_using_landmarks(image, faces, 0);
-    } else {
-      cv::Mat face_roi =
-          image(cv::Rect((int)x, (int)y, (int)w, (int)h)).clone();
-      cv::resize(face_roi, aligned_face, cv::Size(112, 112));
-    }
+    cv::Mat aligned_face = scaled.alignedFace(faces, 0);
 
     if (onnx_model_path_.empty()) {
       error_msg = "Face recognition model not found. Please ensure "
@@ -1054,12 +1252,14 @@ public:
 class FaceDatabaseHelper {
 private:
   Json::Value dbConfig_;
-  bool enabled_;
+  bool enabled_ = false;
 
 public:
   FaceDatabaseHelper() { reloadConfig(); }
 
   void reloadConfig() {
+    bool wasEnabled = enabled_;
+    Json::Value previousConfig = dbConfig_;
     enabled_ = isDatabaseConnectionEnabled();
     if (enabled_) {
       dbConfig_ = getDatabaseConnectionConfig();
@@ -1083,6 +1283,11 @@ public:
         PLOG_DEBUG << "[FaceDatabaseHelper] Database connection not enabled";
       }
     }
+
+    // Switching storage backend changes the gallery
+    if (enabled_ != wasEnabled || (enabled_ && dbConfig_ != previousConfig)) {
+      RecognitionCache::getInstance().bumpGalleryVersion();
+    }
   }
 
   bool isEnabled() const { return enabled_; }
@@ -1357,6 +1562,7 @@ public:
     }
 
     if (executeMySQLCommand(sql.str(), error)) {
+      RecognitionCache::getInstance().bumpGalleryVersion();
       if (isApiLoggingEnabled()) {
         PLOG_INFO << "[FaceDatabaseHelper] Successfully saved face to "
                      "database: image_id="
@@ -1679,6 +1885,7 @@ public:
     }
 
     if (executeMySQLCommand(sql, error)) {
+      RecognitionCache::getInstance().bumpGalleryVersion();
       if (isApiLoggingEnabled()) {
         PLOG_INFO << "[FaceDatabaseHelper] Successfully deleted face from "
                      "database: image_id="
@@ -1800,6 +2007,7 @@ public:
     }
 
     if (executeMySQLCommand(sql, error)) {
+      RecognitionCache::getInstance().bumpGalleryVersion();
       if (isApiLoggingEnabled()) {
         PLOG_INFO << "[FaceDatabaseHelper] Successfully deleted subject from "
                      "database: subject="
@@ -1830,6 +2038,7 @@ public:
     }
 
     if (executeMySQLCommand(sql, error)) {
+      RecognitionCache::getInstance().bumpGalleryVersion();
       if (isApiLoggingEnabled()) {
         PLOG_INFO << "[FaceDatabaseHelper] Successfully deleted all faces from "
                      "database";
@@ -1874,6 +2083,7 @@ public:
         }
 
         if (executeMySQLCommand(sql, error)) {
+          RecognitionCache::getInstance().bumpGalleryVersion();
           if (isApiLoggingEnabled()) {
             PLOG_INFO << "[FaceDatabaseHelper] Successfully merged subjects in "
                          "database";
@@ -1901,6 +2111,7 @@ public:
     }
 
     if (executeMySQLCommand(sql, error)) {
+      RecognitionCache::getInstance().bumpGalleryVersion();
       if (isApiLoggingEnabled()) {
         PLOG_INFO
             << "[FaceDatabaseHelper] Successfully renamed subject in database";
@@ -2028,91 +2239,17 @@ void RecognitionHandler::populateStorageFromDatabase(
 }
 
 bool RecognitionHandler::isBase64(const std::string &str) const {
-  if (str.empty())
-    return false;
-
-  // Base64 characters: A-Z, a-z, 0-9, +, /, and = for padding
-  for (char c : str) {
-    if (!std::isalnum(c) && c != '+' && c != '/' && c != '=' && c != '\n' &&
-        c != '\r' && c != ' ') {
-      return false;
-    }
-  }
-
-  // Check for base64 padding pattern
-  size_t paddingCount = 0;
-  for (size_t i = str.length() - 1; i > 0 && str[i] == '='; --i) {
-    paddingCount++;
-  }
-
-  return paddingCount <= 2;
+  return Base64::isBase64(str);
 }
 
 bool RecognitionHandler::decodeBase64(
     const std::string &base64Str, std::vector<unsigned char> &output) const {
-  // Remove whitespace
-  std::string cleanBase64;
-  for (char c : base64Str) {
-    if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
-      cleanBase64 += c;
-    }
-  }
-
-  if (cleanBase64.empty()) {
-    return false;
-  }
-
-  // Base64 decoding
-  const std::string base64_chars =
-      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-
-  int val = 0, valb = -8;
-  for (unsigned char c : cleanBase64) {
-    if (c == '=')
-      break;
-
-    size_t pos = base64_chars.find(c);
-    if (pos == std::string::npos) {
-      return false; // Invalid character
-    }
-
-    val = (val << 6) + pos;
-    valb += 6;
-
-    if (valb >= 0) {
-      output.push_back((val >> valb) & 0xFF);
-      valb -= 8;
-    }
-  }
-
-  return true;
+  return Base64::decode(base64Str, output) && !output.empty();
 }
 
 std::string
 RecognitionHandler::encodeBase64(const std::vector<unsigned char> &data) const {
-  const std::string base64_chars =
-      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-  std::string encoded;
-  int val = 0, valb = -6;
-
-  for (unsigned char c : data) {
-    val = (val << 8) + c;
-    valb += 8;
-    while (valb >= 0) {
-      encoded.push_back(base64_chars[(val >> valb) & 0x3F]);
-      valb -= 6;
-    }
-  }
-
-  if (valb > -6) {
-    encoded.push_back(base64_chars[((val << 8) >> (valb + 8)) & 0x3F]);
-  }
-
-  while (encoded.size() % 4) {
-    encoded.push_back('=');
-  }
-
-  return encoded;
+  return Base64::encode(data);
 }
 
 bool RecognitionHandler::validateImageFormatAndSize(
@@ -2420,19 +2557,11 @@ bool RecognitionHandler::extractImageData(const HttpRequestPtr &req,
 
   // If it looks like text data and is reasonably long, try base64 decode
   if (isTextData && imageData.size() > 100) {
-    std::string base64Str(reinterpret_cast<const char *>(imageData.data()),
-                          imageData.size());
-    // Remove whitespace
-    std::string cleanBase64;
-    for (char c : base64Str) {
-      if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
-        cleanBase64 += c;
-      }
-    }
-
-    // Try to decode as base64
+    // Try to decode as base64 (whitespace is skipped by the decoder)
     std::vector<unsigned char> decoded;
-    if (decodeBase64(cleanBase64, decoded) && !decoded.empty()) {
+    if (Base64::decode(reinterpret_cast<const char *>(imageData.data()),
+                       imageData.size(), decoded) &&
+        !decoded.empty()) {
       // Verify decoded data looks like image (starts with image magic bytes)
       if (decoded.size() > 4) {
         // Check for common image formats: JPEG (FF D8), PNG (89 50 4E 47), etc.
@@ -2567,7 +2696,10 @@ Json::Value RecognitionHandler::processFaceRecognition(
                  << imageData.size() << " bytes";
     }
 
-    cv::Mat image = cv::imdecode(imageData, cv::IMREAD_COLOR);
+    // Reduced-scale decode for detection; full resolution only where a face
+    // crop needs it
+    ScaledFaceImage scaled(imageData);
+    const cv::Mat &image = scaled.detectionImage();
 
     if (image.empty()) {
       // Return empty result if image cannot be decoded
@@ -2579,7 +2711,8 @@ Json::Value RecognitionHandler::processFaceRecognition(
 
     if (isApiLoggingEnabled()) {
       PLOG_DEBUG << "[RecognitionHandler] Decoded image: " << image.cols << "x"
-                 << image.rows << " pixels";
+                 << image.rows << " pixels (1/" << scaled.scale()
+                 << " scale)";
     }
 
     if (!detectFaces) {
@@ -2740,6 +2873,9 @@ Json::Value RecognitionHandler::processFaceRecognition(
                  << " face(s) in image";
     }
 
+    // Boxes and landmarks are reported in full-resolution pixels
+    cv::Mat facesFull = scaled.toFullResolution(faces);
+
     // Process each detected face
     int num_faces = (limit > 0) ? std::min(limit, faces.rows) : faces.rows;
 
@@ -2748,10 +2884,10 @@ Json::Value RecognitionHandler::processFaceRecognition(
       Json::Value faceResult;
 
       // Extract face detection data
-      float x = faces.at<float>(i, 0);
-      float y = faces.at<float>(i, 1);
-      float w = faces.at<float>(i, 2);
-      float h = faces.at<float>(i, 3);
+      float x = facesFull.at<float>(i, 0);
+      float y = facesFull.at<float>(i, 1);
+      float w = facesFull.at<float>(i, 2);
+      float h = facesFull.at<float>(i, 3);
       float score = (faces.cols > 14) ? faces.at<float>(i, 14) : 1.0f;
 
       // Bounding box
@@ -2769,16 +2905,16 @@ Json::Value RecognitionHandler::processFaceRecognition(
       if (faces.cols >= 15) {
         // YuNet format: (x, y, w, h, re_x, re_y, le_x, le_y, nt_x, nt_y, rcm_x,
         // rcm_y, lcm_x, lcm_y, score)
-        float re_x = faces.at<float>(i, 4);
-        float re_y = faces.at<float>(i, 5);
-        float le_x = faces.at<float>(i, 6);
-        float le_y = faces.at<float>(i, 7);
-        float nt_x = faces.at<float>(i, 8);
-        float nt_y = faces.at<float>(i, 9);
-        float rcm_x = faces.at<float>(i, 10);
-        float rcm_y = faces.at<float>(i, 11);
-        float lcm_x = faces.at<float>(i, 12);
-        float lcm_y = faces.at<float>(i, 13);
+        float re_x = facesFull.at<float>(i, 4);
+        float re_y = facesFull.at<float>(i, 5);
+        float le_x = facesFull.at<float>(i, 6);
+        float le_y = facesFull.at<float>(i, 7);
+        float nt_x = facesFull.at<float>(i, 8);
+        float nt_y = facesFull.at<float>(i, 9);
+        float rcm_x = facesFull.at<float>(i, 10);
+        float rcm_y = facesFull.at<float>(i, 11);
+        float lcm_x = facesFull.at<float>(i, 12);
+        float lcm_y = facesFull.at<float>(i, 13);
 
         Json::Value landmark1(Json::arrayValue);
         landmark1.append(static_cast<int>(re_x));
@@ -2808,19 +2944,7 @@ Json::Value RecognitionHandler::processFaceRecognition(
       faceResult["landmarks"] = landmarks;
 
       // Recognize face (compare with database)
-      x = std::max(0.0f, std::min(x, (float)(image.cols - 1)));
-      y = std::max(0.0f, std::min(y, (float)(image.rows - 1)));
-      w = std::max(1.0f, std::min(w, (float)(image.cols - x)));
-      h = std::max(1.0f, std::min(h, (float)(image.rows - y)));
-
-      cv::Mat aligned_face;
-      if (faces.cols >= 15) {
-        aligned_face = align_face_using_landmarks(image, faces, i);
-      } else {
-        cv::Mat face_roi =
-            image(cv::Rect((int)x, (int)y, (int)w, (int)h)).clone();
-        cv::resize(face_roi, aligned_face, cv::Size(112, 112));
-      }
+      cv::Mat aligned_face = scaled.alignedFace(faces, i);
 
       // Extract embedding with data augmentation (original + flip) for better
       // accuracy Similar to example_face_recognition.cpp
@@ -3015,6 +3139,33 @@ void RecognitionHandler::recognizeFaces(
                  << ", detect_faces: " << (detectFaces ? "true" : "false");
     }
 
+    // Serve resubmitted frames from the result cache (skips decode and
+    // inference). Key covers the raw image bytes and every result-affecting
+    // parameter.
+    auto &cache = getRecognitionCache();
+    std::ostringstream cacheParams;
+    cacheParams << "recognize|" << limit << "|" << predictionCount << "|"
+                << detProbThreshold << "|" << similarityThreshold << "|"
+                << facePlugins << "|" << detectFaces;
+    RecognitionCache::Key cacheKey =
+        RecognitionCache::makeKey(imageData, cacheParams.str());
+    uint64_t galleryVersion = cache.galleryVersion();
+    uint64_t perceptualHash = 0;
+    std::optional<std::string> cachedBody = cache.get(cacheKey);
+    if (!cachedBody && cache.isEnabled() && cache.getConfig().perceptual_hash) {
+      perceptualHash = computePerceptualHash(imageData);
+      cachedBody = cache.getSimilar(cacheKey.params, perceptualHash);
+    }
+    if (cachedBody) {
+      if (isApiLoggingEnabled()) {
+        PLOG_DEBUG << "[API] POST /v1/recognition/recognize - Cache hit";
+      }
+      MetricsInterceptor::callWithMetrics(
+          req, createJsonBodyResponse(*cachedBody, "Content-Type", true),
+          std::move(callback));
+      return;
+    }
+
     // Process face recognition
     Json::Value recognitionResult =
         processFaceRecognition(imageData, limit, predictionCount,
@@ -3025,13 +3176,9 @@ void RecognitionHandler::recognizeFaces(
     Json::Value response;
     response["result"] = recognitionResult;
 
-    auto resp = HttpResponse::newHttpJsonResponse(response);
-    resp->setStatusCode(k200OK);
-
-    // Add CORS headers
-    resp->addHeader("Access-Control-Allow-Origin", "*");
-    resp->addHeader("Access-Control-Allow-Methods", "POST, OPTIONS");
-    resp->addHeader("Access-Control-Allow-Headers", "Content-Type");
+    std::string body = serializeJsonBody(response);
+    auto resp = createJsonBodyResponse(body, "Content-Type", false);
+    cache.put(cacheKey, std::move(body), galleryVersion, perceptualHash);
 
     auto end_time = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -3166,12 +3313,13 @@ bool RecognitionHandler::extractImageFromJson(
     return false;
   }
 
-  // Remove data URL prefix if present (e.g., "data:image/jpeg;base64,")
+  // Skip data URL prefix if present (e.g., "data:image/jpeg;base64,")
+  size_t offset = 0;
   size_t commaPos = fileBase64.find(',');
   if (commaPos != std::string::npos) {
     std::string prefix = fileBase64.substr(0, commaPos);
     if (prefix.find("base64") != std::string::npos) {
-      fileBase64 = fileBase64.substr(commaPos + 1);
+      offset = commaPos + 1;
       if (isApiLoggingEnabled()) {
         PLOG_DEBUG << "[RecognitionHandler] Removed data URL prefix from "
                       "base64 string";
@@ -3180,7 +3328,8 @@ bool RecognitionHandler::extractImageFromJson(
   }
 
   // Decode base64
-  if (!decodeBase64(fileBase64, imageData)) {
+  if (!Base64::decode(fileBase64.data() + offset, fileBase64.size() - offset,
+                      imageData)) {
     error = "Failed to decode base64 image data";
     return false;
   }
@@ -3203,8 +3352,9 @@ bool RecognitionHandler::registerSubject(
       return false;
     }
 
-    // Validate image can be decoded
-    cv::Mat image = cv::imdecode(imageData, cv::IMREAD_COLOR);
+    // Validate image can be decoded (1/8 scale is enough to tell and much
+    // cheaper for large JPEGs)
+    cv::Mat image = cv::imdecode(imageData, cv::IMREAD_REDUCED_GRAYSCALE_8);
     if (image.empty()) {
       error = "Invalid image format or corrupted image data. Please ensure the "
               "image is a valid JPEG, PNG, BMP, GIF, ICO, TIFF, or WebP file";
@@ -3539,8 +3689,9 @@ void RecognitionHandler::registerFaceSubject(
       return;
     }
 
-    // Decode image first
-    cv::Mat image = cv::imdecode(imageData, cv::IMREAD_COLOR);
+    // Decode image first (reduced scale: only used to gate on a detected face)
+    ScaledFaceImage scaled(imageData);
+    const cv::Mat &image = scaled.detectionImage();
     if (image.empty()) {
       if (isApiLoggingEnabled()) {
         PLOG_WARNING
@@ -3559,7 +3710,8 @@ void RecognitionHandler::registerFaceSubject(
     if (isApiLoggingEnabled()) {
       PLOG_DEBUG << "[API] POST /v1/recognition/faces - Successfully decoded "
                     "image: "
-                 << image.cols << "x" << image.rows << " pixels";
+                 << image.cols << "x" << image.rows << " pixels (1/"
+                 << scaled.scale() << " scale)";
     }
 
     // Face detection node: Check if image contains a face before registration
@@ -4968,11 +5120,38 @@ void RecognitionHandler::searchAppearanceSubject(
       return;
     }
 
+    // Serve resubmitted frames from the result cache (skips decode and
+    // inference)
+    auto &cache = getRecognitionCache();
+    std::ostringstream cacheParams;
+    cacheParams << "search|" << threshold << "|" << limit << "|"
+                << detProbThreshold;
+    RecognitionCache::Key cacheKey =
+        RecognitionCache::makeKey(imageData, cacheParams.str());
+    uint64_t galleryVersion = cache.galleryVersion();
+    uint64_t perceptualHash = 0;
+    std::optional<std::string> cachedBody = cache.get(cacheKey);
+    if (!cachedBody && cache.isEnabled() && cache.getConfig().perceptual_hash) {
+      perceptualHash = computePerceptualHash(imageData);
+      cachedBody = cache.getSimilar(cacheKey.params, perceptualHash);
+    }
+    if (cachedBody) {
+      if (isApiLoggingEnabled()) {
+        PLOG_DEBUG << "[API] POST /v1/recognition/search - Cache hit";
+      }
+      MetricsInterceptor::callWithMetrics(
+          req,
+          createJsonBodyResponse(*cachedBody, "Content-Type, x-api-key", true),
+          std::move(callback));
+      return;
+    }
+
     // Get database and extract embedding from input image
     FaceDatabase &db = get_database();
 
-    // Decode image
-    cv::Mat image = cv::imdecode(imageData, cv::IMREAD_COLOR);
+    // Decode image (reduced scale for detection)
+    ScaledFaceImage scaled(imageData);
+    const cv::Mat &image = scaled.detectionImage();
     if (image.empty()) {
       callback(createErrorResponse(400, "Invalid request",
                                    "Failed to decode image"));
@@ -4999,19 +5178,17 @@ void RecognitionHandler::searchAppearanceSubject(
       response["result"] = Json::arrayValue;
       response["message"] = "No faces detected in the input image";
 
-      auto resp = HttpResponse::newHttpJsonResponse(response);
-      resp->setStatusCode(k200OK);
-      resp->addHeader("Access-Control-Allow-Origin", "*");
-      resp->addHeader("Access-Control-Allow-Methods", "POST, OPTIONS");
-      resp->addHeader("Access-Control-Allow-Headers",
-                      "Content-Type, x-api-key");
+      std::string body = serializeJsonBody(response);
+      auto resp =
+          createJsonBodyResponse(body, "Content-Type, x-api-key", false);
+      cache.put(cacheKey, std::move(body), galleryVersion, perceptualHash);
       MetricsInterceptor::callWithMetrics(req, resp, std::move(callback));
       return;
     }
 
     // Get aligned face and extract embedding (use lightweight augmentation:
     // original + horizontal flip) to make query embeddings more robust.
-    cv::Mat aligned_face = align_face_using_landmarks(image, faces, 0);
+    cv::Mat aligned_face = scaled.alignedFace(faces, 0);
     std::string onnx_path = db.get_onnx_model_path();
     if (onnx_path.empty()) {
       callback(createErrorResponse(500, "Internal server error",
@@ -5133,11 +5310,9 @@ void RecognitionHandler::searchAppearanceSubject(
     response["faces_found"] = static_cast<int>(matches.size());
     response["threshold"] = threshold;
 
-    auto resp = HttpResponse::newHttpJsonResponse(response);
-    resp->setStatusCode(k200OK);
-    resp->addHeader("Access-Control-Allow-Origin", "*");
-    resp->addHeader("Access-Control-Allow-Methods", "POST, OPTIONS");
-    resp->addHeader("Access-Control-Allow-Headers", "Content-Type, x-api-key");
+    std::string body = serializeJsonBody(response);
+    auto resp = createJsonBodyResponse(body, "Content-Type, x-api-key", false);
+    cache.put(cacheKey, std::move(body), galleryVersion, perceptualHash);
 
     auto end_time = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
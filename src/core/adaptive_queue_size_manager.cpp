@@ -1,4 +1,5 @@
 #include "core/adaptive_queue_size_manager.h"
+#include "core/queue_telemetry.h"
 #include <algorithm>
 #include <cmath>
 
@@ -63,15 +64,55 @@ void AdaptiveQueueSizeManager::updateSystemMetrics(
 
 void AdaptiveQueueSizeManager::updateInstanceMetrics(
     const std::string &instanceId, const InstanceMetrics &metrics) {
-  std::lock_guard<std::mutex> lock(instances_mutex_);
-  instance_metrics_[instanceId] = metrics;
-  instance_metrics_[instanceId].last_update = std::chrono::steady_clock::now();
+  {
+    std::lock_guard<std::mutex> lock(instances_mutex_);
+    instance_metrics_[instanceId] = metrics;
+    instance_metrics_[instanceId].last_update =
+        std::chrono::steady_clock::now();
+  }
 
   // Recalculate queue size when metrics update
+  // calculateQueueSize() takes instances_mutex_ itself - must not hold it here
   size_t new_size = calculateQueueSize(instanceId);
+
+  std::lock_guard<std::mutex> lock(instances_mutex_);
   current_queue_sizes_[instanceId] = new_size;
 }
 
+size_t
+AdaptiveQueueSizeManager::refreshFromTelemetry(const std::string &instanceId) {
+  if (!enabled_.load()) {
+    return getCurrentQueueSize(instanceId);
+  }
+
+  auto series = QueueTelemetry::getInstance().find(instanceId);
+  if (!series) {
+    return getCurrentQueueSize(instanceId);
+  }
+
+  QueueTelemetry::Summary summary = series->summarize(TELEMETRY_WINDOW_MS);
+  if (summary.samples == 0) {
+    return getCurrentQueueSize(instanceId); // Instance idle - keep size
+  }
+
+  InstanceMetrics metrics;
+  {
+    std::lock_guard<std::mutex> lock(instances_mutex_);
+    auto it = instance_metrics_.find(instanceId);
+    if (it != instance_metrics_.end()) {
+      metrics = it->second;
+    }
+  }
+  // Samples at/above high watermark and actual drops both count as queue
+  // full events
+  metrics.queue_full_frequency =
+      summary.full_per_second + summary.drops_per_second;
+  metrics.current_queue_size = summary.max_depth;
+
+  updateInstanceMetrics(instanceId, metrics);
+  return getCurrentQueueSize(instanceId);
+}
+
 size_t AdaptiveQueueSizeManager::getCurrentQueueSize(
     const std::string &instanceId) const {
   std::lock_guard<std::mutex> lock(instances_mutex_);
@@ -147,13 +147,14 @@ AICache::Stats AICache::getStats() const {
 
 std::string AICache::generateKey(const std::string &image_data,
                                  const std::string &config) {
-  // Generate SHA256 hash of image_data + config
-  std::string input = image_data + "|" + config;
-
+  // Generate SHA256 hash of image_data + "|" + config
+  // Feed the parts separately - concatenating would copy the whole image
   unsigned char hash[SHA256_DIGEST_LENGTH];
   SHA256_CTX sha256;
   SHA256_Init(&sha256);
-  SHA256_Update(&sha256, input.c_str(), input.length());
+  SHA256_Update(&sha256, image_data.data(), image_data.size());
+  SHA256_Update(&sha256, "|", 1);
+  SHA256_Update(&sha256, config.data(), config.size());
   SHA256_Final(hash, &sha256);
 
   std::stringstream ss;
@@ -0,0 +1,621 @@
+#include "core/async_log.h"
+#include "core/env_config.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr uint16_t PADDING = 0xFFFF; // Filler up to the end of the ring
+constexpr size_t MAX_FUNC = 256;
+constexpr size_t MAX_PENDING_LINE = 4096; // Unterminated stream text
+
+struct RecordHeader {
+  uint32_t size; // Whole record including header, multiple of 8
+  uint16_t sink;
+  uint16_t func_len;
+  int32_t severity;
+  uint32_t tid;
+  uint32_t line;
+  uint32_t message_len;
+  int64_t time_ns;
+};
+static_assert(sizeof(RecordHeader) == 32, "RecordHeader layout");
+
+size_t align8(size_t n) { return (n + 7) & ~static_cast<size_t>(7); }
+
+uint32_t currentTid() {
+  thread_local uint32_t tid = static_cast<uint32_t>(syscall(SYS_gettid));
+  return tid;
+}
+
+void writeFd(int fd, const char *data, size_t size) {
+  while (size > 0) {
+    ssize_t n = ::write(fd, data, size);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return;
+    }
+    data += n;
+    size -= static_cast<size_t>(n);
+  }
+}
+
+// Set once the calling thread's ThreadState is gone (thread exit)
+thread_local bool t_state_destroyed = false;
+
+} // namespace
+
+/**
+ * @brief Byte ring of one producer thread, drained by the writer
+ *
+ * Records are [RecordHeader][func][message] padded to 8 bytes and never
+ * wrap: if a record does not fit before the end of the buffer the producer
+ * skips to the start (with a PADDING header if there is room for one).
+ */
+class AsyncLogBackend::Ring {
+public:
+  explicit Ring(size_t capacity)
+      : capacity_(capacity), data_(new char[capacity]) {}
+
+  size_t capacity() const { return capacity_; }
+
+  // Largest record push() accepts
+  size_t maxRecord() const { return capacity_ / 2; }
+
+  size_t used() const {
+    return static_cast<size_t>(head_.load(std::memory_order_acquire) -
+                               tail_.load(std::memory_order_acquire));
+  }
+
+  /**
+   * @brief Queue a record, truncating the message to maxRecord()
+   * @return false if the ring is full
+   */
+  bool push(uint16_t sink, const Record &record, bool *truncated) {
+    RecordHeader header{};
+    header.sink = sink;
+    header.func_len =
+        static_cast<uint16_t>(std::min(record.func_len, MAX_FUNC));
+    size_t room = maxRecord() - sizeof(RecordHeader) - header.func_len;
+    size_t message_len = record.message_len;
+    if (message_len > room) {
+      message_len = room;
+      if (truncated) {
+        *truncated = true;
+      }
+    }
+    header.message_len = static_cast<uint32_t>(message_len);
+    header.severity = record.severity;
+    header.tid = record.tid;
+    header.line = record.line;
+    header.time_ns = record.time_ns;
+    header.size = static_cast<uint32_t>(
+        align8(sizeof(RecordHeader) + header.func_len + message_len));
+    return push(header, record.func, record.message);
+  }
+
+  // Consumer side (drain_mutex_ held)
+  template <typename Fn> void drain(Fn &&fn) {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    uint64_t head = head_.load(std::memory_order_acquire);
+    while (tail < head) {
+      size_t offset = static_cast<size_t>(tail % capacity_);
+      size_t contiguous = capacity_ - offset;
+      if (contiguous < sizeof(RecordHeader)) {
+        tail += contiguous;
+        continue;
+      }
+      RecordHeader header;
+      std::memcpy(&header, data_.get() + offset, sizeof(header));
+      if (header.sink != PADDING) {
+        const char *func = data_.get() + offset + sizeof(header);
+        fn(header, func, func + header.func_len);
+      }
+      tail += header.size;
+    }
+    tail_.store(tail, std::memory_order_release);
+  }
+
+  void close() { closed_.store(true, std::memory_order_release); }
+  bool closed() const { return closed_.load(std::memory_order_acquire); }
+
+private:
+  bool push(const RecordHeader &header, const char *func,
+            const char *message) {
+    size_t need = header.size;
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    uint64_t tail = tail_.load(std::memory_order_acquire);
+    size_t offset = static_cast<size_t>(head % capacity_);
+    size_t contiguous = capacity_ - offset;
+    size_t skip = contiguous < need ? contiguous : 0;
+    if (head + skip + need - tail > capacity_) {
+      return false;
+    }
+    if (skip >= sizeof(RecordHeader)) {
+      RecordHeader pad{};
+      pad.size = static_cast<uint32_t>(skip);
+      pad.sink = PADDING;
+      std::memcpy(data_.get() + offset, &pad, sizeof(pad));
+    }
+    char *p = data_.get() + (head + skip) % capacity_;
+    std::memcpy(p, &header, sizeof(header));
+    std::memcpy(p + sizeof(header), func, header.func_len);
+    std::memcpy(p + sizeof(header) + header.func_len, message,
+                header.message_len);
+    head_.store(head + skip + need, std::memory_order_release);
+    return true;
+  }
+
+  const size_t capacity_;
+  std::unique_ptr<char[]> data_;
+  alignas(64) std::atomic<uint64_t> head_{0}; // Producer
+  alignas(64) std::atomic<uint64_t> tail_{0}; // Consumer
+  std::atomic<bool> closed_{false};
+};
+
+struct AsyncLogBackend::ThreadState {
+  std::shared_ptr<Ring> ring;
+  std::string pending[2]; // Unterminated std::cout / std::cerr text
+
+  ~ThreadState() {
+    t_state_destroyed = true;
+    if (!ring) {
+      return;
+    }
+    for (uint16_t sink : {STDOUT, STDERR}) {
+      if (!pending[sink].empty()) {
+        Record record;
+        record.time_ns = AsyncLogBackend::nowNs();
+        record.tid = currentTid();
+        record.message = pending[sink].data();
+        record.message_len = pending[sink].size();
+        ring->push(sink, record, nullptr);
+      }
+    }
+    ring->close();
+  }
+};
+
+/**
+ * @brief streambuf behind std::cout/std::cerr: collects text per thread and
+ * logs each complete line (no put area, so every write lands here)
+ */
+class AsyncLogBackend::LineBuf : public std::streambuf {
+public:
+  LineBuf(AsyncLogBackend &backend, uint16_t sink)
+      : backend_(backend), sink_(sink) {}
+
+protected:
+  int_type overflow(int_type ch) override {
+    if (traits_type::eq_int_type(ch, traits_type::eof())) {
+      return traits_type::not_eof(ch);
+    }
+    char c = traits_type::to_char_type(ch);
+    append(&c, 1);
+    return ch;
+  }
+
+  std::streamsize xsputn(const char *s, std::streamsize n) override {
+    append(s, static_cast<size_t>(n));
+    return n;
+  }
+
+  // std::endl/std::flush: complete lines are already queued
+  int sync() override { return 0; }
+
+private:
+  void append(const char *s, size_t n) {
+    if (t_state_destroyed) {
+      backend_.write(sink_, s, n);
+      return;
+    }
+    std::string &pending = threadState()->pending[sink_];
+    pending.append(s, n);
+    if (std::memchr(s, '\n', n) != nullptr) {
+      size_t end = pending.rfind('\n') + 1;
+      backend_.write(sink_, pending.data(), end);
+      pending.erase(0, end);
+    } else if (pending.size() >= MAX_PENDING_LINE) {
+      backend_.write(sink_, pending.data(), pending.size());
+      pending.clear();
+    }
+  }
+
+  AsyncLogBackend &backend_;
+  uint16_t sink_;
+};
+
+AsyncLogBackend::AsyncLogBackend() {
+  addOutput("stdout",
+            [](const char *data, size_t size) { writeFd(1, data, size); });
+  addOutput("stderr",
+            [](const char *data, size_t size) { writeFd(2, data, size); });
+  addSink(nullptr, STDOUT);
+  addSink(nullptr, STDERR);
+}
+
+AsyncLogBackend::~AsyncLogBackend() { shutdown(); }
+
+int64_t AsyncLogBackend::nowNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+bool AsyncLogBackend::start() {
+  if (!EnvConfig::getBool("EDGE_AI_ASYNC_LOG", true)) {
+    return false;
+  }
+  Config config;
+  config.ring_bytes =
+      static_cast<size_t>(EnvConfig::getInt("EDGE_AI_LOG_RING_KB", 64, 4,
+                                            16384)) *
+      1024;
+  config.flush_interval = std::chrono::milliseconds(
+      EnvConfig::getInt("EDGE_AI_LOG_FLUSH_MS", 20, 1, 1000));
+  std::string policy = EnvConfig::getString("EDGE_AI_LOG_DROP_POLICY", "drop");
+  config.drop_policy =
+      policy == "block" ? DropPolicy::Block : DropPolicy::Drop;
+  start(config);
+  return true;
+}
+
+void AsyncLogBackend::start(const Config &config) {
+  std::lock_guard<std::mutex> lock(register_mutex_);
+  if (running_.load(std::memory_order_acquire)) {
+    return;
+  }
+  config_ = config;
+  size_t ring_bytes = 4096;
+  while (ring_bytes < config.ring_bytes) {
+    ring_bytes <<= 1;
+  }
+  config_.ring_bytes = ring_bytes;
+  stopping_.store(false);
+  writer_ = std::thread(&AsyncLogBackend::writerLoop, this);
+  running_.store(true, std::memory_order_release);
+}
+
+void AsyncLogBackend::shutdown() {
+  std::lock_guard<std::mutex> lock(register_mutex_);
+  if (!running_.load(std::memory_order_acquire)) {
+    return;
+  }
+  if (orig_cout_) {
+    std::cout.rdbuf(orig_cout_);
+    std::cerr.rdbuf(orig_cerr_);
+    std::clog.rdbuf(orig_clog_);
+    orig_cout_ = orig_cerr_ = orig_clog_ = nullptr;
+  }
+  running_.store(false, std::memory_order_release);
+  {
+    std::lock_guard<std::mutex> wake_lock(wake_mutex_);
+    stopping_.store(true);
+  }
+  wake_cv_.notify_all();
+  if (writer_.joinable()) {
+    writer_.join();
+  }
+  std::lock_guard<std::timed_mutex> drain_lock(drain_mutex_);
+  drainLocked();
+}
+
+void AsyncLogBackend::flush(std::chrono::milliseconds timeout) {
+  std::unique_lock<std::timed_mutex> lock(drain_mutex_, timeout);
+  if (lock.owns_lock()) {
+    drainLocked();
+  }
+}
+
+uint16_t AsyncLogBackend::addOutput(const std::string &name, Writer writer) {
+  std::lock_guard<std::mutex> lock(register_mutex_);
+  uint16_t id = output_count_.load(std::memory_order_relaxed);
+  if (id >= MAX_OUTPUTS) {
+    std::cerr << "[AsyncLog] Too many outputs, cannot add " << name
+              << std::endl;
+    return MAX_OUTPUTS;
+  }
+  outputs_[id] = std::make_unique<Output>();
+  outputs_[id]->name = name;
+  outputs_[id]->writer = std::move(writer);
+  output_count_.store(id + 1, std::memory_order_release);
+  return id;
+}
+
+uint16_t AsyncLogBackend::addSink(Formatter formatter, uint16_t output) {
+  std::lock_guard<std::mutex> lock(register_mutex_);
+  uint16_t id = sink_count_.load(std::memory_order_relaxed);
+  if (id >= MAX_SINKS || output >= output_count_.load()) {
+    std::cerr << "[AsyncLog] Cannot add sink for output " << output
+              << std::endl;
+    return MAX_SINKS;
+  }
+  sinks_[id] = std::make_unique<Sink>();
+  sinks_[id]->formatter = std::move(formatter);
+  sinks_[id]->output = output;
+  sink_count_.store(id + 1, std::memory_order_release);
+  return id;
+}
+
+AsyncLogBackend::ThreadState *AsyncLogBackend::threadState() {
+  thread_local ThreadState state;
+  return &state;
+}
+
+AsyncLogBackend::Ring *AsyncLogBackend::threadRing() {
+  ThreadState *state = threadState();
+  if (!state->ring) {
+    state->ring = std::make_shared<Ring>(config_.ring_bytes);
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    rings_.push_back(state->ring);
+  }
+  return state->ring.get();
+}
+
+bool AsyncLogBackend::log(uint16_t sink, const Record &record) {
+  if (!running_.load(std::memory_order_acquire) || t_state_destroyed) {
+    writeSync(sink, record);
+    return true;
+  }
+
+  Ring *ring = threadRing();
+  bool truncated = false;
+  bool pushed = ring->push(sink, record, &truncated);
+  if (!pushed && config_.drop_policy == DropPolicy::Block) {
+    blocked_.fetch_add(1, std::memory_order_relaxed);
+    while (!pushed && running_.load(std::memory_order_acquire)) {
+      wake_requested_.store(true, std::memory_order_relaxed);
+      wake_cv_.notify_one();
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+      pushed = ring->push(sink, record, &truncated);
+    }
+    if (!pushed) {
+      writeSync(sink, record); // Shut down while waiting
+      return true;
+    }
+  }
+  if (truncated) {
+    truncated_.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (!pushed) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    dropped_bytes_.fetch_add(record.message_len, std::memory_order_relaxed);
+    return false;
+  }
+
+  records_.fetch_add(1, std::memory_order_relaxed);
+  // Don't wait for the next tick once a ring is half full
+  if (ring->used() > ring->capacity() / 2 &&
+      !wake_requested_.exchange(true, std::memory_order_relaxed)) {
+    wake_cv_.notify_one();
+  }
+  return true;
+}
+
+bool AsyncLogBackend::write(uint16_t sink, const char *data, size_t size) {
+  Record record;
+  record.time_ns = nowNs();
+  record.tid = currentTid();
+  record.message = data;
+  record.message_len = size;
+  return log(sink, record);
+}
+
+void AsyncLogBackend::writeSync(uint16_t sink, const Record &record) {
+  if (sink >= sink_count_.load(std::memory_order_acquire)) {
+    return;
+  }
+  const Sink &target = *sinks_[sink];
+  std::string text;
+  if (target.formatter) {
+    target.formatter(record, text);
+  } else {
+    text.assign(record.message, record.message_len);
+  }
+  std::lock_guard<std::timed_mutex> lock(drain_mutex_);
+  outputs_[target.output]->writer(text.data(), text.size());
+}
+
+void AsyncLogBackend::redirectStdStreams() {
+  std::lock_guard<std::mutex> lock(register_mutex_);
+  if (orig_cout_ || !running_.load(std::memory_order_acquire)) {
+    return;
+  }
+  std::cout.flush();
+  std::cerr.flush();
+  if (!stdout_buf_) {
+    stdout_buf_ = std::make_unique<LineBuf>(*this, STDOUT);
+    stderr_buf_ = std::make_unique<LineBuf>(*this, STDERR);
+  }
+  orig_cout_ = std::cout.rdbuf(stdout_buf_.get());
+  orig_cerr_ = std::cerr.rdbuf(stderr_buf_.get());
+  orig_clog_ = std::clog.rdbuf(stderr_buf_.get());
+}
+
+void AsyncLogBackend::writerLoop() {
+  while (!stopping_.load()) {
+    {
+      std::unique_lock<std::mutex> lock(wake_mutex_);
+      wake_cv_.wait_for(lock, config_.flush_interval, [this]() {
+        return wake_requested_.load(std::memory_order_relaxed) ||
+               stopping_.load();
+      });
+    }
+    wake_requested_.store(false, std::memory_order_relaxed);
+    std::lock_guard<std::timed_mutex> lock(drain_mutex_);
+    drainLocked();
+  }
+}
+
+void AsyncLogBackend::drainLocked() {
+  std::vector<std::shared_ptr<Ring>> rings;
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    rings = rings_;
+  }
+
+  struct Item {
+    int64_t time_ns;
+    uint16_t sink;
+    int32_t severity;
+    uint32_t tid;
+    uint32_t line;
+    size_t func_offset;
+    size_t func_len;
+    size_t message_offset;
+    size_t message_len;
+  };
+  std::vector<Item> items;
+  std::string arena;
+  bool has_closed = false;
+  for (const auto &ring : rings) {
+    ring->drain([&](const RecordHeader &header, const char *func,
+                    const char *message) {
+      Item item;
+      item.time_ns = header.time_ns;
+      item.sink = header.sink;
+      item.severity = header.severity;
+      item.tid = header.tid;
+      item.line = header.line;
+      item.func_offset = arena.size();
+      item.func_len = header.func_len;
+      arena.append(func, header.func_len);
+      item.message_offset = arena.size();
+      item.message_len = header.message_len;
+      arena.append(message, header.message_len);
+      items.push_back(item);
+    });
+    has_closed = has_closed || ring->closed();
+  }
+
+  // Threads log independently; merge them back into time order
+  std::stable_sort(items.begin(), items.end(),
+                   [](const Item &a, const Item &b) {
+                     return a.time_ns < b.time_ns;
+                   });
+  uint16_t sink_count = sink_count_.load(std::memory_order_acquire);
+  for (const auto &item : items) {
+    if (item.sink >= sink_count) {
+      continue;
+    }
+    const Sink &sink = *sinks_[item.sink];
+    Output &output = *outputs_[sink.output];
+    if (!sink.formatter) {
+      output.batch.append(arena, item.message_offset, item.message_len);
+      continue;
+    }
+    Record record;
+    record.time_ns = item.time_ns;
+    record.severity = item.severity;
+    record.tid = item.tid;
+    record.line = item.line;
+    record.func = arena.data() + item.func_offset;
+    record.func_len = item.func_len;
+    record.message = arena.data() + item.message_offset;
+    record.message_len = item.message_len;
+    sink.formatter(record, output.batch);
+  }
+  flushOutputsLocked();
+
+  if (has_closed) {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    rings_.erase(std::remove_if(rings_.begin(), rings_.end(),
+                                [](const std::shared_ptr<Ring> &ring) {
+                                  return ring->closed() && ring->used() == 0;
+                                }),
+                 rings_.end());
+  }
+}
+
+void AsyncLogBackend::flushOutputsLocked() {
+  uint16_t output_count = output_count_.load(std::memory_order_acquire);
+  for (uint16_t i = 0; i < output_count; ++i) {
+    Output &output = *outputs_[i];
+    if (output.batch.empty()) {
+      continue;
+    }
+    output.writer(output.batch.data(), output.batch.size());
+    batches_.fetch_add(1, std::memory_order_relaxed);
+    bytes_written_.fetch_add(output.batch.size(), std::memory_order_relaxed);
+    output.batch.clear();
+    if (output.batch.capacity() > (1u << 20)) {
+      output.batch.shrink_to_fit(); // Don't keep a burst's buffer forever
+    }
+  }
+}
+
+AsyncLogBackend::Stats AsyncLogBackend::getStats() const {
+  Stats stats;
+  stats.records = records_.load(std::memory_order_relaxed);
+  stats.dropped = dropped_.load(std::memory_order_relaxed);
+  stats.dropped_bytes = dropped_bytes_.load(std::memory_order_relaxed);
+  stats.truncated = truncated_.load(std::memory_order_relaxed);
+  stats.blocked = blocked_.load(std::memory_order_relaxed);
+  stats.batches = batches_.load(std::memory_order_relaxed);
+  stats.bytes_written = bytes_written_.load(std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    stats.threads = rings_.size();
+  }
+  return stats;
+}
+
+Json::Value AsyncLogBackend::getStatsJson() const {
+  Stats stats = getStats();
+  Json::Value json;
+  json["running"] = isRunning();
+  json["records"] = static_cast<Json::UInt64>(stats.records);
+  json["dropped"] = static_cast<Json::UInt64>(stats.dropped);
+  json["droppedBytes"] = static_cast<Json::UInt64>(stats.dropped_bytes);
+  json["truncated"] = static_cast<Json::UInt64>(stats.truncated);
+  json["blocked"] = static_cast<Json::UInt64>(stats.blocked);
+  json["batches"] = static_cast<Json::UInt64>(stats.batches);
+  json["bytesWritten"] = static_cast<Json::UInt64>(stats.bytes_written);
+  json["threads"] = static_cast<Json::UInt64>(stats.threads);
+  return json;
+}
+
+std::string AsyncLogBackend::getPrometheusMetrics() const {
+  Stats stats = getStats();
+  std::ostringstream oss;
+
+  oss << "# HELP log_records_total Log records queued by producer threads\n";
+  oss << "# TYPE log_records_total counter\n";
+  oss << "log_records_total " << stats.records << "\n";
+  oss << "# HELP log_records_dropped_total Log records dropped because a "
+         "thread's ring buffer was full\n";
+  oss << "# TYPE log_records_dropped_total counter\n";
+  oss << "log_records_dropped_total " << stats.dropped << "\n";
+  oss << "# HELP log_dropped_bytes_total Message bytes of dropped records\n";
+  oss << "# TYPE log_dropped_bytes_total counter\n";
+  oss << "log_dropped_bytes_total " << stats.dropped_bytes << "\n";
+  oss << "# HELP log_records_truncated_total Records cut to fit a ring "
+         "buffer\n";
+  oss << "# TYPE log_records_truncated_total counter\n";
+  oss << "log_records_truncated_total " << stats.truncated << "\n";
+  oss << "# HELP log_producer_waits_total Times a producer waited for the "
+         "writer (block policy)\n";
+  oss << "# TYPE log_producer_waits_total counter\n";
+  oss << "log_producer_waits_total " << stats.blocked << "\n";
+  oss << "# HELP log_write_batches_total Batched writes issued by the log "
+         "writer\n";
+  oss << "# TYPE log_write_batches_total counter\n";
+  oss << "log_write_batches_total " << stats.batches << "\n";
+  oss << "# HELP log_written_bytes_total Bytes written by the log writer\n";
+  oss << "# TYPE log_written_bytes_total counter\n";
+  oss << "log_written_bytes_total " << stats.bytes_written << "\n";
+  oss << "# HELP log_producer_threads Threads with a log ring buffer\n";
+  oss << "# TYPE log_producer_threads gauge\n";
+  oss << "log_producer_threads " << stats.threads << "\n";
+
+  oss << "\n";
+  return oss.str();
+}
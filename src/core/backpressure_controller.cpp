@@ -5,373 +5,343 @@
 
 namespace BackpressureController {
 
-void BackpressureController::configure(const std::string &instanceId,
-                                       DropPolicy policy, double max_fps,
-                                       size_t max_queue_size) {
-  std::unique_lock<std::shared_mutex> config_lock(config_mutex_);
-  std::unique_lock<std::shared_mutex> stats_lock(stats_mutex_);
-
-  InstanceConfig &config = configs_[instanceId];
-  config.policy = policy;
-  double clamped_fps = std::clamp(max_fps, MIN_FPS, MAX_FPS);
-  config.max_fps.store(clamped_fps, std::memory_order_relaxed);
-  config.max_queue_size = max_queue_size;
-  int64_t interval_ms = static_cast<int64_t>(1000.0 / clamped_fps);
-  config.min_frame_interval_ms.store(interval_ms, std::memory_order_relaxed);
-  auto now = std::chrono::steady_clock::now();
-  config.setLastFrameTime(now);
-
-  // Initialize stats if not exists
-  if (stats_.find(instanceId) == stats_.end()) {
-    BackpressureStats &stats = stats_[instanceId];
-    stats.target_fps.store(clamped_fps);
-    stats.current_fps.store(0.0);
+using Controller = BackpressureController;
+
+// ========== InstanceControl ==========
+
+InstanceControl::InstanceControl(
+    const std::string &instanceId,
+    std::shared_ptr<QueueTelemetry::InstanceSeries> telemetry)
+    : instance_id_(instanceId), telemetry_(std::move(telemetry)) {}
+
+int64_t InstanceControl::nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void InstanceControl::configure(DropPolicy policy, double max_fps,
+                                size_t max_queue_size) {
+  double clamped_fps = std::clamp(max_fps, Controller::MIN_FPS,
+                                  Controller::MAX_FPS);
+  policy_.store(policy, std::memory_order_relaxed);
+  max_fps_.store(clamped_fps, std::memory_order_relaxed);
+  setMaxQueueSize(max_queue_size);
+  setTargetFPS(clamped_fps);
+}
+
+void InstanceControl::setMaxQueueSize(size_t max_queue_size) {
+  max_queue_size_.store(max_queue_size, std::memory_order_relaxed);
+  if (telemetry_) {
+    telemetry_->setQueueCapacity(max_queue_size);
   }
 }
 
-bool BackpressureController::shouldDropFrame(const std::string &instanceId) {
-  // OPTIMIZATION: Lock-free fast path using shared_lock for concurrent reads
-  // This eliminates mutex contention in the hot path (called every frame)
+void InstanceControl::setTargetFPS(double fps) {
+  target_fps_.store(fps, std::memory_order_relaxed);
+  min_frame_interval_ns_.store(static_cast<int64_t>(1e9 / fps),
+                               std::memory_order_relaxed);
+}
 
-  InstanceConfig *config = nullptr;
-  {
-    // Use shared_lock for read-only access (allows concurrent readers)
-    std::shared_lock<std::shared_mutex> read_lock(config_mutex_);
-    auto configIt = configs_.find(instanceId);
-    if (configIt == configs_.end()) {
-      return false; // Not configured, don't drop
-    }
-    config = &configIt->second;
-
-    // Lock stats for read access
-    std::shared_lock<std::shared_mutex> stats_lock(stats_mutex_);
-
-    // PHASE 1: Check queue size first (queue-based dropping)
-    // This allows dropping frames when queue is full even if FPS limit not
-    // reached
-    auto statsIt = stats_.find(instanceId);
-    if (statsIt != stats_.end()) {
-      size_t current_queue_size =
-          statsIt->second.current_queue_size.load(std::memory_order_relaxed);
-      size_t max_queue_size = config->max_queue_size;
-
-      // CRITICAL: Drop frames more aggressively when queue is getting full
-      // Use lower threshold (50%) to prevent queue overflow and maintain real-time processing
-      // This is especially important when RTMP output node is slow or blocking
-      const double queue_drop_threshold = 0.5; // 50% of max queue size (reduced from 80%)
-      size_t drop_threshold =
-          static_cast<size_t>(max_queue_size * queue_drop_threshold);
-
-      // Also drop if queue size is very high (>= 40 frames) regardless of max_queue_size
-      // This handles cases where SDK queue size (51) exceeds configured max_queue_size
-      if (current_queue_size >= drop_threshold || current_queue_size >= 40) {
-        // Queue is getting full - drop this frame to prevent overflow
-        // Log occasionally to avoid performance impact (every 100th drop)
-        static thread_local std::unordered_map<std::string, uint64_t> drop_log_counter;
-        auto &counter = drop_log_counter[instanceId];
-        counter++;
-        if (counter % 100 == 1) {
-          std::cerr << "[BackpressureController] Dropping frame for instance "
-                    << instanceId << " (queue_size=" << current_queue_size
-                    << ", threshold=" << drop_threshold << ")" << std::endl;
-        }
-        return true;
-      }
-    }
+size_t InstanceControl::currentQueueDepth() const {
+  // Prefer the deepest node queue from telemetry; updateQueueSize() only
+  // keeps the last value reported by any node
+  if (telemetry_ && telemetry_->nodeCount() > 0) {
+    return telemetry_->currentMaxDepth();
+  }
+  return current_queue_size_.load(std::memory_order_relaxed);
+}
 
-    // PHASE 2: Check FPS limiting (time-based dropping)
-    // Read atomic values while holding shared lock (safe)
-    // The lock ensures config pointer is valid
-    auto now = std::chrono::steady_clock::now();
-    auto last_frame_time = config->getLastFrameTime();
-    int64_t min_interval_ms =
-        config->min_frame_interval_ms.load(std::memory_order_relaxed);
-
-    // Check FPS limiting using atomic values
-    auto time_since_last =
-        std::chrono::duration_cast<std::chrono::milliseconds>(now -
-                                                              last_frame_time);
-
-    if (time_since_last.count() < min_interval_ms) {
-      // Frame too soon - drop based on policy
-      // For DROP_NEWEST (default), drop this new frame
-      return true;
+bool InstanceControl::shouldDropFrame() {
+  // PHASE 1: Check queue size first (queue-based dropping)
+  // This allows dropping frames when queue is full even if FPS limit not
+  // reached
+  size_t current_queue_size = currentQueueDepth();
+  size_t max_queue_size = max_queue_size_.load(std::memory_order_relaxed);
+
+  // CRITICAL: Drop frames more aggressively when queue is getting full
+  // Use lower threshold (50%) to prevent queue overflow and maintain
+  // real-time processing. This is especially important when RTMP output node
+  // is slow or blocking
+  size_t drop_threshold = max_queue_size / 2;
+
+  // Also drop if queue size is very high (>= 40 frames) regardless of
+  // max_queue_size. This handles cases where SDK queue size (51) exceeds
+  // configured max_queue_size
+  if (current_queue_size >= drop_threshold || current_queue_size >= 40) {
+    // Log occasionally to avoid performance impact (every 100th drop)
+    if (drop_log_counter_.fetch_add(1, std::memory_order_relaxed) % 100 == 0) {
+      std::cerr << "[BackpressureController] Dropping frame for instance "
+                << instance_id_ << " (queue_size=" << current_queue_size
+                << ", threshold=" << drop_threshold << ")" << std::endl;
     }
+    return true;
+  }
+
+  // PHASE 2: Check FPS limiting (time-based dropping)
+  int64_t now = nowNs();
+  int64_t min_interval =
+      min_frame_interval_ns_.load(std::memory_order_relaxed);
+  int64_t last = last_frame_time_ns_.load(std::memory_order_relaxed);
+  if (now - last < min_interval) {
+    // Frame too soon - drop this new frame
+    return true;
+  }
+  // CAS so that only one of several concurrent callers takes the slot
+  return !last_frame_time_ns_.compare_exchange_strong(
+      last, now, std::memory_order_relaxed);
+}
 
-    // Update last frame time atomically (lock-free, safe even after lock
-    // release)
-    config->setLastFrameTime(now);
+void InstanceControl::recordFrameProcessed() {
+  frames_processed_.fetch_add(1, std::memory_order_relaxed);
+  int64_t now = nowNs();
+  last_processed_ns_.store(now, std::memory_order_relaxed);
+
+  // Update current FPS once per second
+  uint64_t frames =
+      fps_window_frames_.fetch_add(1, std::memory_order_relaxed) + 1;
+  int64_t window_start = fps_window_start_ns_.load(std::memory_order_relaxed);
+  if (window_start == 0) {
+    fps_window_start_ns_.compare_exchange_strong(window_start, now,
+                                                 std::memory_order_relaxed);
+  } else if (now - window_start >= 1000000000 &&
+             fps_window_start_ns_.compare_exchange_strong(
+                 window_start, now, std::memory_order_relaxed)) {
+    fps_window_frames_.fetch_sub(frames, std::memory_order_relaxed);
+    double fps = frames * 1e9 / static_cast<double>(now - window_start);
+    current_fps_.store(std::round(fps), std::memory_order_relaxed);
   }
-  // Lock released - atomic operations are safe without lock
 
-  return false;
+  updateAdaptiveFPS();
 }
 
-void BackpressureController::recordFrameProcessed(
-    const std::string &instanceId) {
-  bool should_update_adaptive_fps = false;
-  {
-    std::shared_lock<std::shared_mutex> lock(stats_mutex_);
-    auto it = stats_.find(instanceId);
-    if (it == stats_.end()) {
-      return;
-    }
-    auto &stats = it->second;
-    stats.frames_processed.fetch_add(1, std::memory_order_relaxed);
-
-    auto now = std::chrono::steady_clock::now();
-    stats.last_processed_time = now;
-
-    // Update current FPS (simple moving average)
-    // Calculate FPS based on time since last processed frame
-    static thread_local std::unordered_map<
-        std::string, std::chrono::steady_clock::time_point>
-        last_fps_update;
-    static thread_local std::unordered_map<std::string, uint64_t>
-        frame_count_since_update;
-
-    auto &last_update = last_fps_update[instanceId];
-    auto &frame_count = frame_count_since_update[instanceId];
-
-    frame_count++;
-    auto elapsed =
-        std::chrono::duration_cast<std::chrono::milliseconds>(now - last_update)
-            .count();
-
-    if (elapsed >= 1000) { // Update FPS every second
-      double fps = (frame_count * 1000.0) / elapsed;
-      stats.current_fps.store(std::round(fps), std::memory_order_relaxed);
-      frame_count = 0;
-      last_update = now;
+void InstanceControl::recordFrameDropped() {
+  frames_dropped_.fetch_add(1, std::memory_order_relaxed);
+  last_drop_ns_.store(nowNs(), std::memory_order_relaxed);
+}
+
+void InstanceControl::recordQueueFull() {
+  queue_full_count_.fetch_add(1, std::memory_order_relaxed);
+  backpressure_detected_.store(true, std::memory_order_relaxed);
+  updateAdaptiveFPS();
+}
+
+void InstanceControl::updateAdaptiveFPS() {
+  // Only update adaptive FPS if policy is ADAPTIVE_FPS
+  if (policy_.load(std::memory_order_relaxed) != DropPolicy::ADAPTIVE_FPS) {
+    return;
+  }
+
+  int64_t now = nowNs();
+  int64_t last = last_control_ns_.load(std::memory_order_relaxed);
+  int64_t interval_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          Controller::ADAPTIVE_UPDATE_INTERVAL)
+          .count();
+  if (last != 0 && now - last < interval_ns) {
+    return; // Too soon to update
+  }
+  // Skip instead of blocking if another thread is running the step
+  if (control_busy_.exchange(true, std::memory_order_acquire)) {
+    return;
+  }
+  last = last_control_ns_.load(std::memory_order_relaxed);
+  if (last == 0 || now - last >= interval_ns) {
+    last_control_ns_.store(now, std::memory_order_relaxed);
+    double dt = last == 0 ? Controller::ADAPTIVE_UPDATE_INTERVAL.count() / 1000.0
+                          : (now - last) / 1e9;
+
+    size_t max_queue_size =
+        std::max<size_t>(1, max_queue_size_.load(std::memory_order_relaxed));
+    double occupancy =
+        static_cast<double>(currentQueueDepth()) / max_queue_size;
+    // A queue full event since the last step counts as a full queue even if
+    // it drained before this sample
+    uint64_t queue_full = queue_full_count_.load(std::memory_order_relaxed);
+    if (queue_full != last_queue_full_seen_ ||
+        (telemetry_ && telemetry_->isOverloaded())) {
+      occupancy = std::max(occupancy, 1.0);
     }
+    last_queue_full_seen_ = queue_full;
+    applyControlStep(occupancy, dt);
+  }
+  control_busy_.store(false, std::memory_order_release);
+}
+
+double InstanceControl::applyControlStep(double occupancy, double dt_seconds) {
+  occupancy = std::clamp(occupancy, 0.0, 2.0);
+  smoothed_occupancy_ +=
+      Controller::OCCUPANCY_SMOOTHING * (occupancy - smoothed_occupancy_);
+
+  // Velocity form: the integral lives in target_fps itself, so there is no
+  // separate integrator to wind up while the output sits at a limit
+  double error = Controller::OCCUPANCY_SETPOINT - smoothed_occupancy_;
+  double max_fps = max_fps_.load(std::memory_order_relaxed);
+  double delta = (Controller::CONTROL_KP * (error - previous_error_) +
+                  Controller::CONTROL_KI * error * dt_seconds) *
+                 max_fps;
+  previous_error_ = error;
+
+  double max_step = Controller::MAX_STEP_FRACTION * max_fps;
+  delta = std::clamp(delta, -max_step, max_step);
+  double target = std::clamp(target_fps_.load(std::memory_order_relaxed) + delta,
+                             std::min(Controller::MIN_FPS, max_fps), max_fps);
+  setTargetFPS(target);
+
+  backpressure_detected_.store(error < 0, std::memory_order_relaxed);
+  return target;
+}
+
+void InstanceControl::resetStats() {
+  frames_dropped_.store(0, std::memory_order_relaxed);
+  frames_processed_.store(0, std::memory_order_relaxed);
+  queue_full_count_.store(0, std::memory_order_relaxed);
+  current_fps_.store(0.0, std::memory_order_relaxed);
+  backpressure_detected_.store(false, std::memory_order_relaxed);
+}
 
-    // Update adaptive FPS periodically (but not on every frame to avoid lock
-    // contention) Only update every N frames or use try_lock to avoid blocking
-    static thread_local std::unordered_map<std::string, uint64_t>
-        adaptive_update_counter;
-    auto &counter = adaptive_update_counter[instanceId];
-    counter++;
-
-    // Only call updateAdaptiveFPS every 60 frames (~1 second at 60 FPS, ~0.5s
-    // at 120 FPS) This reduces lock contention significantly while maintaining
-    // responsiveness Increased from 30 to 60 to handle higher FPS better
-    if (counter >= 60) {
-      counter = 0;
-      should_update_adaptive_fps = true;
+// ========== BackpressureController ==========
+
+InstanceHandle
+BackpressureController::registerInstance(const std::string &instanceId,
+                                         DropPolicy policy, double max_fps,
+                                         size_t max_queue_size) {
+  InstanceHandle handle;
+  {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto &slot = handles_[instanceId];
+    if (!slot) {
+      slot = std::make_shared<InstanceControl>(
+          instanceId, QueueTelemetry::getInstance().getOrCreate(instanceId));
     }
+    handle = slot;
   }
-  // Lock released - now safe to call updateAdaptiveFPS which needs unique_lock
-  if (should_update_adaptive_fps) {
-    updateAdaptiveFPS(instanceId);
+  handle->configure(policy, max_fps, max_queue_size);
+  return handle;
+}
+
+InstanceHandle
+BackpressureController::getHandle(const std::string &instanceId) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto it = handles_.find(instanceId);
+  if (it != handles_.end()) {
+    return it->second;
+  }
+  return nullptr;
+}
+
+void BackpressureController::unregisterInstance(const std::string &instanceId) {
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  handles_.erase(instanceId);
+}
+
+bool BackpressureController::shouldDropFrame(const std::string &instanceId) {
+  auto handle = getHandle(instanceId);
+  return handle ? handle->shouldDropFrame() : false; // Not configured
+}
+
+void BackpressureController::recordFrameProcessed(
+    const std::string &instanceId) {
+  if (auto handle = getHandle(instanceId)) {
+    handle->recordFrameProcessed();
   }
 }
 
 void BackpressureController::recordFrameDropped(const std::string &instanceId) {
-  std::shared_lock<std::shared_mutex> lock(stats_mutex_);
-  auto it = stats_.find(instanceId);
-  if (it == stats_.end()) {
-    return;
+  if (auto handle = getHandle(instanceId)) {
+    handle->recordFrameDropped();
   }
-  auto &stats = it->second;
-  stats.frames_dropped.fetch_add(1, std::memory_order_relaxed);
-  stats.last_drop_time = std::chrono::steady_clock::now();
 }
 
 void BackpressureController::recordQueueFull(const std::string &instanceId) {
-  bool should_update_adaptive_fps = false;
-  {
-    std::shared_lock<std::shared_mutex> lock(stats_mutex_);
-    auto it = stats_.find(instanceId);
-    if (it == stats_.end()) {
-      return;
-    }
-    auto &stats = it->second;
-    stats.queue_full_count.fetch_add(1, std::memory_order_relaxed);
-    stats.backpressure_detected.store(true, std::memory_order_relaxed);
-    should_update_adaptive_fps = true;
-  }
-  // Lock released - now safe to call updateAdaptiveFPS which needs unique_lock
-  if (should_update_adaptive_fps) {
-    updateAdaptiveFPS(instanceId);
+  if (auto handle = getHandle(instanceId)) {
+    handle->recordQueueFull();
   }
 }
 
 void BackpressureController::updateQueueSize(const std::string &instanceId,
                                              size_t queue_size) {
-  std::shared_lock<std::shared_mutex> lock(stats_mutex_);
-  auto it = stats_.find(instanceId);
-  if (it == stats_.end()) {
-    return;
+  if (auto handle = getHandle(instanceId)) {
+    handle->updateQueueSize(queue_size);
   }
-  auto &stats = it->second;
-  stats.current_queue_size.store(queue_size, std::memory_order_relaxed);
 }
 
 double
 BackpressureController::getCurrentFPS(const std::string &instanceId) const {
-  std::shared_lock<std::shared_mutex> lock(stats_mutex_);
-  auto it = stats_.find(instanceId);
-  if (it != stats_.end()) {
-    return it->second.current_fps.load(std::memory_order_relaxed);
-  }
-  return 0.0;
+  auto handle = getHandle(instanceId);
+  return handle ? handle->getCurrentFPS() : 0.0;
 }
 
 double
 BackpressureController::getTargetFPS(const std::string &instanceId) const {
-  std::shared_lock<std::shared_mutex> lock(stats_mutex_);
-  auto it = stats_.find(instanceId);
-  if (it != stats_.end()) {
-    return it->second.target_fps.load(std::memory_order_relaxed);
-  }
-  return 30.0; // Default
+  auto handle = getHandle(instanceId);
+  return handle ? handle->getTargetFPS() : 30.0; // Default
 }
 
 bool BackpressureController::isBackpressureDetected(
     const std::string &instanceId) const {
-  std::shared_lock<std::shared_mutex> lock(stats_mutex_);
-  auto it = stats_.find(instanceId);
-  if (it != stats_.end()) {
-    return it->second.backpressure_detected.load(std::memory_order_relaxed);
-  }
-  return false;
+  auto handle = getHandle(instanceId);
+  return handle ? handle->isBackpressureDetected() : false;
+}
+
+BackpressureController::BackpressureStatsSnapshot
+BackpressureController::getStats(const InstanceControl &control) {
+  auto toTimePoint = [](int64_t ns) {
+    return std::chrono::steady_clock::time_point(
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::nanoseconds(ns)));
+  };
+
+  BackpressureStatsSnapshot snapshot;
+  snapshot.frames_dropped =
+      control.frames_dropped_.load(std::memory_order_relaxed);
+  snapshot.frames_processed =
+      control.frames_processed_.load(std::memory_order_relaxed);
+  snapshot.queue_full_count =
+      control.queue_full_count_.load(std::memory_order_relaxed);
+  snapshot.current_fps = control.getCurrentFPS();
+  snapshot.target_fps = control.getTargetFPS();
+  snapshot.backpressure_detected = control.isBackpressureDetected();
+  snapshot.current_queue_size = control.currentQueueDepth();
+  snapshot.last_drop_time =
+      toTimePoint(control.last_drop_ns_.load(std::memory_order_relaxed));
+  snapshot.last_processed_time =
+      toTimePoint(control.last_processed_ns_.load(std::memory_order_relaxed));
+  return snapshot;
 }
 
 BackpressureController::BackpressureStatsSnapshot
 BackpressureController::getStats(const std::string &instanceId) const {
-  std::shared_lock<std::shared_mutex> lock(stats_mutex_);
-  auto it = stats_.find(instanceId);
-  if (it != stats_.end()) {
-    const BackpressureStats &stats = it->second;
-    BackpressureStatsSnapshot snapshot;
-    snapshot.frames_dropped =
-        stats.frames_dropped.load(std::memory_order_relaxed);
-    snapshot.frames_processed =
-        stats.frames_processed.load(std::memory_order_relaxed);
-    snapshot.queue_full_count =
-        stats.queue_full_count.load(std::memory_order_relaxed);
-    snapshot.current_fps = stats.current_fps.load(std::memory_order_relaxed);
-    snapshot.target_fps = stats.target_fps.load(std::memory_order_relaxed);
-    snapshot.backpressure_detected =
-        stats.backpressure_detected.load(std::memory_order_relaxed);
-    snapshot.current_queue_size =
-        stats.current_queue_size.load(std::memory_order_relaxed);
-    snapshot.last_drop_time = stats.last_drop_time;
-    snapshot.last_processed_time = stats.last_processed_time;
-    return snapshot;
+  auto handle = getHandle(instanceId);
+  if (handle) {
+    return getStats(*handle);
   }
   return BackpressureStatsSnapshot{};
 }
 
 void BackpressureController::resetStats(const std::string &instanceId) {
-  std::unique_lock<std::shared_mutex> lock(stats_mutex_);
-  auto it = stats_.find(instanceId);
-  if (it != stats_.end()) {
-    BackpressureStats &stats = it->second;
-    stats.frames_dropped.store(0);
-    stats.frames_processed.store(0);
-    stats.queue_full_count.store(0);
-    stats.current_fps.store(0.0);
-    stats.backpressure_detected.store(false);
+  if (auto handle = getHandle(instanceId)) {
+    handle->resetStats();
   }
 }
 
 void BackpressureController::updateAdaptiveFPS(const std::string &instanceId) {
-  // Use try_lock to avoid blocking if another thread is updating
-  // This prevents lock contention from blocking frame processing
-  std::unique_lock<std::shared_mutex> lock(stats_mutex_, std::try_to_lock);
-  if (!lock.owns_lock()) {
-    // Another thread is updating, skip this update
-    return;
-  }
-
-  // Acquire shared lock on config_mutex_ before accessing configs_
-  // This prevents data race when configure() is called concurrently
-  std::shared_lock<std::shared_mutex> config_lock(config_mutex_);
-  auto configIt = configs_.find(instanceId);
-  if (configIt == configs_.end()) {
-    return; // Not configured
-  }
-
-  auto statsIt = stats_.find(instanceId);
-  if (statsIt == stats_.end()) {
-    return;
-  }
-
-  InstanceConfig &config = configIt->second;
-  BackpressureStats &stats = statsIt->second;
-
-  // Only update adaptive FPS if policy is ADAPTIVE_FPS
-  if (config.policy != DropPolicy::ADAPTIVE_FPS) {
-    return;
-  }
-
-  static thread_local std::unordered_map<std::string,
-                                         std::chrono::steady_clock::time_point>
-      last_adaptive_update;
-  auto now = std::chrono::steady_clock::now();
-  auto &last_update = last_adaptive_update[instanceId];
-
-  auto elapsed =
-      std::chrono::duration_cast<std::chrono::milliseconds>(now - last_update);
-  if (elapsed < ADAPTIVE_UPDATE_INTERVAL) {
-    return; // Too soon to update
-  }
-
-  last_update = now;
-
-  double current_target = stats.target_fps.load(std::memory_order_relaxed);
-  bool backpressure =
-      stats.backpressure_detected.load(std::memory_order_relaxed);
-  uint64_t queue_full = stats.queue_full_count.load(std::memory_order_relaxed);
-
-  // If backpressure detected or queue full events, reduce FPS
-  if (backpressure || queue_full > 0) {
-    double new_target = current_target * FPS_REDUCTION_FACTOR;
-    new_target = std::max(new_target, MIN_FPS);
-    stats.target_fps.store(new_target, std::memory_order_relaxed);
-
-    // Update config atomically (lock-free for hot path reads)
-    config.max_fps.store(new_target, std::memory_order_relaxed);
-    int64_t interval_ms = static_cast<int64_t>(1000.0 / new_target);
-    config.min_frame_interval_ms.store(interval_ms, std::memory_order_relaxed);
-
-    // Reset backpressure flag after reducing FPS
-    stats.backpressure_detected.store(false, std::memory_order_relaxed);
-  } else {
-    // No backpressure - gradually increase FPS
-    double new_target = current_target * FPS_INCREASE_FACTOR;
-    double max_fps_value = config.max_fps.load(std::memory_order_relaxed);
-    new_target = std::min(new_target, max_fps_value);
-    new_target = std::min(new_target, MAX_FPS);
-
-    if (new_target > current_target) {
-      stats.target_fps.store(new_target, std::memory_order_relaxed);
-      config.max_fps.store(new_target, std::memory_order_relaxed);
-      int64_t interval_ms = static_cast<int64_t>(1000.0 / new_target);
-      config.min_frame_interval_ms.store(interval_ms,
-                                         std::memory_order_relaxed);
-    }
+  if (auto handle = getHandle(instanceId)) {
+    handle->updateAdaptiveFPS();
   }
 }
 
 void BackpressureController::updateQueueSizeConfig(
     const std::string &instanceId, size_t new_queue_size) {
-  std::unique_lock<std::shared_mutex> config_lock(config_mutex_);
-  auto configIt = configs_.find(instanceId);
-  if (configIt != configs_.end()) {
-    configIt->second.max_queue_size = new_queue_size;
+  if (auto handle = getHandle(instanceId)) {
+    handle->setMaxQueueSize(new_queue_size);
   }
 }
 
 size_t
 BackpressureController::getMaxQueueSize(const std::string &instanceId) const {
-  std::shared_lock<std::shared_mutex> read_lock(config_mutex_);
-  auto configIt = configs_.find(instanceId);
-  if (configIt != configs_.end()) {
-    return configIt->second.max_queue_size;
-  }
-  return 20; // Default
+  auto handle = getHandle(instanceId);
+  return handle ? handle->getMaxQueueSize() : 20; // Default
 }
 
 } // namespace BackpressureController
@@ -1,6 +1,8 @@
 #include "core/log_manager.h"
 #include "core/env_config.h"
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <ctime>
 #include <filesystem>
 #include <future>
@@ -17,19 +19,87 @@ std::string LogManager::base_dir_ = "./logs";
 int LogManager::max_disk_usage_percent_ = 85;
 int LogManager::cleanup_interval_hours_ = 24;
 
-std::unique_ptr<plog::RollingFileAppender<plog::TxtFormatter>>
-    LogManager::api_appender_;
-std::unique_ptr<plog::RollingFileAppender<plog::TxtFormatter>>
-    LogManager::instance_appender_;
-std::unique_ptr<plog::RollingFileAppender<plog::TxtFormatter>>
-    LogManager::sdk_output_appender_;
-std::unique_ptr<plog::RollingFileAppender<plog::TxtFormatter>>
-    LogManager::general_appender_;
+std::unique_ptr<AsyncPlogAppender> LogManager::api_appender_;
+std::unique_ptr<AsyncPlogAppender> LogManager::instance_appender_;
+std::unique_ptr<AsyncPlogAppender> LogManager::sdk_output_appender_;
+std::unique_ptr<AsyncPlogAppender> LogManager::general_appender_;
+std::unique_ptr<AsyncPlogAppender> LogManager::console_appender_;
 
 std::unique_ptr<std::thread> LogManager::cleanup_thread_;
 std::atomic<bool> LogManager::cleanup_running_{false};
 std::mutex LogManager::cleanup_mutex_;
 
+AsyncPlogAppender::AsyncPlogAppender(uint16_t output)
+    : sink_(AsyncLogBackend::getInstance().addSink(formatTxt, output)) {}
+
+AsyncPlogAppender::AsyncPlogAppender(const std::string &name,
+                                     std::unique_ptr<plog::IAppender> target)
+    : target_(std::move(target)) {
+  plog::IAppender *appender = target_.get();
+  uint16_t output = AsyncLogBackend::getInstance().addOutput(
+      name, [appender](const char *data, size_t size) {
+        // One record carries the whole batch; PreformattedFormatter writes
+        // it unchanged
+        plog::Record batch(plog::none, "", 0, "", nullptr, 0);
+        batch << std::string(data, size);
+        appender->write(batch);
+      });
+  sink_ = AsyncLogBackend::getInstance().addSink(formatTxt, output);
+}
+
+void AsyncPlogAppender::write(const plog::Record &record) {
+  const plog::util::Time &time = record.getTime();
+  AsyncLogBackend::Record entry;
+  entry.time_ns = static_cast<int64_t>(time.time) * 1000000000LL +
+                  static_cast<int64_t>(time.millitm) * 1000000LL;
+  entry.severity = static_cast<int>(record.getSeverity());
+  entry.tid = static_cast<uint32_t>(record.getTid());
+  entry.line = static_cast<uint32_t>(record.getLine());
+  entry.func = record.getFunc();
+  entry.func_len = std::strlen(entry.func);
+  entry.message = record.getMessage();
+  entry.message_len = std::strlen(entry.message);
+  AsyncLogBackend::getInstance().log(sink_, entry);
+}
+
+void AsyncPlogAppender::formatTxt(const AsyncLogBackend::Record &record,
+                                  std::string &out) {
+  time_t seconds = static_cast<time_t>(record.time_ns / 1000000000LL);
+  int millis = static_cast<int>((record.time_ns / 1000000LL) % 1000);
+  struct tm t;
+  localtime_r(&seconds, &t);
+  char prefix[64];
+  std::snprintf(
+      prefix, sizeof(prefix), "%04d-%02d-%02d %02d:%02d:%02d.%03d %-5s ",
+      t.tm_year + 1900, t.tm_mon + 1, t.tm_mday, t.tm_hour, t.tm_min,
+      t.tm_sec, millis,
+      plog::severityToString(static_cast<plog::Severity>(record.severity)));
+  out += prefix;
+  out += '[';
+  out += std::to_string(record.tid);
+  out += "] [";
+  out.append(record.func, record.func_len);
+  out += '@';
+  out += std::to_string(record.line);
+  out += "] ";
+  out.append(record.message, record.message_len);
+  out += '\n';
+}
+
+std::unique_ptr<AsyncPlogAppender>
+LogManager::makeFileAppender(Category category, const std::string &path) {
+  // Max file size: 50MB per file
+  size_t max_file_size = 50 * 1024 * 1024;
+  // Max files: 0 = unlimited (we handle cleanup manually)
+  int max_files = 0;
+  static const char *names[] = {"log.api", "log.instance", "log.sdk_output",
+                                "log.general"};
+  return std::make_unique<AsyncPlogAppender>(
+      names[static_cast<int>(category)],
+      std::make_unique<plog::RollingFileAppender<PreformattedFormatter>>(
+          path.c_str(), max_file_size, max_files));
+}
+
 void LogManager::init(const std::string &base_dir, int max_disk_usage_percent,
                       int cleanup_interval_hours) {
   std::lock_guard<std::mutex> lock(cleanup_mutex_);
@@ -53,47 +123,36 @@ void LogManager::init(const std::string &base_dir, int max_disk_usage_percent,
   // Get today's date string
   std::string date_str = getDateString();
 
-  // Max file size: 50MB per file
-  size_t max_file_size = 50 * 1024 * 1024;
-  // Max files: 0 = unlimited (we handle cleanup manually)
-  int max_files = 0;
-
   // Initialize appenders for each category
   // Only create appenders if their respective logging flags are enabled
-  if (isApiLoggingEnabled()) {
-    std::string api_log_path = getLogFilePath(Category::API, date_str);
-    api_appender_ =
-        std::make_unique<plog::RollingFileAppender<plog::TxtFormatter>>(
-            api_log_path.c_str(), max_file_size, max_files);
+  // Appenders register outputs on the async log backend, so create each
+  // one only once
+  if (isApiLoggingEnabled() && !api_appender_) {
+    api_appender_ = makeFileAppender(Category::API,
+                                     getLogFilePath(Category::API, date_str));
   }
 
-  if (isInstanceLoggingEnabled()) {
-    std::string instance_log_path =
-        getLogFilePath(Category::INSTANCE, date_str);
-    instance_appender_ =
-        std::make_unique<plog::RollingFileAppender<plog::TxtFormatter>>(
-            instance_log_path.c_str(), max_file_size, max_files);
+  if (isInstanceLoggingEnabled() && !instance_appender_) {
+    instance_appender_ = makeFileAppender(
+        Category::INSTANCE, getLogFilePath(Category::INSTANCE, date_str));
   }
 
-  if (isSdkOutputLoggingEnabled()) {
-    std::string sdk_log_path = getLogFilePath(Category::SDK_OUTPUT, date_str);
-    sdk_output_appender_ =
-        std::make_unique<plog::RollingFileAppender<plog::TxtFormatter>>(
-            sdk_log_path.c_str(), max_file_size, max_files);
+  if (isSdkOutputLoggingEnabled() && !sdk_output_appender_) {
+    sdk_output_appender_ = makeFileAppender(
+        Category::SDK_OUTPUT, getLogFilePath(Category::SDK_OUTPUT, date_str));
   }
 
   // General appender (always created for general logs)
-  std::string general_log_path = getLogFilePath(Category::GENERAL, date_str);
-  general_appender_ =
-      std::make_unique<plog::RollingFileAppender<plog::TxtFormatter>>(
-          general_log_path.c_str(), max_file_size, max_files);
+  if (!general_appender_) {
+    general_appender_ = makeFileAppender(
+        Category::GENERAL, getLogFilePath(Category::GENERAL, date_str));
+  }
 
   // Start cleanup thread
   startCleanupThread();
 }
 
-plog::RollingFileAppender<plog::TxtFormatter> *
-LogManager::getAppender(Category category) {
+plog::IAppender *LogManager::getAppender(Category category) {
   switch (category) {
   case Category::API:
     return api_appender_.get();
@@ -107,6 +166,15 @@ LogManager::getAppender(Category category) {
   }
 }
 
+plog::IAppender *LogManager::getConsoleAppender() {
+  std::lock_guard<std::mutex> lock(cleanup_mutex_);
+  if (!console_appender_) {
+    console_appender_ =
+        std::make_unique<AsyncPlogAppender>(AsyncLogBackend::STDOUT);
+  }
+  return console_appender_.get();
+}
+
 std::string LogManager::getCategoryDir(Category category) {
   std::string category_dir = base_dir_;
   if (!base_dir_.empty() && base_dir_.back() != '/') {
@@ -0,0 +1,896 @@
+#include "core/model_catalog.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Same extension list as ModelUploadHandler::isValidModelFile plus the
+// engine formats PipelineBuilder can load
+const std::vector<std::string> &modelExtensions() {
+  static const std::vector<std::string> extensions = {
+      ".onnx", ".rknn",   ".weights", ".cfg",    ".pt",  ".pth",
+      ".pb",   ".pbtxt",  ".tflite",  ".txt",    ".engine", ".trt"};
+  return extensions;
+}
+
+std::string toLower(std::string value) {
+  std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+  return value;
+}
+
+std::string parentOf(const std::string &normalized) {
+  size_t pos = normalized.rfind('/');
+  if (pos == std::string::npos) {
+    return "";
+  }
+  if (pos == 0) {
+    return "/";
+  }
+  return normalized.substr(0, pos);
+}
+
+std::string filenameOf(const std::string &normalized) {
+  size_t pos = normalized.rfind('/');
+  return pos == std::string::npos ? normalized : normalized.substr(pos + 1);
+}
+
+bool isUnder(const std::string &path, const std::string &dir) {
+  if (path.size() <= dir.size() || path.compare(0, dir.size(), dir) != 0) {
+    return false;
+  }
+  return dir == "/" || path[dir.size()] == '/';
+}
+
+int64_t toEpochSeconds(fs::file_time_type ftime) {
+  auto sctp = std::chrono::time_point_cast<std::chrono::system_clock::duration>(
+      ftime - fs::file_time_type::clock::now() +
+      std::chrono::system_clock::now());
+  return static_cast<int64_t>(std::chrono::system_clock::to_time_t(sctp));
+}
+
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+uint64_t fnv1a(uint64_t hash, const unsigned char *data, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= data[i];
+    hash *= FNV_PRIME;
+  }
+  return hash;
+}
+
+std::string toHex(uint64_t value) {
+  char buf[17];
+  std::snprintf(buf, sizeof(buf), "%016llx",
+                static_cast<unsigned long long>(value));
+  return std::string(buf);
+}
+
+} // namespace
+
+Json::Value ModelCatalog::ModelEntry::toJson() const {
+  Json::Value json;
+  json["path"] = canonicalPath.empty() ? path : canonicalPath;
+  json["filename"] = filename;
+  json["name"] = name;
+  json["category"] = category;
+  json["size"] = static_cast<Json::UInt64>(size);
+  json["modifiedTime"] = static_cast<Json::Int64>(modifiedTime);
+  if (!checksum.empty()) {
+    json["checksum"] = checksum;
+    json["checksumAlgorithm"] = "fnv1a64";
+  }
+  return json;
+}
+
+ModelCatalog::~ModelCatalog() { stop(); }
+
+std::string ModelCatalog::normalizePath(const std::string &path) {
+  if (path.empty()) {
+    return "";
+  }
+  std::error_code ec;
+  fs::path p(path);
+  if (p.is_relative()) {
+    fs::path abs = fs::absolute(p, ec);
+    if (!ec) {
+      p = abs;
+    }
+  }
+  std::string normalized = p.lexically_normal().string();
+  while (normalized.size() > 1 && normalized.back() == '/') {
+    normalized.pop_back();
+  }
+  return normalized;
+}
+
+bool ModelCatalog::isModelFilename(const std::string &filename) {
+  std::string lower = toLower(filename);
+  // Skip in-progress uploads (ModelUploadHandler writes *.tmp then renames)
+  if (lower.size() >= 4 && lower.compare(lower.size() - 4, 4, ".tmp") == 0) {
+    return false;
+  }
+  // Match the listAvailableModels rule: extension appears anywhere in name
+  for (const auto &ext : modelExtensions()) {
+    if (lower.find(ext) != std::string::npos) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::string ModelCatalog::computeChecksum(const void *data, size_t size) {
+  return toHex(fnv1a(FNV_OFFSET_BASIS,
+                     static_cast<const unsigned char *>(data), size));
+}
+
+std::string ModelCatalog::computeFileChecksum(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    return "";
+  }
+  uint64_t hash = FNV_OFFSET_BASIS;
+  std::vector<char> buffer(1 << 20);
+  while (file) {
+    file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    std::streamsize n = file.gcount();
+    if (n <= 0) {
+      break;
+    }
+    hash = fnv1a(hash, reinterpret_cast<const unsigned char *>(buffer.data()),
+                 static_cast<size_t>(n));
+  }
+  if (file.bad()) {
+    return "";
+  }
+  return toHex(hash);
+}
+
+void ModelCatalog::addDefaultRoots() {
+  // Keep in sync with PipelineBuilder::resolveModelPath search order
+  const char *dataRoot = std::getenv("CVEDIX_DATA_ROOT");
+  if (dataRoot && strlen(dataRoot) > 0) {
+    addRoot(dataRoot);
+  }
+  const char *sdkRoot = std::getenv("CVEDIX_SDK_ROOT");
+  if (sdkRoot && strlen(sdkRoot) > 0) {
+    addRoot(std::string(sdkRoot) + "/cvedix_data");
+  }
+  addRoot("/opt/edge_ai_api/models");
+  addRoot("/usr/share/cvedix/cvedix_data");
+  addRoot("/usr/local/share/cvedix/cvedix_data");
+  addRoot("/usr/include/cvedix/cvedix_data");
+  addRoot("/usr/local/include/cvedix/cvedix_data");
+  addRoot("../edge_ai_sdk/cvedix_data");
+  addRoot("../../edge_ai_sdk/cvedix_data");
+  addRoot("../../../edge_ai_sdk/cvedix_data");
+  addRoot("./cvedix_data");
+  addRoot("./models");
+}
+
+void ModelCatalog::addRoot(const std::string &dir) {
+  std::string root = normalizePath(dir);
+  if (root.empty()) {
+    return;
+  }
+
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (std::find(roots_.begin(), roots_.end(), root) != roots_.end() ||
+      std::find(absent_roots_.begin(), absent_roots_.end(), root) !=
+          absent_roots_.end()) {
+    return;
+  }
+
+  std::error_code ec;
+  if (!fs::is_directory(root, ec)) {
+    absent_roots_.push_back(root);
+    return;
+  }
+
+  roots_.push_back(root);
+  if (running_.load(std::memory_order_acquire)) {
+    scanRootLocked(root);
+    bumpGenerationLocked();
+  }
+}
+
+void ModelCatalog::start() {
+  if (running_.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  auto startTime = std::chrono::steady_clock::now();
+  {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    // Create inotify fd before scanning so watches are added during the scan
+    inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ < 0) {
+      std::cerr << "[ModelCatalog] inotify unavailable (" << strerror(errno)
+                << "), falling back to periodic rescans" << std::endl;
+    }
+    // Roots registered before they existed may have appeared since
+    for (auto it = absent_roots_.begin(); it != absent_roots_.end();) {
+      std::error_code ec;
+      if (fs::is_directory(*it, ec)) {
+        roots_.push_back(*it);
+        it = absent_roots_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    rescanAllLocked();
+  }
+
+  should_stop_ = false;
+  running_.store(true, std::memory_order_release);
+  watch_thread_ = std::thread(&ModelCatalog::watchLoop, this);
+
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                     std::chrono::steady_clock::now() - startTime)
+                     .count();
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  std::cout << "[ModelCatalog] Indexed " << entries_.size()
+            << " model file(s) in " << directories_.size()
+            << " directories under " << roots_.size() << " root(s) in "
+            << elapsed << "ms" << std::endl;
+}
+
+void ModelCatalog::stop() {
+  if (!running_.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  should_stop_ = true;
+  if (watch_thread_.joinable()) {
+    watch_thread_.join();
+  }
+  running_.store(false, std::memory_order_release);
+
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (inotify_fd_ >= 0) {
+    close(inotify_fd_);
+    inotify_fd_ = -1;
+  }
+  watch_to_dir_.clear();
+  dir_to_watch_.clear();
+}
+
+void ModelCatalog::bumpGenerationLocked() {
+  generation_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void ModelCatalog::addWatchLocked(const std::string &dir) {
+  if (inotify_fd_ < 0 || dir_to_watch_.count(dir)) {
+    return;
+  }
+  int wd = inotify_add_watch(inotify_fd_, dir.c_str(),
+                             IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM |
+                                 IN_CREATE | IN_DELETE | IN_DELETE_SELF |
+                                 IN_ONLYDIR);
+  if (wd < 0) {
+    std::cerr << "[ModelCatalog] Failed to watch " << dir << ": "
+              << strerror(errno) << std::endl;
+    return;
+  }
+  watch_to_dir_[wd] = dir;
+  dir_to_watch_[dir] = wd;
+}
+
+void ModelCatalog::scanRootLocked(const std::string &root) {
+  scanDirectoryLocked(root);
+}
+
+void ModelCatalog::scanDirectoryLocked(const std::string &dir) {
+  directories_[dir];
+  opaque_dirs_.erase(dir);
+  addWatchLocked(dir);
+
+  std::error_code ec;
+  fs::directory_iterator it(dir, fs::directory_options::skip_permission_denied,
+                            ec);
+  if (ec) {
+    return;
+  }
+
+  for (; it != fs::directory_iterator(); it.increment(ec)) {
+    if (ec) {
+      break;
+    }
+    const auto &entry = *it;
+    std::string path = dir == "/" ? "/" + entry.path().filename().string()
+                                  : dir + "/" + entry.path().filename().string();
+    std::error_code entryEc;
+    if (entry.is_directory(entryEc)) {
+      if (entry.is_symlink(entryEc)) {
+        // Don't follow directory symlinks (loops); lookups there fall back
+        opaque_dirs_.insert(path);
+      } else {
+        scanDirectoryLocked(path);
+      }
+    } else if (entry.is_regular_file(entryEc) &&
+               isModelFilename(entry.path().filename().string())) {
+      indexFileLocked(path, "");
+    }
+  }
+}
+
+void ModelCatalog::indexFileLocked(const std::string &path,
+                                   const std::string &checksum) {
+  std::error_code ec;
+  if (!fs::is_regular_file(path, ec)) {
+    removeFileLocked(path);
+    return;
+  }
+
+  ModelEntry entry;
+  entry.path = path;
+  entry.filename = filenameOf(path);
+  entry.name = fs::path(entry.filename).stem().string();
+  entry.category = filenameOf(parentOf(path));
+  entry.size = fs::file_size(path, ec);
+  if (ec) {
+    entry.size = 0;
+  }
+  auto ftime = fs::last_write_time(path, ec);
+  entry.modifiedTime = ec ? 0 : toEpochSeconds(ftime);
+  fs::path canonical = fs::canonical(path, ec);
+  entry.canonicalPath = ec ? path : canonical.string();
+  entry.checksum = checksum;
+
+  auto existing = entries_.find(path);
+  if (existing != entries_.end()) {
+    if (entry.checksum.empty() && existing->second.size == entry.size &&
+        existing->second.modifiedTime == entry.modifiedTime) {
+      entry.checksum = existing->second.checksum;
+    }
+    removeFileLocked(path);
+  }
+
+  std::string parent = parentOf(path);
+  if (!directories_.count(parent)) {
+    directories_[parent];
+    addWatchLocked(parent);
+  }
+  directories_[parent].insert(entry.filename);
+  by_name_[toLower(entry.name)].insert(path);
+  by_category_[entry.category].insert(path);
+  if (!entry.checksum.empty()) {
+    by_checksum_[entry.checksum].insert(path);
+  }
+  entries_[path] = std::move(entry);
+  bumpGenerationLocked();
+}
+
+void ModelCatalog::removeFileLocked(const std::string &path) {
+  auto it = entries_.find(path);
+  if (it == entries_.end()) {
+    return;
+  }
+  const ModelEntry &entry = it->second;
+
+  auto eraseFrom = [&path](std::unordered_map<std::string,
+                                              std::set<std::string>> &index,
+                           const std::string &key) {
+    auto indexIt = index.find(key);
+    if (indexIt != index.end()) {
+      indexIt->second.erase(path);
+      if (indexIt->second.empty()) {
+        index.erase(indexIt);
+      }
+    }
+  };
+  eraseFrom(by_name_, toLower(entry.name));
+  eraseFrom(by_category_, entry.category);
+  if (!entry.checksum.empty()) {
+    eraseFrom(by_checksum_, entry.checksum);
+  }
+
+  auto dirIt = directories_.find(parentOf(path));
+  if (dirIt != directories_.end()) {
+    dirIt->second.erase(entry.filename);
+  }
+
+  entries_.erase(it);
+  bumpGenerationLocked();
+}
+
+void ModelCatalog::removeDirectoryLocked(const std::string &dir) {
+  std::vector<std::string> files;
+  for (const auto &pair : entries_) {
+    if (isUnder(pair.first, dir)) {
+      files.push_back(pair.first);
+    }
+  }
+  for (const auto &file : files) {
+    removeFileLocked(file);
+  }
+
+  for (auto it = directories_.begin(); it != directories_.end();) {
+    if (it->first == dir || isUnder(it->first, dir)) {
+      auto watchIt = dir_to_watch_.find(it->first);
+      if (watchIt != dir_to_watch_.end()) {
+        if (inotify_fd_ >= 0) {
+          inotify_rm_watch(inotify_fd_, watchIt->second);
+        }
+        watch_to_dir_.erase(watchIt->second);
+        dir_to_watch_.erase(watchIt);
+      }
+      it = directories_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  for (auto it = opaque_dirs_.begin(); it != opaque_dirs_.end();) {
+    if (*it == dir || isUnder(*it, dir)) {
+      it = opaque_dirs_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  bumpGenerationLocked();
+}
+
+void ModelCatalog::rescanAllLocked() {
+  if (inotify_fd_ >= 0) {
+    for (const auto &pair : watch_to_dir_) {
+      inotify_rm_watch(inotify_fd_, pair.first);
+    }
+  }
+  watch_to_dir_.clear();
+  dir_to_watch_.clear();
+  entries_.clear();
+  directories_.clear();
+  opaque_dirs_.clear();
+  by_name_.clear();
+  by_category_.clear();
+  by_checksum_.clear();
+
+  for (const auto &root : roots_) {
+    scanRootLocked(root);
+  }
+  bumpGenerationLocked();
+}
+
+const std::string *ModelCatalog::findRoot(const std::string &normalized) const {
+  for (const auto &root : roots_) {
+    if (normalized == root || isUnder(normalized, root)) {
+      return &root;
+    }
+  }
+  return nullptr;
+}
+
+ModelCatalog::Lookup
+ModelCatalog::lookupLocked(const std::string &normalized,
+                           bool isDirectory) const {
+  if (!findRoot(normalized)) {
+    for (const auto &root : absent_roots_) {
+      if (normalized == root || isUnder(normalized, root)) {
+        return Lookup::Missing;
+      }
+    }
+    return Lookup::Unknown;
+  }
+
+  std::string dir = normalized;
+  if (!isDirectory) {
+    // Only model files are indexed - anything else is answered by the
+    // filesystem
+    std::string filename = filenameOf(normalized);
+    if (!isModelFilename(filename)) {
+      return Lookup::Unknown;
+    }
+    dir = parentOf(normalized);
+    auto dirIt = directories_.find(dir);
+    if (dirIt != directories_.end()) {
+      return dirIt->second.count(filename) ? Lookup::Found : Lookup::Missing;
+    }
+  } else if (directories_.count(dir)) {
+    return Lookup::Found;
+  }
+
+  // Directory is not indexed: it is missing unless one of its ancestors was
+  // skipped during the scan (directory symlink)
+  std::string current = dir;
+  while (!current.empty() && !directories_.count(current)) {
+    if (opaque_dirs_.count(current)) {
+      return Lookup::Unknown;
+    }
+    std::string parent = parentOf(current);
+    if (parent == current) {
+      break;
+    }
+    current = parent;
+  }
+  return current.empty() ? Lookup::Unknown : Lookup::Missing;
+}
+
+ModelCatalog::Lookup ModelCatalog::lookupFile(const std::string &path) const {
+  if (!isRunning()) {
+    return Lookup::Unknown;
+  }
+  std::string normalized = normalizePath(path);
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return lookupLocked(normalized, false);
+}
+
+ModelCatalog::Lookup
+ModelCatalog::lookupDirectory(const std::string &dir) const {
+  if (!isRunning()) {
+    return Lookup::Unknown;
+  }
+  std::string normalized = normalizePath(dir);
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return lookupLocked(normalized, true);
+}
+
+bool ModelCatalog::listDirectory(const std::string &dir, bool recursive,
+                                 std::vector<ModelEntry> &out) const {
+  if (!isRunning()) {
+    return false;
+  }
+  std::string normalized = normalizePath(dir);
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+
+  Lookup result = lookupLocked(normalized, true);
+  if (result == Lookup::Unknown) {
+    return false;
+  }
+  if (result == Lookup::Missing) {
+    return true;
+  }
+
+  std::set<std::string> paths;
+  if (recursive) {
+    // A symlinked subdirectory would be invisible to the catalog
+    for (const auto &opaque : opaque_dirs_) {
+      if (isUnder(opaque, normalized)) {
+        return false;
+      }
+    }
+    for (const auto &pair : entries_) {
+      if (isUnder(pair.first, normalized)) {
+        paths.insert(pair.first);
+      }
+    }
+  } else {
+    const auto &files = directories_.at(normalized);
+    for (const auto &filename : files) {
+      paths.insert(normalized == "/" ? "/" + filename
+                                     : normalized + "/" + filename);
+    }
+  }
+
+  std::vector<ModelEntry> entries = collectEntries(paths);
+  out.insert(out.end(), entries.begin(), entries.end());
+  return true;
+}
+
+std::vector<ModelCatalog::ModelEntry>
+ModelCatalog::collectEntries(const std::set<std::string> &paths) const {
+  std::vector<ModelEntry> result;
+  result.reserve(paths.size());
+  for (const auto &path : paths) {
+    auto it = entries_.find(path);
+    if (it != entries_.end()) {
+      result.push_back(it->second);
+    }
+  }
+  return result;
+}
+
+bool ModelCatalog::getEntry(const std::string &path, ModelEntry &out) const {
+  std::string normalized = normalizePath(path);
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto it = entries_.find(normalized);
+  if (it == entries_.end()) {
+    return false;
+  }
+  out = it->second;
+  return true;
+}
+
+std::vector<ModelCatalog::ModelEntry>
+ModelCatalog::findByName(const std::string &name) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto it = by_name_.find(toLower(name));
+  if (it == by_name_.end()) {
+    return {};
+  }
+  return collectEntries(it->second);
+}
+
+std::vector<ModelCatalog::ModelEntry>
+ModelCatalog::findByCategory(const std::string &category) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto it = by_category_.find(category);
+  if (it == by_category_.end()) {
+    return {};
+  }
+  return collectEntries(it->second);
+}
+
+std::vector<ModelCatalog::ModelEntry>
+ModelCatalog::findByChecksum(const std::string &checksum) {
+  std::vector<std::string> pending;
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    for (const auto &pair : entries_) {
+      if (pair.second.checksum.empty()) {
+        pending.push_back(pair.first);
+      }
+    }
+  }
+  for (const auto &path : pending) {
+    getChecksum(path);
+  }
+
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto it = by_checksum_.find(checksum);
+  if (it == by_checksum_.end()) {
+    return {};
+  }
+  return collectEntries(it->second);
+}
+
+std::string ModelCatalog::getChecksum(const std::string &path) {
+  std::string normalized = normalizePath(path);
+  uint64_t size = 0;
+  int64_t modifiedTime = 0;
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = entries_.find(normalized);
+    if (it == entries_.end()) {
+      return "";
+    }
+    if (!it->second.checksum.empty()) {
+      return it->second.checksum;
+    }
+    size = it->second.size;
+    modifiedTime = it->second.modifiedTime;
+  }
+
+  // Hash outside the lock - model files can be hundreds of MB
+  std::string checksum = computeFileChecksum(normalized);
+  if (checksum.empty()) {
+    return "";
+  }
+
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  auto it = entries_.find(normalized);
+  if (it != entries_.end() && it->second.size == size &&
+      it->second.modifiedTime == modifiedTime && it->second.checksum.empty()) {
+    it->second.checksum = checksum;
+    by_checksum_[checksum].insert(normalized);
+  }
+  return checksum;
+}
+
+void ModelCatalog::notifyFileChanged(const std::string &path,
+                                     const std::string &checksum) {
+  std::string normalized = normalizePath(path);
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (!findRoot(normalized) || !isModelFilename(filenameOf(normalized))) {
+    return;
+  }
+  indexFileLocked(normalized, checksum);
+}
+
+void ModelCatalog::notifyFileRemoved(const std::string &path) {
+  std::string normalized = normalizePath(path);
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  removeFileLocked(normalized);
+}
+
+bool ModelCatalog::getCachedResolution(const std::string &key,
+                                       std::string &value) const {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  if (cache_generation_ != getGeneration()) {
+    cache_misses_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  auto it = resolution_cache_.find(key);
+  if (it == resolution_cache_.end()) {
+    cache_misses_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  cache_hits_.fetch_add(1, std::memory_order_relaxed);
+  value = it->second;
+  return true;
+}
+
+void ModelCatalog::cacheResolution(const std::string &key,
+                                   const std::string &value,
+                                   uint64_t generation) {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  uint64_t current = getGeneration();
+  if (generation != current) {
+    return; // Catalog changed while resolving - result may be stale
+  }
+  if (cache_generation_ != current) {
+    resolution_cache_.clear();
+    cache_generation_ = current;
+  }
+  resolution_cache_[key] = value;
+}
+
+Json::Value ModelCatalog::getStatistics() const {
+  Json::Value stats;
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  stats["running"] = isRunning();
+  stats["watchMode"] = inotify_fd_ >= 0 ? "inotify" : "polling";
+  stats["models"] = static_cast<Json::UInt64>(entries_.size());
+  stats["directories"] = static_cast<Json::UInt64>(directories_.size());
+  stats["watches"] = static_cast<Json::UInt64>(watch_to_dir_.size());
+  stats["generation"] = static_cast<Json::UInt64>(getGeneration());
+  stats["resolutionCacheHits"] =
+      static_cast<Json::UInt64>(cache_hits_.load(std::memory_order_relaxed));
+  stats["resolutionCacheMisses"] =
+      static_cast<Json::UInt64>(cache_misses_.load(std::memory_order_relaxed));
+
+  Json::Value roots(Json::arrayValue);
+  for (const auto &root : roots_) {
+    roots.append(root);
+  }
+  stats["roots"] = roots;
+  Json::Value absentRoots(Json::arrayValue);
+  for (const auto &root : absent_roots_) {
+    absentRoots.append(root);
+  }
+  stats["absentRoots"] = absentRoots;
+  return stats;
+}
+
+void ModelCatalog::checkAbsentRoots() {
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  for (auto it = absent_roots_.begin(); it != absent_roots_.end();) {
+    std::error_code ec;
+    if (fs::is_directory(*it, ec)) {
+      std::cout << "[ModelCatalog] Root appeared, indexing: " << *it
+                << std::endl;
+      roots_.push_back(*it);
+      scanRootLocked(*it);
+      bumpGenerationLocked();
+      it = absent_roots_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void ModelCatalog::processEvents(const char *buffer, ssize_t length) {
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+
+  ssize_t i = 0;
+  while (i < length) {
+    const struct inotify_event *event =
+        reinterpret_cast<const struct inotify_event *>(&buffer[i]);
+    i += sizeof(struct inotify_event) + event->len;
+
+    if (event->mask & IN_Q_OVERFLOW) {
+      std::cerr << "[ModelCatalog] inotify queue overflow, rescanning"
+                << std::endl;
+      rescanAllLocked();
+      continue;
+    }
+
+    auto watchIt = watch_to_dir_.find(event->wd);
+    if (watchIt == watch_to_dir_.end()) {
+      continue;
+    }
+    std::string dir = watchIt->second;
+
+    if (event->mask & IN_IGNORED) {
+      dir_to_watch_.erase(dir);
+      watch_to_dir_.erase(watchIt);
+      continue;
+    }
+
+    if (event->mask & IN_DELETE_SELF) {
+      removeDirectoryLocked(dir);
+      auto rootIt = std::find(roots_.begin(), roots_.end(), dir);
+      if (rootIt != roots_.end()) {
+        // Root went away - wait for it to come back
+        roots_.erase(rootIt);
+        absent_roots_.push_back(dir);
+      }
+      continue;
+    }
+
+    if (event->len == 0) {
+      continue;
+    }
+    std::string name(event->name);
+    std::string path = dir == "/" ? "/" + name : dir + "/" + name;
+
+    if (event->mask & IN_ISDIR) {
+      if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+        scanDirectoryLocked(path);
+        bumpGenerationLocked();
+      } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+        removeDirectoryLocked(path);
+      }
+      continue;
+    }
+
+    if (!isModelFilename(name)) {
+      continue;
+    }
+    if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE)) {
+      indexFileLocked(path, "");
+    } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+      removeFileLocked(path);
+    }
+  }
+}
+
+void ModelCatalog::watchLoop() {
+  auto lastAbsentCheck = std::chrono::steady_clock::now();
+  auto lastRescan = lastAbsentCheck;
+
+  if (inotify_fd_ < 0) {
+    // Polling fallback: periodic full rescan
+    while (!should_stop_) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(POLL_TIMEOUT_MS));
+      auto now = std::chrono::steady_clock::now();
+      if (now - lastRescan >= std::chrono::milliseconds(POLLING_RESCAN_MS)) {
+        lastRescan = now;
+        checkAbsentRoots();
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        rescanAllLocked();
+      }
+    }
+    return;
+  }
+
+  const size_t BUF_LEN = 1024 * (sizeof(struct inotify_event) + NAME_MAX + 1);
+  std::vector<char> buffer(BUF_LEN);
+
+  struct pollfd pfd;
+  pfd.fd = inotify_fd_;
+  pfd.events = POLLIN;
+
+  while (!should_stop_) {
+    int pollResult = poll(&pfd, 1, POLL_TIMEOUT_MS);
+    if (pollResult < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      std::cerr << "[ModelCatalog] Poll error: " << strerror(errno)
+                << std::endl;
+      break;
+    }
+
+    if (pollResult > 0 && (pfd.revents & POLLIN)) {
+      ssize_t length = read(inotify_fd_, buffer.data(), buffer.size());
+      if (length > 0) {
+        processEvents(buffer.data(), length);
+      } else if (length < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+        std::cerr << "[ModelCatalog] Read error: " << strerror(errno)
+                  << std::endl;
+        break;
+      }
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastAbsentCheck >=
+        std::chrono::milliseconds(ABSENT_ROOT_CHECK_MS)) {
+      lastAbsentCheck = now;
+      checkAbsentRoots();
+    }
+  }
+}
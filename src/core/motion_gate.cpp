@@ -0,0 +1,138 @@
+#include "core/motion_gate.h"
+#include "utils/param_parse.h"
+#include <algorithm>
+#include <stdexcept>
+
+using ParamParse::lookup;
+using ParamParse::parseDouble;
+using ParamParse::parseInt;
+
+MotionGate::Options
+MotionGate::optionsForSensitivity(const std::string &sensitivity) {
+  Options options;
+  if (sensitivity == "High") {
+    options.pixel_threshold = 15;
+    options.min_area = 0.002;
+  } else if (sensitivity == "Medium") {
+    options.pixel_threshold = 22;
+    options.min_area = 0.005;
+  }
+  return options;
+}
+
+MotionGate::Options
+MotionGate::parseOptions(const std::map<std::string, std::string> &params) {
+  const std::string *sensitivity = lookup(params, "sensitivity");
+  Options options = optionsForSensitivity(sensitivity ? *sensitivity : "Low");
+  options.pixel_threshold =
+      parseInt(params, "pixel_threshold", options.pixel_threshold, 1, 255);
+  options.min_area =
+      parseDouble(params, "min_area", options.min_area, 0.0, 1.0);
+  options.analysis_width =
+      parseInt(params, "analysis_width", options.analysis_width, 16, 1920);
+  options.keepalive_ms =
+      parseInt(params, "keepalive_ms", options.keepalive_ms, 0, 600000);
+  options.hold_ms = parseInt(params, "hold_ms", options.hold_ms, 0, 600000);
+  return options;
+}
+
+const char *MotionGate::decisionName(Decision decision) {
+  switch (decision) {
+  case Decision::Initial:
+    return "initial";
+  case Decision::Motion:
+    return "motion";
+  case Decision::Hold:
+    return "hold";
+  case Decision::KeepAlive:
+    return "keepalive";
+  case Decision::SceneChange:
+    return "scene_change";
+  case Decision::Skip:
+    return "skip";
+  }
+  return "unknown";
+}
+
+int MotionGate::analysisHeight(int frameWidth, int frameHeight) const {
+  if (frameWidth <= 0 || frameHeight <= 0) {
+    return 0;
+  }
+  int width = std::min(options_.analysis_width, frameWidth);
+  return std::max(1, static_cast<int>(static_cast<int64_t>(frameHeight) *
+                                      width / frameWidth));
+}
+
+void MotionGate::resetBackground(const uint8_t *gray, int width, int height,
+                                 size_t stride) {
+  width_ = width;
+  height_ = height;
+  background_.resize(static_cast<size_t>(width) * height);
+  for (int y = 0; y < height; ++y) {
+    const uint8_t *row = gray + y * stride;
+    int16_t *bg = background_.data() + static_cast<size_t>(y) * width;
+    for (int x = 0; x < width; ++x) {
+      bg[x] = static_cast<int16_t>(row[x] << 4);
+    }
+  }
+}
+
+MotionGate::Decision MotionGate::update(const uint8_t *gray, int width,
+                                        int height, size_t stride,
+                                        Clock::time_point now) {
+  ++frames_;
+  Decision decision = Decision::Skip;
+
+  if (width != width_ || height != height_ || background_.empty()) {
+    resetBackground(gray, width, height, stride);
+    last_fraction_ = 0.0;
+    decision = Decision::Initial;
+  } else {
+    // Compare in 12.4 fixed point and move the background towards the frame
+    const int threshold = options_.pixel_threshold << 4;
+    const int shift = options_.learn_shift;
+    uint64_t changed = 0;
+    for (int y = 0; y < height; ++y) {
+      const uint8_t *row = gray + y * stride;
+      int16_t *bg = background_.data() + static_cast<size_t>(y) * width;
+      uint32_t rowChanged = 0;
+      for (int x = 0; x < width; ++x) {
+        int current = row[x] << 4;
+        int diff = current - bg[x];
+        rowChanged += static_cast<uint32_t>((diff > threshold) |
+                                            (diff < -threshold));
+        bg[x] = static_cast<int16_t>(bg[x] + (diff >> shift));
+      }
+      changed += rowChanged;
+    }
+    last_fraction_ = static_cast<double>(changed) /
+                     (static_cast<double>(width) * height);
+
+    if (last_fraction_ >= options_.scene_change_area) {
+      // Global change: adapt at once instead of reporting motion for seconds
+      resetBackground(gray, width, height, stride);
+      decision = Decision::SceneChange;
+    } else if (last_fraction_ >= options_.min_area && changed > 0) {
+      decision = Decision::Motion;
+    }
+  }
+
+  if (decision == Decision::Motion) {
+    has_motion_ = true;
+    last_motion_ = now;
+  } else if (decision == Decision::Skip) {
+    if (has_motion_ &&
+        now - last_motion_ < std::chrono::milliseconds(options_.hold_ms)) {
+      decision = Decision::Hold;
+    } else if (now - last_forward_ >=
+               std::chrono::milliseconds(options_.keepalive_ms)) {
+      decision = Decision::KeepAlive;
+    }
+  }
+
+  if (forwards(decision)) {
+    ++forwarded_;
+    last_forward_ = now;
+  }
+  return decision;
+}
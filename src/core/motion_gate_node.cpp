@@ -0,0 +1,132 @@
+#include "core/motion_gate_node.h"
+#include <algorithm>
+#include <iostream>
+#include <opencv2/imgproc.hpp>
+
+namespace {
+
+// Log the forward ratio every this many frames per node
+constexpr uint64_t kReportInterval = 3000;
+
+} // namespace
+
+MotionGateNode::MotionGateNode(const std::string &node_name,
+                               const MotionGate::Options &options)
+    : cvedix_nodes::cvedix_node(node_name), options_(options) {
+  this->initialized();
+}
+
+MotionGateNode::~MotionGateNode() { deinitialized(); }
+
+void MotionGateNode::setJoin(const std::shared_ptr<MotionGateJoinNode> &join) {
+  join_ = join;
+}
+
+MotionGateNode::Channel &MotionGateNode::channel(int index) {
+  std::lock_guard<std::mutex> lock(channels_mutex_);
+  auto &entry = channels_[index];
+  if (!entry) {
+    entry = std::make_unique<Channel>(options_);
+  }
+  return *entry;
+}
+
+std::shared_ptr<cvedix_objects::cvedix_meta> MotionGateNode::handle_frame_meta(
+    std::shared_ptr<cvedix_objects::cvedix_frame_meta> meta) {
+  const cv::Mat &frame = meta->frame;
+  if (frame.empty()) {
+    return meta;
+  }
+
+  // Frames of one channel arrive in order on this node's thread; the map
+  // lock only covers first use of a channel
+  Channel &ch = channel(meta->channel_index);
+  int width = std::min(options_.analysis_width, frame.cols);
+  int height = ch.gate.analysisHeight(frame.cols, frame.rows);
+
+  // Downscale first so the colour conversion runs on a few thousand pixels
+  cv::resize(frame, ch.small, cv::Size(width, height), 0, 0, cv::INTER_AREA);
+  if (ch.small.channels() == 1) {
+    ch.gray = ch.small;
+  } else {
+    cv::cvtColor(ch.small, ch.gray,
+                 ch.small.channels() == 4 ? cv::COLOR_BGRA2GRAY
+                                          : cv::COLOR_BGR2GRAY);
+  }
+
+  auto decision =
+      ch.gate.update(ch.gray.ptr<uint8_t>(), ch.gray.cols, ch.gray.rows,
+                     ch.gray.step[0]);
+  uint64_t frames = frames_.fetch_add(1, std::memory_order_relaxed) + 1;
+  bool forward = MotionGate::forwards(decision);
+  auto join = join_.lock();
+  if (forward) {
+    forwarded_.fetch_add(1, std::memory_order_relaxed);
+    if (join) {
+      join->expect(*meta);
+    }
+  } else if (join && join->carry(meta)) {
+    carried_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  if (frames % kReportInterval == 0) {
+    uint64_t forwarded = forwarded_.load(std::memory_order_relaxed);
+    std::cerr << "[MotionGate] " << node_name << ": forwarded " << forwarded
+              << "/" << frames << " frames ("
+              << (frames ? forwarded * 100 / frames : 0) << "%), carried "
+              << carried_.load(std::memory_order_relaxed) << std::endl;
+  }
+
+  // Returning no meta keeps the frame from the detector; a carried frame is
+  // already on its way through the join node
+  return forward ? meta : nullptr;
+}
+
+// ========== MotionGateJoinNode ==========
+
+MotionGateJoinNode::MotionGateJoinNode(const std::string &node_name)
+    : cvedix_nodes::cvedix_node(node_name) {
+  this->initialized();
+}
+
+MotionGateJoinNode::~MotionGateJoinNode() { deinitialized(); }
+
+void MotionGateJoinNode::expect(const cvedix_objects::cvedix_frame_meta &meta) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  channels_[meta.channel_index].last_sent = meta.frame_index;
+}
+
+bool MotionGateJoinNode::carry(
+    const std::shared_ptr<cvedix_objects::cvedix_frame_meta> &meta) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Channel &ch = channels_[meta->channel_index];
+    // A frame still in the detector would come out after this one. Frame
+    // indices rather than a counter, so a frame the detector drops does not
+    // block carrying for good
+    if (ch.last_detected < ch.last_sent) {
+      return false;
+    }
+    for (const auto &target : ch.targets) {
+      auto copy = target->clone();
+      copy->frame_index = meta->frame_index;
+      meta->targets.push_back(copy);
+    }
+    carried_.insert(meta.get());
+  }
+  this->meta_flow(meta);
+  return true;
+}
+
+std::shared_ptr<cvedix_objects::cvedix_meta>
+MotionGateJoinNode::handle_frame_meta(
+    std::shared_ptr<cvedix_objects::cvedix_frame_meta> meta) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (carried_.erase(meta.get()) > 0) {
+    return meta;
+  }
+  Channel &ch = channels_[meta->channel_index];
+  ch.last_detected = std::max(ch.last_detected, meta->frame_index);
+  ch.targets = meta->targets;
+  return meta;
+}
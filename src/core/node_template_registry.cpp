@@ -483,6 +483,33 @@ const std::map<std::string, NodeTemplateRegistry::NodeTypeMetadata>
           {},
           "Expression Socket Broker",
           "Expression socket broker"}},
+
+        // ========== SYNTHETIC NODES (load testing) ==========
+        {"synthetic_src",
+         {"source",
+          {},
+          {"channel", "width", "height", "fps"},
+          "Synthetic Source",
+          "Generate frames at a fixed resolution and fps (no camera)"}},
+        {"synthetic_detector",
+         {"detector",
+          {},
+          {"latency_ms", "latency_jitter_ms", "latency_mode", "boxes",
+           "min_box", "max_box", "seed"},
+          "Synthetic Detector",
+          "Simulate inference latency and emit moving boxes (no model)"}},
+        {"synthetic_ba",
+         {"processor",
+          {},
+          {},
+          "Synthetic BA",
+          "Pass-through behavior analysis node"}},
+        {"synthetic_broker",
+         {"broker",
+          {},
+          {"serialize"},
+          "Synthetic Broker",
+          "Serialize detection results to JSON and drop them"}},
 };
 
 // Default parameters for specific node types
@@ -531,6 +558,13 @@ const std::map<std::string, std::map<std::string, std::string>>
         {"json_console_broker", {{"broke_for", "NORMAL"}}},
         {"json_enhanced_mqtt_broker",
          {{"broke_for", "NORMAL"}, {"encode_full_frame", "false"}}},
+        {"synthetic_src",
+         {{"channel", "0"},
+          {"width", "1280"},
+          {"height", "720"},
+          {"fps", "25"}}},
+        {"synthetic_detector", {{"latency_ms", "10"}, {"boxes", "5"}}},
+        {"synthetic_broker", {{"serialize", "true"}}},
 };
 
 std::vector<NodePoolManager::NodeTemplate>
@@ -0,0 +1,744 @@
+#include "core/operation_executor.h"
+#include "config/system_config.h"
+#include "core/uuid_generator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+double elapsedMs(std::chrono::steady_clock::time_point from,
+                 std::chrono::steady_clock::time_point to) {
+  return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+std::string formatUtc(std::chrono::system_clock::time_point tp) {
+  auto time_t = std::chrono::system_clock::to_time_t(tp);
+  std::tm tm{};
+  gmtime_r(&time_t, &tm);
+  std::stringstream ss;
+  ss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%SZ");
+  return ss.str();
+}
+
+} // namespace
+
+void OperationExecutor::Progress::report(double fraction,
+                                         const std::string &step) {
+  executor_.setProgress(id_, fraction, step);
+}
+
+const char *OperationExecutor::stateName(State state) {
+  switch (state) {
+  case State::Queued:
+    return "queued";
+  case State::Running:
+    return "running";
+  case State::Succeeded:
+    return "succeeded";
+  case State::Failed:
+    return "failed";
+  case State::Cancelled:
+    return "cancelled";
+  }
+  return "unknown";
+}
+
+OperationExecutor::Config OperationExecutor::loadConfig() {
+  Config config;
+
+  try {
+    Json::Value section =
+        SystemConfig::getInstance().getConfigSection("system.operations");
+    if (section.isObject()) {
+      config.worker_threads = std::max<size_t>(
+          1, section
+                 .get("worker_threads",
+                      static_cast<Json::UInt64>(config.worker_threads))
+                 .asUInt64());
+      config.max_pending = std::max<size_t>(
+          1, section
+                 .get("max_pending",
+                      static_cast<Json::UInt64>(config.max_pending))
+                 .asUInt64());
+      config.max_retained = std::max<size_t>(
+          1, section
+                 .get("max_retained",
+                      static_cast<Json::UInt64>(config.max_retained))
+                 .asUInt64());
+      config.retention = std::chrono::seconds(std::max<Json::Int64>(
+          1, section
+                 .get("retention_seconds",
+                      static_cast<Json::Int64>(config.retention.count()))
+                 .asInt64()));
+    }
+  } catch (const std::exception &e) {
+    std::cerr << "[OperationExecutor] Invalid operations config, using "
+                 "defaults: "
+              << e.what() << std::endl;
+  }
+
+  // Env override for quick throughput tuning without editing config.json
+  if (const char *env = std::getenv("EDGE_AI_OPERATION_WORKERS")) {
+    try {
+      int workers = std::stoi(env);
+      if (workers > 0) {
+        config.worker_threads = static_cast<size_t>(workers);
+      }
+    } catch (const std::exception &) {
+      std::cerr << "[OperationExecutor] Ignoring invalid "
+                   "EDGE_AI_OPERATION_WORKERS="
+                << env << std::endl;
+    }
+  }
+  return config;
+}
+
+void OperationExecutor::configure(const Config &config) {
+  // Let the old pool drain its running operations first
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_.store(false, std::memory_order_release);
+  }
+  joinThreads();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  config_ = config;
+  config_.worker_threads = std::max<size_t>(1, config_.worker_threads);
+  accepting_ = true;
+  startWorkersLocked();
+  std::cerr << "[OperationExecutor] Started: " << config_.worker_threads
+            << " workers, max pending " << config_.max_pending << std::endl;
+}
+
+void OperationExecutor::startWorkersLocked() {
+  // Also reached from submit() when configure() was never called (e.g. in
+  // the worker process): start the default pool on first use
+  if (running_.load(std::memory_order_acquire)) {
+    return;
+  }
+  running_.store(true, std::memory_order_release);
+  for (size_t i = 0; i < config_.worker_threads; ++i) {
+    workers_.emplace_back(&OperationExecutor::workerLoop, this);
+  }
+  timer_ = std::thread(&OperationExecutor::timerLoop, this);
+}
+
+void OperationExecutor::joinThreads() {
+  work_cv_.notify_all();
+  timer_cv_.notify_all();
+  for (auto &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  workers_.clear();
+  if (timer_.joinable()) {
+    timer_.join();
+  }
+}
+
+void OperationExecutor::shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    accepting_ = false;
+    running_.store(false, std::memory_order_release);
+  }
+  joinThreads();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Detach the queues first: cancelling a child updates its batch
+    auto pending = std::move(pending_);
+    pending_.clear();
+    ready_keys_.clear();
+    pending_count_ = 0;
+    for (auto &entry : pending) {
+      for (auto &op : entry.second) {
+        finishLocked(*op, State::Cancelled, "Server shutting down");
+      }
+    }
+    for (auto &entry : operations_) {
+      auto deferred = std::move(entry.second->deferred);
+      entry.second->deferred.clear();
+      for (auto &op : deferred) {
+        --deferred_count_;
+        finishLocked(*op, State::Cancelled, "Server shutting down");
+      }
+    }
+  }
+  done_cv_.notify_all();
+  dispatchEvents();
+}
+
+std::shared_ptr<OperationExecutor::Operation>
+OperationExecutor::newOperation(const std::string &type,
+                                const std::string &key) {
+  auto op = std::make_shared<Operation>();
+  op->id = UUIDGenerator::generateUUID();
+  op->type = type;
+  op->key = key;
+  op->created = Clock::now();
+  op->created_wall = std::chrono::system_clock::now();
+  return op;
+}
+
+void OperationExecutor::enqueueLocked(const std::shared_ptr<Operation> &op) {
+  // Unkeyed operations serialize only with themselves
+  const std::string &key = op->key.empty() ? op->id : op->key;
+  auto &queue = pending_[key];
+  queue.push_back(op);
+  ++pending_count_;
+  ++submitted_;
+  if (queue.size() == 1 && busy_keys_.count(key) == 0) {
+    ready_keys_.push_back(key);
+    work_cv_.notify_one();
+  }
+}
+
+std::string OperationExecutor::submit(const std::string &type,
+                                      const std::string &key, Task task) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!accepting_ || pending_count_ >= config_.max_pending) {
+    ++rejected_;
+    return "";
+  }
+  startWorkersLocked();
+
+  auto op = newOperation(type, key);
+  op->task = std::move(task);
+  operations_[op->id] = op;
+  order_.push_back(op->id);
+  enqueueLocked(op);
+  return op->id;
+}
+
+std::string OperationExecutor::submitBatch(const std::string &type,
+                                           std::vector<BatchItem> items) {
+  return submitBatch(type, std::move(items), BatchOptions{});
+}
+
+std::string OperationExecutor::submitBatch(const std::string &type,
+                                           std::vector<BatchItem> items,
+                                           BatchOptions options) {
+  std::string id;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!accepting_ || pending_count_ + deferred_count_ + items.size() >
+                           config_.max_pending) {
+      ++rejected_;
+      return "";
+    }
+    startWorkersLocked();
+
+    auto parent = newOperation(type, "");
+    parent->batch = true;
+    if (options.observer) {
+      parent->observer =
+          std::make_shared<BatchObserver>(std::move(options.observer));
+    }
+    id = parent->id;
+    operations_[parent->id] = parent;
+    order_.push_back(parent->id);
+
+    const size_t limit =
+        options.max_parallel == 0 ? items.size() : options.max_parallel;
+    for (auto &item : items) {
+      auto child = newOperation(type, item.key);
+      child->parent_id = parent->id;
+      child->task = std::move(item.task);
+      child->timeout = options.item_timeout;
+      parent->children.push_back(child->id);
+      operations_[child->id] = child;
+      order_.push_back(child->id);
+      if (parent->children.size() <= limit) {
+        enqueueLocked(child);
+      } else {
+        parent->deferred.push_back(std::move(child));
+        ++deferred_count_;
+      }
+    }
+    // An empty batch is trivially done
+    updateParentLocked(parent->id);
+  }
+  dispatchEvents();
+  return id;
+}
+
+void OperationExecutor::workerLoop() {
+  while (true) {
+    std::shared_ptr<Operation> op;
+    std::string key;
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      work_cv_.wait(lock, [this] {
+        return !running_.load(std::memory_order_acquire) ||
+               !ready_keys_.empty();
+      });
+      if (!running_.load(std::memory_order_acquire)) {
+        return;
+      }
+
+      key = ready_keys_.front();
+      ready_keys_.pop_front();
+      auto found = pending_.find(key);
+      if (found == pending_.end() || found->second.empty()) {
+        continue;
+      }
+      op = found->second.front();
+      found->second.pop_front();
+      if (found->second.empty()) {
+        pending_.erase(found);
+      }
+      --pending_count_;
+      busy_keys_.insert(key);
+      ++running_count_;
+
+      op->state = State::Running;
+      op->started = Clock::now();
+      ++started_;
+      total_queue_ms_ += elapsedMs(op->created, op->started);
+      task = std::move(op->task);
+      op->task = nullptr;
+      if (!op->parent_id.empty()) {
+        updateParentLocked(op->parent_id);
+      }
+      if (op->timeout.count() > 0) {
+        timed_.push_back(op);
+        timer_cv_.notify_one();
+      }
+    }
+
+    Progress progress(*this, op->id);
+    bool ok = false;
+    std::string error;
+    try {
+      ok = task ? task(progress, error) : true;
+    } catch (const std::exception &e) {
+      error = e.what();
+    } catch (...) {
+      error = "Unknown error";
+    }
+    task = nullptr; // Release captures outside the lock
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --running_count_;
+      if (isFinished(op->state)) {
+        // Already reported as timed out; only now is the key free again
+        std::cerr << "[OperationExecutor] " << op->type << " of '" << op->key
+                  << "' returned "
+                  << static_cast<long long>(
+                         elapsedMs(op->started, Clock::now()))
+                  << " ms after start (timed out earlier)" << std::endl;
+      } else if (ok) {
+        finishLocked(*op, State::Succeeded, "");
+      } else {
+        finishLocked(*op, State::Failed,
+                     error.empty() ? "Operation failed" : error);
+      }
+      busy_keys_.erase(key);
+      if (pending_.count(key) != 0) {
+        ready_keys_.push_back(key);
+        work_cv_.notify_one();
+      }
+      pruneLocked();
+    }
+    done_cv_.notify_all();
+    dispatchEvents();
+  }
+}
+
+void OperationExecutor::timerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (running_.load(std::memory_order_acquire)) {
+    const auto now = Clock::now();
+    auto next = Clock::time_point::max();
+    bool expired = false;
+    for (auto it = timed_.begin(); it != timed_.end();) {
+      Operation &op = **it;
+      const auto deadline = op.started + op.timeout;
+      if (isFinished(op.state)) {
+        it = timed_.erase(it);
+      } else if (deadline <= now) {
+        ++timed_out_;
+        finishLocked(op, State::Failed,
+                     "Timed out after " + std::to_string(op.timeout.count()) +
+                         " ms");
+        it = timed_.erase(it);
+        expired = true;
+      } else {
+        next = std::min(next, deadline);
+        ++it;
+      }
+    }
+
+    if (expired) {
+      lock.unlock();
+      done_cv_.notify_all();
+      dispatchEvents();
+      lock.lock();
+      continue;
+    }
+    if (next == Clock::time_point::max()) {
+      timer_cv_.wait(lock);
+    } else {
+      timer_cv_.wait_until(lock, next);
+    }
+  }
+}
+
+void OperationExecutor::dispatchEvents() {
+  // One dispatcher at a time, so observers see events in the order they
+  // were produced even when several workers finish together
+  std::lock_guard<std::mutex> dispatchLock(dispatch_mutex_);
+  std::vector<PendingEvent> events;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    events.swap(events_);
+  }
+  for (const auto &event : events) {
+    try {
+      (*event.observer)(event.event, event.data);
+    } catch (const std::exception &e) {
+      std::cerr << "[OperationExecutor] Batch observer failed: " << e.what()
+                << std::endl;
+    }
+  }
+}
+
+void OperationExecutor::finishLocked(Operation &op, State state,
+                                     const std::string &error) {
+  op.state = state;
+  op.error = error;
+  op.finished = Clock::now();
+  if (state == State::Succeeded) {
+    op.progress = 1.0;
+    ++succeeded_;
+  } else if (state == State::Failed) {
+    ++failed_;
+  } else {
+    ++cancelled_;
+  }
+  if (state != State::Cancelled) {
+    ++finished_;
+    total_run_ms_ += elapsedMs(op.started, op.finished);
+  }
+
+  recent_finishes_.push_back(op.finished);
+  while (!recent_finishes_.empty() &&
+         op.finished - recent_finishes_.front() > std::chrono::seconds(60)) {
+    recent_finishes_.pop_front();
+  }
+
+  if (op.parent_id.empty()) {
+    return;
+  }
+  auto parent = operations_.find(op.parent_id);
+  if (parent == operations_.end()) {
+    return;
+  }
+  Operation &batch = *parent->second;
+  if (batch.observer) {
+    events_.push_back({batch.observer, "instance", toJsonLocked(op, false)});
+  }
+  // A finished child frees a slot for the next held-back one
+  if (accepting_ && !batch.deferred.empty()) {
+    auto next = std::move(batch.deferred.front());
+    batch.deferred.pop_front();
+    --deferred_count_;
+    enqueueLocked(next);
+  }
+  updateParentLocked(op.parent_id);
+}
+
+void OperationExecutor::updateParentLocked(const std::string &parentId) {
+  auto found = operations_.find(parentId);
+  if (found == operations_.end()) {
+    return;
+  }
+  Operation &parent = *found->second;
+  if (isFinished(parent.state)) {
+    return;
+  }
+
+  size_t done = 0, failed = 0, cancelled = 0, started = 0;
+  double progress = 0.0;
+  for (const auto &childId : parent.children) {
+    auto child = operations_.find(childId);
+    if (child == operations_.end()) {
+      continue;
+    }
+    const Operation &op = *child->second;
+    progress += op.progress;
+    if (op.started != Clock::time_point()) {
+      ++started;
+    }
+    if (isFinished(op.state)) {
+      ++done;
+      failed += op.state == State::Failed;
+      cancelled += op.state == State::Cancelled;
+    }
+  }
+
+  const size_t total = parent.children.size();
+  parent.progress = total == 0 ? 1.0 : progress / static_cast<double>(total);
+  parent.step = std::to_string(done) + "/" + std::to_string(total) + " done";
+  if (started > 0 && parent.state == State::Queued) {
+    parent.state = State::Running;
+    parent.started = Clock::now();
+  }
+  if (done < total) {
+    return;
+  }
+
+  if (parent.state == State::Queued) {
+    parent.started = Clock::now();
+  }
+  parent.finished = Clock::now();
+  if (failed > 0) {
+    parent.state = State::Failed;
+    parent.error = std::to_string(failed) + " of " + std::to_string(total) +
+                   " operations failed";
+  } else if (cancelled > 0) {
+    parent.state = State::Cancelled;
+    parent.error = std::to_string(cancelled) + " of " +
+                   std::to_string(total) + " operations cancelled";
+  } else {
+    parent.state = State::Succeeded;
+  }
+  if (parent.observer) {
+    events_.push_back({parent.observer, "done", toJsonLocked(parent, true)});
+    parent.observer.reset(); // Drop captures (e.g. the client stream)
+  }
+}
+
+void OperationExecutor::pruneLocked() {
+  const auto now = Clock::now();
+  size_t excess = operations_.size() > config_.max_retained
+                      ? operations_.size() - config_.max_retained
+                      : 0;
+
+  for (auto it = order_.begin(); it != order_.end();) {
+    auto found = operations_.find(*it);
+    if (found == operations_.end()) {
+      it = order_.erase(it);
+      continue;
+    }
+    const Operation &op = *found->second;
+    bool expired = isFinished(op.state) &&
+                   now - op.finished > config_.retention;
+    if (excess == 0 && !expired) {
+      break; // Oldest first: nothing further is due yet
+    }
+    // Keep in-flight operations, and children while their batch is listed
+    if (!isFinished(op.state) ||
+        (!op.parent_id.empty() && operations_.count(op.parent_id) != 0)) {
+      ++it;
+      continue;
+    }
+    operations_.erase(found);
+    it = order_.erase(it);
+    if (excess > 0) {
+      --excess;
+    }
+  }
+}
+
+void OperationExecutor::setProgress(const std::string &id, double fraction,
+                                    const std::string &step) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto found = operations_.find(id);
+  if (found == operations_.end()) {
+    return;
+  }
+  Operation &op = *found->second;
+  if (isFinished(op.state)) {
+    return; // Timed out while the task kept going
+  }
+  op.progress = std::max(op.progress, std::clamp(fraction, 0.0, 1.0));
+  if (!step.empty()) {
+    op.step = step;
+  }
+  if (!op.parent_id.empty()) {
+    updateParentLocked(op.parent_id);
+  }
+}
+
+std::optional<OperationExecutor::State>
+OperationExecutor::wait(const std::string &id,
+                        std::chrono::milliseconds timeout) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto found = operations_.find(id);
+  if (found == operations_.end()) {
+    return std::nullopt;
+  }
+  // Hold a reference: the entry may be pruned while we wait
+  auto op = found->second;
+  auto finished = [&op] { return isFinished(op->state); };
+  if (timeout == std::chrono::milliseconds::max()) {
+    done_cv_.wait(lock, finished);
+  } else if (!done_cv_.wait_for(lock, timeout, finished)) {
+    return std::nullopt;
+  }
+  return op->state;
+}
+
+std::optional<OperationExecutor::State>
+OperationExecutor::getState(const std::string &id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto found = operations_.find(id);
+  if (found == operations_.end()) {
+    return std::nullopt;
+  }
+  return found->second->state;
+}
+
+Json::Value OperationExecutor::toJsonLocked(const Operation &op,
+                                            bool withChildren) const {
+  Json::Value json;
+  json["operationId"] = op.id;
+  json["type"] = op.type;
+  if (!op.key.empty()) {
+    json["instanceId"] = op.key;
+  }
+  json["state"] = stateName(op.state);
+  json["progress"] = std::round(op.progress * 1000.0) / 1000.0;
+  if (!op.step.empty()) {
+    json["step"] = op.step;
+  }
+  if (!op.error.empty()) {
+    json["error"] = op.error;
+  }
+  json["createdAt"] = formatUtc(op.created_wall);
+
+  auto wallAt = [&op](Clock::time_point tp) {
+    return op.created_wall +
+           std::chrono::duration_cast<std::chrono::system_clock::duration>(
+               tp - op.created);
+  };
+  const auto now = Clock::now();
+  if (op.started == Clock::time_point()) {
+    // Queued, or cancelled before it ran
+    auto end = isFinished(op.state) ? op.finished : now;
+    json["queuedMs"] = static_cast<Json::Int64>(elapsedMs(op.created, end));
+  } else {
+    json["startedAt"] = formatUtc(wallAt(op.started));
+    json["queuedMs"] =
+        static_cast<Json::Int64>(elapsedMs(op.created, op.started));
+    auto end = isFinished(op.state) ? op.finished : now;
+    json["durationMs"] = static_cast<Json::Int64>(elapsedMs(op.started, end));
+  }
+  if (isFinished(op.state)) {
+    json["finishedAt"] = formatUtc(wallAt(op.finished));
+  }
+  if (!op.parent_id.empty()) {
+    json["parentId"] = op.parent_id;
+  }
+
+  if (op.batch) {
+    Json::Value summary;
+    summary["total"] = static_cast<Json::UInt64>(op.children.size());
+    Json::UInt64 counts[5] = {0, 0, 0, 0, 0};
+    Json::Value children(Json::arrayValue);
+    for (const auto &childId : op.children) {
+      auto child = operations_.find(childId);
+      if (child == operations_.end()) {
+        continue;
+      }
+      ++counts[static_cast<int>(child->second->state)];
+      if (withChildren) {
+        children.append(toJsonLocked(*child->second, false));
+      }
+    }
+    summary["queued"] = counts[static_cast<int>(State::Queued)];
+    summary["running"] = counts[static_cast<int>(State::Running)];
+    summary["succeeded"] = counts[static_cast<int>(State::Succeeded)];
+    summary["failed"] = counts[static_cast<int>(State::Failed)];
+    summary["cancelled"] = counts[static_cast<int>(State::Cancelled)];
+    json["summary"] = summary;
+    if (withChildren) {
+      json["children"] = children;
+    }
+  }
+  return json;
+}
+
+std::optional<Json::Value>
+OperationExecutor::getOperationJson(const std::string &id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto found = operations_.find(id);
+  if (found == operations_.end()) {
+    return std::nullopt;
+  }
+  return toJsonLocked(*found->second, true);
+}
+
+Json::Value OperationExecutor::listOperationsJson(const std::string &key,
+                                                  size_t limit) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Json::Value list(Json::arrayValue);
+  for (auto it = order_.rbegin(); it != order_.rend() && list.size() < limit;
+       ++it) {
+    auto found = operations_.find(*it);
+    if (found == operations_.end()) {
+      continue;
+    }
+    const Operation &op = *found->second;
+    if (key.empty() ? !op.parent_id.empty() : op.key != key) {
+      continue;
+    }
+    list.append(toJsonLocked(op, false));
+  }
+  return list;
+}
+
+OperationExecutor::Stats OperationExecutor::getStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Stats stats;
+  stats.workers = workers_.size();
+  stats.queued = pending_count_ + deferred_count_;
+  stats.running = running_count_;
+  stats.retained = operations_.size();
+  stats.submitted = submitted_;
+  stats.succeeded = succeeded_;
+  stats.failed = failed_;
+  stats.cancelled = cancelled_;
+  stats.rejected = rejected_;
+  stats.timed_out = timed_out_;
+  stats.avg_queue_ms =
+      started_ > 0 ? total_queue_ms_ / static_cast<double>(started_) : 0.0;
+  stats.avg_run_ms =
+      finished_ > 0 ? total_run_ms_ / static_cast<double>(finished_) : 0.0;
+  const auto now = Clock::now();
+  stats.completed_per_minute = static_cast<double>(std::count_if(
+      recent_finishes_.begin(), recent_finishes_.end(),
+      [&now](Clock::time_point tp) {
+        return now - tp <= std::chrono::seconds(60);
+      }));
+  return stats;
+}
+
+Json::Value OperationExecutor::getStatsJson() const {
+  Stats stats = getStats();
+  Json::Value json;
+  json["workers"] = static_cast<Json::UInt64>(stats.workers);
+  json["queued"] = static_cast<Json::UInt64>(stats.queued);
+  json["running"] = static_cast<Json::UInt64>(stats.running);
+  json["retained"] = static_cast<Json::UInt64>(stats.retained);
+  json["submitted"] = static_cast<Json::UInt64>(stats.submitted);
+  json["succeeded"] = static_cast<Json::UInt64>(stats.succeeded);
+  json["failed"] = static_cast<Json::UInt64>(stats.failed);
+  json["cancelled"] = static_cast<Json::UInt64>(stats.cancelled);
+  json["rejected"] = static_cast<Json::UInt64>(stats.rejected);
+  json["timed_out"] = static_cast<Json::UInt64>(stats.timed_out);
+  json["avg_queue_ms"] = stats.avg_queue_ms;
+  json["avg_run_ms"] = stats.avg_run_ms;
+  json["completed_per_minute"] = stats.completed_per_minute;
+  return json;
+}
@@ -2,7 +2,11 @@
 #include "config/system_config.h"
 #include "core/cvedix_validator.h"
 #include "core/env_config.h"
+#include "core/motion_gate_node.h"
 #include "core/platform_detector.h"
+#include "core/synthetic_nodes.h"
+#include "utils/gstreamer_capabilities.h"
+#include "videos/offline_segment_pipeline.h"
 #include <cstdlib> // For setenv
 #include <cstring> // For strlen
 #include <cvedix/nodes/ba/cvedix_ba_crossline_node.h>
@@ -115,6 +119,7 @@
 // #include <cvedix/nodes/broker/cvedix_expr_socket_broker_node.h>
 #include <algorithm>
 #include <cctype>
+#include <climits>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
@@ -135,6 +140,33 @@ namespace fs = std::filesystem;
 // Static flag to ensure CVEDIX logger is initialized only once
 static std::once_flag cvedix_init_flag;
 
+// Parse a gstreamer.plugin_rank value as GST_PLUGIN_FEATURE_RANK does:
+// a number or NONE/MARGINAL/SECONDARY/PRIMARY/MAX. -1 if unset or invalid.
+static int parsePluginRank(const std::string &rank) {
+  if (rank.empty()) {
+    return -1;
+  }
+  static const std::map<std::string, int> names = {{"NONE", 0},
+                                                   {"MARGINAL", 64},
+                                                   {"SECONDARY", 128},
+                                                   {"PRIMARY", 256},
+                                                   {"MAX", INT_MAX}};
+  std::string upper = rank;
+  std::transform(upper.begin(), upper.end(), upper.begin(),
+                 [](unsigned char c) { return std::toupper(c); });
+  auto it = names.find(upper);
+  if (it != names.end()) {
+    return it->second;
+  }
+  try {
+    size_t used = 0;
+    int value = std::stoi(rank, &used);
+    return used == rank.size() && value >= 0 ? value : -1;
+  } catch (...) {
+    return -1;
+  }
+}
+
 // Helper function to select decoder from priority list
 static std::string
 selectDecoderFromPriority(const std::string &defaultDecoder) {
@@ -156,16 +188,35 @@ selectDecoderFromPriority(const std::string &defaultDecoder) {
         {"software", "avdec_h264"}   // Software decoder
     };
 
-    // Try decoders in priority order
+    // Try decoders in priority order, skipping those the GStreamer registry
+    // does not have. Without a manifest (no GStreamer tools found) the first
+    // mapped decoder is used as before.
+    auto &capabilities = GStreamerCapabilities::getInstance();
+    bool known = capabilities.isKnown();
     for (const auto &priorityDecoder : decoderList) {
       auto it = decoderMap.find(priorityDecoder);
-      if (it != decoderMap.end()) {
-        // Check if decoder is available (simple check - could be enhanced)
-        // For now, return first available in priority order
-        std::cerr << "[PipelineBuilder] Selected decoder from priority: "
+      if (it == decoderMap.end()) {
+        continue;
+      }
+      if (known && !capabilities.has(it->second)) {
+        std::cerr << "[PipelineBuilder] Decoder not available, skipping: "
                   << priorityDecoder << " -> " << it->second << std::endl;
-        return it->second;
+        continue;
+      }
+      int rank =
+          parsePluginRank(systemConfig.getGStreamerPluginRank(it->second));
+      if (rank < 0 && known) {
+        rank = capabilities.rank(it->second);
+      }
+      if (rank == 0) {
+        // GST_RANK_NONE: never auto-plugged, skip like decodebin would
+        std::cerr << "[PipelineBuilder] Decoder has rank 0, skipping: "
+                  << priorityDecoder << " -> " << it->second << std::endl;
+        continue;
       }
+      std::cerr << "[PipelineBuilder] Selected decoder from priority: "
+                << priorityDecoder << " -> " << it->second << std::endl;
+      return it->second;
     }
 
     // If no match, return default
@@ -425,6 +476,20 @@ static void ensureCVEDIXInitialized() {
   });
 }
 
+// Node types that run the primary (full-frame) detector; a motion gate is
+// inserted in front of the first one
+static bool isPrimaryDetectorType(const std::string &nodeType) {
+  static const std::set<std::string> kTypes = {
+      "yunet_face_detector",   "trt_yolov8_detector",
+      "trt_yolov8_seg_detector", "trt_yolov8_pose_detector",
+      "trt_vehicle_detector",  "rknn_yolov8_detector",
+      "rknn_yolov11_detector", "rknn_face_detector",
+      "yolo_detector",         "yolov11_detector",
+      "mask_rcnn_detector",    "openpose_detector",
+      "synthetic_detector"};
+  return kTypes.count(nodeType) > 0;
+}
+
 std::vector<std::shared_ptr<cvedix_nodes::cvedix_node>>
 PipelineBuilder::buildPipeline(const SolutionConfig &solution,
                                const CreateInstanceRequest &req,
@@ -679,9 +744,58 @@ PipelineBuilder::buildPipeline(const SolutionConfig &solution,
     }
   }
 
+  // SmartDetection: gate the first detector on motion unless the solution
+  // already places its own motion_gate node
+  bool insertMotionGate = motionGateRequested(req);
+  for (const auto &nodeConfig : solution.pipeline) {
+    if (nodeConfig.nodeType == "motion_gate") {
+      insertMotionGate = false;
+      break;
+    }
+  }
+
+  // A motion gate hands the frames it skips to a join node right after the
+  // detector it feeds, so they reach the tracker and outputs with the last
+  // detections instead of being dropped
+  std::shared_ptr<MotionGateNode> gateAwaitingJoin;
+  auto joinMotionGate = [&]() {
+    if (!gateAwaitingJoin || nodes.empty() ||
+        !isPrimaryDetectorType(nodeTypes.back())) {
+      return;
+    }
+    auto joinNode =
+        std::make_shared<MotionGateJoinNode>("motion_gate_join_" + instanceId);
+    joinNode->attach_to({nodes.back()});
+    gateAwaitingJoin->setJoin(joinNode);
+    gateAwaitingJoin.reset();
+    nodes.push_back(joinNode);
+    nodeTypes.push_back("motion_gate_join");
+    std::cerr << "[PipelineBuilder] Inserted motion gate join after "
+              << nodeTypes[nodeTypes.size() - 2] << std::endl;
+  };
+
   // Build nodes in pipeline order
   for (const auto &nodeConfig : solution.pipeline) {
     try {
+      joinMotionGate();
+      if (insertMotionGate && isPrimaryDetectorType(nodeConfig.nodeType) &&
+          !nodes.empty()) {
+        insertMotionGate = false;
+        auto gateNode = createMotionGateNode(
+            "motion_gate_" + instanceId, std::map<std::string, std::string>(),
+            req);
+        if (hasMultipleSources && !multipleSourceNodes.empty()) {
+          gateNode->attach_to(multipleSourceNodes);
+        } else {
+          gateNode->attach_to({nodes.back()});
+        }
+        nodes.push_back(gateNode);
+        nodeTypes.push_back("motion_gate");
+        gateAwaitingJoin = std::dynamic_pointer_cast<MotionGateNode>(gateNode);
+        std::cerr << "[PipelineBuilder] Inserted motion gate before "
+                  << nodeConfig.nodeType << " (SmartDetection)" << std::endl;
+      }
+
       std::cerr << "[PipelineBuilder] Creating node: " << nodeConfig.nodeType
                 << " (" << nodeConfig.nodeName << ")" << std::endl;
 
@@ -711,10 +825,18 @@ PipelineBuilder::buildPipeline(const SolutionConfig &solution,
       if (node) {
         nodes.push_back(node);
         nodeTypes.push_back(nodeConfig.nodeType);
+        if (nodeConfig.nodeType == "motion_gate") {
+          gateAwaitingJoin = std::dynamic_pointer_cast<MotionGateNode>(node);
+        }
 
         // Connect to previous node(s)
         // For nodes that should attach to multiple sources (detector, tracker), attach to all source nodes
-        if (hasMultipleSources && !multipleSourceNodes.empty()) {
+        // (a motion gate or its join already merges the sources, so attach
+        // after it)
+        if (hasMultipleSources && !multipleSourceNodes.empty() &&
+            nodeTypes.size() > 1 &&
+            nodeTypes[nodeTypes.size() - 2] != "motion_gate" &&
+            nodeTypes[nodeTypes.size() - 2] != "motion_gate_join") {
           // Check if this node should attach to all sources (detector, tracker, etc.)
           if (nodeConfig.nodeType == "yolo_detector" || 
               nodeConfig.nodeType == "trt_vehicle_detector" ||
@@ -887,6 +1009,7 @@ PipelineBuilder::buildPipeline(const SolutionConfig &solution,
                                nodeConfig.nodeType);
     }
   }
+  joinMotionGate();
 
   // Auto-add file_des node if RECORD_PATH is set in additionalParams
   auto recordPathIt = req.additionalParams.find("RECORD_PATH");
@@ -2543,6 +2666,24 @@ PipelineBuilder::createNode(const SolutionConfig::NodeConfig &nodeConfig,
       return createRTMPDestinationNode(nodeName, params, req, instanceId, existingRTMPStreamKeys);
     } else if (nodeConfig.nodeType == "screen_des") {
       return createScreenDestinationNode(nodeName, params);
+    }
+    // Synthetic nodes (load testing without cameras or models)
+    else if (nodeConfig.nodeType == "synthetic_src") {
+      return createSyntheticSourceNode(nodeName, params);
+    } else if (nodeConfig.nodeType == "synthetic_detector") {
+      return createSyntheticDetectorNode(nodeName, params);
+    } else if (nodeConfig.nodeType == "synthetic_ba") {
+      return createSyntheticBANode(nodeName);
+    } else if (nodeConfig.nodeType == "synthetic_broker") {
+      return createSyntheticBrokerNode(nodeName, params);
+    }
+    // Offline video jobs (segment of a file, unpaced)
+    else if (nodeConfig.nodeType == "offline_segment_src") {
+      return createOfflineSegmentSourceNode(nodeName, params);
+    }
+    // Motion gate (SmartDetection)
+    else if (nodeConfig.nodeType == "motion_gate") {
+      return createMotionGateNode(nodeName, params, req);
     } else {
       std::cerr << "[PipelineBuilder] Unknown node type: "
                 << nodeConfig.nodeType << std::endl;
@@ -2618,10 +2759,11 @@ PipelineBuilder::createRTSPSourceNode(
     }
 
     // Get skip_interval (0 means no skip)
-    // Priority: additionalParams SKIP_INTERVAL > params skip_interval > default
-    // (0)
+    // Priority: additionalParams SKIP_INTERVAL > AUTO_SKIP_INTERVAL (set by
+    // SourceAutoTuneMonitor) > params skip_interval > default (0)
     int skipInterval = 0;
     auto skipIt = req.additionalParams.find("SKIP_INTERVAL");
+    auto autoSkipIt = req.additionalParams.find("AUTO_SKIP_INTERVAL");
     if (skipIt != req.additionalParams.end() && !skipIt->second.empty()) {
       try {
         skipInterval = std::stoi(skipIt->second);
@@ -2632,6 +2774,17 @@ PipelineBuilder::createRTSPSourceNode(
         std::cerr << "[PipelineBuilder] Warning: Invalid SKIP_INTERVAL value '"
                   << skipIt->second << "', using default 0" << std::endl;
       }
+    } else if (autoSkipIt != req.additionalParams.end() &&
+               !autoSkipIt->second.empty()) {
+      try {
+        skipInterval = std::max(0, std::stoi(autoSkipIt->second));
+        std::cerr << "[PipelineBuilder] Using auto-tuned skip_interval: "
+                  << skipInterval << std::endl;
+      } catch (const std::exception &e) {
+        std::cerr
+            << "[PipelineBuilder] Warning: Invalid AUTO_SKIP_INTERVAL value '"
+            << autoSkipIt->second << "', using default 0" << std::endl;
+      }
     } else if (params.count("skip_interval")) {
       skipInterval = std::stoi(params.at("skip_interval"));
     }
@@ -2649,9 +2802,9 @@ PipelineBuilder::createRTSPSourceNode(
       codecType = params.at("codec_type");
     }
 
-    // Priority: additionalParams RESIZE_RATIO > params resize_ratio > params
-    // scale > default This allows runtime override of resize_ratio for RTSP
-    // streams
+    // Priority: additionalParams RESIZE_RATIO > AUTO_RESIZE_RATIO (set by
+    // SourceAutoTuneMonitor) > params resize_ratio > params scale > default
+    // This allows runtime override of resize_ratio for RTSP streams
     bool resizeRatioFromAdditionalParams = false;
     auto resizeIt = req.additionalParams.find("RESIZE_RATIO");
     if (resizeIt != req.additionalParams.end() && !resizeIt->second.empty()) {
@@ -2667,6 +2820,22 @@ PipelineBuilder::createRTSPSourceNode(
                   << std::endl;
       }
     }
+    auto autoResizeIt = req.additionalParams.find("AUTO_RESIZE_RATIO");
+    if (!resizeRatioFromAdditionalParams &&
+        autoResizeIt != req.additionalParams.end() &&
+        !autoResizeIt->second.empty()) {
+      try {
+        resize_ratio = std::stof(autoResizeIt->second);
+        resizeRatioFromAdditionalParams = true;
+        std::cerr << "[PipelineBuilder] Using auto-tuned resize_ratio: "
+                  << resize_ratio << std::endl;
+      } catch (const std::exception &e) {
+        std::cerr
+            << "[PipelineBuilder] Warning: Invalid AUTO_RESIZE_RATIO value '"
+            << autoResizeIt->second << "', using value from params or default"
+            << std::endl;
+      }
+    }
 
     // Check if resize_ratio is specified in params (from solution config)
     // Only override if RESIZE_RATIO was NOT set in additionalParams (highest
@@ -3470,8 +3639,87 @@ PipelineBuilder::getRTSPUrl(const CreateInstanceRequest &req) const {
   return "rtsp://localhost:8554/stream";
 }
 
+namespace {
+// Resolution cache key: includes the environment roots so that changing
+// CVEDIX_DATA_ROOT / CVEDIX_SDK_ROOT never serves a stale result
+std::string modelResolutionKey(const std::string &kind,
+                               const std::string &a, const std::string &b) {
+  const char *dataRoot = std::getenv("CVEDIX_DATA_ROOT");
+  const char *sdkRoot = std::getenv("CVEDIX_SDK_ROOT");
+  return kind + "|" + (dataRoot ? dataRoot : "") + "|" +
+         (sdkRoot ? sdkRoot : "") + "|" + a + "|" + b;
+}
+} // namespace
+
+bool PipelineBuilder::modelFileExists(const std::string &path) const {
+  switch (ModelCatalog::getInstance().lookupFile(path)) {
+  case ModelCatalog::Lookup::Found:
+    return true;
+  case ModelCatalog::Lookup::Missing:
+    return false;
+  case ModelCatalog::Lookup::Unknown:
+    break;
+  }
+  std::error_code ec;
+  return fs::exists(path, ec);
+}
+
+bool PipelineBuilder::modelDirectoryExists(const std::string &dir) const {
+  switch (ModelCatalog::getInstance().lookupDirectory(dir)) {
+  case ModelCatalog::Lookup::Found:
+    return true;
+  case ModelCatalog::Lookup::Missing:
+    return false;
+  case ModelCatalog::Lookup::Unknown:
+    break;
+  }
+  std::error_code ec;
+  return fs::is_directory(dir, ec);
+}
+
+std::vector<ModelCatalog::ModelEntry>
+PipelineBuilder::listModelDirectory(const std::string &dir) const {
+  std::vector<ModelCatalog::ModelEntry> entries;
+  if (ModelCatalog::getInstance().listDirectory(dir, false, entries)) {
+    return entries;
+  }
+
+  // Filesystem fallback (catalog not running or directory not covered)
+  try {
+    for (const auto &entry : fs::directory_iterator(dir)) {
+      if (fs::is_regular_file(entry.path())) {
+        ModelCatalog::ModelEntry model;
+        model.path = entry.path().string();
+        model.filename = entry.path().filename().string();
+        entries.push_back(std::move(model));
+      }
+    }
+  } catch (const std::exception &e) {
+    // Ignore directory iteration errors
+  }
+  return entries;
+}
+
 std::string
 PipelineBuilder::resolveModelPath(const std::string &relativePath) const {
+  auto &catalog = ModelCatalog::getInstance();
+  if (!catalog.isRunning()) {
+    return resolveModelPathUncached(relativePath);
+  }
+
+  std::string key = modelResolutionKey("path", relativePath, "");
+  std::string cached;
+  if (catalog.getCachedResolution(key, cached)) {
+    return cached;
+  }
+  uint64_t generation = catalog.getGeneration();
+  std::string resolved = resolveModelPathUncached(relativePath);
+  catalog.cacheResolution(key, resolved, generation);
+  return resolved;
+}
+
+std::string PipelineBuilder::resolveModelPathUncached(
+    const std::string &relativePath) const {
   // Helper function to resolve model file paths
   // Priority:
   // 1. CVEDIX_DATA_ROOT environment variable
@@ -3489,7 +3737,7 @@ PipelineBuilder::resolveModelPath(const std::string &relativePath) const {
     if (path.back() != '/')
       path += '/';
     path += relativePath;
-    if (fs::exists(path)) {
+    if (modelFileExists(path)) {
       std::cerr << "[PipelineBuilder] Using CVEDIX_DATA_ROOT: " << path
                 << std::endl;
       return path;
@@ -3503,7 +3751,7 @@ PipelineBuilder::resolveModelPath(const std::string &relativePath) const {
     if (path.back() != '/')
       path += '/';
     path += "cvedix_data/" + relativePath;
-    if (fs::exists(path)) {
+    if (modelFileExists(path)) {
       std::cerr << "[PipelineBuilder] Using CVEDIX_SDK_ROOT: " << path
                 << std::endl;
       return path;
@@ -3518,14 +3766,14 @@ PipelineBuilder::resolveModelPath(const std::string &relativePath) const {
     std::string modelPath =
         relativePath.substr(relativePath.find_first_of("/\\") + 1);
     std::string optPath = "/opt/edge_ai_api/models/" + modelPath;
-    if (fs::exists(optPath)) {
+    if (modelFileExists(optPath)) {
       std::cerr << "[PipelineBuilder] Using production path: " << optPath
                 << std::endl;
       return optPath;
     }
     // Also try direct path if relativePath is just a filename
     std::string optPathDirect = "/opt/edge_ai_api/models/" + relativePath;
-    if (fs::exists(optPathDirect)) {
+    if (modelFileExists(optPathDirect)) {
       std::cerr << "[PipelineBuilder] Using production path: " << optPathDirect
                 << std::endl;
       return optPathDirect;
@@ -3533,7 +3781,7 @@ PipelineBuilder::resolveModelPath(const std::string &relativePath) const {
   } else {
     // Try direct model file in /opt/edge_ai_api/models
     std::string optPath = "/opt/edge_ai_api/models/" + relativePath;
-    if (fs::exists(optPath)) {
+    if (modelFileExists(optPath)) {
       std::cerr << "[PipelineBuilder] Using production path: " << optPath
                 << std::endl;
       return optPath;
@@ -3554,7 +3802,7 @@ PipelineBuilder::resolveModelPath(const std::string &relativePath) const {
   };
 
   for (const auto &path : systemPaths) {
-    if (fs::exists(path)) {
+    if (modelFileExists(path)) {
       std::cerr << "[PipelineBuilder] Found in system-wide location: " << path
                 << std::endl;
       return path;
@@ -3565,7 +3813,7 @@ PipelineBuilder::resolveModelPath(const std::string &relativePath) const {
     // "face_detection_yunet_2023mar.onnx" instead of "yunet.onnx"
     if (relativePath.find("yunet.onnx") != std::string::npos) {
       fs::path dirPath = fs::path(path).parent_path();
-      if (fs::exists(dirPath) && fs::is_directory(dirPath)) {
+      if (modelDirectoryExists(dirPath.string())) {
         // Look for alternative yunet files (prefer newer versions)
         std::vector<std::string> alternatives = {
             "face_detection_yunet_2023mar.onnx", // Newer version (preferred)
@@ -3576,7 +3824,7 @@ PipelineBuilder::resolveModelPath(const std::string &relativePath) const {
 
         for (const auto &alt : alternatives) {
           fs::path altPath = dirPath / alt;
-          if (fs::exists(altPath)) {
+          if (modelFileExists(altPath.string())) {
             std::cerr << "[PipelineBuilder] Found alternative yunet model: "
                       << altPath.string() << std::endl;
             return altPath.string();
@@ -3595,7 +3843,7 @@ PipelineBuilder::resolveModelPath(const std::string &relativePath) const {
   };
 
   for (const auto &path : commonPaths) {
-    if (fs::exists(path)) {
+    if (modelFileExists(path)) {
       std::cerr << "[PipelineBuilder] Found in SDK directory: "
                 << fs::absolute(path).string() << std::endl;
       return path;
@@ -3606,7 +3854,7 @@ PipelineBuilder::resolveModelPath(const std::string &relativePath) const {
   // (./cvedix_data/) NOTE: This path will NOT exist in production - all data
   // should be in /opt/edge_ai_api
   std::string relativePathFull = "./cvedix_data/" + relativePath;
-  if (fs::exists(relativePathFull)) {
+  if (modelFileExists(relativePathFull)) {
     std::cerr << "[PipelineBuilder] Using development relative path: "
               << fs::absolute(relativePathFull).string() << std::endl;
     return relativePathFull;
@@ -3625,6 +3873,25 @@ PipelineBuilder::resolveModelPath(const std::string &relativePath) const {
 std::string
 PipelineBuilder::resolveModelByName(const std::string &modelName,
                                     const std::string &category) const {
+  auto &catalog = ModelCatalog::getInstance();
+  if (!catalog.isRunning()) {
+    return resolveModelByNameUncached(modelName, category);
+  }
+
+  std::string key = modelResolutionKey("name", modelName, category);
+  std::string cached;
+  if (catalog.getCachedResolution(key, cached)) {
+    return cached;
+  }
+  uint64_t generation = catalog.getGeneration();
+  std::string resolved = resolveModelByNameUncached(modelName, category);
+  catalog.cacheResolution(key, resolved, generation);
+  return resolved;
+}
+
+std::string
+PipelineBuilder::resolveModelByNameUncached(const std::string &modelName,
+                                            const std::string &category) const {
   // Resolve model file by name (e.g., "yunet_2023mar", "yunet_2022mar",
   // "yolov8n_face") Supports various naming patterns and extensions
 
@@ -3698,48 +3965,50 @@ PipelineBuilder::resolveModelByName(const std::string &modelName,
 
   // Search for model file
   for (const auto &dir : searchDirs) {
-    fs::path dirPath(dir);
-    if (!fs::exists(dirPath) || !fs::is_directory(dirPath)) {
+    if (!modelDirectoryExists(dir)) {
       continue;
     }
 
+    // List the directory once (served from ModelCatalog when available)
+    // instead of once per pattern/extension combination
+    std::vector<ModelCatalog::ModelEntry> dirEntries = listModelDirectory(dir);
+    auto canonicalOf = [](const ModelCatalog::ModelEntry &entry) {
+      return entry.canonicalPath.empty()
+                 ? fs::canonical(entry.path).string()
+                 : entry.canonicalPath;
+    };
+
     // Try each pattern with each extension
     for (const auto &pattern : patterns) {
       for (const auto &ext : extensions) {
-        fs::path filePath = dirPath / (pattern + ext);
-        if (fs::exists(filePath)) {
-          std::cerr << "[PipelineBuilder] Found model by name '" << modelName
-                    << "' (pattern: " << pattern << ext
-                    << ") at: " << fs::canonical(filePath).string()
-                    << std::endl;
-          return fs::canonical(filePath).string();
+        const std::string candidate = pattern + ext;
+        for (const auto &entry : dirEntries) {
+          if (entry.filename == candidate) {
+            std::string resolved = canonicalOf(entry);
+            std::cerr << "[PipelineBuilder] Found model by name '" << modelName
+                      << "' (pattern: " << pattern << ext
+                      << ") at: " << resolved << std::endl;
+            return resolved;
+          }
         }
 
-        // Also try case-insensitive search (list directory)
-        try {
-          for (const auto &entry : fs::directory_iterator(dirPath)) {
-            if (fs::is_regular_file(entry.path())) {
-              std::string filename = entry.path().filename().string();
-              std::string filenameLower = filename;
-              std::transform(filenameLower.begin(), filenameLower.end(),
-                             filenameLower.begin(), ::tolower);
-
-              std::string patternLower = pattern + ext;
-              std::transform(patternLower.begin(), patternLower.end(),
-                             patternLower.begin(), ::tolower);
-
-              if (filenameLower == patternLower ||
-                  filenameLower.find(patternLower) != std::string::npos) {
-                std::cerr << "[PipelineBuilder] Found model by name '"
-                          << modelName << "' (matched: " << filename
-                          << ") at: " << fs::canonical(entry.path()).string()
-                          << std::endl;
-                return fs::canonical(entry.path()).string();
-              }
-            }
+        // Also try case-insensitive search
+        std::string patternLower = candidate;
+        std::transform(patternLower.begin(), patternLower.end(),
+                       patternLower.begin(), ::tolower);
+        for (const auto &entry : dirEntries) {
+          std::string filenameLower = entry.filename;
+          std::transform(filenameLower.begin(), filenameLower.end(),
+                         filenameLower.begin(), ::tolower);
+
+          if (filenameLower == patternLower ||
+              filenameLower.find(patternLower) != std::string::npos) {
+            std::string resolved = canonicalOf(entry);
+            std::cerr << "[PipelineBuilder] Found model by name '"
+                      << modelName << "' (matched: " << entry.filename
+                      << ") at: " << resolved << std::endl;
+            return resolved;
           }
-        } catch (const std::exception &e) {
-          // Ignore directory iteration errors
         }
       }
     }
@@ -3811,34 +4080,32 @@ PipelineBuilder::listAvailableModels(const std::string &category) const {
   std::set<std::string> uniqueModels; // Use set to avoid duplicates
 
   for (const auto &dir : searchDirs) {
-    fs::path dirPath(dir);
-    if (!fs::exists(dirPath) || !fs::is_directory(dirPath)) {
+    if (!modelDirectoryExists(dir)) {
       continue;
     }
 
     try {
-      for (const auto &entry : fs::directory_iterator(dirPath)) {
-        if (fs::is_regular_file(entry.path())) {
-          std::string filename = entry.path().filename().string();
-          std::string ext = entry.path().extension().string();
-
-          // Check if it's a model file
-          bool isModelFile = false;
-          for (const auto &modelExt : extensions) {
-            if (ext == modelExt ||
-                filename.find(modelExt) != std::string::npos) {
-              isModelFile = true;
-              break;
-            }
+      for (const auto &entry : listModelDirectory(dir)) {
+        const std::string &filename = entry.filename;
+        std::string ext = fs::path(filename).extension().string();
+
+        // Check if it's a model file
+        bool isModelFile = false;
+        for (const auto &modelExt : extensions) {
+          if (ext == modelExt || filename.find(modelExt) != std::string::npos) {
+            isModelFile = true;
+            break;
           }
+        }
 
-          if (isModelFile) {
-            uniqueModels.insert(fs::canonical(entry.path()).string());
-          }
+        if (isModelFile) {
+          uniqueModels.insert(entry.canonicalPath.empty()
+                                  ? fs::canonical(entry.path).string()
+                                  : entry.canonicalPath);
         }
       }
     } catch (const std::exception &e) {
-      // Ignore directory iteration errors
+      // Ignore canonicalization errors
     }
   }
 
@@ -6838,6 +7105,197 @@ PipelineBuilder::createTRTInsightFaceRecognitionNode(
 }
 #endif // CVEDIX_WITH_TRT
 
+// ========== Synthetic Nodes Implementation ==========
+
+std::shared_ptr<cvedix_nodes::cvedix_node>
+PipelineBuilder::createSyntheticSourceNode(
+    const std::string &nodeName,
+    const std::map<std::string, std::string> &params) {
+
+  try {
+    if (nodeName.empty()) {
+      throw std::invalid_argument("Node name cannot be empty");
+    }
+    auto options = SyntheticWorkload::parseSourceOptions(params);
+
+    std::cerr << "[PipelineBuilder] Creating synthetic source node:"
+              << std::endl;
+    std::cerr << "  Name: '" << nodeName << "'" << std::endl;
+    std::cerr << "  Resolution: " << options.width << "x" << options.height
+              << " @ " << options.fps << " fps" << std::endl;
+
+    auto node = std::make_shared<SyntheticNodes::SyntheticSourceNode>(
+        nodeName, options);
+
+    std::cerr << "[PipelineBuilder] ✓ Synthetic source node created "
+                 "successfully"
+              << std::endl;
+    return node;
+  } catch (const std::exception &e) {
+    std::cerr << "[PipelineBuilder] Exception in createSyntheticSourceNode: "
+              << e.what() << std::endl;
+    throw;
+  }
+}
+
+std::shared_ptr<cvedix_nodes::cvedix_node>
+PipelineBuilder::createSyntheticDetectorNode(
+    const std::string &nodeName,
+    const std::map<std::string, std::string> &params) {
+
+  try {
+    if (nodeName.empty()) {
+      throw std::invalid_argument("Node name cannot be empty");
+    }
+    auto options = SyntheticWorkload::parseDetectorOptions(params);
+
+    std::cerr << "[PipelineBuilder] Creating synthetic detector node:"
+              << std::endl;
+    std::cerr << "  Name: '" << nodeName << "'" << std::endl;
+    std::cerr << "  Latency: " << options.latency_ms << "ms (+/- "
+              << options.latency_jitter_ms << "ms, "
+              << (options.busy_wait ? "busy" : "sleep") << ")" << std::endl;
+    std::cerr << "  Boxes per frame: " << options.boxes << std::endl;
+
+    auto node = std::make_shared<SyntheticNodes::SyntheticDetectorNode>(
+        nodeName, options);
+
+    std::cerr << "[PipelineBuilder] ✓ Synthetic detector node created "
+                 "successfully"
+              << std::endl;
+    return node;
+  } catch (const std::exception &e) {
+    std::cerr << "[PipelineBuilder] Exception in createSyntheticDetectorNode: "
+              << e.what() << std::endl;
+    throw;
+  }
+}
+
+std::shared_ptr<cvedix_nodes::cvedix_node>
+PipelineBuilder::createSyntheticBANode(const std::string &nodeName) {
+
+  try {
+    if (nodeName.empty()) {
+      throw std::invalid_argument("Node name cannot be empty");
+    }
+    std::cerr << "[PipelineBuilder] Creating synthetic BA node: '" << nodeName
+              << "'" << std::endl;
+    return std::make_shared<SyntheticNodes::SyntheticBANode>(nodeName);
+  } catch (const std::exception &e) {
+    std::cerr << "[PipelineBuilder] Exception in createSyntheticBANode: "
+              << e.what() << std::endl;
+    throw;
+  }
+}
+
+std::shared_ptr<cvedix_nodes::cvedix_node>
+PipelineBuilder::createSyntheticBrokerNode(
+    const std::string &nodeName,
+    const std::map<std::string, std::string> &params) {
+
+  try {
+    if (nodeName.empty()) {
+      throw std::invalid_argument("Node name cannot be empty");
+    }
+    auto options = SyntheticWorkload::parseBrokerOptions(params);
+
+    std::cerr << "[PipelineBuilder] Creating synthetic broker node: '"
+              << nodeName << "' (serialize: "
+              << (options.serialize ? "true" : "false") << ")" << std::endl;
+    return std::make_shared<SyntheticNodes::SyntheticBrokerNode>(nodeName,
+                                                                 options);
+  } catch (const std::exception &e) {
+    std::cerr << "[PipelineBuilder] Exception in createSyntheticBrokerNode: "
+              << e.what() << std::endl;
+    throw;
+  }
+}
+
+// ========== Offline Video Job Nodes Implementation ==========
+
+std::shared_ptr<cvedix_nodes::cvedix_node>
+PipelineBuilder::createOfflineSegmentSourceNode(
+    const std::string &nodeName,
+    const std::map<std::string, std::string> &params) {
+
+  try {
+    if (nodeName.empty()) {
+      throw std::invalid_argument("Node name cannot be empty");
+    }
+
+    std::cerr << "[PipelineBuilder] Creating offline segment source node:"
+              << std::endl;
+    std::cerr << "  Name: '" << nodeName << "'" << std::endl;
+    for (const char *key : {"file_path", "start_sec", "end_sec"}) {
+      auto it = params.find(key);
+      std::cerr << "  " << key << ": "
+                << (it != params.end() ? it->second : "") << std::endl;
+    }
+
+    return std::make_shared<OfflineSegmentPipeline::OfflineSegmentSourceNode>(
+        nodeName, params);
+  } catch (const std::exception &e) {
+    std::cerr
+        << "[PipelineBuilder] Exception in createOfflineSegmentSourceNode: "
+        << e.what() << std::endl;
+    throw;
+  }
+}
+
+// ========== Motion Gate Implementation ==========
+
+bool PipelineBuilder::motionGateRequested(const CreateInstanceRequest &req) {
+  if (req.detectorMode != "SmartDetection") {
+    return false;
+  }
+  auto it = req.additionalParams.find("MOTION_GATE");
+  if (it == req.additionalParams.end()) {
+    return false;
+  }
+  std::string value = it->second;
+  std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+  return value == "true" || value == "1" || value == "yes" || value == "on";
+}
+
+std::shared_ptr<cvedix_nodes::cvedix_node>
+PipelineBuilder::createMotionGateNode(
+    const std::string &nodeName,
+    const std::map<std::string, std::string> &params,
+    const CreateInstanceRequest &req) {
+
+  try {
+    if (nodeName.empty()) {
+      throw std::invalid_argument("Node name cannot be empty");
+    }
+    std::map<std::string, std::string> gateParams = params;
+    auto sensitivityIt = gateParams.find("sensitivity");
+    if (sensitivityIt == gateParams.end() || sensitivityIt->second.empty() ||
+        sensitivityIt->second.rfind("${", 0) == 0) {
+      gateParams["sensitivity"] = req.movementSensitivity;
+    }
+    auto options = MotionGate::parseOptions(gateParams);
+
+    std::cerr << "[PipelineBuilder] Creating motion gate node:" << std::endl;
+    std::cerr << "  Name: '" << nodeName << "'" << std::endl;
+    std::cerr << "  Sensitivity: " << gateParams["sensitivity"]
+              << " (pixel_threshold=" << options.pixel_threshold
+              << ", min_area=" << options.min_area << ")" << std::endl;
+    std::cerr << "  Analysis width: " << options.analysis_width << std::endl;
+    std::cerr << "  Keep-alive: " << options.keepalive_ms
+              << "ms, hold: " << options.hold_ms << "ms" << std::endl;
+
+    auto node = std::make_shared<MotionGateNode>(nodeName, options);
+
+    std::cerr << "[PipelineBuilder] ✓ Motion gate node created successfully"
+              << std::endl;
+    return node;
+  } catch (const std::exception &e) {
+    std::cerr << "[PipelineBuilder] Exception in createMotionGateNode: "
+              << e.what() << std::endl;
+    throw;
+  }
+}
+
 // ========== Source Nodes Implementation ==========
 
 std::shared_ptr<cvedix_nodes::cvedix_node> PipelineBuilder::createAppSourceNode(
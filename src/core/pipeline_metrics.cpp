@@ -0,0 +1,288 @@
+#include "core/pipeline_metrics.h"
+#include <algorithm>
+#include <sstream>
+
+namespace {
+
+std::string escapeLabel(const std::string &value) {
+  std::string escaped;
+  escaped.reserve(value.size());
+  for (char c : value) {
+    if (c == '\\' || c == '"') {
+      escaped += '\\';
+    }
+    escaped += c == '\n' ? ' ' : c;
+  }
+  return escaped;
+}
+
+// One instance, read once per scrape
+struct Row {
+  const std::string *label = nullptr;
+  uint64_t incoming = 0;
+  uint64_t processed = 0;
+  uint64_t dropped = 0;
+  uint64_t queue_size = 0;
+  double fps = 0.0;
+  double target_fps = -1.0; // < 0: not controlled in this process
+  int backpressure = -1;    // < 0: unknown
+  double latency_ms = 0.0;
+  uint64_t reconnect_attempts = 0;
+  uint64_t reconnect_failures = 0;
+  bool has_incoming = true;
+  bool has_reconnects = true;
+};
+
+} // namespace
+
+PipelineMetricsRegistry::PipelineMetricsRegistry()
+    : snapshot_(std::make_shared<const Snapshot>()) {}
+
+const PipelineMetricsRegistry::Entry *
+PipelineMetricsRegistry::find(const Snapshot &snapshot,
+                              const std::string &instanceId) {
+  auto it = std::lower_bound(snapshot.begin(), snapshot.end(), instanceId,
+                             [](const Entry &entry, const std::string &id) {
+                               return entry.instance_id < id;
+                             });
+  return (it != snapshot.end() && it->instance_id == instanceId) ? &*it
+                                                                 : nullptr;
+}
+
+PipelineMetricsRegistry::Entry &
+PipelineMetricsRegistry::findOrInsert(Snapshot &snapshot,
+                                      const std::string &instanceId) {
+  auto it = std::lower_bound(snapshot.begin(), snapshot.end(), instanceId,
+                             [](const Entry &entry, const std::string &id) {
+                               return entry.instance_id < id;
+                             });
+  if (it == snapshot.end() || it->instance_id != instanceId) {
+    Entry entry;
+    entry.instance_id = instanceId;
+    entry.label = escapeLabel(instanceId);
+    entry.counters = std::make_shared<Counters>();
+    it = snapshot.insert(it, std::move(entry));
+  }
+  return *it;
+}
+
+std::shared_ptr<PipelineMetricsRegistry::Counters>
+PipelineMetricsRegistry::attach(
+    const std::string &instanceId,
+    BackpressureController::InstanceHandle backpressure,
+    std::shared_ptr<QueueTelemetry::InstanceSeries> telemetry) {
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  auto current = load();
+  const Entry *existing = find(*current, instanceId);
+  if (existing && existing->backpressure == backpressure &&
+      existing->telemetry == telemetry) {
+    return existing->counters;
+  }
+
+  auto next = std::make_shared<Snapshot>(*current);
+  Entry &entry = findOrInsert(*next, instanceId);
+  entry.backpressure = std::move(backpressure);
+  entry.telemetry = std::move(telemetry);
+  auto counters = entry.counters;
+  std::atomic_store(&snapshot_, std::shared_ptr<const Snapshot>(next));
+  return counters;
+}
+
+std::shared_ptr<PipelineMetricsRegistry::Counters>
+PipelineMetricsRegistry::counters(const std::string &instanceId) {
+  auto current = load();
+  if (const Entry *entry = find(*current, instanceId)) {
+    return entry->counters;
+  }
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  current = load();
+  if (const Entry *entry = find(*current, instanceId)) {
+    return entry->counters; // Registered while we waited
+  }
+  auto next = std::make_shared<Snapshot>(*current);
+  auto counters = findOrInsert(*next, instanceId).counters;
+  std::atomic_store(&snapshot_, std::shared_ptr<const Snapshot>(next));
+  return counters;
+}
+
+void PipelineMetricsRegistry::updateFromStatistics(
+    const std::string &instanceId, const Json::Value &statistics) {
+  auto c = counters(instanceId);
+  bool hasIncoming = statistics.isMember("frames_incoming");
+  if (hasIncoming) {
+    c->frames_incoming.store(statistics["frames_incoming"].asUInt64(),
+                             std::memory_order_relaxed);
+  }
+  c->has_incoming.store(hasIncoming, std::memory_order_relaxed);
+  bool hasReconnects = statistics.isMember("rtsp_reconnect_attempts");
+  if (hasReconnects) {
+    c->reconnect_attempts.store(
+        statistics["rtsp_reconnect_attempts"].asUInt64(),
+        std::memory_order_relaxed);
+    c->reconnect_failures.store(
+        statistics.get("rtsp_reconnect_failures", 0).asUInt64(),
+        std::memory_order_relaxed);
+  }
+  c->has_reconnects.store(hasReconnects, std::memory_order_relaxed);
+  c->frames_processed.store(statistics.get("frames_processed", 0).asUInt64(),
+                            std::memory_order_relaxed);
+  c->frames_dropped.store(
+      statistics.get("dropped_frames_count", 0).asUInt64(),
+      std::memory_order_relaxed);
+  c->queue_size.store(statistics.get("input_queue_size", 0).asUInt64(),
+                      std::memory_order_relaxed);
+  c->fps.store(statistics.get("current_framerate", 0.0).asDouble(),
+               std::memory_order_relaxed);
+  c->latency_ms.store(statistics.get("latency", 0.0).asDouble(),
+                      std::memory_order_relaxed);
+}
+
+void PipelineMetricsRegistry::recordReconnect(const std::string &instanceId,
+                                              bool success) {
+  auto c = counters(instanceId);
+  c->reconnect_attempts.fetch_add(1, std::memory_order_relaxed);
+  if (!success) {
+    c->reconnect_failures.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void PipelineMetricsRegistry::remove(const std::string &instanceId) {
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  auto current = load();
+  if (!find(*current, instanceId)) {
+    return;
+  }
+  auto next = std::make_shared<Snapshot>();
+  next->reserve(current->size() - 1);
+  for (const auto &entry : *current) {
+    if (entry.instance_id != instanceId) {
+      next->push_back(entry);
+    }
+  }
+  std::atomic_store(&snapshot_, std::shared_ptr<const Snapshot>(next));
+}
+
+size_t PipelineMetricsRegistry::size() const { return load()->size(); }
+
+std::string PipelineMetricsRegistry::getPrometheusMetrics() const {
+  auto snapshot = load();
+  if (snapshot->empty()) {
+    return "";
+  }
+
+  std::vector<Row> rows;
+  rows.reserve(snapshot->size());
+  for (const auto &entry : *snapshot) {
+    const Counters &c = *entry.counters;
+    Row row;
+    row.label = &entry.label;
+    row.incoming = c.frames_incoming.load(std::memory_order_relaxed);
+    row.reconnect_attempts =
+        c.reconnect_attempts.load(std::memory_order_relaxed);
+    row.reconnect_failures =
+        c.reconnect_failures.load(std::memory_order_relaxed);
+    row.latency_ms = c.latency_ms.load(std::memory_order_relaxed);
+    row.has_incoming = c.has_incoming.load(std::memory_order_relaxed);
+    row.has_reconnects = c.has_reconnects.load(std::memory_order_relaxed);
+    if (entry.backpressure) {
+      auto stats = BackpressureController::BackpressureController::getStats(
+          *entry.backpressure);
+      row.processed = stats.frames_processed;
+      row.dropped = stats.frames_dropped;
+      row.queue_size = stats.current_queue_size;
+      row.fps = stats.current_fps;
+      row.target_fps = stats.target_fps;
+      row.backpressure = stats.backpressure_detected ? 1 : 0;
+    } else {
+      row.processed = c.frames_processed.load(std::memory_order_relaxed);
+      row.dropped = c.frames_dropped.load(std::memory_order_relaxed);
+      row.queue_size = c.queue_size.load(std::memory_order_relaxed);
+      row.fps = c.fps.load(std::memory_order_relaxed);
+    }
+    rows.push_back(row);
+  }
+
+  std::ostringstream oss;
+  auto metric = [&oss, &rows](const char *name, const char *type,
+                              const char *help, auto value, auto present) {
+    oss << "# HELP " << name << " " << help << "\n";
+    oss << "# TYPE " << name << " " << type << "\n";
+    for (const auto &row : rows) {
+      if (present(row)) {
+        oss << name << "{instance_id=\"" << *row.label << "\"} " << value(row)
+            << "\n";
+      }
+    }
+  };
+  auto always = [](const Row &) { return true; };
+
+  metric("pipeline_frames_incoming_total", "counter",
+         "Frames received from the source",
+         [](const Row &r) { return r.incoming; },
+         [](const Row &r) { return r.has_incoming; });
+  metric("pipeline_frames_processed_total", "counter",
+         "Frames that went through the pipeline",
+         [](const Row &r) { return r.processed; }, always);
+  metric("pipeline_frames_dropped_total", "counter",
+         "Frames dropped before processing",
+         [](const Row &r) { return r.dropped; }, always);
+  metric("pipeline_fps", "gauge", "Current processing frame rate",
+         [](const Row &r) { return r.fps; }, always);
+  metric("pipeline_target_fps", "gauge",
+         "Frame rate the backpressure controller allows",
+         [](const Row &r) { return r.target_fps; },
+         [](const Row &r) { return r.target_fps >= 0.0; });
+  metric("pipeline_backpressure", "gauge",
+         "1 while the pipeline is under backpressure",
+         [](const Row &r) { return r.backpressure; },
+         [](const Row &r) { return r.backpressure >= 0; });
+  metric("pipeline_queue_depth", "gauge", "Deepest node input queue",
+         [](const Row &r) { return r.queue_size; }, always);
+  metric("pipeline_latency_seconds", "gauge",
+         "Average frame latency reported by the pipeline",
+         [](const Row &r) { return r.latency_ms / 1000.0; },
+         [](const Row &r) { return r.latency_ms > 0.0; });
+  metric("pipeline_rtsp_reconnect_attempts_total", "counter",
+         "RTSP reconnect attempts",
+         [](const Row &r) { return r.reconnect_attempts; },
+         [](const Row &r) { return r.has_reconnects; });
+  metric("pipeline_rtsp_reconnect_failures_total", "counter",
+         "RTSP reconnect attempts that failed",
+         [](const Row &r) { return r.reconnect_failures; },
+         [](const Row &r) { return r.has_reconnects; });
+
+  // Per node: read straight from the telemetry ring buffers
+  std::ostringstream depth;
+  std::ostringstream drops;
+  for (const auto &entry : *snapshot) {
+    if (!entry.telemetry) {
+      continue;
+    }
+    size_t count = entry.telemetry->nodeCount();
+    for (size_t i = 0; i < count; ++i) {
+      const QueueTelemetry::NodeSeries *node = entry.telemetry->node(i);
+      if (!node) {
+        continue;
+      }
+      std::string labels = "{instance_id=\"" + entry.label + "\",node=\"" +
+                           escapeLabel(node->name()) + "\"} ";
+      depth << "pipeline_node_queue_depth" << labels << node->currentDepth()
+            << "\n";
+      drops << "pipeline_node_frames_dropped_total" << labels
+            << node->totalDrops() << "\n";
+    }
+  }
+  if (depth.tellp() > 0) {
+    oss << "# HELP pipeline_node_queue_depth Input queue size of each "
+           "pipeline node\n";
+    oss << "# TYPE pipeline_node_queue_depth gauge\n";
+    oss << depth.str();
+    oss << "# HELP pipeline_node_frames_dropped_total Frames dropped at each "
+           "pipeline node\n";
+    oss << "# TYPE pipeline_node_frames_dropped_total counter\n";
+    oss << drops.str();
+  }
+
+  oss << "\n";
+  return oss.str();
+}
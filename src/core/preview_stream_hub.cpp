@@ -0,0 +1,409 @@
+#include "core/preview_stream_hub.h"
+#include <algorithm>
+#include <iostream>
+
+void PreviewStreamHub::configure(const Config &config) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  config_ = config;
+  config_.max_fps = std::max(1, config_.max_fps);
+  config_.jpeg_quality = std::clamp(config_.jpeg_quality, 1, 100);
+  config_.max_frames_in_flight = std::max(1, config_.max_frames_in_flight);
+}
+
+PreviewStreamHub::Config PreviewStreamHub::getConfig() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return config_;
+}
+
+void PreviewStreamHub::setFrameSource(FrameSource source) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  source_ = std::move(source);
+}
+
+void PreviewStreamHub::setTranscoder(Transcoder transcoder) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  transcoder_ = std::move(transcoder);
+}
+
+PreviewStreamHub::Variant
+PreviewStreamHub::normalize(const Variant &requested) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Variant variant;
+  variant.max_fps = std::clamp(requested.max_fps, 1, config_.max_fps);
+  if (requested.width > 0) {
+    int width = std::clamp(requested.width, config_.min_width,
+                           config_.max_width);
+    variant.width = std::max(16, (width + 8) / 16 * 16);
+  }
+  return variant;
+}
+
+PreviewStreamHub::ViewerId
+PreviewStreamHub::addViewer(const std::string &instanceId,
+                            const Variant &variant, Framing framing,
+                            PushFn push, AliveFn alive) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (viewer_index_.size() >= config_.max_viewers) {
+    return 0;
+  }
+
+  ViewerId id = next_viewer_id_++;
+  auto &variants = instances_[instanceId];
+  auto it = std::find_if(
+      variants.begin(), variants.end(),
+      [&variant](const VariantState &state) { return state.variant == variant; });
+  if (it == variants.end()) {
+    VariantState state;
+    state.variant = variant;
+    variants.push_back(std::move(state));
+    it = std::prev(variants.end());
+  }
+  Viewer viewer;
+  viewer.id = id;
+  viewer.framing = framing;
+  viewer.push = std::move(push);
+  viewer.alive = std::move(alive);
+  it->viewers.push_back(std::move(viewer));
+  viewer_index_[id] = ViewerLocation{instanceId, variant};
+
+  cv_.notify_all();
+  return id;
+}
+
+void PreviewStreamHub::removeViewer(ViewerId id) {
+  Viewer removed; // Destroyed outside the lock (may close a stream)
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto locIt = viewer_index_.find(id);
+  if (locIt == viewer_index_.end()) {
+    return;
+  }
+  auto instIt = instances_.find(locIt->second.instance_id);
+  if (instIt != instances_.end()) {
+    auto &variants = instIt->second;
+    for (auto varIt = variants.begin(); varIt != variants.end(); ++varIt) {
+      if (!(varIt->variant == locIt->second.variant)) {
+        continue;
+      }
+      auto &viewers = varIt->viewers;
+      auto viewerIt =
+          std::find_if(viewers.begin(), viewers.end(),
+                       [id](const Viewer &viewer) { return viewer.id == id; });
+      if (viewerIt != viewers.end()) {
+        removed = std::move(*viewerIt);
+        viewers.erase(viewerIt);
+      }
+      if (viewers.empty()) {
+        variants.erase(varIt);
+      }
+      break;
+    }
+    if (variants.empty()) {
+      instances_.erase(instIt);
+    }
+  }
+  viewer_index_.erase(locIt);
+}
+
+size_t PreviewStreamHub::removeInstance(const std::string &instanceId) {
+  std::vector<VariantState> removed; // Destroyed outside the lock
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto instIt = instances_.find(instanceId);
+  if (instIt == instances_.end()) {
+    return 0;
+  }
+  size_t count = 0;
+  for (const auto &state : instIt->second) {
+    for (const auto &viewer : state.viewers) {
+      viewer_index_.erase(viewer.id);
+      count++;
+    }
+  }
+  removed.swap(instIt->second);
+  instances_.erase(instIt);
+  return count;
+}
+
+void PreviewStreamHub::start() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (running_) {
+    return;
+  }
+  running_ = true;
+  thread_ = std::thread(&PreviewStreamHub::pumpLoop, this);
+}
+
+void PreviewStreamHub::shutdown() {
+  std::unordered_map<std::string, std::vector<VariantState>> dropped;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = false;
+    cv_.notify_all();
+  }
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  dropped.swap(instances_);
+  viewer_index_.clear();
+}
+
+std::chrono::steady_clock::time_point PreviewStreamHub::nextDueLocked() const {
+  auto due = std::chrono::steady_clock::time_point::max();
+  for (const auto &[instanceId, variants] : instances_) {
+    for (const auto &state : variants) {
+      due = std::min(due, state.next_due);
+    }
+  }
+  return due;
+}
+
+void PreviewStreamHub::pumpLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (running_) {
+    if (viewer_index_.empty()) {
+      // Nobody watching: nothing is fetched or encoded
+      cv_.wait(lock, [this] { return !running_ || !viewer_index_.empty(); });
+      continue;
+    }
+    auto due = nextDueLocked();
+    auto now = std::chrono::steady_clock::now();
+    if (due > now) {
+      cv_.wait_until(lock, due); // Also woken when viewers change
+      continue;
+    }
+    lock.unlock();
+    pump(now);
+    lock.lock();
+  }
+}
+
+std::string PreviewStreamHub::makeMultipartPart(const std::string &jpeg) {
+  std::string part;
+  part.reserve(jpeg.size() + 96);
+  part += "--";
+  part += MULTIPART_BOUNDARY;
+  part += "\r\nContent-Type: image/jpeg\r\nContent-Length: ";
+  part += std::to_string(jpeg.size());
+  part += "\r\n\r\n";
+  part += jpeg;
+  part += "\r\n";
+  return part;
+}
+
+size_t PreviewStreamHub::pump(std::chrono::steady_clock::time_point now) {
+  std::lock_guard<std::mutex> pumpLock(pump_mutex_);
+
+  struct DueVariant {
+    Variant variant;
+    std::vector<Viewer> viewers;
+  };
+  struct DueInstance {
+    std::string instance_id;
+    std::vector<DueVariant> variants;
+  };
+
+  // Snapshot due variants; fetching and encoding happen unlocked
+  FrameSource source;
+  Transcoder transcoder;
+  int quality;
+  int maxInFlight;
+  std::vector<DueInstance> jobs;
+  std::vector<ViewerId> gone;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    source = source_;
+    transcoder = transcoder_;
+    quality = config_.jpeg_quality;
+    maxInFlight = config_.max_frames_in_flight;
+    for (auto &[instanceId, variants] : instances_) {
+      DueInstance job;
+      job.instance_id = instanceId;
+      for (auto &state : variants) {
+        if (state.next_due > now) {
+          continue;
+        }
+        state.next_due =
+            now + std::chrono::microseconds(1000000 / state.variant.max_fps);
+        DueVariant due{state.variant, {}};
+        for (const auto &viewer : state.viewers) {
+          if (viewer.alive && !viewer.alive()) {
+            gone.push_back(viewer.id); // Closed, even if nothing is sent
+            continue;
+          }
+          due.viewers.push_back(viewer);
+        }
+        if (!due.viewers.empty()) {
+          job.variants.push_back(std::move(due));
+        }
+      }
+      if (!job.variants.empty()) {
+        jobs.push_back(std::move(job));
+      }
+    }
+  }
+  for (ViewerId id : gone) {
+    removeViewer(id);
+  }
+  gone.clear();
+  if (!source) {
+    return 0;
+  }
+
+  size_t pushed = 0;
+  std::vector<std::pair<ViewerId, size_t>> sentHashes; // Viewer -> frame
+
+  for (auto &job : jobs) {
+    std::string jpeg;
+    try {
+      jpeg = source(job.instance_id); // Once per instance per tick
+    } catch (const std::exception &e) {
+      std::cerr << "[PreviewStreamHub] Failed to fetch frame for "
+                << job.instance_id << ": " << e.what() << std::endl;
+    }
+    frames_fetched_.fetch_add(1, std::memory_order_relaxed);
+    if (jpeg.empty()) {
+      continue;
+    }
+    size_t frameHash = std::hash<std::string>()(jpeg);
+    Payload sourcePayload;
+
+    for (auto &due : job.variants) {
+      // Viewers that haven't seen this frame and can take another one
+      std::vector<Viewer *> receivers;
+      for (auto &viewer : due.viewers) {
+        if (viewer.last_frame_hash == frameHash) {
+          continue;
+        }
+        if (viewer.in_flight->load(std::memory_order_relaxed) >=
+            maxInFlight) {
+          frames_skipped_.fetch_add(1, std::memory_order_relaxed);
+          continue;
+        }
+        receivers.push_back(&viewer);
+      }
+      if (receivers.empty()) {
+        if (std::all_of(due.viewers.begin(), due.viewers.end(),
+                        [frameHash](const Viewer &viewer) {
+                          return viewer.last_frame_hash == frameHash;
+                        })) {
+          frames_unchanged_.fetch_add(1, std::memory_order_relaxed);
+        }
+        continue;
+      }
+
+      Payload raw;
+      if (due.variant.width == 0 || !transcoder) {
+        if (!sourcePayload) {
+          sourcePayload = std::make_shared<const std::string>(jpeg);
+        }
+        raw = sourcePayload;
+      } else {
+        std::string scaled;
+        try {
+          scaled = transcoder(jpeg, due.variant.width, quality);
+        } catch (const std::exception &e) {
+          std::cerr << "[PreviewStreamHub] Failed to scale frame for "
+                    << job.instance_id << ": " << e.what() << std::endl;
+        }
+        if (scaled.empty()) {
+          continue;
+        }
+        frames_encoded_.fetch_add(1, std::memory_order_relaxed);
+        raw = std::make_shared<const std::string>(std::move(scaled));
+      }
+
+      // Each framing is built at most once per variant and shared
+      Payload part;
+      for (Viewer *viewer : receivers) {
+        Payload payload = raw;
+        if (viewer->framing == Framing::MultipartPart) {
+          if (!part) {
+            part = std::make_shared<const std::string>(makeMultipartPart(*raw));
+          }
+          payload = part;
+        }
+        auto inFlight = viewer->in_flight;
+        inFlight->fetch_add(1, std::memory_order_relaxed);
+        bool delivered = false;
+        try {
+          delivered = viewer->push(payload, [inFlight]() {
+            inFlight->fetch_sub(1, std::memory_order_relaxed);
+          });
+        } catch (const std::exception &) {
+          delivered = false;
+        }
+        if (!delivered) {
+          inFlight->fetch_sub(1, std::memory_order_relaxed);
+          gone.push_back(viewer->id);
+          continue;
+        }
+        pushed++;
+        frames_pushed_.fetch_add(1, std::memory_order_relaxed);
+        bytes_pushed_.fetch_add(payload->size(), std::memory_order_relaxed);
+        sentHashes.emplace_back(viewer->id, frameHash);
+      }
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto &[id, hash] : sentHashes) {
+      auto locIt = viewer_index_.find(id);
+      if (locIt == viewer_index_.end()) {
+        continue;
+      }
+      auto instIt = instances_.find(locIt->second.instance_id);
+      if (instIt == instances_.end()) {
+        continue;
+      }
+      for (auto &state : instIt->second) {
+        if (!(state.variant == locIt->second.variant)) {
+          continue;
+        }
+        for (auto &viewer : state.viewers) {
+          if (viewer.id == id) {
+            viewer.last_frame_hash = hash;
+          }
+        }
+      }
+    }
+  }
+  for (ViewerId id : gone) {
+    removeViewer(id);
+  }
+  return pushed;
+}
+
+PreviewStreamHub::Stats PreviewStreamHub::getStats() const {
+  Stats stats;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.viewers = viewer_index_.size();
+    stats.instances = instances_.size();
+    for (const auto &[instanceId, variants] : instances_) {
+      stats.variants += variants.size();
+    }
+  }
+  stats.frames_fetched = frames_fetched_.load(std::memory_order_relaxed);
+  stats.frames_encoded = frames_encoded_.load(std::memory_order_relaxed);
+  stats.frames_unchanged = frames_unchanged_.load(std::memory_order_relaxed);
+  stats.frames_skipped = frames_skipped_.load(std::memory_order_relaxed);
+  stats.frames_pushed = frames_pushed_.load(std::memory_order_relaxed);
+  stats.bytes_pushed = bytes_pushed_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+Json::Value PreviewStreamHub::getStatsJson() const {
+  Stats stats = getStats();
+  Json::Value json;
+  json["viewers"] = static_cast<Json::UInt64>(stats.viewers);
+  json["instances"] = static_cast<Json::UInt64>(stats.instances);
+  json["variants"] = static_cast<Json::UInt64>(stats.variants);
+  json["framesFetched"] = static_cast<Json::UInt64>(stats.frames_fetched);
+  json["framesEncoded"] = static_cast<Json::UInt64>(stats.frames_encoded);
+  json["framesUnchanged"] = static_cast<Json::UInt64>(stats.frames_unchanged);
+  json["framesSkipped"] = static_cast<Json::UInt64>(stats.frames_skipped);
+  json["framesPushed"] = static_cast<Json::UInt64>(stats.frames_pushed);
+  json["bytesPushed"] = static_cast<Json::UInt64>(stats.bytes_pushed);
+  return json;
+}
@@ -1,4 +1,6 @@
 #include "core/priority_queue.h"
+#include <algorithm>
+#include <iterator>
 
 PriorityQueue::PriorityQueue(size_t max_size) : max_size_(max_size) {}
 
@@ -19,7 +21,8 @@ bool PriorityQueue::enqueue(Request request,
   }
 
   request.timestamp = std::chrono::steady_clock::now();
-  queue_.push(request);
+  priority_counts_[static_cast<int>(request.priority)]++;
+  queue_.push(std::move(request));
   condition_.notify_one();
 
   return true;
@@ -42,6 +45,7 @@ PriorityQueue::dequeue(std::chrono::milliseconds timeout) {
 
   Request request = queue_.top();
   queue_.pop();
+  priority_counts_[static_cast<int>(request.priority)]--;
   condition_.notify_one();
 
   return request;
@@ -58,13 +62,11 @@ PriorityQueue::Stats PriorityQueue::getStats() const {
   Stats stats;
   stats.total = queue_.size();
   stats.max_size = max_size_;
-  stats.high_priority = 0;
-  stats.medium_priority = 0;
-  stats.low_priority = 0;
-
-  // Count by priority (would need to iterate, but priority_queue doesn't
-  // support this) For efficiency, we'll just return total In production,
-  // maintain separate counters
+  stats.critical_priority =
+      priority_counts_[static_cast<int>(Priority::Critical)];
+  stats.high_priority = priority_counts_[static_cast<int>(Priority::High)];
+  stats.medium_priority = priority_counts_[static_cast<int>(Priority::Medium)];
+  stats.low_priority = priority_counts_[static_cast<int>(Priority::Low)];
 
   return stats;
 }
@@ -74,5 +76,6 @@ void PriorityQueue::clear() {
   while (!queue_.empty()) {
     queue_.pop();
   }
+  std::fill(std::begin(priority_counts_), std::end(priority_counts_), 0);
   condition_.notify_all();
 }
@@ -0,0 +1,296 @@
+#include "core/queue_telemetry.h"
+#include <algorithm>
+#include <chrono>
+
+// ========== NodeSeries ==========
+
+void QueueTelemetry::NodeSeries::setName(const std::string &nodeName) {
+  if (has_sdk_name_.load(std::memory_order_acquire) || nodeName.empty()) {
+    return;
+  }
+  std::call_once(name_once_, [this, &nodeName]() {
+    sdk_name_ = nodeName;
+    has_sdk_name_.store(true, std::memory_order_release);
+  });
+}
+
+std::string QueueTelemetry::NodeSeries::name() const {
+  if (has_sdk_name_.load(std::memory_order_acquire)) {
+    return sdk_name_;
+  }
+  return name_;
+}
+
+bool QueueTelemetry::NodeSeries::record(uint32_t depth,
+                                        uint32_t highWatermark) {
+  // Claim a slot - fetch_add keeps this safe when a node has several
+  // upstream nodes (multiple producers)
+  uint64_t index = head_.fetch_add(1, std::memory_order_acq_rel);
+  Slot &slot = slots_[index % CAPACITY];
+
+  slot.seq.store(2 * index + 1, std::memory_order_release);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.timestamp_ms.store(QueueTelemetry::nowMs(), std::memory_order_relaxed);
+  slot.depth.store(depth, std::memory_order_relaxed);
+  slot.drops.store(drops_.load(std::memory_order_relaxed),
+                   std::memory_order_relaxed);
+  slot.seq.store(2 * index + 2, std::memory_order_release);
+
+  current_depth_.store(depth, std::memory_order_relaxed);
+
+  bool full = highWatermark > 0 && depth >= highWatermark;
+  bool was_full = full_.exchange(full, std::memory_order_relaxed);
+  return full && !was_full;
+}
+
+void QueueTelemetry::NodeSeries::snapshot(std::vector<Sample> &out,
+                                          size_t maxSamples,
+                                          int64_t sinceMs) const {
+  uint64_t head = head_.load(std::memory_order_acquire);
+  uint64_t count = std::min<uint64_t>(
+      {head, static_cast<uint64_t>(CAPACITY), static_cast<uint64_t>(maxSamples)});
+
+  size_t first = out.size();
+  for (uint64_t index = head - count; index < head; ++index) {
+    const Slot &slot = slots_[index % CAPACITY];
+
+    uint64_t seq_before = slot.seq.load(std::memory_order_acquire);
+    if (seq_before != 2 * index + 2) {
+      continue; // Being written or already overwritten
+    }
+    Sample sample;
+    sample.timestamp_ms = slot.timestamp_ms.load(std::memory_order_relaxed);
+    sample.depth = slot.depth.load(std::memory_order_relaxed);
+    sample.drops = slot.drops.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.seq.load(std::memory_order_relaxed) != seq_before) {
+      continue;
+    }
+    if (sinceMs > 0 && sample.timestamp_ms < sinceMs) {
+      continue;
+    }
+    out.push_back(sample);
+  }
+
+  // Concurrent writers can complete out of order - keep output sorted
+  std::stable_sort(out.begin() + first, out.end(),
+                   [](const Sample &a, const Sample &b) {
+                     return a.timestamp_ms < b.timestamp_ms;
+                   });
+}
+
+// ========== InstanceSeries ==========
+
+QueueTelemetry::NodeSeries *
+QueueTelemetry::InstanceSeries::addNode(const std::string &nodeName) {
+  std::lock_guard<std::mutex> lock(add_mutex_);
+  size_t count = node_count_.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < count; ++i) {
+    if (nodes_[i]->label() == nodeName) {
+      return nodes_[i].get();
+    }
+  }
+  if (count >= MAX_NODES) {
+    return nullptr;
+  }
+  nodes_[count] = std::make_unique<NodeSeries>(nodeName);
+  // Publish after construction so lock-free readers never see a null slot
+  node_count_.store(count + 1, std::memory_order_release);
+  return nodes_[count].get();
+}
+
+void QueueTelemetry::InstanceSeries::setQueueCapacity(size_t capacity) {
+  if (capacity == 0) {
+    return;
+  }
+  capacity_.store(static_cast<uint32_t>(capacity), std::memory_order_relaxed);
+  uint32_t watermark =
+      std::max<uint32_t>(1, static_cast<uint32_t>(capacity * 8 / 10));
+  high_watermark_.store(watermark, std::memory_order_relaxed);
+}
+
+uint32_t QueueTelemetry::InstanceSeries::currentMaxDepth() const {
+  uint32_t depth = 0;
+  size_t count = node_count_.load(std::memory_order_acquire);
+  for (size_t i = 0; i < count; ++i) {
+    depth = std::max(depth, nodes_[i]->currentDepth());
+  }
+  return depth;
+}
+
+uint64_t QueueTelemetry::InstanceSeries::totalDrops() const {
+  uint64_t drops = 0;
+  size_t count = node_count_.load(std::memory_order_acquire);
+  for (size_t i = 0; i < count; ++i) {
+    drops += nodes_[i]->totalDrops();
+  }
+  return drops;
+}
+
+bool QueueTelemetry::InstanceSeries::isOverloaded() const {
+  size_t count = node_count_.load(std::memory_order_acquire);
+  for (size_t i = 0; i < count; ++i) {
+    if (nodes_[i]->isFull()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+QueueTelemetry::Summary
+QueueTelemetry::InstanceSeries::summarize(int64_t windowMs) const {
+  Summary summary;
+  int64_t now = QueueTelemetry::nowMs();
+  int64_t since = now - windowMs;
+  uint32_t watermark = highWatermark();
+  double seconds = std::max<int64_t>(windowMs, 1) / 1000.0;
+
+  double deepest_avg = 0.0;
+  uint32_t deepest_max = 0;
+  size_t full_samples = 0;
+  std::vector<Sample> samples;
+  samples.reserve(NodeSeries::CAPACITY);
+
+  size_t count = node_count_.load(std::memory_order_acquire);
+  for (size_t i = 0; i < count; ++i) {
+    const NodeSeries &node = *nodes_[i];
+    summary.current_depth = std::max(summary.current_depth, node.currentDepth());
+
+    samples.clear();
+    node.snapshot(samples, NodeSeries::CAPACITY, since);
+    if (samples.empty()) {
+      continue;
+    }
+
+    uint64_t depth_sum = 0;
+    uint32_t node_max = 0;
+    size_t node_full = 0;
+    for (const auto &sample : samples) {
+      depth_sum += sample.depth;
+      node_max = std::max(node_max, sample.depth);
+      if (watermark > 0 && sample.depth >= watermark) {
+        ++node_full;
+      }
+    }
+    full_samples += node_full;
+    summary.full_ratio =
+        std::max(summary.full_ratio,
+                 static_cast<double>(node_full) / samples.size());
+    summary.samples += samples.size();
+    summary.drops += node.totalDrops() - samples.front().drops;
+
+    double node_avg = static_cast<double>(depth_sum) / samples.size();
+    if (node_max > deepest_max ||
+        (node_max == deepest_max && node_avg > deepest_avg)) {
+      deepest_max = node_max;
+      deepest_avg = node_avg;
+    }
+  }
+
+  summary.max_depth = deepest_max;
+  summary.avg_depth = deepest_avg;
+  summary.drops_per_second = summary.drops / seconds;
+  summary.full_per_second = full_samples / seconds;
+  return summary;
+}
+
+Json::Value QueueTelemetry::InstanceSeries::toJson(size_t maxSamples) const {
+  Json::Value json;
+  json["instanceId"] = instance_id_;
+  json["queueCapacity"] = capacity_.load(std::memory_order_relaxed);
+  json["highWatermark"] = highWatermark();
+  json["currentMaxDepth"] = currentMaxDepth();
+  json["totalDrops"] = static_cast<Json::UInt64>(totalDrops());
+  json["overloaded"] = isOverloaded();
+  json["timestamp"] = static_cast<Json::Int64>(QueueTelemetry::nowMs());
+
+  Json::Value nodes(Json::arrayValue);
+  std::vector<Sample> samples;
+  size_t count = node_count_.load(std::memory_order_acquire);
+  for (size_t i = 0; i < count; ++i) {
+    const NodeSeries &node = *nodes_[i];
+    Json::Value nodeJson;
+    nodeJson["name"] = node.name();
+    nodeJson["currentDepth"] = node.currentDepth();
+    nodeJson["totalDrops"] = static_cast<Json::UInt64>(node.totalDrops());
+    nodeJson["totalSamples"] = static_cast<Json::UInt64>(node.totalSamples());
+    nodeJson["full"] = node.isFull();
+
+    samples.clear();
+    node.snapshot(samples, maxSamples);
+    // Compact [timestamp_ms, depth, drops] triples keep large series small
+    Json::Value series(Json::arrayValue);
+    for (const auto &sample : samples) {
+      Json::Value point(Json::arrayValue);
+      point.append(static_cast<Json::Int64>(sample.timestamp_ms));
+      point.append(sample.depth);
+      point.append(static_cast<Json::UInt64>(sample.drops));
+      series.append(point);
+    }
+    nodeJson["samples"] = series;
+    nodes.append(nodeJson);
+  }
+  json["nodes"] = nodes;
+  return json;
+}
+
+// ========== QueueTelemetry ==========
+
+std::shared_ptr<QueueTelemetry::InstanceSeries>
+QueueTelemetry::getOrCreate(const std::string &instanceId) {
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = instances_.find(instanceId);
+    if (it != instances_.end()) {
+      return it->second;
+    }
+  }
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  auto &series = instances_[instanceId];
+  if (!series) {
+    series = std::make_shared<InstanceSeries>(instanceId);
+  }
+  return series;
+}
+
+std::shared_ptr<QueueTelemetry::InstanceSeries>
+QueueTelemetry::find(const std::string &instanceId) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto it = instances_.find(instanceId);
+  if (it != instances_.end()) {
+    return it->second;
+  }
+  return nullptr;
+}
+
+void QueueTelemetry::remove(const std::string &instanceId) {
+  // Hooks still holding NodeSeries pointers keep the series alive through
+  // the shared_ptr they captured
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  instances_.erase(instanceId);
+}
+
+std::vector<std::string> QueueTelemetry::listInstances() const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  std::vector<std::string> ids;
+  ids.reserve(instances_.size());
+  for (const auto &[id, _] : instances_) {
+    ids.push_back(id);
+  }
+  return ids;
+}
+
+Json::Value QueueTelemetry::toJson(const std::string &instanceId,
+                                   size_t maxSamples) const {
+  auto series = find(instanceId);
+  if (!series) {
+    return Json::Value();
+  }
+  return series->toJson(maxSamples);
+}
+
+int64_t QueueTelemetry::nowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
@@ -32,10 +32,9 @@ bool RateLimiter::allow(const std::string &key) {
   auto &bucket = buckets_[key];
   refill(bucket);
 
-  size_t effective_limit = calculateAdaptiveLimit(max_requests_);
-
-  if (bucket.tokens < effective_limit) {
-    bucket.tokens++;
+  // tokens = requests still allowed in the current window
+  if (bucket.tokens > 0) {
+    bucket.tokens--;
     bucket.requests_count++;
     return true;
   }
@@ -45,21 +44,35 @@ bool RateLimiter::allow(const std::string &key) {
 
 void RateLimiter::refill(TokenBucket &bucket) {
   auto now = std::chrono::steady_clock::now();
+  size_t effective_limit = calculateAdaptiveLimit(max_requests_);
+
+  if (bucket.last_refill == std::chrono::steady_clock::time_point{}) {
+    // New bucket starts full
+    bucket.tokens = effective_limit;
+    bucket.last_refill = now;
+    return;
+  }
+
   auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
                      now - bucket.last_refill)
                      .count();
+  if (elapsed <= 0 || window_.count() <= 0) {
+    return;
+  }
 
-  if (elapsed > 0) {
-    size_t tokens_to_add = (elapsed * max_requests_) / (window_.count() * 1000);
-    if (tokens_to_add > 0) {
-      size_t effective_limit = calculateAdaptiveLimit(max_requests_);
-      bucket.tokens = std::min(effective_limit, bucket.tokens + tokens_to_add);
-      bucket.last_refill = now;
-    }
-  } else if (bucket.tokens == 0) {
-    // Initialize if first time
-    bucket.tokens = calculateAdaptiveLimit(max_requests_);
+  size_t tokens_to_add = static_cast<size_t>(elapsed) * max_requests_ /
+                         static_cast<size_t>(window_.count() * 1000);
+  if (tokens_to_add == 0) {
+    return;
+  }
+  bucket.tokens = std::min(effective_limit, bucket.tokens + tokens_to_add);
+  if (bucket.tokens >= effective_limit) {
     bucket.last_refill = now;
+  } else {
+    // Advance only by the time the added tokens account for, so partial
+    // intervals are not lost between calls
+    bucket.last_refill += std::chrono::milliseconds(
+        tokens_to_add * window_.count() * 1000 / max_requests_);
   }
 }
 
@@ -144,6 +157,7 @@ RateLimiter::Stats RateLimiter::getStats() const {
 
   Stats stats;
   stats.total_keys = buckets_.size();
+  stats.active_keys = 0;
 
   auto now = std::chrono::steady_clock::now();
   auto active_threshold = now - std::chrono::seconds(window_.count());
@@ -0,0 +1,307 @@
+#include "core/recognition_cache.h"
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+
+namespace {
+
+constexpr uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t PRIME4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t PRIME5 = 0x27D4EB2F165667C5ULL;
+
+inline uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+inline uint64_t read64(const uint8_t *p) {
+  uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint32_t read32(const uint8_t *p) {
+  uint32_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint64_t xxhRound(uint64_t acc, uint64_t input) {
+  acc += input * PRIME2;
+  acc = rotl(acc, 31);
+  return acc * PRIME1;
+}
+
+inline uint64_t mergeRound(uint64_t acc, uint64_t val) {
+  acc ^= xxhRound(0, val);
+  return acc * PRIME1 + PRIME4;
+}
+
+} // namespace
+
+// ========== Hashing ==========
+
+uint64_t RecognitionCache::hashBytes(const void *data, size_t length,
+                                     uint64_t seed) {
+  // XXH64 - reads the buffer in place, no concatenation or hex encoding
+  const uint8_t *p = static_cast<const uint8_t *>(data);
+  const uint8_t *end = p + length;
+  uint64_t h;
+
+  if (length >= 32) {
+    uint64_t v1 = seed + PRIME1 + PRIME2;
+    uint64_t v2 = seed + PRIME2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - PRIME1;
+    const uint8_t *limit = end - 32;
+    do {
+      v1 = xxhRound(v1, read64(p));
+      v2 = xxhRound(v2, read64(p + 8));
+      v3 = xxhRound(v3, read64(p + 16));
+      v4 = xxhRound(v4, read64(p + 24));
+      p += 32;
+    } while (p <= limit);
+    h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+    h = mergeRound(h, v1);
+    h = mergeRound(h, v2);
+    h = mergeRound(h, v3);
+    h = mergeRound(h, v4);
+  } else {
+    h = seed + PRIME5;
+  }
+
+  h += static_cast<uint64_t>(length);
+
+  while (p + 8 <= end) {
+    h ^= xxhRound(0, read64(p));
+    h = rotl(h, 27) * PRIME1 + PRIME4;
+    p += 8;
+  }
+  if (p + 4 <= end) {
+    h ^= static_cast<uint64_t>(read32(p)) * PRIME1;
+    h = rotl(h, 23) * PRIME2 + PRIME3;
+    p += 4;
+  }
+  while (p < end) {
+    h ^= (*p) * PRIME5;
+    h = rotl(h, 11) * PRIME1;
+    ++p;
+  }
+
+  h ^= h >> 33;
+  h *= PRIME2;
+  h ^= h >> 29;
+  h *= PRIME3;
+  h ^= h >> 32;
+  return h;
+}
+
+uint64_t RecognitionCache::differenceHash(const uint8_t *gray9x8) {
+  uint64_t hash = 0;
+  for (int y = 0; y < 8; ++y) {
+    const uint8_t *row = gray9x8 + y * 9;
+    for (int x = 0; x < 8; ++x) {
+      hash = (hash << 1) | (row[x] < row[x + 1] ? 1 : 0);
+    }
+  }
+  return hash;
+}
+
+int RecognitionCache::hammingDistance(uint64_t a, uint64_t b) {
+  return static_cast<int>(std::bitset<64>(a ^ b).count());
+}
+
+RecognitionCache::Key
+RecognitionCache::makeKey(const std::vector<unsigned char> &image,
+                          const std::string &params) {
+  Key key;
+  key.content = hashBytes(image.data(), image.size());
+  key.params = hashBytes(params.data(), params.size(), PRIME3);
+  return key;
+}
+
+// ========== Configuration ==========
+
+void RecognitionCache::configure(const Config &config) {
+  {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    config_ = config;
+    enabled_.store(config.enabled, std::memory_order_relaxed);
+    shard_budget_.store(std::max<size_t>(1, config.max_bytes / SHARD_COUNT),
+                        std::memory_order_relaxed);
+    ttl_seconds_.store(config.ttl.count(), std::memory_order_relaxed);
+  }
+  clear();
+  hits_.store(0, std::memory_order_relaxed);
+  perceptual_hits_.store(0, std::memory_order_relaxed);
+  misses_.store(0, std::memory_order_relaxed);
+  evictions_.store(0, std::memory_order_relaxed);
+}
+
+RecognitionCache::Config RecognitionCache::getConfig() const {
+  std::lock_guard<std::mutex> lock(config_mutex_);
+  return config_;
+}
+
+// ========== Lookup / insert ==========
+
+size_t RecognitionCache::entryBytes(const Entry &entry) {
+  // Value plus list node, index node and bookkeeping
+  return entry.value.size() + sizeof(Entry) + 64;
+}
+
+void RecognitionCache::erase(Shard &shard, std::list<Entry>::iterator it) {
+  shard.bytes -= entryBytes(*it);
+  shard.index.erase(it->key);
+  shard.lru.erase(it);
+}
+
+std::optional<std::string> RecognitionCache::lookup(const Key &key) {
+  uint64_t version = galleryVersion();
+  Shard &shard = shardFor(key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  auto it = shard.index.find(key);
+  if (it == shard.index.end()) {
+    return std::nullopt;
+  }
+  auto entry = it->second;
+  if (entry->gallery_version != version ||
+      std::chrono::steady_clock::now() > entry->expiry) {
+    erase(shard, entry);
+    return std::nullopt;
+  }
+
+  shard.lru.splice(shard.lru.begin(), shard.lru, entry);
+  return entry->value;
+}
+
+std::optional<std::string> RecognitionCache::get(const Key &key) {
+  if (!isEnabled()) {
+    return std::nullopt;
+  }
+  auto result = lookup(key);
+  if (result) {
+    hits_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+  }
+  return result;
+}
+
+std::optional<std::string>
+RecognitionCache::getSimilar(uint64_t params, uint64_t perceptualHash) {
+  if (!isEnabled() || perceptualHash == 0) {
+    return std::nullopt;
+  }
+  int max_distance;
+  {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    if (!config_.perceptual_hash) {
+      return std::nullopt;
+    }
+    max_distance = static_cast<int>(config_.perceptual_max_distance);
+  }
+
+  // Pick the closest recent frame with the same parameters
+  std::optional<Key> best;
+  int best_distance = max_distance + 1;
+  {
+    std::lock_guard<std::mutex> lock(perceptual_mutex_);
+    for (const auto &candidate : perceptual_index_) {
+      if (candidate.hash == 0 || candidate.key.params != params) {
+        continue;
+      }
+      int distance = hammingDistance(candidate.hash, perceptualHash);
+      if (distance < best_distance) {
+        best_distance = distance;
+        best = candidate.key;
+      }
+    }
+  }
+  if (!best) {
+    return std::nullopt;
+  }
+
+  auto result = lookup(*best);
+  if (result) {
+    perceptual_hits_.fetch_add(1, std::memory_order_relaxed);
+  }
+  return result;
+}
+
+void RecognitionCache::put(const Key &key, std::string value,
+                           uint64_t galleryVersion, uint64_t perceptualHash) {
+  if (!isEnabled() || galleryVersion != this->galleryVersion()) {
+    return; // Result computed against an older gallery
+  }
+
+  Entry entry;
+  entry.key = key;
+  entry.value = std::move(value);
+  entry.gallery_version = galleryVersion;
+  entry.expiry = std::chrono::steady_clock::now() +
+                 std::chrono::seconds(ttl_seconds_.load(std::memory_order_relaxed));
+  size_t bytes = entryBytes(entry);
+  size_t budget = shard_budget_.load(std::memory_order_relaxed);
+  if (bytes > budget) {
+    return; // Larger than a whole shard - not worth caching
+  }
+
+  {
+    Shard &shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+      erase(shard, it->second);
+    }
+    while (!shard.lru.empty() && shard.bytes + bytes > budget) {
+      erase(shard, std::prev(shard.lru.end()));
+      evictions_.fetch_add(1, std::memory_order_relaxed);
+    }
+    shard.lru.push_front(std::move(entry));
+    shard.index[key] = shard.lru.begin();
+    shard.bytes += bytes;
+  }
+
+  if (perceptualHash != 0) {
+    std::lock_guard<std::mutex> lock(perceptual_mutex_);
+    perceptual_index_[perceptual_next_] = PerceptualEntry{perceptualHash, key};
+    perceptual_next_ = (perceptual_next_ + 1) % PERCEPTUAL_INDEX_SIZE;
+  }
+}
+
+void RecognitionCache::bumpGalleryVersion() {
+  gallery_version_.fetch_add(1, std::memory_order_acq_rel);
+  // Entries are also rejected lazily by version; clearing frees memory now
+  clear();
+}
+
+void RecognitionCache::clear() {
+  for (auto &shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.lru.clear();
+    shard.index.clear();
+    shard.bytes = 0;
+  }
+  std::lock_guard<std::mutex> lock(perceptual_mutex_);
+  perceptual_index_.fill(PerceptualEntry{});
+  perceptual_next_ = 0;
+}
+
+RecognitionCache::Stats RecognitionCache::getStats() const {
+  Stats stats;
+  for (auto &shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    stats.entries += shard.lru.size();
+    stats.bytes += shard.bytes;
+  }
+  stats.max_bytes = shard_budget_.load(std::memory_order_relaxed) * SHARD_COUNT;
+  stats.hits = hits_.load(std::memory_order_relaxed);
+  stats.perceptual_hits = perceptual_hits_.load(std::memory_order_relaxed);
+  stats.misses = misses_.load(std::memory_order_relaxed);
+  stats.evictions = evictions_.load(std::memory_order_relaxed);
+  stats.gallery_version = galleryVersion();
+  uint64_t total = stats.hits + stats.misses;
+  stats.hit_rate = total > 0 ? static_cast<double>(stats.hits) / total : 0.0;
+  return stats;
+}
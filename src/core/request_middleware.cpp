@@ -1,7 +1,10 @@
 #include "core/request_middleware.h"
+#include "config/system_config.h"
 #include "core/endpoint_monitor.h"
 #include "core/performance_monitor.h"
+#include <algorithm>
 #include <chrono>
+#include <iostream>
 #include <mutex>
 #include <unordered_map>
 
@@ -48,3 +51,273 @@ void RequestMetricsMiddleware::doFilter(const drogon::HttpRequestPtr &req,
   // callback) to automatically record metrics when sending responses.
   fccb();
 }
+
+// ========== RequestAdmissionControl ==========
+
+RequestAdmissionControl::Config RequestAdmissionControl::loadConfig() {
+  Config config;
+  unsigned int cores = std::thread::hardware_concurrency();
+  config.worker_threads = std::max(2u, cores / 2);
+
+  try {
+    Json::Value section = SystemConfig::getInstance().getConfigSection(
+        "system.admission_control");
+    if (!section.isObject()) {
+      return config;
+    }
+    config.enabled = section.get("enabled", config.enabled).asBool();
+    config.worker_threads = std::max<size_t>(
+        1, section
+               .get("worker_threads",
+                    static_cast<Json::UInt64>(config.worker_threads))
+               .asUInt64());
+    config.max_queue_size = std::max<size_t>(
+        1, section
+               .get("max_queue_size",
+                    static_cast<Json::UInt64>(config.max_queue_size))
+               .asUInt64());
+    config.shed_queue_depth = std::min<size_t>(
+        config.max_queue_size,
+        section
+            .get("shed_queue_depth",
+                 static_cast<Json::UInt64>(config.shed_queue_depth))
+            .asUInt64());
+    config.queue_timeout = std::chrono::milliseconds(
+        section
+            .get("queue_timeout_ms",
+                 static_cast<Json::Int64>(config.queue_timeout.count()))
+            .asInt64());
+    config.client_requests_per_window =
+        section
+            .get("client_requests_per_window",
+                 static_cast<Json::UInt64>(config.client_requests_per_window))
+            .asUInt64();
+    config.client_window = std::chrono::seconds(std::max<Json::Int64>(
+        1, section
+               .get("client_window_seconds",
+                    static_cast<Json::Int64>(config.client_window.count()))
+               .asInt64()));
+  } catch (const std::exception &e) {
+    std::cerr << "[RequestAdmissionControl] Invalid admission_control config, "
+                 "using defaults: "
+              << e.what() << std::endl;
+  }
+  return config;
+}
+
+void RequestAdmissionControl::configure(const Config &config) {
+  shutdown();
+
+  config_ = config;
+  queue_ = std::make_unique<PriorityQueue>(config.max_queue_size);
+  rate_limiter_ = std::make_unique<RateLimiter>(
+      config.client_requests_per_window, config.client_window);
+  enabled_.store(config.enabled, std::memory_order_release);
+  if (!config.enabled) {
+    return;
+  }
+
+  running_.store(true, std::memory_order_release);
+  for (size_t i = 0; i < config.worker_threads; ++i) {
+    workers_.emplace_back(&RequestAdmissionControl::workerLoop, this);
+  }
+  std::cerr << "[RequestAdmissionControl] Executor started: "
+            << config.worker_threads << " workers, queue "
+            << config.max_queue_size << " (shed at "
+            << config.shed_queue_depth << ")" << std::endl;
+}
+
+void RequestAdmissionControl::shutdown() {
+  if (!running_.exchange(false)) {
+    return;
+  }
+  for (auto &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  workers_.clear();
+
+  // Fail whatever is still queued instead of leaving clients hanging
+  while (auto request = queue_->dequeue(std::chrono::milliseconds(0))) {
+    request->task();
+  }
+}
+
+RequestAdmissionControl::Classification
+RequestAdmissionControl::classify(drogon::HttpMethod method,
+                                  const std::string &path) {
+  Classification result;
+
+  auto startsWith = [&path](const char *prefix) {
+    return path.rfind(prefix, 0) == 0;
+  };
+  auto endsWith = [&path](const std::string &suffix) {
+    return path.size() >= suffix.size() &&
+           path.compare(path.size() - suffix.size(), suffix.size(), suffix) ==
+               0;
+  };
+
+  // Cheap read-only endpoints must stay fast under load
+  if (startsWith("/v1/core/health") || path == "/v1/core/version" ||
+      path == "/v1/core/watchdog" || startsWith("/v1/core/metrics") ||
+      path == "/v1/core/ai/metrics" ||
+      (method == drogon::Get && endsWith("/statistics"))) {
+    result.request_class = RequestClass::Critical;
+    result.priority = PriorityQueue::Priority::Critical;
+    return result;
+  }
+
+  if (method != drogon::Post) {
+    return result; // Normal
+  }
+
+  if (startsWith("/v1/core/instance/batch/") ||
+      (startsWith("/v1/core/groups/") &&
+       (endsWith("/start") || endsWith("/stop") || endsWith("/restart")))) {
+    // Instance control - ahead of inference work
+    result.request_class = RequestClass::Heavy;
+    result.priority = PriorityQueue::Priority::High;
+  } else if (path == "/v1/recognition/recognize" ||
+             path == "/v1/recognition/search" ||
+             path == "/v1/recognition/faces" || path == "/v1/core/ai/process" ||
+             path == "/v1/core/ai/batch") {
+    result.request_class = RequestClass::Heavy;
+    result.priority = PriorityQueue::Priority::Medium;
+  } else if (path == "/v1/core/model/upload" ||
+             path == "/v1/core/video/upload" ||
+             path == "/v1/core/font/upload") {
+    result.request_class = RequestClass::Heavy;
+    result.priority = PriorityQueue::Priority::Low;
+  }
+  return result;
+}
+
+drogon::HttpResponsePtr RequestAdmissionControl::createRejectResponse(
+    drogon::HttpStatusCode code, const std::string &message,
+    int retryAfterSeconds) {
+  Json::Value body;
+  body["error"] = code == drogon::k429TooManyRequests ? "Too many requests"
+                                                      : "Service unavailable";
+  body["message"] = message;
+  auto resp = drogon::HttpResponse::newHttpJsonResponse(body);
+  resp->setStatusCode(code);
+  resp->addHeader("Retry-After", std::to_string(retryAfterSeconds));
+  resp->addHeader("Access-Control-Allow-Origin", "*");
+  return resp;
+}
+
+void RequestAdmissionControl::admit(const drogon::HttpRequestPtr &req,
+                                    drogon::AdviceCallback &&acb,
+                                    drogon::AdviceChainCallback &&accb) {
+  if (!enabled_.load(std::memory_order_acquire)) {
+    accb();
+    return;
+  }
+
+  Classification classification = classify(req->method(), req->path());
+  if (classification.request_class != RequestClass::Heavy) {
+    inline_requests_.fetch_add(1, std::memory_order_relaxed);
+    accb();
+    return;
+  }
+
+  // Per-client token bucket
+  if (!rate_limiter_->allow(req->peerAddr().toIp())) {
+    rate_limited_.fetch_add(1, std::memory_order_relaxed);
+    acb(createRejectResponse(drogon::k429TooManyRequests,
+                             "Client request rate limit exceeded", 1));
+    return;
+  }
+
+  // Queue-depth based shedding of low priority work
+  size_t depth = queue_->size();
+  if (classification.priority == PriorityQueue::Priority::Low &&
+      depth >= config_.shed_queue_depth) {
+    shed_.fetch_add(1, std::memory_order_relaxed);
+    acb(createRejectResponse(drogon::k429TooManyRequests,
+                             "Server is busy, retry later", 2));
+    return;
+  }
+
+  // Shared so the queue-full path below can still respond
+  auto respond = std::make_shared<drogon::AdviceCallback>(std::move(acb));
+  auto enqueuedAt = std::chrono::steady_clock::now();
+  auto timeout = config_.queue_timeout;
+  PriorityQueue::Request request;
+  request.priority = classification.priority;
+  request.request_id = req->path();
+  request.timeout = timeout;
+  request.task = [this, req, respond, accb = std::move(accb), enqueuedAt,
+                  timeout]() {
+    // Also reached from shutdown() with running_ == false
+    if (!running_.load(std::memory_order_acquire) ||
+        (timeout.count() > 0 &&
+         std::chrono::steady_clock::now() - enqueuedAt > timeout)) {
+      rejected_.fetch_add(1, std::memory_order_relaxed);
+      (*respond)(createRejectResponse(drogon::k503ServiceUnavailable,
+                                      "Request timed out in admission queue",
+                                      2));
+      return;
+    }
+    // Runs the handler on this executor thread; Drogon sends the response
+    // on the connection's own loop
+    accb();
+  };
+
+  if (!queue_->enqueue(std::move(request), std::chrono::milliseconds(0))) {
+    rejected_.fetch_add(1, std::memory_order_relaxed);
+    (*respond)(createRejectResponse(drogon::k503ServiceUnavailable,
+                                    "Admission queue is full", 2));
+    return;
+  }
+  admitted_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RequestAdmissionControl::workerLoop() {
+  while (running_.load(std::memory_order_acquire)) {
+    auto request = queue_->dequeue(std::chrono::milliseconds(100));
+    if (!request) {
+      continue;
+    }
+    active_workers_.fetch_add(1, std::memory_order_relaxed);
+    try {
+      request->task();
+    } catch (const std::exception &e) {
+      std::cerr << "[RequestAdmissionControl] Handler exception for "
+                << request->request_id << ": " << e.what() << std::endl;
+    } catch (...) {
+      std::cerr << "[RequestAdmissionControl] Unknown handler exception for "
+                << request->request_id << std::endl;
+    }
+    active_workers_.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+RequestAdmissionControl::Stats RequestAdmissionControl::getStats() const {
+  Stats stats;
+  stats.admitted = admitted_.load(std::memory_order_relaxed);
+  stats.inline_requests = inline_requests_.load(std::memory_order_relaxed);
+  stats.rate_limited = rate_limited_.load(std::memory_order_relaxed);
+  stats.shed = shed_.load(std::memory_order_relaxed);
+  stats.rejected = rejected_.load(std::memory_order_relaxed);
+  stats.queue_depth = queue_ ? queue_->size() : 0;
+  stats.active_workers = active_workers_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+Json::Value RequestAdmissionControl::getStatsJson() const {
+  Stats stats = getStats();
+  Json::Value json;
+  json["enabled"] = enabled_.load(std::memory_order_relaxed);
+  json["admitted"] = static_cast<Json::UInt64>(stats.admitted);
+  json["inline"] = static_cast<Json::UInt64>(stats.inline_requests);
+  json["rateLimited"] = static_cast<Json::UInt64>(stats.rate_limited);
+  json["shed"] = static_cast<Json::UInt64>(stats.shed);
+  json["rejected"] = static_cast<Json::UInt64>(stats.rejected);
+  json["queueDepth"] = static_cast<Json::UInt64>(stats.queue_depth);
+  json["maxQueueSize"] = static_cast<Json::UInt64>(config_.max_queue_size);
+  json["activeWorkers"] = static_cast<Json::UInt64>(stats.active_workers);
+  json["workerThreads"] = static_cast<Json::UInt64>(workers_.size());
+  return json;
+}
@@ -0,0 +1,241 @@
+#include "core/source_auto_tuner.h"
+#include "utils/param_parse.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using ParamParse::parseDouble;
+
+namespace {
+
+// Resolution changes in steps of about 20% of the width
+constexpr double kResizeStep = 0.8;
+
+// Ratios are stored in additionalParams; two decimals keep them readable
+double round2(double value) { return std::round(value * 100.0) / 100.0; }
+
+// Unset fields never match
+bool sameSetting(const SourceAutoTuner::Setting &a,
+                 const SourceAutoTuner::Setting &b) {
+  return a.resize_ratio > 0.0 && b.resize_ratio > 0.0 &&
+         std::abs(a.resize_ratio - b.resize_ratio) < 0.005 &&
+         a.skip_interval >= 0 && a.skip_interval == b.skip_interval;
+}
+
+} // namespace
+
+SourceAutoTuner::Options
+SourceAutoTuner::parseOptions(const std::map<std::string, std::string> &params,
+                              const Options &defaults) {
+  Options options = defaults;
+  options.target_fps = parseDouble(params, "AUTO_TUNE_TARGET_FPS",
+                                   options.target_fps, 0.0, 240.0);
+  options.min_object_px = static_cast<int>(parseDouble(
+      params, "AUTO_TUNE_MIN_OBJECT_PX", options.min_object_px, 0, 10000));
+  options.detector_min_px = static_cast<int>(parseDouble(
+      params, "AUTO_TUNE_DETECTOR_MIN_PX", options.detector_min_px, 1, 1000));
+  options.max_decoded_width = static_cast<int>(parseDouble(
+      params, "AUTO_TUNE_MAX_WIDTH", options.max_decoded_width, 0, 16384));
+  return options;
+}
+
+const char *SourceAutoTuner::loadName(Load load) {
+  switch (load) {
+  case Load::Unknown:
+    return "unknown";
+  case Load::Overloaded:
+    return "overloaded";
+  case Load::Balanced:
+    return "balanced";
+  case Load::Spare:
+    return "spare";
+  }
+  return "unknown";
+}
+
+SourceAutoTuner::SourceAutoTuner(const Options &options, const Setting &current,
+                                 const Setting &pinned, const Setting &running)
+    : options_(options), current_(current), pinned_(pinned),
+      running_(running) {
+  current_ = applyPins(current_);
+}
+
+SourceAutoTuner::SourceAutoTuner(const Options &options, const Setting &current,
+                                 const Setting &pinned)
+    : SourceAutoTuner(options, current, pinned, Setting()) {}
+
+SourceAutoTuner::Setting SourceAutoTuner::applyPins(Setting setting) const {
+  if (pinned_.resize_ratio > 0.0) {
+    setting.resize_ratio = pinned_.resize_ratio;
+  }
+  if (pinned_.skip_interval >= 0) {
+    setting.skip_interval = pinned_.skip_interval;
+  }
+  return setting;
+}
+
+double SourceAutoTuner::minResizeRatio() const {
+  double floor = options_.min_resize_ratio;
+  if (options_.min_object_px > 0) {
+    floor = std::max(floor, static_cast<double>(options_.detector_min_px) /
+                                options_.min_object_px);
+  }
+  // Round up so the detection floor is never undershot
+  return std::min(1.0, std::ceil(floor * 100.0) / 100.0);
+}
+
+double SourceAutoTuner::maxResizeRatio(int sourceWidth) const {
+  double ceiling = 1.0;
+  if (sourceWidth > 0 && options_.max_decoded_width > 0) {
+    ceiling = std::min(1.0, std::floor(options_.max_decoded_width * 100.0 /
+                                       sourceWidth) /
+                                100.0);
+  }
+  // Keeping objects detectable wins over the decode width cap
+  return std::max(ceiling, minResizeRatio());
+}
+
+int SourceAutoTuner::baseSkipInterval(double sourceFps) const {
+  if (options_.target_fps <= 0.0 || sourceFps <= 0.0) {
+    return 0;
+  }
+  int skip = static_cast<int>(std::floor(sourceFps / options_.target_fps +
+                                         1e-6)) -
+             1;
+  return std::clamp(skip, 0, options_.max_skip_interval);
+}
+
+SourceAutoTuner::Setting SourceAutoTuner::initialSetting(int sourceWidth,
+                                                         double sourceFps) const {
+  Setting setting;
+  setting.resize_ratio = maxResizeRatio(sourceWidth);
+  setting.skip_interval = baseSkipInterval(sourceFps);
+  return applyPins(setting);
+}
+
+SourceAutoTuner::Load SourceAutoTuner::classify(const Sample &sample) const {
+  if (sample.source_fps <= 0.0 || sample.processed_fps <= 0.0) {
+    return Load::Unknown;
+  }
+  int skip = std::max(current_.skip_interval, 0);
+  double offered = sample.source_fps / (skip + 1);
+  bool cpuKnown = sample.cpu_headroom >= 0.0;
+
+  if (sample.queue_size >= options_.queue_high ||
+      sample.processed_fps < 0.85 * offered ||
+      (cpuKnown && sample.cpu_headroom < options_.min_cpu_headroom)) {
+    return Load::Overloaded;
+  }
+
+  // Per-frame latency must fit the frame budget (with rounding slack; some
+  // backends report latency as 1000 / processed fps)
+  double budgetMs = 1000.0 / offered;
+  if (sample.queue_size <= 1 && sample.processed_fps >= 0.95 * offered &&
+      (!cpuKnown || sample.cpu_headroom >= options_.spare_cpu_headroom) &&
+      sample.latency_ms <= 1.1 * budgetMs) {
+    return Load::Spare;
+  }
+  return Load::Balanced;
+}
+
+SourceAutoTuner::Decision SourceAutoTuner::update(const Sample &sample,
+                                                  Clock::time_point now) {
+  Decision decision;
+  decision.setting = current_;
+
+  if (sample.source_width <= 0 || sample.source_fps <= 0.0) {
+    decision.reason = "waiting for source statistics";
+    return decision;
+  }
+
+  // First measurement of the stream: open-loop choice
+  if (current_.resize_ratio <= 0.0 || current_.skip_interval < 0) {
+    Setting initial = initialSetting(sample.source_width, sample.source_fps);
+    if (current_.resize_ratio > 0.0) {
+      initial.resize_ratio = current_.resize_ratio;
+    }
+    if (current_.skip_interval >= 0) {
+      initial.skip_interval = current_.skip_interval;
+    }
+    // What the pipeline runs with now
+    Setting effective = current_;
+    if (effective.resize_ratio <= 0.0) {
+      effective.resize_ratio = running_.resize_ratio;
+    }
+    if (effective.skip_interval < 0) {
+      effective.skip_interval = running_.skip_interval;
+    }
+    current_ = initial;
+    decision.setting = current_;
+    decision.reason = "initial setting for " +
+                      std::to_string(sample.source_width) + "x" +
+                      std::to_string(sample.source_height) + " source";
+    if (sameSetting(initial, effective)) {
+      // Applying it would only restart the pipeline
+      decision.reason += " already in use";
+      return decision;
+    }
+    last_change_ = now;
+    changed_once_ = true;
+    decision.changed = true;
+    return decision;
+  }
+
+  Load load = classify(sample);
+  decision.load = load;
+  if (load == streak_load_) {
+    ++streak_;
+  } else {
+    streak_load_ = load;
+    streak_ = 1;
+  }
+
+  if (load == Load::Unknown || load == Load::Balanced ||
+      streak_ < options_.stable_samples ||
+      (changed_once_ && now - last_change_ < options_.cooldown)) {
+    decision.reason = loadName(load);
+    return decision;
+  }
+
+  Setting next = current_;
+  bool resizePinned = pinned_.resize_ratio > 0.0;
+  bool skipPinned = pinned_.skip_interval >= 0;
+
+  if (load == Load::Overloaded) {
+    double floor = minResizeRatio();
+    if (!resizePinned && current_.resize_ratio > floor + 1e-9) {
+      next.resize_ratio =
+          std::max(floor, round2(current_.resize_ratio * kResizeStep));
+      decision.reason = "overloaded: lower resolution";
+    } else if (!skipPinned &&
+               current_.skip_interval < options_.max_skip_interval) {
+      next.skip_interval = current_.skip_interval + 1;
+      decision.reason = "overloaded at detection floor: skip more frames";
+    } else {
+      decision.reason = "overloaded at limits";
+      return decision;
+    }
+  } else {
+    double ceiling = maxResizeRatio(sample.source_width);
+    if (!skipPinned &&
+        current_.skip_interval > baseSkipInterval(sample.source_fps)) {
+      next.skip_interval = current_.skip_interval - 1;
+      decision.reason = "spare capacity: skip fewer frames";
+    } else if (!resizePinned && current_.resize_ratio < ceiling - 1e-9) {
+      next.resize_ratio =
+          std::min(ceiling, round2(current_.resize_ratio / kResizeStep));
+      decision.reason = "spare capacity: raise resolution";
+    } else {
+      decision.reason = "spare capacity at best setting";
+      return decision;
+    }
+  }
+
+  current_ = next;
+  last_change_ = now;
+  changed_once_ = true;
+  streak_ = 0;
+  decision.setting = current_;
+  decision.changed = true;
+  return decision;
+}
@@ -0,0 +1,471 @@
+#include "core/startup_profiler.h"
+#include "core/env_config.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <time.h>
+#include <unordered_map>
+#include <unistd.h>
+
+namespace {
+
+thread_local std::string t_thread_label = "main";
+
+int64_t bootTimeUs() {
+  struct timespec ts;
+  if (clock_gettime(CLOCK_BOOTTIME, &ts) != 0) {
+    return -1;
+  }
+  return static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+// Process start in microseconds since boot (/proc/self/stat field 22)
+int64_t processStartBootUs() {
+  std::ifstream stat("/proc/self/stat");
+  std::string content;
+  if (!std::getline(stat, content)) {
+    return -1;
+  }
+  // The command name may contain spaces; fields resume after the last ')'
+  size_t pos = content.rfind(')');
+  if (pos == std::string::npos) {
+    return -1;
+  }
+  std::istringstream fields(content.substr(pos + 1));
+  std::string field;
+  // Field 3 (state) is the first one after ')'; starttime is field 22
+  for (int i = 3; i < 22; ++i) {
+    if (!(fields >> field)) {
+      return -1;
+    }
+  }
+  unsigned long long start_ticks = 0;
+  if (!(fields >> start_ticks)) {
+    return -1;
+  }
+  long ticks_per_second = sysconf(_SC_CLK_TCK);
+  if (ticks_per_second <= 0) {
+    return -1;
+  }
+  return static_cast<int64_t>(start_ticks * 1000000ULL /
+                              static_cast<unsigned long long>(ticks_per_second));
+}
+
+double toMs(int64_t us) { return static_cast<double>(us) / 1000.0; }
+
+} // namespace
+
+// ========== StartupProfiler::Scope ==========
+
+StartupProfiler::Scope::Scope(std::string name, bool background)
+    : name_(std::move(name)), background_(background),
+      start_(std::chrono::steady_clock::now()),
+      exceptions_(std::uncaught_exceptions()) {}
+
+StartupProfiler::Scope::~Scope() {
+  if (status_ == Status::Ok && std::uncaught_exceptions() > exceptions_) {
+    status_ = Status::Failed;
+    error_ = "exception";
+  }
+  StartupProfiler::getInstance().record(name_, start_, status_, error_, {},
+                                        background_);
+}
+
+void StartupProfiler::Scope::fail(const std::string &error) {
+  status_ = Status::Failed;
+  error_ = error;
+}
+
+// ========== StartupProfiler ==========
+
+StartupProfiler::StartupProfiler()
+    : origin_(std::chrono::steady_clock::now()),
+      target_ms_(EnvConfig::getInt("EDGE_AI_STARTUP_TARGET_MS", 1000, 1,
+                                   600000)) {
+  int64_t boot_now = bootTimeUs();
+  int64_t process_start = processStartBootUs();
+  if (boot_now >= 0 && process_start >= 0 && boot_now >= process_start) {
+    pre_main_us_ = boot_now - process_start;
+  }
+}
+
+void StartupProfiler::record(Phase phase) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  phases_.push_back(std::move(phase));
+}
+
+void StartupProfiler::record(const std::string &name,
+                             std::chrono::steady_clock::time_point start,
+                             Status status, const std::string &error,
+                             const std::vector<std::string> &depends_on,
+                             bool background) {
+  auto end = std::chrono::steady_clock::now();
+  Phase phase;
+  phase.name = name;
+  phase.thread = t_thread_label;
+  phase.depends_on = depends_on;
+  phase.start_us = std::max<int64_t>(0, elapsedUs(start));
+  phase.duration_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+          .count();
+  phase.status = status;
+  phase.error = error;
+  phase.background = background;
+  record(std::move(phase));
+}
+
+void StartupProfiler::markReady() {
+  int64_t now = elapsedUs();
+  int64_t boot_now = bootTimeUs();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (ready_us_ < 0) {
+    ready_us_ = now;
+    ready_boot_us_ = boot_now;
+  }
+}
+
+bool StartupProfiler::isReady() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return ready_us_ >= 0;
+}
+
+int64_t
+StartupProfiler::elapsedUs(std::chrono::steady_clock::time_point at) const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(at - origin_)
+      .count();
+}
+
+void StartupProfiler::setThreadLabel(const std::string &label) {
+  t_thread_label = label;
+}
+
+const std::string &StartupProfiler::threadLabel() { return t_thread_label; }
+
+std::vector<StartupProfiler::Phase> StartupProfiler::getPhases() const {
+  std::vector<Phase> phases;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    phases = phases_;
+  }
+  std::stable_sort(phases.begin(), phases.end(),
+                   [](const Phase &a, const Phase &b) {
+                     return a.start_us < b.start_us;
+                   });
+  return phases;
+}
+
+const char *StartupProfiler::statusName(Status status) {
+  switch (status) {
+  case Status::Ok:
+    return "ok";
+  case Status::Failed:
+    return "failed";
+  case Status::Skipped:
+    return "skipped";
+  }
+  return "unknown";
+}
+
+Json::Value StartupProfiler::getTimelineJson() const {
+  auto phases = getPhases();
+  Json::Value json;
+  int64_t ready_us, ready_boot_us, pre_main_us;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ready_us = ready_us_;
+    ready_boot_us = ready_boot_us_;
+    pre_main_us = pre_main_us_;
+  }
+
+  json["ready"] = ready_us >= 0;
+  json["targetMs"] = target_ms_;
+  json["elapsedMs"] = toMs(elapsedUs());
+  if (pre_main_us >= 0) {
+    json["preMainMs"] = toMs(pre_main_us);
+  }
+  if (ready_us >= 0) {
+    json["readyMs"] = toMs(ready_us);
+    json["withinTarget"] = ready_us <= static_cast<int64_t>(target_ms_) * 1000;
+    if (pre_main_us >= 0) {
+      json["processStartToReadyMs"] = toMs(pre_main_us + ready_us);
+    }
+    if (ready_boot_us >= 0) {
+      json["bootToReadyMs"] = toMs(ready_boot_us);
+    }
+  }
+
+  Json::Value list(Json::arrayValue);
+  for (const auto &phase : phases) {
+    Json::Value item;
+    item["name"] = phase.name;
+    item["thread"] = phase.thread;
+    item["startMs"] = toMs(phase.start_us);
+    item["durationMs"] = toMs(phase.duration_us);
+    item["status"] = statusName(phase.status);
+    if (!phase.error.empty()) {
+      item["error"] = phase.error;
+    }
+    if (!phase.depends_on.empty()) {
+      Json::Value deps(Json::arrayValue);
+      for (const auto &dep : phase.depends_on) {
+        deps.append(dep);
+      }
+      item["dependsOn"] = deps;
+    }
+    if (phase.background) {
+      item["background"] = true;
+    }
+    list.append(item);
+  }
+  json["phases"] = list;
+  return json;
+}
+
+std::string StartupProfiler::formatSummary() const {
+  auto phases = getPhases();
+  int64_t ready_us, ready_boot_us, pre_main_us;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ready_us = ready_us_;
+    ready_boot_us = ready_boot_us_;
+    pre_main_us = pre_main_us_;
+  }
+
+  std::ostringstream oss;
+  char line[256];
+  oss << "[Startup] ========================================\n";
+  oss << "[Startup] Startup timeline (ms since main):\n";
+  std::snprintf(line, sizeof(line), "[Startup] %9s %10s  %-10s %s\n", "start",
+                "duration", "thread", "phase");
+  oss << line;
+  for (const auto &phase : phases) {
+    std::string name = phase.name;
+    if (phase.background) {
+      name += " (background)";
+    }
+    if (phase.status != Status::Ok) {
+      name += std::string(" [") + statusName(phase.status) + "]";
+    }
+    std::snprintf(line, sizeof(line), "[Startup] %9.1f %10.1f  %-10s %s\n",
+                  toMs(phase.start_us), toMs(phase.duration_us),
+                  phase.thread.c_str(), name.c_str());
+    oss << line;
+  }
+  if (ready_us >= 0) {
+    oss << "[Startup] API ready after " << toMs(ready_us) << " ms";
+    if (pre_main_us >= 0) {
+      oss << " (" << toMs(pre_main_us + ready_us) << " ms since exec";
+      if (ready_boot_us >= 0) {
+        oss << ", " << toMs(ready_boot_us) / 1000.0 << " s since boot";
+      }
+      oss << ")";
+    }
+    oss << ", target " << target_ms_ << " ms\n";
+  } else {
+    oss << "[Startup] API not ready yet (" << toMs(elapsedUs())
+        << " ms since main)\n";
+  }
+  oss << "[Startup] ========================================\n";
+  return oss.str();
+}
+
+void StartupProfiler::logSummary() const {
+  std::cerr << formatSummary() << std::flush;
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (ready_us_ > static_cast<int64_t>(target_ms_) * 1000) {
+    std::cerr << "[Startup] ⚠ API ready took " << toMs(ready_us_)
+              << " ms, over the " << target_ms_
+              << " ms target (EDGE_AI_STARTUP_TARGET_MS)" << std::endl;
+  }
+}
+
+void StartupProfiler::reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  phases_.clear();
+  origin_ = std::chrono::steady_clock::now();
+  ready_us_ = -1;
+  ready_boot_us_ = -1;
+}
+
+// ========== StartupTaskGraph ==========
+
+StartupTaskGraph::StartupTaskGraph(size_t threads)
+    : threads_(threads == 0 ? defaultThreads() : threads) {}
+
+size_t StartupTaskGraph::defaultThreads() {
+  unsigned int cpus = std::max(1U, std::thread::hardware_concurrency());
+  int default_threads = static_cast<int>(std::min(cpus, 4U));
+  return static_cast<size_t>(
+      EnvConfig::getInt("EDGE_AI_STARTUP_THREADS", default_threads, 1, 16));
+}
+
+void StartupTaskGraph::add(const std::string &name,
+                           std::vector<std::string> depends_on,
+                           std::function<void()> fn) {
+  Task task;
+  task.name = name;
+  task.depends_on = std::move(depends_on);
+  task.fn = std::move(fn);
+  tasks_.push_back(std::move(task));
+}
+
+void StartupTaskGraph::run() {
+  // Resolve dependencies and reject cycles before running anything
+  std::unordered_map<std::string, size_t> index;
+  for (size_t i = 0; i < tasks_.size(); ++i) {
+    if (!index.emplace(tasks_[i].name, i).second) {
+      throw std::invalid_argument("Duplicate startup phase: " +
+                                  tasks_[i].name);
+    }
+  }
+  for (size_t i = 0; i < tasks_.size(); ++i) {
+    tasks_[i].pending = tasks_[i].depends_on.size();
+    tasks_[i].dependents.clear();
+  }
+  for (size_t i = 0; i < tasks_.size(); ++i) {
+    for (const auto &dep : tasks_[i].depends_on) {
+      auto it = index.find(dep);
+      if (it == index.end()) {
+        throw std::invalid_argument("Startup phase '" + tasks_[i].name +
+                                    "' depends on unknown phase '" + dep +
+                                    "'");
+      }
+      tasks_[it->second].dependents.push_back(i);
+    }
+  }
+  {
+    std::vector<size_t> pending(tasks_.size());
+    std::vector<size_t> queue;
+    for (size_t i = 0; i < tasks_.size(); ++i) {
+      pending[i] = tasks_[i].pending;
+      if (pending[i] == 0) {
+        queue.push_back(i);
+      }
+    }
+    size_t visited = 0;
+    while (!queue.empty()) {
+      size_t i = queue.back();
+      queue.pop_back();
+      ++visited;
+      for (size_t d : tasks_[i].dependents) {
+        if (--pending[d] == 0) {
+          queue.push_back(d);
+        }
+      }
+    }
+    if (visited != tasks_.size()) {
+      throw std::invalid_argument("Startup phases have a dependency cycle");
+    }
+  }
+
+  enum class State { Waiting, Queued, Done, Skipped };
+  std::vector<State> state(tasks_.size(), State::Waiting);
+  std::deque<size_t> ready;
+  size_t remaining = tasks_.size();
+  std::exception_ptr first_error;
+  std::mutex mutex;
+  std::condition_variable cv;
+  auto &profiler = StartupProfiler::getInstance();
+
+  for (size_t i = 0; i < tasks_.size(); ++i) {
+    if (tasks_[i].pending == 0) {
+      state[i] = State::Queued;
+      ready.push_back(i);
+    }
+  }
+
+  // Caller holds mutex
+  std::function<void(size_t, const std::string &)> skipDependents =
+      [&](size_t failed, const std::string &cause) {
+        for (size_t d : tasks_[failed].dependents) {
+          if (state[d] != State::Waiting) {
+            continue;
+          }
+          state[d] = State::Skipped;
+          --remaining;
+          StartupProfiler::Phase phase;
+          phase.name = tasks_[d].name;
+          phase.thread = StartupProfiler::threadLabel();
+          phase.depends_on = tasks_[d].depends_on;
+          phase.start_us = profiler.elapsedUs();
+          phase.status = StartupProfiler::Status::Skipped;
+          phase.error = "dependency '" + cause + "' failed";
+          profiler.record(std::move(phase));
+          skipDependents(d, cause);
+        }
+      };
+
+  auto worker = [&]() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      cv.wait(lock, [&]() { return !ready.empty() || remaining == 0; });
+      if (ready.empty()) {
+        return;
+      }
+      size_t i = ready.front();
+      ready.pop_front();
+      lock.unlock();
+
+      Task &task = tasks_[i];
+      auto start = std::chrono::steady_clock::now();
+      std::exception_ptr error;
+      std::string message;
+      try {
+        task.fn();
+      } catch (const std::exception &e) {
+        error = std::current_exception();
+        message = e.what();
+      } catch (...) {
+        error = std::current_exception();
+        message = "unknown exception";
+      }
+      profiler.record(task.name, start,
+                      error ? StartupProfiler::Status::Failed
+                            : StartupProfiler::Status::Ok,
+                      message, task.depends_on);
+
+      lock.lock();
+      state[i] = State::Done;
+      --remaining;
+      if (error) {
+        std::cerr << "[Startup] ✗ Phase '" << task.name
+                  << "' failed: " << message << std::endl;
+        if (!first_error) {
+          first_error = error;
+        }
+        skipDependents(i, task.name);
+      } else {
+        for (size_t d : task.dependents) {
+          if (--tasks_[d].pending == 0 && state[d] == State::Waiting) {
+            state[d] = State::Queued;
+            ready.push_back(d);
+          }
+        }
+      }
+      cv.notify_all();
+    }
+  };
+
+  std::vector<std::thread> helpers;
+  for (size_t t = 1; t < threads_ && t < tasks_.size(); ++t) {
+    helpers.emplace_back([&, t]() {
+      StartupProfiler::setThreadLabel("init-" + std::to_string(t));
+      worker();
+    });
+  }
+  worker();
+  for (auto &helper : helpers) {
+    helper.join();
+  }
+
+  if (first_error) {
+    std::rethrow_exception(first_error);
+  }
+}
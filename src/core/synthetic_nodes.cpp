@@ -0,0 +1,186 @@
+#include "core/synthetic_nodes.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cvedix/objects/cvedix_frame_target.h>
+#include <json/value.h>
+#include <json/writer.h>
+#include <opencv2/imgproc.hpp>
+#include <thread>
+
+namespace SyntheticNodes {
+
+namespace {
+
+const char *const kLabels[] = {"person", "car", "bicycle"};
+
+} // namespace
+
+// ========== SyntheticSourceNode ==========
+
+SyntheticSourceNode::SyntheticSourceNode(
+    const std::string &node_name,
+    const SyntheticWorkload::SourceOptions &options)
+    : cvedix_nodes::cvedix_src_node(node_name, options.channel, 1.0f),
+      options_(options) {
+  original_width = options_.width;
+  original_height = options_.height;
+  original_fps = static_cast<int>(std::lround(options_.fps));
+
+  // Diagonal gradient, rendered once and copied per frame
+  pattern_.create(options_.height, options_.width, CV_8UC3);
+  for (int y = 0; y < pattern_.rows; ++y) {
+    auto *row = pattern_.ptr<cv::Vec3b>(y);
+    for (int x = 0; x < pattern_.cols; ++x) {
+      row[x] = cv::Vec3b(static_cast<uchar>((x * 255) / pattern_.cols),
+                         static_cast<uchar>((y * 255) / pattern_.rows),
+                         static_cast<uchar>(((x + y) / 4) & 0xFF));
+    }
+  }
+
+  this->initialized();
+}
+
+SyntheticSourceNode::~SyntheticSourceNode() { deinitialized(); }
+
+void SyntheticSourceNode::handle_run() {
+  const auto interval = SyntheticWorkload::frameInterval(options_);
+  const int barWidth = std::max(options_.width / 32, 4);
+  auto next = std::chrono::steady_clock::now();
+
+  while (alive) {
+    // Blocks while the node is stopped
+    gate.knock();
+    if (!alive) {
+      break;
+    }
+
+    // Pace at the configured fps; after a stop or a stall, restart the
+    // schedule instead of bursting to catch up
+    auto now = std::chrono::steady_clock::now();
+    if (now > next + interval) {
+      next = now;
+    }
+    std::this_thread::sleep_until(next);
+    next += interval;
+
+    this->frame_index++;
+    cv::Mat frame = pattern_.clone();
+    int travel = std::max(options_.width - barWidth, 1);
+    int barX = static_cast<int>((static_cast<int64_t>(frame_index) * 8) %
+                                travel);
+    cv::rectangle(frame, cv::Rect(barX, 0, barWidth, options_.height),
+                  cv::Scalar(255, 255, 255), cv::FILLED);
+
+    auto out_meta = std::make_shared<cvedix_objects::cvedix_frame_meta>(
+        frame, this->frame_index, this->channel_index, options_.width,
+        options_.height, original_fps);
+    this->out_queue.push(out_meta);
+    if (this->meta_handled_hooker) {
+      this->meta_handled_hooker(node_name, out_queue.size(), out_meta);
+    }
+    // Wake the dispatch thread
+    this->out_queue_semaphore.signal();
+  }
+
+  // Dead flag for the dispatch thread
+  this->out_queue.push(nullptr);
+  this->out_queue_semaphore.signal();
+}
+
+// ========== SyntheticDetectorNode ==========
+
+SyntheticDetectorNode::SyntheticDetectorNode(
+    const std::string &node_name,
+    const SyntheticWorkload::DetectorOptions &options)
+    : cvedix_nodes::cvedix_node(node_name), options_(options) {
+  this->initialized();
+}
+
+SyntheticDetectorNode::~SyntheticDetectorNode() { deinitialized(); }
+
+std::shared_ptr<cvedix_objects::cvedix_meta>
+SyntheticDetectorNode::handle_frame_meta(
+    std::shared_ptr<cvedix_objects::cvedix_frame_meta> meta) {
+  auto latency = SyntheticWorkload::latencyFor(options_, meta->frame_index);
+  if (options_.busy_wait) {
+    auto deadline = std::chrono::steady_clock::now() + latency;
+    while (std::chrono::steady_clock::now() < deadline) {
+      // Spin: simulates a CPU-bound model
+    }
+  } else if (latency.count() > 0) {
+    std::this_thread::sleep_for(latency);
+  }
+
+  auto boxes = SyntheticWorkload::generateBoxes(
+      options_, meta->frame_index, meta->frame.cols, meta->frame.rows);
+  for (const auto &box : boxes) {
+    meta->targets.push_back(
+        std::make_shared<cvedix_objects::cvedix_frame_target>(
+            box.x, box.y, box.width, box.height, box.class_id, box.score,
+            meta->frame_index, meta->channel_index, kLabels[box.class_id]));
+  }
+  return meta;
+}
+
+// ========== SyntheticBANode ==========
+
+SyntheticBANode::SyntheticBANode(const std::string &node_name)
+    : cvedix_nodes::cvedix_node(node_name) {
+  this->initialized();
+}
+
+SyntheticBANode::~SyntheticBANode() { deinitialized(); }
+
+std::shared_ptr<cvedix_objects::cvedix_meta> SyntheticBANode::handle_frame_meta(
+    std::shared_ptr<cvedix_objects::cvedix_frame_meta> meta) {
+  targets_seen_.fetch_add(meta->targets.size(), std::memory_order_relaxed);
+  return meta;
+}
+
+// ========== SyntheticBrokerNode ==========
+
+SyntheticBrokerNode::SyntheticBrokerNode(
+    const std::string &node_name,
+    const SyntheticWorkload::BrokerOptions &options)
+    : cvedix_nodes::cvedix_node(node_name), options_(options) {
+  this->initialized();
+}
+
+SyntheticBrokerNode::~SyntheticBrokerNode() { deinitialized(); }
+
+std::shared_ptr<cvedix_objects::cvedix_meta>
+SyntheticBrokerNode::handle_frame_meta(
+    std::shared_ptr<cvedix_objects::cvedix_frame_meta> meta) {
+  if (options_.serialize) {
+    Json::Value msg;
+    msg["channel_index"] = meta->channel_index;
+    msg["frame_index"] = meta->frame_index;
+    msg["timestamp"] = static_cast<Json::Int64>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count());
+    Json::Value targets(Json::arrayValue);
+    for (const auto &target : meta->targets) {
+      Json::Value t;
+      t["x"] = target->x;
+      t["y"] = target->y;
+      t["width"] = target->width;
+      t["height"] = target->height;
+      t["class_id"] = target->primary_class_id;
+      t["label"] = target->primary_label;
+      t["score"] = target->primary_score;
+      targets.append(t);
+    }
+    msg["targets"] = targets;
+
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    bytes_.fetch_add(Json::writeString(builder, msg).size(),
+                     std::memory_order_relaxed);
+  }
+  messages_.fetch_add(1, std::memory_order_relaxed);
+  return meta;
+}
+
+} // namespace SyntheticNodes
@@ -0,0 +1,143 @@
+#include "core/synthetic_workload.h"
+#include "utils/param_parse.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace SyntheticWorkload {
+
+namespace {
+
+using ParamParse::invalid;
+using ParamParse::lookup;
+using ParamParse::parseBool;
+using ParamParse::parseDouble;
+using ParamParse::parseInt;
+
+// Small integer hash (lowbias32) used to derive per-box constants
+uint32_t mix(uint32_t x) {
+  x ^= x >> 16;
+  x *= 0x7feb352dU;
+  x ^= x >> 15;
+  x *= 0x846ca68bU;
+  x ^= x >> 16;
+  return x;
+}
+
+// Position on [0, range] bouncing between the ends
+int bounce(int64_t travelled, int range) {
+  if (range <= 0) {
+    return 0;
+  }
+  int64_t period = 2 * static_cast<int64_t>(range);
+  int64_t q = travelled % period;
+  if (q < 0) {
+    q += period;
+  }
+  return static_cast<int>(q <= range ? q : period - q);
+}
+
+} // namespace
+
+SourceOptions
+parseSourceOptions(const std::map<std::string, std::string> &params) {
+  SourceOptions options;
+  options.channel = parseInt(params, "channel", options.channel, 0, 1023);
+  options.width = parseInt(params, "width", options.width, 16, 7680);
+  options.height = parseInt(params, "height", options.height, 16, 4320);
+  options.fps = parseDouble(params, "fps", options.fps, 0.1, 240.0);
+  return options;
+}
+
+DetectorOptions
+parseDetectorOptions(const std::map<std::string, std::string> &params) {
+  DetectorOptions options;
+  options.latency_ms =
+      parseInt(params, "latency_ms", options.latency_ms, 0, 10000);
+  options.latency_jitter_ms = parseInt(params, "latency_jitter_ms",
+                                       options.latency_jitter_ms, 0, 10000);
+  if (const std::string *mode = lookup(params, "latency_mode")) {
+    if (*mode == "busy") {
+      options.busy_wait = true;
+    } else if (*mode != "sleep") {
+      invalid("latency_mode", *mode, "sleep or busy");
+    }
+  }
+  options.boxes = parseInt(params, "boxes", options.boxes, 0, 256);
+  options.min_box = parseInt(params, "min_box", options.min_box, 1, 4096);
+  options.max_box = parseInt(params, "max_box", options.max_box, 1, 4096);
+  if (options.max_box < options.min_box) {
+    invalid("max_box", std::to_string(options.max_box),
+            "a value >= min_box (" + std::to_string(options.min_box) + ")");
+  }
+  options.seed = static_cast<uint32_t>(
+      parseInt(params, "seed", static_cast<int>(options.seed), 0, 1 << 30));
+  return options;
+}
+
+BrokerOptions
+parseBrokerOptions(const std::map<std::string, std::string> &params) {
+  BrokerOptions options;
+  options.serialize = parseBool(params, "serialize", options.serialize);
+  return options;
+}
+
+std::chrono::nanoseconds frameInterval(const SourceOptions &options) {
+  return std::chrono::nanoseconds(
+      static_cast<int64_t>(1e9 / std::max(options.fps, 0.1)));
+}
+
+std::chrono::microseconds latencyFor(const DetectorOptions &options,
+                                     int frameIndex) {
+  int64_t us = static_cast<int64_t>(options.latency_ms) * 1000;
+  if (options.latency_jitter_ms > 0) {
+    int64_t span = static_cast<int64_t>(options.latency_jitter_ms) * 2000 + 1;
+    uint32_t h = mix(options.seed ^ mix(static_cast<uint32_t>(frameIndex)));
+    us += static_cast<int64_t>(h % span) -
+          static_cast<int64_t>(options.latency_jitter_ms) * 1000;
+  }
+  return std::chrono::microseconds(std::max<int64_t>(us, 0));
+}
+
+std::vector<Box> generateBoxes(const DetectorOptions &options, int frameIndex,
+                               int width, int height) {
+  std::vector<Box> boxes;
+  if (options.boxes <= 0 || width <= 0 || height <= 0) {
+    return boxes;
+  }
+  boxes.reserve(options.boxes);
+  int sizeRange = options.max_box - options.min_box + 1;
+  int64_t t = std::max(frameIndex, 0);
+
+  for (int i = 0; i < options.boxes; ++i) {
+    uint32_t h0 = mix(options.seed * 0x9e3779b9U + static_cast<uint32_t>(i));
+    uint32_t h1 = mix(h0);
+    uint32_t h2 = mix(h1);
+
+    Box box;
+    box.width = std::min(options.min_box + static_cast<int>(h0 % sizeRange),
+                         width);
+    box.height = std::min(
+        options.min_box + static_cast<int>((h0 >> 12) % sizeRange), height);
+
+    // 1-4 px per frame along each axis, either direction
+    int vx = 1 + static_cast<int>(h1 % 4);
+    int vy = 1 + static_cast<int>((h1 >> 8) % 4);
+    if (h1 & 0x10000U) {
+      vx = -vx;
+    }
+    if (h1 & 0x20000U) {
+      vy = -vy;
+    }
+    box.x = bounce(static_cast<int64_t>(h2 % 65536) + vx * t,
+                   width - box.width);
+    box.y = bounce(static_cast<int64_t>((h2 >> 16) % 65536) + vy * t,
+                   height - box.height);
+
+    box.class_id = static_cast<int>(h0 % 3);
+    box.score = 0.5f + static_cast<float>(h2 % 500) / 1000.0f;
+    boxes.push_back(box);
+  }
+  return boxes;
+}
+
+} // namespace SyntheticWorkload
@@ -1,4 +1,5 @@
 #include "instances/inprocess_instance_manager.h"
+#include "core/queue_telemetry.h"
 #include "models/update_instance_request.h"
 #include <algorithm>
 #include <cctype>
@@ -272,6 +273,17 @@ InProcessInstanceManager::getLastFrame(const std::string &instanceId) const {
   return registry_.getLastFrame(instanceId);
 }
 
+std::string
+InProcessInstanceManager::getLastFrameJpeg(const std::string &instanceId) const {
+  return registry_.getLastFrameJpeg(instanceId);
+}
+
+Json::Value
+InProcessInstanceManager::getQueueTelemetry(const std::string &instanceId,
+                                            size_t maxSamples) const {
+  return QueueTelemetry::getInstance().toJson(instanceId, maxSamples);
+}
+
 Json::Value InProcessInstanceManager::getInstanceConfig(
     const std::string &instanceId) const {
   return registry_.getInstanceConfig(instanceId);
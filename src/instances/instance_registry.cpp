@@ -4,11 +4,18 @@
 #include "core/cvedix_validator.h"
 #include "core/logger.h"
 #include "core/logging_flags.h"
+#include "core/pipeline_metrics.h"
+#include "core/preview_stream_hub.h"
+#include "core/queue_telemetry.h"
+#include "core/synthetic_nodes.h"
 #include "core/timeout_constants.h"
 #include "core/uuid_generator.h"
+#include "instances/queue_monitor.h"
 #include "models/update_instance_request.h"
+#include "utils/base64_codec.h"
 #include "utils/gstreamer_checker.h"
 #include "utils/mp4_directory_watcher.h"
+#include "utils/mp4_finalize_queue.h"
 #include "utils/mp4_finalizer.h"
 #include <algorithm>
 #include <atomic>
@@ -629,6 +636,14 @@ bool InstanceRegistry::deleteInstance(const std::string &instanceId) {
     }
   }
 
+  // Drop queue depth telemetry (history is kept across restarts, not deletes)
+  QueueTelemetry::getInstance().remove(instanceId);
+  PipelineMetricsRegistry::getInstance().remove(instanceId);
+  PreviewStreamHub::getInstance().removeInstance(instanceId);
+  QueueMonitor::getInstance().clearStats(instanceId);
+  BackpressureController::BackpressureController::getInstance()
+      .unregisterInstance(instanceId);
+
   // Delete from storage (doesn't need lock)
   // Always delete from storage since all instances are saved to storage for
   // debugging/inspection This prevents deleted instances from being reloaded on
@@ -1890,24 +1905,20 @@ bool InstanceRegistry::stopInstance(const std::string &instanceId) {
                    "in: "
                 << recordPath << std::endl;
 
-      // Finalize all MP4 files in the record directory
-      // This will:
-      // 1. Try faststart on each file
+      // Finalize all MP4 files in the record directory on the shared
+      // finalize queue. This will:
+      // 1. Move moov to the front (in process; already finalized files are
+      //    only scanned)
       // 2. If file needs conversion (H.264 High profile or yuv444p), convert to
       //    Baseline + yuv420p
       // 3. Overwrite original file with converted version
-      int processed = MP4Finalizer::MP4Finalizer::finalizeDirectory(
-          recordPath, true); // true = convert to compatible format if needed
+      size_t queued = MP4Finalizer::MP4FinalizeQueue::getInstance()
+                          .submitDirectory(recordPath,
+                                           true); // true = convert if needed
 
-      std::cerr << "[InstanceRegistry] [MP4Finalizer] ✓ Completed finalization "
-                   "for instance "
-                << instanceId << std::endl;
-      std::cerr << "[InstanceRegistry] [MP4Finalizer] Converted " << processed
-                << " MP4 file(s) to compatible format" << std::endl;
-      std::cerr
-          << "[InstanceRegistry] [MP4Finalizer] All files are now viewable "
-             "with standard video players"
-          << std::endl;
+      std::cerr << "[InstanceRegistry] [MP4Finalizer] ✓ Queued " << queued
+                << " MP4 file(s) of instance " << instanceId
+                << " for finalization" << std::endl;
     });
 
     // Detach thread so it runs independently and doesn't block instance stop
@@ -2594,6 +2605,7 @@ InstanceRegistry::createInstanceInfo(const std::string &instanceId,
 
   // Performance mode
   info.performanceMode = req.performanceMode;
+  info.resourceLimits = req.resourceLimits; // Only applied in subprocess mode
 
   // SolutionManager settings
   info.recommendedFrameRate = req.recommendedFrameRate;
@@ -3514,8 +3526,24 @@ bool InstanceRegistry::startPipeline(
       return true;
     }
 
+    // Check for synthetic source node (load testing)
+    auto syntheticNode =
+        std::dynamic_pointer_cast<SyntheticNodes::SyntheticSourceNode>(
+            nodes[0]);
+    if (syntheticNode) {
+      std::cerr << "[InstanceRegistry] Starting synthetic source pipeline ("
+                << syntheticNode->options().width << "x"
+                << syntheticNode->options().height << " @ "
+                << syntheticNode->options().fps << " fps)..." << std::endl;
+      syntheticNode->start();
+      std::cerr
+          << "[InstanceRegistry] Synthetic source pipeline started successfully"
+          << std::endl;
+      return true;
+    }
+
     // If not a recognized source node, cannot start pipeline
-    // RTSP, File, and RTMP source nodes are currently supported
+    // RTSP, File, RTMP and synthetic source nodes are currently supported
     std::cerr << "[InstanceRegistry] ✗ Error: First node is not a recognized "
                  "source node (RTSP, File, or RTMP)"
               << std::endl;
@@ -3899,6 +3927,13 @@ void InstanceRegistry::stopPipeline(
           } else {
             // Generic stop for other source types
             try {
+              // Synthetic source has no GStreamer state: stop generating,
+              // then detach
+              auto syntheticNode = std::dynamic_pointer_cast<
+                  SyntheticNodes::SyntheticSourceNode>(nodes[0]);
+              if (syntheticNode) {
+                syntheticNode->stop();
+              }
               if (nodes[0]) {
                 nodes[0]->detach_recursively();
               }
@@ -5278,31 +5313,6 @@ InstanceRegistry::getInstanceConfig(const std::string &instanceId) const {
   return config;
 }
 
-// Base64 encoding helper function
-static std::string base64_encode(const unsigned char *data, size_t length) {
-  static const char base64_chars[] =
-      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-
-  std::string encoded;
-  encoded.reserve(((length + 2) / 3) * 4);
-
-  size_t i = 0;
-  while (i < length) {
-    unsigned char byte1 = data[i++];
-    unsigned char byte2 = (i < length) ? data[i++] : 0;
-    unsigned char byte3 = (i < length) ? data[i++] : 0;
-
-    unsigned int combined = (byte1 << 16) | (byte2 << 8) | byte3;
-
-    encoded += base64_chars[(combined >> 18) & 0x3F];
-    encoded += base64_chars[(combined >> 12) & 0x3F];
-    encoded += (i - 2 < length) ? base64_chars[(combined >> 6) & 0x3F] : '=';
-    encoded += (i - 1 < length) ? base64_chars[combined & 0x3F] : '=';
-  }
-
-  return encoded;
-}
-
 std::optional<InstanceStatistics>
 InstanceRegistry::getInstanceStatistics(const std::string &instanceId) {
   // CRITICAL: Minimize lock scope to prevent blocking when other instances are
@@ -5700,6 +5710,24 @@ InstanceRegistry::getLastFrame(const std::string &instanceId) const {
   std::cout << "[InstanceRegistry] getLastFrame() called for instance: "
             << instanceId << std::endl;
 
+  FramePtr frame_ptr = getCachedFrame(instanceId);
+  if (!frame_ptr || frame_ptr->empty()) {
+    return "";
+  }
+  return encodeFrameToBase64(*frame_ptr, 85); // Default quality 85%
+}
+
+std::string
+InstanceRegistry::getLastFrameJpeg(const std::string &instanceId) const {
+  FramePtr frame_ptr = getCachedFrame(instanceId);
+  if (!frame_ptr || frame_ptr->empty()) {
+    return "";
+  }
+  return encodeFrameToJpeg(*frame_ptr, 85);
+}
+
+InstanceRegistry::FramePtr
+InstanceRegistry::getCachedFrame(const std::string &instanceId) const {
   // PHASE 1 OPTIMIZATION: Get shared_ptr copy quickly, release lock
   // CRITICAL: Use timeout to prevent blocking if mutex is locked
   FramePtr frame_ptr;
@@ -5711,13 +5739,13 @@ InstanceRegistry::getLastFrame(const std::string &instanceId) const {
     // FRAME_CACHE_MUTEX_TIMEOUT_MS)
     if (!lock.try_lock_for(TimeoutConstants::getFrameCacheMutexTimeout())) {
       std::cerr << "[InstanceRegistry] WARNING: getLastFrame() timeout - "
-                   "frame_cache_mutex_ is locked, returning empty string"
+                   "frame_cache_mutex_ is locked, returning no frame"
                 << std::endl;
       if (isInstanceLoggingEnabled()) {
         PLOG_WARNING << "[InstanceRegistry] getLastFrame() timeout after "
                         "1000ms - mutex may be locked by another operation";
       }
-      return ""; // Return empty string to prevent blocking
+      return nullptr; // Don't block the caller
     }
 
     auto it = frame_caches_.find(instanceId);
@@ -5725,7 +5753,7 @@ InstanceRegistry::getLastFrame(const std::string &instanceId) const {
       std::cout << "[InstanceRegistry] getLastFrame() - No cache entry found "
                    "for instance: "
                 << instanceId << std::endl;
-      return ""; // No frame cached
+      return nullptr; // No frame cached
     }
 
     const FrameCache &cache = it->second;
@@ -5738,19 +5766,14 @@ InstanceRegistry::getLastFrame(const std::string &instanceId) const {
       std::cout << "[InstanceRegistry] getLastFrame() - Cache entry exists but "
                    "no frame available"
                 << std::endl;
-      return ""; // No frame cached
+      return nullptr; // No frame cached
     }
 
     // Get shared_ptr copy (reference counting, no copy of Mat data)
     frame_ptr = cache.frame;
   }
   // Lock released - frame_ptr keeps frame alive via reference counting
-
-  // Encode frame to base64 (frame_ptr dereferences to cv::Mat&)
-  if (!frame_ptr || frame_ptr->empty()) {
-    return "";
-  }
-  return encodeFrameToBase64(*frame_ptr, 85); // Default quality 85%
+  return frame_ptr;
 }
 
 void InstanceRegistry::updateFrameCache(const std::string &instanceId,
@@ -5890,7 +5913,18 @@ void InstanceRegistry::setupFrameCaptureHook(
               << instanceId
               << " (OSD node in pipeline: " << (hasOSDNode ? "yes" : "no")
               << ")" << std::endl;
-    appDesNode->set_app_des_result_hooker([this, instanceId, hasOSDNode](
+    // Resolve the backpressure handle once - the per-frame path below then
+    // needs no map lookup or lock (configured in startPipeline PHASE 3)
+    auto backpressureHandle =
+        BackpressureController::BackpressureController::getInstance()
+            .getHandle(instanceId);
+    if (!backpressureHandle) {
+      backpressureHandle =
+          BackpressureController::BackpressureController::getInstance()
+              .registerInstance(instanceId);
+    }
+    appDesNode->set_app_des_result_hooker([this, instanceId, hasOSDNode,
+                                           backpressureHandle](
                                               std::string /*node_name*/,
                                               std::shared_ptr<
                                                   cvedix_objects::cvedix_meta>
@@ -5910,13 +5944,11 @@ void InstanceRegistry::setupFrameCaptureHook(
 
           // PHASE 3: Check backpressure control before processing frame
           using namespace BackpressureController;
-          auto &backpressure =
-              BackpressureController::BackpressureController::getInstance();
 
           // Check if we should drop this frame (FPS limiting, queue full,
           // etc.)
-          if (backpressure.shouldDropFrame(instanceId)) {
-            backpressure.recordFrameDropped(instanceId);
+          if (backpressureHandle->shouldDropFrame()) {
+            backpressureHandle->recordFrameDropped();
 
             // Update dropped_frames counter in tracker (if tracker exists)
             // Use try_lock to avoid blocking frame processing
@@ -5929,7 +5961,9 @@ void InstanceRegistry::setupFrameCaptureHook(
                   // Get dropped count from backpressure controller (most
                   // accurate) Note: getStats returns a snapshot (value), not a
                   // pointer
-                  auto backpressureStats = backpressure.getStats(instanceId);
+                  auto backpressureStats =
+                      BackpressureController::BackpressureController::getStats(
+                          *backpressureHandle);
                   uint64_t dropped_from_backpressure =
                       backpressureStats.frames_dropped;
                   trackerIt->second.dropped_frames.store(
@@ -6005,7 +6039,7 @@ void InstanceRegistry::setupFrameCaptureHook(
           }
 
           // PHASE 3: Record frame processed for backpressure tracking
-          backpressure.recordFrameProcessed(instanceId);
+          backpressureHandle->recordFrameProcessed();
 
           // DEBUG: Log frame_meta details
           static thread_local std::unordered_map<std::string, uint64_t>
@@ -6164,6 +6198,22 @@ void InstanceRegistry::setupQueueSizeTrackingHook(
             << nodes.size() << " nodes" << std::endl;
   std::cout.flush();
 
+  // Per-node queue depth ring buffers - recorded lock-free on every frame and
+  // consumed directly by BackpressureController, AdaptiveQueueSizeManager and
+  // QueueMonitor
+  auto telemetry = QueueTelemetry::getInstance().getOrCreate(instanceId);
+  auto backpressureHandle =
+      BackpressureController::BackpressureController::getInstance().getHandle(
+          instanceId);
+  if (!backpressureHandle) {
+    backpressureHandle =
+        BackpressureController::BackpressureController::getInstance()
+            .registerInstance(instanceId);
+  }
+  // Exported by /v1/core/metrics straight from these atomics
+  auto metrics = PipelineMetricsRegistry::getInstance().attach(
+      instanceId, backpressureHandle, telemetry);
+
   for (size_t i = 0; i < nodes.size(); ++i) {
     const auto &node = nodes[i];
     if (!node) {
@@ -6171,6 +6221,8 @@ void InstanceRegistry::setupQueueSizeTrackingHook(
     }
 
     const bool isSourceNode = (i == 0); // First node is source node
+    QueueTelemetry::NodeSeries *series =
+        telemetry->addNode("node_" + std::to_string(i));
 
     if (isSourceNode) {
       std::cout << "[InstanceRegistry] Setting up hook on source node (index "
@@ -6179,13 +6231,31 @@ void InstanceRegistry::setupQueueSizeTrackingHook(
     }
 
     try {
-      node->set_meta_arriving_hooker([this, instanceId, isSourceNode](
-                                         std::string /*node_name*/,
-                                         int queue_size,
+      node->set_meta_arriving_hooker([this, instanceId, isSourceNode,
+                                      telemetry, series, backpressureHandle,
+                                      metrics](
+                                         std::string node_name, int queue_size,
                                          std::shared_ptr<
                                              cvedix_objects::cvedix_meta>
                                              meta) {
         try {
+          // Record queue depth first - lock-free, so overload is visible to
+          // consumers within this frame even if the registry lock is busy
+          if (series && queue_size >= 0) {
+            series->setName(node_name);
+            bool becameFull = series->record(static_cast<uint32_t>(queue_size),
+                                             telemetry->highWatermark());
+            if (becameFull) {
+              backpressureHandle->recordQueueFull();
+              QueueMonitor::getInstance().recordQueueFullWarning(instanceId,
+                                                                 node_name);
+            }
+          }
+          if (isSourceNode && meta &&
+              meta->meta_type == cvedix_objects::cvedix_meta_type::FRAME) {
+            metrics->frames_incoming.fetch_add(1, std::memory_order_relaxed);
+          }
+
           // OPTIMIZED: Use try_lock to avoid blocking frame processing
           // If lock is busy (e.g., another instance is starting), skip this
           // update Queue size tracking is not critical - missing one update
@@ -6242,10 +6312,9 @@ void InstanceRegistry::setupQueueSizeTrackingHook(
                 }
 
                 // Get dropped frames from backpressure controller
-                using namespace BackpressureController;
-                auto &backpressure = BackpressureController::
-                    BackpressureController::getInstance();
-                auto backpressureStats = backpressure.getStats(instanceId);
+                auto backpressureStats =
+                    BackpressureController::BackpressureController::getStats(
+                        *backpressureHandle);
 
                 // Update dropped_frames from backpressure controller (most
                 // accurate)
@@ -6260,33 +6329,17 @@ void InstanceRegistry::setupQueueSizeTrackingHook(
             }
 
             // Track queue size on all nodes
-            // FIX: Update queue size every time hook is called, not only when
-            // increasing This allows tracking actual queue size including when
-            // it decreases
-            tracker.current_queue_size = static_cast<size_t>(queue_size);
+            // Report the deepest node queue rather than whichever node called
+            // the hook last
+            tracker.current_queue_size = telemetry->currentMaxDepth();
 
             if (queue_size > static_cast<int>(tracker.max_queue_size_seen)) {
               tracker.max_queue_size_seen = static_cast<size_t>(queue_size);
             }
 
-            // PHASE 3: Update queue size in backpressure controller for
-            // queue-based frame dropping (no lock needed - singleton)
-            using namespace BackpressureController;
-            auto &backpressure =
-                BackpressureController::BackpressureController::getInstance();
-            backpressure.updateQueueSize(
-                instanceId,
-                static_cast<size_t>(queue_size)); // Thread-safe, no lock needed
-
-            // Record queue full event if queue is getting full (threshold:
-            // 80% of typical max) Increased from 8 to 16 to match increased
-            // queue size (20) for multi-instance performance
-            const size_t queue_warning_threshold =
-                16; // Warn at 16 frames (80% of 20)
-            if (queue_size >= static_cast<int>(queue_warning_threshold)) {
-              backpressure.recordQueueFull(
-                  instanceId); // Thread-safe, no lock needed
-            }
+            // Queue-based frame dropping and queue full events are driven by
+            // the telemetry recorded above (BackpressureController reads it
+            // directly; the full transition was already reported)
 
             // FIX: Track SDK-level drops when queue is full
             // When queue is at max capacity, frames are being dropped at SDK
@@ -6313,6 +6366,9 @@ void InstanceRegistry::setupQueueSizeTrackingHook(
                 // Estimate 1 drop per check when queue is full (conservative
                 // estimate)
                 tracker.dropped_frames.fetch_add(1, std::memory_order_relaxed);
+                if (series) {
+                  series->recordDrops();
+                }
                 last_drop_time[instanceId] = now;
               }
             }
@@ -6341,6 +6397,15 @@ void InstanceRegistry::setupQueueSizeTrackingHook(
 
 std::string InstanceRegistry::encodeFrameToBase64(const cv::Mat &frame,
                                                   int jpegQuality) const {
+  std::string jpeg = encodeFrameToJpeg(frame, jpegQuality);
+  if (jpeg.empty()) {
+    return "";
+  }
+  return Base64::encode(jpeg.data(), jpeg.size());
+}
+
+std::string InstanceRegistry::encodeFrameToJpeg(const cv::Mat &frame,
+                                                int jpegQuality) const {
   if (frame.empty()) {
     return "";
   }
@@ -6355,17 +6420,13 @@ std::string InstanceRegistry::encodeFrameToBase64(const cv::Mat &frame,
       return "";
     }
 
-    if (buffer.empty()) {
-      return "";
-    }
-
-    return base64_encode(buffer.data(), buffer.size());
+    return std::string(buffer.begin(), buffer.end());
   } catch (const std::exception &e) {
-    std::cerr << "[InstanceRegistry] Exception encoding frame to base64: "
+    std::cerr << "[InstanceRegistry] Exception encoding frame to JPEG: "
               << e.what() << std::endl;
     return "";
   } catch (...) {
-    std::cerr << "[InstanceRegistry] Unknown exception encoding frame to base64"
+    std::cerr << "[InstanceRegistry] Unknown exception encoding frame to JPEG"
               << std::endl;
     return "";
   }
@@ -6555,6 +6616,8 @@ void InstanceRegistry::startRTSPMonitorThread(const std::string &instanceId) {
             // Pass stop flag to reconnectRTSPStream so it can abort early if
             // instance is being stopped
             bool reconnect_success = reconnectRTSPStream(instanceId, stop_flag);
+            PipelineMetricsRegistry::getInstance().recordReconnect(
+                instanceId, reconnect_success);
 
             last_reconnect_attempt = now;
 
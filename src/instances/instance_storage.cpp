@@ -702,6 +702,11 @@ InstanceStorage::instanceInfoToConfigJson(const InstanceInfo &info,
       info.performanceMode.empty() ? "Balanced" : info.performanceMode;
   config["PerformanceMode"] = performanceMode;
 
+  // Store worker resource limits (only when set)
+  if (!info.resourceLimits.empty()) {
+    config["ResourceLimits"] = info.resourceLimits.toJson();
+  }
+
   // Store Tripwire (always include, empty by default)
   Json::Value tripwire(Json::objectValue);
   tripwire["Tripwires"] = Json::Value(Json::objectValue);
@@ -992,6 +997,11 @@ InstanceStorage::configJsonToInstanceInfo(const Json::Value &config,
       }
     }
 
+    // Extract worker resource limits
+    if (config.isMember("ResourceLimits")) {
+      info.resourceLimits = ResourceLimits::fromJson(config["ResourceLimits"]);
+    }
+
     // Extract Movement settings
     if (config.isMember("Movement") && config["Movement"].isObject()) {
       const Json::Value &movement = config["Movement"];
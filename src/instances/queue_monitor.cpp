@@ -1,10 +1,10 @@
 #include "instances/queue_monitor.h"
+#include "core/adaptive_queue_size_manager.h"
+#include "core/backpressure_controller.h"
+#include "core/queue_telemetry.h"
 #include <algorithm>
 #include <chrono>
-#include <fstream>
 #include <iostream>
-#include <regex>
-#include <sstream>
 
 QueueMonitor::QueueMonitor() {
   // Default configuration - aggressive thresholds to prevent deadlock
@@ -62,6 +62,21 @@ void QueueMonitor::recordQueueFullWarning(const std::string &instanceId,
 }
 
 bool QueueMonitor::shouldClearQueue(const std::string &instanceId) {
+  // Sustained saturation seen directly in queue depth telemetry: a node queue
+  // is full now and was at/above high watermark for most of the window
+  auto series = QueueTelemetry::getInstance().find(instanceId);
+  if (series && series->isOverloaded()) {
+    auto summary = series->summarize(monitoring_window_ * 1000);
+    if (summary.samples > 0 && summary.full_ratio >= SATURATION_RATIO) {
+      std::cerr << "[QueueMonitor] Queue clearing recommended for instance "
+                << instanceId << " (queue depth " << summary.current_depth
+                << " >= " << series->highWatermark() << " for "
+                << monitoring_window_ << "s, drops: " << summary.drops << ")"
+                << std::endl;
+      return true;
+    }
+  }
+
   std::lock_guard<std::mutex> lock(stats_mutex_);
 
   auto it = instance_stats_.find(instanceId);
@@ -144,16 +159,15 @@ void QueueMonitor::setMonitoringWindow(int window) {
 
 void QueueMonitor::monitoringThread() {
   while (running_.load()) {
-    std::this_thread::sleep_for(std::chrono::seconds(monitoring_window_));
+    // Queue full warnings are pushed by the queue size hooks as they happen;
+    // this loop only re-tunes queue sizes and ages out old warnings
+    std::this_thread::sleep_for(std::chrono::milliseconds(TELEMETRY_POLL_MS));
 
     if (!running_.load()) {
       break;
     }
 
-    // Parse log file if enabled
-    if (log_parsing_enabled_.load()) {
-      parseLogFile();
-    }
+    applyAdaptiveQueueSizes();
 
     // Check all instances for queue issues
     std::lock_guard<std::mutex> lock(stats_mutex_);
@@ -206,94 +220,16 @@ void QueueMonitor::monitoringThread() {
   }
 }
 
-std::string QueueMonitor::parseLogLine(const std::string &logLine) {
-  // Pattern: [Warn] [node_name] queue full, dropping meta!
-  // Node name format: node_type_instanceId (e.g.,
-  // yolo_detector_90d86cfb-46fa-4214-8a3c-e7c737ccf369) Extract node name from
-  // log line
-  std::regex pattern(R"(\[Warn\].*?\[([^\]]+)\].*?queue full.*?dropping meta)");
-  std::smatch match;
-
-  if (std::regex_search(logLine, match, pattern)) {
-    if (match.size() > 1) {
-      std::string nodeName = match[1].str();
-
-      // Extract instance ID from node name
-      // Node name format: node_type_instanceId
-      // Try to find UUID pattern (8-4-4-4-12 hex digits)
-      std::regex uuidPattern(
-          R"([a-f0-9]{8}-[a-f0-9]{4}-[a-f0-9]{4}-[a-f0-9]{4}-[a-f0-9]{12})");
-      std::smatch uuidMatch;
-
-      if (std::regex_search(nodeName, uuidMatch, uuidPattern)) {
-        return uuidMatch[0].str();
-      }
-
-      // Fallback: Try to find instance ID from node_to_instance_map
-      std::lock_guard<std::mutex> lock(node_map_mutex_);
-      auto it = node_to_instance_map_.find(nodeName);
-      if (it != node_to_instance_map_.end()) {
-        return it->second;
-      }
-    }
-  }
-
-  return "";
-}
-
-void QueueMonitor::enableLogParsing(const std::string &logFilePath) {
-  log_file_path_ = logFilePath;
-  log_parsing_enabled_.store(true);
-  std::cerr << "[QueueMonitor] Log parsing enabled for: " << logFilePath
-            << std::endl;
-}
-
-void QueueMonitor::parseLogFile() {
-  if (log_file_path_.empty()) {
-    return;
-  }
-
-  std::lock_guard<std::mutex> lock(log_file_mutex_);
+void QueueMonitor::applyAdaptiveQueueSizes() {
+  using namespace AdaptiveQueueSize;
+  auto &adaptiveQueue = AdaptiveQueueSizeManager::getInstance();
+  auto &backpressure =
+      BackpressureController::BackpressureController::getInstance();
 
-  static std::ifstream log_file(log_file_path_);
-  static std::streampos last_position = 0;
-
-  if (!log_file.is_open()) {
-    log_file.open(log_file_path_);
-    if (!log_file.is_open()) {
-      return;
+  for (const auto &instanceId : QueueTelemetry::getInstance().listInstances()) {
+    size_t recommended = adaptiveQueue.refreshFromTelemetry(instanceId);
+    if (recommended != backpressure.getMaxQueueSize(instanceId)) {
+      backpressure.updateQueueSizeConfig(instanceId, recommended);
     }
-    // Seek to end to read only new lines
-    log_file.seekg(0, std::ios::end);
-    last_position = log_file.tellg();
-    return;
   }
-
-  // Read only new lines since last check
-  log_file.seekg(last_position);
-  std::string line;
-  while (std::getline(log_file, line)) {
-    std::string instanceId = parseLogLine(line);
-    if (!instanceId.empty()) {
-      // Extract node name from line
-      std::regex nodePattern(R"(\[([^\]]+)\])");
-      std::smatch nodeMatch;
-      if (std::regex_search(line, nodeMatch, nodePattern) &&
-          nodeMatch.size() > 1) {
-        std::string nodeName = nodeMatch[1].str();
-        recordQueueFullWarning(instanceId, nodeName);
-      }
-    }
-  }
-
-  // Update position for next read
-  last_position = log_file.tellg();
-}
-
-void QueueMonitor::updateNodeToInstanceMap() {
-  // This will be called periodically to update node-to-instance mapping
-  // For now, we extract instance ID from node name pattern:
-  // node_type_instanceId Example:
-  // yolo_detector_90d86cfb-46fa-4214-8a3c-e7c737ccf369 This is a simple
-  // approach - can be improved with actual instance registry integration
 }
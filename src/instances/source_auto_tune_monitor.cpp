@@ -0,0 +1,360 @@
+#include "instances/source_auto_tune_monitor.h"
+#include "config/system_config.h"
+#include "core/operation_executor.h"
+#include "instances/instance_manager.h"
+#include "solutions/solution_registry.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+const char *const kOptionKeys[] = {"AUTO_TUNE_TARGET_FPS",
+                                   "AUTO_TUNE_MIN_OBJECT_PX",
+                                   "AUTO_TUNE_DETECTOR_MIN_PX",
+                                   "AUTO_TUNE_MAX_WIDTH", "RESIZE_RATIO",
+                                   "SKIP_INTERVAL"};
+
+std::string paramOr(const std::map<std::string, std::string> &params,
+                    const std::string &key) {
+  auto it = params.find(key);
+  return it != params.end() ? it->second : "";
+}
+
+bool isTrue(std::string value) {
+  std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+  return value == "true" || value == "1" || value == "yes" || value == "on";
+}
+
+// Invalid or unset values read as "not set"
+double parseRatio(const std::string &value) {
+  try {
+    double ratio = std::stod(value);
+    return ratio > 0.0 && ratio <= 1.0 ? ratio : 0.0;
+  } catch (const std::exception &) {
+    return 0.0;
+  }
+}
+
+int parseSkip(const std::string &value) {
+  try {
+    int skip = std::stoi(value);
+    return skip >= 0 ? skip : -1;
+  } catch (const std::exception &) {
+    return -1;
+  }
+}
+
+// "1920x1080" -> width/height, 0 when malformed
+void parseResolution(const std::string &resolution, int &width, int &height) {
+  width = 0;
+  height = 0;
+  if (std::sscanf(resolution.c_str(), "%dx%d", &width, &height) != 2) {
+    width = 0;
+    height = 0;
+  }
+}
+
+std::string formatRatio(double ratio) {
+  char buffer[16];
+  std::snprintf(buffer, sizeof(buffer), "%.2f", ratio);
+  return buffer;
+}
+
+} // namespace
+
+SourceAutoTuneMonitor::Config SourceAutoTuneMonitor::loadConfig() {
+  Config config;
+
+  try {
+    Json::Value section =
+        SystemConfig::getInstance().getConfigSection("system.auto_tune");
+    if (section.isObject()) {
+      config.enabled = section.get("enabled", config.enabled).asBool();
+      config.interval = std::chrono::seconds(std::max<Json::Int64>(
+          1, section
+                 .get("interval_seconds",
+                      static_cast<Json::Int64>(config.interval.count()))
+                 .asInt64()));
+      config.stable_samples = std::max(
+          1, section.get("stable_samples", config.stable_samples).asInt());
+      config.cooldown = std::chrono::seconds(std::max<Json::Int64>(
+          0, section
+                 .get("cooldown_seconds",
+                      static_cast<Json::Int64>(config.cooldown.count()))
+                 .asInt64()));
+      config.min_cpu_headroom =
+          section.get("min_cpu_headroom", config.min_cpu_headroom).asDouble();
+      config.spare_cpu_headroom =
+          section.get("spare_cpu_headroom", config.spare_cpu_headroom)
+              .asDouble();
+      config.queue_high = std::max<size_t>(
+          1, section
+                 .get("queue_high",
+                      static_cast<Json::UInt64>(config.queue_high))
+                 .asUInt64());
+      config.default_target_fps =
+          std::max(0.0, section.get("default_target_fps",
+                                    config.default_target_fps)
+                            .asDouble());
+    }
+  } catch (const std::exception &e) {
+    std::cerr << "[SourceAutoTune] Invalid auto_tune config, using defaults: "
+              << e.what() << std::endl;
+  }
+  return config;
+}
+
+bool SourceAutoTuneMonitor::isEnabledFor(const InstanceInfo &info) {
+  return isTrue(paramOr(info.additionalParams, "AUTO_TUNE"));
+}
+
+SourceAutoTuner::Options SourceAutoTuneMonitor::optionsFor(
+    const Config &config, const std::map<std::string, std::string> &params) {
+  SourceAutoTuner::Options defaults;
+  defaults.target_fps = config.default_target_fps;
+  defaults.stable_samples = config.stable_samples;
+  defaults.cooldown = config.cooldown;
+  defaults.min_cpu_headroom = config.min_cpu_headroom;
+  defaults.spare_cpu_headroom = config.spare_cpu_headroom;
+  defaults.queue_high = config.queue_high;
+  return SourceAutoTuner::parseOptions(params, defaults);
+}
+
+SourceAutoTuner::Setting SourceAutoTuneMonitor::pinnedSetting(
+    const std::map<std::string, std::string> &params) {
+  SourceAutoTuner::Setting setting;
+  setting.resize_ratio = parseRatio(paramOr(params, "RESIZE_RATIO"));
+  setting.skip_interval = parseSkip(paramOr(params, "SKIP_INTERVAL"));
+  return setting;
+}
+
+SourceAutoTuner::Setting SourceAutoTuneMonitor::tunedSetting(
+    const std::map<std::string, std::string> &params) {
+  SourceAutoTuner::Setting setting;
+  setting.resize_ratio = parseRatio(paramOr(params, "AUTO_RESIZE_RATIO"));
+  setting.skip_interval = parseSkip(paramOr(params, "AUTO_SKIP_INTERVAL"));
+  return setting;
+}
+
+SourceAutoTuner::Setting
+SourceAutoTuneMonitor::runningSetting(const InstanceInfo &info) {
+  // Defaults of PipelineBuilder::createRTSPSourceNode
+  SourceAutoTuner::Setting setting{0.6, 0};
+  auto solution = SolutionRegistry::getInstance().getSolution(info.solutionId);
+  if (!solution.has_value()) {
+    return setting;
+  }
+  for (const auto &node : solution->pipeline) {
+    if (node.nodeType != "rtsp_src") {
+      continue;
+    }
+    const auto &params = node.parameters;
+    auto ratio = params.find("resize_ratio");
+    if (ratio == params.end()) {
+      ratio = params.find("scale");
+    }
+    if (ratio != params.end()) {
+      setting.resize_ratio = parseRatio(ratio->second);
+    }
+    auto skip = params.find("skip_interval");
+    if (skip != params.end()) {
+      setting.skip_interval = parseSkip(skip->second);
+    }
+    break;
+  }
+  return setting;
+}
+
+SourceAutoTuneMonitor::~SourceAutoTuneMonitor() { stop(); }
+
+void SourceAutoTuneMonitor::start(IInstanceManager *manager,
+                                  const Config &config) {
+  if (!config.enabled || !manager || running_.exchange(true)) {
+    return;
+  }
+  manager_ = manager;
+  config_ = config;
+  thread_ = std::thread(&SourceAutoTuneMonitor::run, this);
+}
+
+void SourceAutoTuneMonitor::stop() {
+  if (!running_.exchange(false)) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+  }
+  wake_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void SourceAutoTuneMonitor::run() {
+  sampleCpuHeadroom(); // Baseline for the first delta
+  while (running_.load()) {
+    {
+      std::unique_lock<std::mutex> lock(wake_mutex_);
+      wake_.wait_for(lock, config_.interval, [this] { return !running_; });
+    }
+    if (!running_.load()) {
+      break;
+    }
+    try {
+      tick();
+    } catch (const std::exception &e) {
+      std::cerr << "[SourceAutoTune] Error: " << e.what() << std::endl;
+    }
+  }
+}
+
+void SourceAutoTuneMonitor::tick() {
+  double cpuHeadroom = sampleCpuHeadroom();
+  auto &executor = OperationExecutor::getInstance();
+  std::map<std::string, Tracked> seen;
+
+  for (const auto &info : manager_->getAllInstances()) {
+    if (!info.running || !isEnabledFor(info)) {
+      continue;
+    }
+    const std::string &instanceId = info.instanceId;
+    Tracked tracked;
+    auto previous = tracked_.find(instanceId);
+    if (previous != tracked_.end()) {
+      tracked = std::move(previous->second);
+    }
+
+    // Wait for a pending update; after a failure start over from the
+    // persisted setting
+    if (!tracked.operation_id.empty()) {
+      auto state = executor.getState(tracked.operation_id);
+      if (state.has_value() && !OperationExecutor::isFinished(*state)) {
+        seen[instanceId] = std::move(tracked);
+        continue;
+      }
+      if (!state.has_value() ||
+          *state != OperationExecutor::State::Succeeded) {
+        tracked.tuner.reset();
+      }
+      tracked.operation_id.clear();
+    }
+
+    std::string paramsKey;
+    for (const char *key : kOptionKeys) {
+      paramsKey += paramOr(info.additionalParams, key) + "|";
+    }
+    if (!tracked.tuner || tracked.params_key != paramsKey) {
+      try {
+        tracked.tuner = std::make_unique<SourceAutoTuner>(
+            optionsFor(config_, info.additionalParams),
+            tunedSetting(info.additionalParams),
+            pinnedSetting(info.additionalParams), runningSetting(info));
+        tracked.params_key = paramsKey;
+      } catch (const std::invalid_argument &e) {
+        std::cerr << "[SourceAutoTune] Instance " << instanceId
+                  << ": auto-tune disabled: " << e.what() << std::endl;
+        continue;
+      }
+    }
+
+    auto stats = manager_->getInstanceStatistics(instanceId);
+    if (!stats.has_value()) {
+      seen[instanceId] = std::move(tracked);
+      continue;
+    }
+    SourceAutoTuner::Sample sample;
+    parseResolution(stats->source_resolution.empty() ? stats->resolution
+                                                     : stats->source_resolution,
+                    sample.source_width, sample.source_height);
+    sample.source_fps = stats->source_framerate;
+    sample.processed_fps = stats->current_framerate;
+    sample.latency_ms = stats->latency;
+    sample.queue_size = stats->input_queue_size;
+    sample.cpu_headroom = cpuHeadroom;
+
+    auto decision = tracked.tuner->update(sample);
+    if (decision.changed) {
+      std::cerr << "[SourceAutoTune] Instance " << instanceId << ": "
+                << decision.reason << " -> resize_ratio="
+                << formatRatio(decision.setting.resize_ratio)
+                << ", skip_interval=" << decision.setting.skip_interval
+                << " (processed " << sample.processed_fps << "/"
+                << sample.source_fps << " fps, queue " << sample.queue_size
+                << ", cpu idle " << cpuHeadroom << ")" << std::endl;
+      tracked.operation_id = apply(info, decision.setting);
+      if (tracked.operation_id.empty()) {
+        // Executor full: retry from the persisted setting next time
+        tracked.tuner.reset();
+      }
+    }
+    seen[instanceId] = std::move(tracked);
+  }
+
+  // Instances that stopped, were deleted or opted out start fresh next time
+  tracked_ = std::move(seen);
+}
+
+std::string
+SourceAutoTuneMonitor::apply(const InstanceInfo &info,
+                             const SourceAutoTuner::Setting &setting) {
+  Json::Value update;
+  if (manager_->isSubprocessMode()) {
+    // The worker replaces AdditionalParams as a whole
+    Json::Value params(Json::objectValue);
+    for (const auto &[key, value] : info.additionalParams) {
+      params[key] = value;
+    }
+    params["AUTO_RESIZE_RATIO"] = formatRatio(setting.resize_ratio);
+    params["AUTO_SKIP_INTERVAL"] = std::to_string(setting.skip_interval);
+    update["AdditionalParams"] = params;
+  } else {
+    update["additionalParams"]["AUTO_RESIZE_RATIO"] =
+        formatRatio(setting.resize_ratio);
+    update["additionalParams"]["AUTO_SKIP_INTERVAL"] =
+        std::to_string(setting.skip_interval);
+  }
+
+  IInstanceManager *manager = manager_;
+  std::string instanceId = info.instanceId;
+  return OperationExecutor::getInstance().submit(
+      "auto_tune", instanceId,
+      [manager, instanceId, update](OperationExecutor::Progress &progress,
+                                    std::string &error) {
+        progress.report(0.1, "applying source settings");
+        if (!manager->updateInstance(instanceId, update)) {
+          error = "Could not update instance";
+          return false;
+        }
+        return true;
+      });
+}
+
+double SourceAutoTuneMonitor::sampleCpuHeadroom() {
+  std::ifstream stat("/proc/stat");
+  std::string line;
+  if (!stat || !std::getline(stat, line) || line.compare(0, 4, "cpu ") != 0) {
+    return -1.0;
+  }
+  std::istringstream fields(line.substr(4));
+  uint64_t value = 0, total = 0, idle = 0;
+  // user nice system idle iowait irq softirq steal
+  for (int i = 0; i < 8 && fields >> value; ++i) {
+    total += value;
+    if (i == 3 || i == 4) {
+      idle += value;
+    }
+  }
+
+  uint64_t dTotal = total - last_cpu_total_;
+  uint64_t dIdle = idle - last_cpu_idle_;
+  bool first = last_cpu_total_ == 0;
+  last_cpu_total_ = total;
+  last_cpu_idle_ = idle;
+  if (first || dTotal == 0) {
+    return -1.0;
+  }
+  return static_cast<double>(dIdle) / dTotal;
+}
@@ -1,6 +1,9 @@
 #include "instances/subprocess_instance_manager.h"
+#include "core/preview_stream_hub.h"
 #include "core/timeout_constants.h"
 #include "core/uuid_generator.h"
+#include "worker/cpu_placement.h"
+#include "worker/worker_cgroup_manager.h"
 #include "models/solution_config.h"
 #include <chrono>
 #include <future>
@@ -26,6 +29,11 @@ SubprocessInstanceManager::SubprocessInstanceManager(
         onWorkerError(id, error);
       });
 
+  supervisor_->setRestartCallback(
+      [this](const std::string &id, bool restarted, bool pipelineResumed) {
+        onWorkerRestarted(id, restarted, pipelineResumed);
+      });
+
   // Start supervisor monitoring
   supervisor_->start();
 
@@ -88,6 +96,7 @@ SubprocessInstanceManager::createInstance(const CreateInstanceRequest &req) {
   info.licensePlateConfidenceThreshold = req.licensePlateConfidenceThreshold;
   info.confThreshold = req.confThreshold;
   info.performanceMode = req.performanceMode;
+  info.resourceLimits = req.resourceLimits;
   info.recommendedFrameRate = req.recommendedFrameRate;
   info.fps = 0.0;
   info.startTime = std::chrono::steady_clock::now();
@@ -257,6 +266,9 @@ bool SubprocessInstanceManager::deleteInstance(const std::string &instanceId) {
   // Remove from storage
   instance_storage_.deleteInstance(instanceId);
 
+  // Close preview streams of the deleted instance
+  PreviewStreamHub::getInstance().removeInstance(instanceId);
+
   std::cout << "[SubprocessInstanceManager] Deleted instance: " << instanceId
             << std::endl;
   return true;
@@ -824,9 +836,60 @@ int SubprocessInstanceManager::getInstanceCount() const {
   return static_cast<int>(instances_.size());
 }
 
+namespace {
+
+// Statistics fields as sent by the worker (GET_STATISTICS data or pushed
+// STATISTICS_UPDATE snapshot)
+InstanceStatistics statisticsFromWorkerData(const Json::Value &data) {
+  InstanceStatistics stats;
+  stats.frames_processed = data.get("frames_processed", 0).asUInt64();
+  stats.start_time = data.get("start_time", 0).asInt64();
+  stats.current_framerate = data.get("current_framerate", 0.0).asDouble();
+  stats.source_framerate = data.get("source_framerate", 0.0).asDouble();
+  stats.latency = data.get("latency", 0.0).asDouble();
+  stats.input_queue_size = data.get("input_queue_size", 0).asUInt64();
+  stats.dropped_frames_count = data.get("dropped_frames_count", 0).asUInt64();
+  stats.resolution = data.get("resolution", "").asString();
+  stats.source_resolution = data.get("source_resolution", "").asString();
+  stats.format = data.get("format", "").asString();
+  return stats;
+}
+
+} // namespace
+
 std::optional<InstanceStatistics>
 SubprocessInstanceManager::getInstanceStatistics(
     const std::string &instanceId) {
+  auto stats = fetchWorkerStatistics(instanceId);
+  if (stats.has_value()) {
+    auto usage = worker::WorkerCgroupManager::getInstance().readUsage(instanceId);
+    if (usage.has_value()) {
+      stats->resource_usage = usage->toJson();
+    }
+    auto placement =
+        worker::CpuPlacement::getInstance().getAssignment(instanceId);
+    if (placement.has_value() && !placement->cpus.empty()) {
+      stats->placement["cpus"] =
+          worker::CpuPlacement::formatCpuList(placement->cpus);
+      stats->placement["numa_node"] = placement->node;
+      stats->placement["fps_per_cpu"] =
+          stats->current_framerate / placement->cpus.size();
+    }
+  }
+  return stats;
+}
+
+std::optional<InstanceStatistics>
+SubprocessInstanceManager::fetchWorkerStatistics(
+    const std::string &instanceId) {
+  // Fast path: latest snapshot pushed by the worker, no IPC round trip
+  auto pushed = supervisor_->getLatestStatistics(
+      instanceId,
+      std::chrono::milliseconds(TimeoutConstants::getWorkerStatsMaxAgeMs()));
+  if (pushed.has_value()) {
+    return statisticsFromWorkerData(pushed.value());
+  }
+
   // Flush output immediately to ensure logs appear
   std::cout.flush();
   std::cerr.flush();
@@ -938,6 +1001,9 @@ SubprocessInstanceManager::getInstanceStatistics(
         config["RtspUrl"] = info.rtspUrl;
         config["RtmpUrl"] = info.rtmpUrl;
         config["FilePath"] = info.filePath;
+        if (!info.resourceLimits.empty()) {
+          config["ResourceLimits"] = info.resourceLimits.toJson();
+        }
 
         if (!info.additionalParams.empty()) {
           Json::Value params;
@@ -1225,18 +1291,8 @@ SubprocessInstanceManager::getInstanceStatistics(
     std::cout
         << "[SubprocessInstanceManager] Parsing statistics from 'data' field"
         << std::endl;
-    InstanceStatistics stats;
-    const auto &data = response.payload["data"];
-    stats.frames_processed = data.get("frames_processed", 0).asUInt64();
-    stats.start_time = data.get("start_time", 0).asInt64();
-    stats.current_framerate = data.get("current_framerate", 0.0).asDouble();
-    stats.source_framerate = data.get("source_framerate", 0.0).asDouble();
-    stats.latency = data.get("latency", 0.0).asDouble();
-    stats.input_queue_size = data.get("input_queue_size", 0).asUInt64();
-    stats.dropped_frames_count = data.get("dropped_frames_count", 0).asUInt64();
-    stats.resolution = data.get("resolution", "").asString();
-    stats.source_resolution = data.get("source_resolution", "").asString();
-    stats.format = data.get("format", "").asString();
+    InstanceStatistics stats =
+        statisticsFromWorkerData(response.payload["data"]);
     std::cout << "[SubprocessInstanceManager] Successfully parsed statistics "
                  "for instance "
               << instanceId << std::endl;
@@ -1335,6 +1391,26 @@ SubprocessInstanceManager::getLastFrame(const std::string &instanceId) const {
   return "";
 }
 
+Json::Value
+SubprocessInstanceManager::getQueueTelemetry(const std::string &instanceId,
+                                             size_t maxSamples) const {
+  // Telemetry lives in the worker process (recorded by its pipeline hooks)
+  worker::IPCMessage msg;
+  msg.type = worker::MessageType::GET_QUEUE_TELEMETRY;
+  msg.payload["instance_id"] = instanceId;
+  msg.payload["max_samples"] = static_cast<Json::UInt64>(maxSamples);
+
+  auto response = const_cast<worker::WorkerSupervisor *>(supervisor_.get())
+                      ->sendToWorker(instanceId, msg,
+                                     TimeoutConstants::getIpcStatusTimeoutMs());
+
+  if (response.type == worker::MessageType::GET_QUEUE_TELEMETRY_RESPONSE &&
+      response.payload.get("success", false).asBool()) {
+    return response.payload["data"];
+  }
+  return Json::Value();
+}
+
 Json::Value SubprocessInstanceManager::getInstanceConfig(
     const std::string &instanceId) const {
   std::lock_guard<std::mutex> lock(instances_mutex_);
@@ -1406,6 +1482,9 @@ void SubprocessInstanceManager::loadPersistentInstances() {
     config["RtmpUrl"] = info.rtmpUrl;
     config["FilePath"] = info.filePath;
     config["Persistent"] = info.persistent;
+    if (!info.resourceLimits.empty()) {
+      config["ResourceLimits"] = info.resourceLimits.toJson();
+    }
 
     // Spawn worker
     if (supervisor_->spawnWorker(instanceId, config)) {
@@ -1486,6 +1565,9 @@ Json::Value SubprocessInstanceManager::buildWorkerConfig(
   config["Group"] = req.group;
   config["AutoStart"] = req.autoStart;
   config["Persistent"] = req.persistent;
+  if (!req.resourceLimits.empty()) {
+    config["ResourceLimits"] = req.resourceLimits.toJson();
+  }
 
   // Add additional parameters (includes source URLs)
   // CRITICAL: Serialize as flat structure (not nested) to ensure worker can parse correctly
@@ -1559,6 +1641,9 @@ Json::Value SubprocessInstanceManager::buildWorkerConfigFromInstanceInfo(
   config["Group"] = info.group;
   config["AutoStart"] = info.autoStart;
   config["Persistent"] = info.persistent;
+  if (!info.resourceLimits.empty()) {
+    config["ResourceLimits"] = info.resourceLimits.toJson();
+  }
 
   // Add URLs and file paths
   if (!info.rtspUrl.empty()) {
@@ -1651,3 +1736,32 @@ void SubprocessInstanceManager::onWorkerError(const std::string &instanceId,
     it->second.retryCount++;
   }
 }
+
+void SubprocessInstanceManager::onWorkerRestarted(const std::string &instanceId,
+                                                  bool restarted,
+                                                  bool pipelineResumed) {
+  if (!restarted) {
+    std::cerr << "[SubprocessInstanceManager] Worker " << instanceId
+              << " not restarted anymore, restart limit reached" << std::endl;
+    std::lock_guard<std::mutex> lock(instances_mutex_);
+    auto it = instances_.find(instanceId);
+    if (it != instances_.end()) {
+      it->second.running = false;
+      it->second.loaded = false;
+      it->second.retryLimitReached = true;
+    }
+    return;
+  }
+
+  std::cout << "[SubprocessInstanceManager] Worker " << instanceId
+            << " restarted after crash"
+            << (pipelineResumed ? ", pipeline resumed" : "") << std::endl;
+
+  std::lock_guard<std::mutex> lock(instances_mutex_);
+  auto it = instances_.find(instanceId);
+  if (it != instances_.end()) {
+    it->second.loaded = true;
+    it->second.running = pipelineResumed;
+    it->second.retryLimitReached = false;
+  }
+}
@@ -5,11 +5,14 @@
 #include "api/swagger_handler.h"
 #include "api/version_handler.h"
 #include "api/watchdog_handler.h"
+#include "api/operations_handler.h"
 #include <drogon/drogon.h>
 #ifdef ENABLE_SYSTEM_INFO_HANDLER
 #include "api/system_info_handler.h"
 #endif
 #include "api/ai_websocket.h"
+#include "api/instance_subscription_hub.h"
+#include "api/preview_websocket.h"
 #include "api/config_handler.h"
 #include "api/endpoints_handler.h"
 #include "api/group_handler.h"
@@ -24,6 +27,7 @@
 #include "api/metrics_handler.h"
 #endif
 #include "config/system_config.h"
+#include "core/async_log.h"
 #include "core/categorized_logger.h"
 #include "core/cors_filter.h"
 #include "core/env_config.h"
@@ -31,10 +35,14 @@
 #include "core/logger.h"
 #include "core/logging_flags.h"
 #include "core/metrics_interceptor.h"
+#include "core/model_catalog.h"
 #include "core/node_pool_manager.h"
 #include "core/node_storage.h"
+#include "core/operation_executor.h"
 #include "core/pipeline_builder.h"
+#include "core/preview_stream_hub.h"
 #include "core/request_middleware.h"
+#include "core/startup_profiler.h"
 #include "core/timeout_constants.h"
 #include "core/watchdog.h"
 #include "fonts/font_upload_handler.h"
@@ -45,10 +53,15 @@
 #include "instances/instance_registry.h"
 #include "instances/instance_storage.h"
 #include "instances/queue_monitor.h"
+#include "instances/source_auto_tune_monitor.h"
 #include "models/model_upload_handler.h"
 #include "solutions/solution_registry.h"
 #include "solutions/solution_storage.h"
 #include "utils/gstreamer_checker.h"
+#include "utils/mp4_finalize_queue.h"
+#include "videos/offline_job_manager.h"
+#include "videos/offline_segment_pipeline.h"
+#include "videos/video_job_handler.h"
 #include "videos/video_upload_handler.h"
 #include <algorithm>
 #include <arpa/inet.h>
@@ -179,6 +192,7 @@ void segfaultHandler(int /*signal*/) // Parameter name commented to avoid
         << std::endl;
     std::cerr << "[CRITICAL] ========================================"
               << std::endl;
+    AsyncLogBackend::getInstance().flush();
     std::fflush(stdout);
     std::fflush(stderr);
 
@@ -280,6 +294,7 @@ void segfaultHandler(int /*signal*/) // Parameter name commented to avoid
   // monitoring thread will detect the crash and attempt to reconnect
 
   // Flush all output
+  AsyncLogBackend::getInstance().flush();
   std::fflush(stdout);
   std::fflush(stderr);
 
@@ -350,6 +365,7 @@ void signalHandler(int signal) {
           std::cerr << "[CRITICAL] Force exit after 50ms - RTSP retry loops "
                        "blocking shutdown"
                     << std::endl;
+          AsyncLogBackend::getInstance().flush();
           std::fflush(stdout);
           std::fflush(stderr);
           force_exit_ref->store(true);
@@ -565,6 +581,7 @@ void signalHandler(int signal) {
         std::cerr << "[CRITICAL] RTSP retry loops prevented graceful shutdown "
                      "- forcing exit"
                   << std::endl;
+        AsyncLogBackend::getInstance().flush();
         std::fflush(stdout);
         std::fflush(stderr);
 
@@ -594,6 +611,7 @@ void signalHandler(int signal) {
                 << std::endl;
       std::cerr << "[CRITICAL] Total segfaults before exit: "
                 << g_segfault_count.load() << std::endl;
+      AsyncLogBackend::getInstance().flush();
       std::fflush(stdout);
       std::fflush(stderr);
 
@@ -619,6 +637,7 @@ void signalHandler(int signal) {
     if (g_force_exit.load()) {
       std::cerr << "[CRITICAL] Force exit confirmed - terminating immediately"
                 << std::endl;
+      AsyncLogBackend::getInstance().flush();
       std::fflush(stdout);
       std::fflush(stderr);
       // Use abort() for most aggressive termination
@@ -999,6 +1018,7 @@ void terminateHandler() {
     std::this_thread::sleep_for(std::chrono::milliseconds(1000));
 
     // CRITICAL: Must terminate according to C++ standard
+    AsyncLogBackend::getInstance().flush();
     std::fflush(stdout);
     std::fflush(stderr);
     std::_Exit(1); // Exit immediately without calling destructors (safer in
@@ -1123,6 +1143,7 @@ void terminateHandler() {
 
     // CRITICAL: Must terminate according to C++ standard
     // Cannot return from terminate handler
+    AsyncLogBackend::getInstance().flush();
     std::fflush(stdout);
     std::fflush(stderr);
     std::_Exit(1);
@@ -1890,6 +1911,17 @@ static void setupGStreamerPluginPath(bool enable_find_search = false) {
 
 int main(int argc, char *argv[]) {
   try {
+    // Startup timeline (GET /v1/core/health/startup); starts the clock
+    auto &startupProfiler = StartupProfiler::getInstance();
+    auto phaseStart = std::chrono::steady_clock::now();
+
+    // Queue std::cout/std::cerr and plog output for a background writer so
+    // logging stays off frame and request threads (EDGE_AI_ASYNC_LOG=0 to
+    // write synchronously)
+    if (AsyncLogBackend::getInstance().start()) {
+      AsyncLogBackend::getInstance().redirectStdStreams();
+    }
+
     // CRITICAL: Disable problematic GStreamer plugins FIRST, before anything
     // else VA plugin (libgstva.so) can crash on systems with broken GPU drivers
     // (nouveau, etc.) Must be done BEFORE GStreamer initializes (which happens
@@ -1968,9 +2000,13 @@ int main(int argc, char *argv[]) {
                 << std::endl;
     }
 
+    startupProfiler.record("gstreamer_env", phaseStart);
+
     // Initialize categorized logger first (before any logging)
     // This sets up log directories, daily rotation, and cleanup
+    phaseStart = std::chrono::steady_clock::now();
     CategorizedLogger::init();
+    startupProfiler.record("logger", phaseStart);
 
     PLOG_INFO << "========================================";
     PLOG_INFO << "Edge AI API Server";
@@ -1989,23 +2025,7 @@ int main(int argc, char *argv[]) {
     }
     PLOG_INFO << "Starting REST API server...";
 
-    // Check GStreamer plugins availability
-    std::cerr << "\n[Main] Checking GStreamer plugins..." << std::endl;
-    bool pluginsOk = GStreamerChecker::validatePlugins(true);
-    if (!pluginsOk) {
-      std::cerr
-          << "[Main] ⚠ WARNING: Some required GStreamer plugins are missing!"
-          << std::endl;
-      std::cerr << "[Main] The application will continue, but some features "
-                   "may not work."
-                << std::endl;
-      std::cerr << "[Main] Please install missing plugins before using "
-                   "RTSP/RTMP/File source nodes.\n"
-                << std::endl;
-    } else {
-      std::cerr << "[Main] ✓ All required GStreamer plugins are available\n"
-                << std::endl;
-    }
+    phaseStart = std::chrono::steady_clock::now();
 
     // Register signal handlers for graceful shutdown and crash prevention
     // CRITICAL: Register BEFORE Drogon initializes to ensure our handler is
@@ -2019,6 +2039,31 @@ int main(int argc, char *argv[]) {
     // Register terminate handler for uncaught exceptions
     std::set_terminate(terminateHandler);
 
+    // Check GStreamer plugins availability in the background: nothing
+    // during startup depends on the result and the check spawns one
+    // gst-inspect process per plugin. Started after the signal handlers are
+    // installed because system() saves and restores SIGINT/SIGQUIT.
+    std::thread([]() {
+      StartupProfiler::setThreadLabel("background");
+      StartupProfiler::Scope phase("gstreamer_plugins", true);
+      std::cerr << "\n[Main] Checking GStreamer plugins..." << std::endl;
+      bool pluginsOk = GStreamerChecker::validatePlugins(true);
+      if (!pluginsOk) {
+        std::cerr
+            << "[Main] ⚠ WARNING: Some required GStreamer plugins are missing!"
+            << std::endl;
+        std::cerr << "[Main] The application will continue, but some "
+                     "features may not work."
+                  << std::endl;
+        std::cerr << "[Main] Please install missing plugins before using "
+                     "RTSP/RTMP/File source nodes.\n"
+                  << std::endl;
+      } else {
+        std::cerr << "[Main] ✓ All required GStreamer plugins are available\n"
+                  << std::endl;
+      }
+    }).detach();
+
     // Load system configuration first (needed for web_server config)
     // Use intelligent path resolution with 3-tier fallback
     std::string configPath = EnvConfig::resolveConfigPath();
@@ -2032,6 +2077,8 @@ int main(int argc, char *argv[]) {
     std::string host = webServerConfig.ipAddress;
     uint16_t port = webServerConfig.port;
 
+    startupProfiler.record("system_config", phaseStart);
+
     PLOG_INFO << "Server will listen on: " << host << ":" << port;
     PLOG_INFO << "Available endpoints:";
     PLOG_INFO << "  GET /v1/core/health  - Health check";
@@ -2071,6 +2118,7 @@ int main(int argc, char *argv[]) {
     static HealthHandler healthHandler;
     static VersionHandler versionHandler;
     static WatchdogHandler watchdogHandler;
+    static OperationsHandler operationsHandler;
     static SwaggerHandler swaggerHandler;
     static EndpointsHandler endpointsHandler;
     static LogHandler logHandler;
@@ -2082,6 +2130,7 @@ int main(int argc, char *argv[]) {
 #endif
 
     // Initialize instance management components
+    phaseStart = std::chrono::steady_clock::now();
     static SolutionRegistry &solutionRegistry = SolutionRegistry::getInstance();
     static PipelineBuilder pipelineBuilder;
 
@@ -2283,15 +2332,13 @@ int main(int argc, char *argv[]) {
           << "[Main] In-process instance manager initialized (legacy mode)";
     }
 
-    // Initialize default solutions (face_detection, etc.)
-    solutionRegistry.initializeDefaultSolutions();
+    startupProfiler.record("instance_manager", phaseStart);
 
-    // Initialize node pool manager and default templates
+    // Initialize node pool manager (templates are loaded below)
+    phaseStart = std::chrono::steady_clock::now();
     static NodePoolManager &nodePool = NodePoolManager::getInstance();
-    nodePool.initializeDefaultTemplates();
-    PLOG_INFO << "[Main] Node pool manager initialized with default templates";
 
-    // Initialize node storage and load persisted nodes
+    // Initialize node storage (persisted nodes are loaded below)
     // Priority: 1. NODES_DIR env var, 2. /opt/edge_ai_api/nodes (with
     // auto-fallback)
     std::string nodesDir;
@@ -2417,60 +2464,6 @@ int main(int argc, char *argv[]) {
     PLOG_INFO << "[Main] Nodes directory: " << nodesDir;
     static NodeStorage nodeStorage(nodesDir);
 
-    // Step 1: Load persisted nodes from storage (if any)
-    size_t loadedFromStorage = nodePool.loadNodesFromStorage(nodeStorage);
-    PLOG_INFO << "[Main] Loaded " << loadedFromStorage << " nodes from storage";
-
-    // Step 2: Create default nodes from all available templates
-    // This ensures all supported node types have default nodes, not just those
-    // from solutions
-    size_t createdFromTemplates = nodePool.createDefaultNodesFromTemplates();
-    PLOG_INFO << "[Main] Created " << createdFromTemplates
-              << " default nodes from templates";
-
-    // Step 3: Also create nodes from default solutions (for nodes with specific
-    // configurations) This adds nodes with solution-specific parameters
-    size_t createdFromSolutions =
-        nodePool.createNodesFromDefaultSolutions(solutionRegistry);
-    PLOG_INFO << "[Main] Created " << createdFromSolutions
-              << " nodes from default solutions";
-
-    size_t totalCreated = createdFromTemplates + createdFromSolutions;
-
-    // Step 4: Load user-created nodes again (in case storage was updated)
-    // This ensures we have all nodes: defaults + user-created
-    size_t loadedUserNodes = nodePool.loadNodesFromStorage(nodeStorage);
-
-    // Step 5: Get total count for reporting
-    auto stats = nodePool.getStats();
-    std::cerr << "[Main] ========================================" << std::endl;
-    std::cerr << "[Main] Node Pool Status:" << std::endl;
-    std::cerr << "[Main]   Total nodes: " << stats.totalPreConfiguredNodes
-              << std::endl;
-    std::cerr << "[Main]   Available: " << stats.availableNodes << std::endl;
-    std::cerr << "[Main]   In use: " << stats.inUseNodes << std::endl;
-    std::cerr << "[Main]   Default nodes (from templates): "
-              << createdFromTemplates << std::endl;
-    std::cerr << "[Main]   Nodes from solutions: " << createdFromSolutions
-              << std::endl;
-    std::cerr << "[Main]   User-created nodes: " << loadedUserNodes
-              << std::endl;
-    std::cerr << "[Main] ========================================" << std::endl;
-    PLOG_INFO << "[Main] Node pool initialized: "
-              << stats.totalPreConfiguredNodes << " total nodes ("
-              << stats.availableNodes << " available, " << stats.inUseNodes
-              << " in use)";
-
-    // Step 6: Save nodes to storage only if we created new nodes
-    if (totalCreated > 0) {
-      if (nodePool.saveNodesToStorage(nodeStorage)) {
-        PLOG_INFO << "[Main] Saved nodes to storage (including " << totalCreated
-                  << " new nodes)";
-      } else {
-        PLOG_WARNING << "[Main] Failed to save nodes to storage";
-      }
-    }
-
     // Initialize solution storage and load custom solutions
     // Default: /opt/edge_ai_api/solutions (auto-created if needed, with
     // fallback)
@@ -2479,35 +2472,176 @@ int main(int argc, char *argv[]) {
     PLOG_INFO << "[Main] Solutions directory: " << solutionsDir;
     static SolutionStorage solutionStorage(solutionsDir);
 
-    // Load persisted custom solutions
-    auto customSolutions = solutionStorage.loadAllSolutions();
-    for (const auto &config : customSolutions) {
-      // Check if solution ID conflicts with default solution
-      if (solutionRegistry.isDefaultSolution(config.solutionId)) {
-        PLOG_WARNING << "[Main] Skipping custom solution '" << config.solutionId
-                     << "': ID conflicts with default system solution. "
-                     << "Please rename the solution to use a different ID.";
-        continue;
+    // Initialize group registry and storage
+    // Default: /var/lib/edge_ai_api/groups (auto-created if needed)
+    std::string groupsDir = EnvConfig::resolveDataDir("GROUPS_DIR", "groups");
+    PLOG_INFO << "[Main] Groups directory: " << groupsDir;
+    static GroupStorage groupStorage(groupsDir);
+    static GroupRegistry &groupRegistry = GroupRegistry::getInstance();
+
+    startupProfiler.record("data_dirs", phaseStart);
+
+    // Load registries, storage and persistent instances. Independent phases
+    // run in parallel on a small pool (EDGE_AI_STARTUP_THREADS, 1 = serial);
+    // each phase starts once the phases it reads from are done.
+    std::vector<SolutionConfig> customSolutions;
+    std::vector<GroupInfo> persistedGroups;
+    StartupTaskGraph initGraph;
+    PLOG_INFO << "[Main] Parallel initialization on " << initGraph.threads()
+              << " threads";
+
+    // Initialize default solutions (face_detection, etc.)
+    initGraph.add("default_solutions", {},
+                  []() { solutionRegistry.initializeDefaultSolutions(); });
+
+    initGraph.add("node_templates", {}, []() {
+      nodePool.initializeDefaultTemplates();
+      PLOG_INFO << "[Main] Node pool manager initialized with default "
+                   "templates";
+    });
+
+    initGraph.add("node_pool", {"default_solutions", "node_templates"}, []() {
+      // Step 1: Load persisted nodes from storage (if any)
+      size_t loadedFromStorage = nodePool.loadNodesFromStorage(nodeStorage);
+      PLOG_INFO << "[Main] Loaded " << loadedFromStorage
+                << " nodes from storage";
+
+      // Step 2: Create default nodes from all available templates
+      // This ensures all supported node types have default nodes, not just
+      // those from solutions
+      size_t createdFromTemplates = nodePool.createDefaultNodesFromTemplates();
+      PLOG_INFO << "[Main] Created " << createdFromTemplates
+                << " default nodes from templates";
+
+      // Step 3: Also create nodes from default solutions (for nodes with
+      // specific configurations) This adds nodes with solution-specific
+      // parameters
+      size_t createdFromSolutions =
+          nodePool.createNodesFromDefaultSolutions(solutionRegistry);
+      PLOG_INFO << "[Main] Created " << createdFromSolutions
+                << " nodes from default solutions";
+
+      size_t totalCreated = createdFromTemplates + createdFromSolutions;
+
+      // Step 4: Load user-created nodes again (in case storage was updated)
+      // This ensures we have all nodes: defaults + user-created
+      size_t loadedUserNodes = nodePool.loadNodesFromStorage(nodeStorage);
+
+      // Step 5: Get total count for reporting
+      auto stats = nodePool.getStats();
+      std::cerr << "[Main] ========================================"
+                << std::endl;
+      std::cerr << "[Main] Node Pool Status:" << std::endl;
+      std::cerr << "[Main]   Total nodes: " << stats.totalPreConfiguredNodes
+                << std::endl;
+      std::cerr << "[Main]   Available: " << stats.availableNodes << std::endl;
+      std::cerr << "[Main]   In use: " << stats.inUseNodes << std::endl;
+      std::cerr << "[Main]   Default nodes (from templates): "
+                << createdFromTemplates << std::endl;
+      std::cerr << "[Main]   Nodes from solutions: " << createdFromSolutions
+                << std::endl;
+      std::cerr << "[Main]   User-created nodes: " << loadedUserNodes
+                << std::endl;
+      std::cerr << "[Main] ========================================"
+                << std::endl;
+      PLOG_INFO << "[Main] Node pool initialized: "
+                << stats.totalPreConfiguredNodes << " total nodes ("
+                << stats.availableNodes << " available, " << stats.inUseNodes
+                << " in use)";
+
+      // Step 6: Save nodes to storage only if we created new nodes
+      if (totalCreated > 0) {
+        if (nodePool.saveNodesToStorage(nodeStorage)) {
+          PLOG_INFO << "[Main] Saved nodes to storage (including "
+                    << totalCreated << " new nodes)";
+        } else {
+          PLOG_WARNING << "[Main] Failed to save nodes to storage";
+        }
       }
+    });
 
-      // Register solution (registerSolution will also check for default
-      // solutions)
-      solutionRegistry.registerSolution(config);
+    initGraph.add("custom_solutions_load", {}, [&customSolutions]() {
+      customSolutions = solutionStorage.loadAllSolutions();
+    });
 
-      // Create nodes for node types in this custom solution (if they don't
-      // exist) Note: These are user-created nodes, not default nodes
-      size_t nodesCreated = nodePool.createNodesFromSolution(config);
-      if (nodesCreated > 0) {
-        PLOG_INFO << "[Main] Created " << nodesCreated
-                  << " nodes for custom solution: " << config.solutionId;
+    // Register persisted custom solutions
+    initGraph.add(
+        "custom_solutions", {"custom_solutions_load", "node_pool"},
+        [&customSolutions]() {
+          for (const auto &config : customSolutions) {
+            // Check if solution ID conflicts with default solution
+            if (solutionRegistry.isDefaultSolution(config.solutionId)) {
+              PLOG_WARNING
+                  << "[Main] Skipping custom solution '" << config.solutionId
+                  << "': ID conflicts with default system solution. "
+                  << "Please rename the solution to use a different ID.";
+              continue;
+            }
+
+            // Register solution (registerSolution will also check for default
+            // solutions)
+            solutionRegistry.registerSolution(config);
+
+            // Create nodes for node types in this custom solution (if they
+            // don't exist) Note: These are user-created nodes, not default
+            // nodes
+            size_t nodesCreated = nodePool.createNodesFromSolution(config);
+            if (nodesCreated > 0) {
+              PLOG_INFO << "[Main] Created " << nodesCreated
+                        << " nodes for custom solution: " << config.solutionId;
+            }
+
+            PLOG_INFO << "[Main] Loaded custom solution: "
+                      << config.solutionId << " (" << config.solutionName
+                      << ")";
+          }
+        });
+
+    // Load persistent instances (they reference default and custom
+    // solutions)
+    initGraph.add("persistent_instances", {"custom_solutions"}, []() {
+      instanceManager->loadPersistentInstances();
+    });
+
+    // Initialize default groups and load persisted groups
+    initGraph.add("groups", {}, [&persistedGroups]() {
+      groupRegistry.initializeDefaultGroups();
+      persistedGroups = groupStorage.loadAllGroups();
+      for (const auto &group : persistedGroups) {
+        if (!groupRegistry.groupExists(group.groupId)) {
+          groupRegistry.registerGroup(group.groupId, group.groupName,
+                                      group.description);
+          PLOG_INFO << "[Main] Loaded group: " << group.groupId << " ("
+                    << group.groupName << ")";
+        }
       }
+    });
 
-      PLOG_INFO << "[Main] Loaded custom solution: " << config.solutionId
-                << " (" << config.solutionName << ")";
-    }
+    initGraph.add("group_sync", {"groups", "persistent_instances"}, []() {
+      // Sync groups with instances after loading
+      // This ensures groups have correct instance counts and instance IDs
+      auto allInstances = instanceManager->getAllInstances();
+      std::map<std::string, std::vector<std::string>> groupInstancesMap;
+      for (const auto &info : allInstances) {
+        if (!info.group.empty()) {
+          // Auto-create group if it doesn't exist
+          if (!groupRegistry.groupExists(info.group)) {
+            groupRegistry.registerGroup(info.group, info.group, "");
+            PLOG_INFO << "[Main] Auto-created group from instance: "
+                      << info.group;
+          }
+          groupInstancesMap[info.group].push_back(info.instanceId);
+        }
+      }
+      // Update group registry with instance IDs
+      for (const auto &[groupId, instanceIds] : groupInstancesMap) {
+        groupRegistry.setInstanceIds(groupId, instanceIds);
+      }
+    });
 
-    // Load persistent instances
-    instanceManager->loadPersistentInstances();
+    initGraph.run();
+
+    phaseStart = std::chrono::steady_clock::now();
 
     // ============================================
     // AUTO-START FUNCTIONALITY
@@ -2529,47 +2663,6 @@ int main(int argc, char *argv[]) {
     SolutionHandler::setSolutionRegistry(&solutionRegistry);
     SolutionHandler::setSolutionStorage(&solutionStorage);
 
-    // Initialize group registry and storage
-    // Default: /var/lib/edge_ai_api/groups (auto-created if needed)
-    std::string groupsDir = EnvConfig::resolveDataDir("GROUPS_DIR", "groups");
-    PLOG_INFO << "[Main] Groups directory: " << groupsDir;
-    static GroupStorage groupStorage(groupsDir);
-    static GroupRegistry &groupRegistry = GroupRegistry::getInstance();
-
-    // Initialize default groups
-    groupRegistry.initializeDefaultGroups();
-
-    // Load persisted groups
-    auto persistedGroups = groupStorage.loadAllGroups();
-    for (const auto &group : persistedGroups) {
-      if (!groupRegistry.groupExists(group.groupId)) {
-        groupRegistry.registerGroup(group.groupId, group.groupName,
-                                    group.description);
-        PLOG_INFO << "[Main] Loaded group: " << group.groupId << " ("
-                  << group.groupName << ")";
-      }
-    }
-
-    // Sync groups with instances after loading
-    // This ensures groups have correct instance counts and instance IDs
-    auto allInstances = instanceManager->getAllInstances();
-    std::map<std::string, std::vector<std::string>> groupInstancesMap;
-    for (const auto &info : allInstances) {
-      if (!info.group.empty()) {
-        // Auto-create group if it doesn't exist
-        if (!groupRegistry.groupExists(info.group)) {
-          groupRegistry.registerGroup(info.group, info.group, "");
-          PLOG_INFO << "[Main] Auto-created group from instance: "
-                    << info.group;
-        }
-        groupInstancesMap[info.group].push_back(info.instanceId);
-      }
-    }
-    // Update group registry with instance IDs
-    for (const auto &[groupId, instanceIds] : groupInstancesMap) {
-      groupRegistry.setInstanceIds(groupId, instanceIds);
-    }
-
     // Register group registry, storage, and instance manager with group
     // handler
     GroupHandler::setGroupRegistry(&groupRegistry);
@@ -2589,6 +2682,10 @@ int main(int argc, char *argv[]) {
     // Register instance manager with WebSocket controller
     AIWebSocketController::setInstanceManager(instanceManager.get());
 
+    // Register instance manager as live preview frame source (MJPEG and
+    // binary WebSocket preview share PreviewStreamHub)
+    PreviewWebSocketController::setInstanceManager(instanceManager.get());
+
     // CRITICAL: Create handler instances AFTER dependencies are set
     // This ensures handlers are ready when Drogon registers routes
     // Handlers created here depend on dependencies set above
@@ -2602,7 +2699,10 @@ int main(int argc, char *argv[]) {
     static JamsHandler jamsHandler;
     static StopsHandler stopsHandler;
 
+    startupProfiler.record("handlers", phaseStart);
+
     // Initialize model upload handler with configurable directory
+    phaseStart = std::chrono::steady_clock::now();
     // Priority: 1. MODELS_DIR env var, 2. /opt/edge_ai_api/models (with
     // auto-fallback)
     std::string modelsDir;
@@ -2737,6 +2837,15 @@ int main(int argc, char *argv[]) {
     ModelUploadHandler::setModelsDirectory(modelsDir);
     static ModelUploadHandler modelUploadHandler;
 
+    // Index model files once (kept fresh with inotify) so PipelineBuilder
+    // model resolution and model listing don't stat every candidate path
+    {
+      auto &modelCatalog = ModelCatalog::getInstance();
+      modelCatalog.addRoot(EnvConfig::resolveDirectory(modelsDir, "models"));
+      modelCatalog.addDefaultRoots();
+      modelCatalog.start();
+    }
+
     // Initialize video upload handler with configurable directory
     // Priority: 1. VIDEOS_DIR env var, 2. /opt/edge_ai_api/videos (with
     // auto-fallback)
@@ -2871,6 +2980,22 @@ int main(int argc, char *argv[]) {
     PLOG_INFO << "[Main] Videos directory: " << videosDir;
     VideoUploadHandler::setVideosDirectory(videosDir);
     static VideoUploadHandler videoUploadHandler;
+
+    // Offline (faster than real time) analysis of uploaded videos
+    std::string videoJobsDir =
+        EnvConfig::resolveDataDir("VIDEO_JOBS_DIR", "video_jobs");
+    {
+      auto offlineConfig = OfflineJobManager::loadConfig();
+      offlineConfig.jobs_dir = videoJobsDir;
+      OfflineJobManager::getInstance().configure(offlineConfig);
+      OfflineJobManager::getInstance().setSegmentProcessor(
+          &OfflineSegmentPipeline::processSegment);
+    }
+    // Finished recordings are finalized (faststart) by a bounded worker pool
+    MP4Finalizer::MP4FinalizeQueue::getInstance().configure(
+        MP4Finalizer::MP4FinalizeQueue::loadConfig());
+    VideoJobHandler::setVideosDirectory(videosDir);
+    static VideoJobHandler videoJobHandler;
     static RecognitionHandler recognitionHandler;
 
     // Initialize font upload handler with configurable directory
@@ -3088,6 +3213,7 @@ int main(int argc, char *argv[]) {
 
     // Create config handler instance to register endpoints
     static ConfigHandler configHandler;
+    startupProfiler.record("media_dirs", phaseStart);
 
     PLOG_INFO << "[Main] Instance management initialized";
     PLOG_INFO << "  POST /v1/core/instance - Create new instance";
@@ -3117,6 +3243,8 @@ int main(int argc, char *argv[]) {
     PLOG_INFO << "  DELETE /v1/core/groups/{groupId} - Delete group";
     PLOG_INFO
         << "  GET /v1/core/groups/{groupId}/instances - Get instances in group";
+    PLOG_INFO << "  POST /v1/core/groups/{groupId}/start|stop|restart - "
+                 "Group action (?stream=true for SSE progress)";
     PLOG_INFO << "  Groups directory: " << groupsDir;
     PLOG_INFO << "[Main] Model upload handler initialized";
     PLOG_INFO << "  POST /v1/core/model/upload - Upload model file";
@@ -3130,6 +3258,12 @@ int main(int argc, char *argv[]) {
     PLOG_INFO << "  PUT /v1/core/video/{videoName} - Rename video file";
     PLOG_INFO << "  DELETE /v1/core/video/{videoName} - Delete video file";
     PLOG_INFO << "  Videos directory: " << videosDir;
+    PLOG_INFO << "[Main] Offline video jobs initialized";
+    PLOG_INFO << "  POST /v1/core/video/jobs - Analyse a video faster than "
+                 "real time";
+    PLOG_INFO << "  GET /v1/core/video/jobs/{jobId} - Job progress";
+    PLOG_INFO << "  GET /v1/core/video/jobs/{jobId}/events - Merged events";
+    PLOG_INFO << "  Jobs directory: " << videoJobsDir;
     PLOG_INFO << "[Main] Font upload handler initialized";
     PLOG_INFO << "  POST /v1/core/font/upload - Upload font file";
     PLOG_INFO << "  GET /v1/core/font/list - List uploaded fonts";
@@ -3169,6 +3303,7 @@ int main(int argc, char *argv[]) {
     // endpoints are not needed yet. They can be enabled later when needed.
 
     // Initialize watchdog and health monitor from environment variables
+    phaseStart = std::chrono::steady_clock::now();
     uint32_t watchdog_check_interval =
         EnvConfig::getUInt32("WATCHDOG_CHECK_INTERVAL_MS", 5000);
     uint32_t watchdog_timeout =
@@ -3187,8 +3322,12 @@ int main(int argc, char *argv[]) {
     WatchdogHandler::setWatchdog(g_watchdog.get());
     WatchdogHandler::setHealthMonitor(g_health_monitor.get());
 
+    startupProfiler.record("watchdog", phaseStart);
+    phaseStart = std::chrono::steady_clock::now();
     PLOG_INFO << "[Main] Watchdog and health monitor started";
     PLOG_INFO << "  GET /v1/core/watchdog - Watchdog status";
+    PLOG_INFO << "  GET /v1/core/operations - Recent instance operations";
+    PLOG_INFO << "  GET /v1/core/operations/{id} - Operation state and progress";
 
     // Start debug analysis board thread if debug mode is enabled
     std::thread debugThread;
@@ -3236,6 +3375,15 @@ int main(int argc, char *argv[]) {
     retryMonitorThread.detach(); // Detach so it runs independently
     PLOG_INFO << "[Main] Retry limit monitoring thread started";
 
+    // Queue monitor re-tunes per-instance queue sizes from queue depth
+    // telemetry; queue full warnings are pushed by the pipeline hooks
+    QueueMonitor::getInstance().startMonitoring();
+
+    // Source auto-tune adjusts resize_ratio / skip_interval of instances that
+    // opted in with AUTO_TUNE
+    SourceAutoTuneMonitor::getInstance().start(
+        instanceManager.get(), SourceAutoTuneMonitor::loadConfig());
+
     // TEMPORARILY DISABLED: Queue monitoring thread
     // This thread monitors instance FPS and queue status to proactively prevent
     // deadlock When FPS drops to 0 or queue warnings are excessive,
@@ -3528,6 +3676,7 @@ int main(int argc, char *argv[]) {
               std::cerr << "[CRITICAL] Possible causes: blocked API request, "
                            "RTSP retry loop, or other blocking operation"
                         << std::endl;
+              AsyncLogBackend::getInstance().flush();
               std::fflush(stdout);
               std::fflush(stderr);
 
@@ -3668,6 +3817,38 @@ int main(int argc, char *argv[]) {
     PLOG_INFO
         << "[Config] Metrics middleware registered for endpoint monitoring";
 
+    // Admission control: keeps heavy endpoints (recognition, uploads, batch
+    // operations) off the I/O threads so health/metrics stay responsive.
+    // Registered as pre-handling advice because it must run for every route.
+    {
+      auto &admission = RequestAdmissionControl::getInstance();
+      auto admissionConfig = RequestAdmissionControl::loadConfig();
+      admission.configure(admissionConfig);
+      if (admissionConfig.enabled) {
+        app.registerPreHandlingAdvice(
+            [](const drogon::HttpRequestPtr &req, drogon::AdviceCallback &&acb,
+               drogon::AdviceChainCallback &&accb) {
+              RequestAdmissionControl::getInstance().admit(
+                  req, std::move(acb), std::move(accb));
+            });
+        PLOG_INFO << "[Config] Admission control enabled: "
+                  << admissionConfig.worker_threads << " workers, queue "
+                  << admissionConfig.max_queue_size;
+      } else {
+        PLOG_INFO << "[Config] Admission control disabled";
+      }
+    }
+
+    // Long-running instance operations (stop/restart/delete/batch) run on a
+    // bounded pool, serialized per instance, tracked via /v1/core/operations
+    {
+      auto operationsConfig = OperationExecutor::loadConfig();
+      OperationExecutor::getInstance().configure(operationsConfig);
+      PLOG_INFO << "[Config] Operation executor: "
+                << operationsConfig.worker_threads << " workers, max pending "
+                << operationsConfig.max_pending;
+    }
+
     // Explicitly disable HTTPS - we only use HTTP
     // With useSSL=false, Drogon will not check for SSL certificates
     PLOG_INFO << "[Config] Using HTTP only (HTTPS disabled)";
@@ -3744,6 +3925,14 @@ int main(int argc, char *argv[]) {
     // pool We just need to call addListener once - Drogon will create multiple
     // listeners if needed for load balancing when using multiple threads
     app.addListener(host, port, false, "", "");
+    startupProfiler.record("http_server", phaseStart);
+
+    // Listeners are open once the beginning advices run: the API is ready
+    app.registerBeginningAdvice([]() {
+      auto &profiler = StartupProfiler::getInstance();
+      profiler.markReady();
+      profiler.logSummary();
+    });
 
     PLOG_INFO << "[Server] Starting HTTP server on " << host << ":" << port;
     PLOG_INFO << "[Server] Access http://" << host << ":" << port
@@ -3794,6 +3983,15 @@ int main(int argc, char *argv[]) {
       // force exit
       app.run();
 
+      // Stop admission executor threads before tearing down handlers
+      RequestAdmissionControl::getInstance().shutdown();
+      SourceAutoTuneMonitor::getInstance().stop();
+      OperationExecutor::getInstance().shutdown();
+      OfflineJobManager::getInstance().shutdown();
+      MP4Finalizer::MP4FinalizeQueue::getInstance().shutdown();
+      PreviewStreamHub::getInstance().shutdown();
+      InstanceSubscriptionHub::getInstance().shutdown();
+
       // After app.run() returns, ensure we exit cleanly
       // If we're here, quit() was called, so proceed with cleanup
       if (g_shutdown || g_force_exit.load()) {
@@ -3804,6 +4002,7 @@ int main(int argc, char *argv[]) {
       if (g_force_exit.load()) {
         std::cerr << "[SHUTDOWN] Force exit requested, skipping cleanup..."
                   << std::endl;
+        AsyncLogBackend::getInstance().flush();
         _exit(0);
       }
     } catch (const std::exception &e) {
@@ -3835,6 +4034,7 @@ int main(int argc, char *argv[]) {
     }
 
     PLOG_INFO << "Server stopped.";
+    AsyncLogBackend::getInstance().shutdown();
     return 0;
   } catch (const std::exception &e) {
     PLOG_FATAL << "Fatal error: " << e.what();
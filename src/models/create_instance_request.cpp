@@ -64,6 +64,13 @@ bool CreateInstanceRequest::validate() const {
     return false;
   }
 
+  // Validate resourceLimits
+  std::string limitsError = resourceLimits.validate();
+  if (!limitsError.empty()) {
+    validation_error_ = limitsError;
+    return false;
+  }
+
   return true;
 }
 
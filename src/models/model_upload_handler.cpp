@@ -1,6 +1,7 @@
 #include "models/model_upload_handler.h"
 #include "core/env_config.h"
 #include "core/metrics_interceptor.h"
+#include "core/model_catalog.h"
 #include <algorithm>
 #include <cctype>
 #include <chrono>
@@ -687,6 +688,12 @@ void ModelUploadHandler::uploadModel(
             continue;
           }
 
+          // Update model catalog incrementally (checksum from upload body)
+          ModelCatalog::getInstance().notifyFileChanged(
+              partFilePath.string(),
+              ModelCatalog::computeChecksum(body.data() + contentStart,
+                                            writeSize));
+
           // Get file size
           auto fileSize = std::filesystem::file_size(partFilePath);
 
@@ -965,6 +972,11 @@ void ModelUploadHandler::uploadModel(
                                          std::string(e.what())));
         return;
       }
+
+      // Update model catalog incrementally (checksum from upload body)
+      ModelCatalog::getInstance().notifyFileChanged(
+          filePath.string(),
+          ModelCatalog::computeChecksum(body.data(), writeSize));
     }
 
     // Get file size with proper error handling
@@ -1082,6 +1094,62 @@ void ModelUploadHandler::listModels(
     Json::Value response;
     Json::Value models(Json::arrayValue);
 
+    // Serve from the model catalog when it indexes the models directory
+    // (no directory walk / stat per file). checksum=true computes missing
+    // content checksums.
+    auto &catalog = ModelCatalog::getInstance();
+    std::vector<ModelCatalog::ModelEntry> catalogEntries;
+    if (catalog.lookupDirectory(modelsPath.string()) ==
+            ModelCatalog::Lookup::Found &&
+        catalog.listDirectory(modelsPath.string(), subDir.empty(),
+                              catalogEntries)) {
+      bool withChecksum = req->getParameter("checksum") == "true";
+      std::string basePath = ModelCatalog::normalizePath(modelsPath.string());
+      int count = 0;
+      for (auto &entry : catalogEntries) {
+        if (!isValidModelFile(entry.filename)) {
+          continue;
+        }
+        if (withChecksum && entry.checksum.empty()) {
+          entry.checksum = catalog.getChecksum(entry.path);
+        }
+
+        Json::Value model;
+        model["filename"] = entry.filename;
+        if (subDir.empty()) {
+          model["relativePath"] = entry.path.substr(basePath.size() + 1);
+        }
+        model["path"] = entry.canonicalPath;
+        model["size"] = static_cast<Json::Int64>(entry.size);
+
+        std::time_t timeT = static_cast<std::time_t>(entry.modifiedTime);
+        std::stringstream ss;
+        ss << std::put_time(std::localtime(&timeT), "%Y-%m-%d %H:%M:%S");
+        model["modified"] = ss.str();
+        if (!entry.checksum.empty()) {
+          model["checksum"] = entry.checksum;
+        }
+
+        models.append(model);
+        count++;
+      }
+
+      response["success"] = true;
+      response["models"] = models;
+      response["count"] = count;
+      response["directory"] = std::filesystem::canonical(modelsPath).string();
+
+      auto resp = HttpResponse::newHttpJsonResponse(response);
+      resp->setStatusCode(k200OK);
+      resp->addHeader("Access-Control-Allow-Origin", "*");
+      resp->addHeader("Access-Control-Allow-Methods",
+                      "POST, GET, PUT, DELETE, OPTIONS");
+      resp->addHeader("Access-Control-Allow-Headers",
+                      "Content-Type, Authorization");
+      MetricsInterceptor::callWithMetrics(req, resp, std::move(callback));
+      return;
+    }
+
     if (!std::filesystem::exists(modelsPath)) {
       // Return empty list if directory doesn't exist
       response["success"] = true;
@@ -1348,6 +1416,9 @@ void ModelUploadHandler::renameModel(
       return;
     }
 
+    ModelCatalog::getInstance().notifyFileRemoved(sourcePath.string());
+    ModelCatalog::getInstance().notifyFileChanged(destPath.string());
+
     Json::Value response;
     response["success"] = true;
     response["message"] = "Model file renamed successfully";
@@ -1432,6 +1503,7 @@ void ModelUploadHandler::deleteModel(
                                    "Could not delete model file"));
       return;
     }
+    ModelCatalog::getInstance().notifyFileRemoved(filePath.string());
 
     Json::Value response;
     response["success"] = true;
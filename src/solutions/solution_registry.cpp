@@ -125,6 +125,7 @@ void SolutionRegistry::initializeDefaultSolutions() {
   registerBAJamMQTTDefaultSolution();           // ba_jam_mqtt_default
   registerBAStopDefaultSolution();              // ba_stop_default
   registerBAStopMQTTDefaultSolution();          // ba_stop_mqtt_default
+  registerSyntheticLoadTestSolution();          // synthetic_load_test
 
 #ifdef CVEDIX_WITH_RKNN
   registerRKNNYOLOv11DetectionSolution();
@@ -1701,3 +1702,58 @@ void SolutionRegistry::registerBAStopMQTTDefaultSolution() {
 
   registerSolution(config);
 }
+
+void SolutionRegistry::registerSyntheticLoadTestSolution() {
+  SolutionConfig config;
+  config.solutionId = "synthetic_load_test";
+  config.solutionName = "Synthetic Load Test (no models, CPU only)";
+  config.solutionType = "synthetic";
+  config.isDefault = true;
+
+  // Unset ${...} parameters fall back to the node defaults (see
+  // core/synthetic_workload.h)
+
+  // Synthetic Source Node (generated frames)
+  SolutionConfig::NodeConfig syntheticSrc;
+  syntheticSrc.nodeType = "synthetic_src";
+  syntheticSrc.nodeName = "synthetic_src_{instanceId}";
+  syntheticSrc.parameters["channel"] = "0";
+  syntheticSrc.parameters["width"] = "${SYNTHETIC_WIDTH}";
+  syntheticSrc.parameters["height"] = "${SYNTHETIC_HEIGHT}";
+  syntheticSrc.parameters["fps"] = "${SYNTHETIC_FPS}";
+  config.pipeline.push_back(syntheticSrc);
+
+  // Synthetic Detector Node (simulated latency, moving boxes)
+  SolutionConfig::NodeConfig syntheticDetector;
+  syntheticDetector.nodeType = "synthetic_detector";
+  syntheticDetector.nodeName = "synthetic_detector_{instanceId}";
+  syntheticDetector.parameters["latency_ms"] = "${SYNTHETIC_LATENCY_MS}";
+  syntheticDetector.parameters["latency_jitter_ms"] =
+      "${SYNTHETIC_LATENCY_JITTER_MS}";
+  syntheticDetector.parameters["latency_mode"] = "${SYNTHETIC_LATENCY_MODE}";
+  syntheticDetector.parameters["boxes"] = "${SYNTHETIC_BOXES}";
+  syntheticDetector.parameters["seed"] = "${SYNTHETIC_SEED}";
+  config.pipeline.push_back(syntheticDetector);
+
+  // Synthetic BA Node (pass-through)
+  SolutionConfig::NodeConfig syntheticBA;
+  syntheticBA.nodeType = "synthetic_ba";
+  syntheticBA.nodeName = "synthetic_ba_{instanceId}";
+  config.pipeline.push_back(syntheticBA);
+
+  // Synthetic Broker Node (serializes, does not publish)
+  SolutionConfig::NodeConfig syntheticBroker;
+  syntheticBroker.nodeType = "synthetic_broker";
+  syntheticBroker.nodeName = "synthetic_broker_{instanceId}";
+  syntheticBroker.parameters["serialize"] = "${SYNTHETIC_SERIALIZE}";
+  config.pipeline.push_back(syntheticBroker);
+
+  // Default configurations
+  config.defaults["SYNTHETIC_WIDTH"] = "1280";
+  config.defaults["SYNTHETIC_HEIGHT"] = "720";
+  config.defaults["SYNTHETIC_FPS"] = "25";
+  config.defaults["SYNTHETIC_LATENCY_MS"] = "10";
+  config.defaults["SYNTHETIC_BOXES"] = "5";
+
+  registerSolution(config);
+}
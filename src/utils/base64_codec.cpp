@@ -0,0 +1,536 @@
+#include "utils/base64_codec.h"
+#include <array>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BASE64_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define BASE64_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace Base64 {
+
+namespace {
+
+constexpr char kAlphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Character -> 6-bit value, 0xFF for anything outside the alphabet
+constexpr std::array<uint8_t, 256> makeDecodeTable() {
+  std::array<uint8_t, 256> table{};
+  for (auto &entry : table) {
+    entry = 0xFF;
+  }
+  for (int i = 0; i < 64; ++i) {
+    table[static_cast<uint8_t>(kAlphabet[i])] = static_cast<uint8_t>(i);
+  }
+  return table;
+}
+constexpr std::array<uint8_t, 256> kDecode = makeDecodeTable();
+
+inline bool isSpace(uint8_t c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+// Block functions process as many whole blocks as they can and return the
+// number of input bytes consumed. Decoders stop before the first block that
+// holds anything but alphabet characters; the caller handles it.
+// Decoders may write up to 32 bytes past the decoded data.
+using BlockEncoder = size_t (*)(const uint8_t *src, size_t size, char *dst);
+using BlockDecoder = size_t (*)(const uint8_t *src, size_t size,
+                                uint8_t *dst);
+
+size_t encodeScalar(const uint8_t *src, size_t size, char *dst) {
+  size_t i = 0;
+  for (; i + 3 <= size; i += 3) {
+    uint32_t triple = (static_cast<uint32_t>(src[i]) << 16) |
+                      (static_cast<uint32_t>(src[i + 1]) << 8) | src[i + 2];
+    dst[0] = kAlphabet[(triple >> 18) & 0x3F];
+    dst[1] = kAlphabet[(triple >> 12) & 0x3F];
+    dst[2] = kAlphabet[(triple >> 6) & 0x3F];
+    dst[3] = kAlphabet[triple & 0x3F];
+    dst += 4;
+  }
+  return i;
+}
+
+size_t decodeScalar(const uint8_t *src, size_t size, uint8_t *dst) {
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    uint32_t a = kDecode[src[i]];
+    uint32_t b = kDecode[src[i + 1]];
+    uint32_t c = kDecode[src[i + 2]];
+    uint32_t d = kDecode[src[i + 3]];
+    if ((a | b | c | d) & 0x80) {
+      break;
+    }
+    uint32_t triple = (a << 18) | (b << 12) | (c << 6) | d;
+    dst[0] = static_cast<uint8_t>(triple >> 16);
+    dst[1] = static_cast<uint8_t>(triple >> 8);
+    dst[2] = static_cast<uint8_t>(triple);
+    dst += 3;
+  }
+  return i;
+}
+
+#ifdef BASE64_X86
+
+// Encoding: spread 12 input bytes over 16 lanes, extract the four 6-bit
+// indices with multiplies, then map index ranges to ASCII with one pshufb
+// (W. Mula, "Base64 encoding with SIMD instructions").
+// Decoding: classify each character by its nibbles to validate, add a
+// per-range offset, then pack 4x6 bits back into 3 bytes (A. Klomp's
+// base64 library).
+
+__attribute__((target("ssse3"))) inline __m128i
+encodeLanes128(__m128i in) {
+  in = _mm_shuffle_epi8(in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7,
+                                          10, 9, 11, 10));
+  const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+  const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+  const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  const __m128i indices = _mm_or_si128(t1, t3);
+
+  __m128i offset = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+  offset = _mm_or_si128(offset, _mm_and_si128(less, _mm_set1_epi8(13)));
+  const __m128i shift =
+      _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                    '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                    '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+  return _mm_add_epi8(_mm_shuffle_epi8(shift, offset), indices);
+}
+
+__attribute__((target("ssse3"))) size_t encodeSSSE3(const uint8_t *src,
+                                                     size_t size, char *dst) {
+  size_t i = 0;
+  // Loads 16 bytes, uses 12
+  for (; i + 16 <= size; i += 12) {
+    __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), encodeLanes128(in));
+    dst += 16;
+  }
+  return i;
+}
+
+// Returns false if any lane is outside the alphabet
+__attribute__((target("ssse3"))) inline bool decodeLanes128(__m128i &str) {
+  const __m128i lut_lo =
+      _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                    0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+  const __m128i lut_hi =
+      _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10,
+                    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  const __m128i lut_roll =
+      _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i nibble = _mm_set1_epi8(0x0f);
+
+  const __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(str, 4), nibble);
+  const __m128i lo_nibbles = _mm_and_si128(str, nibble);
+  const __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+  const __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+  const __m128i invalid =
+      _mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128());
+  if (_mm_movemask_epi8(invalid) != 0xFFFF) {
+    return false;
+  }
+  const __m128i eq_2f = _mm_cmpeq_epi8(str, _mm_set1_epi8('/'));
+  const __m128i roll =
+      _mm_shuffle_epi8(lut_roll, _mm_add_epi8(eq_2f, hi_nibbles));
+  str = _mm_add_epi8(str, roll);
+
+  const __m128i merged_ab_bc =
+      _mm_maddubs_epi16(str, _mm_set1_epi32(0x01400140));
+  str = _mm_madd_epi16(merged_ab_bc, _mm_set1_epi32(0x00011000));
+  str = _mm_shuffle_epi8(str, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14,
+                                            13, 12, -1, -1, -1, -1));
+  return true;
+}
+
+__attribute__((target("ssse3"))) size_t
+decodeSSSE3(const uint8_t *src, size_t size, uint8_t *dst) {
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    __m128i str = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    if (!decodeLanes128(str)) {
+      break;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), str);
+    dst += 12;
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) size_t encodeAVX2(const uint8_t *src,
+                                                   size_t size, char *dst) {
+  const __m256i spread = _mm256_setr_epi8(
+      1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1, 0, 2, 1, 4, 3, 5,
+      4, 7, 6, 8, 7, 10, 9, 11, 10);
+  const __m256i shift = _mm256_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+  size_t i = 0;
+  // Two 16-byte loads 12 bytes apart: reads 28 bytes, uses 24
+  for (; i + 28 <= size; i += 24) {
+    __m256i in = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 12)), 1);
+    in = _mm256_shuffle_epi8(in, spread);
+    const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+    const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+    const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+    const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+    const __m256i indices = _mm256_or_si256(t1, t3);
+
+    __m256i offset = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    offset =
+        _mm256_or_si256(offset, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+    __m256i out =
+        _mm256_add_epi8(_mm256_shuffle_epi8(shift, offset), indices);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), out);
+    dst += 32;
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) size_t decodeAVX2(const uint8_t *src,
+                                                   size_t size, uint8_t *dst) {
+  const __m256i lut_lo = _mm256_setr_epi8(
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A,
+      0x1B, 0x1B, 0x1B, 0x1A, 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+      0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+  const __m256i lut_hi = _mm256_setr_epi8(
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  const __m256i lut_roll = _mm256_setr_epi8(
+      0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16, 19, 4,
+      -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m256i pack = _mm256_setr_epi8(
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5, 4,
+      10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+  const __m256i nibble = _mm256_set1_epi8(0x0f);
+
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    __m256i str =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    const __m256i hi_nibbles =
+        _mm256_and_si256(_mm256_srli_epi32(str, 4), nibble);
+    const __m256i lo_nibbles = _mm256_and_si256(str, nibble);
+    const __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+    const __m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+    if (!_mm256_testz_si256(lo, hi)) {
+      break;
+    }
+    const __m256i eq_2f = _mm256_cmpeq_epi8(str, _mm256_set1_epi8('/'));
+    const __m256i roll =
+        _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(eq_2f, hi_nibbles));
+    str = _mm256_add_epi8(str, roll);
+
+    const __m256i merged_ab_bc =
+        _mm256_maddubs_epi16(str, _mm256_set1_epi32(0x01400140));
+    str = _mm256_madd_epi16(merged_ab_bc, _mm256_set1_epi32(0x00011000));
+    str = _mm256_shuffle_epi8(str, pack);
+    // 12 bytes per lane -> 24 contiguous bytes
+    str = _mm256_permutevar8x32_epi32(str,
+                                      _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), str);
+    dst += 24;
+  }
+  return i;
+}
+
+#endif // BASE64_X86
+
+#ifdef BASE64_NEON
+
+inline uint8x16x4_t loadTable(const uint8_t *table) {
+  uint8x16x4_t t;
+  t.val[0] = vld1q_u8(table);
+  t.val[1] = vld1q_u8(table + 16);
+  t.val[2] = vld1q_u8(table + 32);
+  t.val[3] = vld1q_u8(table + 48);
+  return t;
+}
+
+// De-interleaving loads split 48 bytes into the three byte positions of each
+// group (and 64 characters into the four positions), so the 6-bit fields are
+// plain shifts and the alphabet mapping is a 64-byte table lookup.
+size_t encodeNEON(const uint8_t *src, size_t size, char *dst) {
+  const uint8x16x4_t alphabet =
+      loadTable(reinterpret_cast<const uint8_t *>(kAlphabet));
+  const uint8x16_t mask = vdupq_n_u8(0x3F);
+  size_t i = 0;
+  for (; i + 48 <= size; i += 48) {
+    uint8x16x3_t in = vld3q_u8(src + i);
+    uint8x16x4_t out;
+    out.val[0] = vshrq_n_u8(in.val[0], 2);
+    out.val[1] = vandq_u8(
+        vorrq_u8(vshrq_n_u8(in.val[1], 4), vshlq_n_u8(in.val[0], 4)), mask);
+    out.val[2] = vandq_u8(
+        vorrq_u8(vshrq_n_u8(in.val[2], 6), vshlq_n_u8(in.val[1], 2)), mask);
+    out.val[3] = vandq_u8(in.val[2], mask);
+    out.val[0] = vqtbl4q_u8(alphabet, out.val[0]);
+    out.val[1] = vqtbl4q_u8(alphabet, out.val[1]);
+    out.val[2] = vqtbl4q_u8(alphabet, out.val[2]);
+    out.val[3] = vqtbl4q_u8(alphabet, out.val[3]);
+    vst4q_u8(reinterpret_cast<uint8_t *>(dst), out);
+    dst += 64;
+  }
+  return i;
+}
+
+size_t decodeNEON(const uint8_t *src, size_t size, uint8_t *dst) {
+  // kDecode[0..63] and kDecode[64..127]; bytes >= 128 are caught by their
+  // own top bit
+  const uint8x16x4_t low = loadTable(kDecode.data());
+  const uint8x16x4_t high = loadTable(kDecode.data() + 64);
+  const uint8x16_t offset = vdupq_n_u8(64);
+  size_t i = 0;
+  for (; i + 64 <= size; i += 64) {
+    uint8x16x4_t str = vld4q_u8(src + i);
+    uint8x16_t error = vdupq_n_u8(0);
+    for (int k = 0; k < 4; ++k) {
+      uint8x16_t c = str.val[k];
+      uint8x16_t value = vqtbl4q_u8(low, c);
+      value = vqtbx4q_u8(value, high, vsubq_u8(c, offset));
+      error = vorrq_u8(error, vorrq_u8(value, c));
+      str.val[k] = value;
+    }
+    if (vmaxvq_u8(error) & 0x80) {
+      break;
+    }
+    uint8x16x3_t out;
+    out.val[0] =
+        vorrq_u8(vshlq_n_u8(str.val[0], 2), vshrq_n_u8(str.val[1], 4));
+    out.val[1] =
+        vorrq_u8(vshlq_n_u8(str.val[1], 4), vshrq_n_u8(str.val[2], 2));
+    out.val[2] = vorrq_u8(vshlq_n_u8(str.val[2], 6), str.val[3]);
+    vst3q_u8(dst, out);
+    dst += 48;
+  }
+  return i;
+}
+
+#endif // BASE64_NEON
+
+BlockEncoder encoderFor(Impl impl) {
+  switch (impl) {
+#ifdef BASE64_X86
+  case Impl::AVX2:
+    return encodeAVX2;
+  case Impl::SSSE3:
+    return encodeSSSE3;
+#endif
+#ifdef BASE64_NEON
+  case Impl::NEON:
+    return encodeNEON;
+#endif
+  default:
+    return encodeScalar;
+  }
+}
+
+BlockDecoder decoderFor(Impl impl) {
+  switch (impl) {
+#ifdef BASE64_X86
+  case Impl::AVX2:
+    return decodeAVX2;
+  case Impl::SSSE3:
+    return decodeSSSE3;
+#endif
+#ifdef BASE64_NEON
+  case Impl::NEON:
+    return decodeNEON;
+#endif
+  default:
+    return decodeScalar;
+  }
+}
+
+} // namespace
+
+bool isSupported(Impl impl) {
+  switch (impl) {
+  case Impl::Scalar:
+    return true;
+#ifdef BASE64_X86
+  case Impl::SSSE3:
+    return __builtin_cpu_supports("ssse3");
+  case Impl::AVX2:
+    return __builtin_cpu_supports("avx2");
+#endif
+#ifdef BASE64_NEON
+  case Impl::NEON:
+    return true;
+#endif
+  default:
+    return false;
+  }
+}
+
+Impl bestImpl() {
+  static const Impl best = []() {
+    for (Impl impl : {Impl::AVX2, Impl::SSSE3, Impl::NEON}) {
+      if (isSupported(impl)) {
+        return impl;
+      }
+    }
+    return Impl::Scalar;
+  }();
+  return best;
+}
+
+const char *implName(Impl impl) {
+  switch (impl) {
+  case Impl::SSSE3:
+    return "ssse3";
+  case Impl::AVX2:
+    return "avx2";
+  case Impl::NEON:
+    return "neon";
+  default:
+    return "scalar";
+  }
+}
+
+std::string encode(const void *data, size_t size) {
+  return encode(data, size, bestImpl());
+}
+
+std::string encode(const void *data, size_t size, Impl impl) {
+  if (!isSupported(impl)) {
+    impl = Impl::Scalar;
+  }
+  std::string result(encodedSize(size), '\0');
+  const auto *src = static_cast<const uint8_t *>(data);
+  char *dst = &result[0];
+
+  size_t done = encoderFor(impl)(src, size, dst);
+  done += encodeScalar(src + done, size - done, dst + done / 3 * 4);
+
+  size_t rest = size - done;
+  if (rest > 0) {
+    uint32_t triple = static_cast<uint32_t>(src[done]) << 16;
+    if (rest == 2) {
+      triple |= static_cast<uint32_t>(src[done + 1]) << 8;
+    }
+    char *tail = &result[result.size() - 4];
+    tail[0] = kAlphabet[(triple >> 18) & 0x3F];
+    tail[1] = kAlphabet[(triple >> 12) & 0x3F];
+    tail[2] = rest == 2 ? kAlphabet[(triple >> 6) & 0x3F] : '=';
+    tail[3] = '=';
+  }
+  return result;
+}
+
+bool decode(const char *text, size_t size,
+            std::vector<unsigned char> &output) {
+  return decode(text, size, output, bestImpl());
+}
+
+bool decode(const char *text, size_t size, std::vector<unsigned char> &output,
+            Impl impl) {
+  if (!isSupported(impl)) {
+    impl = Impl::Scalar;
+  }
+  BlockDecoder blocks = decoderFor(impl);
+  const auto *src = reinterpret_cast<const uint8_t *>(text);
+
+  // Room for every character being significant plus SIMD store overrun
+  output.resize(size / 4 * 3 + 3 + 32);
+  uint8_t *dst = output.data();
+  size_t written = 0;
+  size_t pos = 0;
+
+  while (pos < size) {
+    // Fast path over clean blocks, then the scalar loop up to the next
+    // whitespace/padding/invalid character
+    size_t used = blocks(src + pos, size - pos, dst + written);
+    pos += used;
+    written += used / 4 * 3;
+    used = decodeScalar(src + pos, size - pos, dst + written);
+    pos += used;
+    written += used / 4 * 3;
+    if (pos >= size) {
+      break;
+    }
+
+    // Slow path: one group of four significant characters
+    uint8_t group[4];
+    int count = 0;
+    while (pos < size && count < 4) {
+      uint8_t c = src[pos];
+      if (isSpace(c)) {
+        ++pos;
+        continue;
+      }
+      if (c == '=') {
+        break;
+      }
+      uint8_t value = kDecode[c];
+      if (value & 0x80) {
+        return false;
+      }
+      group[count++] = value;
+      ++pos;
+    }
+
+    if (count == 4) {
+      dst[written++] = static_cast<uint8_t>((group[0] << 2) | (group[1] >> 4));
+      dst[written++] = static_cast<uint8_t>((group[1] << 4) | (group[2] >> 2));
+      dst[written++] = static_cast<uint8_t>((group[2] << 6) | group[3]);
+      continue;
+    }
+
+    // Final group: padding (if any) and whitespace may follow, nothing else
+    int padding = 0;
+    for (; pos < size; ++pos) {
+      uint8_t c = src[pos];
+      if (c == '=') {
+        ++padding;
+      } else if (!isSpace(c)) {
+        return false;
+      }
+    }
+    if (count == 1 || (count == 0 && padding > 0) ||
+        (padding > 0 && count + padding != 4)) {
+      return false;
+    }
+    if (count >= 2) {
+      dst[written++] = static_cast<uint8_t>((group[0] << 2) | (group[1] >> 4));
+    }
+    if (count == 3) {
+      dst[written++] = static_cast<uint8_t>((group[1] << 4) | (group[2] >> 2));
+    }
+    break;
+  }
+
+  output.resize(written);
+  return true;
+}
+
+bool isBase64(const std::string &text) {
+  if (text.empty()) {
+    return false;
+  }
+  for (unsigned char c : text) {
+    if ((kDecode[c] & 0x80) && c != '=' && !isSpace(c)) {
+      return false;
+    }
+  }
+  size_t padding = 0;
+  for (size_t i = text.size() - 1; i > 0 && text[i] == '='; --i) {
+    ++padding;
+  }
+  return padding <= 2;
+}
+
+} // namespace Base64
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Base64 (RFC 4648, standard alphabet) encoder/decoder
+ *
+ * Shared by every path that moves images as base64: preview/last-frame
+ * encoding in the registry and the worker, and image uploads in the
+ * recognition API. Large inputs are processed in SIMD blocks (AVX2 or SSSE3
+ * picked at runtime on x86-64, NEON on AArch64) with a table-driven scalar
+ * loop for the tail and for CPUs without them. All implementations produce
+ * identical output.
+ */
+namespace Base64 {
+
+enum class Impl { Scalar, SSSE3, AVX2, NEON };
+
+/**
+ * @brief Fastest implementation this CPU supports (used by default)
+ */
+Impl bestImpl();
+
+bool isSupported(Impl impl);
+const char *implName(Impl impl);
+
+inline size_t encodedSize(size_t size) { return (size + 2) / 3 * 4; }
+
+/**
+ * @brief Encode with '=' padding
+ */
+std::string encode(const void *data, size_t size);
+std::string encode(const void *data, size_t size, Impl impl);
+inline std::string encode(const std::vector<unsigned char> &data) {
+  return encode(data.data(), data.size());
+}
+
+/**
+ * @brief Decode into output (replaced)
+ *
+ * Whitespace (space, tab, CR, LF) anywhere is skipped and trailing padding
+ * is optional.
+ * @return false on characters outside the alphabet, misplaced padding or a
+ * truncated final group (output is unspecified then)
+ */
+bool decode(const char *text, size_t size, std::vector<unsigned char> &output);
+bool decode(const char *text, size_t size, std::vector<unsigned char> &output,
+            Impl impl);
+inline bool decode(const std::string &text,
+                   std::vector<unsigned char> &output) {
+  return decode(text.data(), text.size(), output);
+}
+
+/**
+ * @brief Quick syntax check: alphabet, '=' and whitespace only, at most two
+ * trailing '='
+ */
+bool isBase64(const std::string &text);
+
+} // namespace Base64
@@ -0,0 +1,502 @@
+#include "utils/gstreamer_capabilities.h"
+#include "core/env_config.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <sys/stat.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+
+#ifdef EDGE_AI_GST_PROBE
+#include <gst/gst.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+bool endsWith(const std::string &value, const std::string &suffix) {
+  return value.size() >= suffix.size() &&
+         value.compare(value.size() - suffix.size(), suffix.size(), suffix) ==
+             0;
+}
+
+std::string trim(const std::string &value) {
+  size_t begin = value.find_first_not_of(" \t\r\n");
+  if (begin == std::string::npos) {
+    return "";
+  }
+  size_t end = value.find_last_not_of(" \t\r\n");
+  return value.substr(begin, end - begin + 1);
+}
+
+std::string toLower(std::string value) {
+  std::transform(value.begin(), value.end(), value.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return value;
+}
+
+// Codec elements with these prefixes drive a hardware block even when their
+// class does not say "Hardware" (older plugins, gst-inspect fallback)
+bool hasHardwarePrefix(const std::string &name) {
+  static const std::array<const char *, 12> prefixes = {
+      "nv",  "v4l2", "va",  "qsv",   "msdk",  "mpp",
+      "omx", "amf",  "vt",  "d3d11", "d3d12", "rkmpp"};
+  for (const char *prefix : prefixes) {
+    if (name.rfind(prefix, 0) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+int64_t fileMtime(const std::string &path) {
+  struct stat st;
+  if (path.empty() || stat(path.c_str(), &st) != 0) {
+    return -1;
+  }
+  return static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000LL +
+         st.st_mtim.tv_nsec;
+}
+
+} // namespace
+
+std::shared_ptr<const GStreamerCapabilities::Manifest>
+GStreamerCapabilities::get() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (manifest_) {
+    return manifest_;
+  }
+  return loadOrProbe(false);
+}
+
+std::shared_ptr<const GStreamerCapabilities::Manifest>
+GStreamerCapabilities::refresh() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return loadOrProbe(true);
+}
+
+bool GStreamerCapabilities::has(const std::string &name) {
+  auto manifest = get();
+  return manifest->elements.count(name) > 0 ||
+         manifest->plugins.count(name) > 0;
+}
+
+int GStreamerCapabilities::rank(const std::string &element) {
+  auto manifest = get();
+  auto it = manifest->elements.find(element);
+  return it == manifest->elements.end() ? -1
+                                        : static_cast<int>(it->second.rank);
+}
+
+bool GStreamerCapabilities::isKnown() { return !get()->empty(); }
+
+std::shared_ptr<const GStreamerCapabilities::Manifest>
+GStreamerCapabilities::loadOrProbe(bool force) {
+  std::string path = manifestPath();
+  if (!force) {
+    auto cached = loadManifest(path, currentKey());
+    if (cached) {
+      manifest_ = std::make_shared<const Manifest>(std::move(*cached));
+      return manifest_;
+    }
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  Manifest manifest = probe();
+  // The probe may have created or rescanned the registry
+  manifest.key = currentKey();
+  manifest.created_at = static_cast<int64_t>(std::time(nullptr));
+  auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+
+  size_t decoders = 0, encoders = 0, hardware = 0;
+  for (const auto &[name, element] : manifest.elements) {
+    decoders += element.decoder ? 1 : 0;
+    encoders += element.encoder ? 1 : 0;
+    hardware += element.hardware ? 1 : 0;
+  }
+  std::cerr << "[GStreamerCapabilities] Probed " << manifest.elements.size()
+            << " elements from " << manifest.plugins.size() << " plugins ("
+            << decoders << " decoders, " << encoders << " encoders, "
+            << hardware << " hardware) via " << manifest.source << " in "
+            << elapsed_ms << " ms" << std::endl;
+
+  // Not caching "no GStreamer found": installing it must not need a refresh
+  if (!manifest.empty() && !path.empty()) {
+    if (saveManifest(path, manifest)) {
+      std::cerr << "[GStreamerCapabilities] Manifest cached at " << path
+                << std::endl;
+    }
+  }
+  manifest_ = std::make_shared<const Manifest>(std::move(manifest));
+  return manifest_;
+}
+
+GStreamerCapabilities::Manifest GStreamerCapabilities::probe() {
+  auto manifest = probeRegistry();
+  if (manifest) {
+    return std::move(*manifest);
+  }
+  return probeGstInspect();
+}
+
+std::optional<GStreamerCapabilities::Manifest>
+GStreamerCapabilities::probeRegistry() {
+#ifdef EDGE_AI_GST_PROBE
+  GError *error = nullptr;
+  if (!gst_init_check(nullptr, nullptr, &error)) {
+    std::cerr << "[GStreamerCapabilities] gst_init failed: "
+              << (error ? error->message : "unknown error")
+              << ", falling back to gst-inspect-1.0" << std::endl;
+    g_clear_error(&error);
+    return std::nullopt;
+  }
+
+  Manifest manifest;
+  manifest.source = "registry";
+  gchar *version = gst_version_string();
+  manifest.gstreamer_version = version ? version : "";
+  g_free(version);
+
+  GstRegistry *registry = gst_registry_get();
+  GList *plugins = gst_registry_get_plugin_list(registry);
+  for (GList *item = plugins; item; item = item->next) {
+    const gchar *name = gst_plugin_get_name(GST_PLUGIN(item->data));
+    if (name) {
+      manifest.plugins.insert(name);
+    }
+  }
+  gst_plugin_list_free(plugins);
+
+  GList *features =
+      gst_registry_get_feature_list(registry, GST_TYPE_ELEMENT_FACTORY);
+  for (GList *item = features; item; item = item->next) {
+    GstPluginFeature *feature = GST_PLUGIN_FEATURE(item->data);
+    Element element;
+    element.name = gst_plugin_feature_get_name(feature);
+    const gchar *plugin = gst_plugin_feature_get_plugin_name(feature);
+    element.plugin = plugin ? plugin : "";
+    const gchar *klass = gst_element_factory_get_metadata(
+        GST_ELEMENT_FACTORY(feature), GST_ELEMENT_METADATA_KLASS);
+    element.klass = klass ? klass : "";
+    element.rank = gst_plugin_feature_get_rank(feature);
+    classify(element);
+    manifest.elements[element.name] = std::move(element);
+  }
+  gst_plugin_feature_list_free(features);
+  return manifest;
+#else
+  return std::nullopt;
+#endif
+}
+
+GStreamerCapabilities::Manifest GStreamerCapabilities::probeGstInspect() {
+  // One listing for everything instead of one gst-inspect per element
+  std::string output;
+  FILE *pipe = popen("gst-inspect-1.0 2>/dev/null", "r");
+  if (pipe) {
+    std::array<char, 4096> buffer;
+    size_t read = 0;
+    while ((read = fread(buffer.data(), 1, buffer.size(), pipe)) > 0) {
+      output.append(buffer.data(), read);
+    }
+    pclose(pipe);
+  }
+
+  Manifest manifest = parseGstInspect(output);
+  if (manifest.empty()) {
+    manifest.source = "none";
+    std::cerr << "[GStreamerCapabilities] ⚠ No GStreamer elements found "
+                 "(gst-inspect-1.0 missing or failed)"
+              << std::endl;
+    return manifest;
+  }
+
+  FILE *version_pipe = popen("gst-inspect-1.0 --gst-version 2>/dev/null", "r");
+  if (version_pipe) {
+    std::array<char, 256> line;
+    if (fgets(line.data(), line.size(), version_pipe)) {
+      manifest.gstreamer_version = trim(line.data());
+    }
+    pclose(version_pipe);
+  }
+  return manifest;
+}
+
+GStreamerCapabilities::Manifest
+GStreamerCapabilities::parseGstInspect(const std::string &output) {
+  // Element lines look like "libav:  avdec_h264: libav H.264 ... decoder".
+  // Type finders ("typefindfunctions: video/x-h264: h264, x264") and tracers
+  // ("coretracers:  latency (GstTracerFactory)") are not elements.
+  Manifest manifest;
+  manifest.source = "gst-inspect";
+  std::istringstream in(output);
+  std::string line;
+  while (std::getline(in, line)) {
+    size_t plugin_end = line.find(": ");
+    if (plugin_end == std::string::npos) {
+      continue;
+    }
+    std::string plugin = trim(line.substr(0, plugin_end));
+    std::string rest = line.substr(plugin_end + 2);
+    size_t name_end = rest.find(": ");
+    if (name_end == std::string::npos) {
+      continue;
+    }
+    std::string name = trim(rest.substr(0, name_end));
+    if (plugin.empty() || name.empty() ||
+        plugin.find(' ') != std::string::npos ||
+        name.find_first_of(" /") != std::string::npos) {
+      continue;
+    }
+    if (plugin == "typefindfunctions") {
+      continue;
+    }
+
+    Element element;
+    element.name = name;
+    element.plugin = plugin;
+    classify(element, trim(rest.substr(name_end + 2)));
+    manifest.plugins.insert(plugin);
+    manifest.elements[name] = std::move(element);
+  }
+  return manifest;
+}
+
+void GStreamerCapabilities::classify(Element &element,
+                                     const std::string &description) {
+  if (!element.klass.empty()) {
+    bool codec = element.klass.find("Codec") != std::string::npos;
+    element.decoder =
+        codec && element.klass.find("Decoder") != std::string::npos;
+    element.encoder =
+        codec && element.klass.find("Encoder") != std::string::npos;
+    element.hardware = element.klass.find("Hardware") != std::string::npos;
+  } else {
+    // gst-inspect listing has no class: go by name and description
+    std::string lower = toLower(description);
+    element.decoder = endsWith(element.name, "dec") ||
+                      lower.find("decoder") != std::string::npos;
+    element.encoder = endsWith(element.name, "enc") ||
+                      lower.find("encoder") != std::string::npos;
+    element.hardware = false;
+  }
+  if ((element.decoder || element.encoder) && !element.hardware) {
+    element.hardware = hasHardwarePrefix(element.name);
+  }
+}
+
+GStreamerCapabilities::CacheKey GStreamerCapabilities::currentKey() {
+  CacheKey key;
+  key.registry_path = registryPath();
+  key.registry_mtime = fileMtime(key.registry_path);
+  // Variables that change which plugins the registry is built from
+  static const std::array<const char *, 4> variables = {
+      "GST_PLUGIN_PATH", "GST_PLUGIN_PATH_1_0", "GST_PLUGIN_SYSTEM_PATH",
+      "GST_PLUGIN_SYSTEM_PATH_1_0"};
+  for (const char *variable : variables) {
+    const char *value = std::getenv(variable);
+    if (value) {
+      key.environment += std::string(variable) + "=" + value + ";";
+    }
+  }
+  return key;
+}
+
+std::string GStreamerCapabilities::manifestPath() {
+  std::string path = EnvConfig::getString("EDGE_AI_GST_MANIFEST");
+  if (!path.empty()) {
+    return path;
+  }
+  return EnvConfig::resolveDataDir("CACHE_DIR", "cache") +
+         "/gstreamer_capabilities.json";
+}
+
+std::string GStreamerCapabilities::registryPath() {
+  for (const char *variable : {"GST_REGISTRY_1_0", "GST_REGISTRY"}) {
+    std::string path = EnvConfig::getString(variable);
+    if (!path.empty()) {
+      return path;
+    }
+  }
+
+  // Same location as g_get_user_cache_dir()/gstreamer-1.0/registry.<cpu>.bin
+  std::string cache_dir = EnvConfig::getString("XDG_CACHE_HOME");
+  if (cache_dir.empty()) {
+    std::string home = EnvConfig::getString("HOME");
+    if (home.empty()) {
+      return "";
+    }
+    cache_dir = home + "/.cache";
+  }
+  std::string dir = cache_dir + "/gstreamer-1.0";
+
+  struct utsname name;
+  std::string machine = uname(&name) == 0 ? name.machine : "unknown";
+  std::string path = dir + "/registry." + machine + ".bin";
+  if (fs::exists(path)) {
+    return path;
+  }
+  // GStreamer names the file after its build CPU, which does not always
+  // match uname (e.g. "arm" vs "armv7l")
+  std::error_code ec;
+  for (const auto &entry : fs::directory_iterator(dir, ec)) {
+    std::string file = entry.path().filename().string();
+    if (file.rfind("registry.", 0) == 0 && endsWith(file, ".bin")) {
+      return entry.path().string();
+    }
+  }
+  return path;
+}
+
+Json::Value GStreamerCapabilities::toJson(const Manifest &manifest) {
+  Json::Value json(Json::objectValue);
+  json["version"] = manifest.version;
+  json["source"] = manifest.source;
+  json["gstreamerVersion"] = manifest.gstreamer_version;
+  json["createdAt"] = static_cast<Json::Int64>(manifest.created_at);
+  json["registry"]["path"] = manifest.key.registry_path;
+  json["registry"]["mtime"] =
+      static_cast<Json::Int64>(manifest.key.registry_mtime);
+  json["registry"]["environment"] = manifest.key.environment;
+
+  Json::Value plugins(Json::arrayValue);
+  for (const auto &plugin : manifest.plugins) {
+    plugins.append(plugin);
+  }
+  json["plugins"] = plugins;
+
+  // Derived lists are written for people reading the file; fromJson()
+  // rebuilds them from the element entries
+  Json::Value elements(Json::objectValue);
+  Json::Value decoders(Json::arrayValue);
+  Json::Value encoders(Json::arrayValue);
+  Json::Value hardware(Json::arrayValue);
+  for (const auto &[name, element] : manifest.elements) {
+    Json::Value entry(Json::objectValue);
+    entry["plugin"] = element.plugin;
+    if (!element.klass.empty()) {
+      entry["klass"] = element.klass;
+    }
+    entry["rank"] = element.rank;
+    entry["decoder"] = element.decoder;
+    entry["encoder"] = element.encoder;
+    entry["hardware"] = element.hardware;
+    elements[name] = entry;
+    if (element.decoder) {
+      decoders.append(name);
+    }
+    if (element.encoder) {
+      encoders.append(name);
+    }
+    if (element.hardware) {
+      hardware.append(name);
+    }
+  }
+  json["elements"] = elements;
+  json["decoders"] = decoders;
+  json["encoders"] = encoders;
+  json["hardware"] = hardware;
+  return json;
+}
+
+std::optional<GStreamerCapabilities::Manifest>
+GStreamerCapabilities::fromJson(const Json::Value &json) {
+  if (!json.isObject() || !json["elements"].isObject() ||
+      !json["registry"].isObject()) {
+    return std::nullopt;
+  }
+  Manifest manifest;
+  manifest.version = json.get("version", 0).asInt();
+  manifest.source = json.get("source", "").asString();
+  manifest.gstreamer_version = json.get("gstreamerVersion", "").asString();
+  manifest.created_at = json.get("createdAt", 0).asInt64();
+  const Json::Value &registry = json["registry"];
+  manifest.key.registry_path = registry.get("path", "").asString();
+  manifest.key.registry_mtime = registry.get("mtime", -1).asInt64();
+  manifest.key.environment = registry.get("environment", "").asString();
+
+  for (const auto &plugin : json["plugins"]) {
+    manifest.plugins.insert(plugin.asString());
+  }
+  const Json::Value &elements = json["elements"];
+  for (const auto &name : elements.getMemberNames()) {
+    const Json::Value &entry = elements[name];
+    Element element;
+    element.name = name;
+    element.plugin = entry.get("plugin", "").asString();
+    element.klass = entry.get("klass", "").asString();
+    element.rank = entry.get("rank", 0).asUInt();
+    element.decoder = entry.get("decoder", false).asBool();
+    element.encoder = entry.get("encoder", false).asBool();
+    element.hardware = entry.get("hardware", false).asBool();
+    manifest.elements[name] = std::move(element);
+  }
+  return manifest;
+}
+
+std::optional<GStreamerCapabilities::Manifest>
+GStreamerCapabilities::loadManifest(const std::string &path,
+                                    const CacheKey &key) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    return std::nullopt;
+  }
+  Json::CharReaderBuilder builder;
+  Json::Value json;
+  std::string errors;
+  if (!Json::parseFromStream(builder, file, &json, &errors)) {
+    std::cerr << "[GStreamerCapabilities] Ignoring unreadable manifest "
+              << path << ": " << errors << std::endl;
+    return std::nullopt;
+  }
+  auto manifest = fromJson(json);
+  if (!manifest || manifest->version != MANIFEST_VERSION ||
+      !(manifest->key == key)) {
+    return std::nullopt;
+  }
+  return manifest;
+}
+
+bool GStreamerCapabilities::saveManifest(const std::string &path,
+                                         const Manifest &manifest) {
+  try {
+    fs::path target(path);
+    if (target.has_parent_path()) {
+      fs::create_directories(target.parent_path());
+    }
+    // API server and workers may probe at the same time: write a private
+    // file and rename it over the manifest so readers never see half of one
+    std::string temp = path + ".tmp." + std::to_string(getpid());
+    {
+      std::ofstream file(temp, std::ios::trunc);
+      if (!file.is_open()) {
+        std::cerr << "[GStreamerCapabilities] ⚠ Cannot write " << temp
+                  << std::endl;
+        return false;
+      }
+      Json::StreamWriterBuilder writer;
+      writer["indentation"] = "  ";
+      file << Json::writeString(writer, toJson(manifest)) << std::endl;
+      if (!file.good()) {
+        file.close();
+        fs::remove(temp);
+        return false;
+      }
+    }
+    fs::rename(temp, target);
+    return true;
+  } catch (const std::exception &e) {
+    std::cerr << "[GStreamerCapabilities] ⚠ Cannot save manifest " << path
+              << ": " << e.what() << std::endl;
+    return false;
+  }
+}
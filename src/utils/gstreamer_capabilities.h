@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstdint>
+#include <json/json.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * @brief GStreamer capability manifest
+ *
+ * Lists the elements (with plugin, class and rank) and plugins known to the
+ * local GStreamer registry, plus the decoders, encoders and hardware elements
+ * among them. Built once per registry state and cached on disk
+ * (EDGE_AI_GST_MANIFEST, default <CACHE_DIR>/gstreamer_capabilities.json):
+ * the cache is valid while the manifest version, the registry file path and
+ * mtime and the GStreamer plugin path variables are unchanged, so the API
+ * server and every worker skip probing after the first boot.
+ *
+ * Probing queries the registry in-process when built with GStreamer headers
+ * (EDGE_AI_GST_PROBE); otherwise a single `gst-inspect-1.0` listing is
+ * parsed instead of one process per element.
+ */
+class GStreamerCapabilities {
+public:
+  static constexpr int MANIFEST_VERSION = 1;
+
+  struct Element {
+    std::string name;
+    std::string plugin;
+    std::string klass; // e.g. "Codec/Decoder/Video/Hardware"
+    unsigned int rank = 0;
+    bool decoder = false;
+    bool encoder = false;
+    bool hardware = false;
+  };
+
+  /**
+   * @brief What the cached manifest must match to be reused
+   */
+  struct CacheKey {
+    std::string registry_path;
+    int64_t registry_mtime = -1; // -1 = registry file missing
+    std::string environment;     // GST_PLUGIN_PATH etc.
+
+    bool operator==(const CacheKey &other) const {
+      return registry_path == other.registry_path &&
+             registry_mtime == other.registry_mtime &&
+             environment == other.environment;
+    }
+  };
+
+  struct Manifest {
+    int version = MANIFEST_VERSION;
+    std::string source; // "registry", "gst-inspect" or "none"
+    std::string gstreamer_version;
+    CacheKey key;
+    int64_t created_at = 0; // Unix time
+    std::map<std::string, Element> elements;
+    std::set<std::string> plugins;
+
+    bool empty() const { return elements.empty() && plugins.empty(); }
+  };
+
+  static GStreamerCapabilities &getInstance() {
+    static GStreamerCapabilities instance;
+    return instance;
+  }
+
+  /**
+   * @brief Manifest for this process: cached file if still valid, otherwise
+   * probed and written back. Loaded once; thread-safe.
+   */
+  std::shared_ptr<const Manifest> get();
+
+  /**
+   * @brief Probe again and rewrite the cache (e.g. after installing plugins)
+   */
+  std::shared_ptr<const Manifest> refresh();
+
+  /**
+   * @brief True if an element or a plugin with this name exists
+   */
+  bool has(const std::string &name);
+
+  /**
+   * @brief Registry rank of an element, or -1 if unknown/missing
+   */
+  int rank(const std::string &element);
+
+  /**
+   * @brief False when probing found no GStreamer at all (callers should not
+   * treat every element as missing then)
+   */
+  bool isKnown();
+
+  static CacheKey currentKey();
+  static std::string manifestPath();
+  static std::string registryPath();
+
+  static Json::Value toJson(const Manifest &manifest);
+  static std::optional<Manifest> fromJson(const Json::Value &json);
+
+  /**
+   * @brief Read a cached manifest; empty if missing, unreadable, from another
+   * manifest version or for another registry state
+   */
+  static std::optional<Manifest> loadManifest(const std::string &path,
+                                              const CacheKey &key);
+  static bool saveManifest(const std::string &path, const Manifest &manifest);
+
+  /**
+   * @brief Parse the element listing of `gst-inspect-1.0` (no arguments)
+   */
+  static Manifest parseGstInspect(const std::string &output);
+
+  /**
+   * @brief Fill decoder/encoder/hardware from the class and name
+   */
+  static void classify(Element &element, const std::string &description = "");
+
+private:
+  GStreamerCapabilities() = default;
+  GStreamerCapabilities(const GStreamerCapabilities &) = delete;
+  GStreamerCapabilities &operator=(const GStreamerCapabilities &) = delete;
+
+  std::shared_ptr<const Manifest> loadOrProbe(bool force);
+  static Manifest probe();
+  static std::optional<Manifest> probeRegistry();
+  static Manifest probeGstInspect();
+
+  std::mutex mutex_;
+  std::shared_ptr<const Manifest> manifest_;
+};
@@ -1,6 +1,6 @@
 #include "gstreamer_checker.h"
+#include "gstreamer_capabilities.h"
 #include <algorithm>
-#include <cstdlib>
 #include <iostream>
 #include <set>
 #include <sstream>
@@ -8,9 +8,8 @@
 namespace GStreamerChecker {
 
 bool checkPlugin(const std::string &pluginName) {
-  std::string command = "gst-inspect-1.0 " + pluginName + " >/dev/null 2>&1";
-  int status = std::system(command.c_str());
-  return status == 0;
+  // Element or plugin name, answered from the cached capability manifest
+  return GStreamerCapabilities::getInstance().has(pluginName);
 }
 
 std::map<std::string, PluginInfo> checkRequiredPlugins() {
@@ -0,0 +1,104 @@
+#include "utils/image_header.h"
+#include <algorithm>
+
+namespace ImageHeader {
+
+namespace {
+
+uint32_t readBE16(const unsigned char *p) {
+  return (static_cast<uint32_t>(p[0]) << 8) | p[1];
+}
+
+uint32_t readBE32(const unsigned char *p) {
+  return (readBE16(p) << 16) | readBE16(p + 2);
+}
+
+Info probeJpeg(const unsigned char *data, size_t size) {
+  Info info;
+  size_t pos = 2; // After SOI
+  while (pos + 4 <= size) {
+    if (data[pos] != 0xFF) {
+      return info; // Lost marker sync
+    }
+    unsigned char marker = data[pos + 1];
+    if (marker == 0xFF) {
+      ++pos; // Fill byte
+      continue;
+    }
+    // Standalone markers carry no length
+    if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7)) {
+      pos += 2;
+      continue;
+    }
+    if (marker == 0xD9 || marker == 0xDA) {
+      return info; // EOI or start of scan before any frame header
+    }
+    size_t length = readBE16(data + pos + 2);
+    if (length < 2) {
+      return info;
+    }
+    // SOF0..SOF15, excluding DHT (C4), JPG (C8) and DAC (CC)
+    bool sof = marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 &&
+               marker != 0xC8 && marker != 0xCC;
+    if (sof) {
+      // length(2) precision(1) height(2) width(2)
+      if (length < 7 || pos + 9 > size) {
+        return info;
+      }
+      info.format = Format::Jpeg;
+      info.height = static_cast<int>(readBE16(data + pos + 5));
+      info.width = static_cast<int>(readBE16(data + pos + 7));
+      return info;
+    }
+    pos += 2 + length;
+  }
+  return info;
+}
+
+Info probePng(const unsigned char *data, size_t size) {
+  Info info;
+  // Signature(8) length(4) "IHDR"(4) width(4) height(4)
+  if (size < 24 || data[12] != 'I' || data[13] != 'H' || data[14] != 'D' ||
+      data[15] != 'R') {
+    return info;
+  }
+  uint32_t width = readBE32(data + 16);
+  uint32_t height = readBE32(data + 20);
+  if (width == 0 || height == 0 || width > 0x7FFFFFFF ||
+      height > 0x7FFFFFFF) {
+    return info;
+  }
+  info.format = Format::Png;
+  info.width = static_cast<int>(width);
+  info.height = static_cast<int>(height);
+  return info;
+}
+
+} // namespace
+
+Info probe(const unsigned char *data, size_t size) {
+  static const unsigned char kPngSignature[8] = {0x89, 'P',  'N',  'G',
+                                                 0x0D, 0x0A, 0x1A, 0x0A};
+  if (size >= 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF) {
+    return probeJpeg(data, size);
+  }
+  if (size >= 8 && std::equal(kPngSignature, kPngSignature + 8, data)) {
+    return probePng(data, size);
+  }
+  return Info();
+}
+
+int reducedScale(int width, int height, int minLongSide) {
+  if (minLongSide <= 0) {
+    return 1;
+  }
+  int longSide = std::max(width, height);
+  for (int scale : {8, 4, 2}) {
+    if (longSide / scale >= minLongSide) {
+      return scale;
+    }
+  }
+  return 1;
+}
+
+} // namespace ImageHeader
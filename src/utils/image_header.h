@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Image dimensions from the encoded header, without decoding pixels
+ *
+ * Lets callers size a decode before paying for it: recognition picks a
+ * reduced JPEG DCT scale (cv::IMREAD_REDUCED_COLOR_2/4/8) so detection does
+ * not run on a fully decoded 12 MP upload.
+ */
+namespace ImageHeader {
+
+enum class Format { Unknown, Jpeg, Png };
+
+struct Info {
+  Format format = Format::Unknown;
+  int width = 0;
+  int height = 0;
+
+  bool valid() const { return width > 0 && height > 0; }
+};
+
+/**
+ * @brief Read format and size from a JPEG (SOFn segment) or PNG (IHDR)
+ * header. Returns an invalid Info for other formats or truncated headers.
+ */
+Info probe(const unsigned char *data, size_t size);
+inline Info probe(const std::vector<unsigned char> &data) {
+  return probe(data.data(), data.size());
+}
+
+/**
+ * @brief Largest power-of-two reduction (1, 2, 4 or 8) that keeps the long
+ * side of a width x height image at or above minLongSide
+ *
+ * minLongSide <= 0 disables reduction (always 1).
+ */
+int reducedScale(int width, int height, int minLongSide);
+
+} // namespace ImageHeader
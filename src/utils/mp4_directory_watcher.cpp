@@ -1,4 +1,5 @@
 #include "utils/mp4_directory_watcher.h"
+#include "utils/mp4_finalize_queue.h"
 #include "utils/mp4_finalizer.h"
 #include <iostream>
 #include <chrono>
@@ -17,7 +18,8 @@ namespace MP4Finalizer {
 
 MP4DirectoryWatcher::MP4DirectoryWatcher(const std::string &watchDirectory)
     : watchDirectory_(watchDirectory), running_(false), shouldStop_(false),
-      inotifyFd_(-1), watchDescriptor_(-1) {
+      processed_(std::make_shared<ProcessedFiles>()), inotifyFd_(-1),
+      watchDescriptor_(-1) {
   // Ensure directory exists
   if (!fs::exists(watchDirectory_)) {
     fs::create_directories(watchDirectory_);
@@ -63,92 +65,36 @@ void MP4DirectoryWatcher::stop() {
             << watchDirectory_ << std::endl;
 }
 
-bool MP4DirectoryWatcher::isFileStable(const std::string &filePath) {
-  if (!fs::exists(filePath)) {
-    return false;
-  }
-
-  // Check if file is being written to
-  if (MP4Finalizer::MP4Finalizer::isFileBeingWritten(filePath)) {
-    return false;
-  }
-
-  // Check file size stability
-  uintmax_t prevSize = fs::file_size(filePath);
-  std::this_thread::sleep_for(std::chrono::milliseconds(500));
-  
-  if (!fs::exists(filePath)) {
-    return false;
-  }
-
-  uintmax_t currSize = fs::file_size(filePath);
-  if (currSize != prevSize) {
-    return false;
-  }
-
-  // Wait a bit more to be sure
-  std::this_thread::sleep_for(std::chrono::milliseconds(500));
-  if (!fs::exists(filePath)) {
-    return false;
-  }
-
-  currSize = fs::file_size(filePath);
-  return (currSize == prevSize);
-}
-
 void MP4DirectoryWatcher::processNewFile(const std::string &filePath) {
   // Check if already processed
   {
-    std::lock_guard<std::mutex> lock(processedFilesMutex_);
-    if (processedFiles_.find(filePath) != processedFiles_.end()) {
+    std::lock_guard<std::mutex> lock(processed_->mutex);
+    if (!processed_->files.insert(filePath).second) {
       return; // Already processed
     }
   }
 
-  // Wait for file to stabilize (file_des_node may still be writing)
-  // But don't wait too long - we want to convert as soon as possible
-  int retries = 0;
-  const int maxRetries = 10; // Wait up to 5 seconds (10 * 500ms)
-  
-  while (retries < maxRetries && !shouldStop_) {
-    if (isFileStable(filePath)) {
-      break;
-    }
-    std::this_thread::sleep_for(std::chrono::milliseconds(500));
-    retries++;
-  }
-
-  if (shouldStop_ || !fs::exists(filePath)) {
-    return;
-  }
-
-  // Even if file is not completely stable, try to process it
-  // This allows conversion to happen during recording
-  // The conversion process will handle partial files gracefully
-
-  // Mark as processed
-  {
-    std::lock_guard<std::mutex> lock(processedFilesMutex_);
-    processedFiles_.insert(filePath);
-  }
-
-  std::cerr << "[MP4DirectoryWatcher] Processing file: " << filePath
-            << std::endl;
-
-  // Finalize and convert file (overwrite original)
-  // This will:
-  // 1. Try faststart first (if file is complete)
-  // 2. If file needs conversion, convert and overwrite original
-  // Note: If file is still being written, conversion may fail, but we'll retry
-  // when file is closed (IN_CLOSE_WRITE event)
-  if (MP4Finalizer::MP4Finalizer::finalizeFile(filePath, true)) {
-    std::cerr << "[MP4DirectoryWatcher] ✓ File converted successfully: "
+  // Finalize and convert file (overwrite original) on the shared finalize
+  // queue, which waits for the file to stabilize, moves moov to the front in
+  // process and converts to a compatible format if needed. Bounded workers
+  // keep bursts of closed recordings from spawning a thread (and ffmpeg) per
+  // file. A failed finalization forgets the file so the next close or move
+  // of it is retried.
+  auto forget = [processed = processed_, filePath]() {
+    std::lock_guard<std::mutex> lock(processed->mutex);
+    processed->files.erase(filePath);
+  };
+  if (MP4FinalizeQueue::getInstance().submit(
+          filePath, true, [forget](bool success) {
+            if (!success) {
+              forget();
+            }
+          })) {
+    std::cerr << "[MP4DirectoryWatcher] Queued file for finalizing: "
               << filePath << std::endl;
   } else {
-    // Conversion failed, likely because file is still being written
-    // Remove from processed list so we can retry when file is closed
-    std::lock_guard<std::mutex> lock(processedFilesMutex_);
-    processedFiles_.erase(filePath);
+    // Queue full: allow a retry on the next event for this file
+    forget();
   }
 }
 
@@ -229,9 +175,7 @@ void MP4DirectoryWatcher::watchLoopInotify() {
             // Check if file is being created or closed
             if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
               // File was closed after writing or moved to directory
-              // Process it in background
-              std::thread([this, filePath]() { processNewFile(filePath); })
-                  .detach();
+              processNewFile(filePath);
             } else if (event->mask & IN_CREATE) {
               // File created, but may still be written to
               // We'll process it when it's closed (IN_CLOSE_WRITE)
@@ -246,7 +190,12 @@ void MP4DirectoryWatcher::watchLoopInotify() {
 }
 
 void MP4DirectoryWatcher::watchLoopPolling() {
-  std::set<std::string> lastFiles;
+  // Size seen on the previous scan, and size when last queued. A file is
+  // queued once its size held across a scan and no process has it open for
+  // writing, so workers never wait on recordings in progress; a failed file
+  // is only retried after it changes.
+  std::map<std::string, uintmax_t> lastSizes;
+  std::map<std::string, uintmax_t> queuedSizes;
 
   while (!shouldStop_) {
     try {
@@ -255,24 +204,39 @@ void MP4DirectoryWatcher::watchLoopPolling() {
         continue;
       }
 
-      std::set<std::string> currentFiles;
+      std::map<std::string, uintmax_t> currentSizes;
 
       // Scan directory for MP4 files
       for (const auto &entry : fs::directory_iterator(watchDirectory_)) {
         if (entry.is_regular_file() && entry.path().extension() == ".mp4") {
           std::string filePath = entry.path().string();
-          currentFiles.insert(filePath);
+          uintmax_t size = entry.file_size();
+          currentSizes[filePath] = size;
 
-          // Check if this is a new file
-          if (lastFiles.find(filePath) == lastFiles.end()) {
-            // New file detected, process it in background
-            std::thread([this, filePath]() { processNewFile(filePath); })
-                .detach();
+          auto last = lastSizes.find(filePath);
+          if (last == lastSizes.end() || last->second != size) {
+            continue; // New or still growing, check again next scan
+          }
+          auto queued = queuedSizes.find(filePath);
+          if (queued != queuedSizes.end() && queued->second == size) {
+            continue; // Already queued at this size
           }
+          if (MP4Finalizer::isFileBeingWritten(filePath)) {
+            continue;
+          }
+          queuedSizes[filePath] = size;
+          processNewFile(filePath);
         }
       }
 
-      lastFiles = currentFiles;
+      lastSizes.swap(currentSizes);
+      for (auto it = queuedSizes.begin(); it != queuedSizes.end();) {
+        if (lastSizes.count(it->first)) {
+          ++it;
+        } else {
+          it = queuedSizes.erase(it); // File removed
+        }
+      }
 
     } catch (const fs::filesystem_error &e) {
       std::cerr << "[MP4DirectoryWatcher] Error scanning directory: "
@@ -5,6 +5,8 @@
 #include <thread>
 #include <atomic>
 #include <mutex>
+#include <map>
+#include <memory>
 #include <set>
 #include <filesystem>
 
@@ -15,9 +17,9 @@ namespace MP4Finalizer {
 /**
  * @brief Watches a directory for new MP4 files and automatically converts them
  * 
- * This class monitors a directory for new MP4 files. When a file is created
- * and stabilized (not being written anymore), it automatically converts it
- * to a compatible format, overwriting the original file.
+ * This class monitors a directory for new MP4 files. Closed files are
+ * handed to MP4FinalizeQueue, which finalizes them (faststart) and converts
+ * them to a compatible format if needed, overwriting the original file.
  */
 class MP4DirectoryWatcher {
 public:
@@ -44,14 +46,18 @@ private:
   void watchLoopInotify(); // Use inotify for efficient file system monitoring
   void watchLoopPolling(); // Fallback to polling if inotify not available
   void processNewFile(const std::string &filePath);
-  bool isFileStable(const std::string &filePath);
 
   std::string watchDirectory_;
   std::thread watchThread_;
   std::atomic<bool> running_;
   std::atomic<bool> shouldStop_;
-  std::mutex processedFilesMutex_;
-  std::set<std::string> processedFiles_; // Track processed files to avoid duplicates
+  // Track processed files to avoid duplicates. Shared with finalize queue
+  // completions, which may run after the watcher is gone.
+  struct ProcessedFiles {
+    std::mutex mutex;
+    std::set<std::string> files;
+  };
+  std::shared_ptr<ProcessedFiles> processed_;
   int inotifyFd_; // File descriptor for inotify
   int watchDescriptor_; // Watch descriptor for the directory
 };
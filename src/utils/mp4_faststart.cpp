@@ -0,0 +1,524 @@
+#include "utils/mp4_faststart.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <limits>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace MP4Finalizer {
+
+namespace {
+
+// moov holds the sample tables only; a 10-minute 1080p recording has a few MB
+constexpr uint64_t kMaxMoovSize = 256ull * 1024 * 1024;
+constexpr size_t kCopyBufferSize = 1 << 20;
+
+uint32_t readU32(const uint8_t *p) {
+  return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) |
+         (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+uint64_t readU64(const uint8_t *p) {
+  return (uint64_t(readU32(p)) << 32) | readU32(p + 4);
+}
+
+void putU32(std::vector<uint8_t> &out, uint32_t value) {
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    out.push_back(static_cast<uint8_t>(value >> shift));
+  }
+}
+
+void putU64(std::vector<uint8_t> &out, uint64_t value) {
+  putU32(out, static_cast<uint32_t>(value >> 32));
+  putU32(out, static_cast<uint32_t>(value));
+}
+
+void setU32(std::vector<uint8_t> &out, size_t at, uint32_t value) {
+  for (int i = 0; i < 4; ++i) {
+    out[at + i] = static_cast<uint8_t>(value >> (24 - 8 * i));
+  }
+}
+
+struct Box {
+  std::string type;
+  uint64_t offset = 0;
+  uint64_t size = 0;
+  uint32_t header = 8; // 16 with a 64-bit size
+};
+
+class FileDescriptor {
+public:
+  explicit FileDescriptor(int fd) : fd_(fd) {}
+  ~FileDescriptor() {
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+  }
+  FileDescriptor(const FileDescriptor &) = delete;
+  FileDescriptor &operator=(const FileDescriptor &) = delete;
+  int get() const { return fd_; }
+  // Close explicitly to see write-back errors
+  bool close() {
+    int fd = fd_;
+    fd_ = -1;
+    return fd < 0 || ::close(fd) == 0;
+  }
+
+private:
+  int fd_;
+};
+
+bool preadAll(int fd, void *buffer, size_t length, uint64_t offset) {
+  auto *out = static_cast<uint8_t *>(buffer);
+  while (length > 0) {
+    ssize_t n = ::pread(fd, out, length, static_cast<off_t>(offset));
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    out += n;
+    offset += n;
+    length -= n;
+  }
+  return true;
+}
+
+bool writeAll(int fd, const void *buffer, size_t length) {
+  const auto *in = static_cast<const uint8_t *>(buffer);
+  while (length > 0) {
+    ssize_t n = ::write(fd, in, length);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    in += n;
+    length -= n;
+  }
+  return true;
+}
+
+// Copy [offset, offset + length) of in to the current position of out.
+// copy_file_range keeps the data in the kernel (and can share extents on
+// reflink filesystems); plain read/write is the fallback.
+bool copyRange(int in, int out, uint64_t offset, uint64_t length) {
+#ifdef __linux__
+  while (length > 0) {
+    loff_t inOffset = static_cast<loff_t>(offset);
+    ssize_t n = ::copy_file_range(in, &inOffset, out, nullptr, length, 0);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      if (n < 0 && errno != ENOSYS && errno != EXDEV && errno != EINVAL &&
+          errno != EOPNOTSUPP) {
+        return false;
+      }
+      break; // Not supported here: finish with read/write
+    }
+    offset += n;
+    length -= n;
+  }
+#endif
+  std::vector<uint8_t> buffer(std::min<uint64_t>(length, kCopyBufferSize));
+  while (length > 0) {
+    size_t chunk =
+        static_cast<size_t>(std::min<uint64_t>(length, buffer.size()));
+    if (!preadAll(in, buffer.data(), chunk, offset) ||
+        !writeAll(out, buffer.data(), chunk)) {
+      return false;
+    }
+    offset += chunk;
+    length -= chunk;
+  }
+  return true;
+}
+
+bool scanBoxes(int fd, uint64_t fileSize, std::vector<Box> &boxes,
+               std::string &error) {
+  uint64_t offset = 0;
+  while (offset < fileSize) {
+    uint8_t header[16];
+    if (fileSize - offset < 8 || !preadAll(fd, header, 8, offset)) {
+      error = "truncated box header at offset " + std::to_string(offset);
+      return false;
+    }
+    Box box;
+    box.type.assign(reinterpret_cast<const char *>(header + 4), 4);
+    box.offset = offset;
+    box.size = readU32(header);
+    if (box.size == 1) {
+      if (fileSize - offset < 16 || !preadAll(fd, header + 8, 8, offset + 8)) {
+        error = "truncated box header at offset " + std::to_string(offset);
+        return false;
+      }
+      box.size = readU64(header + 8);
+      box.header = 16;
+    } else if (box.size == 0) {
+      box.size = fileSize - offset; // Box extends to end of file
+    }
+    if (box.size < box.header || box.size > fileSize - offset) {
+      error = "box '" + box.type + "' at offset " + std::to_string(offset) +
+              " runs past end of file (recording incomplete?)";
+      return false;
+    }
+    boxes.push_back(box);
+    offset += box.size;
+  }
+  return true;
+}
+
+// State for rewriting one moov box
+struct MoovRewrite {
+  // Where moov goes (first mdat) and where it was
+  uint64_t insert_at = std::numeric_limits<uint64_t>::max();
+  uint64_t moov_offset = 0;
+  uint64_t old_size = 0;
+  uint64_t new_size = 0;
+  bool upgrade_co64 = false; // Write stco tables as co64
+  bool overflow = false;     // Some shifted stco offset needs 64 bits
+  std::string error;
+  std::string video_codec;
+  int h264_profile = -1;
+
+  bool mapOffset(uint64_t in, uint64_t &out) const {
+    if (in < insert_at) {
+      out = in;
+    } else if (in < moov_offset) {
+      out = in + new_size;
+    } else if (in >= moov_offset + old_size) {
+      out = in - old_size + new_size;
+    } else {
+      return false; // Points into moov itself
+    }
+    return true;
+  }
+};
+
+bool isContainer(const std::string &type) {
+  return type == "moov" || type == "trak" || type == "mdia" ||
+         type == "minf" || type == "stbl";
+}
+
+bool isVideoSampleEntry(const std::string &type) {
+  return type == "avc1" || type == "avc3" || type == "hvc1" ||
+         type == "hev1" || type == "av01" || type == "vp09" || type == "mp4v";
+}
+
+// Record the codec (and H.264 profile) of the first video sample entry
+void inspectStsd(const uint8_t *payload, size_t size, MoovRewrite &ctx) {
+  if (!ctx.video_codec.empty() || size < 16) {
+    return;
+  }
+  const uint8_t *entry = payload + 8; // version/flags, entry_count
+  uint32_t entrySize = readU32(entry);
+  std::string type(reinterpret_cast<const char *>(entry + 4), 4);
+  if (!isVideoSampleEntry(type) || entrySize > size - 8) {
+    return;
+  }
+  ctx.video_codec = type;
+  if (type != "avc1" && type != "avc3") {
+    return;
+  }
+  // Child boxes follow the 78-byte VisualSampleEntry fields
+  size_t at = 8 + 78;
+  while (at + 8 <= entrySize) {
+    uint32_t childSize = readU32(entry + at);
+    if (childSize < 8 || childSize > entrySize - at) {
+      return;
+    }
+    if (std::memcmp(entry + at + 4, "avcC", 4) == 0 && childSize >= 10) {
+      ctx.h264_profile = entry[at + 9]; // AVCProfileIndication
+      return;
+    }
+    at += childSize;
+  }
+}
+
+bool rewriteChunkOffsets(const std::string &type, const uint8_t *payload,
+                         size_t size, MoovRewrite &ctx,
+                         std::vector<uint8_t> &out) {
+  bool wide = type == "co64";
+  size_t entryBytes = wide ? 8 : 4;
+  if (size < 8) {
+    ctx.error = type + " box too short";
+    return false;
+  }
+  uint32_t count = readU32(payload + 4);
+  if ((size - 8) / entryBytes < count) {
+    ctx.error = type + " box shorter than its entry count";
+    return false;
+  }
+  bool writeWide = wide || ctx.upgrade_co64;
+  uint64_t boxSize = 16 + uint64_t(count) * (writeWide ? 8 : 4);
+  if (boxSize > std::numeric_limits<uint32_t>::max()) {
+    ctx.error = type + " box too large";
+    return false;
+  }
+  putU32(out, static_cast<uint32_t>(boxSize));
+  const char *name = writeWide ? "co64" : "stco";
+  out.insert(out.end(), name, name + 4);
+  out.insert(out.end(), payload, payload + 4); // version/flags
+  putU32(out, count);
+
+  const uint8_t *entries = payload + 8;
+  for (uint32_t i = 0; i < count; ++i) {
+    uint64_t offset =
+        wide ? readU64(entries + i * 8) : readU32(entries + i * 4);
+    uint64_t mapped = 0;
+    if (!ctx.mapOffset(offset, mapped)) {
+      ctx.error =
+          "chunk offset " + std::to_string(offset) + " points into moov";
+      return false;
+    }
+    if (writeWide) {
+      putU64(out, mapped);
+    } else {
+      if (mapped > std::numeric_limits<uint32_t>::max()) {
+        ctx.overflow = true;
+      }
+      putU32(out, static_cast<uint32_t>(mapped));
+    }
+  }
+  return true;
+}
+
+// Rewrite a sequence of boxes, descending into the sample table path
+bool rewriteBoxes(const uint8_t *data, size_t size, MoovRewrite &ctx,
+                  std::vector<uint8_t> &out) {
+  size_t at = 0;
+  while (at < size) {
+    if (size - at < 8) {
+      ctx.error = "truncated box inside moov";
+      return false;
+    }
+    uint64_t boxSize = readU32(data + at);
+    size_t header = 8;
+    std::string type(reinterpret_cast<const char *>(data + at + 4), 4);
+    if (boxSize == 1) {
+      if (size - at < 16) {
+        ctx.error = "truncated box inside moov";
+        return false;
+      }
+      boxSize = readU64(data + at + 8);
+      header = 16;
+    } else if (boxSize == 0) {
+      boxSize = size - at;
+    }
+    if (boxSize < header || boxSize > size - at) {
+      ctx.error = "box '" + type + "' inside moov is corrupt";
+      return false;
+    }
+    const uint8_t *payload = data + at + header;
+    size_t payloadSize = static_cast<size_t>(boxSize) - header;
+
+    if (type == "cmov") {
+      ctx.error = "compressed moov is not supported";
+      return false;
+    }
+    if (type == "stco" || type == "co64") {
+      if (!rewriteChunkOffsets(type, payload, payloadSize, ctx, out)) {
+        return false;
+      }
+    } else if (isContainer(type)) {
+      size_t start = out.size();
+      out.insert(out.end(), data + at, data + at + header);
+      if (!rewriteBoxes(payload, payloadSize, ctx, out)) {
+        return false;
+      }
+      uint64_t newSize = out.size() - start;
+      if (header == 16) {
+        setU32(out, start + 8, static_cast<uint32_t>(newSize >> 32));
+        setU32(out, start + 12, static_cast<uint32_t>(newSize));
+      } else if (newSize > std::numeric_limits<uint32_t>::max()) {
+        ctx.error = "box '" + type + "' too large";
+        return false;
+      } else {
+        setU32(out, start, static_cast<uint32_t>(newSize));
+      }
+    } else {
+      if (type == "stsd") {
+        inspectStsd(payload, payloadSize, ctx);
+      }
+      out.insert(out.end(), data + at, data + at + boxSize);
+    }
+    at += static_cast<size_t>(boxSize);
+  }
+  return true;
+}
+
+MP4Faststart::Result process(const std::string &inputPath,
+                             const std::string *outputPath) {
+  using Status = MP4Faststart::Status;
+  MP4Faststart::Result result;
+
+  FileDescriptor in(::open(inputPath.c_str(), O_RDONLY | O_CLOEXEC));
+  struct stat st;
+  if (in.get() < 0 || ::fstat(in.get(), &st) != 0) {
+    result.error = "cannot open " + inputPath + ": " + std::strerror(errno);
+    return result;
+  }
+  result.file_size = static_cast<uint64_t>(st.st_size);
+
+  std::vector<Box> boxes;
+  if (!scanBoxes(in.get(), result.file_size, boxes, result.error)) {
+    result.status = Status::Invalid;
+    return result;
+  }
+  const Box *moov = nullptr;
+  const Box *mdat = nullptr;
+  bool fragmented = false;
+  for (const auto &box : boxes) {
+    if (box.type == "moov" && !moov) {
+      moov = &box;
+    } else if (box.type == "mdat" && !mdat) {
+      mdat = &box;
+    } else if (box.type == "moof") {
+      fragmented = true;
+    }
+  }
+  if (!moov) {
+    result.status = fragmented ? Status::Fragmented : Status::Invalid;
+    if (!fragmented) {
+      result.error = "no moov box (recording incomplete?)";
+    }
+    return result;
+  }
+  if (moov->size > kMaxMoovSize) {
+    result.status = Status::Invalid;
+    result.error = "moov box too large (" + std::to_string(moov->size) + ")";
+    return result;
+  }
+
+  std::vector<uint8_t> original(static_cast<size_t>(moov->size));
+  if (!preadAll(in.get(), original.data(), original.size(), moov->offset)) {
+    result.error = "cannot read moov: " + std::string(std::strerror(errno));
+    return result;
+  }
+
+  bool needsMove = mdat && !fragmented && moov->offset > mdat->offset;
+  MoovRewrite ctx;
+  ctx.moov_offset = moov->offset;
+  ctx.old_size = moov->size;
+  ctx.new_size = moov->size;
+  if (needsMove && outputPath) {
+    ctx.insert_at = mdat->offset;
+  }
+
+  // The new moov size depends on whether stco tables grow to co64, and the
+  // shifted offsets depend on the new size: iterate until both agree
+  std::vector<uint8_t> moovOut;
+  for (int pass = 0; pass < 4; ++pass) {
+    moovOut.clear();
+    ctx.overflow = false;
+    if (!rewriteBoxes(original.data(), original.size(), ctx, moovOut)) {
+      result.status = Status::Invalid;
+      result.error = ctx.error;
+      return result;
+    }
+    if (ctx.overflow && !ctx.upgrade_co64) {
+      ctx.upgrade_co64 = true;
+      continue;
+    }
+    if (moovOut.size() == ctx.new_size) {
+      break;
+    }
+    ctx.new_size = moovOut.size();
+  }
+  result.video_codec = ctx.video_codec;
+  result.h264_profile = ctx.h264_profile;
+
+  if (fragmented) {
+    result.status = Status::Fragmented;
+    return result;
+  }
+  if (!needsMove) {
+    result.status = Status::AlreadyFaststart;
+    return result;
+  }
+  if (!outputPath) {
+    result.status = Status::NotFaststart;
+    return result;
+  }
+  if (moovOut.size() != ctx.new_size || ctx.overflow) {
+    result.status = Status::Invalid;
+    result.error = "chunk offsets did not converge";
+    return result;
+  }
+
+  FileDescriptor out(::open(outputPath->c_str(),
+                            O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                            st.st_mode & 0777));
+  if (out.get() < 0) {
+    result.error = "cannot create " + *outputPath + ": " + std::strerror(errno);
+    return result;
+  }
+  // [boxes before mdat] [moov] [mdat ... up to old moov] [boxes after moov]
+  uint64_t moovEnd = moov->offset + moov->size;
+  bool written =
+      copyRange(in.get(), out.get(), 0, mdat->offset) &&
+      writeAll(out.get(), moovOut.data(), moovOut.size()) &&
+      copyRange(in.get(), out.get(), mdat->offset,
+                moov->offset - mdat->offset) &&
+      copyRange(in.get(), out.get(), moovEnd, result.file_size - moovEnd);
+  if (!out.close() || !written) {
+    result.error = "cannot write " + *outputPath + ": " + std::strerror(errno);
+    ::unlink(outputPath->c_str());
+    return result;
+  }
+
+  result.status = Status::Rewritten;
+  result.bytes_written = result.file_size - moov->size + moovOut.size();
+  return result;
+}
+
+} // namespace
+
+const char *MP4Faststart::statusName(Status status) {
+  switch (status) {
+  case Status::Rewritten:
+    return "rewritten";
+  case Status::AlreadyFaststart:
+    return "already_faststart";
+  case Status::NotFaststart:
+    return "not_faststart";
+  case Status::Fragmented:
+    return "fragmented";
+  case Status::Invalid:
+    return "invalid";
+  case Status::Failed:
+    return "failed";
+  }
+  return "failed";
+}
+
+MP4Faststart::Result MP4Faststart::probe(const std::string &filePath) {
+  return process(filePath, nullptr);
+}
+
+MP4Faststart::Result MP4Faststart::rewrite(const std::string &inputPath,
+                                           const std::string &outputPath) {
+  return process(inputPath, &outputPath);
+}
+
+MP4Faststart::Result MP4Faststart::rewriteFile(const std::string &filePath) {
+  // Not *.mp4, so directory watchers ignore the temporary file
+  std::string tempPath = filePath + ".faststart.tmp";
+  Result result = rewrite(filePath, tempPath);
+  if (result.status == Status::Rewritten &&
+      std::rename(tempPath.c_str(), filePath.c_str()) != 0) {
+    result.status = Status::Failed;
+    result.error = "cannot replace " + filePath + ": " + std::strerror(errno);
+    ::unlink(tempPath.c_str());
+  }
+  return result;
+}
+
+} // namespace MP4Finalizer
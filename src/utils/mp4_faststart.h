@@ -0,0 +1,73 @@
+#ifndef MP4_FASTSTART_H
+#define MP4_FASTSTART_H
+
+#include <cstdint>
+#include <string>
+
+namespace MP4Finalizer {
+
+/**
+ * @brief In-process MP4 faststart (moov before mdat) without ffmpeg
+ *
+ * Walks the top-level ISO-BMFF boxes, loads the moov box, shifts every chunk
+ * offset (stco/co64) by the size of the relocated moov and writes
+ * [boxes before mdat] [moov] [mdat ...] in one streaming copy. stco tables
+ * are upgraded to co64 when a shifted offset no longer fits 32 bits.
+ *
+ * Files whose moov already precedes mdat, and fragmented MP4 (moof), are left
+ * untouched: they already play while downloading.
+ */
+class MP4Faststart {
+public:
+  enum class Status {
+    Rewritten,        // moov moved in front of mdat
+    AlreadyFaststart, // Nothing to do
+    NotFaststart,     // probe() only: moov follows mdat
+    Fragmented,       // Fragmented MP4, streamable as is
+    Invalid,          // Not an MP4 we can rewrite (truncated, no moov, ...)
+    Failed            // I/O error
+  };
+
+  struct Result {
+    Status status = Status::Failed;
+    std::string error;
+    uint64_t file_size = 0;
+    uint64_t bytes_written = 0; // 0 unless Rewritten
+    std::string video_codec;    // Sample entry of the first video track
+    int h264_profile = -1;      // AVCProfileIndication, -1 when not H.264
+  };
+
+  static const char *statusName(Status status);
+
+  /**
+   * @brief Whether a status leaves the file playable with faststart
+   */
+  static bool isOk(Status status) {
+    return status == Status::Rewritten || status == Status::AlreadyFaststart ||
+           status == Status::Fragmented;
+  }
+
+  /**
+   * @brief Read the box layout and video codec without writing anything
+   *
+   * Status is NotFaststart when rewrite() would move moov.
+   */
+  static Result probe(const std::string &filePath);
+
+  /**
+   * @brief Write a faststart copy of inputPath to outputPath
+   *
+   * outputPath is only created when the status is Rewritten.
+   */
+  static Result rewrite(const std::string &inputPath,
+                        const std::string &outputPath);
+
+  /**
+   * @brief Rewrite a file in place (temporary file + rename)
+   */
+  static Result rewriteFile(const std::string &filePath);
+};
+
+} // namespace MP4Finalizer
+
+#endif // MP4_FASTSTART_H
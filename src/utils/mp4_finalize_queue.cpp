@@ -0,0 +1,285 @@
+#include "utils/mp4_finalize_queue.h"
+#include "config/system_config.h"
+#include "utils/mp4_finalizer.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace MP4Finalizer {
+
+MP4FinalizeQueue::Config MP4FinalizeQueue::loadConfig() {
+  Config config;
+  try {
+    Json::Value section =
+        SystemConfig::getInstance().getConfigSection("system.recording");
+    if (section.isObject()) {
+      config.workers = std::max<size_t>(
+          1, section
+                 .get("finalize_workers",
+                      static_cast<Json::UInt64>(config.workers))
+                 .asUInt64());
+      config.max_pending = std::max<size_t>(
+          1, section
+                 .get("finalize_max_pending",
+                      static_cast<Json::UInt64>(config.max_pending))
+                 .asUInt64());
+    }
+  } catch (const std::exception &e) {
+    std::cerr << "[MP4FinalizeQueue] Invalid recording config, using "
+                 "defaults: "
+              << e.what() << std::endl;
+  }
+  return config;
+}
+
+void MP4FinalizeQueue::configure(const Config &config) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  config_ = config;
+  config_.workers = std::max<size_t>(1, config_.workers);
+  config_.max_pending = std::max<size_t>(1, config_.max_pending);
+}
+
+void MP4FinalizeQueue::startWorkersLocked() {
+  while (workers_.size() < config_.workers) {
+    workers_.emplace_back(&MP4FinalizeQueue::workerLoop, this);
+  }
+}
+
+bool MP4FinalizeQueue::submit(const std::string &filePath,
+                              bool createCompatible, Completion done) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_) {
+      return false;
+    }
+    auto pending = in_flight_.find(filePath);
+    if (pending != in_flight_.end()) {
+      // Will be finalized by the pending task
+      if (done) {
+        pending->second.push_back(std::move(done));
+      }
+      return true;
+    }
+    if (queue_.size() >= config_.max_pending) {
+      rejected_++;
+      std::cerr << "[MP4FinalizeQueue] ⚠ Queue full (" << queue_.size()
+                << " pending), not finalizing: " << filePath << std::endl;
+      return false;
+    }
+    startWorkersLocked();
+    queue_.push_back({filePath, createCompatible});
+    auto &completions = in_flight_[filePath];
+    if (done) {
+      completions.push_back(std::move(done));
+    }
+    submitted_++;
+  }
+  cv_.notify_one();
+  return true;
+}
+
+size_t MP4FinalizeQueue::submitDirectory(const std::string &directory,
+                                         bool createCompatible) {
+  size_t accepted = 0;
+  try {
+    for (const auto &entry : fs::directory_iterator(directory)) {
+      if (entry.is_regular_file() && entry.path().extension() == ".mp4" &&
+          submit(entry.path().string(), createCompatible)) {
+        accepted++;
+      }
+    }
+  } catch (const fs::filesystem_error &e) {
+    std::cerr << "[MP4FinalizeQueue] Error reading directory: " << e.what()
+              << std::endl;
+  }
+  return accepted;
+}
+
+void MP4FinalizeQueue::shutdown() {
+  std::vector<std::thread> workers;
+  std::deque<Task> dropped;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_) {
+      return;
+    }
+    stopping_ = true;
+    dropped.swap(queue_);
+    workers.swap(workers_);
+  }
+  for (const auto &task : dropped) {
+    complete(task.filePath, false);
+  }
+  cv_.notify_all();
+  for (auto &worker : workers) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  if (!dropped.empty()) {
+    std::cerr << "[MP4FinalizeQueue] Dropped " << dropped.size()
+              << " queued file(s) at shutdown" << std::endl;
+  }
+}
+
+void MP4FinalizeQueue::workerLoop() {
+  while (true) {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+      if (stopping_) {
+        return;
+      }
+      task = std::move(queue_.front());
+      queue_.pop_front();
+      active_++;
+    }
+
+    bool success = process(task);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      active_--;
+    }
+    complete(task.filePath, success);
+  }
+}
+
+void MP4FinalizeQueue::complete(const std::string &filePath, bool success) {
+  std::vector<Completion> completions;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = in_flight_.find(filePath);
+    if (it == in_flight_.end()) {
+      return;
+    }
+    completions.swap(it->second);
+    in_flight_.erase(it);
+  }
+  for (auto &done : completions) {
+    try {
+      done(success);
+    } catch (const std::exception &e) {
+      std::cerr << "[MP4FinalizeQueue] Completion error for " << filePath
+                << ": " << e.what() << std::endl;
+    }
+  }
+}
+
+bool MP4FinalizeQueue::process(const Task &task) {
+  auto start = std::chrono::steady_clock::now();
+  FinalizeReport report;
+  bool ok = false;
+  try {
+    ok = MP4Finalizer::finalizeFile(task.filePath, task.createCompatible,
+                                    &report);
+  } catch (const std::exception &e) {
+    std::cerr << "[MP4FinalizeQueue] Error finalizing " << task.filePath
+              << ": " << e.what() << std::endl;
+  }
+  busy_us_ += std::chrono::duration_cast<std::chrono::microseconds>(
+                  std::chrono::steady_clock::now() - start)
+                  .count();
+
+  if (report.faststart == MP4Faststart::Status::Rewritten) {
+    rewritten_++;
+    bytes_written_ += report.bytes_written;
+  } else if (report.faststart == MP4Faststart::Status::AlreadyFaststart ||
+             report.faststart == MP4Faststart::Status::Fragmented) {
+    already_faststart_++;
+  }
+  if (report.ffmpeg_fallback) {
+    ffmpeg_fallbacks_++;
+  }
+  if (report.converted) {
+    converted_++;
+  }
+  if (!ok) {
+    failed_++;
+  }
+  return ok;
+}
+
+MP4FinalizeQueue::Stats MP4FinalizeQueue::getStats() const {
+  Stats stats;
+  stats.submitted = submitted_.load();
+  stats.rejected = rejected_.load();
+  stats.rewritten = rewritten_.load();
+  stats.already_faststart = already_faststart_.load();
+  stats.ffmpeg_fallbacks = ffmpeg_fallbacks_.load();
+  stats.converted = converted_.load();
+  stats.failed = failed_.load();
+  stats.bytes_written = bytes_written_.load();
+  stats.busy_seconds = busy_us_.load() / 1e6;
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats.pending = queue_.size();
+  stats.active = active_;
+  return stats;
+}
+
+Json::Value MP4FinalizeQueue::getStatsJson() const {
+  Stats stats = getStats();
+  Json::Value json;
+  json["submitted"] = static_cast<Json::UInt64>(stats.submitted);
+  json["rejected"] = static_cast<Json::UInt64>(stats.rejected);
+  json["rewritten"] = static_cast<Json::UInt64>(stats.rewritten);
+  json["already_faststart"] =
+      static_cast<Json::UInt64>(stats.already_faststart);
+  json["ffmpeg_fallbacks"] = static_cast<Json::UInt64>(stats.ffmpeg_fallbacks);
+  json["converted"] = static_cast<Json::UInt64>(stats.converted);
+  json["failed"] = static_cast<Json::UInt64>(stats.failed);
+  json["bytes_written"] = static_cast<Json::UInt64>(stats.bytes_written);
+  json["busy_seconds"] = stats.busy_seconds;
+  json["pending"] = static_cast<Json::UInt64>(stats.pending);
+  json["active"] = static_cast<Json::UInt64>(stats.active);
+  return json;
+}
+
+std::string MP4FinalizeQueue::getPrometheusMetrics() const {
+  Stats stats = getStats();
+  std::ostringstream oss;
+
+  oss << "# HELP recording_finalize_files_total Recordings finalized, by "
+         "result\n";
+  oss << "# TYPE recording_finalize_files_total counter\n";
+  oss << "recording_finalize_files_total{result=\"rewritten\"} "
+      << stats.rewritten << "\n";
+  oss << "recording_finalize_files_total{result=\"already_faststart\"} "
+      << stats.already_faststart << "\n";
+  oss << "recording_finalize_files_total{result=\"ffmpeg_fallback\"} "
+      << stats.ffmpeg_fallbacks << "\n";
+  oss << "recording_finalize_files_total{result=\"converted\"} "
+      << stats.converted << "\n";
+  oss << "recording_finalize_files_total{result=\"failed\"} " << stats.failed
+      << "\n";
+  oss << "# HELP recording_finalize_rejected_total Recordings not queued "
+         "because the finalize queue was full\n";
+  oss << "# TYPE recording_finalize_rejected_total counter\n";
+  oss << "recording_finalize_rejected_total " << stats.rejected << "\n";
+  oss << "# HELP recording_finalize_bytes_written_total Bytes written by the "
+         "in-process faststart rewriter\n";
+  oss << "# TYPE recording_finalize_bytes_written_total counter\n";
+  oss << "recording_finalize_bytes_written_total " << stats.bytes_written
+      << "\n";
+  oss << "# HELP recording_finalize_busy_seconds_total Worker time spent "
+         "finalizing recordings\n";
+  oss << "# TYPE recording_finalize_busy_seconds_total counter\n";
+  oss << "recording_finalize_busy_seconds_total " << stats.busy_seconds
+      << "\n";
+  oss << "# HELP recording_finalize_queue_depth Recordings waiting to be "
+         "finalized\n";
+  oss << "# TYPE recording_finalize_queue_depth gauge\n";
+  oss << "recording_finalize_queue_depth " << stats.pending << "\n";
+  oss << "# HELP recording_finalize_active Recordings being finalized\n";
+  oss << "# TYPE recording_finalize_active gauge\n";
+  oss << "recording_finalize_active " << stats.active << "\n";
+  oss << "\n";
+
+  return oss.str();
+}
+
+} // namespace MP4Finalizer
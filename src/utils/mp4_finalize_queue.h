@@ -0,0 +1,134 @@
+#ifndef MP4_FINALIZE_QUEUE_H
+#define MP4_FINALIZE_QUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <json/json.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace MP4Finalizer {
+
+/**
+ * @brief Bounded queue that finalizes finished recordings
+ *
+ * A fixed number of workers run MP4Finalizer::finalizeFile(), so a burst of
+ * closed recordings (many cameras rolling over at once) no longer starts one
+ * thread and ffmpeg process per file. A file already queued or in progress
+ * is not queued twice. Throughput is exported as metrics.
+ */
+class MP4FinalizeQueue {
+public:
+  // Called on a queue worker with the result of finalizeFile(); files
+  // dropped at shutdown report false
+  using Completion = std::function<void(bool success)>;
+
+  struct Config {
+    size_t workers = 2;
+    size_t max_pending = 256;
+  };
+
+  struct Stats {
+    uint64_t submitted = 0;
+    uint64_t rejected = 0; // Queue full
+    uint64_t rewritten = 0; // moov moved in process
+    uint64_t already_faststart = 0;
+    uint64_t ffmpeg_fallbacks = 0;
+    uint64_t converted = 0; // Re-encoded to a compatible profile
+    uint64_t failed = 0;
+    uint64_t bytes_written = 0; // By the in-process rewriter
+    double busy_seconds = 0.0;  // Summed over workers
+    size_t pending = 0;
+    size_t active = 0;
+  };
+
+  static MP4FinalizeQueue &getInstance() {
+    static MP4FinalizeQueue instance;
+    return instance;
+  }
+
+  /**
+   * @brief Read config from the optional "system.recording" section
+   */
+  static Config loadConfig();
+
+  /**
+   * @brief Apply configuration (call from startup code before submitting)
+   */
+  void configure(const Config &config);
+
+  /**
+   * @brief Queue a file; workers start on first use
+   * @param done Optional completion, also called when the file was already
+   * queued by someone else
+   * @return false when the queue is full or shut down (done is not called)
+   */
+  bool submit(const std::string &filePath, bool createCompatible = true,
+              Completion done = nullptr);
+
+  /**
+   * @brief Queue every *.mp4 file in a directory
+   * @return Number of files accepted
+   */
+  size_t submitDirectory(const std::string &directory,
+                         bool createCompatible = true);
+
+  /**
+   * @brief Stop workers after their current file; queued files are dropped
+   */
+  void shutdown();
+
+  Stats getStats() const;
+  Json::Value getStatsJson() const;
+
+  /**
+   * @brief Prometheus exposition of finalize queue metrics
+   */
+  std::string getPrometheusMetrics() const;
+
+private:
+  MP4FinalizeQueue() = default;
+  ~MP4FinalizeQueue() { shutdown(); }
+  MP4FinalizeQueue(const MP4FinalizeQueue &) = delete;
+  MP4FinalizeQueue &operator=(const MP4FinalizeQueue &) = delete;
+
+  struct Task {
+    std::string filePath;
+    bool createCompatible = true;
+  };
+
+  void startWorkersLocked();
+  void workerLoop();
+  bool process(const Task &task);
+  void complete(const std::string &filePath, bool success);
+
+  Config config_;
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Task> queue_;
+  // Queued or being processed, with the completions waiting for each file
+  std::map<std::string, std::vector<Completion>> in_flight_;
+  std::vector<std::thread> workers_;
+  size_t active_ = 0;
+  bool stopping_ = false;
+
+  std::atomic<uint64_t> submitted_{0};
+  std::atomic<uint64_t> rejected_{0};
+  std::atomic<uint64_t> rewritten_{0};
+  std::atomic<uint64_t> already_faststart_{0};
+  std::atomic<uint64_t> ffmpeg_fallbacks_{0};
+  std::atomic<uint64_t> converted_{0};
+  std::atomic<uint64_t> failed_{0};
+  std::atomic<uint64_t> bytes_written_{0};
+  std::atomic<uint64_t> busy_us_{0};
+};
+
+} // namespace MP4Finalizer
+
+#endif // MP4_FINALIZE_QUEUE_H
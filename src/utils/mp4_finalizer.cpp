@@ -5,16 +5,87 @@
 #include <iostream>
 #include <chrono>
 #include <thread>
+#include <cctype>
 #include <cstdlib>
 #include <cstring>
 #include <cstdio>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 
 namespace fs = std::filesystem;
 
 namespace MP4Finalizer {
 
+namespace {
+
+// 1 if some process has the file open for writing, 0 if not, -1 when /proc
+// cannot be read
+int openForWriting(const std::string &filePath) {
+  struct stat target;
+  if (::stat(filePath.c_str(), &target) != 0) {
+    return 0;
+  }
+  DIR *proc = ::opendir("/proc");
+  if (!proc) {
+    return -1;
+  }
+
+  bool found = false;
+  while (!found) {
+    struct dirent *process = ::readdir(proc);
+    if (!process) {
+      break;
+    }
+    if (!std::isdigit(static_cast<unsigned char>(process->d_name[0]))) {
+      continue;
+    }
+    std::string pidDir = std::string("/proc/") + process->d_name;
+    DIR *fds = ::opendir((pidDir + "/fd").c_str());
+    if (!fds) {
+      continue; // Exited, or owned by another user
+    }
+    while (struct dirent *fd = ::readdir(fds)) {
+      if (fd->d_name[0] == '.') {
+        continue;
+      }
+      struct stat st;
+      std::string fdPath = pidDir + "/fd/" + fd->d_name;
+      if (::stat(fdPath.c_str(), &st) != 0 || st.st_dev != target.st_dev ||
+          st.st_ino != target.st_ino) {
+        continue;
+      }
+      // Same file: readers (players, our own rewriter) do not count
+      std::ifstream info(pidDir + "/fdinfo/" + fd->d_name);
+      std::string key;
+      long flags = O_RDWR;
+      while (info >> key) {
+        if (key == "flags:") {
+          std::string value;
+          info >> value;
+          flags = std::strtol(value.c_str(), nullptr, 8);
+          break;
+        }
+      }
+      if ((flags & O_ACCMODE) != O_RDONLY) {
+        found = true;
+        break;
+      }
+    }
+    ::closedir(fds);
+  }
+  ::closedir(proc);
+  return found ? 1 : 0;
+}
+
+} // namespace
+
 bool MP4Finalizer::isFileBeingWritten(const std::string &filePath) {
-  // Check if file is open by another process using lsof
+  int open = openForWriting(filePath);
+  if (open >= 0) {
+    return open == 1;
+  }
+  // No /proc: check if file is open by another process using lsof
   std::string command = "lsof \"" + filePath + "\" >/dev/null 2>&1";
   int result = std::system(command.c_str());
   return (result == 0);
@@ -119,6 +190,16 @@ bool MP4Finalizer::needsConversion(const std::string &filePath) {
   if (!fs::exists(filePath)) {
     return false;
   }
+  return needsConversion(filePath, MP4Faststart::probe(filePath));
+}
+
+bool MP4Finalizer::needsConversion(const std::string &filePath,
+                                   const MP4Faststart::Result &info) {
+  if (info.h264_profile >= 0) {
+    // High profiles (100+) and CAVLC 4:4:4 (44); chroma other than 4:2:0
+    // only exists in these
+    return info.h264_profile >= 100 || info.h264_profile == 44;
+  }
 
   std::string profile = getFileProfile(filePath);
   std::string pixFmt = getPixelFormat(filePath);
@@ -183,7 +264,11 @@ bool MP4Finalizer::executeFFmpeg(const std::string &command) {
 }
 
 bool MP4Finalizer::finalizeFile(const std::string &filePath,
-                                 bool createCompatible) {
+                                 bool createCompatible,
+                                 FinalizeReport *report) {
+  FinalizeReport localReport;
+  FinalizeReport &result = report ? *report : localReport;
+
   if (!fs::exists(filePath)) {
     std::cerr << "[MP4Finalizer] File not found: " << filePath << std::endl;
     return false;
@@ -219,6 +304,25 @@ bool MP4Finalizer::finalizeFile(const std::string &filePath,
               << std::endl;
   }
 
+  // Move moov in front of mdat in process: one streaming copy, no ffmpeg
+  auto faststart = MP4Faststart::rewriteFile(filePath);
+  result.faststart = faststart.status;
+  result.bytes_written = faststart.bytes_written;
+  if (MP4Faststart::isOk(faststart.status)) {
+    std::cerr << "[MP4Finalizer] ✓ Finalized ("
+              << MP4Faststart::statusName(faststart.status)
+              << "): " << filePath << std::endl;
+    if (createCompatible && needsConversion(filePath, faststart)) {
+      std::cerr << "[MP4Finalizer] File uses incompatible encoding, converting to compatible format..."
+                << std::endl;
+      result.converted = convertToCompatible(filePath, "");
+    }
+    return true;
+  }
+  std::cerr << "[MP4Finalizer] In-process faststart failed ("
+            << faststart.error << "), falling back to ffmpeg..." << std::endl;
+  result.ffmpeg_fallback = true;
+
   std::string tempFile = filePath + ".tmp.mp4"; // Use .mp4 extension so ffmpeg recognizes format
 
   // Try faststart first (fastest, preserves quality)
@@ -239,6 +343,7 @@ bool MP4Finalizer::finalizeFile(const std::string &filePath,
         std::cerr << "[MP4Finalizer] File uses incompatible encoding, converting to compatible format..."
                   << std::endl;
         if (convertToCompatible(filePath, "")) { // Empty string = overwrite original
+          result.converted = true;
           return true;
         }
       }
@@ -271,6 +376,7 @@ bool MP4Finalizer::finalizeFile(const std::string &filePath,
               << std::endl;
     // Convert and overwrite original file
     if (convertToCompatible(filePath, "")) { // Empty string = overwrite original
+      result.converted = true;
       return true;
     }
     std::cerr << "[MP4Finalizer] Conversion also failed for: " << filePath << std::endl;
@@ -282,6 +388,7 @@ bool MP4Finalizer::finalizeFile(const std::string &filePath,
     std::cerr << "[MP4Finalizer] Attempting conversion anyway to fix file structure..."
               << std::endl;
     if (convertToCompatible(filePath, "")) {
+      result.converted = true;
       return true;
     }
   }
@@ -1,6 +1,7 @@
 #ifndef MP4_FINALIZER_H
 #define MP4_FINALIZER_H
 
+#include "utils/mp4_faststart.h"
 #include <string>
 #include <vector>
 #include <memory>
@@ -10,11 +11,22 @@
 
 namespace MP4Finalizer {
 
+/**
+ * @brief What finalizeFile() did to a file
+ */
+struct FinalizeReport {
+  MP4Faststart::Status faststart = MP4Faststart::Status::Failed;
+  uint64_t bytes_written = 0; // By the in-process rewriter
+  bool ffmpeg_fallback = false; // In-process rewrite failed, ffmpeg used
+  bool converted = false;       // Re-encoded to a compatible profile
+};
+
 /**
  * @brief Utility class to automatically finalize and convert MP4 files
  * 
  * This class provides functionality to:
- * - Finalize MP4 files with faststart (move moov atom to beginning)
+ * - Finalize MP4 files with faststart (move moov atom to beginning), in
+ *   process via MP4Faststart with ffmpeg only as a fallback
  * - Convert files with incompatible encoding settings to compatible format
  * - Process files in background without blocking
  */
@@ -25,10 +37,12 @@ public:
    * 
    * @param filePath Path to the MP4 file
    * @param createCompatible If true, create a compatible version if needed
+   * @param report Optional details of what was done
    * @return true if successful, false otherwise
    */
   static bool finalizeFile(const std::string &filePath,
-                           bool createCompatible = true);
+                           bool createCompatible = true,
+                           FinalizeReport *report = nullptr);
 
   /**
    * @brief Finalize all MP4 files in a directory
@@ -42,7 +56,10 @@ public:
 
   /**
    * @brief Check if a file is being written to
-   * 
+   *
+   * Looks for a descriptor open for writing in /proc/<pid>/fd (no lsof
+   * process per check); lsof is only used when /proc is unavailable.
+   *
    * @param filePath Path to the file
    * @return true if file is being written, false otherwise
    */
@@ -50,7 +67,10 @@ public:
 
   /**
    * @brief Check if file uses incompatible encoding settings
-   * 
+   *
+   * H.264 files are checked from the avcC box; ffprobe is only run for
+   * other codecs.
+   *
    * @param filePath Path to the MP4 file
    * @return true if file needs conversion, false otherwise
    */
@@ -85,6 +105,12 @@ private:
    */
   static bool executeFFmpeg(const std::string &command);
 
+  /**
+   * @brief needsConversion() using codec info already read from the file
+   */
+  static bool needsConversion(const std::string &filePath,
+                              const MP4Faststart::Result &info);
+
   /**
    * @brief Get file profile using ffprobe
    * 
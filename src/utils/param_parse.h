@@ -0,0 +1,92 @@
+#pragma once
+
+#include <map>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Strict parsing of string node / additional parameters
+ *
+ * Unset, empty and unresolved template ("${...}") values read as "use the
+ * default"; anything else must parse completely and lie in range, or
+ * std::invalid_argument names the key, the value and what was expected.
+ */
+namespace ParamParse {
+
+using Params = std::map<std::string, std::string>;
+
+// Parameter value, or nullptr when the default should be used
+inline const std::string *lookup(const Params &params, const std::string &key) {
+  auto it = params.find(key);
+  if (it == params.end() || it->second.empty() ||
+      it->second.rfind("${", 0) == 0) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+[[noreturn]] inline void invalid(const std::string &key,
+                                 const std::string &value,
+                                 const std::string &expected) {
+  throw std::invalid_argument("Invalid " + key + " '" + value +
+                              "': expected " + expected);
+}
+
+inline double parseDouble(const Params &params, const std::string &key,
+                          double fallback, double min, double max) {
+  const std::string *value = lookup(params, key);
+  if (!value) {
+    return fallback;
+  }
+  std::string expected = "a number in [" + std::to_string(min) + ", " +
+                         std::to_string(max) + "]";
+  size_t used = 0;
+  double parsed = 0.0;
+  try {
+    parsed = std::stod(*value, &used);
+  } catch (const std::exception &) {
+    invalid(key, *value, expected);
+  }
+  if (used != value->size() || !(parsed >= min && parsed <= max)) {
+    invalid(key, *value, expected);
+  }
+  return parsed;
+}
+
+inline int parseInt(const Params &params, const std::string &key,
+                    int fallback, int min, int max) {
+  const std::string *value = lookup(params, key);
+  if (!value) {
+    return fallback;
+  }
+  std::string expected = "an integer in [" + std::to_string(min) + ", " +
+                         std::to_string(max) + "]";
+  size_t used = 0;
+  long parsed = 0;
+  try {
+    parsed = std::stol(*value, &used);
+  } catch (const std::exception &) {
+    invalid(key, *value, expected);
+  }
+  if (used != value->size() || parsed < min || parsed > max) {
+    invalid(key, *value, expected);
+  }
+  return static_cast<int>(parsed);
+}
+
+inline bool parseBool(const Params &params, const std::string &key,
+                      bool fallback) {
+  const std::string *value = lookup(params, key);
+  if (!value) {
+    return fallback;
+  }
+  if (*value == "true" || *value == "1") {
+    return true;
+  }
+  if (*value == "false" || *value == "0") {
+    return false;
+  }
+  invalid(key, *value, "true or false");
+}
+
+} // namespace ParamParse
@@ -0,0 +1,718 @@
+#include "videos/offline_job_manager.h"
+#include "config/system_config.h"
+#include "core/uuid_generator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+double elapsedSeconds(std::chrono::steady_clock::time_point from,
+                      std::chrono::steady_clock::time_point to) {
+  return std::chrono::duration<double>(to - from).count();
+}
+
+std::string formatUtc(std::chrono::system_clock::time_point tp) {
+  auto time_t = std::chrono::system_clock::to_time_t(tp);
+  std::tm tm{};
+  gmtime_r(&time_t, &tm);
+  std::stringstream ss;
+  ss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%SZ");
+  return ss.str();
+}
+
+// Single-quote for /bin/sh
+std::string shellQuote(const std::string &value) {
+  std::string quoted = "'";
+  for (char c : value) {
+    if (c == '\'') {
+      quoted += "'\\''";
+    } else {
+      quoted += c;
+    }
+  }
+  return quoted + "'";
+}
+
+bool runCommand(const std::string &command, std::string &output) {
+  FILE *pipe = popen(command.c_str(), "r");
+  if (!pipe) {
+    return false;
+  }
+  char buffer[4096];
+  size_t read = 0;
+  while ((read = fread(buffer, 1, sizeof(buffer), pipe)) > 0) {
+    output.append(buffer, read);
+  }
+  return pclose(pipe) == 0;
+}
+
+// "30000/1001" or "25"
+double parseRate(const std::string &rate) {
+  size_t slash = rate.find('/');
+  try {
+    if (slash == std::string::npos) {
+      return std::stod(rate);
+    }
+    double den = std::stod(rate.substr(slash + 1));
+    return den > 0.0 ? std::stod(rate.substr(0, slash)) / den : 0.0;
+  } catch (const std::exception &) {
+    return 0.0;
+  }
+}
+
+double round2(double value) { return std::round(value * 100.0) / 100.0; }
+
+} // namespace
+
+void OfflineJobManager::SegmentProgress::setFrames(uint64_t frames) {
+  manager_.setSegmentFrames(job_id_, segment_, frames);
+}
+
+bool OfflineJobManager::SegmentProgress::cancelled() const {
+  return manager_.isCancelled(job_id_);
+}
+
+const char *OfflineJobManager::stateName(State state) {
+  switch (state) {
+  case State::Queued:
+    return "queued";
+  case State::Probing:
+    return "probing";
+  case State::Running:
+    return "running";
+  case State::Merging:
+    return "merging";
+  case State::Succeeded:
+    return "succeeded";
+  case State::Failed:
+    return "failed";
+  case State::Cancelled:
+    return "cancelled";
+  }
+  return "unknown";
+}
+
+OfflineJobManager::Config OfflineJobManager::loadConfig() {
+  Config config;
+  try {
+    Json::Value section =
+        SystemConfig::getInstance().getConfigSection("system.offline_jobs");
+    if (section.isObject()) {
+      config.max_workers = section
+                               .get("max_workers", static_cast<Json::UInt64>(
+                                                       config.max_workers))
+                               .asUInt64();
+      config.max_concurrent_jobs = std::max<size_t>(
+          1, section
+                 .get("max_concurrent_jobs",
+                      static_cast<Json::UInt64>(config.max_concurrent_jobs))
+                 .asUInt64());
+      config.segments_per_worker = std::max<size_t>(
+          1, section
+                 .get("segments_per_worker",
+                      static_cast<Json::UInt64>(config.segments_per_worker))
+                 .asUInt64());
+      config.min_segment_seconds = std::max(
+          1.0, section.get("min_segment_seconds", config.min_segment_seconds)
+                   .asDouble());
+      config.max_retained_jobs = std::max<size_t>(
+          1, section
+                 .get("max_retained_jobs",
+                      static_cast<Json::UInt64>(config.max_retained_jobs))
+                 .asUInt64());
+    }
+  } catch (const std::exception &e) {
+    std::cerr << "[OfflineJobManager] Invalid offline_jobs config, using "
+                 "defaults: "
+              << e.what() << std::endl;
+  }
+  return config;
+}
+
+void OfflineJobManager::configure(const Config &config) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  config_ = config;
+  if (config_.max_workers == 0) {
+    config_.max_workers =
+        std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+  config_.max_concurrent_jobs = std::max<size_t>(1, config_.max_concurrent_jobs);
+  accepting_ = true;
+  std::cerr << "[OfflineJobManager] Configured: " << config_.max_workers
+            << " segment workers, " << config_.max_concurrent_jobs
+            << " concurrent job(s), jobs dir " << config_.jobs_dir
+            << std::endl;
+}
+
+void OfflineJobManager::setProber(Prober prober) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  prober_ = std::move(prober);
+}
+
+void OfflineJobManager::setSegmentProcessor(SegmentProcessor processor) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  processor_ = std::move(processor);
+}
+
+bool OfflineJobManager::probeWithFfprobe(const std::string &path,
+                                         VideoInfo &info, std::string &error) {
+  std::string output;
+  if (!runCommand("ffprobe -v error -select_streams v:0 -show_entries "
+                  "stream=avg_frame_rate,r_frame_rate,nb_frames:format="
+                  "duration -of default=noprint_wrappers=1 " +
+                      shellQuote(path) + " 2>/dev/null",
+                  output)) {
+    error = "ffprobe failed (is ffprobe installed and the file a video?)";
+    return false;
+  }
+
+  std::istringstream lines(output);
+  std::string line;
+  double rFrameRate = 0.0;
+  while (std::getline(lines, line)) {
+    size_t eq = line.find('=');
+    if (eq == std::string::npos) {
+      continue;
+    }
+    std::string key = line.substr(0, eq);
+    std::string value = line.substr(eq + 1);
+    if (key == "avg_frame_rate") {
+      info.fps = parseRate(value);
+    } else if (key == "r_frame_rate") {
+      rFrameRate = parseRate(value);
+    } else if (key == "duration") {
+      info.duration_sec = parseRate(value);
+    } else if (key == "nb_frames") {
+      info.frames = static_cast<uint64_t>(std::max(0.0, parseRate(value)));
+    }
+  }
+  if (info.fps <= 0.0) {
+    info.fps = rFrameRate;
+  }
+  if (info.duration_sec <= 0.0 || info.fps <= 0.0) {
+    error = "Could not determine video duration / frame rate";
+    return false;
+  }
+
+  // Packet flags only: no decoding, fast even for 24 h recordings
+  std::string packets;
+  if (!runCommand("ffprobe -v error -select_streams v:0 -show_entries "
+                  "packet=pts_time,flags -of csv=p=0 " +
+                      shellQuote(path) + " 2>/dev/null",
+                  packets)) {
+    error = "ffprobe could not list keyframes";
+    return false;
+  }
+  info.keyframes = VideoSegmenter::parseKeyframeTimes(packets);
+  return true;
+}
+
+void OfflineJobManager::startRunnersLocked() {
+  if (running_) {
+    return;
+  }
+  if (config_.max_workers == 0) {
+    config_.max_workers =
+        std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+  running_ = true;
+  for (size_t i = 0; i < config_.max_concurrent_jobs; ++i) {
+    runners_.emplace_back(&OfflineJobManager::runnerLoop, this);
+  }
+}
+
+std::string OfflineJobManager::submit(const JobRequest &request,
+                                      std::string &error) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!accepting_) {
+    error = "Server shutting down";
+    return "";
+  }
+  if (!processor_) {
+    error = "Offline analytics is not available in this build";
+    return "";
+  }
+  if (request.solution_id.empty()) {
+    error = "solutionId is required";
+    return "";
+  }
+  std::error_code ec;
+  if (!fs::is_regular_file(request.video_path, ec)) {
+    error = "Video file not found: " + request.video_name;
+    return "";
+  }
+
+  auto job = std::make_shared<Job>();
+  job->id = UUIDGenerator::generateUUID();
+  job->request = request;
+  job->dir = (fs::path(config_.jobs_dir) / job->id).string();
+  job->created = Clock::now();
+  job->created_wall = std::chrono::system_clock::now();
+  fs::create_directories(job->dir, ec);
+  if (ec) {
+    error = "Cannot create job directory " + job->dir + ": " + ec.message();
+    return "";
+  }
+
+  startRunnersLocked();
+  jobs_[job->id] = job;
+  order_.push_back(job->id);
+  queue_.push_back(job);
+  work_cv_.notify_one();
+  return job->id;
+}
+
+void OfflineJobManager::runnerLoop() {
+  while (true) {
+    std::shared_ptr<Job> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      work_cv_.wait(lock, [this] { return !running_ || !queue_.empty(); });
+      if (!running_) {
+        return;
+      }
+      job = queue_.front();
+      queue_.pop_front();
+    }
+    runJob(job);
+  }
+}
+
+void OfflineJobManager::runJob(const std::shared_ptr<Job> &job) {
+  Prober prober;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    job->state = State::Probing;
+    prober = prober_;
+  }
+
+  VideoInfo info;
+  std::string error;
+  if (!prober(job->request.video_path, info, error)) {
+    finishJob(job, State::Failed, error.empty() ? "Probe failed" : error);
+    return;
+  }
+  if (info.frames == 0) {
+    info.frames = static_cast<uint64_t>(std::llround(info.duration_sec *
+                                                     info.fps));
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    job->info = info;
+    job->parallelism = std::clamp<size_t>(
+        job->request.parallelism == 0 ? config_.max_workers
+                                      : job->request.parallelism,
+        1, config_.max_workers);
+    size_t target = job->request.segments == 0
+                        ? job->parallelism * config_.segments_per_worker
+                        : job->request.segments;
+    for (const auto &segment : VideoSegmenter::planSegments(
+             info.keyframes, info.duration_sec, target,
+             config_.min_segment_seconds)) {
+      SegmentState state;
+      state.segment = segment;
+      state.expected_frames = static_cast<uint64_t>(std::llround(
+          (segment.end_sec - segment.start_sec) * info.fps));
+      job->segments.push_back(state);
+    }
+    job->state = State::Running;
+    job->started = Clock::now();
+  }
+  std::cerr << "[OfflineJobManager] Job " << job->id << ": "
+            << job->segments.size() << " segments on " << job->parallelism
+            << " workers (" << info.duration_sec << " s @ " << info.fps
+            << " fps, " << info.keyframes.size() << " keyframes)"
+            << std::endl;
+
+  if (!processSegments(job, error)) {
+    finishJob(job, job->cancel ? State::Cancelled : State::Failed,
+              job->cancel ? "Cancelled" : error);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    job->state = State::Merging;
+  }
+  if (!mergeSegments(job, error)) {
+    finishJob(job, State::Failed, error);
+    return;
+  }
+  finishJob(job, State::Succeeded, "");
+}
+
+bool OfflineJobManager::processSegments(const std::shared_ptr<Job> &job,
+                                        std::string &error) {
+  SegmentProcessor processor;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    processor = processor_;
+  }
+
+  const size_t count = job->segments.size();
+  std::atomic<size_t> next{0};
+  std::atomic<bool> failed{false};
+
+  auto worker = [&] {
+    while (!job->cancel && !failed) {
+      const size_t index = next.fetch_add(1);
+      if (index >= count) {
+        return;
+      }
+
+      SegmentTask task;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job->segments[index].state = "running";
+        task.segment = job->segments[index].segment;
+      }
+      task.job_id = job->id;
+      task.video_path = job->request.video_path;
+      task.solution_id = job->request.solution_id;
+      task.additional_params = job->request.additional_params;
+      task.include_detections = job->request.include_detections;
+      task.to_end = index + 1 == count;
+      task.fps = job->info.fps;
+      task.output_path =
+          (fs::path(job->dir) / ("segment_" + std::to_string(index) + ".tsv"))
+              .string();
+
+      SegmentProgress progress(*this, job->id, index);
+      const auto start = Clock::now();
+      std::string segmentError;
+      bool ok = false;
+      try {
+        ok = processor(task, progress, segmentError);
+      } catch (const std::exception &e) {
+        segmentError = e.what();
+      }
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      SegmentState &state = job->segments[index];
+      state.seconds = elapsedSeconds(start, Clock::now());
+      state.state = ok ? "done" : "failed";
+      if (!ok) {
+        state.error = segmentError.empty() ? "Segment failed" : segmentError;
+        if (!failed.exchange(true)) {
+          error = "Segment " + std::to_string(index) + ": " + state.error;
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  const size_t threads = std::min(job->parallelism, count);
+  for (size_t i = 1; i < threads; ++i) {
+    workers.emplace_back(worker);
+  }
+  worker(); // The runner thread is one of the workers
+  for (auto &thread : workers) {
+    thread.join();
+  }
+  return !failed && !job->cancel;
+}
+
+bool OfflineJobManager::mergeSegments(const std::shared_ptr<Job> &job,
+                                      std::string &error) {
+  std::vector<std::unique_ptr<std::ifstream>> files;
+  std::vector<std::istream *> inputs;
+  for (size_t i = 0; i < job->segments.size(); ++i) {
+    auto path = fs::path(job->dir) / ("segment_" + std::to_string(i) + ".tsv");
+    files.push_back(std::make_unique<std::ifstream>(path));
+    // A segment without events may not have written a file at all
+    inputs.push_back(files.back()->is_open() ? files.back().get() : nullptr);
+  }
+
+  const auto mergedPath = fs::path(job->dir) / "events.jsonl";
+  std::ofstream output(mergedPath, std::ios::trunc);
+  if (!output) {
+    error = "Cannot write " + mergedPath.string();
+    return false;
+  }
+  uint64_t events = VideoSegmenter::mergeEventStreams(inputs, output);
+  output.close();
+  files.clear();
+
+  for (size_t i = 0; i < job->segments.size(); ++i) {
+    std::error_code ec;
+    fs::remove(fs::path(job->dir) / ("segment_" + std::to_string(i) + ".tsv"),
+               ec);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  job->events = events;
+  return true;
+}
+
+void OfflineJobManager::finishJob(const std::shared_ptr<Job> &job, State state,
+                                  const std::string &error) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    job->state = state;
+    job->error = error;
+    job->finished = Clock::now();
+    std::cerr << "[OfflineJobManager] Job " << job->id << " "
+              << stateName(state) << (error.empty() ? "" : ": " + error)
+              << std::endl;
+    pruneLocked();
+  }
+  done_cv_.notify_all();
+}
+
+void OfflineJobManager::setSegmentFrames(const std::string &id, size_t segment,
+                                         uint64_t frames) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto found = jobs_.find(id);
+  if (found != jobs_.end() && segment < found->second->segments.size()) {
+    found->second->segments[segment].frames = frames;
+  }
+}
+
+bool OfflineJobManager::isCancelled(const std::string &id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto found = jobs_.find(id);
+  return found == jobs_.end() || found->second->cancel;
+}
+
+bool OfflineJobManager::cancelOrDelete(const std::string &id) {
+  std::shared_ptr<Job> job;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = jobs_.find(id);
+    if (found == jobs_.end()) {
+      return false;
+    }
+    job = found->second;
+    if (isFinished(job->state)) {
+      jobs_.erase(found);
+      order_.erase(std::remove(order_.begin(), order_.end(), id),
+                   order_.end());
+      std::error_code ec;
+      fs::remove_all(job->dir, ec);
+      return true;
+    }
+    job->cancel = true;
+    auto queued = std::find(queue_.begin(), queue_.end(), job);
+    if (queued == queue_.end()) {
+      return true; // Running: the workers stop at the next segment/check
+    }
+    queue_.erase(queued);
+  }
+  finishJob(job, State::Cancelled, "Cancelled");
+  return true;
+}
+
+std::optional<OfflineJobManager::State>
+OfflineJobManager::wait(const std::string &id,
+                        std::chrono::milliseconds timeout) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto found = jobs_.find(id);
+  if (found == jobs_.end()) {
+    return std::nullopt;
+  }
+  auto job = found->second;
+  auto finished = [&job] { return isFinished(job->state); };
+  if (timeout == std::chrono::milliseconds::max()) {
+    done_cv_.wait(lock, finished);
+  } else if (!done_cv_.wait_for(lock, timeout, finished)) {
+    return std::nullopt;
+  }
+  return job->state;
+}
+
+void OfflineJobManager::pruneLocked() {
+  size_t finished = 0;
+  for (const auto &id : order_) {
+    auto found = jobs_.find(id);
+    finished += found != jobs_.end() && isFinished(found->second->state);
+  }
+  for (auto it = order_.begin();
+       it != order_.end() && finished > config_.max_retained_jobs;) {
+    auto found = jobs_.find(*it);
+    if (found == jobs_.end() || !isFinished(found->second->state)) {
+      ++it;
+      continue;
+    }
+    std::error_code ec;
+    fs::remove_all(found->second->dir, ec);
+    jobs_.erase(found);
+    it = order_.erase(it);
+    --finished;
+  }
+}
+
+Json::Value OfflineJobManager::toJsonLocked(const Job &job,
+                                            bool withSegments) const {
+  Json::Value json;
+  json["jobId"] = job.id;
+  json["video"] = job.request.video_name;
+  json["solutionId"] = job.request.solution_id;
+  json["state"] = stateName(job.state);
+  if (!job.error.empty()) {
+    json["error"] = job.error;
+  }
+  json["createdAt"] = formatUtc(job.created_wall);
+
+  uint64_t frames = 0;
+  uint64_t done = 0;
+  for (const auto &segment : job.segments) {
+    frames += segment.frames;
+    done += segment.state == "done";
+  }
+  const uint64_t total = job.info.frames;
+  json["framesProcessed"] = static_cast<Json::UInt64>(frames);
+  json["totalFrames"] = static_cast<Json::UInt64>(total);
+  json["progress"] =
+      job.state == State::Succeeded
+          ? 1.0
+          : (total > 0 ? round2(std::min(1.0, static_cast<double>(frames) /
+                                                  static_cast<double>(total)))
+                       : 0.0);
+  json["segmentCount"] = static_cast<Json::UInt64>(job.segments.size());
+  json["segmentsDone"] = static_cast<Json::UInt64>(done);
+  json["parallelism"] = static_cast<Json::UInt64>(job.parallelism);
+  json["videoDurationSec"] = round2(job.info.duration_sec);
+  json["videoFps"] = round2(job.info.fps);
+
+  if (!job.segments.empty()) {
+    const bool ended = isFinished(job.state);
+    const double elapsed = elapsedSeconds(
+        job.started, ended && job.finished > job.started ? job.finished
+                                                         : Clock::now());
+    const double fps = elapsed > 0.0 ? static_cast<double>(frames) / elapsed
+                                     : 0.0;
+    json["elapsedSec"] = round2(elapsed);
+    json["framesPerSecond"] = round2(fps);
+    // Video time analysed per wall-clock second
+    json["speedFactor"] = job.info.fps > 0.0 ? round2(fps / job.info.fps) : 0.0;
+    if (!ended && fps > 0.0 && total > frames) {
+      json["etaSec"] = round2(static_cast<double>(total - frames) / fps);
+    }
+  }
+  if (job.state == State::Succeeded) {
+    json["events"] = static_cast<Json::UInt64>(job.events);
+  }
+
+  if (withSegments) {
+    Json::Value segments(Json::arrayValue);
+    for (const auto &state : job.segments) {
+      Json::Value segment;
+      segment["index"] = static_cast<Json::UInt64>(state.segment.index);
+      segment["startSec"] = round2(state.segment.start_sec);
+      segment["endSec"] = round2(state.segment.end_sec);
+      segment["state"] = state.state;
+      segment["frames"] = static_cast<Json::UInt64>(state.frames);
+      segment["expectedFrames"] =
+          static_cast<Json::UInt64>(state.expected_frames);
+      if (state.seconds > 0.0) {
+        segment["framesPerSecond"] =
+            round2(static_cast<double>(state.frames) / state.seconds);
+      }
+      if (!state.error.empty()) {
+        segment["error"] = state.error;
+      }
+      segments.append(segment);
+    }
+    json["segments"] = segments;
+  }
+  return json;
+}
+
+std::optional<Json::Value>
+OfflineJobManager::getJobJson(const std::string &id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto found = jobs_.find(id);
+  if (found == jobs_.end()) {
+    return std::nullopt;
+  }
+  return toJsonLocked(*found->second, true);
+}
+
+Json::Value OfflineJobManager::listJobsJson() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Json::Value list(Json::arrayValue);
+  for (auto it = order_.rbegin(); it != order_.rend(); ++it) {
+    auto found = jobs_.find(*it);
+    if (found != jobs_.end()) {
+      list.append(toJsonLocked(*found->second, false));
+    }
+  }
+  return list;
+}
+
+std::optional<Json::Value>
+OfflineJobManager::getEventsJson(const std::string &id, uint64_t offset,
+                                 uint64_t limit) const {
+  std::string path;
+  Json::Value response;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = jobs_.find(id);
+    if (found == jobs_.end()) {
+      return std::nullopt;
+    }
+    const Job &job = *found->second;
+    response["jobId"] = job.id;
+    response["state"] = stateName(job.state);
+    response["offset"] = static_cast<Json::UInt64>(offset);
+    response["total"] = static_cast<Json::UInt64>(job.events);
+    if (job.state == State::Succeeded) {
+      path = (fs::path(job.dir) / "events.jsonl").string();
+    }
+  }
+
+  Json::Value events(Json::arrayValue);
+  std::ifstream file(path);
+  Json::CharReaderBuilder builder;
+  std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+  std::string line;
+  uint64_t index = 0;
+  while (!path.empty() && events.size() < limit && std::getline(file, line)) {
+    if (index++ < offset) {
+      continue;
+    }
+    Json::Value event;
+    std::string errors;
+    if (reader->parse(line.data(), line.data() + line.size(), &event,
+                      &errors)) {
+      events.append(event);
+    }
+  }
+  response["count"] = static_cast<Json::UInt64>(events.size());
+  response["events"] = events;
+  return response;
+}
+
+void OfflineJobManager::shutdown() {
+  std::vector<std::shared_ptr<Job>> queued;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    accepting_ = false;
+    running_ = false;
+    for (auto &entry : jobs_) {
+      entry.second->cancel = true;
+    }
+    queued.assign(queue_.begin(), queue_.end());
+    queue_.clear();
+  }
+  work_cv_.notify_all();
+  for (auto &job : queued) {
+    finishJob(job, State::Cancelled, "Server shutting down");
+  }
+  for (auto &runner : runners_) {
+    if (runner.joinable()) {
+      runner.join();
+    }
+  }
+  runners_.clear();
+}
@@ -0,0 +1,406 @@
+#include "videos/offline_segment_pipeline.h"
+#include "core/pipeline_builder.h"
+#include "solutions/solution_registry.h"
+#include "videos/video_segmenter.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cvedix/objects/cvedix_frame_target.h>
+#include <iostream>
+#include <json/value.h>
+#include <json/writer.h>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/videoio.hpp>
+#include <thread>
+
+namespace OfflineSegmentPipeline {
+
+namespace {
+
+// Give up on a segment whose pipeline stops consuming frames
+constexpr auto kStallTimeout = std::chrono::seconds(60);
+// After EOF, frames a node dropped never arrive; stop waiting for them
+constexpr auto kDrainTimeout = std::chrono::seconds(2);
+
+double paramDouble(const std::map<std::string, std::string> &params,
+                   const std::string &key, double fallback) {
+  auto it = params.find(key);
+  if (it == params.end() || it->second.empty()) {
+    return fallback;
+  }
+  try {
+    return std::stod(it->second);
+  } catch (const std::exception &) {
+    return fallback;
+  }
+}
+
+std::string toCompactJson(const Json::Value &value) {
+  Json::StreamWriterBuilder builder;
+  builder["indentation"] = "";
+  return Json::writeString(builder, value);
+}
+
+Json::Value targetJson(const cvedix_objects::cvedix_frame_target &target) {
+  Json::Value object;
+  object["trackId"] = target.track_id;
+  object["classId"] = target.primary_class_id;
+  object["label"] = target.primary_label;
+  object["score"] = std::round(target.primary_score * 1000.0) / 1000.0;
+  object["x"] = target.x;
+  object["y"] = target.y;
+  object["width"] = target.width;
+  object["height"] = target.height;
+  return object;
+}
+
+const char *baTypeName(cvedix_objects::cvedix_ba_type type) {
+  switch (type) {
+  case cvedix_objects::cvedix_ba_type::CROSSLINE:
+    return "crossline";
+  case cvedix_objects::cvedix_ba_type::JAM:
+    return "jam";
+  case cvedix_objects::cvedix_ba_type::STOP:
+    return "stop";
+  default:
+    return "other";
+  }
+}
+
+// Nodes that only render, stream or publish: not needed offline
+bool isOutputNode(const std::string &nodeType) {
+  auto endsWith = [&nodeType](const std::string &suffix) {
+    return nodeType.size() >= suffix.size() &&
+           nodeType.compare(nodeType.size() - suffix.size(), suffix.size(),
+                            suffix) == 0;
+  };
+  return endsWith("_des") || nodeType.find("broker") != std::string::npos ||
+         nodeType.find("osd") != std::string::npos;
+}
+
+bool isSourceNode(const std::string &nodeType) {
+  return nodeType.size() > 4 &&
+         nodeType.compare(nodeType.size() - 4, 4, "_src") == 0;
+}
+
+// additionalParams that make PipelineBuilder add sources or outputs
+bool isIoParam(const std::string &key) {
+  static const char *const kPrefixes[] = {"MQTT_", "RTMP_", "RTSP_", "KAFKA_",
+                                          "FILE_PATH"};
+  static const char *const kKeys[] = {"HLS_URL", "HTTP_URL", "UDP_PORT",
+                                      "ENABLE_SCREEN_DES", "RECORD_PATH"};
+  for (const char *prefix : kPrefixes) {
+    if (key.rfind(prefix, 0) == 0) {
+      return true;
+    }
+  }
+  return std::find(std::begin(kKeys), std::end(kKeys), key) != std::end(kKeys);
+}
+
+} // namespace
+
+// ========== OfflineSegmentSourceNode ==========
+
+OfflineSegmentSourceNode::OfflineSegmentSourceNode(
+    const std::string &node_name,
+    const std::map<std::string, std::string> &params)
+    : cvedix_nodes::cvedix_src_node(
+          node_name, static_cast<int>(paramDouble(params, "channel", 0)),
+          1.0f) {
+  auto it = params.find("file_path");
+  if (it != params.end()) {
+    file_path_ = it->second;
+  }
+  start_sec_ = std::max(0.0, paramDouble(params, "start_sec", 0.0));
+  end_sec_ = std::max(0.0, paramDouble(params, "end_sec", 0.0));
+  fps_ = std::max(0.0, paramDouble(params, "fps", 0.0));
+  resize_ratio_ = paramDouble(params, "resize_ratio", 1.0);
+  if (resize_ratio_ <= 0.0 || resize_ratio_ > 1.0) {
+    resize_ratio_ = 1.0;
+  }
+  max_queue_ = static_cast<size_t>(
+      std::max(1.0, paramDouble(params, "max_queue", 32)));
+  if (file_path_.empty()) {
+    throw std::invalid_argument("offline_segment_src requires file_path");
+  }
+  this->initialized();
+}
+
+OfflineSegmentSourceNode::~OfflineSegmentSourceNode() { deinitialized(); }
+
+std::string OfflineSegmentSourceNode::error() const {
+  std::lock_guard<std::mutex> lock(error_mutex_);
+  return error_;
+}
+
+void OfflineSegmentSourceNode::handle_run() {
+  cv::VideoCapture capture;
+  double fps = fps_;
+  int64_t firstFrame = 0;
+  bool opened = false;
+
+  while (alive) {
+    // Blocks while the node is stopped
+    gate.knock();
+    if (!alive) {
+      break;
+    }
+    if (finished_) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      continue;
+    }
+
+    if (!opened) {
+      opened = true;
+      if (!capture.open(file_path_) || !capture.isOpened()) {
+        std::lock_guard<std::mutex> lock(error_mutex_);
+        error_ = "Cannot open " + file_path_;
+        finished_ = true;
+        continue;
+      }
+      if (fps <= 0.0) {
+        fps = capture.get(cv::CAP_PROP_FPS);
+      }
+      if (fps <= 0.0) {
+        fps = 25.0;
+      }
+      original_fps = static_cast<int>(std::lround(fps));
+      original_width = static_cast<int>(capture.get(cv::CAP_PROP_FRAME_WIDTH));
+      original_height =
+          static_cast<int>(capture.get(cv::CAP_PROP_FRAME_HEIGHT));
+      // start_sec is a keyframe, so the seek lands exactly on it
+      if (start_sec_ > 0.0) {
+        capture.set(cv::CAP_PROP_POS_MSEC, start_sec_ * 1000.0);
+      }
+      firstFrame = std::llround(start_sec_ * fps);
+    }
+
+    // No pacing; only wait while downstream is behind
+    if (static_cast<size_t>(out_queue.size()) > max_queue_) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      continue;
+    }
+
+    const int64_t index =
+        firstFrame + static_cast<int64_t>(frames_emitted_.load());
+    cv::Mat frame;
+    if ((end_sec_ > 0.0 && static_cast<double>(index) / fps >= end_sec_) ||
+        !capture.read(frame) || frame.empty()) {
+      capture.release();
+      finished_ = true;
+      continue;
+    }
+    if (resize_ratio_ < 1.0) {
+      cv::Mat resized;
+      cv::resize(frame, resized, cv::Size(), resize_ratio_, resize_ratio_);
+      frame = resized;
+    }
+
+    this->frame_index = static_cast<int>(index);
+    auto out_meta = std::make_shared<cvedix_objects::cvedix_frame_meta>(
+        frame, this->frame_index, this->channel_index, original_width,
+        original_height, original_fps);
+    this->out_queue.push(out_meta);
+    if (this->meta_handled_hooker) {
+      this->meta_handled_hooker(node_name, out_queue.size(), out_meta);
+    }
+    this->out_queue_semaphore.signal();
+    frames_emitted_.fetch_add(1);
+  }
+
+  // Dead flag for the dispatch thread
+  this->out_queue.push(nullptr);
+  this->out_queue_semaphore.signal();
+}
+
+// ========== OfflineCollectorNode ==========
+
+OfflineCollectorNode::OfflineCollectorNode(const std::string &node_name,
+                                           const std::string &output_path,
+                                           double fps, bool include_detections)
+    : cvedix_nodes::cvedix_node(node_name),
+      output_(output_path, std::ios::trunc), fps_(fps > 0.0 ? fps : 25.0),
+      include_detections_(include_detections) {
+  this->initialized();
+}
+
+OfflineCollectorNode::~OfflineCollectorNode() { deinitialized(); }
+
+std::shared_ptr<cvedix_objects::cvedix_meta>
+OfflineCollectorNode::handle_frame_meta(
+    std::shared_ptr<cvedix_objects::cvedix_frame_meta> meta) {
+  const double time = static_cast<double>(meta->frame_index) / fps_;
+  const double roundedTime = std::round(time * 1000.0) / 1000.0;
+
+  for (const auto &ba_res : meta->ba_results) {
+    Json::Value event;
+    event["time"] = roundedTime;
+    event["frameIndex"] = meta->frame_index;
+    event["type"] = baTypeName(ba_res->type);
+    event["label"] = ba_res->ba_label;
+    Json::Value objects(Json::arrayValue);
+    for (int track_id : ba_res->involve_target_ids_in_frame) {
+      for (const auto &target : meta->targets) {
+        if (target->track_id == track_id) {
+          objects.append(targetJson(*target));
+          break;
+        }
+      }
+    }
+    event["objects"] = objects;
+    output_ << VideoSegmenter::formatEventLine(time, toCompactJson(event))
+            << '\n';
+  }
+
+  if (include_detections_ && !meta->targets.empty()) {
+    Json::Value event;
+    event["time"] = roundedTime;
+    event["frameIndex"] = meta->frame_index;
+    event["type"] = "detections";
+    Json::Value objects(Json::arrayValue);
+    for (const auto &target : meta->targets) {
+      objects.append(targetJson(*target));
+    }
+    event["objects"] = objects;
+    output_ << VideoSegmenter::formatEventLine(time, toCompactJson(event))
+            << '\n';
+  }
+
+  frames_seen_.fetch_add(1);
+  return meta;
+}
+
+// ========== processSegment ==========
+
+bool processSegment(const OfflineJobManager::SegmentTask &task,
+                    OfflineJobManager::SegmentProgress &progress,
+                    std::string &error) {
+  auto optSolution =
+      SolutionRegistry::getInstance().getSolution(task.solution_id);
+  if (!optSolution.has_value()) {
+    error = "Solution not found: " + task.solution_id;
+    return false;
+  }
+
+  const std::string instanceId = "offline_" + task.job_id.substr(0, 8) + "_" +
+                                 std::to_string(task.segment.index);
+
+  // Same analysis, segment source, no outputs
+  SolutionConfig solution = optSolution.value();
+  std::vector<SolutionConfig::NodeConfig> pipeline;
+  bool hasSource = false;
+  for (const auto &nodeConfig : solution.pipeline) {
+    if (isSourceNode(nodeConfig.nodeType)) {
+      if (hasSource) {
+        continue;
+      }
+      hasSource = true;
+      SolutionConfig::NodeConfig source;
+      source.nodeType = "offline_segment_src";
+      source.nodeName = "offline_segment_src_{instanceId}";
+      source.parameters["file_path"] = task.video_path;
+      source.parameters["start_sec"] = std::to_string(task.segment.start_sec);
+      source.parameters["fps"] = std::to_string(task.fps);
+      source.parameters["end_sec"] =
+          task.to_end ? "0" : std::to_string(task.segment.end_sec);
+      auto ratio = nodeConfig.parameters.find("resize_ratio");
+      if (ratio != nodeConfig.parameters.end()) {
+        source.parameters["resize_ratio"] = ratio->second;
+      }
+      pipeline.push_back(source);
+    } else if (!isOutputNode(nodeConfig.nodeType)) {
+      pipeline.push_back(nodeConfig);
+    }
+  }
+  if (!hasSource) {
+    error = "Solution " + task.solution_id + " has no source node";
+    return false;
+  }
+  solution.pipeline = pipeline;
+
+  CreateInstanceRequest req;
+  req.name = instanceId;
+  req.solution = task.solution_id;
+  for (const auto &param : task.additional_params) {
+    if (!isIoParam(param.first)) {
+      req.additionalParams[param.first] = param.second;
+    }
+  }
+
+  std::vector<std::shared_ptr<cvedix_nodes::cvedix_node>> nodes;
+  try {
+    PipelineBuilder builder;
+    nodes = builder.buildPipeline(solution, req, instanceId);
+  } catch (const std::exception &e) {
+    error = std::string("Failed to build pipeline: ") + e.what();
+    return false;
+  }
+  std::shared_ptr<OfflineSegmentSourceNode> source =
+      nodes.empty()
+          ? nullptr
+          : std::dynamic_pointer_cast<OfflineSegmentSourceNode>(nodes.front());
+  if (!source) {
+    error = "Pipeline has no offline segment source";
+    return false;
+  }
+
+  auto collector = std::make_shared<OfflineCollectorNode>(
+      "offline_collector_" + instanceId, task.output_path, task.fps,
+      task.include_detections);
+  if (!collector->ok()) {
+    error = "Cannot write " + task.output_path;
+    source->detach_recursively();
+    return false;
+  }
+  collector->attach_to({nodes.back()});
+
+  source->start();
+  uint64_t lastFrames = 0;
+  auto lastChange = std::chrono::steady_clock::now();
+  bool cancelled = false;
+  while (true) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    const uint64_t frames = collector->framesSeen();
+    progress.setFrames(frames);
+    if (progress.cancelled()) {
+      cancelled = true;
+      break;
+    }
+    // Done once every emitted frame has reached the end of the pipeline
+    if (source->finished() && frames >= source->framesEmitted()) {
+      break;
+    }
+    if (frames != lastFrames) {
+      lastFrames = frames;
+      lastChange = std::chrono::steady_clock::now();
+    } else if (source->finished() &&
+               std::chrono::steady_clock::now() - lastChange > kDrainTimeout) {
+      break;
+    } else if (std::chrono::steady_clock::now() - lastChange >
+               kStallTimeout) {
+      error = "Pipeline stalled at frame " + std::to_string(frames);
+      break;
+    }
+  }
+
+  source->stop();
+  source->detach_recursively();
+  progress.setFrames(collector->framesSeen());
+
+  if (cancelled) {
+    error = "Cancelled";
+    return false;
+  }
+  if (error.empty()) {
+    error = source->error();
+  }
+  if (!error.empty()) {
+    std::cerr << "[OfflineSegmentPipeline] Segment " << task.segment.index
+              << " of job " << task.job_id << " failed: " << error
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+} // namespace OfflineSegmentPipeline
@@ -0,0 +1,280 @@
+#include "videos/video_job_handler.h"
+#include "core/cors_helper.h"
+#include "core/logger.h"
+#include "core/logging_flags.h"
+#include "core/metrics_interceptor.h"
+#include "solutions/solution_registry.h"
+#include "videos/offline_job_manager.h"
+#include <drogon/HttpResponse.h>
+#include <filesystem>
+
+std::string VideoJobHandler::videos_dir_ = "./videos";
+
+namespace {
+
+constexpr uint64_t kDefaultEventsLimit = 1000;
+constexpr uint64_t kMaxEventsLimit = 10000;
+
+uint64_t queryNumber(const HttpRequestPtr &req, const std::string &key,
+                     uint64_t fallback) {
+  std::string value = req->getParameter(key);
+  if (value.empty() ||
+      value.find_first_not_of("0123456789") != std::string::npos) {
+    return fallback;
+  }
+  try {
+    return std::stoull(value);
+  } catch (const std::exception &) {
+    return fallback;
+  }
+}
+
+HttpResponsePtr jsonResponse(const Json::Value &body, HttpStatusCode status) {
+  auto resp = HttpResponse::newHttpJsonResponse(body);
+  resp->setStatusCode(status);
+  CorsHelper::addAllowAllHeaders(resp);
+  return resp;
+}
+
+} // namespace
+
+void VideoJobHandler::setVideosDirectory(const std::string &dir) {
+  videos_dir_ = dir;
+}
+
+std::string VideoJobHandler::extractJobId(const HttpRequestPtr &req) const {
+  std::string jobId = req->getParameter("jobId");
+  if (jobId.empty()) {
+    std::string path = req->getPath();
+    size_t jobsPos = path.find("/jobs/");
+    if (jobsPos != std::string::npos) {
+      size_t start = jobsPos + 6; // length of "/jobs/"
+      size_t end = path.find("/", start);
+      if (end == std::string::npos) {
+        end = path.length();
+      }
+      jobId = path.substr(start, end - start);
+    }
+  }
+  return jobId;
+}
+
+std::string
+VideoJobHandler::resolveVideoPath(const std::string &video) const {
+  std::filesystem::path relative(video);
+  if (video.empty() || relative.is_absolute()) {
+    return "";
+  }
+  for (const auto &part : relative) {
+    if (part == "..") {
+      return "";
+    }
+  }
+  return (std::filesystem::path(videos_dir_) / relative).string();
+}
+
+void VideoJobHandler::createJob(
+    const HttpRequestPtr &req,
+    std::function<void(const HttpResponsePtr &)> &&callback) {
+  MetricsInterceptor::setHandlerStartTime(req);
+
+  if (isApiLoggingEnabled()) {
+    PLOG_INFO << "[API] POST /v1/core/video/jobs - Create offline job";
+  }
+
+  try {
+    auto json = req->getJsonObject();
+    if (!json || !json->isObject()) {
+      callback(createErrorResponse(400, "Invalid request",
+                                   "Request body must be a JSON object"));
+      return;
+    }
+    const Json::Value &body = *json;
+
+    OfflineJobManager::JobRequest request;
+    request.video_name = body.get("video", "").asString();
+    request.video_path = resolveVideoPath(request.video_name);
+    if (request.video_path.empty()) {
+      callback(createErrorResponse(
+          400, "Invalid request",
+          "video must be a file name relative to the videos directory"));
+      return;
+    }
+
+    request.solution_id = body.get("solutionId", "").asString();
+    if (request.solution_id.empty()) {
+      callback(
+          createErrorResponse(400, "Invalid request", "solutionId is required"));
+      return;
+    }
+    if (!SolutionRegistry::getInstance()
+             .getSolution(request.solution_id)
+             .has_value()) {
+      callback(createErrorResponse(404, "Not found",
+                                   "Solution not found: " +
+                                       request.solution_id));
+      return;
+    }
+
+    if (body.isMember("additionalParams")) {
+      if (!body["additionalParams"].isObject()) {
+        callback(createErrorResponse(400, "Invalid request",
+                                     "additionalParams must be an object"));
+        return;
+      }
+      for (const auto &key : body["additionalParams"].getMemberNames()) {
+        const Json::Value &value = body["additionalParams"][key];
+        request.additional_params[key] =
+            value.isString() ? value.asString() : value.toStyledString();
+      }
+    }
+
+    for (const char *key : {"segments", "parallelism"}) {
+      if (body.isMember(key) &&
+          (!body[key].isIntegral() || body[key].asInt64() < 1 ||
+           body[key].asInt64() > 1024)) {
+        callback(createErrorResponse(
+            400, "Invalid request",
+            std::string(key) + " must be an integer between 1 and 1024"));
+        return;
+      }
+    }
+    request.segments = body.get("segments", 0).asUInt();
+    request.parallelism = body.get("parallelism", 0).asUInt();
+    request.include_detections = body.get("includeDetections", true).asBool();
+
+    std::string error;
+    std::string jobId = OfflineJobManager::getInstance().submit(request, error);
+    if (jobId.empty()) {
+      if (isApiLoggingEnabled()) {
+        PLOG_WARNING << "[API] POST /v1/core/video/jobs - Rejected: " << error;
+      }
+      bool missing = error.rfind("Video file not found", 0) == 0;
+      callback(createErrorResponse(missing ? 404 : 503,
+                                   missing ? "Not found"
+                                           : "Service unavailable",
+                                   error));
+      return;
+    }
+
+    if (isApiLoggingEnabled()) {
+      PLOG_INFO << "[API] POST /v1/core/video/jobs - Queued job " << jobId
+                << " (" << request.video_name << ", "
+                << request.solution_id << ")";
+    }
+    auto job = OfflineJobManager::getInstance().getJobJson(jobId);
+    auto resp = jsonResponse(job.value_or(Json::Value()), k202Accepted);
+    resp->addHeader("Location", "/v1/core/video/jobs/" + jobId);
+    callback(resp);
+  } catch (const std::exception &e) {
+    if (isApiLoggingEnabled()) {
+      PLOG_ERROR << "[API] POST /v1/core/video/jobs - Exception: " << e.what();
+    }
+    callback(createErrorResponse(500, "Internal server error", e.what()));
+  }
+}
+
+void VideoJobHandler::listJobs(
+    const HttpRequestPtr &req,
+    std::function<void(const HttpResponsePtr &)> &&callback) {
+  MetricsInterceptor::setHandlerStartTime(req);
+
+  Json::Value response;
+  response["jobs"] = OfflineJobManager::getInstance().listJobsJson();
+  response["total"] = response["jobs"].size();
+  callback(jsonResponse(response, k200OK));
+}
+
+void VideoJobHandler::getJob(
+    const HttpRequestPtr &req,
+    std::function<void(const HttpResponsePtr &)> &&callback) {
+  MetricsInterceptor::setHandlerStartTime(req);
+
+  std::string jobId = extractJobId(req);
+  auto job = OfflineJobManager::getInstance().getJobJson(jobId);
+  if (!job.has_value()) {
+    callback(createErrorResponse(404, "Not found", "Job not found: " + jobId));
+    return;
+  }
+  callback(jsonResponse(*job, k200OK));
+}
+
+void VideoJobHandler::getJobEvents(
+    const HttpRequestPtr &req,
+    std::function<void(const HttpResponsePtr &)> &&callback) {
+  MetricsInterceptor::setHandlerStartTime(req);
+
+  std::string jobId = extractJobId(req);
+  uint64_t offset = queryNumber(req, "offset", 0);
+  uint64_t limit = std::min(queryNumber(req, "limit", kDefaultEventsLimit),
+                            kMaxEventsLimit);
+
+  try {
+    auto events =
+        OfflineJobManager::getInstance().getEventsJson(jobId, offset, limit);
+    if (!events.has_value()) {
+      callback(
+          createErrorResponse(404, "Not found", "Job not found: " + jobId));
+      return;
+    }
+    if ((*events)["state"].asString() != "succeeded") {
+      callback(createErrorResponse(
+          409, "Conflict",
+          "Events are available once the job has succeeded (state: " +
+              (*events)["state"].asString() + ")"));
+      return;
+    }
+    callback(jsonResponse(*events, k200OK));
+  } catch (const std::exception &e) {
+    if (isApiLoggingEnabled()) {
+      PLOG_ERROR << "[API] GET /v1/core/video/jobs/" << jobId
+                 << "/events - Exception: " << e.what();
+    }
+    callback(createErrorResponse(500, "Internal server error", e.what()));
+  }
+}
+
+void VideoJobHandler::deleteJob(
+    const HttpRequestPtr &req,
+    std::function<void(const HttpResponsePtr &)> &&callback) {
+  MetricsInterceptor::setHandlerStartTime(req);
+
+  std::string jobId = extractJobId(req);
+  if (isApiLoggingEnabled()) {
+    PLOG_INFO << "[API] DELETE /v1/core/video/jobs/" << jobId;
+  }
+  if (!OfflineJobManager::getInstance().cancelOrDelete(jobId)) {
+    callback(createErrorResponse(404, "Not found", "Job not found: " + jobId));
+    return;
+  }
+
+  // Still listed when it was cancelled rather than deleted
+  auto job = OfflineJobManager::getInstance().getJobJson(jobId);
+  Json::Value response;
+  response["success"] = true;
+  response["jobId"] = jobId;
+  response["deleted"] = !job.has_value();
+  if (job.has_value()) {
+    response["state"] = (*job)["state"];
+  }
+  callback(jsonResponse(response, k200OK));
+}
+
+void VideoJobHandler::handleOptions(
+    const HttpRequestPtr &req,
+    std::function<void(const HttpResponsePtr &)> &&callback) {
+  MetricsInterceptor::setHandlerStartTime(req);
+  callback(CorsHelper::createOptionsResponse());
+}
+
+HttpResponsePtr
+VideoJobHandler::createErrorResponse(int statusCode, const std::string &error,
+                                     const std::string &message) const {
+  Json::Value errorJson;
+  errorJson["success"] = false;
+  errorJson["error"] = error;
+  if (!message.empty()) {
+    errorJson["message"] = message;
+  }
+  return jsonResponse(errorJson, static_cast<HttpStatusCode>(statusCode));
+}
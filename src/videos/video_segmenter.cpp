@@ -0,0 +1,126 @@
+#include "videos/video_segmenter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <queue>
+#include <sstream>
+
+namespace VideoSegmenter {
+
+namespace {
+
+// Parses the leading number of a line; false for N/A, blank, etc.
+bool parseTime(const std::string &text, double &value) {
+  const char *begin = text.c_str();
+  char *end = nullptr;
+  value = std::strtod(begin, &end);
+  return end != begin && std::isfinite(value);
+}
+
+} // namespace
+
+std::vector<double> parseKeyframeTimes(const std::string &output) {
+  std::vector<double> times;
+  std::istringstream stream(output);
+  std::string line;
+  while (std::getline(stream, line)) {
+    size_t comma = line.find(',');
+    if (comma != std::string::npos &&
+        line.find('K', comma + 1) == std::string::npos) {
+      continue; // Packet line without the keyframe flag
+    }
+    double value = 0.0;
+    if (parseTime(line.substr(0, comma), value) && value >= 0.0) {
+      times.push_back(value);
+    }
+  }
+  std::sort(times.begin(), times.end());
+  times.erase(std::unique(times.begin(), times.end()), times.end());
+  return times;
+}
+
+std::vector<Segment> planSegments(const std::vector<double> &keyframes,
+                                  double duration_sec, size_t target_count,
+                                  double min_segment_sec) {
+  std::vector<double> boundaries{0.0};
+  if (duration_sec > 0.0 && target_count > 1 && !keyframes.empty()) {
+    for (size_t i = 1; i < target_count; ++i) {
+      const double ideal = duration_sec * static_cast<double>(i) /
+                           static_cast<double>(target_count);
+      // Nearest keyframe to the even split point
+      auto it = std::lower_bound(keyframes.begin(), keyframes.end(), ideal);
+      double best = it == keyframes.end() ? keyframes.back() : *it;
+      if (it != keyframes.begin() &&
+          (it == keyframes.end() || ideal - *(it - 1) < *it - ideal)) {
+        best = *(it - 1);
+      }
+      if (best - boundaries.back() >= min_segment_sec &&
+          duration_sec - best >= min_segment_sec) {
+        boundaries.push_back(best);
+      }
+    }
+  }
+
+  std::vector<Segment> segments;
+  segments.reserve(boundaries.size());
+  for (size_t i = 0; i < boundaries.size(); ++i) {
+    Segment segment;
+    segment.index = i;
+    segment.start_sec = boundaries[i];
+    segment.end_sec = i + 1 < boundaries.size()
+                          ? boundaries[i + 1]
+                          : std::max(duration_sec, boundaries[i]);
+    segments.push_back(segment);
+  }
+  return segments;
+}
+
+std::string formatEventLine(double time_sec, const std::string &json) {
+  std::ostringstream line;
+  line << std::fixed << std::setprecision(3) << time_sec << '\t' << json;
+  return line.str();
+}
+
+uint64_t mergeEventStreams(const std::vector<std::istream *> &inputs,
+                           std::ostream &output) {
+  struct Head {
+    double time;
+    size_t stream;
+    std::string json;
+  };
+  // Min-heap on (time, stream); each stream contributes one head at a time
+  // so line order within a stream is preserved
+  auto later = [](const Head &a, const Head &b) {
+    return a.time != b.time ? a.time > b.time : a.stream > b.stream;
+  };
+  std::priority_queue<Head, std::vector<Head>, decltype(later)> heads(later);
+
+  auto advance = [&inputs, &heads](size_t stream) {
+    std::string line;
+    while (inputs[stream] && std::getline(*inputs[stream], line)) {
+      size_t tab = line.find('\t');
+      double time = 0.0;
+      if (tab == std::string::npos || !parseTime(line.substr(0, tab), time)) {
+        continue;
+      }
+      heads.push({time, stream, line.substr(tab + 1)});
+      return;
+    }
+  };
+
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    advance(i);
+  }
+  uint64_t written = 0;
+  while (!heads.empty()) {
+    Head head = heads.top();
+    heads.pop();
+    output << head.json << '\n';
+    ++written;
+    advance(head.stream);
+  }
+  return written;
+}
+
+} // namespace VideoSegmenter
@@ -0,0 +1,544 @@
+#include "worker/cpu_placement.h"
+#include "core/env_config.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+
+namespace worker {
+
+namespace {
+
+const int MPOL_PREFERRED_MODE = 1; // MPOL_PREFERRED from <numaif.h>
+
+std::string readFile(const std::string &path) {
+  std::ifstream file(path);
+  if (!file) {
+    return "";
+  }
+  std::ostringstream oss;
+  oss << file.rdbuf();
+  return oss.str();
+}
+
+int readInt(const std::string &path, int default_value) {
+  std::string content = readFile(path);
+  try {
+    return content.empty() ? default_value : std::stoi(content);
+  } catch (const std::exception &) {
+    return default_value;
+  }
+}
+
+const char *policyName(CpuPlacement::Policy policy) {
+  switch (policy) {
+  case CpuPlacement::Policy::Pack:
+    return "pack";
+  case CpuPlacement::Policy::Spread:
+    return "spread";
+  default:
+    return "none";
+  }
+}
+
+} // namespace
+
+std::vector<int> CpuPlacement::parseCpuList(const std::string &list) {
+  std::vector<int> cpus;
+  std::istringstream iss(list);
+  std::string range;
+  while (std::getline(iss, range, ',')) {
+    range.erase(std::remove_if(range.begin(), range.end(), ::isspace),
+                range.end());
+    if (range.empty()) {
+      continue;
+    }
+    try {
+      auto dash = range.find('-');
+      int first = std::stoi(range.substr(0, dash));
+      int last = dash == std::string::npos ? first
+                                           : std::stoi(range.substr(dash + 1));
+      for (int cpu = first; cpu <= last && cpu < CPU_SETSIZE; ++cpu) {
+        if (cpu >= 0) {
+          cpus.push_back(cpu);
+        }
+      }
+    } catch (const std::exception &) {
+      std::cerr << "[CpuPlacement] Ignoring invalid CPU range '" << range
+                << "'" << std::endl;
+    }
+  }
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  return cpus;
+}
+
+std::string CpuPlacement::formatCpuList(const std::vector<int> &cpus) {
+  std::string list;
+  for (size_t i = 0; i < cpus.size();) {
+    size_t j = i;
+    while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) {
+      ++j;
+    }
+    if (!list.empty()) {
+      list += ",";
+    }
+    list += std::to_string(cpus[i]);
+    if (j > i) {
+      list += "-" + std::to_string(cpus[j]);
+    }
+    i = j + 1;
+  }
+  return list;
+}
+
+cpu_set_t CpuPlacement::toMask(const std::vector<int> &cpus) {
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  for (int cpu : cpus) {
+    CPU_SET(cpu, &mask);
+  }
+  return mask;
+}
+
+std::vector<CpuPlacement::Cpu> CpuPlacement::readTopology() {
+  const std::string base = "/sys/devices/system/cpu/";
+  std::vector<int> online = parseCpuList(readFile(base + "online"));
+  if (online.empty()) {
+    unsigned count = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned cpu = 0; cpu < count; ++cpu) {
+      online.push_back(static_cast<int>(cpu));
+    }
+  }
+
+  std::map<int, int> nodeOf;
+  std::error_code ec;
+  for (const auto &entry : std::filesystem::directory_iterator(
+           "/sys/devices/system/node", ec)) {
+    std::string name = entry.path().filename().string();
+    if (name.rfind("node", 0) != 0 || name.size() == 4 ||
+        !std::isdigit(static_cast<unsigned char>(name[4]))) {
+      continue;
+    }
+    int node = std::stoi(name.substr(4));
+    for (int cpu : parseCpuList(readFile(entry.path().string() + "/cpulist"))) {
+      nodeOf[cpu] = node;
+    }
+  }
+
+  // cpu_capacity (arm64) describes big.LITTLE directly; otherwise fall back
+  // to the relative maximum frequency
+  std::vector<Cpu> cpus;
+  int maxFreq = 0;
+  bool haveCapacity = true;
+  for (int id : online) {
+    std::string dir = base + "cpu" + std::to_string(id) + "/";
+    Cpu cpu;
+    cpu.id = id;
+    cpu.node = nodeOf.count(id) ? nodeOf[id] : 0;
+    cpu.capacity = readInt(dir + "cpu_capacity", -1);
+    if (cpu.capacity <= 0) {
+      haveCapacity = false;
+      cpu.capacity = readInt(dir + "cpufreq/cpuinfo_max_freq", 0);
+      maxFreq = std::max(maxFreq, cpu.capacity);
+    }
+    cpus.push_back(cpu);
+  }
+  if (!haveCapacity) {
+    for (auto &cpu : cpus) {
+      cpu.capacity = (maxFreq > 0 && cpu.capacity > 0)
+                         ? std::max(1, cpu.capacity * 1024 / maxFreq)
+                         : 1024;
+    }
+  }
+  return cpus;
+}
+
+void CpuPlacement::initialize() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (initialized_) {
+    return;
+  }
+
+  Config config;
+  std::string policy = EnvConfig::getString("EDGE_AI_WORKER_PLACEMENT", "none");
+  if (policy == "pack") {
+    config.policy = Policy::Pack;
+  } else if (policy == "spread") {
+    config.policy = Policy::Spread;
+  } else if (policy != "none") {
+    std::cerr << "[CpuPlacement] Unknown EDGE_AI_WORKER_PLACEMENT '" << policy
+              << "' (expected none, pack or spread), placement disabled"
+              << std::endl;
+  }
+  config.reserved_cpus =
+      parseCpuList(EnvConfig::getString("EDGE_AI_RESERVED_CPUS", ""));
+  config.cpus_per_worker = EnvConfig::getInt("EDGE_AI_CPUS_PER_WORKER", 2, 1,
+                                             CPU_SETSIZE);
+  config.workers_per_cpu =
+      EnvConfig::getInt("EDGE_AI_WORKERS_PER_CPU", 1, 1, 64);
+
+  configureLocked(config, readTopology());
+
+  if (!config_.reserved_cpus.empty()) {
+    // Threads created later (Drogon I/O loops, ...) inherit this mask
+    if (applyToProcess(getpid(), config_.reserved_cpus)) {
+      std::cout << "[CpuPlacement] API process pinned to CPUs "
+                << formatCpuList(config_.reserved_cpus) << std::endl;
+    }
+  }
+  if (config_.policy != Policy::None) {
+    std::cout << "[CpuPlacement] Policy " << policyName(config_.policy)
+              << ", " << config_.cpus_per_worker << " CPU(s) per worker, "
+              << cpus_.size() << " CPU(s) available for workers" << std::endl;
+  }
+}
+
+void CpuPlacement::configure(const Config &config,
+                             const std::vector<Cpu> &cpus) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  configureLocked(config, cpus);
+}
+
+void CpuPlacement::configureLocked(const Config &config,
+                                   const std::vector<Cpu> &cpus) {
+  initialized_ = true;
+  config_ = config;
+  cpus_.clear();
+  for (const auto &cpu : cpus) {
+    if (std::find(config.reserved_cpus.begin(), config.reserved_cpus.end(),
+                  cpu.id) == config.reserved_cpus.end()) {
+      cpus_.push_back(cpu);
+    }
+  }
+  if (cpus_.empty()) {
+    std::cerr << "[CpuPlacement] EDGE_AI_RESERVED_CPUS leaves no CPU for "
+                 "workers, ignoring it"
+              << std::endl;
+    cpus_ = cpus;
+    config_.reserved_cpus.clear();
+  }
+  load_.clear();
+  placed_.clear();
+}
+
+double CpuPlacement::costLocked(const std::vector<int> &cpus) const {
+  if (cpus.empty()) {
+    return 0.0;
+  }
+  double cost = 0.0;
+  for (int id : cpus) {
+    auto it = std::find_if(cpus_.begin(), cpus_.end(),
+                           [id](const Cpu &cpu) { return cpu.id == id; });
+    int capacity = it != cpus_.end() ? std::max(1, it->capacity) : 1024;
+    auto load = load_.find(id);
+    int workers = load != load_.end() ? load->second : 0;
+    cost += (workers + 1) * 1024.0 / capacity;
+  }
+  return cost / cpus.size();
+}
+
+CpuPlacement::Assignment CpuPlacement::chooseLocked(int only_node) const {
+  std::map<int, std::vector<const Cpu *>> nodes;
+  for (const auto &cpu : cpus_) {
+    if (only_node < 0 || cpu.node == only_node) {
+      nodes[cpu.node].push_back(&cpu);
+    }
+  }
+
+  auto loadOf = [this](int id) {
+    auto it = load_.find(id);
+    return it != load_.end() ? it->second : 0;
+  };
+
+  Assignment best;
+  double bestCost = 0.0;
+  for (auto &[node, members] : nodes) {
+    // Spread: cheapest CPUs (least load per unit of capacity). Pack: fill
+    // CPUs that still have room, biggest cores first.
+    bool pack = config_.policy == Policy::Pack;
+    int limit = config_.workers_per_cpu;
+    std::sort(members.begin(), members.end(),
+              [&loadOf, pack, limit](const Cpu *a, const Cpu *b) {
+                int loadA = loadOf(a->id);
+                int loadB = loadOf(b->id);
+                if (pack) {
+                  bool roomA = loadA < limit;
+                  bool roomB = loadB < limit;
+                  if (roomA != roomB) {
+                    return roomA;
+                  }
+                  if (roomA && loadA != loadB) {
+                    return loadA > loadB;
+                  }
+                  if (a->capacity != b->capacity) {
+                    return a->capacity > b->capacity;
+                  }
+                }
+                double costA = (loadA + 1) * 1024.0 / std::max(1, a->capacity);
+                double costB = (loadB + 1) * 1024.0 / std::max(1, b->capacity);
+                return costA != costB ? costA < costB : a->id < b->id;
+              });
+    size_t count = std::min<size_t>(config_.cpus_per_worker, members.size());
+    Assignment candidate;
+    candidate.node = node;
+    bool fits = true;
+    for (size_t i = 0; i < count; ++i) {
+      candidate.cpus.push_back(members[i]->id);
+      fits = fits && loadOf(members[i]->id) < config_.workers_per_cpu;
+    }
+    std::sort(candidate.cpus.begin(), candidate.cpus.end());
+    double cost = costLocked(candidate.cpus);
+
+    if (pack && fits) {
+      best = candidate; // Lowest node with room
+      break;
+    }
+    if (best.cpus.empty() || cost < bestCost) {
+      best = candidate;
+      bestCost = cost;
+    }
+  }
+
+  if (nodes.size() <= 1 && only_node < 0) {
+    best.node = -1; // Single node: no memory policy needed
+  }
+  return best;
+}
+
+void CpuPlacement::addLoadLocked(const Assignment &assignment, int delta) {
+  for (int cpu : assignment.cpus) {
+    load_[cpu] += delta;
+  }
+}
+
+CpuPlacement::Assignment CpuPlacement::assign(const std::string &instance_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = placed_.find(instance_id);
+  if (it != placed_.end()) {
+    return it->second.assignment;
+  }
+
+  Assignment assignment;
+  if (config_.policy == Policy::None) {
+    // Only keep workers off the reserved CPUs (they would otherwise
+    // inherit the API process' mask)
+    if (!config_.reserved_cpus.empty()) {
+      for (const auto &cpu : cpus_) {
+        assignment.cpus.push_back(cpu.id);
+      }
+    }
+    return assignment;
+  }
+
+  assignment = chooseLocked();
+  addLoadLocked(assignment, 1);
+  placed_[instance_id] = Placed{next_seq_++, assignment};
+  return assignment;
+}
+
+std::vector<CpuPlacement::Move>
+CpuPlacement::release(const std::string &instance_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = placed_.find(instance_id);
+  if (it == placed_.end()) {
+    return {};
+  }
+  addLoadLocked(it->second.assignment, -1);
+  placed_.erase(it);
+
+  // Newest first (the ones that were squeezed in last), each worker moves
+  // only if that makes it cheaper
+  std::vector<std::pair<uint64_t, std::string>> order;
+  for (const auto &[id, placed] : placed_) {
+    order.emplace_back(placed.seq, id);
+  }
+  std::sort(order.rbegin(), order.rend());
+
+  std::vector<Move> moves;
+  for (const auto &[seq, id] : order) {
+    Assignment &current = placed_[id].assignment;
+    addLoadLocked(current, -1);
+    Assignment candidate = chooseLocked(current.node);
+    candidate.node = current.node;
+    if (candidate.cpus != current.cpus &&
+        costLocked(candidate.cpus) < costLocked(current.cpus) - 1e-9) {
+      current = candidate;
+      moves.push_back(Move{id, current});
+    }
+    addLoadLocked(current, 1);
+  }
+  return moves;
+}
+
+std::optional<CpuPlacement::Assignment>
+CpuPlacement::getAssignment(const std::string &instance_id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = placed_.find(instance_id);
+  if (it == placed_.end()) {
+    return std::nullopt;
+  }
+  return it->second.assignment;
+}
+
+void CpuPlacement::applyInChild(const cpu_set_t &mask, int node) {
+  if (CPU_COUNT(&mask) > 0) {
+    sched_setaffinity(0, sizeof(mask), &mask);
+  }
+  if (node >= 0 && node < 1024) {
+    unsigned long nodemask[1024 / (8 * sizeof(unsigned long))] = {};
+    nodemask[node / (8 * sizeof(unsigned long))] |=
+        1UL << (node % (8 * sizeof(unsigned long)));
+    syscall(SYS_set_mempolicy, MPOL_PREFERRED_MODE, nodemask,
+            sizeof(nodemask) * 8);
+  }
+}
+
+bool CpuPlacement::applyToProcess(pid_t pid, const std::vector<int> &cpus) {
+  if (cpus.empty()) {
+    return false;
+  }
+  cpu_set_t mask = toMask(cpus);
+  bool ok = true;
+  std::error_code ec;
+  std::filesystem::directory_iterator tasks(
+      "/proc/" + std::to_string(pid) + "/task", ec);
+  if (ec) {
+    return false;
+  }
+  for (const auto &task : tasks) {
+    pid_t tid = 0;
+    try {
+      tid = static_cast<pid_t>(std::stoi(task.path().filename().string()));
+    } catch (const std::exception &) {
+      continue;
+    }
+    // A thread may exit meanwhile; only report real failures
+    if (sched_setaffinity(tid, sizeof(mask), &mask) != 0 && errno != ESRCH) {
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+std::unordered_map<int, double>
+CpuPlacement::sampleUtilization(CpuTimes &previous) {
+  std::unordered_map<int, double> utilization;
+  std::istringstream stat(readFile("/proc/stat"));
+  std::string line;
+
+  while (std::getline(stat, line)) {
+    if (line.size() < 4 || line.compare(0, 3, "cpu") != 0 ||
+        !std::isdigit(static_cast<unsigned char>(line[3]))) {
+      continue;
+    }
+    std::istringstream fields(line.substr(3));
+    int cpu = 0;
+    uint64_t value = 0, total = 0, idle = 0;
+    fields >> cpu;
+    // user nice system idle iowait irq softirq steal
+    for (int i = 0; i < 8 && fields >> value; ++i) {
+      total += value;
+      if (i == 3 || i == 4) {
+        idle += value;
+      }
+    }
+
+    auto &last = previous[cpu];
+    uint64_t dTotal = total - last.first;
+    uint64_t dIdle = idle - last.second;
+    utilization[cpu] =
+        dTotal > 0 ? 1.0 - static_cast<double>(dIdle) / dTotal : 0.0;
+    last = {total, idle};
+  }
+  return utilization;
+}
+
+Json::Value CpuPlacement::getStatsJson() {
+  std::unordered_map<int, double> utilization;
+  {
+    std::lock_guard<std::mutex> lock(sample_mutex_);
+    utilization = sampleUtilization(stats_sample_);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  Json::Value json;
+  json["policy"] = policyName(config_.policy);
+  json["reservedCpus"] = formatCpuList(config_.reserved_cpus);
+  json["cpusPerWorker"] = config_.cpus_per_worker;
+
+  Json::Value cpus(Json::arrayValue);
+  std::map<int, Json::Value> byId;
+  for (const auto &[id, busy] : utilization) {
+    Json::Value cpu;
+    cpu["cpu"] = id;
+    cpu["utilization"] = busy;
+    cpu["reserved"] = std::find(config_.reserved_cpus.begin(),
+                                config_.reserved_cpus.end(),
+                                id) != config_.reserved_cpus.end();
+    byId[id] = cpu;
+  }
+  for (const auto &cpu : cpus_) {
+    Json::Value &entry = byId[cpu.id];
+    entry["cpu"] = cpu.id;
+    entry["node"] = cpu.node;
+    entry["capacity"] = cpu.capacity;
+    auto load = load_.find(cpu.id);
+    entry["workers"] = load != load_.end() ? load->second : 0;
+  }
+  for (auto &[id, cpu] : byId) {
+    cpus.append(cpu);
+  }
+  json["cpus"] = cpus;
+
+  Json::Value workers(Json::objectValue);
+  for (const auto &[id, placed] : placed_) {
+    Json::Value worker;
+    worker["cpus"] = formatCpuList(placed.assignment.cpus);
+    worker["node"] = placed.assignment.node;
+    workers[id] = worker;
+  }
+  json["workers"] = workers;
+  return json;
+}
+
+std::string CpuPlacement::getPrometheusMetrics() {
+  std::map<int, double> sorted;
+  {
+    std::lock_guard<std::mutex> lock(sample_mutex_);
+    auto utilization = sampleUtilization(metrics_sample_);
+    sorted.insert(utilization.begin(), utilization.end());
+  }
+
+  std::ostringstream oss;
+  oss << "# HELP cpu_core_utilization_ratio Busy fraction of each CPU since "
+         "the previous scrape\n";
+  oss << "# TYPE cpu_core_utilization_ratio gauge\n";
+  for (const auto &[cpu, busy] : sorted) {
+    oss << "cpu_core_utilization_ratio{cpu=\"" << cpu << "\"} " << busy
+        << "\n";
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (config_.policy != Policy::None) {
+    oss << "# HELP worker_placement_cpu_workers Workers pinned to each CPU\n";
+    oss << "# TYPE worker_placement_cpu_workers gauge\n";
+    for (const auto &cpu : cpus_) {
+      auto load = load_.find(cpu.id);
+      oss << "worker_placement_cpu_workers{cpu=\"" << cpu.id << "\",node=\""
+          << cpu.node << "\"} " << (load != load_.end() ? load->second : 0)
+          << "\n";
+    }
+  }
+  oss << "\n";
+  return oss.str();
+}
+
+} // namespace worker
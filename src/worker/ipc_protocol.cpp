@@ -132,4 +132,44 @@ Json::Value createErrorResponse(const std::string &error,
   return response;
 }
 
+bool isPushEvent(MessageType type) {
+  switch (type) {
+  case MessageType::INSTANCE_STATE_CHANGED:
+  case MessageType::INSTANCE_ERROR:
+  case MessageType::WORKER_MEMORY_WARNING:
+  case MessageType::STATISTICS_UPDATE:
+    return true;
+  default:
+    return false;
+  }
+}
+
+Json::Value diffStatistics(const Json::Value &previous,
+                           const Json::Value &current) {
+  Json::Value delta(Json::objectValue);
+  if (!current.isObject()) {
+    return delta;
+  }
+  for (const auto &key : current.getMemberNames()) {
+    const Json::Value &value = current[key];
+    if (!previous.isObject() || !previous.isMember(key) ||
+        previous[key] != value) {
+      delta[key] = value;
+    }
+  }
+  return delta;
+}
+
+void applyStatisticsDelta(Json::Value &snapshot, const Json::Value &delta) {
+  if (!delta.isObject()) {
+    return;
+  }
+  if (!snapshot.isObject()) {
+    snapshot = Json::Value(Json::objectValue);
+  }
+  for (const auto &key : delta.getMemberNames()) {
+    snapshot[key] = delta[key];
+  }
+}
+
 } // namespace worker
@@ -146,6 +146,9 @@ void UnixSocketServer::acceptLoop() {
       on_client_connected_(client_fd);
     }
 
+    // Events may only be pushed after WORKER_READY went out
+    client_fd_.store(client_fd);
+
     // Handle client in same thread (single client expected per worker)
     handleClient(client_fd);
   }
@@ -179,7 +182,7 @@ void UnixSocketServer::handleClient(int client_fd) {
           continue;
         }
         // Error or connection closed
-        close(client_fd);
+        releaseClient(client_fd);
         return;
       }
 
@@ -190,12 +193,12 @@ void UnixSocketServer::handleClient(int client_fd) {
                MessageHeader::HEADER_SIZE - total_received, 0);
       if (n < 0) {
         // Error - connection closed or error
-        close(client_fd);
+        releaseClient(client_fd);
         return;
       }
       if (n == 0) {
         // Connection closed
-        close(client_fd);
+        releaseClient(client_fd);
         return;
       }
       total_received += n;
@@ -225,7 +228,7 @@ void UnixSocketServer::handleClient(int client_fd) {
           if (ret == 0) {
             continue; // Timeout - check running_ flag
           }
-          close(client_fd);
+          releaseClient(client_fd);
           return;
         }
 
@@ -233,12 +236,12 @@ void UnixSocketServer::handleClient(int client_fd) {
                  header.payload_size - total_received, 0);
         if (n < 0) {
           // Error
-          close(client_fd);
+          releaseClient(client_fd);
           return;
         }
         if (n == 0) {
           // Connection closed
-          close(client_fd);
+          releaseClient(client_fd);
           return;
         }
         total_received += n;
@@ -293,6 +296,8 @@ void UnixSocketServer::handleClient(int client_fd) {
     auto send_start = std::chrono::steady_clock::now();
 
     // Send all data - blocking is OK here since response is small
+    // send_mutex_ keeps pushed events from interleaving with the response
+    std::unique_lock<std::mutex> send_lock(send_mutex_);
     while (total_sent < static_cast<ssize_t>(total_size) && running_.load()) {
       ssize_t sent = send(client_fd, response_data.data() + total_sent,
                           total_size - total_sent, MSG_NOSIGNAL);
@@ -312,6 +317,7 @@ void UnixSocketServer::handleClient(int client_fd) {
       std::cout << "[Worker] Sent " << total_sent << "/" << total_size
                 << " bytes" << std::endl;
     }
+    send_lock.unlock();
 
     auto send_end = std::chrono::steady_clock::now();
     auto send_duration = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -330,9 +336,49 @@ void UnixSocketServer::handleClient(int client_fd) {
     std::cout << "[Worker] ===== IPC REQUEST HANDLED =====" << std::endl;
   }
 
+  releaseClient(client_fd);
+}
+
+void UnixSocketServer::releaseClient(int client_fd) {
+  {
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    client_fd_.store(-1);
+  }
   close(client_fd);
 }
 
+bool UnixSocketServer::sendAll(int fd, const std::string &data) {
+  size_t total_sent = 0;
+  while (total_sent < data.size()) {
+    ssize_t sent = ::send(fd, data.data() + total_sent,
+                          data.size() - total_sent, MSG_NOSIGNAL);
+    if (sent <= 0) {
+      return false;
+    }
+    total_sent += sent;
+  }
+  return true;
+}
+
+bool UnixSocketServer::sendEvent(const IPCMessage &msg) {
+  std::string data = msg.serialize();
+
+  std::lock_guard<std::mutex> lock(send_mutex_);
+  int fd = client_fd_.load();
+  if (fd < 0) {
+    return false;
+  }
+
+  // Drop the event rather than block if the supervisor is not draining
+  struct pollfd pfd;
+  pfd.fd = fd;
+  pfd.events = POLLOUT;
+  if (poll(&pfd, 1, 0) <= 0 || !(pfd.revents & POLLOUT)) {
+    return false;
+  }
+  return sendAll(fd, data);
+}
+
 // ============================================================================
 // UnixSocketClient
 // ============================================================================
@@ -450,58 +496,13 @@ IPCMessage UnixSocketClient::sendAndReceive(const IPCMessage &msg,
     return error;
   }
 
-  // Receive header with remaining timeout
-  std::string header_data =
-      receiveRaw(MessageHeader::HEADER_SIZE, remaining_timeout);
-  if (header_data.empty()) {
-    IPCMessage error;
-    error.type = MessageType::ERROR_RESPONSE;
-    error.payload = createErrorResponse("Receive header timeout");
-    return error;
-  }
-
-  MessageHeader header;
-  if (!MessageHeader::deserialize(header_data.data(), header_data.size(),
-                                  header)) {
-    IPCMessage error;
-    error.type = MessageType::ERROR_RESPONSE;
-    error.payload = createErrorResponse("Invalid response header");
-    return error;
-  }
-
-  // Calculate remaining timeout after receiving header
-  auto elapsed_after_header =
-      std::chrono::duration_cast<std::chrono::milliseconds>(
-          std::chrono::steady_clock::now() - start_time)
-          .count();
-  remaining_timeout = timeout_ms - static_cast<int>(elapsed_after_header);
-
-  if (remaining_timeout <= 0) {
-    IPCMessage error;
-    error.type = MessageType::ERROR_RESPONSE;
-    error.payload = createErrorResponse("Receive header timeout");
-    return error;
-  }
-
-  // Receive payload with remaining timeout
-  std::string payload_data;
-  if (header.payload_size > 0) {
-    payload_data = receiveRaw(header.payload_size, remaining_timeout);
-    if (payload_data.empty()) {
-      IPCMessage error;
-      error.type = MessageType::ERROR_RESPONSE;
-      error.payload = createErrorResponse("Receive payload timeout");
-      return error;
-    }
-  }
-
-  // Deserialize
+  // Receive response with remaining timeout (events before it are dispatched)
   IPCMessage response;
-  std::string full_data = header_data + payload_data;
-  if (!IPCMessage::deserialize(full_data, response)) {
+  std::string error_message;
+  if (!readReply(response, remaining_timeout, error_message)) {
     IPCMessage error;
     error.type = MessageType::ERROR_RESPONSE;
-    error.payload = createErrorResponse("Failed to deserialize response");
+    error.payload = createErrorResponse(error_message);
     return error;
   }
 
@@ -526,40 +527,125 @@ IPCMessage UnixSocketClient::receive(int timeout_ms) {
     return error;
   }
 
-  // Receive header
-  std::string header_data = receiveRaw(MessageHeader::HEADER_SIZE, timeout_ms);
-  if (header_data.empty()) {
+  IPCMessage response;
+  std::string error_message;
+  if (!readReply(response, timeout_ms, error_message)) {
     IPCMessage error;
     error.type = MessageType::ERROR_RESPONSE;
-    error.payload = createErrorResponse("Receive timeout");
+    error.payload = createErrorResponse(error_message);
     return error;
   }
 
+  return response;
+}
+
+void UnixSocketClient::setEventHandler(EventHandler handler) {
+  std::lock_guard<std::mutex> lock(recv_mutex_);
+  event_handler_ = std::move(handler);
+}
+
+size_t UnixSocketClient::pollEvents() {
+  std::unique_lock<std::mutex> lock(recv_mutex_, std::try_to_lock);
+  if (!lock.owns_lock() || !connected_.load()) {
+    return 0;
+  }
+
+  size_t dispatched = 0;
+  while (true) {
+    struct pollfd pfd;
+    pfd.fd = socket_fd_;
+    pfd.events = POLLIN;
+    if (poll(&pfd, 1, 0) <= 0 || !(pfd.revents & POLLIN)) {
+      break;
+    }
+
+    // The worker writes each message in one go, so once the header is
+    // readable the rest follows immediately
+    IPCMessage msg;
+    std::string error_message;
+    if (!readMessage(msg, 1000, error_message)) {
+      break;
+    }
+    if (!isPushEvent(msg.type)) {
+      // Late reply to a request that already timed out - drop it so the
+      // next request does not read it as its response
+      std::cerr << "[Socket] Dropping unexpected message type "
+                << static_cast<int>(msg.type) << std::endl;
+      continue;
+    }
+    if (event_handler_) {
+      event_handler_(msg);
+    }
+    dispatched++;
+  }
+  return dispatched;
+}
+
+bool UnixSocketClient::readMessage(IPCMessage &out, int timeout_ms,
+                                   std::string &error) {
+  auto start_time = std::chrono::steady_clock::now();
+
+  // Receive header
+  std::string header_data = receiveRaw(MessageHeader::HEADER_SIZE, timeout_ms);
+  if (header_data.empty()) {
+    error = "Receive header timeout";
+    return false;
+  }
+
   MessageHeader header;
   if (!MessageHeader::deserialize(header_data.data(), header_data.size(),
                                   header)) {
-    IPCMessage error;
-    error.type = MessageType::ERROR_RESPONSE;
-    error.payload = createErrorResponse("Invalid header");
-    return error;
+    error = "Invalid response header";
+    return false;
   }
 
-  // Receive payload
+  // Receive payload with remaining timeout
   std::string payload_data;
   if (header.payload_size > 0) {
-    payload_data = receiveRaw(header.payload_size, timeout_ms);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now() - start_time)
+                       .count();
+    int remaining_timeout = timeout_ms - static_cast<int>(elapsed);
+    if (remaining_timeout > 0) {
+      payload_data = receiveRaw(header.payload_size, remaining_timeout);
+    }
+    if (payload_data.empty()) {
+      error = "Receive payload timeout";
+      return false;
+    }
   }
 
-  IPCMessage response;
-  std::string full_data = header_data + payload_data;
-  if (!IPCMessage::deserialize(full_data, response)) {
-    IPCMessage error;
-    error.type = MessageType::ERROR_RESPONSE;
-    error.payload = createErrorResponse("Deserialize failed");
-    return error;
+  // Deserialize
+  if (!IPCMessage::deserialize(header_data + payload_data, out)) {
+    error = "Failed to deserialize response";
+    return false;
   }
+  return true;
+}
 
-  return response;
+bool UnixSocketClient::readReply(IPCMessage &out, int timeout_ms,
+                                 std::string &error) {
+  auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+  while (true) {
+    int remaining_timeout = static_cast<int>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now())
+            .count());
+    if (remaining_timeout <= 0) {
+      error = "Receive header timeout";
+      return false;
+    }
+    if (!readMessage(out, remaining_timeout, error)) {
+      return false;
+    }
+    if (!isPushEvent(out.type)) {
+      return true;
+    }
+    if (event_handler_) {
+      event_handler_(out);
+    }
+  }
 }
 
 bool UnixSocketClient::sendRaw(const std::string &data) {
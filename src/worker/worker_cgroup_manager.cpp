@@ -0,0 +1,402 @@
+#include "worker/worker_cgroup_manager.h"
+#include "core/env_config.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unistd.h>
+#include <vector>
+
+namespace worker {
+
+namespace {
+
+const char *CGROUP_MOUNT = "/sys/fs/cgroup";
+const char *LEAF_PREFIX = "worker-";
+const int64_t CPU_MAX_PERIOD_US = 100000;
+
+std::string readFile(const std::string &path) {
+  std::ifstream file(path);
+  if (!file) {
+    return "";
+  }
+  std::ostringstream oss;
+  oss << file.rdbuf();
+  return oss.str();
+}
+
+bool writeFile(const std::string &path, const std::string &value) {
+  std::ofstream file(path);
+  if (!file) {
+    return false;
+  }
+  file << value;
+  file.flush();
+  return static_cast<bool>(file);
+}
+
+// Value of "key N" in a flat-keyed file (cpu.stat, memory.stat, ...)
+uint64_t readKeyed(const std::string &content, const std::string &key) {
+  std::istringstream iss(content);
+  std::string name;
+  uint64_t value = 0;
+  while (iss >> name >> value) {
+    if (name == key) {
+      return value;
+    }
+  }
+  return 0;
+}
+
+// Path of this process' cgroup relative to the mount, from "0::/path"
+std::string ownCgroup() {
+  std::istringstream iss(readFile("/proc/self/cgroup"));
+  std::string line;
+  while (std::getline(iss, line)) {
+    if (line.rfind("0::", 0) == 0) {
+      return line.substr(3);
+    }
+  }
+  return "";
+}
+
+std::string leafName(const std::string &instance_id) {
+  std::string name = LEAF_PREFIX;
+  for (char c : instance_id) {
+    bool safe = std::isalnum(static_cast<unsigned char>(c)) || c == '-' ||
+                c == '_';
+    name += safe ? c : '_';
+  }
+  return name;
+}
+
+std::string escapeLabel(const std::string &value) {
+  std::string escaped;
+  for (char c : value) {
+    if (c == '\\' || c == '"') {
+      escaped += '\\';
+    }
+    escaped += c == '\n' ? ' ' : c;
+  }
+  return escaped;
+}
+
+} // namespace
+
+Json::Value WorkerResourceUsage::toJson() const {
+  Json::Value json;
+  json["cpu_seconds"] = cpu_usage_usec / 1e6;
+  json["cpu_throttled_seconds"] = cpu_throttled_usec / 1e6;
+  json["memory_bytes"] = static_cast<Json::UInt64>(memory_current);
+  json["rss_bytes"] = static_cast<Json::UInt64>(memory_anon);
+  json["memory_high_events"] = static_cast<Json::UInt64>(memory_high_events);
+  json["oom_events"] = static_cast<Json::UInt64>(oom_events);
+  json["oom_kills"] = static_cast<Json::UInt64>(oom_kill_events);
+  json["cpu_pressure_avg10"] = cpu_pressure_avg10;
+  json["memory_pressure_avg10"] = memory_pressure_avg10;
+  return json;
+}
+
+bool WorkerCgroupManager::initialize() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return initializeLocked();
+}
+
+bool WorkerCgroupManager::isEnabled() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return enabled_;
+}
+
+bool WorkerCgroupManager::initializeLocked() {
+  if (initialized_) {
+    return enabled_;
+  }
+  initialized_ = true;
+
+  if (!EnvConfig::getBool("EDGE_AI_WORKER_CGROUPS", false)) {
+    return false;
+  }
+
+  namespace fs = std::filesystem;
+  std::error_code ec;
+  if (!fs::exists(std::string(CGROUP_MOUNT) + "/cgroup.controllers", ec)) {
+    std::cerr << "[WorkerCgroup] cgroup v2 is not mounted at " << CGROUP_MOUNT
+              << ", workers run without resource limits" << std::endl;
+    return false;
+  }
+
+  std::string own = std::string(CGROUP_MOUNT) + ownCgroup();
+  std::string root = EnvConfig::getString("EDGE_AI_WORKER_CGROUP_ROOT", own);
+  while (root.size() > 1 && root.back() == '/') {
+    root.pop_back();
+  }
+  fs::create_directories(root, ec);
+
+  if (fs::equivalent(root, own, ec)) {
+    // No internal processes: move ourselves out before enabling controllers
+    std::string supervisor = root + "/supervisor";
+    fs::create_directory(supervisor, ec);
+    if (!writeFile(supervisor + "/cgroup.procs", std::to_string(getpid()))) {
+      std::cerr << "[WorkerCgroup] Cannot move server into " << supervisor
+                << " (" << strerror(errno)
+                << "); is the cgroup delegated (Delegate=yes)?" << std::endl;
+      return false;
+    }
+  }
+
+  std::string available = readFile(root + "/cgroup.controllers");
+  for (const char *controller : {"cpu", "memory"}) {
+    if (available.find(controller) == std::string::npos) {
+      continue;
+    }
+    writeFile(root + "/cgroup.subtree_control",
+              std::string("+") + controller);
+  }
+  std::istringstream enabled(readFile(root + "/cgroup.subtree_control"));
+  std::string controller;
+  while (enabled >> controller) {
+    cpu_controller_ = cpu_controller_ || controller == "cpu";
+    memory_controller_ = memory_controller_ || controller == "memory";
+  }
+
+  if (access((root + "/cgroup.procs").c_str(), W_OK) != 0) {
+    std::cerr << "[WorkerCgroup] " << root
+              << " is not writable, workers run without resource limits"
+              << std::endl;
+    return false;
+  }
+
+  root_ = root;
+  enabled_ = true;
+  std::cout << "[WorkerCgroup] Worker cgroups under " << root_ << " (cpu: "
+            << (cpu_controller_ ? "yes" : "no")
+            << ", memory: " << (memory_controller_ ? "yes" : "no") << ")"
+            << std::endl;
+  return true;
+}
+
+std::string
+WorkerCgroupManager::leafPathLocked(const std::string &instance_id) const {
+  return root_ + "/" + leafName(instance_id);
+}
+
+std::string WorkerCgroupManager::formatCpuMax(double cores) {
+  if (cores <= 0.0) {
+    return "max " + std::to_string(CPU_MAX_PERIOD_US);
+  }
+  // The kernel rejects quotas below 1ms
+  auto quota = std::max<int64_t>(
+      1000, static_cast<int64_t>(cores * CPU_MAX_PERIOD_US + 0.5));
+  return std::to_string(quota) + " " + std::to_string(CPU_MAX_PERIOD_US);
+}
+
+std::string WorkerCgroupManager::prepare(const std::string &instance_id,
+                                         const ResourceLimits &limits) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!initializeLocked()) {
+    return "";
+  }
+
+  std::string path = leafPathLocked(instance_id);
+  std::error_code ec;
+  std::filesystem::create_directory(path, ec);
+  if (ec) {
+    std::cerr << "[WorkerCgroup] Cannot create " << path << ": "
+              << ec.message() << std::endl;
+    return "";
+  }
+
+  // Always written, so a reused leaf drops limits that were removed
+  if (cpu_controller_) {
+    int weight = limits.cpuWeight > 0 ? limits.cpuWeight : 100;
+    if (!writeFile(path + "/cpu.weight", std::to_string(weight)) ||
+        !writeFile(path + "/cpu.max", formatCpuMax(limits.cpuMax))) {
+      std::cerr << "[WorkerCgroup] Failed to set CPU limits for "
+                << instance_id << std::endl;
+    }
+  }
+  if (memory_controller_) {
+    std::string high = limits.memoryHighMB > 0
+                           ? std::to_string(limits.memoryHighMB * 1024 * 1024)
+                           : "max";
+    if (!writeFile(path + "/memory.high", high)) {
+      std::cerr << "[WorkerCgroup] Failed to set memory.high for "
+                << instance_id << std::endl;
+    }
+  }
+
+  leaves_[instance_id] = path;
+  return path + "/cgroup.procs";
+}
+
+void WorkerCgroupManager::joinFromChild(const char *procs_path) {
+  int fd = open(procs_path, O_WRONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return;
+  }
+  ssize_t written = write(fd, "0", 1);
+  (void)written;
+  close(fd);
+}
+
+void WorkerCgroupManager::remove(const std::string &instance_id) {
+  std::string path;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = leaves_.find(instance_id);
+    if (it == leaves_.end()) {
+      return;
+    }
+    path = it->second;
+    leaves_.erase(it);
+  }
+  if (rmdir(path.c_str()) != 0 && errno != ENOENT) {
+    std::cerr << "[WorkerCgroup] Failed to remove " << path << ": "
+              << strerror(errno) << std::endl;
+  }
+}
+
+void WorkerCgroupManager::parsePressure(const std::string &content,
+                                        double &some_avg10,
+                                        uint64_t &some_total_usec) {
+  std::istringstream iss(content);
+  std::string line;
+  while (std::getline(iss, line)) {
+    if (line.rfind("some ", 0) != 0) {
+      continue;
+    }
+    std::istringstream fields(line.substr(5));
+    std::string field;
+    while (fields >> field) {
+      auto eq = field.find('=');
+      if (eq == std::string::npos) {
+        continue;
+      }
+      std::string key = field.substr(0, eq);
+      std::string value = field.substr(eq + 1);
+      try {
+        if (key == "avg10") {
+          some_avg10 = std::stod(value);
+        } else if (key == "total") {
+          some_total_usec = std::stoull(value);
+        }
+      } catch (const std::exception &) {
+      }
+    }
+  }
+}
+
+std::optional<WorkerResourceUsage>
+WorkerCgroupManager::readUsage(const std::string &instance_id) const {
+  std::string path;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = leaves_.find(instance_id);
+    if (it == leaves_.end()) {
+      return std::nullopt;
+    }
+    path = it->second;
+  }
+
+  std::string cpuStat = readFile(path + "/cpu.stat");
+  if (cpuStat.empty()) {
+    return std::nullopt; // Leaf gone
+  }
+
+  WorkerResourceUsage usage;
+  usage.cpu_usage_usec = readKeyed(cpuStat, "usage_usec");
+  usage.cpu_throttled_usec = readKeyed(cpuStat, "throttled_usec");
+
+  std::string current = readFile(path + "/memory.current");
+  if (!current.empty()) {
+    try {
+      usage.memory_current = std::stoull(current);
+    } catch (const std::exception &) {
+    }
+  }
+  usage.memory_anon = readKeyed(readFile(path + "/memory.stat"), "anon");
+
+  std::string events = readFile(path + "/memory.events");
+  usage.memory_high_events = readKeyed(events, "high");
+  usage.oom_events = readKeyed(events, "oom");
+  usage.oom_kill_events = readKeyed(events, "oom_kill");
+
+  parsePressure(readFile(path + "/cpu.pressure"), usage.cpu_pressure_avg10,
+                usage.cpu_pressure_total_usec);
+  parsePressure(readFile(path + "/memory.pressure"),
+                usage.memory_pressure_avg10,
+                usage.memory_pressure_total_usec);
+  return usage;
+}
+
+std::string WorkerCgroupManager::getPrometheusMetrics() const {
+  std::vector<std::string> instances;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto &[instance_id, path] : leaves_) {
+      instances.push_back(instance_id);
+    }
+  }
+
+  std::vector<std::pair<std::string, WorkerResourceUsage>> usages;
+  for (const auto &instance_id : instances) {
+    auto usage = readUsage(instance_id);
+    if (usage.has_value()) {
+      usages.emplace_back(escapeLabel(instance_id), usage.value());
+    }
+  }
+  if (usages.empty()) {
+    return "";
+  }
+
+  std::ostringstream oss;
+  auto metric = [&oss, &usages](const char *name, const char *type,
+                                const char *help, auto value) {
+    oss << "# HELP " << name << " " << help << "\n";
+    oss << "# TYPE " << name << " " << type << "\n";
+    for (const auto &[label, usage] : usages) {
+      oss << name << "{instance_id=\"" << label << "\"} " << value(usage)
+          << "\n";
+    }
+  };
+
+  metric("worker_cpu_seconds_total", "counter",
+         "CPU time used by the worker cgroup",
+         [](const WorkerResourceUsage &u) { return u.cpu_usage_usec / 1e6; });
+  metric("worker_cpu_throttled_seconds_total", "counter",
+         "Time the worker was throttled by cpu.max",
+         [](const WorkerResourceUsage &u) {
+           return u.cpu_throttled_usec / 1e6;
+         });
+  metric("worker_memory_bytes", "gauge",
+         "Memory charged to the worker cgroup (memory.current)",
+         [](const WorkerResourceUsage &u) { return u.memory_current; });
+  metric("worker_rss_bytes", "gauge",
+         "Anonymous memory of the worker cgroup",
+         [](const WorkerResourceUsage &u) { return u.memory_anon; });
+  metric("worker_memory_high_events_total", "counter",
+         "Times the worker was throttled for exceeding memory.high",
+         [](const WorkerResourceUsage &u) { return u.memory_high_events; });
+  metric("worker_oom_kills_total", "counter",
+         "Processes of the worker cgroup killed by the OOM killer",
+         [](const WorkerResourceUsage &u) { return u.oom_kill_events; });
+  metric("worker_cpu_pressure_seconds_total", "counter",
+         "Time some worker tasks stalled waiting for CPU (PSI)",
+         [](const WorkerResourceUsage &u) {
+           return u.cpu_pressure_total_usec / 1e6;
+         });
+  metric("worker_memory_pressure_seconds_total", "counter",
+         "Time some worker tasks stalled waiting for memory (PSI)",
+         [](const WorkerResourceUsage &u) {
+           return u.memory_pressure_total_usec / 1e6;
+         });
+  oss << "\n";
+  return oss.str();
+}
+
+} // namespace worker
@@ -1,9 +1,12 @@
 #include "worker/worker_handler.h"
 #include "core/env_config.h"
 #include "core/pipeline_builder.h"
+#include "core/queue_telemetry.h"
+#include "core/synthetic_nodes.h"
 #include "core/timeout_constants.h"
 #include "models/create_instance_request.h"
 #include "solutions/solution_registry.h"
+#include "utils/base64_codec.h"
 #include <cstring>
 #include <sys/socket.h>
 #include <unistd.h>
@@ -28,10 +31,6 @@
 #include <sstream>
 #include <thread>
 
-// Base64 encoding table
-static const char base64_chars[] =
-    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-
 namespace worker {
 
 WorkerHandler::WorkerHandler(const std::string &instance_id,
@@ -77,6 +76,7 @@ WorkerHandler::~WorkerHandler() {
     }
   }
 
+  stopStatsPush();
   cleanupPipeline();
   if (server_) {
     server_->stop();
@@ -163,6 +163,9 @@ int WorkerHandler::run() {
   // Send ready signal to supervisor
   sendReadySignal();
 
+  // Push statistics so the supervisor can serve them without IPC round trips
+  startStatsPush();
+
   std::cout << "[Worker:" << instance_id_ << "] Ready and listening on "
             << socket_path_ << std::endl;
 
@@ -231,6 +234,8 @@ int WorkerHandler::run() {
 
   cleanupPipeline();
 
+  stopStatsPush();
+
   std::cout << "[Worker:" << instance_id_ << "] Stopping IPC server..."
             << std::endl;
   if (server_) {
@@ -265,6 +270,8 @@ IPCMessage WorkerHandler::handleMessage(const IPCMessage &msg) {
     return handleGetStatistics(msg);
   case MessageType::GET_LAST_FRAME:
     return handleGetLastFrame(msg);
+  case MessageType::GET_QUEUE_TELEMETRY:
+    return handleGetQueueTelemetry(msg);
   default: {
     IPCMessage error;
     error.type = MessageType::ERROR_RESPONSE;
@@ -642,23 +649,47 @@ IPCMessage WorkerHandler::handleGetStatistics(const IPCMessage & /*msg*/) {
     return response;
   }
 
-  auto now = std::chrono::steady_clock::now();
-  auto uptime =
-      std::chrono::duration_cast<std::chrono::seconds>(now - start_time_)
-          .count();
-  auto start_unix = std::chrono::duration_cast<std::chrono::seconds>(
-                        std::chrono::system_clock::now().time_since_epoch())
-                        .count();
+  // Refresh source framerate/resolution (bounded by a short timeout)
+  refreshSourceInfo();
+  Json::Value data = buildStatisticsData();
 
-  // Use shared_lock to allow concurrent reads - never blocks other readers
-  // Multiple GET_STATISTICS requests can run simultaneously
-  // Writers (state updates) still get exclusive access
-  std::string state_copy;
-  {
-    std::shared_lock<std::shared_mutex> lock(state_mutex_);
-    state_copy = current_state_;
+  // Log statistics summary for debugging
+  auto handle_end = std::chrono::steady_clock::now();
+  auto handle_duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                             handle_end - handle_start)
+                             .count();
+  uint64_t frames_processed_value = data["frames_processed"].asUInt64();
+  double current_fps_value = data["current_framerate"].asDouble();
+  std::string state_copy = data["state"].asString();
+  std::cout << "[Worker:" << instance_id_ << "] GET_STATISTICS: "
+            << "frames_processed=" << frames_processed_value
+            << ", current_fps=" << current_fps_value
+            << ", source_fps=" << data["source_framerate"].asDouble()
+            << ", queue_size=" << queue_size_.load() << ", state=" << state_copy
+            << " (duration: " << handle_duration << "ms)" << std::endl;
+
+  // Add diagnostic info when statistics are empty (pipeline running but no
+  // frames processed yet)
+  if (frames_processed_value == 0 && current_fps_value == 0.0) {
+    auto uptime = std::chrono::duration_cast<std::chrono::seconds>(
+                      std::chrono::steady_clock::now() - start_time_)
+                      .count();
+    data["diagnostic"] =
+        "Pipeline is running but no frames have been processed yet. "
+        "This may be normal if the instance just started or the source is not "
+        "providing frames.";
+    std::cout << "[Worker:" << instance_id_
+              << "] GET_STATISTICS: Warning - No frames processed yet. "
+              << "Pipeline state: " << state_copy
+              << ", Queue size: " << queue_size_.load()
+              << ", Uptime: " << uptime << " seconds" << std::endl;
   }
 
+  response.payload = createResponse(ResponseStatus::OK, "", data);
+  return response;
+}
+
+void WorkerHandler::refreshSourceInfo() {
   // Get source framerate and resolution from source node (if available)
   // CRITICAL: Use timeout protection to prevent blocking when source node is
   // busy This prevents API from hanging when pipeline is overloaded (queue
@@ -776,31 +807,45 @@ IPCMessage WorkerHandler::handleGetStatistics(const IPCMessage & /*msg*/) {
     }
   }
 
-  // Use source_resolution_ member if source_res is empty (fallback)
-  if (source_res.empty() && !source_resolution_.empty()) {
+  if (source_fps > 0.0) {
+    source_fps_.store(source_fps, std::memory_order_relaxed);
+  }
+}
+
+Json::Value WorkerHandler::buildStatisticsData() const {
+  auto now = std::chrono::steady_clock::now();
+  auto uptime =
+      std::chrono::duration_cast<std::chrono::seconds>(now - start_time_)
+          .count();
+  auto start_unix = std::chrono::duration_cast<std::chrono::seconds>(
+                        std::chrono::system_clock::now().time_since_epoch())
+                        .count();
+
+  // Use shared_lock to allow concurrent reads - never blocks other readers
+  std::string state_copy;
+  std::string source_res;
+  {
+    std::shared_lock<std::shared_mutex> lock(state_mutex_);
+    state_copy = current_state_;
     source_res = source_resolution_;
   }
 
+  int width = frame_width_.load(std::memory_order_relaxed);
+  int height = frame_height_.load(std::memory_order_relaxed);
+  std::string resolution =
+      width > 0 && height > 0
+          ? std::to_string(width) + "x" + std::to_string(height)
+          : "";
+
   // Calculate latency (average time per frame in milliseconds)
   double current_fps_value = current_fps_.load();
+  double source_fps = source_fps_.load(std::memory_order_relaxed);
   double latency = 0.0;
   uint64_t frames_processed_value = frames_processed_.load();
   if (frames_processed_value > 0 && current_fps_value > 0.0) {
     latency = std::round(1000.0 / current_fps_value);
   }
 
-  // Log statistics summary for debugging
-  auto handle_end = std::chrono::steady_clock::now();
-  auto handle_duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-                             handle_end - handle_start)
-                             .count();
-  std::cout << "[Worker:" << instance_id_ << "] GET_STATISTICS: "
-            << "frames_processed=" << frames_processed_value
-            << ", current_fps=" << current_fps_value
-            << ", source_fps=" << source_fps
-            << ", queue_size=" << queue_size_.load() << ", state=" << state_copy
-            << " (duration: " << handle_duration << "ms)" << std::endl;
-
   Json::Value data;
   data["instance_id"] = instance_id_;
   data["frames_processed"] = static_cast<Json::UInt64>(frames_processed_value);
@@ -811,28 +856,112 @@ IPCMessage WorkerHandler::handleGetStatistics(const IPCMessage & /*msg*/) {
   data["source_framerate"] = source_fps > 0.0 ? source_fps : current_fps_value;
   data["latency"] = latency;
   data["input_queue_size"] = static_cast<Json::UInt64>(queue_size_.load());
-  data["resolution"] = resolution_.empty() ? source_res : resolution_;
-  data["source_resolution"] =
-      source_res.empty() ? source_resolution_ : source_res;
+  data["resolution"] = resolution.empty() ? source_res : resolution;
+  data["source_resolution"] = source_res;
   data["format"] = "BGR";
   data["state"] = state_copy;
+  return data;
+}
 
-  // Add diagnostic info when statistics are empty (pipeline running but no
-  // frames processed yet)
-  if (frames_processed_value == 0 && current_fps_value == 0.0) {
-    data["diagnostic"] =
-        "Pipeline is running but no frames have been processed yet. "
-        "This may be normal if the instance just started or the source is not "
-        "providing frames.";
-    std::cout << "[Worker:" << instance_id_
-              << "] GET_STATISTICS: Warning - No frames processed yet. "
-              << "Pipeline state: " << state_copy
-              << ", Queue size: " << queue_size_.load()
-              << ", Uptime: " << uptime << " seconds" << std::endl;
+void WorkerHandler::startStatsPush() {
+  int interval_ms = TimeoutConstants::getWorkerStatsPushIntervalMs();
+  if (interval_ms <= 0 || stats_push_thread_.joinable()) {
+    return;
   }
+  stats_push_thread_ = std::thread(&WorkerHandler::statsPushLoop, this,
+                                   std::chrono::milliseconds(interval_ms));
+  std::cout << "[Worker:" << instance_id_ << "] Pushing statistics every "
+            << interval_ms << "ms" << std::endl;
+}
 
-  response.payload = createResponse(ResponseStatus::OK, "", data);
-  return response;
+void WorkerHandler::stopStatsPush() {
+  {
+    std::lock_guard<std::mutex> lock(stats_push_mutex_);
+    shutdown_requested_.store(true);
+  }
+  stats_push_cv_.notify_all();
+  if (stats_push_thread_.joinable()) {
+    stats_push_thread_.join();
+  }
+}
+
+void WorkerHandler::statsPushLoop(std::chrono::milliseconds interval) {
+  // A full snapshot every KEYFRAME_INTERVAL pushes bounds how long the
+  // supervisor stays without data after it lost track (reconnect, dropped
+  // event); in between only changed fields are sent
+  const uint64_t KEYFRAME_INTERVAL = 20;
+  // Source node queries are comparatively expensive and rarely change
+  const auto SOURCE_REFRESH_INTERVAL = std::chrono::seconds(5);
+  // Unchanged statistics are still confirmed this often, so the supervisor
+  // can tell a quiet pipeline from a stale snapshot
+  const auto KEEPALIVE_INTERVAL = std::chrono::seconds(1);
+
+  Json::Value last_sent; // Null until the supervisor has a full snapshot
+  uint64_t seq = 0;
+  uint64_t pushes_since_keyframe = 0;
+  bool reported_running = false;
+  std::chrono::steady_clock::time_point last_source_refresh{};
+  std::chrono::steady_clock::time_point last_push{};
+
+  std::unique_lock<std::mutex> lock(stats_push_mutex_);
+  while (!shutdown_requested_.load()) {
+    stats_push_cv_.wait_for(lock, interval,
+                            [this] { return shutdown_requested_.load(); });
+    if (shutdown_requested_.load()) {
+      break;
+    }
+    lock.unlock();
+
+    IPCMessage event;
+    event.type = MessageType::STATISTICS_UPDATE;
+
+    if (!pipeline_running_.load()) {
+      // Tell the supervisor once that there is nothing to report
+      if (reported_running) {
+        event.payload["seq"] = static_cast<Json::UInt64>(seq + 1);
+        event.payload["running"] = false;
+        if (server_->sendEvent(event)) {
+          seq++;
+          reported_running = false;
+        }
+      }
+      last_sent = Json::Value();
+      lock.lock();
+      continue;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - last_source_refresh >= SOURCE_REFRESH_INTERVAL &&
+        !starting_pipeline_.load() && !stopping_pipeline_.load() &&
+        !building_new_pipeline_.load()) {
+      refreshSourceInfo();
+      last_source_refresh = now;
+    }
+
+    Json::Value data = buildStatisticsData();
+    bool full =
+        last_sent.isNull() || pushes_since_keyframe + 1 >= KEYFRAME_INTERVAL;
+    Json::Value body = full ? data : diffStatistics(last_sent, data);
+    if (!full && body.empty() && now - last_push < KEEPALIVE_INTERVAL) {
+      lock.lock();
+      continue; // Nothing changed
+    }
+
+    event.payload["seq"] = static_cast<Json::UInt64>(seq + 1);
+    event.payload["running"] = true;
+    event.payload["full"] = full;
+    event.payload["data"] = body;
+    if (server_->sendEvent(event)) {
+      seq++;
+      pushes_since_keyframe = full ? 0 : pushes_since_keyframe + 1;
+      last_push = now;
+      last_sent = std::move(data);
+      reported_running = true;
+    } else {
+      last_sent = Json::Value(); // Resend everything next time
+    }
+    lock.lock();
+  }
 }
 
 IPCMessage WorkerHandler::handleGetLastFrame(const IPCMessage & /*msg*/) {
@@ -916,6 +1045,25 @@ IPCMessage WorkerHandler::handleGetLastFrame(const IPCMessage & /*msg*/) {
   return response;
 }
 
+IPCMessage WorkerHandler::handleGetQueueTelemetry(const IPCMessage &msg) {
+  IPCMessage response;
+  response.type = MessageType::GET_QUEUE_TELEMETRY_RESPONSE;
+
+  size_t max_samples = static_cast<size_t>(
+      msg.payload.get("max_samples", Json::UInt64(100)).asUInt64());
+
+  Json::Value data =
+      QueueTelemetry::getInstance().toJson(instance_id_, max_samples);
+  if (data.isNull()) {
+    response.payload = createErrorResponse("No queue telemetry recorded",
+                                           ResponseStatus::NOT_FOUND);
+    return response;
+  }
+
+  response.payload = createResponse(ResponseStatus::OK, "", data);
+  return response;
+}
+
 CreateInstanceRequest
 WorkerHandler::parseCreateRequest(const Json::Value &config) const {
   CreateInstanceRequest req;
@@ -1122,8 +1270,17 @@ bool WorkerHandler::startPipeline() {
 
         fileNode->start();
       } else {
-        last_error_ = "No supported source node found in pipeline";
-        return false;
+        // Synthetic source (load testing)
+        auto syntheticNode =
+            std::dynamic_pointer_cast<SyntheticNodes::SyntheticSourceNode>(
+                pipeline_nodes_[0]);
+        if (!syntheticNode) {
+          last_error_ = "No supported source node found in pipeline";
+          return false;
+        }
+        std::cout << "[Worker:" << instance_id_
+                  << "] Starting synthetic source node" << std::endl;
+        syntheticNode->start();
       }
     }
 
@@ -1364,6 +1521,10 @@ void WorkerHandler::stopPipeline() {
               } else if (stopStatus == std::future_status::ready) {
                 stopFuture.get();
               }
+            } else if (auto syntheticNode = std::dynamic_pointer_cast<
+                           SyntheticNodes::SyntheticSourceNode>(node)) {
+              // Generated frames: stopping never blocks
+              syntheticNode->stop();
             }
           }
 
@@ -1684,17 +1845,30 @@ void WorkerHandler::setupQueueSizeTrackingHook() {
     return;
   }
 
+  // Per-node queue depth ring buffers, served via GET_QUEUE_TELEMETRY
+  auto telemetry = QueueTelemetry::getInstance().getOrCreate(instance_id_);
+
   // Setup meta_arriving_hooker on all nodes to track input queue size
-  for (const auto &node : pipeline_nodes_) {
+  for (size_t i = 0; i < pipeline_nodes_.size(); ++i) {
+    const auto &node = pipeline_nodes_[i];
     if (!node) {
       continue;
     }
+    QueueTelemetry::NodeSeries *series =
+        telemetry->addNode("node_" + std::to_string(i));
 
     try {
       node->set_meta_arriving_hooker(
-          [this](std::string /*node_name*/, int queue_size,
-                 std::shared_ptr<cvedix_objects::cvedix_meta> /* meta */) {
+          [this, telemetry,
+           series](std::string node_name, int queue_size,
+                   std::shared_ptr<cvedix_objects::cvedix_meta> /* meta */) {
             try {
+              if (series && queue_size >= 0) {
+                series->setName(node_name);
+                series->record(static_cast<uint32_t>(queue_size),
+                               telemetry->highWatermark());
+              }
+
               // Update queue_size_ atomically (thread-safe)
               // Track maximum queue size seen
               size_t current_size = queue_size_.load();
@@ -1760,9 +1934,10 @@ void WorkerHandler::updateFrameCache(const cv::Mat &frame) {
     last_fps_update_ = now;
   }
 
-  // Update resolution
+  // Update resolution (string is built by readers)
   if (!frame.empty()) {
-    resolution_ = std::to_string(frame.cols) + "x" + std::to_string(frame.rows);
+    frame_width_.store(frame.cols, std::memory_order_relaxed);
+    frame_height_.store(frame.rows, std::memory_order_relaxed);
   }
 }
 
@@ -1779,31 +1954,7 @@ std::string WorkerHandler::encodeFrameToBase64(const cv::Mat &frame,
     return "";
   }
 
-  // Base64 encode
-  std::string result;
-  result.reserve(((buffer.size() + 2) / 3) * 4);
-
-  size_t i = 0;
-  while (i < buffer.size()) {
-    uint32_t octet_a = i < buffer.size() ? buffer[i++] : 0;
-    uint32_t octet_b = i < buffer.size() ? buffer[i++] : 0;
-    uint32_t octet_c = i < buffer.size() ? buffer[i++] : 0;
-
-    uint32_t triple = (octet_a << 16) + (octet_b << 8) + octet_c;
-
-    result += base64_chars[(triple >> 18) & 0x3F];
-    result += base64_chars[(triple >> 12) & 0x3F];
-    result += base64_chars[(triple >> 6) & 0x3F];
-    result += base64_chars[triple & 0x3F];
-  }
-
-  // Add padding
-  size_t padding = (3 - (buffer.size() % 3)) % 3;
-  for (size_t p = 0; p < padding; ++p) {
-    result[result.size() - 1 - p] = '=';
-  }
-
-  return result;
+  return Base64::encode(buffer.data(), buffer.size());
 }
 
 bool WorkerHandler::checkIfNeedsRebuild(const Json::Value &oldConfig,
@@ -1881,8 +2032,11 @@ bool WorkerHandler::checkIfNeedsRebuild(const Json::Value &oldConfig,
     }
 
     // Check other model paths (MODEL_PATH, SFACE_MODEL_PATH, etc.)
-    std::vector<std::string> modelPathKeys = {"MODEL_PATH", "SFACE_MODEL_PATH",
-                                              "WEIGHTS_PATH", "CONFIG_PATH"};
+    // Source decode settings are also fixed when the source node is created
+    std::vector<std::string> modelPathKeys = {
+        "MODEL_PATH",         "SFACE_MODEL_PATH", "WEIGHTS_PATH",
+        "CONFIG_PATH",        "RESIZE_RATIO",     "SKIP_INTERVAL",
+        "AUTO_RESIZE_RATIO", "AUTO_SKIP_INTERVAL"};
     for (const auto &key : modelPathKeys) {
       if (oldParams.isMember(key) != newParams.isMember(key) ||
           (oldParams.isMember(key) && newParams.isMember(key) &&
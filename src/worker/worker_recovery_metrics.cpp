@@ -0,0 +1,84 @@
+#include "worker/worker_recovery_metrics.h"
+#include <sstream>
+
+namespace worker {
+
+void WorkerRecoveryMetrics::recordCrash() {
+  crashes_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void WorkerRecoveryMetrics::recordRestart() {
+  restarts_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void WorkerRecoveryMetrics::recordRestartFailure() {
+  restart_failures_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void WorkerRecoveryMetrics::recordRecovery(
+    std::chrono::steady_clock::duration crash_to_first_frame) {
+  auto us = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(crash_to_first_frame)
+          .count());
+  recovery_us_sum_.fetch_add(us, std::memory_order_relaxed);
+  last_recovery_us_.store(us, std::memory_order_relaxed);
+  recoveries_.fetch_add(1, std::memory_order_relaxed);
+}
+
+WorkerRecoveryMetrics::Stats WorkerRecoveryMetrics::getStats() const {
+  Stats stats;
+  stats.crashes = crashes_.load(std::memory_order_relaxed);
+  stats.restarts = restarts_.load(std::memory_order_relaxed);
+  stats.restart_failures = restart_failures_.load(std::memory_order_relaxed);
+  stats.recoveries = recoveries_.load(std::memory_order_relaxed);
+  stats.recovery_seconds_sum =
+      recovery_us_sum_.load(std::memory_order_relaxed) / 1e6;
+  stats.last_recovery_seconds =
+      last_recovery_us_.load(std::memory_order_relaxed) / 1e6;
+  return stats;
+}
+
+Json::Value WorkerRecoveryMetrics::getStatsJson() const {
+  Stats stats = getStats();
+  Json::Value json;
+  json["crashes"] = static_cast<Json::UInt64>(stats.crashes);
+  json["restarts"] = static_cast<Json::UInt64>(stats.restarts);
+  json["restartFailures"] = static_cast<Json::UInt64>(stats.restart_failures);
+  json["recoveries"] = static_cast<Json::UInt64>(stats.recoveries);
+  json["lastCrashToFirstFrameMs"] = stats.last_recovery_seconds * 1000.0;
+  return json;
+}
+
+std::string WorkerRecoveryMetrics::getPrometheusMetrics() const {
+  Stats stats = getStats();
+  std::ostringstream oss;
+
+  oss << "# HELP worker_crashes_total Worker processes that exited "
+         "unexpectedly\n";
+  oss << "# TYPE worker_crashes_total counter\n";
+  oss << "worker_crashes_total " << stats.crashes << "\n";
+  oss << "# HELP worker_restarts_total Crashed workers restarted\n";
+  oss << "# TYPE worker_restarts_total counter\n";
+  oss << "worker_restarts_total " << stats.restarts << "\n";
+  oss << "# HELP worker_restart_failures_total Worker restarts that failed\n";
+  oss << "# TYPE worker_restart_failures_total counter\n";
+  oss << "worker_restart_failures_total " << stats.restart_failures << "\n";
+
+  oss << "# HELP worker_crash_to_first_frame_seconds Time from crash "
+         "detection to the first frame processed by the restarted worker\n";
+  oss << "# TYPE worker_crash_to_first_frame_seconds summary\n";
+  oss << "worker_crash_to_first_frame_seconds_sum "
+      << stats.recovery_seconds_sum << "\n";
+  oss << "worker_crash_to_first_frame_seconds_count " << stats.recoveries
+      << "\n";
+  oss << "# HELP worker_last_crash_to_first_frame_seconds Crash-to-first-frame "
+         "time of the most recent recovery\n";
+  oss << "# TYPE worker_last_crash_to_first_frame_seconds gauge\n";
+  oss << "worker_last_crash_to_first_frame_seconds "
+      << stats.last_recovery_seconds << "\n";
+  oss << "\n";
+
+  return oss.str();
+}
+
+} // namespace worker
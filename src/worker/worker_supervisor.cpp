@@ -1,5 +1,9 @@
 #include "worker/worker_supervisor.h"
+#include "core/pipeline_metrics.h"
 #include "core/timeout_constants.h"
+#include "worker/cpu_placement.h"
+#include "worker/worker_cgroup_manager.h"
+#include "worker/worker_recovery_metrics.h"
 #include <chrono>
 #include <climits> // for PATH_MAX
 #include <cstring>
@@ -7,12 +11,58 @@
 #include <filesystem>
 #include <iostream>
 #include <optional>
+#include <shared_mutex>
 #include <signal.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434 // Same number on all architectures (Linux 5.3+)
+#endif
+
 namespace worker {
 
+namespace {
+
+// epoll token of the wake-up eventfd
+constexpr uint64_t WAKE_TOKEN = 0;
+
+int openPidfd(pid_t pid) {
+  return static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+}
+
+// Writes "<message><code>\n" to stderr with a single write() from a stack
+// buffer; safe between fork() and exec()
+void writeChildError(const char *message, int code) {
+  char buf[128];
+  size_t len = 0;
+  while (*message && len < sizeof(buf) - 16) {
+    buf[len++] = *message++;
+  }
+  char digits[12];
+  size_t count = 0;
+  unsigned value = code < 0 ? 0u - static_cast<unsigned>(code)
+                            : static_cast<unsigned>(code);
+  do {
+    digits[count++] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value > 0);
+  if (code < 0) {
+    buf[len++] = '-';
+  }
+  while (count > 0) {
+    buf[len++] = digits[--count];
+  }
+  buf[len++] = '\n';
+  ssize_t written = write(STDERR_FILENO, buf, len);
+  (void)written;
+}
+
+} // namespace
+
 WorkerSupervisor::WorkerSupervisor(const std::string &worker_executable)
     : worker_executable_(worker_executable) {}
 
@@ -23,8 +73,29 @@ void WorkerSupervisor::start() {
     return;
   }
 
+  // Resolve the delegated cgroup subtree and CPU placement (which pins this
+  // process to the reserved CPUs) before the first spawn
+  WorkerCgroupManager::getInstance().initialize();
+  CpuPlacement::getInstance().initialize();
+
   running_.store(true);
   monitor_thread_ = std::thread(&WorkerSupervisor::monitorLoop, this);
+  event_thread_ = std::thread(&WorkerSupervisor::eventLoop, this);
+  restart_thread_ = std::thread(&WorkerSupervisor::restartLoop, this);
+
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  wake_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (epoll_fd_ >= 0 && wake_fd_ >= 0) {
+    struct epoll_event ev;
+    std::memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.u64 = WAKE_TOKEN;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &ev);
+    exit_watch_thread_ = std::thread(&WorkerSupervisor::exitWatchLoop, this);
+  } else {
+    std::cerr << "[Supervisor] epoll/eventfd unavailable (" << strerror(errno)
+              << "), worker exits detected by heartbeat only" << std::endl;
+  }
 
   std::cout << "[Supervisor] Started" << std::endl;
 }
@@ -34,7 +105,17 @@ void WorkerSupervisor::stop() {
     return;
   }
 
-  running_.store(false);
+  {
+    std::lock_guard<std::mutex> lock(restart_mutex_);
+    running_.store(false);
+    pending_restarts_.clear();
+  }
+  restart_cv_.notify_all();
+  // A restart in progress must finish (or discard its process) before the
+  // worker list is snapshotted
+  if (restart_thread_.joinable()) {
+    restart_thread_.join();
+  }
 
   // Stop all workers
   std::vector<std::string> worker_ids;
@@ -60,6 +141,23 @@ void WorkerSupervisor::stop() {
   if (monitor_thread_.joinable()) {
     monitor_thread_.join();
   }
+  if (event_thread_.joinable()) {
+    event_thread_.join();
+  }
+  if (exit_watch_thread_.joinable()) {
+    uint64_t one = 1;
+    ssize_t written = write(wake_fd_, &one, sizeof(one));
+    (void)written;
+    exit_watch_thread_.join();
+  }
+  if (epoll_fd_ >= 0) {
+    close(epoll_fd_);
+    epoll_fd_ = -1;
+  }
+  if (wake_fd_ >= 0) {
+    close(wake_fd_);
+    wake_fd_ = -1;
+  }
 
   std::cout << "[Supervisor] Stopped" << std::endl;
 }
@@ -75,6 +173,20 @@ bool WorkerSupervisor::spawnWorker(const std::string &instance_id,
     return false;
   }
 
+  auto worker = launchWorker(instance_id, config);
+  if (!worker) {
+    releaseInstanceResourcesLocked(instance_id);
+    return false;
+  }
+
+  watchWorker(*worker);
+  workers_[instance_id] = std::move(worker);
+  return true;
+}
+
+std::unique_ptr<WorkerInfo>
+WorkerSupervisor::launchWorker(const std::string &instance_id,
+                               const Json::Value &config) {
   // Find worker executable
   std::string exe_path = findWorkerExecutable();
   if (exe_path.empty()) {
@@ -89,7 +201,7 @@ bool WorkerSupervisor::spawnWorker(const std::string &instance_id,
     std::cerr << "[Supervisor]   3. Run diagnostic script:" << std::endl;
     std::cerr << "[Supervisor]      ./scripts/diagnose_spawn_worker.sh" << std::endl;
     std::cerr << "[Supervisor] ========================================" << std::endl;
-    return false;
+    return nullptr;
   }
 
   // Generate socket path
@@ -101,6 +213,16 @@ bool WorkerSupervisor::spawnWorker(const std::string &instance_id,
   builder["indentation"] = "";
   std::string config_str = Json::writeString(builder, config);
 
+  // Own cgroup leaf with the instance's limits; joined by the child itself
+  // so the worker is confined from its first instruction
+  std::string cgroup_procs = WorkerCgroupManager::getInstance().prepare(
+      instance_id, ResourceLimits::fromJson(config["ResourceLimits"]));
+
+  // CPUs and preferred NUMA node, applied by the child before exec
+  CpuPlacement::Assignment placement =
+      CpuPlacement::getInstance().assign(instance_id);
+  cpu_set_t cpu_mask = CpuPlacement::toMask(placement.cpus);
+
   // Fork and exec worker process
   pid_t pid = fork();
 
@@ -118,19 +240,25 @@ bool WorkerSupervisor::spawnWorker(const std::string &instance_id,
     std::cerr << "[Supervisor]   4. Run diagnostic script:" << std::endl;
     std::cerr << "[Supervisor]      ./scripts/diagnose_spawn_worker.sh" << std::endl;
     std::cerr << "[Supervisor] ========================================" << std::endl;
-    return false;
+    return nullptr;
   }
 
   if (pid == 0) {
     // Child process - exec worker
     // Arguments: worker_executable --instance-id <id> --socket <path> --config
     // <json>
+    if (!cgroup_procs.empty()) {
+      WorkerCgroupManager::joinFromChild(cgroup_procs.c_str());
+    }
+    CpuPlacement::applyInChild(cpu_mask, placement.node);
     execl(exe_path.c_str(), exe_path.c_str(), "--instance-id",
           instance_id.c_str(), "--socket", socket_path.c_str(), "--config",
           config_str.c_str(), nullptr);
 
-    // If exec fails
-    std::cerr << "[Worker] Failed to exec: " << strerror(errno) << std::endl;
+    // If exec fails. Only async-signal-safe calls after fork(): std::cerr
+    // goes through the async log buffer, whose thread and lock did not
+    // survive the fork.
+    writeChildError("[Worker] Failed to exec, errno ", errno);
     _exit(1);
   }
 
@@ -142,6 +270,7 @@ bool WorkerSupervisor::spawnWorker(const std::string &instance_id,
   worker->state = WorkerState::STARTING;
   worker->start_time = std::chrono::steady_clock::now();
   worker->last_heartbeat = worker->start_time;
+  worker->config = config;
 
   std::cout << "[Supervisor] Spawned worker PID " << pid
             << " for instance: " << instance_id << std::endl;
@@ -172,17 +301,21 @@ bool WorkerSupervisor::spawnWorker(const std::string &instance_id,
     kill(pid, SIGKILL);
     waitpid(pid, nullptr, 0);
     cleanupSocket(socket_path);
-    return false;
+    return nullptr;
   }
 
-  workers_[instance_id] = std::move(worker);
-  return true;
+  return worker;
 }
 
 bool WorkerSupervisor::terminateWorker(const std::string &instance_id,
                                        bool force) {
   std::lock_guard<std::timed_mutex> lock(workers_mutex_);
 
+  {
+    std::unique_lock<std::shared_mutex> stats_lock(statistics_mutex_);
+    recovering_.erase(instance_id);
+  }
+
   auto it = workers_.find(instance_id);
   if (it == workers_.end()) {
     return false;
@@ -192,6 +325,7 @@ bool WorkerSupervisor::terminateWorker(const std::string &instance_id,
 
   if (worker.pid <= 0) {
     workers_.erase(it);
+    releaseInstanceResourcesLocked(instance_id);
     return true;
   }
 
@@ -211,6 +345,7 @@ bool WorkerSupervisor::terminateWorker(const std::string &instance_id,
                   << " exited gracefully" << std::endl;
         cleanupWorker(worker);
         workers_.erase(it);
+        releaseInstanceResourcesLocked(instance_id);
         return true;
       }
     }
@@ -228,6 +363,7 @@ bool WorkerSupervisor::terminateWorker(const std::string &instance_id,
 
   cleanupWorker(worker);
   workers_.erase(it);
+  releaseInstanceResourcesLocked(instance_id);
   return true;
 }
 
@@ -332,14 +468,24 @@ IPCMessage WorkerSupervisor::sendToWorker(const std::string &instance_id,
     std::cout << "[WorkerSupervisor] Response type: "
               << static_cast<int>(response.type) << std::endl;
 
-    // Re-acquire lock to restore state
+    // Re-acquire lock to restore state (unless the worker crashed meanwhile)
     {
       std::lock_guard<std::timed_mutex> lock(workers_mutex_);
       auto it = workers_.find(instance_id);
-      if (it != workers_.end()) {
-        setWorkerState(*it->second, WorkerState::READY);
+      if (it != workers_.end() && it->second->state == WorkerState::BUSY) {
+        WorkerInfo &worker = *it->second;
+        setWorkerState(worker, WorkerState::READY);
         std::cout << "[WorkerSupervisor] Set worker state back to READY"
                   << std::endl;
+
+        // Remember whether the pipeline runs, to resume it after a crash
+        bool ok = response.payload.get("success", false).asBool();
+        if (ok && response.type == MessageType::START_INSTANCE_RESPONSE) {
+          worker.pipeline_started = true;
+        } else if (ok &&
+                   response.type == MessageType::STOP_INSTANCE_RESPONSE) {
+          worker.pipeline_started = false;
+        }
       }
     }
   } catch (const std::exception &e) {
@@ -349,7 +495,7 @@ IPCMessage WorkerSupervisor::sendToWorker(const std::string &instance_id,
     {
       std::lock_guard<std::timed_mutex> lock(workers_mutex_);
       auto it = workers_.find(instance_id);
-      if (it != workers_.end()) {
+      if (it != workers_.end() && it->second->state == WorkerState::BUSY) {
         setWorkerState(*it->second, WorkerState::READY);
       }
     }
@@ -365,7 +511,7 @@ IPCMessage WorkerSupervisor::sendToWorker(const std::string &instance_id,
     {
       std::lock_guard<std::timed_mutex> lock(workers_mutex_);
       auto it = workers_.find(instance_id);
-      if (it != workers_.end()) {
+      if (it != workers_.end() && it->second->state == WorkerState::BUSY) {
         setWorkerState(*it->second, WorkerState::READY);
       }
     }
@@ -457,6 +603,10 @@ void WorkerSupervisor::setErrorCallback(ErrorCallback callback) {
   error_callback_ = std::move(callback);
 }
 
+void WorkerSupervisor::setRestartCallback(RestartCallback callback) {
+  restart_callback_ = std::move(callback);
+}
+
 std::optional<WorkerInfo>
 WorkerSupervisor::getWorkerInfo(const std::string &instance_id) const {
   std::lock_guard<std::timed_mutex> lock(workers_mutex_);
@@ -551,52 +701,482 @@ void WorkerSupervisor::monitorLoop() {
   }
 }
 
+void WorkerSupervisor::eventLoop() {
+  // Events are also dispatched by any request that reads the socket; this
+  // loop only picks up what arrives while a worker is idle
+  const auto poll_interval = std::chrono::milliseconds(50);
+
+  while (running_.load()) {
+    std::this_thread::sleep_for(poll_interval);
+
+    // Don't queue behind the monitor's heartbeat round, try again later
+    std::unique_lock<std::timed_mutex> lock(workers_mutex_,
+                                            std::chrono::milliseconds(10));
+    if (!lock.owns_lock()) {
+      continue;
+    }
+    for (auto &[instance_id, worker] : workers_) {
+      if (worker->client && worker->client->isConnected()) {
+        worker->client->pollEvents();
+      }
+    }
+  }
+}
+
+void WorkerSupervisor::handleWorkerEvent(const std::string &instance_id,
+                                         const IPCMessage &event) {
+  if (event.type != MessageType::STATISTICS_UPDATE) {
+    std::cout << "[Supervisor] Event " << static_cast<int>(event.type)
+              << " from worker " << instance_id << std::endl;
+    return;
+  }
+
+  const Json::Value &payload = event.payload;
+  uint64_t seq = payload.get("seq", 0).asUInt64();
+
+  std::unique_lock<std::shared_mutex> lock(statistics_mutex_);
+  if (!payload.get("running", false).asBool()) {
+    latest_statistics_.erase(instance_id);
+    auto counters = PipelineMetricsRegistry::getInstance().counters(instance_id);
+    counters->fps.store(0.0, std::memory_order_relaxed);
+    counters->queue_size.store(0, std::memory_order_relaxed);
+    return;
+  }
+
+  StatisticsSnapshot *snapshot = nullptr;
+  if (payload.get("full", false).asBool()) {
+    snapshot = &latest_statistics_[instance_id];
+    snapshot->data = payload["data"];
+  } else {
+    auto it = latest_statistics_.find(instance_id);
+    if (it == latest_statistics_.end()) {
+      return; // No base yet, wait for the next full snapshot
+    }
+    if (seq != it->second.seq + 1) {
+      // Missed an update - the merged snapshot can't be trusted anymore
+      latest_statistics_.erase(it);
+      return;
+    }
+    snapshot = &it->second;
+    applyStatisticsDelta(snapshot->data, payload["data"]);
+  }
+  auto now = std::chrono::steady_clock::now();
+  snapshot->seq = seq;
+  snapshot->updated = now;
+  PipelineMetricsRegistry::getInstance().updateFromStatistics(instance_id,
+                                                              snapshot->data);
+
+  // First frame of a restarted worker ends its recovery
+  auto recovering = recovering_.find(instance_id);
+  if (recovering != recovering_.end() &&
+      snapshot->data.get("frames_processed", 0).asUInt64() > 0) {
+    auto elapsed = now - recovering->second;
+    WorkerRecoveryMetrics::getInstance().recordRecovery(elapsed);
+    std::cout << "[Supervisor] Worker " << instance_id
+              << " processing frames again "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed)
+                     .count()
+              << "ms after crash" << std::endl;
+    recovering_.erase(recovering);
+  }
+}
+
+std::optional<Json::Value>
+WorkerSupervisor::getLatestStatistics(const std::string &instance_id,
+                                      std::chrono::milliseconds max_age) const {
+  std::shared_lock<std::shared_mutex> lock(statistics_mutex_);
+  auto it = latest_statistics_.find(instance_id);
+  if (it == latest_statistics_.end() ||
+      std::chrono::steady_clock::now() - it->second.updated > max_age) {
+    return std::nullopt;
+  }
+  return it->second.data;
+}
+
 void WorkerSupervisor::checkWorkerHealth(WorkerInfo &worker) {
   // Already implemented in monitorLoop
   (void)worker; // Suppress unused parameter warning
 }
 
-void WorkerSupervisor::handleWorkerCrash(const std::string &instance_id) {
-  if (error_callback_) {
-    error_callback_(instance_id, "Worker crashed");
+void WorkerSupervisor::exitWatchLoop() {
+  struct epoll_event events[16];
+
+  while (running_.load()) {
+    int n = epoll_wait(epoll_fd_, events, 16, -1);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      std::cerr << "[Supervisor] epoll_wait failed: " << strerror(errno)
+                << std::endl;
+      break;
+    }
+
+    for (int i = 0; i < n; ++i) {
+      uint64_t token = events[i].data.u64;
+      if (token == WAKE_TOKEN) {
+        uint64_t value;
+        ssize_t drained = read(wake_fd_, &value, sizeof(value));
+        (void)drained;
+        continue;
+      }
+
+      // Watches are one-shot: claim the entry so it fires only once
+      ExitWatch watch;
+      {
+        std::lock_guard<std::mutex> lock(watch_mutex_);
+        auto it = exit_watches_.find(token);
+        if (it == exit_watches_.end()) {
+          continue; // Unwatched meanwhile (worker terminated/cleaned up)
+        }
+        watch = it->second;
+        exit_watches_.erase(it);
+      }
+
+      if (watch.is_pidfd) {
+        onWorkerExited(watch.instance_id, watch.pid);
+      } else {
+        onWorkerHangup(watch.instance_id, watch.pid);
+      }
+    }
   }
+}
 
-  // Attempt restart if under limit
-  std::lock_guard<std::timed_mutex> lock(workers_mutex_);
-  auto it = workers_.find(instance_id);
-  if (it == workers_.end())
+void WorkerSupervisor::watchWorker(WorkerInfo &worker) {
+  if (epoll_fd_ < 0 || worker.pid <= 0) {
     return;
+  }
 
-  WorkerInfo &worker = *it->second;
+  auto addWatch = [this, &worker](int fd, bool is_pidfd, uint32_t events) {
+    std::lock_guard<std::mutex> lock(watch_mutex_);
+    uint64_t token = next_watch_token_++;
+    struct epoll_event ev;
+    std::memset(&ev, 0, sizeof(ev));
+    ev.events = events | EPOLLONESHOT;
+    ev.data.u64 = token;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) == 0) {
+      exit_watches_[token] = ExitWatch{worker.instance_id, worker.pid, fd,
+                                       is_pidfd};
+    }
+  };
 
-  if (worker.restart_count < max_restarts_) {
-    std::cout << "[Supervisor] Attempting restart "
-              << (worker.restart_count + 1) << "/" << max_restarts_ << " for "
-              << instance_id << std::endl;
+  if (worker.pidfd < 0) {
+    worker.pidfd = openPidfd(worker.pid);
+  }
+  if (worker.pidfd >= 0) {
+    fcntl(worker.pidfd, F_SETFD, FD_CLOEXEC);
+    addWatch(worker.pidfd, true, EPOLLIN);
+  }
+  if (worker.client && worker.client->getFd() >= 0) {
+    // Only hang-up; readable data is handled by the event/request paths
+    addWatch(worker.client->getFd(), false, EPOLLRDHUP);
+  }
+}
+
+void WorkerSupervisor::unwatchWorker(WorkerInfo &worker) {
+  if (epoll_fd_ < 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(watch_mutex_);
+  for (auto it = exit_watches_.begin(); it != exit_watches_.end();) {
+    if (it->second.instance_id == worker.instance_id) {
+      epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, it->second.fd, nullptr);
+      it = exit_watches_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void WorkerSupervisor::onWorkerExited(const std::string &instance_id,
+                                      pid_t pid) {
+  {
+    std::lock_guard<std::timed_mutex> lock(workers_mutex_);
+    auto it = workers_.find(instance_id);
+    if (it == workers_.end() || it->second->pid != pid) {
+      return; // Terminated on purpose, or already handled by the monitor
+    }
+    WorkerInfo &worker = *it->second;
+
+    int status = 0;
+    if (waitpid(pid, &status, WNOHANG) == pid) {
+      if (WIFEXITED(status)) {
+        std::cout << "[Supervisor] Worker " << instance_id
+                  << " exited with code " << WEXITSTATUS(status) << std::endl;
+      } else if (WIFSIGNALED(status)) {
+        std::cout << "[Supervisor] Worker " << instance_id
+                  << " killed by signal " << WTERMSIG(status) << std::endl;
+      }
+    }
+    worker.last_error = "Worker process exited";
+    setWorkerState(worker, WorkerState::CRASHED);
+  }
+  handleWorkerCrash(instance_id);
+}
+
+void WorkerSupervisor::onWorkerHangup(const std::string &instance_id,
+                                      pid_t pid) {
+  bool exited = false;
+  {
+    std::lock_guard<std::timed_mutex> lock(workers_mutex_);
+    auto it = workers_.find(instance_id);
+    if (it == workers_.end() || it->second->pid != pid ||
+        it->second->state == WorkerState::STOPPING) {
+      return;
+    }
+    WorkerInfo &worker = *it->second;
+
+    int status = 0;
+    pid_t result = waitpid(pid, &status, WNOHANG);
+    if (result == 0) {
+      // Alive but unreachable: it can't be controlled anymore. Kill it so the
+      // pidfd (or heartbeat) path restarts it.
+      std::cerr << "[Supervisor] Worker " << instance_id
+                << " closed its IPC connection, killing PID " << pid
+                << std::endl;
+      worker.last_error = "IPC connection lost";
+      kill(pid, SIGKILL);
+      return;
+    }
+    if (worker.pidfd >= 0 && result < 0) {
+      return; // Not reaped here; the pidfd watch reports the exit
+    }
+    // Reaped here, so the pidfd path would not find anything to report
+    worker.last_error = "Worker process exited";
+    setWorkerState(worker, WorkerState::CRASHED);
+    exited = true;
+  }
+  if (exited) {
+    handleWorkerCrash(instance_id);
+  }
+}
+
+void WorkerSupervisor::handleWorkerCrash(const std::string &instance_id) {
+  auto crashed_at = std::chrono::steady_clock::now();
+
+  uint64_t ticket = 0;
+  int delay_ms = 0;
+  {
+    std::lock_guard<std::timed_mutex> lock(workers_mutex_);
+    auto it = workers_.find(instance_id);
+    if (it == workers_.end())
+      return;
+
+    WorkerInfo &worker = *it->second;
+    if (worker.state != WorkerState::CRASHED || worker.pid <= 0) {
+      return; // Already handled (exit watch and heartbeat both noticed)
+    }
+
+    // A hung worker (heartbeat timeout) is still alive - make sure it's gone
+    if (waitpid(worker.pid, nullptr, WNOHANG) == 0) {
+      kill(worker.pid, SIGKILL);
+      waitpid(worker.pid, nullptr, 0);
+    }
 
     // Clean up old resources
     cleanupWorker(worker);
 
-    // Wait before restart
-    std::this_thread::sleep_for(std::chrono::milliseconds(restart_delay_ms_));
+    // A worker that ran fine for a while starts over with its restart budget
+    if (restart_policy_.ranStably(crashed_at - worker.start_time)) {
+      worker.restart_count = 0;
+    }
 
-    // Note: Full restart would need to re-read config from storage
-    // For now, just increment counter and mark as stopped
-    worker.restart_count++;
-    setWorkerState(worker, WorkerState::STOPPED);
-  } else {
-    std::cerr << "[Supervisor] Max restarts reached for " << instance_id
+    ticket = nextRestartLocked(worker, delay_ms);
+  }
+
+  WorkerRecoveryMetrics::getInstance().recordCrash();
+  if (error_callback_) {
+    error_callback_(instance_id, "Worker crashed");
+  }
+  if (ticket == 0) {
+    giveUpRestart(instance_id);
+    return;
+  }
+  scheduleRestart(instance_id, ticket, crashed_at, delay_ms);
+}
+
+uint64_t WorkerSupervisor::nextRestartLocked(WorkerInfo &worker,
+                                             int &delay_ms) {
+  if (restart_policy_.exhausted(worker.restart_count)) {
+    std::cerr << "[Supervisor] Max restarts reached for " << worker.instance_id
               << std::endl;
-    cleanupWorker(worker);
-    workers_.erase(it);
+    std::string instance_id = worker.instance_id;
+    workers_.erase(instance_id); // worker is gone from here on
+    releaseInstanceResourcesLocked(instance_id);
+    return 0;
+  }
+
+  int attempt = ++worker.restart_count;
+  delay_ms = restart_policy_.delayMs(attempt);
+  worker.restarting = true;
+  worker.restart_ticket = next_restart_ticket_++;
+  std::cout << "[Supervisor] Attempting restart " << attempt << "/"
+            << restart_policy_.max_restarts << " for " << worker.instance_id
+            << (delay_ms > 0 ? " in " + std::to_string(delay_ms) + "ms" : "")
+            << std::endl;
+  return worker.restart_ticket;
+}
+
+void WorkerSupervisor::giveUpRestart(const std::string &instance_id) {
+  {
+    std::unique_lock<std::shared_mutex> lock(statistics_mutex_);
+    recovering_.erase(instance_id);
+  }
+  if (restart_callback_) {
+    restart_callback_(instance_id, false, false);
+  }
+}
+
+void WorkerSupervisor::scheduleRestart(
+    const std::string &instance_id, uint64_t ticket,
+    std::chrono::steady_clock::time_point crashed_at, int delay_ms) {
+  {
+    std::lock_guard<std::mutex> lock(restart_mutex_);
+    if (!running_.load()) {
+      return; // Entry is removed by stop()
+    }
+    pending_restarts_.emplace(std::chrono::steady_clock::now() +
+                                  std::chrono::milliseconds(delay_ms),
+                              PendingRestart{instance_id, ticket, crashed_at});
+  }
+  restart_cv_.notify_one();
+}
+
+void WorkerSupervisor::restartLoop() {
+  std::unique_lock<std::mutex> lock(restart_mutex_);
+  while (running_.load()) {
+    if (pending_restarts_.empty()) {
+      restart_cv_.wait(lock);
+      continue;
+    }
+    auto next = pending_restarts_.begin();
+    if (std::chrono::steady_clock::now() < next->first) {
+      restart_cv_.wait_until(lock, next->first);
+      continue;
+    }
+    PendingRestart restart = next->second;
+    pending_restarts_.erase(next);
+
+    lock.unlock();
+    restartWorker(restart.instance_id, restart.ticket, restart.crashed_at);
+    lock.lock();
   }
 }
 
-bool WorkerSupervisor::restartWorker(const std::string &instance_id) {
-  // This would need access to the original config
-  // Implementation depends on how config is stored
-  (void)instance_id; // Suppress unused parameter warning
-  return false;
+bool WorkerSupervisor::restartWorker(
+    const std::string &instance_id, uint64_t ticket,
+    std::chrono::steady_clock::time_point crashed_at) {
+  // Matches only the crashed entry this restart was scheduled for
+  auto findEntry = [this, &instance_id, ticket]() -> WorkerInfo * {
+    auto it = workers_.find(instance_id);
+    if (it == workers_.end() || !it->second->restarting ||
+        it->second->restart_ticket != ticket) {
+      return nullptr;
+    }
+    return it->second.get();
+  };
+
+  Json::Value config;
+  bool pipeline_started = false;
+  {
+    std::lock_guard<std::timed_mutex> lock(workers_mutex_);
+    WorkerInfo *entry = findEntry();
+    if (!entry) {
+      return false; // Terminated while waiting for the restart
+    }
+    config = entry->config;
+    pipeline_started = entry->pipeline_started;
+  }
+
+  // Spawn and wait for ready without the lock; the crashed entry stays in
+  // place meanwhile
+  std::unique_ptr<WorkerInfo> fresh = launchWorker(instance_id, config);
+
+  if (!fresh) {
+    WorkerRecoveryMetrics::getInstance().recordRestartFailure();
+    std::cerr << "[Supervisor] Failed to restart worker for " << instance_id
+              << std::endl;
+    uint64_t next_ticket = 0;
+    int delay_ms = 0;
+    {
+      std::lock_guard<std::timed_mutex> lock(workers_mutex_);
+      WorkerInfo *entry = findEntry();
+      if (!entry) {
+        if (workers_.find(instance_id) == workers_.end()) {
+          // Terminated meanwhile; the launch assigned resources again
+          releaseInstanceResourcesLocked(instance_id);
+        }
+        return false;
+      }
+      next_ticket = nextRestartLocked(*entry, delay_ms);
+    }
+    if (next_ticket == 0) {
+      giveUpRestart(instance_id);
+    } else {
+      scheduleRestart(instance_id, next_ticket, crashed_at, delay_ms);
+    }
+    return false;
+  }
+
+  {
+    std::lock_guard<std::timed_mutex> lock(workers_mutex_);
+    WorkerInfo *entry = running_.load() ? findEntry() : nullptr;
+    if (!entry) {
+      // Terminated (or stopped) while the new process started: don't leave
+      // it running for an instance that is gone
+      std::cout << "[Supervisor] Worker " << instance_id
+                << " was terminated during restart, killing PID " << fresh->pid
+                << std::endl;
+      fresh->client.reset();
+      kill(fresh->pid, SIGKILL);
+      waitpid(fresh->pid, nullptr, 0);
+      if (workers_.find(instance_id) == workers_.end()) {
+        cleanupSocket(fresh->socket_path);
+        releaseInstanceResourcesLocked(instance_id);
+      }
+      return false;
+    }
+    fresh->restart_count = entry->restart_count;
+    watchWorker(*fresh);
+    workers_[instance_id] = std::move(fresh);
+  }
+  {
+    // Keeps the first crash time if the worker crashed again while recovering
+    std::unique_lock<std::shared_mutex> lock(statistics_mutex_);
+    recovering_.emplace(instance_id, crashed_at);
+  }
+  WorkerRecoveryMetrics::getInstance().recordRestart();
+
+  bool resumed = false;
+  if (pipeline_started) {
+    IPCMessage start_msg;
+    start_msg.type = MessageType::START_INSTANCE;
+    start_msg.payload["instance_id"] = instance_id;
+    IPCMessage response = sendToWorker(
+        instance_id, start_msg, TimeoutConstants::getIpcStartStopTimeoutMs());
+    resumed = response.type == MessageType::START_INSTANCE_RESPONSE &&
+              response.payload.get("success", false).asBool();
+    if (!resumed) {
+      std::cerr << "[Supervisor] Restarted worker " << instance_id
+                << " but could not resume its pipeline" << std::endl;
+    }
+  }
+  if (!resumed) {
+    std::unique_lock<std::shared_mutex> lock(statistics_mutex_);
+    recovering_.erase(instance_id); // No frames expected
+  }
+
+  std::cout << "[Supervisor] Worker " << instance_id << " restarted "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::steady_clock::now() - crashed_at)
+                   .count()
+            << "ms after crash" << (resumed ? ", pipeline resumed" : "")
+            << std::endl;
+
+  if (restart_callback_) {
+    restart_callback_(instance_id, true, resumed);
+  }
+  return true;
 }
 
 bool WorkerSupervisor::waitForWorkerReady(WorkerInfo &worker, int timeout_ms) {
@@ -623,6 +1203,10 @@ bool WorkerSupervisor::waitForWorkerReady(WorkerInfo &worker, int timeout_ms) {
     // Try to connect to socket
     if (!worker.client) {
       worker.client = std::make_unique<UnixSocketClient>(worker.socket_path);
+      worker.client->setEventHandler(
+          [this, instance_id = worker.instance_id](const IPCMessage &event) {
+            handleWorkerEvent(instance_id, event);
+          });
     }
 
     if (!worker.client->isConnected()) {
@@ -656,15 +1240,45 @@ void WorkerSupervisor::setWorkerState(WorkerInfo &worker,
 }
 
 void WorkerSupervisor::cleanupWorker(WorkerInfo &worker) {
+  unwatchWorker(worker);
+  if (worker.pidfd >= 0) {
+    close(worker.pidfd);
+    worker.pidfd = -1;
+  }
+
   if (worker.client) {
     worker.client->disconnect();
     worker.client.reset();
   }
 
+  {
+    std::unique_lock<std::shared_mutex> lock(statistics_mutex_);
+    latest_statistics_.erase(worker.instance_id);
+  }
+
   cleanupSocket(worker.socket_path);
   worker.pid = -1;
 }
 
+void WorkerSupervisor::releaseInstanceResourcesLocked(
+    const std::string &instance_id) {
+  WorkerCgroupManager::getInstance().remove(instance_id);
+  PipelineMetricsRegistry::getInstance().remove(instance_id);
+
+  for (const auto &move : CpuPlacement::getInstance().release(instance_id)) {
+    auto it = workers_.find(move.instance_id);
+    if (it == workers_.end() || it->second->pid <= 0) {
+      continue; // Picked up on its next spawn
+    }
+    if (CpuPlacement::applyToProcess(it->second->pid, move.assignment.cpus)) {
+      std::cout << "[Supervisor] Moved worker " << move.instance_id
+                << " to CPUs "
+                << CpuPlacement::formatCpuList(move.assignment.cpus)
+                << std::endl;
+    }
+  }
+}
+
 std::string WorkerSupervisor::findWorkerExecutable() const {
   // 1. Check if it's an absolute path
   if (worker_executable_[0] == '/') {
@@ -0,0 +1,193 @@
+#include "core/async_log.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <fcntl.h>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+// Output that records what the writer hands it
+struct Capture {
+  std::mutex mutex;
+  std::string text;
+  size_t writes = 0;
+
+  AsyncLogBackend::Writer writer() {
+    return [this](const char *data, size_t size) {
+      std::lock_guard<std::mutex> lock(mutex);
+      text.append(data, size);
+      ++writes;
+    };
+  }
+};
+
+std::vector<std::string> lines(const std::string &text) {
+  std::vector<std::string> out;
+  std::istringstream in(text);
+  std::string line;
+  while (std::getline(in, line)) {
+    out.push_back(line);
+  }
+  return out;
+}
+
+} // namespace
+
+class AsyncLogTest : public ::testing::Test {
+protected:
+  void TearDown() override { AsyncLogBackend::getInstance().shutdown(); }
+};
+
+TEST_F(AsyncLogTest, BatchesRecordsFromManyThreadsInTimeOrder) {
+  auto &backend = AsyncLogBackend::getInstance();
+  // Outputs and sinks live as long as the backend: register once per process
+  static Capture capture;
+  static uint16_t sink = backend.addSink(
+      [](const AsyncLogBackend::Record &record, std::string &out) {
+        out += std::to_string(record.time_ns);
+        out += ' ';
+        out.append(record.message, record.message_len);
+        out += '\n';
+      },
+      backend.addOutput("capture", capture.writer()));
+  {
+    std::lock_guard<std::mutex> lock(capture.mutex);
+    capture.text.clear();
+    capture.writes = 0;
+  }
+
+  AsyncLogBackend::Config config;
+  config.flush_interval = std::chrono::milliseconds(5);
+  backend.start(config);
+  auto before = backend.getStats();
+
+  constexpr int kThreads = 4;
+  constexpr int kLines = 500;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < kLines; ++i) {
+        std::string message = "t" + std::to_string(t) + " " + std::to_string(i);
+        backend.write(sink, message.data(), message.size());
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  backend.flush();
+
+  auto after = backend.getStats();
+  EXPECT_EQ(after.dropped, before.dropped);
+  std::lock_guard<std::mutex> lock(capture.mutex);
+  auto written = lines(capture.text);
+  ASSERT_EQ(written.size(), static_cast<size_t>(kThreads * kLines));
+  EXPECT_LT(capture.writes, written.size()); // Batched, not one per line
+
+  int64_t last_time = 0;
+  std::vector<int> next(kThreads, 0);
+  for (const auto &line : written) {
+    std::istringstream in(line);
+    int64_t time_ns = 0;
+    std::string thread, index;
+    in >> time_ns >> thread >> index;
+    EXPECT_GE(time_ns, last_time);
+    last_time = time_ns;
+    int t = std::stoi(thread.substr(1));
+    EXPECT_EQ(std::stoi(index), next[t]++); // Per-thread order kept
+  }
+}
+
+TEST_F(AsyncLogTest, DropsAndCountsWhenWriterFallsBehind) {
+  auto &backend = AsyncLogBackend::getInstance();
+  static std::mutex gate_mutex;
+  static std::condition_variable gate_cv;
+  static bool open;
+  static std::atomic<size_t> written;
+  static uint16_t sink = backend.addSink(
+      nullptr, backend.addOutput("slow", [](const char *, size_t size) {
+        std::unique_lock<std::mutex> lock(gate_mutex);
+        gate_cv.wait(lock, []() { return open; });
+        written += size;
+      }));
+  open = false;
+  written = 0;
+
+  AsyncLogBackend::Config config;
+  config.ring_bytes = 4096;
+  config.flush_interval = std::chrono::milliseconds(1);
+  config.drop_policy = AsyncLogBackend::DropPolicy::Drop;
+  backend.start(config);
+  auto before = backend.getStats();
+
+  // Fresh thread, fresh 4 KiB ring; the writer is stuck on the gate
+  std::string line(100, 'x');
+  line += '\n';
+  size_t accepted = 0;
+  std::thread producer([&]() {
+    backend.write(sink, line.data(), line.size());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    for (int i = 0; i < 200; ++i) {
+      accepted += backend.write(sink, line.data(), line.size()) ? 1 : 0;
+    }
+  });
+  producer.join();
+
+  auto stats = backend.getStats();
+  EXPECT_GT(stats.dropped, before.dropped);
+  EXPECT_EQ(stats.dropped - before.dropped, 200 - accepted);
+  EXPECT_GE(stats.dropped_bytes - before.dropped_bytes,
+            (200 - accepted) * line.size());
+
+  {
+    std::lock_guard<std::mutex> lock(gate_mutex);
+    open = true;
+  }
+  gate_cv.notify_all();
+  backend.shutdown();
+  EXPECT_EQ(written.load(), (accepted + 1) * line.size());
+}
+
+TEST_F(AsyncLogTest, RedirectsStdStreamsLineByLine) {
+  char path[] = "/tmp/async_log_test_XXXXXX";
+  int fd = mkstemp(path);
+  ASSERT_GE(fd, 0);
+  std::cout.flush();
+  int saved_stdout = dup(1);
+  dup2(fd, 1);
+
+  auto &backend = AsyncLogBackend::getInstance();
+  AsyncLogBackend::Config config;
+  config.flush_interval = std::chrono::milliseconds(5);
+  backend.start(config);
+  backend.redirectStdStreams();
+
+  std::thread worker([]() {
+    std::cout << "[Worker] part one, " << 42 << std::flush;
+    std::cout << " part two" << std::endl;
+    std::cout << "[Worker] unterminated";
+  });
+  worker.join(); // Thread exit flushes the unterminated text
+  std::cout << "[Main] done" << std::endl;
+  backend.shutdown();
+
+  fflush(stdout);
+  dup2(saved_stdout, 1);
+  close(saved_stdout);
+  close(fd);
+
+  std::ifstream in(path);
+  std::stringstream content;
+  content << in.rdbuf();
+  unlink(path);
+  EXPECT_EQ(content.str(),
+            "[Worker] part one, 42 part two\n[Worker] unterminated[Main] "
+            "done\n");
+}
@@ -0,0 +1,131 @@
+#include "core/backpressure_controller.h"
+#include <algorithm>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace BackpressureController;
+
+class BackpressureControllerTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    prefix_ = "backpressure_test_" +
+              std::to_string(reinterpret_cast<uintptr_t>(this)) + "_";
+  }
+
+  void TearDown() override {
+    auto &controller = BackpressureController::BackpressureController::getInstance();
+    for (const auto &id : ids_) {
+      controller.unregisterInstance(id);
+      QueueTelemetry::getInstance().remove(id);
+    }
+  }
+
+  InstanceHandle registerInstance(const std::string &name, DropPolicy policy,
+                                  double max_fps, size_t max_queue_size) {
+    ids_.push_back(prefix_ + name);
+    return BackpressureController::BackpressureController::getInstance()
+        .registerInstance(ids_.back(), policy, max_fps, max_queue_size);
+  }
+
+  std::string prefix_;
+  std::vector<std::string> ids_;
+};
+
+TEST_F(BackpressureControllerTest, HandleIsStableAcrossReconfigure) {
+  auto &controller = BackpressureController::BackpressureController::getInstance();
+  auto handle = registerInstance("stable", DropPolicy::DROP_NEWEST, 30.0, 10);
+  ASSERT_NE(handle, nullptr);
+  EXPECT_EQ(controller.getHandle(ids_.back()), handle);
+
+  auto again = controller.registerInstance(ids_.back(),
+                                           DropPolicy::ADAPTIVE_FPS, 15.0, 20);
+  EXPECT_EQ(again, handle);
+  EXPECT_EQ(handle->getPolicy(), DropPolicy::ADAPTIVE_FPS);
+  EXPECT_DOUBLE_EQ(handle->getMaxFPS(), 15.0);
+  EXPECT_EQ(controller.getMaxQueueSize(ids_.back()), 20u);
+
+  controller.unregisterInstance(ids_.back());
+  EXPECT_EQ(controller.getHandle(ids_.back()), nullptr);
+  EXPECT_FALSE(controller.shouldDropFrame(ids_.back()));
+  // Handles captured before unregistering keep working
+  handle->recordFrameDropped();
+  EXPECT_EQ(BackpressureController::BackpressureController::getStats(*handle)
+                .frames_dropped,
+            1u);
+}
+
+TEST_F(BackpressureControllerTest, PacesFramesAndDropsOnQueueDepth) {
+  auto handle = registerInstance("pacing", DropPolicy::DROP_NEWEST, 20.0, 10);
+
+  EXPECT_FALSE(handle->shouldDropFrame()); // First frame always passes
+  EXPECT_TRUE(handle->shouldDropFrame());  // Within 50 ms interval
+  std::this_thread::sleep_for(std::chrono::milliseconds(60));
+  EXPECT_FALSE(handle->shouldDropFrame());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(60));
+  handle->updateQueueSize(5); // 50% of max queue size
+  EXPECT_TRUE(handle->shouldDropFrame());
+  handle->updateQueueSize(0);
+  EXPECT_FALSE(handle->shouldDropFrame());
+}
+
+TEST_F(BackpressureControllerTest, StringApiMatchesHandle) {
+  auto &controller = BackpressureController::BackpressureController::getInstance();
+  auto handle = registerInstance("string_api", DropPolicy::DROP_NEWEST, 30.0, 10);
+
+  controller.recordFrameProcessed(ids_.back());
+  controller.recordFrameDropped(ids_.back());
+  controller.recordQueueFull(ids_.back());
+
+  auto stats = controller.getStats(ids_.back());
+  EXPECT_EQ(stats.frames_processed, 1u);
+  EXPECT_EQ(stats.frames_dropped, 1u);
+  EXPECT_EQ(stats.queue_full_count, 1u);
+  EXPECT_TRUE(controller.isBackpressureDetected(ids_.back()));
+
+  controller.resetStats(ids_.back());
+  EXPECT_EQ(BackpressureController::BackpressureController::getStats(*handle)
+                .frames_processed,
+            0u);
+}
+
+TEST_F(BackpressureControllerTest, AdaptiveFpsConvergesWithoutOscillation) {
+  auto handle = registerInstance("adaptive", DropPolicy::ADAPTIVE_FPS, 30.0, 20);
+
+  // Plant: pipeline drains 20 FPS, queue grows when input exceeds that
+  const double capacity_fps = 20.0;
+  const double dt = 0.25;
+  double depth = 0.0;
+  std::vector<double> targets;
+  for (int step = 0; step < 240; ++step) {
+    double target = handle->applyControlStep(depth / 20.0, dt);
+    depth = std::clamp(depth + (target - capacity_fps) * dt, 0.0, 20.0);
+    targets.push_back(target);
+  }
+
+  // Never collapses to MIN_FPS or sticks at the ceiling
+  auto [lo, hi] = std::minmax_element(targets.end() - 80, targets.end());
+  EXPECT_GT(*lo, capacity_fps - 2.0);
+  EXPECT_LT(*hi, capacity_fps + 2.0);
+  EXPECT_LT(depth, 20.0 * 0.8);
+  EXPECT_GE(*std::min_element(targets.begin(), targets.end()),
+            BackpressureController::BackpressureController::MIN_FPS);
+}
+
+TEST_F(BackpressureControllerTest, AdaptiveFpsRecoversWhenQueueDrains) {
+  auto handle = registerInstance("recover", DropPolicy::ADAPTIVE_FPS, 30.0, 20);
+  for (int i = 0; i < 20; ++i) {
+    handle->applyControlStep(1.0, 0.25);
+  }
+  double reduced = handle->getTargetFPS();
+  EXPECT_LT(reduced, 30.0);
+  EXPECT_TRUE(handle->isBackpressureDetected());
+
+  for (int i = 0; i < 40; ++i) {
+    handle->applyControlStep(0.0, 0.25);
+  }
+  EXPECT_DOUBLE_EQ(handle->getTargetFPS(), 30.0);
+  EXPECT_FALSE(handle->isBackpressureDetected());
+}
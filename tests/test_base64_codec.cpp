@@ -0,0 +1,137 @@
+#include "utils/base64_codec.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Straightforward reference (the loop the handlers used to carry)
+std::string referenceEncode(const std::vector<unsigned char> &data) {
+  static const char chars[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string encoded;
+  unsigned int val = 0;
+  int valb = -6;
+  for (unsigned char c : data) {
+    val = (val << 8) + c;
+    valb += 8;
+    while (valb >= 0) {
+      encoded.push_back(chars[(val >> valb) & 0x3F]);
+      valb -= 6;
+    }
+  }
+  if (valb > -6) {
+    encoded.push_back(chars[((val << 8) >> (valb + 8)) & 0x3F]);
+  }
+  while (encoded.size() % 4) {
+    encoded.push_back('=');
+  }
+  return encoded;
+}
+
+std::vector<unsigned char> randomBytes(size_t size, std::mt19937 &rng) {
+  std::vector<unsigned char> data(size);
+  for (auto &byte : data) {
+    byte = static_cast<unsigned char>(rng());
+  }
+  return data;
+}
+
+std::vector<Base64::Impl> supportedImpls() {
+  std::vector<Base64::Impl> impls;
+  for (auto impl : {Base64::Impl::Scalar, Base64::Impl::SSSE3,
+                    Base64::Impl::AVX2, Base64::Impl::NEON}) {
+    if (Base64::isSupported(impl)) {
+      impls.push_back(impl);
+    }
+  }
+  return impls;
+}
+
+} // namespace
+
+TEST(Base64CodecTest, MatchesReferenceForAllLengthsAndImplementations) {
+  std::mt19937 rng(42);
+  for (size_t size = 0; size < 300; ++size) {
+    auto data = randomBytes(size, rng);
+    std::string expected = referenceEncode(data);
+    for (auto impl : supportedImpls()) {
+      SCOPED_TRACE(std::string(Base64::implName(impl)) + " size " +
+                   std::to_string(size));
+      std::string encoded = Base64::encode(data.data(), data.size(), impl);
+      ASSERT_EQ(encoded, expected);
+      std::vector<unsigned char> decoded;
+      ASSERT_TRUE(
+          Base64::decode(encoded.data(), encoded.size(), decoded, impl));
+      ASSERT_EQ(decoded, data);
+    }
+  }
+  EXPECT_EQ(Base64::encode("foobar", 6), "Zm9vYmFy");
+  EXPECT_EQ(Base64::encode("fo", 2), "Zm8=");
+}
+
+TEST(Base64CodecTest, RejectsEveryInvalidByteInsideSimdBlocks) {
+  std::mt19937 rng(7);
+  std::string valid = Base64::encode(randomBytes(3 * 64, rng));
+  for (auto impl : supportedImpls()) {
+    for (int byte = 0; byte < 256; ++byte) {
+      char c = static_cast<char>(byte);
+      bool alphabet = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+                      (c >= '0' && c <= '9') || c == '+' || c == '/';
+      bool space = c == ' ' || c == '\n' || c == '\r' || c == '\t';
+      if (alphabet || space) {
+        continue;
+      }
+      for (size_t pos : {size_t(0), size_t(17), size_t(40), size_t(127)}) {
+        std::string text = valid;
+        text[pos] = c;
+        std::vector<unsigned char> decoded;
+        EXPECT_FALSE(Base64::decode(text.data(), text.size(), decoded, impl))
+            << Base64::implName(impl) << " byte " << byte << " at " << pos;
+      }
+    }
+  }
+}
+
+TEST(Base64CodecTest, SkipsWhitespaceAndAcceptsMissingPadding) {
+  std::mt19937 rng(3);
+  auto data = randomBytes(1000, rng);
+  std::string encoded = Base64::encode(data);
+
+  // MIME-style 76-character lines with CRLF
+  std::string wrapped;
+  for (size_t i = 0; i < encoded.size(); i += 76) {
+    wrapped += encoded.substr(i, 76) + "\r\n";
+  }
+  for (auto impl : supportedImpls()) {
+    std::vector<unsigned char> decoded;
+    ASSERT_TRUE(
+        Base64::decode(wrapped.data(), wrapped.size(), decoded, impl));
+    EXPECT_EQ(decoded, data) << Base64::implName(impl);
+  }
+
+  std::vector<unsigned char> decoded;
+  ASSERT_TRUE(Base64::decode("Zm8", decoded));
+  EXPECT_EQ(std::string(decoded.begin(), decoded.end()), "fo");
+  ASSERT_TRUE(Base64::decode(" Zm9v YmE= \n", decoded));
+  EXPECT_EQ(std::string(decoded.begin(), decoded.end()), "fooba");
+  ASSERT_TRUE(Base64::decode("", decoded));
+  EXPECT_TRUE(decoded.empty());
+
+  EXPECT_FALSE(Base64::decode("Zm9vY", decoded));    // Truncated group
+  EXPECT_FALSE(Base64::decode("Zm8==", decoded));    // Too much padding
+  EXPECT_FALSE(Base64::decode("Zm8=Zm8=", decoded)); // Data after padding
+  EXPECT_FALSE(Base64::decode("====", decoded));
+}
+
+TEST(Base64CodecTest, IsBase64ChecksAlphabetAndPadding) {
+  EXPECT_TRUE(Base64::isBase64("Zm9vYmE=\r\n"));
+  // Same whitespace decode() skips
+  EXPECT_TRUE(Base64::isBase64("Zm9v\tYmE="));
+  std::vector<unsigned char> decoded;
+  EXPECT_TRUE(Base64::decode("Zm9v\tYmE=", decoded));
+  EXPECT_FALSE(Base64::isBase64(""));
+  EXPECT_FALSE(Base64::isBase64("Zm9v-mE="));
+  EXPECT_FALSE(Base64::isBase64("Zm9vY==="));
+}
@@ -0,0 +1,99 @@
+#include "worker/cpu_placement.h"
+#include <gtest/gtest.h>
+
+using namespace worker;
+
+namespace {
+
+std::vector<CpuPlacement::Cpu> makeCpus(int count, int per_node,
+                                        int capacity = 1024) {
+  std::vector<CpuPlacement::Cpu> cpus;
+  for (int id = 0; id < count; ++id) {
+    cpus.push_back(CpuPlacement::Cpu{id, id / per_node, capacity});
+  }
+  return cpus;
+}
+
+} // namespace
+
+TEST(CpuPlacementTest, CpuListRoundTrip) {
+  auto cpus = CpuPlacement::parseCpuList("0-2, 5,7-8,2");
+  EXPECT_EQ(cpus, (std::vector<int>{0, 1, 2, 5, 7, 8}));
+  EXPECT_EQ(CpuPlacement::formatCpuList(cpus), "0-2,5,7-8");
+  EXPECT_TRUE(CpuPlacement::parseCpuList("").empty());
+}
+
+TEST(CpuPlacementTest, SpreadPrefersBigCoresAndRebalancesOnRelease) {
+  auto &placement = CpuPlacement::getInstance();
+
+  // big.LITTLE: CPUs 0-3 LITTLE, 4-7 big
+  auto cpus = makeCpus(8, 8);
+  for (int id = 0; id < 4; ++id) {
+    cpus[id].capacity = 446;
+  }
+  CpuPlacement::Config config;
+  config.policy = CpuPlacement::Policy::Spread;
+  config.cpus_per_worker = 2;
+  placement.configure(config, cpus);
+  EXPECT_EQ(placement.assign("a").cpus, (std::vector<int>{4, 5}));
+  EXPECT_EQ(placement.assign("b").cpus, (std::vector<int>{6, 7}));
+  EXPECT_EQ(placement.assign("a").cpus, (std::vector<int>{4, 5})); // Sticky
+  EXPECT_EQ(placement.assign("a").node, -1); // Single node
+
+  // Four single-CPU workers fill the node, the fifth shares CPU 0
+  config.cpus_per_worker = 1;
+  placement.configure(config, makeCpus(4, 4));
+  for (const char *id : {"w1", "w2", "w3", "w4", "w5"}) {
+    placement.assign(id);
+  }
+  EXPECT_EQ(placement.getAssignment("w5")->cpus, (std::vector<int>{0}));
+
+  // Stopping w2 frees CPU 1; w5 moves there instead of sharing with w1
+  auto moves = placement.release("w2");
+  ASSERT_EQ(moves.size(), 1u);
+  EXPECT_EQ(moves[0].instance_id, "w5");
+  EXPECT_EQ(moves[0].assignment.cpus, (std::vector<int>{1}));
+  EXPECT_FALSE(placement.getAssignment("w2").has_value());
+}
+
+TEST(CpuPlacementTest, PackFillsLowestNodeAndSkipsReservedCpus) {
+  auto &placement = CpuPlacement::getInstance();
+  CpuPlacement::Config config;
+  config.policy = CpuPlacement::Policy::Pack;
+  config.cpus_per_worker = 1;
+  config.reserved_cpus = {0};
+  placement.configure(config, makeCpus(6, 3));
+
+  auto first = placement.assign("a");
+  EXPECT_EQ(first.cpus, (std::vector<int>{1}));
+  EXPECT_EQ(first.node, 0);
+  EXPECT_EQ(placement.assign("b").cpus, (std::vector<int>{2}));
+  auto third = placement.assign("c");
+  EXPECT_EQ(third.cpus, (std::vector<int>{3}));
+  EXPECT_EQ(third.node, 1);
+
+  // Policy none only keeps workers off the reserved CPUs
+  config.policy = CpuPlacement::Policy::None;
+  placement.configure(config, makeCpus(4, 4));
+  EXPECT_EQ(placement.assign("d").cpus, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(CpuPlacementTest, UtilizationBaselinesAreIndependent) {
+  CpuPlacement::CpuTimes stats, metrics;
+  auto first = CpuPlacement::sampleUtilization(stats);
+  if (first.empty()) {
+    GTEST_SKIP() << "/proc/stat not available";
+  }
+  auto statsBaseline = stats;
+
+  // Another reader sampling in between leaves this baseline alone
+  CpuPlacement::sampleUtilization(metrics);
+  CpuPlacement::sampleUtilization(metrics);
+  EXPECT_EQ(stats, statsBaseline);
+  EXPECT_EQ(metrics.size(), stats.size());
+
+  for (const auto &[cpu, busy] : CpuPlacement::sampleUtilization(stats)) {
+    EXPECT_GE(busy, 0.0) << "cpu " << cpu;
+    EXPECT_LE(busy, 1.0) << "cpu " << cpu;
+  }
+}
@@ -0,0 +1,113 @@
+#include "utils/gstreamer_capabilities.h"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+namespace {
+
+const char *kGstInspectOutput =
+    "coreelements:  capsfilter: CapsFilter\n"
+    "coreelements:  filesrc: File Source\n"
+    "coretracers:  latency (GstTracerFactory)\n"
+    "isomp4:  qtdemux: QuickTime demuxer\n"
+    "libav:  avdec_h264: libav H.264 / AVC / MPEG-4 AVC / MPEG-4 part 10 "
+    "decoder\n"
+    "nvcodec:  nvh264dec: NVDEC h264 Video Decoder\n"
+    "openh264:  openh264enc: OpenH264 video encoder\n"
+    "typefindfunctions: video/x-h264: h264, x264, 264\n"
+    "\n"
+    "Total count: 6 plugins, 7 features\n";
+
+} // namespace
+
+TEST(GStreamerCapabilitiesTest, ParsesGstInspectListing) {
+  auto manifest = GStreamerCapabilities::parseGstInspect(kGstInspectOutput);
+  EXPECT_EQ(manifest.source, "gst-inspect");
+  EXPECT_EQ(manifest.elements.size(), 6u);
+  EXPECT_EQ(manifest.plugins.count("isomp4"), 1u);
+  EXPECT_EQ(manifest.plugins.count("typefindfunctions"), 0u);
+  EXPECT_EQ(manifest.elements.count("latency"), 0u);
+
+  const auto &avdec = manifest.elements.at("avdec_h264");
+  EXPECT_EQ(avdec.plugin, "libav");
+  EXPECT_TRUE(avdec.decoder);
+  EXPECT_FALSE(avdec.hardware);
+  const auto &nvdec = manifest.elements.at("nvh264dec");
+  EXPECT_TRUE(nvdec.decoder);
+  EXPECT_TRUE(nvdec.hardware);
+  const auto &openh264 = manifest.elements.at("openh264enc");
+  EXPECT_TRUE(openh264.encoder);
+  EXPECT_FALSE(openh264.decoder);
+  EXPECT_FALSE(manifest.elements.at("qtdemux").decoder);
+}
+
+TEST(GStreamerCapabilitiesTest, ClassifiesFromRegistryClass) {
+  GStreamerCapabilities::Element element;
+  element.name = "decodebin";
+  element.klass = "Generic/Bin/Decoder";
+  GStreamerCapabilities::classify(element);
+  EXPECT_FALSE(element.decoder); // Not a codec
+
+  element.name = "v4l2h264dec";
+  element.klass = "Codec/Decoder/Video/Hardware";
+  GStreamerCapabilities::classify(element);
+  EXPECT_TRUE(element.decoder);
+  EXPECT_TRUE(element.hardware);
+
+  element.name = "vaapih264enc";
+  element.klass = "Codec/Encoder/Video";
+  GStreamerCapabilities::classify(element);
+  EXPECT_TRUE(element.encoder);
+  EXPECT_TRUE(element.hardware); // By name
+}
+
+TEST(GStreamerCapabilitiesTest, CachedManifestIsKeyedByRegistryState) {
+  char path[] = "/tmp/gst_manifest_test_XXXXXX";
+  int fd = mkstemp(path);
+  ASSERT_GE(fd, 0);
+  close(fd);
+
+  auto manifest = GStreamerCapabilities::parseGstInspect(kGstInspectOutput);
+  manifest.gstreamer_version = "GStreamer 1.22.0";
+  manifest.key.registry_path = "/tmp/registry.x86_64.bin";
+  manifest.key.registry_mtime = 1700000000000000000LL;
+  manifest.key.environment = "GST_PLUGIN_PATH=/opt/plugins;";
+  manifest.elements["avdec_h264"].rank = 256;
+  ASSERT_TRUE(GStreamerCapabilities::saveManifest(path, manifest));
+
+  auto loaded = GStreamerCapabilities::loadManifest(path, manifest.key);
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(loaded->gstreamer_version, "GStreamer 1.22.0");
+  EXPECT_EQ(loaded->plugins, manifest.plugins);
+  ASSERT_EQ(loaded->elements.size(), manifest.elements.size());
+  EXPECT_EQ(loaded->elements.at("avdec_h264").rank, 256u);
+  EXPECT_TRUE(loaded->elements.at("nvh264dec").hardware);
+
+  // Registry rewritten (plugin installed/removed) or plugin path changed
+  auto newer = manifest.key;
+  newer.registry_mtime += 1;
+  EXPECT_FALSE(GStreamerCapabilities::loadManifest(path, newer).has_value());
+  auto other_env = manifest.key;
+  other_env.environment.clear();
+  EXPECT_FALSE(
+      GStreamerCapabilities::loadManifest(path, other_env).has_value());
+
+  // Manifest written by another format version
+  auto json = GStreamerCapabilities::toJson(manifest);
+  json["version"] = GStreamerCapabilities::MANIFEST_VERSION + 1;
+  {
+    std::ofstream file(path, std::ios::trunc);
+    file << json.toStyledString();
+  }
+  EXPECT_FALSE(
+      GStreamerCapabilities::loadManifest(path, manifest.key).has_value());
+
+  {
+    std::ofstream file(path, std::ios::trunc);
+    file << "{ not json";
+  }
+  EXPECT_FALSE(
+      GStreamerCapabilities::loadManifest(path, manifest.key).has_value());
+  std::remove(path);
+}
@@ -0,0 +1,81 @@
+#include "utils/image_header.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+// SOI, APP0 (JFIF), DQT stub, SOF0 with the given size
+std::vector<unsigned char> jpegHeader(int width, int height,
+                                      unsigned char sof = 0xC0) {
+  std::vector<unsigned char> data = {0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10,
+                                     'J',  'F',  'I',  'F',  0x00, 0x01,
+                                     0x01, 0x00, 0x00, 0x01, 0x00, 0x01,
+                                     0x00, 0x00};
+  // DHT segment before the frame header must be skipped, not parsed
+  data.insert(data.end(), {0xFF, 0xC4, 0x00, 0x04, 0x00, 0x00});
+  data.insert(data.end(),
+              {0xFF, sof, 0x00, 0x11, 0x08,
+               static_cast<unsigned char>(height >> 8),
+               static_cast<unsigned char>(height & 0xFF),
+               static_cast<unsigned char>(width >> 8),
+               static_cast<unsigned char>(width & 0xFF), 0x03});
+  return data;
+}
+
+std::vector<unsigned char> pngHeader(uint32_t width, uint32_t height) {
+  std::vector<unsigned char> data = {0x89, 'P', 'N', 'G', 0x0D, 0x0A,
+                                     0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D,
+                                     'I',  'H', 'D', 'R'};
+  for (uint32_t value : {width, height}) {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+      data.push_back(static_cast<unsigned char>(value >> shift));
+    }
+  }
+  return data;
+}
+
+} // namespace
+
+TEST(ImageHeaderTest, ReadsJpegFrameHeader) {
+  auto info = ImageHeader::probe(jpegHeader(4032, 3024));
+  EXPECT_EQ(info.format, ImageHeader::Format::Jpeg);
+  EXPECT_EQ(info.width, 4032);
+  EXPECT_EQ(info.height, 3024);
+
+  // Progressive frame
+  info = ImageHeader::probe(jpegHeader(1920, 1080, 0xC2));
+  EXPECT_EQ(info.width, 1920);
+  EXPECT_EQ(info.height, 1080);
+}
+
+TEST(ImageHeaderTest, ReadsPngHeader) {
+  auto info = ImageHeader::probe(pngHeader(640, 480));
+  EXPECT_EQ(info.format, ImageHeader::Format::Png);
+  EXPECT_EQ(info.width, 640);
+  EXPECT_EQ(info.height, 480);
+}
+
+TEST(ImageHeaderTest, RejectsTruncatedAndUnknownData) {
+  auto jpeg = jpegHeader(4032, 3024);
+  // Any cut before the end of the width field (component count may be cut)
+  for (size_t cut = 0; cut + 1 < jpeg.size(); ++cut) {
+    std::vector<unsigned char> truncated(jpeg.begin(), jpeg.begin() + cut);
+    EXPECT_FALSE(ImageHeader::probe(truncated).valid()) << "cut " << cut;
+  }
+  auto png = pngHeader(640, 480);
+  png.resize(20);
+  EXPECT_FALSE(ImageHeader::probe(png).valid());
+  EXPECT_FALSE(ImageHeader::probe(pngHeader(0, 480)).valid());
+
+  std::vector<unsigned char> bmp = {'B', 'M', 0, 0, 0, 0, 0, 0};
+  EXPECT_EQ(ImageHeader::probe(bmp).format, ImageHeader::Format::Unknown);
+}
+
+TEST(ImageHeaderTest, PicksLargestScaleKeepingLongSide) {
+  EXPECT_EQ(ImageHeader::reducedScale(4032, 3024, 960), 4); // 1008x756
+  EXPECT_EQ(ImageHeader::reducedScale(3024, 4032, 960), 4); // Portrait
+  EXPECT_EQ(ImageHeader::reducedScale(1920, 1080, 960), 2);
+  EXPECT_EQ(ImageHeader::reducedScale(8000, 6000, 960), 8);
+  EXPECT_EQ(ImageHeader::reducedScale(1280, 720, 960), 1);
+  EXPECT_EQ(ImageHeader::reducedScale(4032, 3024, 0), 1); // Disabled
+}
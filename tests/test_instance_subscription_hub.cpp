@@ -0,0 +1,167 @@
+#include "api/instance_subscription_hub.h"
+#include <gtest/gtest.h>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct FakeConnection {
+  std::vector<InstanceSubscriptionHub::Payload> received;
+  std::vector<std::function<void()>> pending; // Unfinished sends
+  bool open = true;
+  bool closed = false;
+
+  InstanceSubscriptionHub::Subscriber subscriber(bool completeImmediately) {
+    InstanceSubscriptionHub::Subscriber sub;
+    sub.send = [this, completeImmediately](
+                   InstanceSubscriptionHub::Payload payload,
+                   std::function<void()> done) {
+      received.push_back(payload);
+      if (completeImmediately) {
+        done();
+      } else {
+        pending.push_back(std::move(done));
+      }
+    };
+    sub.connected = [this]() { return open; };
+    sub.close = [this]() { closed = true; };
+    return sub;
+  }
+};
+
+} // namespace
+
+class InstanceSubscriptionHubTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    hub().configure(InstanceSubscriptionHub::Config());
+    hub().setUpdateBuilder([this](const std::string &instanceId) {
+      builds_[instanceId]++;
+      return std::optional<std::string>("{\"instanceId\":\"" + instanceId +
+                                        "\"}");
+    });
+  }
+
+  void TearDown() override {
+    for (auto *conn : registered_) {
+      hub().removeConnection(conn);
+    }
+  }
+
+  static InstanceSubscriptionHub &hub() {
+    return InstanceSubscriptionHub::getInstance();
+  }
+
+  void subscribe(FakeConnection &conn, const std::string &instanceId,
+                 bool completeImmediately = true) {
+    registered_.push_back(&conn);
+    hub().subscribe(&conn, instanceId, conn.subscriber(completeImmediately));
+  }
+
+  std::map<std::string, int> builds_;
+  std::vector<FakeConnection *> registered_;
+};
+
+TEST_F(InstanceSubscriptionHubTest, BuildsOncePerInstanceAndSharesBuffer) {
+  std::vector<FakeConnection> conns(50);
+  for (auto &conn : conns) {
+    subscribe(conn, "cam-1");
+  }
+  FakeConnection other;
+  subscribe(other, "cam-2");
+  subscribe(other, "cam-2"); // Idempotent
+
+  EXPECT_EQ(hub().tick(), 51u);
+  EXPECT_EQ(builds_["cam-1"], 1);
+  EXPECT_EQ(builds_["cam-2"], 1);
+  for (auto &conn : conns) {
+    ASSERT_EQ(conn.received.size(), 1u);
+    EXPECT_EQ(conn.received[0].get(), conns[0].received[0].get());
+  }
+
+  auto stats = hub().getStats();
+  EXPECT_EQ(stats.connections, 51u);
+  EXPECT_EQ(stats.subscriptions, 51u);
+  EXPECT_EQ(stats.instances, 2u);
+}
+
+TEST_F(InstanceSubscriptionHubTest, UnsubscribeAndRemoveConnection) {
+  FakeConnection a, b;
+  subscribe(a, "cam-1");
+  subscribe(a, "cam-2");
+  subscribe(b, "cam-1");
+
+  hub().unsubscribe(&a, "cam-1");
+  EXPECT_EQ(hub().getStats().subscriptions, 2u);
+  hub().removeConnection(&b);
+  EXPECT_EQ(hub().getStats().subscriptions, 1u);
+  EXPECT_EQ(hub().getStats().instances, 1u);
+
+  hub().tick();
+  EXPECT_EQ(a.received.size(), 1u);
+  EXPECT_TRUE(b.received.empty());
+  EXPECT_EQ(builds_.count("cam-1"), 0u);
+}
+
+TEST_F(InstanceSubscriptionHubTest, SlowConnectionIsSkippedThenClosed) {
+  InstanceSubscriptionHub::Config config;
+  config.max_pending_per_connection = 2;
+  config.max_consecutive_skips = 3;
+  hub().configure(config);
+
+  FakeConnection slow, fast;
+  subscribe(slow, "cam-1", false);
+  subscribe(fast, "cam-1");
+
+  for (int i = 0; i < 4; ++i) {
+    hub().tick();
+  }
+  EXPECT_EQ(slow.received.size(), 2u); // Limited by pending sends
+  EXPECT_EQ(fast.received.size(), 4u);
+  EXPECT_FALSE(slow.closed);
+
+  // Draining the queue lets updates through again
+  for (auto &done : slow.pending) {
+    done();
+  }
+  slow.pending.clear();
+  hub().tick();
+  EXPECT_EQ(slow.received.size(), 3u);
+
+  for (int i = 0; i < 5; ++i) {
+    hub().tick();
+  }
+  EXPECT_TRUE(slow.closed);
+  EXPECT_EQ(fast.received.size(), 10u);
+  EXPECT_EQ(hub().getStats().connections_closed, 1u);
+}
+
+TEST_F(InstanceSubscriptionHubTest, TicksOnItsOwnThread) {
+  auto config = InstanceSubscriptionHub::Config();
+  config.interval = std::chrono::milliseconds(10);
+  hub().configure(config);
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::thread::id builtOn;
+  hub().setUpdateBuilder([&](const std::string &) {
+    std::lock_guard<std::mutex> lock(mutex);
+    builtOn = std::this_thread::get_id();
+    cv.notify_all();
+    return std::optional<std::string>("{}");
+  });
+  FakeConnection conn;
+  subscribe(conn, "cam-1");
+
+  hub().start();
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(2),
+                            [&] { return builtOn != std::thread::id(); }));
+  }
+  hub().shutdown();
+  EXPECT_NE(builtOn, std::this_thread::get_id());
+}
@@ -0,0 +1,129 @@
+#include "core/model_catalog.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <gtest/gtest.h>
+#include <thread>
+#include <unistd.h>
+
+class ModelCatalogTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    test_dir_ = "/tmp/edge_ai_api_test_models_" + std::to_string(getpid());
+    std::filesystem::create_directories(test_dir_ + "/face");
+    writeFile(test_dir_ + "/face/yunet_2023mar.onnx", "yunet");
+    writeFile(test_dir_ + "/face/readme.md", "not a model");
+
+    auto &catalog = ModelCatalog::getInstance();
+    catalog.addRoot(test_dir_);
+    catalog.start();
+  }
+
+  void TearDown() override {
+    ModelCatalog::getInstance().stop();
+    if (std::filesystem::exists(test_dir_)) {
+      std::filesystem::remove_all(test_dir_);
+    }
+  }
+
+  static void writeFile(const std::string &path, const std::string &content) {
+    std::ofstream file(path, std::ios::binary);
+    file << content;
+  }
+
+  // Wait for the inotify watcher to pick up a change
+  static bool waitFor(const std::function<bool()> &predicate) {
+    for (int i = 0; i < 100; ++i) {
+      if (predicate()) {
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    return false;
+  }
+
+  std::string test_dir_;
+};
+
+TEST_F(ModelCatalogTest, IndexesModelFilesUnderRoot) {
+  auto &catalog = ModelCatalog::getInstance();
+  EXPECT_EQ(catalog.lookupFile(test_dir_ + "/face/yunet_2023mar.onnx"),
+            ModelCatalog::Lookup::Found);
+  EXPECT_EQ(catalog.lookupFile(test_dir_ + "/face/missing.onnx"),
+            ModelCatalog::Lookup::Missing);
+  EXPECT_EQ(catalog.lookupFile(test_dir_ + "/object/missing.onnx"),
+            ModelCatalog::Lookup::Missing);
+  EXPECT_EQ(catalog.lookupDirectory(test_dir_ + "/face"),
+            ModelCatalog::Lookup::Found);
+
+  // Non-model files and paths outside the roots are left to the filesystem
+  EXPECT_EQ(catalog.lookupFile(test_dir_ + "/face/readme.md"),
+            ModelCatalog::Lookup::Unknown);
+  EXPECT_EQ(catalog.lookupFile("/nonexistent_root/model.onnx"),
+            ModelCatalog::Lookup::Unknown);
+}
+
+TEST_F(ModelCatalogTest, IndexesByNameAndCategory) {
+  auto &catalog = ModelCatalog::getInstance();
+  auto byName = catalog.findByName("YUNET_2023MAR");
+  ASSERT_EQ(byName.size(), 1u);
+  EXPECT_EQ(byName[0].category, "face");
+  EXPECT_EQ(byName[0].size, 5u);
+
+  auto byCategory = catalog.findByCategory("face");
+  EXPECT_EQ(byCategory.size(), 1u);
+
+  std::vector<ModelCatalog::ModelEntry> entries;
+  ASSERT_TRUE(catalog.listDirectory(test_dir_, true, entries));
+  EXPECT_EQ(entries.size(), 1u);
+}
+
+TEST_F(ModelCatalogTest, ComputesChecksumOnDemand) {
+  auto &catalog = ModelCatalog::getInstance();
+  std::string path = test_dir_ + "/face/yunet_2023mar.onnx";
+  std::string checksum = catalog.getChecksum(path);
+  EXPECT_EQ(checksum, ModelCatalog::computeChecksum("yunet", 5));
+  EXPECT_EQ(catalog.findByChecksum(checksum).size(), 1u);
+}
+
+TEST_F(ModelCatalogTest, NotifyUpdatesIndexIncrementally) {
+  auto &catalog = ModelCatalog::getInstance();
+  std::string path = test_dir_ + "/face/uploaded.onnx";
+  writeFile(path, "uploaded");
+  catalog.notifyFileChanged(path, ModelCatalog::computeChecksum("uploaded", 8));
+
+  ModelCatalog::ModelEntry entry;
+  ASSERT_TRUE(catalog.getEntry(path, entry));
+  EXPECT_EQ(entry.size, 8u);
+  EXPECT_FALSE(entry.checksum.empty());
+
+  std::filesystem::remove(path);
+  catalog.notifyFileRemoved(path);
+  EXPECT_EQ(catalog.lookupFile(path), ModelCatalog::Lookup::Missing);
+}
+
+TEST_F(ModelCatalogTest, WatcherPicksUpNewFiles) {
+  auto &catalog = ModelCatalog::getInstance();
+  std::filesystem::create_directories(test_dir_ + "/object");
+  writeFile(test_dir_ + "/object/yolov8n.onnx", "yolo");
+
+  EXPECT_TRUE(waitFor([&]() {
+    return catalog.lookupFile(test_dir_ + "/object/yolov8n.onnx") ==
+           ModelCatalog::Lookup::Found;
+  }));
+}
+
+TEST_F(ModelCatalogTest, ResolutionCacheInvalidatedOnChange) {
+  auto &catalog = ModelCatalog::getInstance();
+  uint64_t generation = catalog.getGeneration();
+  catalog.cacheResolution("key", "value", generation);
+
+  std::string value;
+  ASSERT_TRUE(catalog.getCachedResolution("key", value));
+  EXPECT_EQ(value, "value");
+
+  writeFile(test_dir_ + "/face/new_model.onnx", "new");
+  catalog.notifyFileChanged(test_dir_ + "/face/new_model.onnx");
+  EXPECT_FALSE(catalog.getCachedResolution("key", value));
+}
@@ -0,0 +1,167 @@
+#include "core/motion_gate.h"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using Decision = MotionGate::Decision;
+using ms = std::chrono::milliseconds;
+
+constexpr int kWidth = 64;
+constexpr int kHeight = 48;
+
+std::vector<uint8_t> flatFrame(uint8_t level) {
+  return std::vector<uint8_t>(kWidth * kHeight, level);
+}
+
+// Flat frame with a bright square at (x, y)
+std::vector<uint8_t> frameWithBox(int x, int y, int size) {
+  auto frame = flatFrame(40);
+  for (int row = y; row < y + size && row < kHeight; ++row) {
+    for (int col = x; col < x + size && col < kWidth; ++col) {
+      frame[row * kWidth + col] = 220;
+    }
+  }
+  return frame;
+}
+
+} // namespace
+
+TEST(MotionGateTest, StaticSceneOnlyForwardsKeepAlives) {
+  MotionGate::Options options;
+  options.keepalive_ms = 1000;
+  options.hold_ms = 0;
+  MotionGate gate(options);
+  auto frame = flatFrame(40);
+  auto t0 = MotionGate::Clock::time_point() + std::chrono::hours(1);
+
+  EXPECT_EQ(gate.update(frame.data(), kWidth, kHeight, kWidth, t0),
+            Decision::Initial);
+  // 10 fps for 10 seconds
+  for (int i = 1; i <= 100; ++i) {
+    gate.update(frame.data(), kWidth, kHeight, kWidth, t0 + ms(100 * i));
+  }
+  EXPECT_EQ(gate.frames(), 101u);
+  EXPECT_EQ(gate.forwarded(), 11u); // Initial + one keep-alive per second
+  EXPECT_DOUBLE_EQ(gate.lastChangedFraction(), 0.0);
+}
+
+TEST(MotionGateTest, MovingObjectIsForwardedThenHeld) {
+  MotionGate::Options options;
+  options.keepalive_ms = 10000;
+  options.hold_ms = 500;
+  MotionGate gate(options);
+  auto t0 = MotionGate::Clock::time_point() + std::chrono::hours(1);
+  auto background = flatFrame(40);
+  gate.update(background.data(), kWidth, kHeight, kWidth, t0);
+
+  auto moved = frameWithBox(10, 10, 12);
+  EXPECT_EQ(gate.update(moved.data(), kWidth, kHeight, kWidth, t0 + ms(100)),
+            Decision::Motion);
+  EXPECT_GT(gate.lastChangedFraction(), options.min_area);
+
+  // Object left; the background only moved slightly towards it, so the
+  // empty scene is static again: held for hold_ms, then skipped
+  EXPECT_EQ(
+      gate.update(background.data(), kWidth, kHeight, kWidth, t0 + ms(200)),
+      Decision::Hold);
+  EXPECT_EQ(
+      gate.update(background.data(), kWidth, kHeight, kWidth, t0 + ms(550)),
+      Decision::Hold);
+  EXPECT_EQ(
+      gate.update(background.data(), kWidth, kHeight, kWidth, t0 + ms(700)),
+      Decision::Skip);
+  EXPECT_EQ(gate.forwarded(), 4u);
+}
+
+TEST(MotionGateTest, SmallChangesBelowMinAreaAreIgnored) {
+  MotionGate::Options options;
+  options.min_area = 0.05;
+  options.keepalive_ms = 10000;
+  options.hold_ms = 0;
+  MotionGate gate(options);
+  auto t0 = MotionGate::Clock::time_point() + std::chrono::hours(1);
+  auto background = flatFrame(40);
+  gate.update(background.data(), kWidth, kHeight, kWidth, t0);
+
+  // 4x4 box = 0.5% of the frame
+  auto small = frameWithBox(5, 5, 4);
+  EXPECT_EQ(gate.update(small.data(), kWidth, kHeight, kWidth, t0 + ms(100)),
+            Decision::Skip);
+
+  // Sensor noise below pixel_threshold never counts
+  auto noisy = flatFrame(40 + options.pixel_threshold - 1);
+  EXPECT_EQ(gate.update(noisy.data(), kWidth, kHeight, kWidth, t0 + ms(200)),
+            Decision::Skip);
+}
+
+TEST(MotionGateTest, GlobalChangeResetsBackground) {
+  MotionGate::Options options;
+  options.keepalive_ms = 10000;
+  options.hold_ms = 0;
+  MotionGate gate(options);
+  auto t0 = MotionGate::Clock::time_point() + std::chrono::hours(1);
+  auto dark = flatFrame(20);
+  auto lit = flatFrame(200);
+  gate.update(dark.data(), kWidth, kHeight, kWidth, t0);
+
+  EXPECT_EQ(gate.update(lit.data(), kWidth, kHeight, kWidth, t0 + ms(100)),
+            Decision::SceneChange);
+  // The new scene is the background immediately
+  EXPECT_EQ(gate.update(lit.data(), kWidth, kHeight, kWidth, t0 + ms(200)),
+            Decision::Skip);
+}
+
+TEST(MotionGateTest, HonoursStrideAndResolutionChanges) {
+  MotionGate gate;
+  auto t0 = MotionGate::Clock::time_point() + std::chrono::hours(1);
+  // Padded rows: padding bytes change but must not be read
+  std::vector<uint8_t> padded(kHeight * (kWidth + 16), 40);
+  EXPECT_EQ(gate.update(padded.data(), kWidth, kHeight, kWidth + 16, t0),
+            Decision::Initial);
+  for (int row = 0; row < kHeight; ++row) {
+    for (int col = kWidth; col < kWidth + 16; ++col) {
+      padded[row * (kWidth + 16) + col] = 255;
+    }
+  }
+  EXPECT_EQ(gate.update(padded.data(), kWidth, kHeight, kWidth + 16,
+                        t0 + ms(2000)),
+            Decision::KeepAlive);
+  EXPECT_DOUBLE_EQ(gate.lastChangedFraction(), 0.0);
+
+  auto smaller = std::vector<uint8_t>(32 * 24, 40);
+  EXPECT_EQ(gate.update(smaller.data(), 32, 24, 32, t0 + ms(2100)),
+            Decision::Initial);
+  EXPECT_EQ(gate.analysisHeight(1920, 1080), 90);
+  EXPECT_EQ(gate.analysisHeight(100, 50), 50);
+}
+
+TEST(MotionGateTest, ParsesParametersAndSensitivityPresets) {
+  auto low = MotionGate::parseOptions({});
+  auto high = MotionGate::parseOptions({{"sensitivity", "High"}});
+  EXPECT_LT(high.pixel_threshold, low.pixel_threshold);
+  EXPECT_LT(high.min_area, low.min_area);
+
+  auto options = MotionGate::parseOptions({{"sensitivity", "${SENSITIVITY}"},
+                                           {"min_area", "0.02"},
+                                           {"keepalive_ms", "2500"},
+                                           {"hold_ms", ""}});
+  EXPECT_EQ(options.pixel_threshold, low.pixel_threshold);
+  EXPECT_DOUBLE_EQ(options.min_area, 0.02);
+  EXPECT_EQ(options.keepalive_ms, 2500);
+  EXPECT_EQ(options.hold_ms, low.hold_ms);
+
+  EXPECT_THROW(MotionGate::parseOptions({{"pixel_threshold", "0"}}),
+               std::invalid_argument);
+  EXPECT_THROW(MotionGate::parseOptions({{"min_area", "1.5"}}),
+               std::invalid_argument);
+  EXPECT_THROW(MotionGate::parseOptions({{"keepalive_ms", "1s"}}),
+               std::invalid_argument);
+  // Integer options are not truncated
+  EXPECT_THROW(MotionGate::parseOptions({{"pixel_threshold", "12.7"}}),
+               std::invalid_argument);
+  EXPECT_THROW(MotionGate::parseOptions({{"analysis_width", "320.5"}}),
+               std::invalid_argument);
+}
@@ -0,0 +1,206 @@
+#include "utils/mp4_faststart.h"
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace fs = std::filesystem;
+using MP4Finalizer::MP4Faststart;
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+void put32(Bytes &out, uint32_t value) {
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    out.push_back(static_cast<uint8_t>(value >> shift));
+  }
+}
+
+void put64(Bytes &out, uint64_t value) {
+  put32(out, static_cast<uint32_t>(value >> 32));
+  put32(out, static_cast<uint32_t>(value));
+}
+
+uint32_t get32(const Bytes &in, size_t at) {
+  return (uint32_t(in[at]) << 24) | (uint32_t(in[at + 1]) << 16) |
+         (uint32_t(in[at + 2]) << 8) | uint32_t(in[at + 3]);
+}
+
+Bytes box(const std::string &type, const Bytes &payload) {
+  Bytes out;
+  put32(out, static_cast<uint32_t>(8 + payload.size()));
+  out.insert(out.end(), type.begin(), type.end());
+  out.insert(out.end(), payload.begin(), payload.end());
+  return out;
+}
+
+Bytes concat(std::initializer_list<Bytes> parts) {
+  Bytes out;
+  for (const auto &part : parts) {
+    out.insert(out.end(), part.begin(), part.end());
+  }
+  return out;
+}
+
+// avc1 sample entry with an avcC of the given profile
+Bytes stsd(uint8_t profile) {
+  Bytes avc1(78, 0);
+  Bytes avcC = {1, profile, 0, 31, 0xff, 0xe0, 0x00};
+  Bytes entry = box("avc1", concat({avc1, box("avcC", avcC)}));
+  Bytes payload;
+  put32(payload, 0); // version/flags
+  put32(payload, 1); // entry_count
+  return box("stsd", concat({payload, entry}));
+}
+
+Bytes chunkOffsets(const std::vector<uint64_t> &offsets, bool wide) {
+  Bytes payload;
+  put32(payload, 0);
+  put32(payload, static_cast<uint32_t>(offsets.size()));
+  for (uint64_t offset : offsets) {
+    if (wide) {
+      put64(payload, offset);
+    } else {
+      put32(payload, static_cast<uint32_t>(offset));
+    }
+  }
+  return box(wide ? "co64" : "stco", payload);
+}
+
+Bytes moov(const std::vector<uint64_t> &offsets, bool wide = false) {
+  Bytes stbl = box("stbl", concat({stsd(100), chunkOffsets(offsets, wide)}));
+  Bytes trak = box("trak", box("mdia", box("minf", stbl)));
+  return box("moov", concat({box("mvhd", Bytes(100, 0)), trak}));
+}
+
+// Chunk payloads are distinct so offsets can be checked by content
+const Bytes kChunkA = {'A', 'A', 'A', 'A'};
+const Bytes kChunkB = {'B', 'B', 'B', 'B', 'B'};
+
+class MP4FaststartTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    dir_ = fs::temp_directory_path() /
+           ("mp4_faststart_test_" + std::to_string(::getpid()));
+    fs::create_directories(dir_);
+  }
+  void TearDown() override { fs::remove_all(dir_); }
+
+  std::string write(const std::string &name, const Bytes &data) {
+    std::string path = (dir_ / name).string();
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char *>(data.data()), data.size());
+    return path;
+  }
+
+  Bytes read(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    return Bytes(std::istreambuf_iterator<char>(in), {});
+  }
+
+  // Recording layout: ftyp, mdat, moov at the end
+  Bytes recording(bool wide) {
+    Bytes ftyp = box("ftyp", {'i', 's', 'o', 'm', 0, 0, 2, 0});
+    Bytes mdat = box("mdat", concat({kChunkA, kChunkB}));
+    uint64_t chunkA = ftyp.size() + 8;
+    return concat({ftyp, mdat, moov({chunkA, chunkA + kChunkA.size()}, wide)});
+  }
+
+  // Offsets of the single chunk offset box in a faststart file
+  std::vector<uint64_t> offsetsIn(const Bytes &file, bool wide) {
+    const std::string type = wide ? "co64" : "stco";
+    for (size_t at = 0; at + 16 <= file.size(); ++at) {
+      if (std::string(file.begin() + at + 4, file.begin() + at + 8) == type) {
+        std::vector<uint64_t> offsets;
+        uint32_t count = get32(file, at + 12);
+        for (uint32_t i = 0; i < count; ++i) {
+          offsets.push_back(
+              wide ? (uint64_t(get32(file, at + 16 + i * 8)) << 32) |
+                         get32(file, at + 20 + i * 8)
+                   : get32(file, at + 16 + i * 4));
+        }
+        return offsets;
+      }
+    }
+    return {};
+  }
+
+  fs::path dir_;
+};
+
+} // namespace
+
+TEST_F(MP4FaststartTest, MovesMoovAheadOfMdatAndShiftsChunkOffsets) {
+  for (bool wide : {false, true}) {
+    Bytes original = recording(wide);
+    std::string path = write(wide ? "co64.mp4" : "stco.mp4", original);
+
+    auto probe = MP4Faststart::probe(path);
+    EXPECT_EQ(probe.status, MP4Faststart::Status::NotFaststart);
+    EXPECT_EQ(probe.video_codec, "avc1");
+    EXPECT_EQ(probe.h264_profile, 100);
+
+    auto result = MP4Faststart::rewriteFile(path);
+    ASSERT_EQ(result.status, MP4Faststart::Status::Rewritten) << result.error;
+    Bytes rewritten = read(path);
+    EXPECT_EQ(rewritten.size(), original.size());
+    EXPECT_EQ(result.bytes_written, original.size());
+    EXPECT_FALSE(fs::exists(path + ".faststart.tmp"));
+
+    // ftyp, moov, mdat
+    size_t moovAt = get32(rewritten, 0);
+    EXPECT_EQ(std::string(rewritten.begin() + moovAt + 4,
+                          rewritten.begin() + moovAt + 8),
+              "moov");
+    size_t mdatAt = moovAt + get32(rewritten, moovAt);
+    EXPECT_EQ(std::string(rewritten.begin() + mdatAt + 4,
+                          rewritten.begin() + mdatAt + 8),
+              "mdat");
+
+    // Offsets still point at the same chunk bytes
+    auto offsets = offsetsIn(rewritten, wide);
+    ASSERT_EQ(offsets.size(), 2u);
+    EXPECT_EQ(Bytes(rewritten.begin() + offsets[0],
+                    rewritten.begin() + offsets[0] + kChunkA.size()),
+              kChunkA);
+    EXPECT_EQ(Bytes(rewritten.begin() + offsets[1],
+                    rewritten.begin() + offsets[1] + kChunkB.size()),
+              kChunkB);
+
+    // A second pass has nothing to do
+    EXPECT_EQ(MP4Faststart::rewriteFile(path).status,
+              MP4Faststart::Status::AlreadyFaststart);
+    EXPECT_EQ(read(path), rewritten);
+  }
+}
+
+TEST_F(MP4FaststartTest, RejectsIncompleteAndLeavesFragmentedFiles) {
+  Bytes ftyp = box("ftyp", {'i', 's', 'o', 'm', 0, 0, 2, 0});
+
+  // Recording still open: mdat without moov
+  std::string open = write("open.mp4", concat({ftyp, box("mdat", kChunkA)}));
+  auto incomplete = MP4Faststart::rewriteFile(open);
+  EXPECT_EQ(incomplete.status, MP4Faststart::Status::Invalid);
+  EXPECT_FALSE(incomplete.error.empty());
+
+  // Truncated in the middle of a box
+  Bytes full = recording(false);
+  std::string truncated =
+      write("truncated.mp4", Bytes(full.begin(), full.end() - 10));
+  EXPECT_EQ(MP4Faststart::rewriteFile(truncated).status,
+            MP4Faststart::Status::Invalid);
+  EXPECT_EQ(read(truncated).size(), full.size() - 10);
+
+  // Fragmented MP4 needs no finalizing
+  std::string fragmented =
+      write("fragmented.mp4", concat({ftyp, moov({}), box("moof", Bytes(16, 0)),
+                                      box("mdat", kChunkA)}));
+  auto result = MP4Faststart::rewriteFile(fragmented);
+  EXPECT_EQ(result.status, MP4Faststart::Status::Fragmented);
+  EXPECT_TRUE(MP4Faststart::isOk(result.status));
+}
@@ -0,0 +1,214 @@
+#include "videos/offline_job_manager.h"
+#include "videos/video_segmenter.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+
+using State = OfflineJobManager::State;
+using namespace std::chrono_literals;
+namespace fs = std::filesystem;
+
+TEST(VideoSegmenterTest, ParsesKeyframePacketsOnly) {
+  auto times = VideoSegmenter::parseKeyframeTimes(
+      "0.000000,K__\n0.040000,___\nN/A,K__\n10.000000,K__\n"
+      "\n10.000000,K__\n5.000000,K_\n");
+  EXPECT_EQ(times, (std::vector<double>{0.0, 5.0, 10.0}));
+
+  // Plain "pts_time" lines (e.g. -skip_frame nokey output)
+  EXPECT_EQ(VideoSegmenter::parseKeyframeTimes("2.5\n1.0\n"),
+            (std::vector<double>{1.0, 2.5}));
+}
+
+TEST(VideoSegmenterTest, PlansKeyframeAlignedSegments) {
+  std::vector<double> keyframes;
+  for (int t = 0; t <= 120; t += 7) {
+    keyframes.push_back(t);
+  }
+  auto segments = VideoSegmenter::planSegments(keyframes, 120.0, 4, 10.0);
+  ASSERT_EQ(segments.size(), 4u);
+  EXPECT_DOUBLE_EQ(segments[0].start_sec, 0.0);
+  EXPECT_DOUBLE_EQ(segments[1].start_sec, 28.0); // nearest to 30
+  EXPECT_DOUBLE_EQ(segments[2].start_sec, 63.0); // nearest to 60
+  EXPECT_DOUBLE_EQ(segments[3].start_sec, 91.0); // nearest to 90
+  EXPECT_DOUBLE_EQ(segments[3].end_sec, 120.0);
+  for (size_t i = 1; i < segments.size(); ++i) {
+    EXPECT_DOUBLE_EQ(segments[i - 1].end_sec, segments[i].start_sec);
+  }
+
+  // Too short for the minimum length: fewer segments, never empty
+  auto coarse = VideoSegmenter::planSegments(keyframes, 120.0, 100, 30.0);
+  ASSERT_GT(coarse.size(), 1u);
+  EXPECT_LE(coarse.size(), 4u);
+  for (const auto &segment : coarse) {
+    EXPECT_GE(segment.end_sec - segment.start_sec, 30.0);
+  }
+  EXPECT_EQ(VideoSegmenter::planSegments({}, 120.0, 8, 10.0).size(), 1u);
+  EXPECT_EQ(VideoSegmenter::planSegments({0.0}, 120.0, 8, 10.0).size(), 1u);
+}
+
+TEST(VideoSegmenterTest, MergesStreamsInTimeOrder) {
+  std::istringstream a(VideoSegmenter::formatEventLine(1.0, "{\"a\":1}") +
+                       "\n" +
+                       VideoSegmenter::formatEventLine(5.0, "{\"a\":2}") +
+                       "\n");
+  std::istringstream b("garbage\n" +
+                       VideoSegmenter::formatEventLine(1.0, "{\"b\":1}") +
+                       "\n" +
+                       VideoSegmenter::formatEventLine(3.0, "{\"b\":2}") +
+                       "\n");
+  std::ostringstream out;
+  EXPECT_EQ(VideoSegmenter::mergeEventStreams({&a, nullptr, &b}, out), 4u);
+  EXPECT_EQ(out.str(), "{\"a\":1}\n{\"b\":1}\n{\"b\":2}\n{\"a\":2}\n");
+}
+
+class OfflineJobManagerTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    dir_ = fs::temp_directory_path() /
+           ("offline_jobs_test_" + std::to_string(::getpid()));
+    fs::create_directories(dir_);
+    video_ = (dir_ / "clip.mp4").string();
+    std::ofstream(video_) << "not really a video";
+
+    OfflineJobManager::Config config;
+    config.max_workers = 4;
+    config.segments_per_worker = 2;
+    config.min_segment_seconds = 5.0;
+    config.jobs_dir = (dir_ / "jobs").string();
+    manager().configure(config);
+    // 80 s @ 25 fps, keyframe every 2 s
+    manager().setProber([](const std::string &,
+                           OfflineJobManager::VideoInfo &info,
+                           std::string &) {
+      info.duration_sec = 80.0;
+      info.fps = 25.0;
+      for (int t = 0; t < 80; t += 2) {
+        info.keyframes.push_back(t);
+      }
+      return true;
+    });
+  }
+
+  void TearDown() override {
+    manager().shutdown();
+    fs::remove_all(dir_);
+  }
+
+  static OfflineJobManager &manager() {
+    return OfflineJobManager::getInstance();
+  }
+
+  OfflineJobManager::JobRequest request() const {
+    OfflineJobManager::JobRequest request;
+    request.video_path = video_;
+    request.video_name = "clip.mp4";
+    request.solution_id = "ba_crossline";
+    return request;
+  }
+
+  fs::path dir_;
+  std::string video_;
+};
+
+TEST_F(OfflineJobManagerTest, ProcessesSegmentsInParallelAndMergesEvents) {
+  std::atomic<int> active{0};
+  std::atomic<int> peak{0};
+  manager().setSegmentProcessor(
+      [&](const OfflineJobManager::SegmentTask &task,
+          OfflineJobManager::SegmentProgress &progress, std::string &) {
+        int now = ++active;
+        int seen = peak;
+        while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+        }
+        std::this_thread::sleep_for(20ms);
+        std::ofstream out(task.output_path);
+        // One event per second of the segment, in time order
+        uint64_t frames = 0;
+        for (double t = task.segment.start_sec; t < task.segment.end_sec;
+             t += 1.0) {
+          out << VideoSegmenter::formatEventLine(
+                     t, "{\"t\":" + std::to_string(static_cast<int>(t)) + "}")
+              << "\n";
+          frames += 25;
+          progress.setFrames(frames);
+        }
+        --active;
+        return true;
+      });
+
+  std::string error;
+  std::string id = manager().submit(request(), error);
+  ASSERT_FALSE(id.empty()) << error;
+  EXPECT_EQ(manager().wait(id, 10000ms), State::Succeeded);
+  EXPECT_GT(peak.load(), 1);
+
+  Json::Value job = *manager().getJobJson(id);
+  EXPECT_EQ(job["state"].asString(), "succeeded");
+  EXPECT_EQ(job["segmentCount"].asUInt(), 8u);
+  EXPECT_EQ(job["framesProcessed"].asUInt64(), 2000u);
+  EXPECT_EQ(job["totalFrames"].asUInt64(), 2000u);
+  EXPECT_DOUBLE_EQ(job["progress"].asDouble(), 1.0);
+  EXPECT_EQ(job["events"].asUInt64(), 80u);
+  EXPECT_GT(job["speedFactor"].asDouble(), 0.0);
+
+  Json::Value page = *manager().getEventsJson(id, 10, 5);
+  ASSERT_EQ(page["count"].asUInt(), 5u);
+  EXPECT_EQ(page["total"].asUInt64(), 80u);
+  for (Json::ArrayIndex i = 0; i < 5; ++i) {
+    EXPECT_EQ(page["events"][i]["t"].asInt(), static_cast<int>(10 + i));
+  }
+
+  // Deleting a finished job removes it and its files
+  EXPECT_TRUE(manager().cancelOrDelete(id));
+  EXPECT_FALSE(manager().getJobJson(id).has_value());
+  EXPECT_FALSE(fs::exists(dir_ / "jobs" / id));
+}
+
+TEST_F(OfflineJobManagerTest, FailsOnSegmentErrorAndCancels) {
+  manager().setSegmentProcessor(
+      [](const OfflineJobManager::SegmentTask &task,
+         OfflineJobManager::SegmentProgress &, std::string &error) {
+        if (task.segment.index == 2) {
+          error = "decode error";
+          return false;
+        }
+        return true;
+      });
+  std::string error;
+  std::string id = manager().submit(request(), error);
+  ASSERT_FALSE(id.empty()) << error;
+  EXPECT_EQ(manager().wait(id, 10000ms), State::Failed);
+  EXPECT_NE((*manager().getJobJson(id))["error"].asString().find(
+                "decode error"),
+            std::string::npos);
+
+  // Running job: processor sees the cancellation
+  std::atomic<bool> started{false};
+  manager().setSegmentProcessor(
+      [&](const OfflineJobManager::SegmentTask &,
+          OfflineJobManager::SegmentProgress &progress, std::string &) {
+        started = true;
+        while (!progress.cancelled()) {
+          std::this_thread::sleep_for(1ms);
+        }
+        return false;
+      });
+  id = manager().submit(request(), error);
+  ASSERT_FALSE(id.empty()) << error;
+  while (!started) {
+    std::this_thread::sleep_for(1ms);
+  }
+  EXPECT_TRUE(manager().cancelOrDelete(id));
+  EXPECT_EQ(manager().wait(id, 10000ms), State::Cancelled);
+
+  // Unknown video and unknown job
+  auto missing = request();
+  missing.video_path = (dir_ / "missing.mp4").string();
+  EXPECT_TRUE(manager().submit(missing, error).empty());
+  EXPECT_FALSE(manager().cancelOrDelete("no-such-job"));
+}
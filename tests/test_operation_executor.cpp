@@ -0,0 +1,279 @@
+#include "core/operation_executor.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using State = OperationExecutor::State;
+using namespace std::chrono_literals;
+
+class OperationExecutorTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    OperationExecutor::Config config;
+    config.worker_threads = 4;
+    config.max_pending = 64;
+    executor().configure(config);
+  }
+
+  void TearDown() override { executor().shutdown(); }
+
+  static OperationExecutor &executor() {
+    return OperationExecutor::getInstance();
+  }
+};
+
+TEST_F(OperationExecutorTest, ReportsStateProgressAndErrors) {
+  std::atomic<bool> release{false};
+  std::string id = executor().submit(
+      "restart", "inst-1",
+      [&](OperationExecutor::Progress &progress, std::string &) {
+        progress.report(0.5, "stopping");
+        while (!release) {
+          std::this_thread::sleep_for(1ms);
+        }
+        return true;
+      });
+  ASSERT_FALSE(id.empty());
+
+  // Wait until the task published its progress
+  Json::Value json;
+  for (int i = 0; i < 500; ++i) {
+    json = *executor().getOperationJson(id);
+    if (json["step"].asString() == "stopping") {
+      break;
+    }
+    std::this_thread::sleep_for(2ms);
+  }
+  EXPECT_EQ(json["state"].asString(), "running");
+  EXPECT_EQ(json["instanceId"].asString(), "inst-1");
+  EXPECT_DOUBLE_EQ(json["progress"].asDouble(), 0.5);
+
+  release = true;
+  EXPECT_EQ(executor().wait(id, 5000ms), State::Succeeded);
+  json = *executor().getOperationJson(id);
+  EXPECT_DOUBLE_EQ(json["progress"].asDouble(), 1.0);
+  EXPECT_TRUE(json.isMember("finishedAt"));
+
+  std::string failed = executor().submit(
+      "stop", "inst-2", [](OperationExecutor::Progress &, std::string &error) {
+        error = "pipeline not found";
+        return false;
+      });
+  std::string thrown = executor().submit(
+      "stop", "inst-3", [](OperationExecutor::Progress &, std::string &) {
+        throw std::runtime_error("boom");
+        return true;
+      });
+  EXPECT_EQ(executor().wait(failed, 5000ms), State::Failed);
+  EXPECT_EQ(executor().wait(thrown, 5000ms), State::Failed);
+  EXPECT_EQ((*executor().getOperationJson(failed))["error"].asString(),
+            "pipeline not found");
+  EXPECT_EQ((*executor().getOperationJson(thrown))["error"].asString(),
+            "boom");
+  EXPECT_FALSE(executor().getOperationJson("no-such-id").has_value());
+}
+
+TEST_F(OperationExecutorTest, SerializesPerInstanceAndBoundsParallelism) {
+  std::mutex mutex;
+  std::unordered_map<std::string, int> active;
+  std::unordered_map<std::string, std::vector<int>> order;
+  std::atomic<int> running{0};
+  std::atomic<int> peak{0};
+  bool overlapped = false;
+
+  std::vector<std::string> ids;
+  for (int i = 0; i < 40; ++i) {
+    std::string key = "serial-" + std::to_string(i % 8);
+    ids.push_back(executor().submit(
+        "restart", key,
+        [&, key, i](OperationExecutor::Progress &, std::string &) {
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            overlapped = overlapped || active[key] > 0;
+            ++active[key];
+            order[key].push_back(i);
+          }
+          int now = ++running;
+          int seen = peak.load();
+          while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+          }
+          std::this_thread::sleep_for(2ms);
+          --running;
+          std::lock_guard<std::mutex> lock(mutex);
+          --active[key];
+          return true;
+        }));
+  }
+  for (const auto &id : ids) {
+    ASSERT_EQ(executor().wait(id, 10000ms), State::Succeeded);
+  }
+
+  EXPECT_FALSE(overlapped);
+  EXPECT_LE(peak.load(), 4);
+  EXPECT_GT(peak.load(), 1);
+  for (const auto &entry : order) {
+    // Same-instance operations run in submission order
+    for (size_t i = 1; i < entry.second.size(); ++i) {
+      EXPECT_LT(entry.second[i - 1], entry.second[i]);
+    }
+  }
+  EXPECT_EQ(executor().listOperationsJson("serial-3", 100).size(), 5u);
+}
+
+TEST_F(OperationExecutorTest, BatchAggregatesChildren) {
+  std::vector<OperationExecutor::BatchItem> items;
+  for (int i = 0; i < 6; ++i) {
+    items.push_back({"inst-" + std::to_string(i),
+                     [i](OperationExecutor::Progress &, std::string &error) {
+                       if (i == 2) {
+                         error = "not found";
+                         return false;
+                       }
+                       return true;
+                     }});
+  }
+  std::string id = executor().submitBatch("batch_restart", std::move(items));
+  ASSERT_FALSE(id.empty());
+  EXPECT_EQ(executor().wait(id, 5000ms), State::Failed);
+
+  Json::Value json = *executor().getOperationJson(id);
+  EXPECT_EQ(json["summary"]["total"].asUInt(), 6u);
+  EXPECT_EQ(json["summary"]["succeeded"].asUInt(), 5u);
+  EXPECT_EQ(json["summary"]["failed"].asUInt(), 1u);
+  EXPECT_EQ(json["children"].size(), 6u);
+  EXPECT_EQ(json["children"][2]["error"].asString(), "not found");
+  EXPECT_EQ(json["children"][0]["parentId"].asString(), id);
+  EXPECT_EQ(json["error"].asString(), "1 of 6 operations failed");
+
+  // Listing shows the batch, not its children
+  Json::Value list = executor().listOperationsJson("", 1);
+  ASSERT_EQ(list.size(), 1u);
+  EXPECT_EQ(list[0]["operationId"].asString(), id);
+
+  std::string empty = executor().submitBatch("batch_stop", {});
+  EXPECT_EQ(executor().getState(empty), State::Succeeded);
+}
+
+TEST_F(OperationExecutorTest, RejectsWhenFullAndCancelsOnShutdown) {
+  OperationExecutor::Config config;
+  config.worker_threads = 1;
+  config.max_pending = 2;
+  executor().configure(config);
+
+  std::atomic<bool> release{false};
+  auto blocker = [&](OperationExecutor::Progress &, std::string &) {
+    while (!release) {
+      std::this_thread::sleep_for(1ms);
+    }
+    return true;
+  };
+  std::string first = executor().submit("stop", "a", blocker);
+  while (executor().getState(first) != State::Running) {
+    std::this_thread::sleep_for(1ms);
+  }
+  std::string second = executor().submit("stop", "b", blocker);
+  std::string third = executor().submit("stop", "c", blocker);
+  EXPECT_FALSE(second.empty());
+  EXPECT_FALSE(third.empty());
+  EXPECT_TRUE(executor().submit("stop", "d", blocker).empty());
+  EXPECT_TRUE(executor()
+                  .submitBatch("batch_stop", {{"e", blocker}, {"f", blocker}})
+                  .empty());
+  EXPECT_EQ(executor().getStats().rejected, 2u);
+
+  // Shut down with work still queued: the running operation finishes, the
+  // queued ones are cancelled and new submissions are refused
+  std::thread releaser([&] {
+    std::this_thread::sleep_for(50ms);
+    release = true;
+  });
+  executor().shutdown();
+  releaser.join();
+
+  EXPECT_EQ(executor().getState(first), State::Succeeded);
+  EXPECT_EQ(executor().getState(second), State::Cancelled);
+  EXPECT_EQ(executor().getState(third), State::Cancelled);
+  auto cancelled = *executor().getOperationJson(third);
+  EXPECT_EQ(cancelled["error"].asString(), "Server shutting down");
+  // Never ran: no start time or duration
+  EXPECT_FALSE(cancelled.isMember("startedAt"));
+  EXPECT_FALSE(cancelled.isMember("durationMs"));
+  EXPECT_TRUE(cancelled.isMember("queuedMs"));
+  EXPECT_TRUE((*executor().getOperationJson(first)).isMember("startedAt"));
+  EXPECT_TRUE(executor().submit("stop", "h", blocker).empty());
+}
+
+TEST_F(OperationExecutorTest, BatchOptionsCapParallelismTimeOutAndNotify) {
+  std::atomic<int> running{0};
+  std::atomic<int> peak{0};
+  std::atomic<bool> release{false};
+  std::vector<OperationExecutor::BatchItem> items;
+  for (int i = 0; i < 6; ++i) {
+    items.push_back({"group-" + std::to_string(i),
+                     [&, i](OperationExecutor::Progress &, std::string &) {
+                       int now = ++running;
+                       int seen = peak.load();
+                       while (now > seen &&
+                              !peak.compare_exchange_weak(seen, now)) {
+                       }
+                       // The last item hangs past its timeout
+                       while (i == 5 && !release) {
+                         std::this_thread::sleep_for(1ms);
+                       }
+                       std::this_thread::sleep_for(5ms);
+                       --running;
+                       return true;
+                     }});
+  }
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<std::string> events;
+  Json::Value done;
+  OperationExecutor::BatchOptions options;
+  options.max_parallel = 2;
+  options.item_timeout = 200ms;
+  options.observer = [&](const std::string &event, const Json::Value &data) {
+    std::lock_guard<std::mutex> lock(mutex);
+    events.push_back(event);
+    if (event == "done") {
+      done = data;
+      cv.notify_all();
+    }
+  };
+  std::string id =
+      executor().submitBatch("group_restart", std::move(items), options);
+  ASSERT_FALSE(id.empty());
+  EXPECT_EQ(executor().wait(id, 5000ms), State::Failed);
+  EXPECT_LE(peak.load(), 2);
+
+  {
+    // Observers run after the state change, so wait for the event itself
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(cv.wait_for(lock, 5000ms, [&] { return !done.isNull(); }));
+    ASSERT_EQ(events.size(), 7u);
+    for (size_t i = 0; i < 6; ++i) {
+      EXPECT_EQ(events[i], "instance");
+    }
+    EXPECT_EQ(events[6], "done");
+    EXPECT_EQ(done["operationId"].asString(), id);
+    EXPECT_EQ(done["summary"]["succeeded"].asUInt(), 5u);
+    EXPECT_EQ(done["children"][5]["error"].asString(),
+              "Timed out after 200 ms");
+  }
+  EXPECT_EQ(executor().getStats().timed_out, 1u);
+
+  // The timed-out task still owns its instance until it returns
+  std::string next = executor().submit(
+      "stop", "group-5",
+      [](OperationExecutor::Progress &, std::string &) { return true; });
+  EXPECT_FALSE(executor().wait(next, 50ms).has_value());
+  release = true;
+  EXPECT_EQ(executor().wait(next, 5000ms), State::Succeeded);
+}
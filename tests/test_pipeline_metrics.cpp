@@ -0,0 +1,161 @@
+#include "core/pipeline_metrics.h"
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+
+class PipelineMetricsTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    prefix_ = "pipeline_metrics_test_" +
+              std::to_string(reinterpret_cast<uintptr_t>(this)) + "_";
+  }
+
+  void TearDown() override {
+    auto &registry = PipelineMetricsRegistry::getInstance();
+    for (const auto &id : ids_) {
+      registry.remove(id);
+      BackpressureController::BackpressureController::getInstance()
+          .unregisterInstance(id);
+      QueueTelemetry::getInstance().remove(id);
+    }
+  }
+
+  std::string track(const std::string &suffix) {
+    ids_.push_back(prefix_ + suffix);
+    return ids_.back();
+  }
+
+  std::string prefix_;
+  std::vector<std::string> ids_;
+};
+
+TEST_F(PipelineMetricsTest, ExportsInProcessPipelinePerInstanceAndNode) {
+  std::string id = track("inprocess");
+  auto telemetry = QueueTelemetry::getInstance().getOrCreate(id);
+  auto handle =
+      BackpressureController::BackpressureController::getInstance()
+          .registerInstance(id);
+  auto *decoder = telemetry->addNode("node_0");
+  decoder->setName("file_src_0");
+  decoder->record(3, telemetry->highWatermark());
+  decoder->recordDrops(2);
+
+  auto counters =
+      PipelineMetricsRegistry::getInstance().attach(id, handle, telemetry);
+  EXPECT_EQ(PipelineMetricsRegistry::getInstance().attach(id, handle,
+                                                          telemetry),
+            counters);
+  counters->frames_incoming.fetch_add(5);
+  handle->recordFrameProcessed();
+  handle->recordFrameProcessed();
+  handle->recordFrameDropped();
+  PipelineMetricsRegistry::getInstance().recordReconnect(id, false);
+  PipelineMetricsRegistry::getInstance().recordReconnect(id, true);
+
+  std::string text = PipelineMetricsRegistry::getInstance().getPrometheusMetrics();
+  std::string label = "{instance_id=\"" + id + "\"} ";
+  EXPECT_NE(text.find("pipeline_frames_incoming_total" + label + "5\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("pipeline_frames_processed_total" + label + "2\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("pipeline_frames_dropped_total" + label + "1\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("pipeline_rtsp_reconnect_attempts_total" + label + "2\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("pipeline_rtsp_reconnect_failures_total" + label + "1\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("pipeline_target_fps" + label), std::string::npos);
+  EXPECT_NE(text.find("pipeline_node_queue_depth{instance_id=\"" + id +
+                      "\",node=\"file_src_0\"} 3\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("pipeline_node_frames_dropped_total{instance_id=\"" + id +
+                      "\",node=\"file_src_0\"} 2\n"),
+            std::string::npos);
+
+  PipelineMetricsRegistry::getInstance().remove(id);
+  text = PipelineMetricsRegistry::getInstance().getPrometheusMetrics();
+  EXPECT_EQ(text.find(id), std::string::npos);
+}
+
+TEST_F(PipelineMetricsTest, ExportsPushedWorkerStatistics) {
+  std::string id = track("worker\"1");
+  Json::Value stats;
+  stats["frames_incoming"] = 120;
+  stats["frames_processed"] = 100;
+  stats["dropped_frames_count"] = 20;
+  stats["input_queue_size"] = 4;
+  stats["current_framerate"] = 25.0;
+  stats["latency"] = 40.0;
+  PipelineMetricsRegistry::getInstance().updateFromStatistics(id, stats);
+
+  std::string text = PipelineMetricsRegistry::getInstance().getPrometheusMetrics();
+  std::string label = "{instance_id=\"" + prefix_ + "worker\\\"1\"} ";
+  EXPECT_NE(text.find("pipeline_frames_processed_total" + label + "100\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("pipeline_frames_dropped_total" + label + "20\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("pipeline_queue_depth" + label + "4\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("pipeline_latency_seconds" + label + "0.04\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("pipeline_frames_incoming_total" + label + "120\n"),
+            std::string::npos);
+  // No backpressure controller for this instance in this process
+  EXPECT_EQ(text.find("pipeline_target_fps" + label), std::string::npos);
+  // Not reported by the worker: left out rather than exported as 0
+  EXPECT_EQ(text.find("pipeline_rtsp_reconnect_attempts_total" + label),
+            std::string::npos);
+
+  stats.removeMember("frames_incoming");
+  stats["rtsp_reconnect_attempts"] = 3;
+  stats["rtsp_reconnect_failures"] = 1;
+  PipelineMetricsRegistry::getInstance().updateFromStatistics(id, stats);
+  text = PipelineMetricsRegistry::getInstance().getPrometheusMetrics();
+  EXPECT_EQ(text.find("pipeline_frames_incoming_total" + label),
+            std::string::npos);
+  EXPECT_NE(
+      text.find("pipeline_rtsp_reconnect_attempts_total" + label + "3\n"),
+      std::string::npos);
+  EXPECT_NE(
+      text.find("pipeline_rtsp_reconnect_failures_total" + label + "1\n"),
+      std::string::npos);
+}
+
+TEST_F(PipelineMetricsTest, ScrapeOfHundredInstancesIsCheapDuringUpdates) {
+  auto &registry = PipelineMetricsRegistry::getInstance();
+  for (int i = 0; i < 100; ++i) {
+    std::string id = track("cam" + std::to_string(i));
+    auto telemetry = QueueTelemetry::getInstance().getOrCreate(id);
+    for (int n = 0; n < 6; ++n) {
+      telemetry->addNode("node_" + std::to_string(n));
+    }
+    registry.attach(id,
+                    BackpressureController::BackpressureController::getInstance()
+                        .registerInstance(id),
+                    telemetry);
+  }
+
+  // Frame threads keep counting while we scrape
+  std::atomic<bool> stop{false};
+  auto counters = registry.counters(ids_.front());
+  std::thread writer([&]() {
+    while (!stop.load()) {
+      counters->frames_incoming.fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+
+  registry.getPrometheusMetrics(); // Warm up
+  auto start = std::chrono::steady_clock::now();
+  constexpr int kScrapes = 20;
+  for (int i = 0; i < kScrapes; ++i) {
+    EXPECT_FALSE(registry.getPrometheusMetrics().empty());
+  }
+  auto per_scrape = (std::chrono::steady_clock::now() - start) / kScrapes;
+  stop = true;
+  writer.join();
+
+  // Generous bound for sanitizer/debug builds; release builds are ~10x lower
+  EXPECT_LT(std::chrono::duration_cast<std::chrono::microseconds>(per_scrape)
+                .count(),
+            5000);
+}
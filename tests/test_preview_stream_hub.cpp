@@ -0,0 +1,244 @@
+#include "core/preview_stream_hub.h"
+#include <gtest/gtest.h>
+#include <map>
+#include <vector>
+
+class PreviewStreamHubTest : public ::testing::Test {
+protected:
+  using Clock = std::chrono::steady_clock;
+
+  void SetUp() override {
+    hub().shutdown(); // Drops viewers of previous tests
+    hub().configure(PreviewStreamHub::Config());
+    hub().setFrameSource([this](const std::string &instanceId) {
+      fetches_[instanceId]++;
+      return frames_[instanceId];
+    });
+    hub().setTranscoder([this](const std::string &jpeg, int width, int) {
+      encodes_++;
+      return jpeg + "@" + std::to_string(width);
+    });
+  }
+
+  void TearDown() override { hub().shutdown(); }
+
+  static PreviewStreamHub &hub() { return PreviewStreamHub::getInstance(); }
+
+  PreviewStreamHub::ViewerId
+  watch(const std::string &instanceId, PreviewStreamHub::Variant variant,
+        std::vector<std::string> &received,
+        PreviewStreamHub::Framing framing = PreviewStreamHub::Framing::Jpeg) {
+    return hub().addViewer(instanceId, hub().normalize(variant), framing,
+                           [&received](const PreviewStreamHub::Payload &p,
+                                       PreviewStreamHub::Sent sent) {
+                             received.push_back(*p);
+                             sent();
+                             return true;
+                           });
+  }
+
+  std::map<std::string, std::string> frames_;
+  std::map<std::string, int> fetches_;
+  int encodes_ = 0;
+};
+
+TEST_F(PreviewStreamHubTest, EncodesOncePerVariantAndSharesAcrossViewers) {
+  frames_["cam-1"] = "JPEG1";
+  std::vector<std::string> a, b, c, mjpeg;
+  watch("cam-1", {5, 320}, a);
+  watch("cam-1", {5, 321}, b); // Rounded to the same width
+  watch("cam-1", {5, 0}, c);
+  watch("cam-1", {5, 320}, mjpeg, PreviewStreamHub::Framing::MultipartPart);
+
+  auto now = Clock::now();
+  EXPECT_EQ(hub().pump(now), 4u);
+  EXPECT_EQ(fetches_["cam-1"], 1);
+  EXPECT_EQ(encodes_, 1); // Only the scaled variant is re-encoded
+  ASSERT_EQ(a.size(), 1u);
+  EXPECT_EQ(a[0], "JPEG1@320");
+  EXPECT_EQ(b, a);
+  EXPECT_EQ(c[0], "JPEG1");
+  EXPECT_EQ(mjpeg[0], PreviewStreamHub::makeMultipartPart("JPEG1@320"));
+  EXPECT_EQ(hub().getStats().variants, 2u);
+}
+
+TEST_F(PreviewStreamHubTest, RespectsFpsAndSkipsUnchangedFrames) {
+  frames_["cam-1"] = "JPEG1";
+  std::vector<std::string> slow, fast;
+  watch("cam-1", {1, 0}, slow);
+  watch("cam-1", {10, 0}, fast);
+
+  auto t0 = Clock::now();
+  hub().pump(t0);
+  hub().pump(t0 + std::chrono::milliseconds(150)); // Only fast is due
+  EXPECT_EQ(slow.size(), 1u);
+  EXPECT_EQ(fast.size(), 1u); // Same frame, not resent
+  EXPECT_EQ(hub().getStats().frames_unchanged, 1u);
+
+  frames_["cam-1"] = "JPEG2";
+  hub().pump(t0 + std::chrono::milliseconds(300));
+  EXPECT_EQ(fast.size(), 2u);
+  EXPECT_EQ(slow.size(), 1u);
+  hub().pump(t0 + std::chrono::milliseconds(1100));
+  EXPECT_EQ(slow.size(), 2u);
+  EXPECT_EQ(slow.back(), "JPEG2");
+}
+
+TEST_F(PreviewStreamHubTest, NewViewerGetsCurrentFrameWithoutChange) {
+  frames_["cam-1"] = "JPEG1";
+  std::vector<std::string> first, late;
+  watch("cam-1", {5, 0}, first);
+
+  auto t0 = Clock::now();
+  hub().pump(t0);
+  watch("cam-1", {5, 0}, late); // Joins after the frame was pushed
+  hub().pump(t0 + std::chrono::milliseconds(200));
+  EXPECT_EQ(first.size(), 1u); // Already has it
+  ASSERT_EQ(late.size(), 1u);
+  EXPECT_EQ(late[0], "JPEG1");
+
+  auto unchanged = hub().getStats().frames_unchanged;
+  hub().pump(t0 + std::chrono::milliseconds(400));
+  EXPECT_EQ(late.size(), 1u);
+  EXPECT_EQ(hub().getStats().frames_unchanged, unchanged + 1);
+}
+
+TEST_F(PreviewStreamHubTest, SlowViewerSkipsFramesWhileBusy) {
+  auto config = PreviewStreamHub::Config();
+  config.max_frames_in_flight = 2;
+  hub().configure(config);
+
+  std::vector<std::string> fast;
+  std::vector<PreviewStreamHub::Sent> pending; // Slow viewer's sends
+  int slowPushes = 0;
+  watch("cam-1", {10, 0}, fast);
+  hub().addViewer("cam-1", {10, 0}, PreviewStreamHub::Framing::Jpeg,
+                  [&](const PreviewStreamHub::Payload &,
+                      PreviewStreamHub::Sent sent) {
+                    slowPushes++;
+                    pending.push_back(std::move(sent));
+                    return true;
+                  });
+
+  auto skipped = hub().getStats().frames_skipped;
+  auto t0 = Clock::now();
+  for (int i = 0; i < 5; ++i) {
+    frames_["cam-1"] = "JPEG" + std::to_string(i);
+    hub().pump(t0 + std::chrono::milliseconds(100 * i));
+  }
+  EXPECT_EQ(fast.size(), 5u);
+  EXPECT_EQ(slowPushes, 2);
+  EXPECT_EQ(hub().getStats().frames_skipped, skipped + 3);
+
+  // Once the connection caught up it gets the latest frame again
+  for (auto &sent : pending) {
+    sent();
+  }
+  frames_["cam-1"] = "JPEG5";
+  hub().pump(t0 + std::chrono::milliseconds(500));
+  EXPECT_EQ(slowPushes, 3);
+}
+
+TEST_F(PreviewStreamHubTest, StopsFetchingWhenNobodyWatches) {
+  frames_["cam-1"] = "JPEG1";
+  std::vector<std::string> received;
+  auto id = watch("cam-1", {5, 0}, received);
+  bool open = true;
+  hub().addViewer("cam-2", {5, 0}, PreviewStreamHub::Framing::Jpeg,
+                  [&open](const PreviewStreamHub::Payload &,
+                          PreviewStreamHub::Sent sent) {
+                    if (open) {
+                      sent();
+                    }
+                    return open;
+                  });
+  frames_["cam-2"] = "JPEG2";
+
+  auto now = Clock::now();
+  hub().pump(now);
+  open = false; // Client disconnected: dropped on next push
+  frames_["cam-2"] = "JPEG3";
+  hub().pump(now + std::chrono::seconds(1));
+  EXPECT_EQ(hub().getStats().instances, 1u);
+
+  hub().removeViewer(id);
+  EXPECT_EQ(hub().getStats().viewers, 0u);
+  hub().pump(now + std::chrono::seconds(2));
+  EXPECT_EQ(fetches_["cam-1"], 2);
+  EXPECT_EQ(fetches_["cam-2"], 2);
+}
+
+TEST_F(PreviewStreamHubTest, DropsClosedViewersWithoutPushing) {
+  frames_["cam-1"] = "JPEG1";
+  bool open = true;
+  int pushes = 0;
+  hub().addViewer(
+      "cam-1", {5, 0}, PreviewStreamHub::Framing::MultipartPart,
+      [&pushes](const PreviewStreamHub::Payload &,
+                PreviewStreamHub::Sent sent) {
+        pushes++;
+        sent();
+        return true;
+      },
+      [&open] { return open; });
+
+  auto now = Clock::now();
+  hub().pump(now);
+  EXPECT_EQ(pushes, 1);
+
+  // Static scene: nothing to push, the closed client is still noticed and
+  // its instance is no longer fetched
+  open = false;
+  hub().pump(now + std::chrono::seconds(1));
+  EXPECT_EQ(pushes, 1);
+  EXPECT_EQ(hub().getStats().viewers, 0u);
+  EXPECT_EQ(fetches_["cam-1"], 1);
+
+  // Stopped instance (no frame) behaves the same
+  frames_["cam-2"] = "";
+  bool open2 = true;
+  hub().addViewer(
+      "cam-2", {5, 0}, PreviewStreamHub::Framing::Jpeg,
+      [](const PreviewStreamHub::Payload &, PreviewStreamHub::Sent sent) {
+        sent();
+        return true;
+      },
+      [&open2] { return open2; });
+  hub().pump(now + std::chrono::seconds(2));
+  open2 = false;
+  hub().pump(now + std::chrono::seconds(3));
+  EXPECT_EQ(hub().getStats().viewers, 0u);
+}
+
+TEST_F(PreviewStreamHubTest, RemoveInstanceDropsItsViewers) {
+  std::vector<std::string> a, b, c;
+  watch("cam-1", {5, 0}, a);
+  watch("cam-1", {10, 320}, b);
+  watch("cam-2", {5, 0}, c);
+
+  EXPECT_EQ(hub().removeInstance("cam-1"), 2u);
+  EXPECT_EQ(hub().removeInstance("cam-1"), 0u);
+  auto stats = hub().getStats();
+  EXPECT_EQ(stats.viewers, 1u);
+  EXPECT_EQ(stats.instances, 1u);
+}
+
+TEST_F(PreviewStreamHubTest, BackgroundThreadPushesFrames) {
+  frames_["cam-1"] = "JPEG1";
+  std::mutex mutex;
+  std::condition_variable cv;
+  int received = 0;
+  hub().start();
+  hub().addViewer("cam-1", {30, 0}, PreviewStreamHub::Framing::Jpeg,
+                  [&](const PreviewStreamHub::Payload &,
+                      PreviewStreamHub::Sent sent) {
+                    sent();
+                    std::lock_guard<std::mutex> lock(mutex);
+                    received++;
+                    cv.notify_all();
+                    return true;
+                  });
+  std::unique_lock<std::mutex> lock(mutex);
+  EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(2),
+                          [&] { return received > 0; }));
+}
@@ -0,0 +1,132 @@
+#include "core/queue_telemetry.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+class QueueTelemetryTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    instance_id_ = "queue_telemetry_test_" +
+                   std::to_string(reinterpret_cast<uintptr_t>(this));
+    series_ = QueueTelemetry::getInstance().getOrCreate(instance_id_);
+    series_->setQueueCapacity(20); // High watermark 16
+  }
+
+  void TearDown() override { QueueTelemetry::getInstance().remove(instance_id_); }
+
+  std::string instance_id_;
+  std::shared_ptr<QueueTelemetry::InstanceSeries> series_;
+};
+
+TEST_F(QueueTelemetryTest, RecordsSamplesPerNode) {
+  auto *source = series_->addNode("node_0");
+  auto *detector = series_->addNode("node_1");
+  ASSERT_NE(source, nullptr);
+  ASSERT_NE(detector, nullptr);
+  EXPECT_EQ(series_->addNode("node_0"), source);
+
+  source->record(1, series_->highWatermark());
+  detector->record(5, series_->highWatermark());
+  detector->record(7, series_->highWatermark());
+
+  EXPECT_EQ(series_->nodeCount(), 2u);
+  EXPECT_EQ(series_->currentMaxDepth(), 7u);
+
+  std::vector<QueueTelemetry::Sample> samples;
+  detector->snapshot(samples, 10);
+  ASSERT_EQ(samples.size(), 2u);
+  EXPECT_EQ(samples[0].depth, 5u);
+  EXPECT_EQ(samples[1].depth, 7u);
+}
+
+TEST_F(QueueTelemetryTest, ReportsFullTransitionOnce) {
+  auto *node = series_->addNode("node_0");
+  uint32_t watermark = series_->highWatermark();
+  EXPECT_EQ(watermark, 16u);
+
+  EXPECT_FALSE(node->record(10, watermark));
+  EXPECT_TRUE(node->record(16, watermark));
+  EXPECT_FALSE(node->record(18, watermark)); // Still full - no new event
+  EXPECT_TRUE(series_->isOverloaded());
+  EXPECT_FALSE(node->record(3, watermark));
+  EXPECT_FALSE(series_->isOverloaded());
+  EXPECT_TRUE(node->record(20, watermark));
+}
+
+TEST_F(QueueTelemetryTest, RingBufferKeepsMostRecentSamples) {
+  auto *node = series_->addNode("node_0");
+  const size_t total = QueueTelemetry::NodeSeries::CAPACITY + 10;
+  for (size_t i = 0; i < total; ++i) {
+    node->record(static_cast<uint32_t>(i % 1000), 0);
+  }
+
+  std::vector<QueueTelemetry::Sample> samples;
+  node->snapshot(samples, total);
+  ASSERT_EQ(samples.size(), QueueTelemetry::NodeSeries::CAPACITY);
+  EXPECT_EQ(samples.back().depth, static_cast<uint32_t>((total - 1) % 1000));
+  EXPECT_EQ(node->totalSamples(), total);
+}
+
+TEST_F(QueueTelemetryTest, SummarizesWindow) {
+  auto *node = series_->addNode("node_0");
+  for (int i = 0; i < 10; ++i) {
+    node->record(i < 9 ? 18 : 2, series_->highWatermark());
+  }
+  node->recordDrops(3);
+  node->record(17, series_->highWatermark());
+
+  auto summary = series_->summarize(5000);
+  EXPECT_EQ(summary.samples, 11u);
+  EXPECT_EQ(summary.max_depth, 18u);
+  EXPECT_EQ(summary.current_depth, 17u);
+  EXPECT_EQ(summary.drops, 3u);
+  EXPECT_NEAR(summary.full_ratio, 10.0 / 11.0, 1e-9);
+}
+
+TEST_F(QueueTelemetryTest, ConcurrentWritersAndReaders) {
+  auto *node = series_->addNode("node_0");
+  std::atomic<bool> stop{false};
+  std::thread reader([&]() {
+    std::vector<QueueTelemetry::Sample> samples;
+    while (!stop.load()) {
+      samples.clear();
+      node->snapshot(samples, QueueTelemetry::NodeSeries::CAPACITY);
+      for (size_t i = 1; i < samples.size(); ++i) {
+        ASSERT_LE(samples[i - 1].timestamp_ms, samples[i].timestamp_ms);
+      }
+    }
+  });
+
+  std::vector<std::thread> writers;
+  for (int w = 0; w < 4; ++w) {
+    writers.emplace_back([&]() {
+      for (int i = 0; i < 10000; ++i) {
+        node->record(static_cast<uint32_t>(i % 30), series_->highWatermark());
+      }
+    });
+  }
+  for (auto &writer : writers) {
+    writer.join();
+  }
+  stop.store(true);
+  reader.join();
+
+  EXPECT_EQ(node->totalSamples(), 40000u);
+}
+
+TEST_F(QueueTelemetryTest, SerializesToJson) {
+  auto *node = series_->addNode("node_0");
+  node->setName("yolo_detector_0");
+  node->record(4, series_->highWatermark());
+
+  Json::Value json = QueueTelemetry::getInstance().toJson(instance_id_, 10);
+  ASSERT_FALSE(json.isNull());
+  EXPECT_EQ(json["highWatermark"].asUInt(), 16u);
+  ASSERT_EQ(json["nodes"].size(), 1u);
+  EXPECT_EQ(json["nodes"][0]["name"].asString(), "yolo_detector_0");
+  EXPECT_EQ(json["nodes"][0]["samples"].size(), 1u);
+  EXPECT_EQ(json["nodes"][0]["samples"][0][1].asUInt(), 4u);
+
+  EXPECT_TRUE(
+      QueueTelemetry::getInstance().toJson("missing_instance", 10).isNull());
+}
@@ -0,0 +1,129 @@
+#include "core/recognition_cache.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+class RecognitionCacheTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    RecognitionCache::Config config;
+    config.max_bytes = 1024 * 1024;
+    config.perceptual_hash = true;
+    RecognitionCache::getInstance().configure(config);
+  }
+
+  void TearDown() override {
+    RecognitionCache::getInstance().configure(RecognitionCache::Config());
+  }
+
+  static std::vector<unsigned char> image(unsigned char seed, size_t size) {
+    std::vector<unsigned char> bytes(size);
+    for (size_t i = 0; i < size; ++i) {
+      bytes[i] = static_cast<unsigned char>(seed + i * 31);
+    }
+    return bytes;
+  }
+};
+
+TEST_F(RecognitionCacheTest, HashIsStableAndContentSensitive) {
+  auto a = image(1, 4096);
+  auto b = a;
+  b[2048] ^= 1;
+  EXPECT_EQ(RecognitionCache::hashBytes(a.data(), a.size()),
+            RecognitionCache::hashBytes(a.data(), a.size()));
+  EXPECT_NE(RecognitionCache::hashBytes(a.data(), a.size()),
+            RecognitionCache::hashBytes(b.data(), b.size()));
+  // Reference XXH64 value of the empty input with seed 0
+  EXPECT_EQ(RecognitionCache::hashBytes("", 0), 0xEF46DB3751D8E999ULL);
+
+  EXPECT_NE(RecognitionCache::makeKey(a, "recognize|limit=0"),
+            RecognitionCache::makeKey(a, "recognize|limit=1"));
+}
+
+TEST_F(RecognitionCacheTest, HitsMissesAndGalleryInvalidation) {
+  auto &cache = RecognitionCache::getInstance();
+  auto key = RecognitionCache::makeKey(image(1, 1000), "recognize");
+
+  EXPECT_FALSE(cache.get(key).has_value());
+  cache.put(key, "{\"result\":[]}", cache.galleryVersion());
+  auto hit = cache.get(key);
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_EQ(*hit, "{\"result\":[]}");
+
+  uint64_t version = cache.galleryVersion();
+  cache.bumpGalleryVersion();
+  EXPECT_FALSE(cache.get(key).has_value());
+
+  // Results computed against the old gallery are not stored
+  cache.put(key, "stale", version);
+  EXPECT_FALSE(cache.get(key).has_value());
+
+  auto stats = cache.getStats();
+  EXPECT_EQ(stats.hits, 1u);
+  EXPECT_EQ(stats.misses, 3u);
+}
+
+TEST_F(RecognitionCacheTest, EvictsLeastRecentlyUsedWithinByteBudget) {
+  auto &cache = RecognitionCache::getInstance();
+  std::vector<RecognitionCache::Key> keys;
+  std::string value(8 * 1024, 'x');
+  for (int i = 0; i < 400; ++i) {
+    keys.push_back(
+        RecognitionCache::makeKey(image(static_cast<unsigned char>(i), 64 + i),
+                                  "recognize"));
+    cache.put(keys.back(), value, cache.galleryVersion());
+    cache.get(keys.front()); // Keep the first entry hot
+  }
+
+  auto stats = cache.getStats();
+  EXPECT_LE(stats.bytes, stats.max_bytes);
+  EXPECT_GT(stats.evictions, 0u);
+  EXPECT_TRUE(cache.get(keys.front()).has_value());
+  EXPECT_TRUE(cache.get(keys.back()).has_value());
+}
+
+TEST_F(RecognitionCacheTest, MatchesNearDuplicateFrames) {
+  auto &cache = RecognitionCache::getInstance();
+  uint8_t thumb[72];
+  for (int i = 0; i < 72; ++i) {
+    thumb[i] = static_cast<uint8_t>((i * 37) % 251);
+  }
+  uint64_t hash = RecognitionCache::differenceHash(thumb);
+  thumb[0] = thumb[1]; // Slight change flips at most one bit
+  uint64_t similar = RecognitionCache::differenceHash(thumb);
+  EXPECT_LE(RecognitionCache::hammingDistance(hash, similar), 1);
+
+  auto key = RecognitionCache::makeKey(image(7, 500), "search");
+  cache.put(key, "cached", cache.galleryVersion(), hash);
+
+  auto hit = cache.getSimilar(key.params, similar);
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_EQ(*hit, "cached");
+  EXPECT_FALSE(cache.getSimilar(key.params, ~hash).has_value());
+  EXPECT_FALSE(cache.getSimilar(key.params + 1, similar).has_value());
+  EXPECT_EQ(cache.getStats().perceptual_hits, 1u);
+}
+
+TEST_F(RecognitionCacheTest, ConcurrentAccess) {
+  auto &cache = RecognitionCache::getInstance();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&cache, t]() {
+      for (int i = 0; i < 2000; ++i) {
+        auto key = RecognitionCache::makeKey(
+            image(static_cast<unsigned char>(i % 50), 256), "recognize");
+        if (!cache.get(key)) {
+          cache.put(key, std::string(512, 'a' + t), cache.galleryVersion());
+        }
+        if (t == 0 && i % 500 == 0) {
+          cache.bumpGalleryVersion();
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  auto stats = cache.getStats();
+  EXPECT_EQ(stats.hits + stats.misses, 8000u);
+}
@@ -0,0 +1,88 @@
+#include "core/priority_queue.h"
+#include "core/rate_limiter.h"
+#include "core/request_middleware.h"
+#include <gtest/gtest.h>
+
+using Admission = RequestAdmissionControl;
+
+TEST(RequestAdmissionTest, ClassifiesRoutes) {
+  EXPECT_EQ(Admission::classify(drogon::Get, "/v1/core/health").request_class,
+            Admission::RequestClass::Critical);
+  EXPECT_EQ(Admission::classify(drogon::Get,
+                                "/v1/core/instance/abc/statistics")
+                .request_class,
+            Admission::RequestClass::Critical);
+  EXPECT_EQ(Admission::classify(drogon::Get, "/v1/core/instance").request_class,
+            Admission::RequestClass::Normal);
+
+  auto recognize =
+      Admission::classify(drogon::Post, "/v1/recognition/recognize");
+  EXPECT_EQ(recognize.request_class, Admission::RequestClass::Heavy);
+  EXPECT_EQ(recognize.priority, PriorityQueue::Priority::Medium);
+
+  auto batch = Admission::classify(drogon::Post, "/v1/core/instance/batch/start");
+  EXPECT_EQ(batch.request_class, Admission::RequestClass::Heavy);
+  EXPECT_EQ(batch.priority, PriorityQueue::Priority::High);
+  auto group =
+      Admission::classify(drogon::Post, "/v1/core/groups/site-a/restart");
+  EXPECT_EQ(group.request_class, Admission::RequestClass::Heavy);
+  EXPECT_EQ(group.priority, PriorityQueue::Priority::High);
+
+  auto upload = Admission::classify(drogon::Post, "/v1/core/model/upload");
+  EXPECT_EQ(upload.request_class, Admission::RequestClass::Heavy);
+  EXPECT_EQ(upload.priority, PriorityQueue::Priority::Low);
+
+  // Only POST does the heavy work
+  EXPECT_EQ(Admission::classify(drogon::Get, "/v1/recognition/faces")
+                .request_class,
+            Admission::RequestClass::Normal);
+}
+
+TEST(RequestAdmissionTest, TokenBucketLimitsPerClient) {
+  RateLimiter limiter(3, std::chrono::seconds(60));
+  EXPECT_TRUE(limiter.allow("10.0.0.1"));
+  EXPECT_TRUE(limiter.allow("10.0.0.1"));
+  EXPECT_TRUE(limiter.allow("10.0.0.1"));
+  EXPECT_FALSE(limiter.allow("10.0.0.1"));
+  EXPECT_EQ(limiter.getRemainingTokens("10.0.0.1"), 0u);
+
+  // Other clients have their own bucket
+  EXPECT_TRUE(limiter.allow("10.0.0.2"));
+  EXPECT_EQ(limiter.getRemainingTokens("10.0.0.2"), 2u);
+
+  limiter.reset("10.0.0.1");
+  EXPECT_TRUE(limiter.allow("10.0.0.1"));
+}
+
+TEST(RequestAdmissionTest, PriorityQueueOrdersAndCounts) {
+  PriorityQueue queue(3);
+  auto make = [](PriorityQueue::Priority priority, const char *id) {
+    PriorityQueue::Request request;
+    request.priority = priority;
+    request.request_id = id;
+    request.task = [] {};
+    request.timeout = std::chrono::milliseconds(0);
+    return request;
+  };
+
+  ASSERT_TRUE(queue.enqueue(make(PriorityQueue::Priority::Low, "upload"),
+                            std::chrono::milliseconds(0)));
+  ASSERT_TRUE(queue.enqueue(make(PriorityQueue::Priority::Medium, "recognize"),
+                            std::chrono::milliseconds(0)));
+  ASSERT_TRUE(queue.enqueue(make(PriorityQueue::Priority::High, "batch"),
+                            std::chrono::milliseconds(0)));
+  EXPECT_FALSE(queue.enqueue(make(PriorityQueue::Priority::High, "full"),
+                             std::chrono::milliseconds(0)));
+
+  auto stats = queue.getStats();
+  EXPECT_EQ(stats.total, 3u);
+  EXPECT_EQ(stats.high_priority, 1u);
+  EXPECT_EQ(stats.medium_priority, 1u);
+  EXPECT_EQ(stats.low_priority, 1u);
+
+  EXPECT_EQ(queue.dequeue(std::chrono::milliseconds(0))->request_id, "batch");
+  EXPECT_EQ(queue.dequeue(std::chrono::milliseconds(0))->request_id,
+            "recognize");
+  EXPECT_EQ(queue.getStats().low_priority, 1u);
+  EXPECT_EQ(queue.getStats().high_priority, 0u);
+}
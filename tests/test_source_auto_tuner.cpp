@@ -0,0 +1,174 @@
+#include "core/source_auto_tuner.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+namespace {
+
+using Load = SourceAutoTuner::Load;
+using Setting = SourceAutoTuner::Setting;
+
+SourceAutoTuner::Sample sample(int width, int height, double sourceFps,
+                               double processedFps, size_t queue = 0,
+                               double cpuHeadroom = -1.0) {
+  SourceAutoTuner::Sample s;
+  s.source_width = width;
+  s.source_height = height;
+  s.source_fps = sourceFps;
+  s.processed_fps = processedFps;
+  s.latency_ms = 20.0;
+  s.queue_size = queue;
+  s.cpu_headroom = cpuHeadroom;
+  return s;
+}
+
+SourceAutoTuner::Options fastOptions() {
+  SourceAutoTuner::Options options;
+  options.target_fps = 10.0;
+  options.stable_samples = 2;
+  options.cooldown = std::chrono::seconds(0);
+  return options;
+}
+
+} // namespace
+
+TEST(SourceAutoTunerTest, InitialSettingCapsWidthAndSkipsToTargetFps) {
+  SourceAutoTuner tuner(fastOptions(), Setting(), Setting());
+
+  // 4K at 25 fps: decode at most 1920 wide, process every other frame
+  auto first = tuner.update(sample(3840, 2160, 25.0, 0.0));
+  EXPECT_TRUE(first.changed);
+  EXPECT_DOUBLE_EQ(first.setting.resize_ratio, 0.5);
+  EXPECT_EQ(first.setting.skip_interval, 1);
+
+  // 720p at 30 fps: full resolution, keep one frame in three
+  SourceAutoTuner small(fastOptions(), Setting(), Setting());
+  auto decision = small.update(sample(1280, 720, 30.0, 0.0));
+  EXPECT_DOUBLE_EQ(decision.setting.resize_ratio, 1.0);
+  EXPECT_EQ(decision.setting.skip_interval, 2);
+
+  // No statistics yet: nothing is chosen
+  SourceAutoTuner waiting(fastOptions(), Setting(), Setting());
+  EXPECT_FALSE(waiting.update(sample(0, 0, 0.0, 0.0)).changed);
+  EXPECT_EQ(waiting.current().skip_interval, -1);
+}
+
+TEST(SourceAutoTunerTest, InitialSettingAlreadyRunningIsNotAChange) {
+  // 10 fps source at the target rate, solution already decodes at full size
+  SourceAutoTuner tuner(fastOptions(), Setting(), Setting(), Setting{1.0, 0});
+  auto first = tuner.update(sample(1920, 1080, 10.0, 0.0));
+  EXPECT_FALSE(first.changed);
+  EXPECT_DOUBLE_EQ(tuner.current().resize_ratio, 1.0);
+  EXPECT_EQ(tuner.current().skip_interval, 0);
+
+  // Builder default 0.6 differs from the open-loop full resolution
+  SourceAutoTuner defaults(fastOptions(), Setting(), Setting(),
+                           Setting{0.6, 0});
+  EXPECT_TRUE(defaults.update(sample(1920, 1080, 10.0, 0.0)).changed);
+
+  // Pinned resolution, skip matches: nothing to apply
+  SourceAutoTuner pinned(fastOptions(), Setting(), Setting{0.5, -1},
+                         Setting{0.6, 0});
+  EXPECT_FALSE(pinned.update(sample(3840, 2160, 10.0, 0.0)).changed);
+  EXPECT_DOUBLE_EQ(pinned.current().resize_ratio, 0.5);
+
+  // Unknown running value (templated in the solution) is always applied
+  SourceAutoTuner unknown(fastOptions(), Setting(), Setting(),
+                          Setting{1.0, -1});
+  EXPECT_TRUE(unknown.update(sample(1920, 1080, 10.0, 0.0)).changed);
+}
+
+TEST(SourceAutoTunerTest, OverloadLowersResolutionToDetectionFloorThenSkips) {
+  auto options = fastOptions();
+  options.min_object_px = 40; // 20 px detector minimum -> ratio >= 0.5
+  SourceAutoTuner tuner(options, Setting{0.8, 0}, Setting());
+  EXPECT_DOUBLE_EQ(tuner.minResizeRatio(), 0.5);
+
+  auto t = SourceAutoTuner::Clock::now();
+  auto overloaded = sample(1920, 1080, 10.0, 6.0, 8);
+  EXPECT_EQ(tuner.classify(overloaded), Load::Overloaded);
+
+  // One sample is not enough
+  EXPECT_FALSE(tuner.update(overloaded, t).changed);
+  auto step = tuner.update(overloaded, t);
+  EXPECT_TRUE(step.changed);
+  EXPECT_DOUBLE_EQ(step.setting.resize_ratio, 0.64);
+
+  tuner.update(overloaded, t);
+  EXPECT_DOUBLE_EQ(tuner.update(overloaded, t).setting.resize_ratio, 0.51);
+  tuner.update(overloaded, t);
+  EXPECT_DOUBLE_EQ(tuner.update(overloaded, t).setting.resize_ratio, 0.5);
+
+  // At the floor, frames are skipped instead
+  tuner.update(overloaded, t);
+  auto skip = tuner.update(overloaded, t);
+  EXPECT_DOUBLE_EQ(skip.setting.resize_ratio, 0.5);
+  EXPECT_EQ(skip.setting.skip_interval, 1);
+}
+
+TEST(SourceAutoTunerTest, SpareCapacityUndoesSkipBeforeRaisingResolution) {
+  SourceAutoTuner tuner(fastOptions(), Setting{0.4, 3}, Setting());
+  auto t = SourceAutoTuner::Clock::now();
+  // 25 fps source, skip 3 -> 6.25 fps offered and fully processed
+  auto spare = sample(1920, 1080, 25.0, 6.25, 0, 0.6);
+  EXPECT_EQ(tuner.classify(spare), Load::Spare);
+
+  tuner.update(spare, t);
+  EXPECT_EQ(tuner.update(spare, t).setting.skip_interval, 2);
+  spare.processed_fps = 25.0 / 3;
+  tuner.update(spare, t);
+  EXPECT_EQ(tuner.update(spare, t).setting.skip_interval, 1); // Base for 10fps
+
+  // Skip is at the target rate now; resolution goes up
+  spare.processed_fps = 12.5;
+  tuner.update(spare, t);
+  auto raised = tuner.update(spare, t);
+  EXPECT_EQ(raised.setting.skip_interval, 1);
+  EXPECT_DOUBLE_EQ(raised.setting.resize_ratio, 0.5);
+
+  // A busy CPU is not spare capacity
+  EXPECT_EQ(tuner.classify(sample(1920, 1080, 25.0, 12.5, 0, 0.2)),
+            Load::Balanced);
+  EXPECT_EQ(tuner.classify(sample(1920, 1080, 25.0, 12.5, 0, 0.05)),
+            Load::Overloaded);
+}
+
+TEST(SourceAutoTunerTest, CooldownAndPinnedValuesAreRespected) {
+  auto options = fastOptions();
+  options.cooldown = std::chrono::seconds(60);
+  SourceAutoTuner tuner(options, Setting{0.6, 0}, Setting{0.6, -1});
+  auto t = SourceAutoTuner::Clock::now();
+  auto overloaded = sample(1920, 1080, 10.0, 5.0, 8);
+
+  // Resolution pinned by RESIZE_RATIO: only the skip moves
+  tuner.update(overloaded, t);
+  auto first = tuner.update(overloaded, t);
+  EXPECT_TRUE(first.changed);
+  EXPECT_DOUBLE_EQ(first.setting.resize_ratio, 0.6);
+  EXPECT_EQ(first.setting.skip_interval, 1);
+
+  // Within the cooldown nothing changes, however long the overload lasts
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_FALSE(tuner.update(overloaded, t + std::chrono::seconds(30)).changed);
+  }
+  EXPECT_TRUE(tuner.update(overloaded, t + std::chrono::seconds(61)).changed);
+  EXPECT_EQ(tuner.current().skip_interval, 2);
+}
+
+TEST(SourceAutoTunerTest, ParsesInstanceParameters) {
+  SourceAutoTuner::Options defaults;
+  auto options = SourceAutoTuner::parseOptions(
+      {{"AUTO_TUNE_TARGET_FPS", "12.5"},
+       {"AUTO_TUNE_MIN_OBJECT_PX", "64"},
+       {"AUTO_TUNE_MAX_WIDTH", "${MAX_WIDTH}"}},
+      defaults);
+  EXPECT_DOUBLE_EQ(options.target_fps, 12.5);
+  EXPECT_EQ(options.min_object_px, 64);
+  EXPECT_EQ(options.max_decoded_width, defaults.max_decoded_width);
+
+  EXPECT_THROW(SourceAutoTuner::parseOptions({{"AUTO_TUNE_TARGET_FPS", "fast"}},
+                                             defaults),
+               std::invalid_argument);
+  EXPECT_THROW(SourceAutoTuner::parseOptions(
+                   {{"AUTO_TUNE_DETECTOR_MIN_PX", "0"}}, defaults),
+               std::invalid_argument);
+}
@@ -0,0 +1,154 @@
+#include "core/startup_profiler.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <gtest/gtest.h>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+class StartupProfilerTest : public ::testing::Test {
+protected:
+  void SetUp() override { StartupProfiler::getInstance().reset(); }
+
+  static const StartupProfiler::Phase *
+  findPhase(const std::vector<StartupProfiler::Phase> &phases,
+            const std::string &name) {
+    for (const auto &phase : phases) {
+      if (phase.name == name) {
+        return &phase;
+      }
+    }
+    return nullptr;
+  }
+};
+
+TEST_F(StartupProfilerTest, RunsIndependentPhasesInParallelAfterDependencies) {
+  std::mutex mutex;
+  std::condition_variable cv;
+  int started = 0;
+  std::atomic<bool> config_done{false};
+  std::atomic<bool> order_ok{true};
+
+  // "templates" and "solutions" only finish once both are running at the
+  // same time, which cannot happen on a single thread
+  auto meet = [&]() {
+    std::unique_lock<std::mutex> lock(mutex);
+    ++started;
+    cv.notify_all();
+    return cv.wait_for(lock, std::chrono::seconds(5),
+                       [&]() { return started >= 2; });
+  };
+  bool met_templates = false;
+  bool met_solutions = false;
+
+  StartupTaskGraph graph(3);
+  graph.add("node_pool", {"templates", "solutions"}, [&]() {
+    order_ok = order_ok && met_templates && met_solutions;
+  });
+  graph.add("config", {}, [&]() { config_done = true; });
+  graph.add("templates", {"config"}, [&]() {
+    order_ok = order_ok && config_done;
+    met_templates = meet();
+  });
+  graph.add("solutions", {"config"}, [&]() {
+    order_ok = order_ok && config_done;
+    met_solutions = meet();
+  });
+  graph.run();
+
+  EXPECT_TRUE(met_templates);
+  EXPECT_TRUE(met_solutions);
+  EXPECT_TRUE(order_ok);
+
+  auto phases = StartupProfiler::getInstance().getPhases();
+  ASSERT_EQ(phases.size(), 4u);
+  const auto *templates = findPhase(phases, "templates");
+  const auto *solutions = findPhase(phases, "solutions");
+  ASSERT_NE(templates, nullptr);
+  ASSERT_NE(solutions, nullptr);
+  EXPECT_NE(templates->thread, solutions->thread);
+  const auto *pool = findPhase(phases, "node_pool");
+  ASSERT_NE(pool, nullptr);
+  EXPECT_EQ(pool->depends_on.size(), 2u);
+  EXPECT_GE(pool->start_us, templates->start_us + templates->duration_us);
+}
+
+TEST_F(StartupProfilerTest, FailedPhaseSkipsDependentsAndRethrows) {
+  std::atomic<bool> dependent_ran{false};
+  std::atomic<bool> independent_ran{false};
+
+  StartupTaskGraph graph(2);
+  graph.add("storage", {}, []() { throw std::runtime_error("disk gone"); });
+  graph.add("instances", {"storage"}, [&]() { dependent_ran = true; });
+  graph.add("groups", {"instances"}, [&]() { dependent_ran = true; });
+  graph.add("plugins", {}, [&]() { independent_ran = true; });
+
+  EXPECT_THROW(
+      {
+        try {
+          graph.run();
+        } catch (const std::runtime_error &e) {
+          EXPECT_STREQ(e.what(), "disk gone");
+          throw;
+        }
+      },
+      std::runtime_error);
+  EXPECT_FALSE(dependent_ran);
+  EXPECT_TRUE(independent_ran);
+
+  auto timeline = StartupProfiler::getInstance().getTimelineJson();
+  std::map<std::string, std::string> status;
+  for (const auto &phase : timeline["phases"]) {
+    status[phase["name"].asString()] = phase["status"].asString();
+  }
+  EXPECT_EQ(status["storage"], "failed");
+  EXPECT_EQ(status["instances"], "skipped");
+  EXPECT_EQ(status["groups"], "skipped");
+  EXPECT_EQ(status["plugins"], "ok");
+}
+
+TEST_F(StartupProfilerTest, RejectsUnknownDependenciesAndCycles) {
+  bool ran = false;
+  StartupTaskGraph unknown(1);
+  unknown.add("a", {"missing"}, [&]() { ran = true; });
+  EXPECT_THROW(unknown.run(), std::invalid_argument);
+
+  StartupTaskGraph cycle(1);
+  cycle.add("a", {"b"}, [&]() { ran = true; });
+  cycle.add("b", {"a"}, [&]() { ran = true; });
+  cycle.add("c", {}, [&]() { ran = true; });
+  EXPECT_THROW(cycle.run(), std::invalid_argument);
+  EXPECT_FALSE(ran);
+}
+
+TEST_F(StartupProfilerTest, TimelineReportsScopesAndReadyTime) {
+  auto &profiler = StartupProfiler::getInstance();
+  {
+    StartupProfiler::Scope scope("system_config");
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  try {
+    StartupProfiler::Scope scope("logger");
+    throw std::runtime_error("boom");
+  } catch (const std::exception &) {
+  }
+  EXPECT_FALSE(profiler.isReady());
+  profiler.markReady();
+  profiler.markReady(); // First call wins
+
+  auto timeline = profiler.getTimelineJson();
+  EXPECT_TRUE(timeline["ready"].asBool());
+  EXPECT_GE(timeline["readyMs"].asDouble(), 5.0);
+  EXPECT_TRUE(timeline.isMember("withinTarget"));
+  ASSERT_EQ(timeline["phases"].size(), 2u);
+  EXPECT_EQ(timeline["phases"][0]["name"].asString(), "system_config");
+  EXPECT_GE(timeline["phases"][0]["durationMs"].asDouble(), 5.0);
+  EXPECT_EQ(timeline["phases"][0]["thread"].asString(), "main");
+  EXPECT_EQ(timeline["phases"][1]["status"].asString(), "failed");
+
+  std::string summary = profiler.formatSummary();
+  EXPECT_NE(summary.find("system_config"), std::string::npos);
+  EXPECT_NE(summary.find("API ready after"), std::string::npos);
+}
@@ -0,0 +1,106 @@
+#include "core/synthetic_workload.h"
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using namespace SyntheticWorkload;
+
+TEST(SyntheticWorkloadTest, UnresolvedPlaceholdersFallBackToDefaults) {
+  auto source = parseSourceOptions({{"width", "${SYNTHETIC_WIDTH}"},
+                                    {"height", ""},
+                                    {"fps", "12.5"}});
+  EXPECT_EQ(source.width, 1280);
+  EXPECT_EQ(source.height, 720);
+  EXPECT_DOUBLE_EQ(source.fps, 12.5);
+  EXPECT_EQ(frameInterval(source).count(), 80000000);
+
+  auto detector = parseDetectorOptions(
+      {{"latency_ms", "40"}, {"latency_mode", "busy"}, {"boxes", "${X}"}});
+  EXPECT_EQ(detector.latency_ms, 40);
+  EXPECT_TRUE(detector.busy_wait);
+  EXPECT_EQ(detector.boxes, 5);
+
+  EXPECT_FALSE(parseBrokerOptions({{"serialize", "false"}}).serialize);
+  EXPECT_TRUE(parseBrokerOptions({}).serialize);
+}
+
+TEST(SyntheticWorkloadTest, RejectsMalformedValues) {
+  EXPECT_THROW(parseSourceOptions({{"width", "wide"}}), std::invalid_argument);
+  EXPECT_THROW(parseSourceOptions({{"width", "640px"}}),
+               std::invalid_argument);
+  EXPECT_THROW(parseSourceOptions({{"fps", "0"}}), std::invalid_argument);
+  EXPECT_THROW(parseDetectorOptions({{"boxes", "-1"}}), std::invalid_argument);
+  EXPECT_THROW(parseDetectorOptions({{"latency_mode", "gpu"}}),
+               std::invalid_argument);
+  EXPECT_THROW(parseDetectorOptions({{"min_box", "100"}, {"max_box", "50"}}),
+               std::invalid_argument);
+  EXPECT_THROW(parseBrokerOptions({{"serialize", "maybe"}}),
+               std::invalid_argument);
+}
+
+TEST(SyntheticWorkloadTest, LatencyJitterStaysInRange) {
+  DetectorOptions options;
+  options.latency_ms = 20;
+  EXPECT_EQ(latencyFor(options, 7).count(), 20000);
+
+  options.latency_jitter_ms = 5;
+  bool varied = false;
+  for (int frame = 0; frame < 200; ++frame) {
+    auto us = latencyFor(options, frame).count();
+    EXPECT_GE(us, 15000);
+    EXPECT_LE(us, 25000);
+    EXPECT_EQ(us, latencyFor(options, frame).count());
+    varied = varied || us != latencyFor(options, 0).count();
+  }
+  EXPECT_TRUE(varied);
+
+  options.latency_ms = 0;
+  for (int frame = 0; frame < 50; ++frame) {
+    EXPECT_GE(latencyFor(options, frame).count(), 0);
+  }
+}
+
+TEST(SyntheticWorkloadTest, BoxesStayInFrameAndMoveSmoothly) {
+  DetectorOptions options;
+  options.boxes = 16;
+  options.min_box = 20;
+  options.max_box = 300;
+  const int width = 320;
+  const int height = 240;
+
+  auto previous = generateBoxes(options, 0, width, height);
+  ASSERT_EQ(previous.size(), 16u);
+  for (int frame = 1; frame < 500; ++frame) {
+    auto boxes = generateBoxes(options, frame, width, height);
+    ASSERT_EQ(boxes.size(), previous.size());
+    for (size_t i = 0; i < boxes.size(); ++i) {
+      const auto &box = boxes[i];
+      ASSERT_GE(box.x, 0);
+      ASSERT_GE(box.y, 0);
+      ASSERT_LE(box.x + box.width, width);
+      ASSERT_LE(box.y + box.height, height);
+      ASSERT_GE(box.width, 1);
+      ASSERT_GE(box.score, 0.5f);
+      ASSERT_LT(box.score, 1.0f);
+      // Same object: same size and class, at most 4 px per axis per frame
+      EXPECT_EQ(box.width, previous[i].width);
+      EXPECT_EQ(box.class_id, previous[i].class_id);
+      EXPECT_LE(std::abs(box.x - previous[i].x), 4);
+      EXPECT_LE(std::abs(box.y - previous[i].y), 4);
+    }
+    previous = boxes;
+  }
+
+  // Deterministic per seed
+  auto a = generateBoxes(options, 42, width, height);
+  auto b = generateBoxes(options, 42, width, height);
+  options.seed = 1;
+  auto c = generateBoxes(options, 42, width, height);
+  EXPECT_EQ(a[3].x, b[3].x);
+  EXPECT_EQ(a[3].y, b[3].y);
+  EXPECT_FALSE(a[3].x == c[3].x && a[3].y == c[3].y &&
+               a[3].width == c[3].width);
+
+  options.boxes = 0;
+  EXPECT_TRUE(generateBoxes(options, 1, width, height).empty());
+}
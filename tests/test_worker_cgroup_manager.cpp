@@ -0,0 +1,38 @@
+#include "models/resource_limits.h"
+#include "worker/worker_cgroup_manager.h"
+#include <gtest/gtest.h>
+
+using namespace worker;
+
+TEST(WorkerCgroupManagerTest, ResourceLimitsRoundTripAndValidate) {
+  ResourceLimits limits;
+  EXPECT_TRUE(limits.empty());
+  EXPECT_TRUE(limits.validate().empty());
+
+  Json::Value json;
+  json["cpuWeight"] = 200;
+  json["cpuMax"] = 1.5;
+  json["memoryHighMB"] = 512;
+  limits = ResourceLimits::fromJson(json);
+  EXPECT_FALSE(limits.empty());
+  EXPECT_TRUE(limits.validate().empty());
+  EXPECT_EQ(limits.toJson(), json);
+
+  limits.cpuWeight = 20000;
+  EXPECT_FALSE(limits.validate().empty());
+
+  EXPECT_EQ(WorkerCgroupManager::formatCpuMax(1.5), "150000 100000");
+  EXPECT_EQ(WorkerCgroupManager::formatCpuMax(0.0), "max 100000");
+  EXPECT_EQ(WorkerCgroupManager::formatCpuMax(0.001), "1000 100000");
+}
+
+TEST(WorkerCgroupManagerTest, ParsesPressureStallInformation) {
+  const std::string content =
+      "some avg10=12.50 avg60=3.00 avg300=0.75 total=4200000\n"
+      "full avg10=1.00 avg60=0.10 avg300=0.00 total=100\n";
+  double avg10 = 0.0;
+  uint64_t total = 0;
+  WorkerCgroupManager::parsePressure(content, avg10, total);
+  EXPECT_DOUBLE_EQ(avg10, 12.5);
+  EXPECT_EQ(total, 4200000u);
+}
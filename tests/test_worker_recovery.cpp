@@ -0,0 +1,76 @@
+#include "worker/worker_recovery_metrics.h"
+#include "worker/worker_restart_policy.h"
+#include <chrono>
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace worker;
+
+TEST(WorkerRecoveryTest, BackoffStartsImmediatelyAndIsCapped) {
+  WorkerRestartPolicy policy;
+
+  EXPECT_EQ(policy.delayMs(1), 0);
+  EXPECT_EQ(policy.delayMs(2), 1000);
+  EXPECT_EQ(policy.delayMs(3), 2000);
+  EXPECT_EQ(policy.delayMs(4), 4000);
+  EXPECT_EQ(policy.delayMs(5), 8000);
+  EXPECT_EQ(policy.delayMs(6), 16000);
+  EXPECT_EQ(policy.delayMs(7), 30000); // 32 s capped
+  EXPECT_EQ(policy.delayMs(50), 30000);
+
+  policy.base_delay_ms = 100;
+  EXPECT_EQ(policy.delayMs(2), 100);
+  EXPECT_EQ(policy.delayMs(7), 3200);
+  EXPECT_EQ(policy.delayMs(8), 3200); // Doubling stops after 32x
+}
+
+TEST(WorkerRecoveryTest, RestartsStopAtMaxAndResetAfterStableRun) {
+  WorkerRestartPolicy policy;
+  policy.max_restarts = 3;
+
+  // Attempts 1..3 are allowed, a fourth crash gives up
+  int restart_count = 0;
+  int attempts = 0;
+  while (!policy.exhausted(restart_count)) {
+    ++restart_count;
+    ++attempts;
+  }
+  EXPECT_EQ(attempts, 3);
+
+  policy.max_restarts = 0;
+  EXPECT_TRUE(policy.exhausted(0));
+
+  EXPECT_FALSE(policy.ranStably(std::chrono::seconds(30)));
+  EXPECT_TRUE(policy.ranStably(std::chrono::minutes(6)));
+}
+
+TEST(WorkerRecoveryTest, MetricsCountCrashesRestartsAndRecoveries) {
+  auto &metrics = WorkerRecoveryMetrics::getInstance();
+  auto before = metrics.getStats();
+
+  metrics.recordCrash();
+  metrics.recordCrash();
+  metrics.recordRestart();
+  metrics.recordRestartFailure();
+  metrics.recordRecovery(std::chrono::milliseconds(1500));
+
+  auto after = metrics.getStats();
+  EXPECT_EQ(after.crashes - before.crashes, 2u);
+  EXPECT_EQ(after.restarts - before.restarts, 1u);
+  EXPECT_EQ(after.restart_failures - before.restart_failures, 1u);
+  EXPECT_EQ(after.recoveries - before.recoveries, 1u);
+  EXPECT_DOUBLE_EQ(after.last_recovery_seconds, 1.5);
+  EXPECT_NEAR(after.recovery_seconds_sum - before.recovery_seconds_sum, 1.5,
+              1e-6);
+
+  Json::Value json = metrics.getStatsJson();
+  EXPECT_EQ(json["crashes"].asUInt64(), after.crashes);
+  EXPECT_DOUBLE_EQ(json["lastCrashToFirstFrameMs"].asDouble(), 1500.0);
+
+  std::string text = metrics.getPrometheusMetrics();
+  EXPECT_NE(text.find("worker_crashes_total " + std::to_string(after.crashes)),
+            std::string::npos);
+  EXPECT_NE(text.find("worker_restart_failures_total"), std::string::npos);
+  EXPECT_NE(text.find("worker_crash_to_first_frame_seconds_count"),
+            std::string::npos);
+}
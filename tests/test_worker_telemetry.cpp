@@ -0,0 +1,80 @@
+#include "worker/ipc_protocol.h"
+#include "worker/unix_socket.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace worker;
+
+TEST(WorkerTelemetryTest, StatisticsDeltaCarriesOnlyChangedFields) {
+  Json::Value previous;
+  previous["frames_processed"] = 100;
+  previous["current_framerate"] = 25.0;
+  previous["state"] = "running";
+
+  Json::Value current = previous;
+  current["frames_processed"] = 125;
+  current["resolution"] = "1280x720";
+
+  Json::Value delta = diffStatistics(previous, current);
+  EXPECT_EQ(delta.size(), 2u);
+  EXPECT_EQ(delta["frames_processed"].asInt(), 125);
+  EXPECT_EQ(delta["resolution"].asString(), "1280x720");
+  EXPECT_TRUE(diffStatistics(current, current).empty());
+
+  applyStatisticsDelta(previous, delta);
+  EXPECT_EQ(previous, current);
+
+  EXPECT_TRUE(isPushEvent(MessageType::STATISTICS_UPDATE));
+  EXPECT_FALSE(isPushEvent(MessageType::WORKER_READY));
+  EXPECT_FALSE(isPushEvent(MessageType::PONG));
+}
+
+TEST(WorkerTelemetryTest, PushedEventsDoNotBreakRequestResponse) {
+  std::string path =
+      "/tmp/edge_ai_telemetry_test_" + std::to_string(getpid()) + ".sock";
+  UnixSocketServer server(path);
+  ASSERT_TRUE(server.start([](const IPCMessage &) {
+    IPCMessage pong;
+    pong.type = MessageType::PONG;
+    return pong;
+  }));
+
+  std::vector<uint64_t> received;
+  UnixSocketClient client(path);
+  client.setEventHandler([&received](const IPCMessage &event) {
+    received.push_back(event.payload["seq"].asUInt64());
+  });
+  ASSERT_TRUE(client.connect(1000));
+
+  auto pushEvent = [&server](uint64_t seq) {
+    IPCMessage event;
+    event.type = MessageType::STATISTICS_UPDATE;
+    event.payload["seq"] = static_cast<Json::UInt64>(seq);
+    // The server only knows the client once accept() ran
+    for (int i = 0; i < 100 && !server.sendEvent(event); ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  };
+
+  // An event queued ahead of the response is dispatched, not returned
+  pushEvent(1);
+  IPCMessage ping;
+  ping.type = MessageType::PING;
+  IPCMessage reply = client.sendAndReceive(ping, 2000);
+  EXPECT_EQ(reply.type, MessageType::PONG);
+  ASSERT_EQ(received.size(), 1u);
+
+  // Events arriving while idle are drained by pollEvents()
+  pushEvent(2);
+  for (int i = 0; i < 100 && received.size() < 2; ++i) {
+    client.pollEvents();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_EQ(received.size(), 2u);
+  EXPECT_EQ(received[1], 2u);
+
+  client.disconnect();
+  server.stop();
+}